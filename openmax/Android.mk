@@ -12,7 +12,7 @@ ifeq ($(BOARD_USE_ANDROID), false)
 BOARD_USE_KHRONOS_OMX_HEADER := true
 endif
 
-EXYNOS_OMX_SUPPORT_TUNNELING := false
+EXYNOS_OMX_SUPPORT_TUNNELING := true
 EXYNOS_OMX_SUPPORT_EGL_IMAGE := false
 
 EXYNOS_OMX_TOP := $(LOCAL_PATH)
@@ -79,3 +79,5 @@ endif
 ifeq ($(BOARD_USE_WMA_CODEC), true)
 include $(EXYNOS_OMX_COMPONENT)/audio/dec/wma/Android.mk
 endif
+
+include $(EXYNOS_OMX_TOP)/test/Android.mk
@@ -33,4 +33,8 @@ ifeq ($(EXYNOS_OMX_SUPPORT_EGL_IMAGE), true)
 LOCAL_CFLAGS += -DEGL_IMAGE_SUPPORT
 endif
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
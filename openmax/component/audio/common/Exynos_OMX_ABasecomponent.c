@@ -1417,7 +1417,18 @@ OMX_ERRORTYPE Exynos_OMX_SetConfig(
         goto EXIT;
     }
 
-    switch (nIndex) {
+    switch ((int)nIndex) {
+    case OMX_IndexConfigBufferBatch:
+    {
+        EXYNOS_OMX_CONFIG_BUFFER_BATCH *pBatch = (EXYNOS_OMX_CONFIG_BUFFER_BATCH *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pBatch, sizeof(EXYNOS_OMX_CONFIG_BUFFER_BATCH));
+        if (ret != OMX_ErrorNone)
+            goto EXIT;
+
+        ret = Exynos_OMX_SubmitBufferBatch(hComponent, pBatch);
+    }
+        break;
     default:
         ret = OMX_ErrorUnsupportedIndex;
         break;
@@ -1465,6 +1476,12 @@ OMX_ERRORTYPE Exynos_OMX_GetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_BUFFER_BATCH) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigBufferBatch;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
     ret = OMX_ErrorBadParameter;
 
 EXIT:
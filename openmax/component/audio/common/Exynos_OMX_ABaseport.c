@@ -476,56 +476,39 @@ EXIT:
     return ret;
 }
 
-OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
-    OMX_IN OMX_HANDLETYPE        hComponent,
-    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+/* checks on the header itself, nothing is locked yet */
+static OMX_ERRORTYPE Exynos_OMX_CheckBufferHeader(
+    OMX_BUFFERHEADERTYPE *pBuffer,
+    OMX_U32               nPortIndex)
 {
-    OMX_ERRORTYPE                ret                = OMX_ErrorNone;
-    OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
-    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
-    EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
-    EXYNOS_OMX_MESSAGE          *message            = NULL;
-
-    OMX_U32 i = 0;
-    OMX_BOOL bFindBuffer = OMX_FALSE;
-
-    FunctionIn();
-
-    if (hComponent == NULL) {
-        ret = OMX_ErrorBadParameter;
-        goto EXIT;
-    }
-    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
-
-    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
-    if (ret != OMX_ErrorNone)
-        goto EXIT;
-
-    if (pOMXComponent->pComponentPrivate == NULL) {
-        ret = OMX_ErrorBadParameter;
-        goto EXIT;
-    }
-    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
-
-    if (pExynosComponent->currentState == OMX_StateInvalid) {
-        ret = OMX_ErrorInvalidState;
-        goto EXIT;
-    }
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
 
     if (pBuffer == NULL) {
         ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
 
-    if (pBuffer->nInputPortIndex != INPUT_PORT_INDEX) {
+    if (((nPortIndex == INPUT_PORT_INDEX) &&
+         (pBuffer->nInputPortIndex != INPUT_PORT_INDEX)) ||
+        ((nPortIndex == OUTPUT_PORT_INDEX) &&
+         (pBuffer->nOutputPortIndex != OUTPUT_PORT_INDEX))) {
         ret = OMX_ErrorBadPortIndex;
         goto EXIT;
     }
 
     ret = Exynos_OMX_Check_SizeVersion(pBuffer, sizeof(OMX_BUFFERHEADERTYPE));
-    if (ret != OMX_ErrorNone) {
-        goto EXIT;
-    }
+
+EXIT:
+    return ret;
+}
+
+/* whether the port takes client buffers in the current state */
+static OMX_ERRORTYPE Exynos_OMX_CheckPortSubmit(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nPortIndex)
+{
+    OMX_ERRORTYPE        ret         = OMX_ErrorNone;
+    EXYNOS_OMX_BASEPORT *pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
 
     if ((pExynosComponent->currentState != OMX_StateIdle) &&
         (pExynosComponent->currentState != OMX_StateExecuting) &&
@@ -534,81 +517,92 @@ OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
         goto EXIT;
     }
 
-    pExynosPort = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
     if ((!CHECK_PORT_ENABLED(pExynosPort)) ||
-        (CHECK_PORT_BEING_FLUSHED(pExynosPort) &&
-        (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
+        ((CHECK_PORT_BEING_FLUSHED(pExynosPort)) &&
+         (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
         ((pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle) &&
-        (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
+         (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
+                                (nPortIndex == INPUT_PORT_INDEX)? "INPUT":"OUTPUT",
                                 CHECK_PORT_ENABLED(pExynosPort), pExynosPort->portState,
                                 CHECK_PORT_TUNNELED(pExynosPort), CHECK_PORT_BUFFER_SUPPLIER(pExynosPort));
         ret = OMX_ErrorIncorrectStateOperation;
         goto EXIT;
     }
 
-    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
-    for (i = 0; i < pExynosPort->portDefinition.nBufferCountActual; i++) {
+EXIT:
+    return ret;
+}
+
+/* hPortMutex must be held, bufferSemID is posted by the caller */
+static OMX_ERRORTYPE Exynos_OMX_QueueClientBuffer(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nPortIndex,
+    OMX_BUFFERHEADERTYPE     *pBuffer)
+{
+    OMX_ERRORTYPE        ret         = OMX_ErrorNone;
+    EXYNOS_OMX_BASEPORT *pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+    EXYNOS_OMX_MESSAGE  *message     = NULL;
+    OMX_U32              nBufferNum  = MAX_BUFFER_NUM;
+    OMX_BOOL             bFindBuffer = OMX_FALSE;
+
+    OMX_U32 i = 0;
+
+    if (nPortIndex == INPUT_PORT_INDEX)
+        nBufferNum = pExynosPort->portDefinition.nBufferCountActual;
+
+    for (i = 0; i < nBufferNum; i++) {
         if (pBuffer == pExynosPort->extendBufferHeader[i].OMXBufferHeader) {
             if (pExynosPort->extendBufferHeader[i].bBufferInOMX == OMX_FALSE) {
                 pExynosPort->extendBufferHeader[i].bBufferInOMX = OMX_TRUE;
                 bFindBuffer = OMX_TRUE;
                 break;
             } else {
-                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] input buffer(%p) was already entered!", pExynosComponent, __FUNCTION__, pBuffer);
+                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] %s buffer(%p) was already entered!", pExynosComponent, __FUNCTION__,
+                                                    (nPortIndex == INPUT_PORT_INDEX)? "input":"output", pBuffer);
             }
         }
     }
 
     if (bFindBuffer == OMX_FALSE) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] EmptyThisBuffer is failed : %p", pExynosComponent, __FUNCTION__, pBuffer);
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] %s is failed : %p", pExynosComponent, __FUNCTION__,
+                                            (nPortIndex == INPUT_PORT_INDEX)? "EmptyThisBuffer":"FillThisBuffer", pBuffer);
         ret = OMX_ErrorBadParameter;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
 
     message = Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_MESSAGE));
     if (message == NULL) {
         ret = OMX_ErrorInsufficientResources;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
-    message->messageType = EXYNOS_OMX_CommandEmptyBuffer;
-    message->messageParam = (OMX_U32) i;
-    message->pCmdData = (OMX_PTR)pBuffer;
+    message->messageType    = (nPortIndex == INPUT_PORT_INDEX)? EXYNOS_OMX_CommandEmptyBuffer:EXYNOS_OMX_CommandFillBuffer;
+    message->messageParam   = (OMX_U32) i;
+    message->pCmdData       = (OMX_PTR)pBuffer;
 
-    ret = Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message);
-    if (ret != 0) {
+    if (Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message) != 0) {
+        Exynos_OSAL_Free(message);
         ret = OMX_ErrorUndefined;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
-    ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
 
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader:%p, nAllocLen:%d, nFilledLen:%d, nOffset:%d, nFlags:%x",
                                             pExynosComponent, __FUNCTION__,
                                             pBuffer, pBuffer->nAllocLen, pBuffer->nFilledLen, pBuffer->nOffset, pBuffer->nFlags);
 
-    Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
-
 EXIT:
-    FunctionOut();
-
     return ret;
 }
 
-OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
-    OMX_IN OMX_HANDLETYPE        hComponent,
-    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+static OMX_ERRORTYPE Exynos_OMX_SubmitBuffer(
+    OMX_HANDLETYPE           hComponent,
+    OMX_BUFFERHEADERTYPE    *pBuffer,
+    OMX_U32                  nPortIndex)
 {
     OMX_ERRORTYPE                ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
     EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
-    EXYNOS_OMX_MESSAGE          *message            = NULL;
-
-    OMX_U32 i = 0;
-    OMX_BOOL bFindBuffer = OMX_FALSE;
 
     FunctionIn();
 
@@ -633,84 +627,126 @@ OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
         goto EXIT;
     }
 
-    if (pBuffer == NULL) {
-        ret = OMX_ErrorBadParameter;
+    ret = Exynos_OMX_CheckBufferHeader(pBuffer, nPortIndex);
+    if (ret != OMX_ErrorNone)
         goto EXIT;
-    }
 
-    if (pBuffer->nOutputPortIndex != OUTPUT_PORT_INDEX) {
-        ret = OMX_ErrorBadPortIndex;
+    ret = Exynos_OMX_CheckPortSubmit(pExynosComponent, nPortIndex);
+    if (ret != OMX_ErrorNone)
         goto EXIT;
-    }
 
-    ret = Exynos_OMX_Check_SizeVersion(pBuffer, sizeof(OMX_BUFFERHEADERTYPE));
-    if (ret != OMX_ErrorNone) {
+    pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+
+    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+
+    ret = Exynos_OMX_QueueClientBuffer(pExynosComponent, nPortIndex, pBuffer);
+    if (ret == OMX_ErrorNone)
+        ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+
+    Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
+    OMX_IN OMX_HANDLETYPE        hComponent,
+    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    return Exynos_OMX_SubmitBuffer(hComponent, pBuffer, INPUT_PORT_INDEX);
+}
+
+OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
+    OMX_IN OMX_HANDLETYPE        hComponent,
+    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    return Exynos_OMX_SubmitBuffer(hComponent, pBuffer, OUTPUT_PORT_INDEX);
+}
+
+/*
+ * same checks as EmptyThisBuffer/FillThisBuffer but the port mutex is taken once for the batch.
+ * bufferSemID still counts buffers, it is posted once for every buffer queued.
+ */
+OMX_ERRORTYPE Exynos_OMX_SubmitBufferBatch(
+    OMX_IN OMX_HANDLETYPE                   hComponent,
+    OMX_IN EXYNOS_OMX_CONFIG_BUFFER_BATCH  *pBatch)
+{
+    OMX_ERRORTYPE                ret                = OMX_ErrorNone;
+    OMX_ERRORTYPE                headerRet          = OMX_ErrorNone;
+    OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
+    EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
+    OMX_U32                      nValid             = 0;
+
+    OMX_U32 i = 0;
+
+    FunctionIn();
+
+    if ((hComponent == NULL) ||
+        (pBatch == NULL)) {
+        ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
 
-    if ((pExynosComponent->currentState != OMX_StateIdle) &&
-        (pExynosComponent->currentState != OMX_StateExecuting) &&
-        (pExynosComponent->currentState != OMX_StatePause)) {
-        ret = OMX_ErrorIncorrectStateOperation;
+    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
 
-    pExynosPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
-    if ((!CHECK_PORT_ENABLED(pExynosPort)) ||
-        ((CHECK_PORT_BEING_FLUSHED(pExynosPort)) &&
-         (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
-        ((pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle) &&
-         (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
-                                CHECK_PORT_ENABLED(pExynosPort), pExynosPort->portState,
-                                CHECK_PORT_TUNNELED(pExynosPort), CHECK_PORT_BUFFER_SUPPLIER(pExynosPort));
-        ret = OMX_ErrorIncorrectStateOperation;
+    pBatch->nSubmitted = 0;
+
+    if (pExynosComponent->currentState == OMX_StateInvalid) {
+        ret = OMX_ErrorInvalidState;
         goto EXIT;
     }
 
-    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
-    for (i = 0; i < MAX_BUFFER_NUM; i++) {
-        if (pBuffer == pExynosPort->extendBufferHeader[i].OMXBufferHeader) {
-            if (pExynosPort->extendBufferHeader[i].bBufferInOMX == OMX_FALSE) {
-                pExynosPort->extendBufferHeader[i].bBufferInOMX = OMX_TRUE;
-                bFindBuffer = OMX_TRUE;
-                break;
-            } else {
-                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] output buffer(%p) was already entered!", pExynosComponent, __FUNCTION__, pBuffer);
-            }
-        }
+    if (pBatch->nPortIndex >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
     }
 
-    if (bFindBuffer == OMX_FALSE) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] FillThisBuffer is failed : %p", pExynosComponent, __FUNCTION__, pBuffer);
+    if (pBatch->nCount > EXYNOS_OMX_BUFFER_BATCH_MAX) {
         ret = OMX_ErrorBadParameter;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
 
-    message = Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_MESSAGE));
-    if (message == NULL) {
-        ret = OMX_ErrorInsufficientResources;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
-        goto EXIT;
+    /* everything up to the first bad header is still submitted */
+    for (nValid = 0; nValid < pBatch->nCount; nValid++) {
+        headerRet = Exynos_OMX_CheckBufferHeader(pBatch->pBuffers[nValid], pBatch->nPortIndex);
+        if (headerRet != OMX_ErrorNone)
+            break;
     }
-    message->messageType = EXYNOS_OMX_CommandFillBuffer;
-    message->messageParam = (OMX_U32) i;
-    message->pCmdData = (OMX_PTR)pBuffer;
 
-    ret = Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message);
-    if (ret != 0) {
-        ret = OMX_ErrorUndefined;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+    ret = Exynos_OMX_CheckPortSubmit(pExynosComponent, pBatch->nPortIndex);
+    if (ret != OMX_ErrorNone)
         goto EXIT;
-    }
 
-    ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+    pExynosPort = &pExynosComponent->pExynosPort[pBatch->nPortIndex];
 
-    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader:%p", pExynosComponent, __FUNCTION__, pBuffer);
+    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+
+    for (i = 0; i < nValid; i++) {
+        ret = Exynos_OMX_QueueClientBuffer(pExynosComponent, pBatch->nPortIndex, pBatch->pBuffers[i]);
+        if (ret != OMX_ErrorNone)
+            break;
+
+        Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+        pBatch->nSubmitted++;
+    }
 
     Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
 
+    if (ret == OMX_ErrorNone)
+        ret = headerRet;
+
 EXIT:
     FunctionOut();
 
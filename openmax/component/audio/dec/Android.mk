@@ -28,4 +28,8 @@ LOCAL_HEADER_LIBRARIES := media_plugin_headers
 endif
 endif
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
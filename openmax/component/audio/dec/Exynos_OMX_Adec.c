@@ -958,6 +958,9 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 n
 
     Exynos_OSAL_MutexLock(flushPortBuffer->bufferMutex);
     ret = Exynos_OMX_FlushPort(pOMXComponent, nPortIndex);
+    /* the codec drops what it keeps of the flushed data */
+    if (pAudioDec->exynos_codec_flush != NULL)
+        pAudioDec->exynos_codec_flush(pOMXComponent, nPortIndex);
     Exynos_OSAL_MutexUnlock(flushPortBuffer->bufferMutex);
 
     if (nPortIndex == INPUT_PORT_INDEX) {
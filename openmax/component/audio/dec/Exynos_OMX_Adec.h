@@ -74,6 +74,7 @@ typedef struct _EXYNOS_OMX_AUDIODEC_COMPONENT
     OMX_HANDLETYPE hBufferProcessThread;
 
     OMX_ERRORTYPE (*exynos_codec_bufferProcess) (OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pInputData, EXYNOS_OMX_DATA *pOutputData);
+    OMX_ERRORTYPE (*exynos_codec_flush) (OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);  /* optional */
 
     int (*exynos_checkInputFrame)(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag, OMX_BOOL bPreviousFrameEOF, OMX_BOOL *pbEndOfFrame);
 } EXYNOS_OMX_AUDIODEC_COMPONENT;
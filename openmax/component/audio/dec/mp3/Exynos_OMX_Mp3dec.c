@@ -858,6 +858,7 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
     pExynosComponent->exynos_codec_componentInit      = &Exynos_SRP_Mp3Dec_Init;
     pExynosComponent->exynos_codec_componentTerminate = &Exynos_SRP_Mp3Dec_Terminate;
     pAudioDec->exynos_codec_bufferProcess = &Exynos_SRP_Mp3Dec_bufferProcess;
+    pAudioDec->exynos_codec_flush = NULL;
     pAudioDec->exynos_checkInputFrame = NULL;
 
     pExynosComponent->currentState = OMX_StateLoaded;
@@ -31,4 +31,8 @@ LOCAL_C_INCLUDES := $(EXYNOS_OMX_INC)/khronos \
 	$(EXYNOS_AUDIO_CODEC)/alp/include \
 	$(EXYNOS_AUDIO_CODEC)/ffmpeg/include
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_SHARED_LIBRARY)
@@ -430,6 +430,21 @@ OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pExynosComponent->bSaveFlagEOS = OMX_FALSE;
     pExynosComponent->getAllDelayBuffer = OMX_FALSE;
 
+    pWmaDec->pPcmBuffer = Exynos_OSAL_Malloc(AVCODEC_MAX_AUDIO_FRAME_SIZE);
+    if (pWmaDec->pPcmBuffer == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "%s: pcm buffer alloc error", __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    pWmaDec->nPcmLen            = 0;
+    pWmaDec->nPcmOffset         = 0;
+    pWmaDec->nPacketSamples     = 0;
+    pWmaDec->nPacketCount       = 0;
+    pWmaDec->nFrameCount        = 0;
+    pWmaDec->nOutputBufferCount = 0;
+    pWmaDec->nOutputSamples     = 0;
+    pWmaDec->nDecodeTimeUs      = 0;
+
     FFmpeg_Init(&pWmaDec->ffmpeg);
 
 EXIT:
@@ -447,8 +462,24 @@ OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
 
     FunctionIn();
 
+    if ((pWmaDec->nOutputSamples > 0) &&
+        (pWmaDec->nSampleRate > 0)) {
+        OMX_U64 nAudioMs = (pWmaDec->nOutputSamples * 1000) / pWmaDec->nSampleRate;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "%s: %llu ms of audio, packets: %llu, frames: %llu, output buffers: %llu (%llu/s), decode: %llu us/s",
+                        __FUNCTION__, nAudioMs,
+                        pWmaDec->nPacketCount, pWmaDec->nFrameCount, pWmaDec->nOutputBufferCount,
+                        (nAudioMs > 0)? ((pWmaDec->nOutputBufferCount * 1000) / nAudioMs):0,
+                        (nAudioMs > 0)? ((pWmaDec->nDecodeTimeUs * 1000) / nAudioMs):0);
+    }
+
     FFmpeg_DeInit(&pWmaDec->ffmpeg);
 
+    Exynos_OSAL_Free(pWmaDec->pPcmBuffer);
+    pWmaDec->pPcmBuffer = NULL;
+    pWmaDec->nPcmLen    = 0;
+    pWmaDec->nPcmOffset = 0;
+
 EXIT:
     FunctionOut();
 
@@ -471,17 +502,183 @@ OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_codecConfigure(OMX_COMPONENTTYPE *pOMXCompone
     Exynos_OSAL_Memcpy(extra_data, ((char*)pInputData->buffer.addr[AUDIO_DATA_PLANE]) + codec_info_size,
                                     codecInfo.codecSpecificDataSize);
 
+    pWmaDec->nSampleRate = codecInfo.sampleRates;
+    pWmaDec->nChannels   = codecInfo.numberOfChannels;
+
     return FFmpeg_CodecOpen(ffmpeg, codecInfo.codecID, codecInfo.averageNumberOfbytesPerSecond * 8,
                             extra_data, codecInfo.codecSpecificDataSize, codecInfo.sampleRates,
                             codecInfo.numberOfChannels, codecInfo.blockAlignment);
 }
 
+static OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_decodePacket(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pInputData, EXYNOS_OMX_DATA *pOutputData)
+{
+    OMX_ERRORTYPE                  ret = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_AUDIODEC_COMPONENT *pAudioDec = (EXYNOS_OMX_AUDIODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMA_HANDLE             *pWmaDec = (EXYNOS_WMA_HANDLE *)pAudioDec->hCodecHandle;
+    OMX_U32                        nSampleSize = 0;
+    OMX_U32                        nSpace = 0;
+    OMX_U32                        nCopySize = 0;
+    OMX_U64                        nStartUs = 0;
+    int                            nInLen = 0;
+    int                            nOutLen = 0;
+    int                            nOutSize = 0;
+    OMX_BOOL                       bDirect = OMX_FALSE;
+
+    FunctionIn();
+
+    nSampleSize = ((pWmaDec->nChannels > 0)? pWmaDec->nChannels:DEFAULT_AUDIO_CHANNELS_NUM) *
+                  (pWmaDec->pcmParam.nBitPerSample / 8);
+    if (nSampleSize == 0)
+        nSampleSize = 1;
+
+    if ((pExynosComponent->reInputData == OMX_FALSE) ||
+        ((pInputData->usedDataLen == 0) && (pWmaDec->nPcmLen == 0))) {
+        /* a new packet, anything left of the previous one was flushed */
+        pWmaDec->nPacketSamples = 0;
+        pWmaDec->nPcmLen        = 0;
+        pWmaDec->nPcmOffset     = 0;
+        pInputData->usedDataLen = 0;
+        pWmaDec->nPacketCount++;
+    }
+
+    /* an output buffer starts at the packet time plus what was given out of the packet before */
+    pOutputData->timeStamp = pInputData->timeStamp;
+    if (pWmaDec->nSampleRate > 0)
+        pOutputData->timeStamp += (OMX_TICKS)((pWmaDec->nPacketSamples * 1000000) / pWmaDec->nSampleRate);
+    pOutputData->nFlags  = pInputData->nFlags & (~OMX_BUFFERFLAG_EOS);
+    pOutputData->dataLen = 0;
+
+    while (1) {
+        nSpace = pOutputData->allocSize - pOutputData->dataLen;
+
+        /* the rest of a frame which did not fit goes first */
+        if (pWmaDec->nPcmOffset < pWmaDec->nPcmLen) {
+            nCopySize = pWmaDec->nPcmLen - pWmaDec->nPcmOffset;
+            if (nCopySize > nSpace)
+                nCopySize = nSpace - (nSpace % nSampleSize);
+
+            Exynos_OSAL_Memcpy((char *)pOutputData->buffer.addr[AUDIO_DATA_PLANE] + pOutputData->dataLen,
+                               pWmaDec->pPcmBuffer + pWmaDec->nPcmOffset, nCopySize);
+            pWmaDec->nPcmOffset     += nCopySize;
+            pOutputData->dataLen    += nCopySize;
+            pWmaDec->nPacketSamples += nCopySize / nSampleSize;
+
+            if (pWmaDec->nPcmOffset < pWmaDec->nPcmLen) {
+                ret = (OMX_ERRORTYPE)OMX_ErrorInputDataDecodeYet;
+                break;
+            }
+
+            pWmaDec->nPcmLen    = 0;
+            pWmaDec->nPcmOffset = 0;
+            continue;
+        }
+
+        if (pInputData->usedDataLen >= pInputData->dataLen)
+            break;
+
+        if (nSpace < nSampleSize) {
+            ret = (OMX_ERRORTYPE)OMX_ErrorInputDataDecodeYet;
+            break;
+        }
+
+        /* decoder wants room for the largest frame, otherwise decode aside and copy what fits */
+        bDirect = (nSpace >= AVCODEC_MAX_AUDIO_FRAME_SIZE)? OMX_TRUE:OMX_FALSE;
+        nInLen  = (int)(pInputData->dataLen - pInputData->usedDataLen);
+        nOutSize = (bDirect == OMX_TRUE)? (int)nSpace:AVCODEC_MAX_AUDIO_FRAME_SIZE;
+        nOutLen  = nOutSize;
+
+        nStartUs = Exynos_OSAL_GetSystemTimeUs();
+        ret = FFmpeg_Decode(&pWmaDec->ffmpeg,
+                            (OMX_PTR)((char *)pInputData->buffer.addr[AUDIO_DATA_PLANE] + pInputData->usedDataLen), &nInLen,
+                            (bDirect == OMX_TRUE)? (OMX_PTR)((char *)pOutputData->buffer.addr[AUDIO_DATA_PLANE] + pOutputData->dataLen):(OMX_PTR)pWmaDec->pPcmBuffer,
+                            &nOutLen);
+        pWmaDec->nDecodeTimeUs += Exynos_OSAL_GetSystemTimeUs() - nStartUs;
+        if (ret != OMX_ErrorNone)
+            break;
+
+        if (nOutLen > nOutSize) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "%s: FFmpeg_Decode gave %d bytes for %d bytes of room",
+                            __FUNCTION__, nOutLen, nOutSize);
+            ret = OMX_ErrorUndefined;
+            break;
+        }
+
+        if (nOutLen > 0) {
+            pWmaDec->nFrameCount++;
+            pWmaDec->nOutputSamples += nOutLen / nSampleSize;
+
+            if (bDirect == OMX_TRUE) {
+                pOutputData->dataLen    += nOutLen;
+                pWmaDec->nPacketSamples += nOutLen / nSampleSize;
+            } else {
+                pWmaDec->nPcmLen    = nOutLen;
+                pWmaDec->nPcmOffset = 0;
+            }
+        }
+
+        /* FFmpeg_Decode() is taken to give back in *nInLen the bytes of the frame it decoded, as
+         * avcodec_decode_audio() does. a wrapper giving back the whole input ends the packet after
+         * its first frame like one call per packet did, which shows as nFrameCount == nPacketCount.
+         * nothing else moves the packet on, so a length out of range drops the rest of it
+         */
+        if ((nInLen <= 0) ||
+            ((OMX_U32)nInLen > (pInputData->dataLen - pInputData->usedDataLen))) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "%s: FFmpeg_Decode took %d of %d bytes, the rest of packet is dropped",
+                            __FUNCTION__, nInLen, (int)(pInputData->dataLen - pInputData->usedDataLen));
+            pInputData->usedDataLen = pInputData->dataLen;
+        } else {
+            pInputData->usedDataLen += nInLen;
+        }
+    }
+
+    if (ret != (OMX_ERRORTYPE)OMX_ErrorInputDataDecodeYet) {
+        /* nothing of the packet is kept on an error */
+        pWmaDec->nPcmLen    = 0;
+        pWmaDec->nPcmOffset = 0;
+    }
+
+    if (pOutputData->dataLen > 0)
+        pWmaDec->nOutputBufferCount++;
+
+    FunctionOut();
+
+    return ret;
+}
+
+/* a packet half given out does not carry over a seek */
+OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_Flush(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
+{
+    OMX_ERRORTYPE                  ret = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_AUDIODEC_COMPONENT *pAudioDec = (EXYNOS_OMX_AUDIODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMA_HANDLE             *pWmaDec = (EXYNOS_WMA_HANDLE *)pAudioDec->hCodecHandle;
+
+    FunctionIn();
+
+    /* the frames of the packet are kept for the output, only an input flush drops the packet */
+    if ((pWmaDec == NULL) ||
+        (nPortIndex != INPUT_PORT_INDEX))
+        goto EXIT;
+
+    if (pWmaDec->nPcmLen > 0)
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "%s: %d bytes of decoded packet are dropped",
+                        __FUNCTION__, (int)(pWmaDec->nPcmLen - pWmaDec->nPcmOffset));
+
+    pWmaDec->nPacketSamples = 0;
+    pWmaDec->nPcmLen        = 0;
+    pWmaDec->nPcmOffset     = 0;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_bufferProcess(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pInputData, EXYNOS_OMX_DATA *pOutputData)
 {
     OMX_ERRORTYPE             ret = OMX_ErrorNone;
     EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
-    EXYNOS_OMX_AUDIODEC_COMPONENT *pAudioDec = (EXYNOS_OMX_AUDIODEC_COMPONENT *)pExynosComponent->hComponentHandle;
-    EXYNOS_WMA_HANDLE             *pWmaDec = (EXYNOS_WMA_HANDLE *)pAudioDec->hCodecHandle;
     EXYNOS_OMX_BASEPORT      *pInputPort = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
     EXYNOS_OMX_BASEPORT      *pOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
 
@@ -507,16 +704,8 @@ OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_bufferProcess(OMX_COMPONENTTYPE *pOMXComponen
     if (pInputData->nFlags & OMX_BUFFERFLAG_CODECCONFIG) {
         ret = Exynos_FFMPEG_WmaDec_codecConfigure(pOMXComponent, pInputData);
     } else {
-        /* Save timestamp and flags of input data */
-        pOutputData->timeStamp = pInputData->timeStamp;
-        pOutputData->nFlags = pInputData->nFlags & (~OMX_BUFFERFLAG_EOS);
-
-        /* WARNING IT DOESNT GUARANTEE WORKING WELL TO MULTIPLE FRAMES */
-        pInputData->dataLen = pInputData->allocSize;
-        pOutputData->dataLen = pOutputData->allocSize;
-        ret = FFmpeg_Decode(&pWmaDec->ffmpeg,
-                            pInputData->buffer.addr[AUDIO_DATA_PLANE], (int*)&pInputData->dataLen,
-                            pOutputData->buffer.addr[AUDIO_DATA_PLANE], (int*)&pOutputData->dataLen);
+        /* all frames of the packet are packed into output buffers, it may take several calls */
+        ret = Exynos_FFMPEG_WmaDec_decodePacket(pOMXComponent, pInputData, pOutputData);
     }
 
     if (ret != OMX_ErrorNone) {
@@ -527,11 +716,18 @@ OMX_ERRORTYPE Exynos_FFMPEG_WmaDec_bufferProcess(OMX_COMPONENTTYPE *pOMXComponen
             pExynosComponent->pCallbacks->EventHandler((OMX_HANDLETYPE)pOMXComponent,
                                                     pExynosComponent->callbackData,
                                                     OMX_EventError, ret, 0, NULL);
+
+            /* drop the rest of the packet, what is decoded of it still goes out */
+            pInputData->dataLen = 0;
+            pInputData->remainDataLen = 0;
+            pInputData->usedDataLen = 0;
+
+            pOutputData->usedDataLen = 0;
+            pOutputData->remainDataLen = pOutputData->dataLen;
         }
     } else {
-        pInputData->usedDataLen += pInputData->dataLen;
-        pInputData->remainDataLen = pInputData->dataLen - pInputData->usedDataLen;
-        pInputData->dataLen -= pInputData->usedDataLen;
+        pInputData->dataLen = 0;
+        pInputData->remainDataLen = 0;
         pInputData->usedDataLen = 0;
 
         pOutputData->usedDataLen = 0;
@@ -684,6 +880,7 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
     pExynosComponent->exynos_codec_componentInit      = &Exynos_FFMPEG_WmaDec_Init;
     pExynosComponent->exynos_codec_componentTerminate = &Exynos_FFMPEG_WmaDec_Terminate;
     pAudioDec->exynos_codec_bufferProcess = &Exynos_FFMPEG_WmaDec_bufferProcess;
+    pAudioDec->exynos_codec_flush = &Exynos_FFMPEG_WmaDec_Flush;
     pAudioDec->exynos_checkInputFrame = NULL;
 
     pExynosComponent->currentState = OMX_StateLoaded;
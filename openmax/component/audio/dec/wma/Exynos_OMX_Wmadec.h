@@ -52,6 +52,23 @@ typedef struct _EXYNOS_WMA_HANDLE
     OMX_AUDIO_PARAM_PCMMODETYPE pcmParam;
 
     FFmpeg ffmpeg;
+
+    /* stream info from codec config, used to place output buffers in time */
+    OMX_U32 nSampleRate;
+    OMX_U32 nChannels;
+
+    /* packet being decoded, kept while its frames are spread over several output buffers */
+    OMX_U64 nPacketSamples;     /* samples per channel already given out from the packet */
+    OMX_U8 *pPcmBuffer;         /* a frame that did not fit the rest of an output buffer */
+    OMX_U32 nPcmLen;
+    OMX_U32 nPcmOffset;
+
+    /* statistics */
+    OMX_U64 nPacketCount;
+    OMX_U64 nFrameCount;
+    OMX_U64 nOutputBufferCount;
+    OMX_U64 nOutputSamples;
+    OMX_U64 nDecodeTimeUs;
 } EXYNOS_WMA_HANDLE;
 
 #ifdef __cplusplus
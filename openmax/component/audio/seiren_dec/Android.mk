@@ -26,4 +26,8 @@ else
 LOCAL_C_INCLUDES += $(ANDROID_MEDIA_INC)/openmax
 endif
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
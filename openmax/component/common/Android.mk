@@ -46,8 +46,10 @@ include $(CLEAR_VARS)
 
 LOCAL_MODULE_TAGS := optional
 
+# the worker pool is process-wide, it lives here with the other state every component shares
 LOCAL_SRC_FILES := \
-	Exynos_OMX_Resourcemanager.c
+	Exynos_OMX_Resourcemanager.c \
+	../../osal/Exynos_OSAL_WorkerPool.c
 
 LOCAL_PRELINK_MODULE := false
 LOCAL_MODULE := libExynosOMX_Resourcemanager
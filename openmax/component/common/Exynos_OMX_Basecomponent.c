@@ -36,6 +36,9 @@
 #include "Exynos_OSAL_ETC.h"
 #include "Exynos_OSAL_Semaphore.h"
 #include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_Bench.h"
+#include "Exynos_OSAL_Trace.h"
+#include "Exynos_OSAL_WorkerPool.h"
 #include "Exynos_OMX_Baseport.h"
 #include "Exynos_OMX_Basecomponent.h"
 #include "Exynos_OMX_Resourcemanager.h"
@@ -84,6 +87,74 @@ EXIT:
     return ret;
 }
 
+/* state, transient state, flush flags and bExitBufferProcessThread must be updated before this */
+void Exynos_OMX_NotifyStateChange(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
+{
+    if ((pExynosComponent == NULL) ||
+        (pExynosComponent->hStateCondition == NULL))
+        return;
+
+    Exynos_OSAL_ConditionBroadcast(pExynosComponent->hStateCondition);
+    Exynos_OMX_WakeBufferProcess(pExynosComponent, ALL_PORT_INDEX);
+}
+
+/* must follow the semaphore post or state update that a parked step is waiting for */
+void Exynos_OMX_WakeBufferProcess(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    OMX_S32                      nPortIndex)
+{
+    EXYNOS_OMX_BASEPORT *pExynosPort = NULL;
+    OMX_S32              i;
+    OMX_U32              j;
+
+    if ((pExynosComponent == NULL) ||
+        (pExynosComponent->pExynosPort == NULL))
+        return;
+
+    for (i = 0; i < (OMX_S32)pExynosComponent->portParam.nPorts; i++) {
+        if ((nPortIndex != ALL_PORT_INDEX) &&
+            (nPortIndex != i))
+            continue;
+
+        pExynosPort = &pExynosComponent->pExynosPort[i];
+        for (j = 0; j < ALL_WAY_NUM; j++) {
+            if (pExynosPort->hProcessWorker[j] != NULL)
+                Exynos_OSAL_WorkerSignal(pExynosPort->hProcessWorker[j]);
+        }
+    }
+}
+
+/*
+ * replaces sched_yield() at the top of the buffer process loops.
+ * on the worker pool, a step that can not make progress until the component is executing
+ * or the flush is done gives its thread back. returns OMX_TRUE when the step has to unwind.
+ * a buffer thread sleeps through the flush of its port instead, until the next state change.
+ */
+OMX_BOOL Exynos_OMX_BufferProcess_Yield(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    OMX_U32                      nPortIndex)
+{
+    if (Exynos_OSAL_WorkerCurrent() == NULL) {
+        if (pExynosComponent->hStateCondition == NULL)
+            return OMX_FALSE;
+
+        /* waits once, the caller checks its exit flag and comes back while the flush is going on */
+        Exynos_OSAL_ConditionLock(pExynosComponent->hStateCondition);
+        if ((CHECK_PORT_BEING_FLUSHED(&pExynosComponent->pExynosPort[nPortIndex])) &&
+            (pExynosComponent->transientState != EXYNOS_OMX_TransStateIdleToLoaded))
+            Exynos_OSAL_ConditionWait(pExynosComponent->hStateCondition);
+        Exynos_OSAL_ConditionUnlock(pExynosComponent->hStateCondition);
+
+        return OMX_FALSE;
+    }
+
+    if ((pExynosComponent->currentState != OMX_StateExecuting) ||
+        (CHECK_PORT_BEING_FLUSHED(&pExynosComponent->pExynosPort[nPortIndex])))
+        Exynos_OSAL_WorkerPark();
+
+    return Exynos_OSAL_WorkerYield();
+}
+
 
 /* OMX Interface */
 OMX_ERRORTYPE Exynos_OMX_GetComponentVersion(
@@ -183,6 +254,7 @@ OMX_ERRORTYPE Exynos_OMX_SendCommand(
     case OMX_CommandStateSet :
         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] OMX_CommandStateSet(%s)",
                                                 pExynosComponent, __FUNCTION__, stateString(nParam));
+        pExynosComponent->nStateSetTimeUs = Exynos_OSAL_GetSystemTimeUs();
         ret = Exynos_CheckStateSet(pExynosComponent, nParam);
         break;
     case OMX_CommandFlush :
@@ -924,6 +996,24 @@ EXIT:
     return ret;
 }
 
+static void Exynos_OMX_StateSetDone(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_STATETYPE             fromState,
+    OMX_STATETYPE             toState)
+{
+    OMX_U64 nDurationUs = Exynos_OSAL_GetSystemTimeUs() - pExynosComponent->nStateSetTimeUs;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] %s -> %s took %lld us", pExynosComponent, __FUNCTION__,
+                                        stateString(fromState), stateString(toState), (long long)nDurationUs);
+
+    if ((fromState == OMX_StateLoaded) &&
+        (toState == OMX_StateIdle))
+        Exynos_OSAL_BenchPhase(pExynosComponent->hBench, BENCH_PHASE_LOADED_TO_IDLE, nDurationUs);
+    else if ((fromState == OMX_StateIdle) &&
+             (toState == OMX_StateExecuting))
+        Exynos_OSAL_BenchPhase(pExynosComponent->hBench, BENCH_PHASE_IDLE_TO_EXECUTING, nDurationUs);
+}
+
 static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
     OMX_COMPONENTTYPE   *pOMXComponent,
     OMX_U32              destState)
@@ -994,11 +1084,6 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
                 pExynosComponent->pExynosPort[i].hPortMutex = NULL;
             }
 
-            /* terminate signal about pause */
-            for (i = 0; i < ALL_PORT_NUM; i++) {
-                Exynos_OSAL_SignalTerminate(pExynosComponent->pExynosPort[i].pauseEvent);
-                pExynosComponent->pExynosPort[i].pauseEvent = NULL;
-            }
 
             /* terminate sema for buffer handling on port */
             for (i = 0; i < ALL_PORT_NUM; i++) {
@@ -1048,11 +1133,6 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
                 pExynosComponent->pExynosPort[i].hPortMutex = NULL;
             }
 
-            /* terminate signal about pause */
-            for (i = 0; i < ALL_PORT_NUM; i++) {
-                Exynos_OSAL_SignalTerminate(pExynosComponent->pExynosPort[i].pauseEvent);
-                pExynosComponent->pExynosPort[i].pauseEvent = NULL;
-            }
 
             /* terminate sema for buffer handling on port */
             for (i = 0; i < ALL_PORT_NUM; i++) {
@@ -1073,7 +1153,7 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
                             Exynos_OSAL_Free(pMessage);
                     }
 
-                    ret = pExynosComponent->exynos_FreeTunnelBuffer(pExynosPort, i);
+                    ret = pExynosComponent->exynos_FreeTunnelBuffer(pOMXComponent, i);
                     if (OMX_ErrorNone != ret)
                         goto EXIT;
                 }
@@ -1113,7 +1193,7 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
                 if (CHECK_PORT_TUNNELED(pExynosPort) &&
                     CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) &&
                     CHECK_PORT_ENABLED(pExynosPort)) {
-                    ret = pExynosComponent->exynos_AllocateTunnelBuffer(pExynosPort, i);
+                    ret = pExynosComponent->exynos_AllocateTunnelBuffer(pOMXComponent, i);
                     if (ret!=OMX_ErrorNone)
                         goto EXIT;
                 }
@@ -1126,9 +1206,11 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
             if (ret != OMX_ErrorNone) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to exynos_codec_componentInit() (0x%x)", pExynosComponent, __FUNCTION__, ret);
 #ifdef TUNNELING_SUPPORT
-                /*
-                 * if (CHECK_PORT_TUNNELED == OMX_TRUE) thenTunnel Buffer Free
-                 */
+                for (i = 0; i < (int)pExynosComponent->portParam.nPorts; i++) {
+                    if (CHECK_PORT_TUNNELED(&pExynosComponent->pExynosPort[i]) &&
+                        CHECK_PORT_BUFFER_SUPPLIER(&pExynosComponent->pExynosPort[i]))
+                        pExynosComponent->exynos_FreeTunnelBuffer(pOMXComponent, i);
+                }
 #endif
                 goto EXIT;
             }
@@ -1143,16 +1225,6 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
                 }
             }
 
-            /* create signal about pause */
-            for (i = 0; i < ALL_PORT_NUM; i++) {
-                ret = Exynos_OSAL_SignalCreate(&pExynosComponent->pExynosPort[i].pauseEvent);
-                if (ret != OMX_ErrorNone) {
-                    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Exynos_OSAL_SignalCreate (0x%x)", pExynosComponent, __FUNCTION__, ret);
-                    ret = OMX_ErrorInsufficientResources;
-                    goto FAIL_TO_IDLE;
-                }
-            }
-
             for (i = 0; i < ALL_PORT_NUM; i++) {
                 /* create mutex in way */
                 if (pExynosComponent->pExynosPort[i].portWayType == WAY1_PORT) {
@@ -1190,9 +1262,11 @@ static OMX_ERRORTYPE Exynos_OMX_ComponentStateSet(
             if (ret != OMX_ErrorNone) {
 FAIL_TO_IDLE:
 #ifdef TUNNELING_SUPPORT
-                /*
-                 * if (CHECK_PORT_TUNNELED == OMX_TRUE) thenTunnel Buffer Free
-                 */
+                for (i = 0; i < (int)pExynosComponent->portParam.nPorts; i++) {
+                    if (CHECK_PORT_TUNNELED(&pExynosComponent->pExynosPort[i]) &&
+                        CHECK_PORT_BUFFER_SUPPLIER(&pExynosComponent->pExynosPort[i]))
+                        pExynosComponent->exynos_FreeTunnelBuffer(pOMXComponent, i);
+                }
 #endif
                 for (i = 0; i < ALL_PORT_NUM; i++) {
                     /* terminate mutex in way */
@@ -1212,11 +1286,6 @@ FAIL_TO_IDLE:
                     pExynosComponent->pExynosPort[i].hPortMutex = NULL;
                 }
 
-                /* terminate signal about pause */
-                for (i = 0; i < ALL_PORT_NUM; i++) {
-                    Exynos_OSAL_SignalTerminate(pExynosComponent->pExynosPort[i].pauseEvent);
-                    pExynosComponent->pExynosPort[i].pauseEvent = NULL;
-                }
 
                 /* terminate sema for buffer handling on port */
                 for (i = 0; i < ALL_PORT_NUM; i++) {
@@ -1262,56 +1331,29 @@ FAIL_TO_IDLE:
         break;
     case OMX_StateExecuting:
     {
-        int j;
-
         switch (currentState) {
         case OMX_StateLoaded:
             ret = OMX_ErrorIncorrectStateTransition;
             break;
         case OMX_StateIdle:
 #ifdef TUNNELING_SUPPORT
-            for (i = 0; i < pExynosComponent->portParam.nPorts; i++) {
-                pExynosPort = &pExynosComponent->pExynosPort[i];
-
-                if (CHECK_PORT_TUNNELED(pExynosPort) &&
-                    CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) &&
-                    CHECK_PORT_ENABLED(pExynosPort)) {
-                    for (j = 0; j < pExynosPort->tunnelBufferNum; j++)
-                        Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[i].bufferSemID);
-                }
-            }
+            /* the supplier queues its own buffers, nobody else will */
+            for (i = 0; i < pExynosComponent->portParam.nPorts; i++)
+                Exynos_OMX_TunnelPortRestart(pOMXComponent, i);
 #endif
             pExynosComponent->transientState    = EXYNOS_OMX_TransStateMax;
             pExynosComponent->currentState      = OMX_StateExecuting;
 
-            /* set signal about pause */
-            for (i = 0; i < ALL_PORT_NUM; i++)
-                Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[i].pauseEvent);
+            Exynos_OMX_NotifyStateChange(pExynosComponent);
             break;
         case OMX_StatePause:
 #ifdef TUNNELING_SUPPORT
-            for (i = 0; i < pExynosComponent->portParam.nPorts; i++) {
-                pExynosPort = &pExynosComponent->pExynosPort[i];
-
-                if (CHECK_PORT_TUNNELED(pExynosPort) &&
-                    CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) &&
-                    CHECK_PORT_ENABLED(pExynosPort)) {
-                    OMX_S32 semaValue = 0, cnt = 0;
-
-                    Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->pExynosPort[i].bufferSemID, &semaValue);
-                    if (Exynos_OSAL_GetElemNum(&pExynosPort->bufferQ) > semaValue) {
-                        cnt = Exynos_OSAL_GetElemNum(&pExynosPort->bufferQ) - semaValue;
-                        for (j = 0; j < cnt; j++)
-                            Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[i].bufferSemID);
-                    }
-                }
-            }
+            for (i = 0; i < pExynosComponent->portParam.nPorts; i++)
+                Exynos_OMX_TunnelPortRestart(pOMXComponent, i);
 #endif
             pExynosComponent->currentState = OMX_StateExecuting;
 
-            /* set signal about pause */
-            for (i = 0; i < ALL_PORT_NUM; i++)
-                Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[i].pauseEvent);
+            Exynos_OMX_NotifyStateChange(pExynosComponent);
             break;
         case OMX_StateWaitForResources:
             ret = OMX_ErrorIncorrectStateTransition;
@@ -1368,6 +1410,8 @@ FAIL_TO_IDLE:
 
 EXIT:
     if (ret == OMX_ErrorNone) {
+        Exynos_OMX_StateSetDone(pExynosComponent, currentState, (OMX_STATETYPE)destState);
+
         if (pExynosComponent->pCallbacks != NULL) {
             Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] OMX_EventCmdComplete(%s)",
                                         pExynosComponent, __FUNCTION__, stateString(destState));
@@ -1447,6 +1491,8 @@ static OMX_ERRORTYPE Exynos_OMX_EventHandler(
         pExynosComponent->transientState = EXYNOS_OMX_TransStateMax;
         pExynosComponent->currentState   = OMX_StateLoaded;
 
+        Exynos_OMX_StateSetDone(pExynosComponent, OMX_StateIdle, OMX_StateLoaded);
+
         if (pExynosComponent->pCallbacks != NULL) {
             Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] OMX_EventCmdComplete(OMX_StateLoaded)", pExynosComponent, __FUNCTION__);
 
@@ -1480,6 +1526,8 @@ static OMX_ERRORTYPE Exynos_OMX_EventHandler(
         pExynosComponent->transientState = EXYNOS_OMX_TransStateMax;
         pExynosComponent->currentState   = OMX_StateIdle;
 
+        Exynos_OMX_StateSetDone(pExynosComponent, OMX_StateLoaded, OMX_StateIdle);
+
         if (pExynosComponent->pCallbacks != NULL) {
             Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] OMX_EventCmdComplete(OMX_StateIdle)", pExynosComponent, __FUNCTION__);
 
@@ -2138,6 +2186,57 @@ EXIT:
     return ret;
 }
 
+/* never takes a port or queue mutex, so it is safe to call while the pipeline is stuck */
+void Exynos_OMX_GetPipelineMetrics(
+    EXYNOS_OMX_BASECOMPONENT                    *pExynosComponent,
+    EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS    *pMetrics)
+{
+    EXYNOS_OMX_PIPELINE_METRICS *pCounter = &pExynosComponent->metrics;
+    EXYNOS_OMX_BASEPORT         *pInputPort  = NULL;
+    EXYNOS_OMX_BASEPORT         *pOutputPort = NULL;
+    OMX_S32                      nHeld       = 0;
+    int i;
+
+    pMetrics->nInputQueued          = 0;
+    pMetrics->nOutputQueued         = 0;
+    pMetrics->nInputCodecQueued     = 0;
+    pMetrics->nOutputCodecQueued    = 0;
+
+    if (pExynosComponent->pExynosPort != NULL) {
+        pInputPort  = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+        pOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+        pMetrics->nInputQueued  = (OMX_U32)Exynos_OSAL_PeekElemNum(&pInputPort->bufferQ);
+        pMetrics->nOutputQueued = (OMX_U32)Exynos_OSAL_PeekElemNum(&pOutputPort->bufferQ);
+
+        if (pInputPort->bufferProcessType & BUFFER_COPY)
+            pMetrics->nInputCodecQueued = (OMX_U32)Exynos_OSAL_PeekElemNum(&pInputPort->codecBufferQ);
+        if (pOutputPort->bufferProcessType & BUFFER_COPY)
+            pMetrics->nOutputCodecQueued = (OMX_U32)Exynos_OSAL_PeekElemNum(&pOutputPort->codecBufferQ);
+    }
+
+    /* in/out are counted on different threads, a momentary negative value means empty */
+    nHeld = EXYNOS_OMX_METRIC_GET(pCounter->nHeldByCodec[INPUT_PORT_INDEX]);
+    pMetrics->nInputHeldByCodec  = (nHeld > 0)? (OMX_U32)nHeld:0;
+    nHeld = EXYNOS_OMX_METRIC_GET(pCounter->nHeldByCodec[OUTPUT_PORT_INDEX]);
+    pMetrics->nOutputHeldByCodec = (nHeld > 0)? (OMX_U32)nHeld:0;
+
+    pMetrics->nPendingConfigs = (OMX_U32)Exynos_OSAL_PeekElemNum(&pExynosComponent->dynamicConfigQ);
+
+    pMetrics->nReorderSlots = 0;
+    for (i = 0; i < MAX_TIMESTAMP; i++) {
+        if (pExynosComponent->bTimestampSlotUsed[i] == OMX_TRUE)
+            pMetrics->nReorderSlots++;
+    }
+
+    pMetrics->nInputFrames      = EXYNOS_OMX_METRIC_GET(pCounter->nInputFrames);
+    pMetrics->nOutputFrames     = EXYNOS_OMX_METRIC_GET(pCounter->nOutputFrames);
+    pMetrics->nDroppedFrames    = EXYNOS_OMX_METRIC_GET(pCounter->nDroppedFrames);
+    pMetrics->nErrors           = EXYNOS_OMX_METRIC_GET(pCounter->nErrors);
+    pMetrics->nInputCopiedKB    = (OMX_U32)(EXYNOS_OMX_METRIC_GET(pCounter->nCopiedBytes[INPUT_PORT_INDEX]) >> 10);
+    pMetrics->nOutputCopiedKB   = (OMX_U32)(EXYNOS_OMX_METRIC_GET(pCounter->nCopiedBytes[OUTPUT_PORT_INDEX]) >> 10);
+}
+
 OMX_ERRORTYPE Exynos_OMX_GetConfig(
     OMX_IN OMX_HANDLETYPE hComponent,
     OMX_IN OMX_INDEXTYPE  nConfigIndex,
@@ -2178,7 +2277,20 @@ OMX_ERRORTYPE Exynos_OMX_GetConfig(
         goto EXIT;
     }
 
-    switch (nConfigIndex) {
+    switch ((int)nConfigIndex) {
+    case OMX_IndexConfigVideoPipelineMetrics:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *pMetrics = (EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *)pConfigs;
+
+        ret = Exynos_OMX_Check_SizeVersion(pMetrics, sizeof(EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        Exynos_OMX_GetPipelineMetrics(pExynosComponent, pMetrics);
+    }
+        break;
     default:
         ret = OMX_ErrorUnsupportedIndex;
         break;
@@ -2231,7 +2343,20 @@ OMX_ERRORTYPE Exynos_OMX_SetConfig(
         goto EXIT;
     }
 
-    switch (nConfigIndex) {
+    switch ((int)nConfigIndex) {
+    case OMX_IndexConfigBufferBatch:
+    {
+        EXYNOS_OMX_CONFIG_BUFFER_BATCH *pBatch = (EXYNOS_OMX_CONFIG_BUFFER_BATCH *)pConfigs;
+
+        ret = Exynos_OMX_Check_SizeVersion(pBatch, sizeof(EXYNOS_OMX_CONFIG_BUFFER_BATCH));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        ret = Exynos_OMX_SubmitBufferBatch(hComponent, pBatch);
+    }
+        break;
     default:
         ret = OMX_ErrorUnsupportedIndex;
         break;
@@ -2287,6 +2412,18 @@ OMX_ERRORTYPE Exynos_OMX_GetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_VIDEO_PIPELINE_METRICS) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigVideoPipelineMetrics;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_BUFFER_BATCH) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigBufferBatch;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
     ret = OMX_ErrorBadParameter;
 
 EXIT:
@@ -2374,9 +2511,6 @@ void Exynos_OMX_Component_AbnormalTermination(OMX_HANDLETYPE hComponent)
 {
     OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
     EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
-    EXYNOS_OMX_BASEPORT      *pExynosPort      = NULL;
-
-    int i = 0;
 
     FunctionIn();
 
@@ -2405,6 +2539,444 @@ EXIT:
     return;
 }
 
+OMX_ERRORTYPE Exynos_OMX_HDR10PlusRing_Put(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nTag,
+    OMX_TICKS                 timeStamp,
+    OMX_PTR                   pHDR10PlusInfo)
+{
+    OMX_ERRORTYPE                    ret    = OMX_ErrorNone;
+    EXYNOS_OMX_VIDEO_HDR10PLUS_RING *pRing  = NULL;
+    EXYNOS_OMX_VIDEO_HDR10PLUS_INFO *pEntry = NULL;
+
+    FunctionIn();
+
+    if ((pExynosComponent == NULL) ||
+        (pHDR10PlusInfo == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    pRing  = &pExynosComponent->HDR10plusRing;
+    pEntry = &pRing->entry[nTag % MAX_HDR10PLUS_RING_NUM];
+
+    /* the ring owns the payload from here on, so no copy is made */
+    Exynos_OSAL_MutexLock(pRing->hMutex);
+
+    if (pEntry->bOccupied == OMX_TRUE) {
+        /* the frame owning this tag has never been output */
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] drop stale HDR10+ info(tag: %d, timestamp: %lld)",
+                                            pExynosComponent, __FUNCTION__, pEntry->nTag, pEntry->timeStamp);
+        Exynos_OSAL_Free(pEntry->pHDR10PlusInfo);
+        pRing->nCount--;
+    }
+
+    pEntry->bOccupied      = OMX_TRUE;
+    pEntry->nTag           = nTag;
+    pEntry->timeStamp      = timeStamp;
+    pEntry->pHDR10PlusInfo = pHDR10PlusInfo;
+    pRing->nCount++;
+
+    Exynos_OSAL_MutexUnlock(pRing->hMutex);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+OMX_PTR Exynos_OMX_HDR10PlusRing_Get(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nTag,
+    OMX_TICKS                 timeStamp)
+{
+    EXYNOS_OMX_VIDEO_HDR10PLUS_RING *pRing          = NULL;
+    EXYNOS_OMX_VIDEO_HDR10PLUS_INFO *pEntry         = NULL;
+    OMX_PTR                          pHDR10PlusInfo = NULL;
+
+    FunctionIn();
+
+    if (pExynosComponent == NULL)
+        goto EXIT;
+
+    pRing  = &pExynosComponent->HDR10plusRing;
+    pEntry = &pRing->entry[nTag % MAX_HDR10PLUS_RING_NUM];
+
+    Exynos_OSAL_MutexLock(pRing->hMutex);
+
+    if ((pEntry->bOccupied == OMX_TRUE) &&
+        (pEntry->nTag == nTag)) {
+        if (pEntry->timeStamp == timeStamp) {
+            /* ownership moves to the caller */
+            pHDR10PlusInfo = pEntry->pHDR10PlusInfo;
+
+            pEntry->bOccupied      = OMX_FALSE;
+            pEntry->pHDR10PlusInfo = NULL;
+            pRing->nCount--;
+        } else {
+            /* a later frame reused this tag, its info stays for it */
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] HDR10+ info of tag(%d) is for timestamp %lld, not %lld",
+                                                pExynosComponent, __FUNCTION__, nTag, pEntry->timeStamp, timeStamp);
+        }
+    }
+
+    Exynos_OSAL_MutexUnlock(pRing->hMutex);
+
+EXIT:
+    FunctionOut();
+
+    return pHDR10PlusInfo;
+}
+
+void Exynos_OMX_HDR10PlusRing_Flush(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
+{
+    EXYNOS_OMX_VIDEO_HDR10PLUS_RING *pRing = NULL;
+    int i;
+
+    FunctionIn();
+
+    if (pExynosComponent == NULL)
+        goto EXIT;
+
+    pRing = &pExynosComponent->HDR10plusRing;
+
+    Exynos_OSAL_MutexLock(pRing->hMutex);
+
+    for (i = 0; (i < MAX_HDR10PLUS_RING_NUM) && (pRing->nCount > 0); i++) {
+        if (pRing->entry[i].bOccupied == OMX_TRUE) {
+            Exynos_OSAL_Free(pRing->entry[i].pHDR10PlusInfo);
+            pRing->entry[i].pHDR10PlusInfo = NULL;
+            pRing->entry[i].bOccupied      = OMX_FALSE;
+            pRing->nCount--;
+        }
+    }
+
+    Exynos_OSAL_MutexUnlock(pRing->hMutex);
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_Trace_SendCommand(
+    OMX_IN OMX_HANDLETYPE   hComponent,
+    OMX_IN OMX_COMMANDTYPE  Cmd,
+    OMX_IN OMX_U32          nParam,
+    OMX_IN OMX_PTR          pCmdData)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    /* pCmdData is only a mark, its contents are meaningless in another process */
+    Exynos_OSAL_TraceCall(pExynosComponent->hTrace, TRACE_CALL_SEND_COMMAND, (OMX_U32)Cmd, nParam, NULL, 0);
+
+    ret = pExynosComponent->traceEntry.SendCommand(hComponent, Cmd, nParam, pCmdData);
+
+EXIT:
+    return ret;
+}
+
+/* a replay runs in another process, so no address is recorded */
+static void Exynos_OMX_Trace_Structure(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    TRACE_CALL_TYPE           eType,
+    OMX_INDEXTYPE             nIndex,
+    OMX_PTR                   pStructure)
+{
+    OMX_PTR pRecord = pStructure;
+    OMX_U32 nSize   = 0;
+
+    if (pStructure == NULL) {
+        Exynos_OSAL_TraceCall(pExynosComponent->hTrace, eType, (OMX_U32)nIndex, 0, NULL, 0);
+        return;
+    }
+
+    /* every OMX structure starts with nSize */
+    nSize = *((OMX_U32 *)pStructure);
+
+    switch ((int)nIndex) {
+    case OMX_IndexParamPortDefinition:
+    {
+        OMX_PARAM_PORTDEFINITIONTYPE *pPortDef = NULL;
+
+        if (nSize != sizeof(OMX_PARAM_PORTDEFINITIONTYPE))
+            break;
+
+        /* the replay puts back the component's own pointers */
+        pRecord = Exynos_OSAL_Malloc(nSize);
+        if (pRecord == NULL)
+            return;
+
+        Exynos_OSAL_Memcpy(pRecord, pStructure, nSize);
+        pPortDef = (OMX_PARAM_PORTDEFINITIONTYPE *)pRecord;
+
+        switch (pPortDef->eDomain) {
+        case OMX_PortDomainAudio:
+            pPortDef->format.audio.cMIMEType     = NULL;
+            pPortDef->format.audio.pNativeRender = NULL;
+            break;
+        case OMX_PortDomainVideo:
+            pPortDef->format.video.cMIMEType     = NULL;
+            pPortDef->format.video.pNativeRender = NULL;
+            pPortDef->format.video.pNativeWindow = NULL;
+            break;
+        case OMX_PortDomainImage:
+            pPortDef->format.image.cMIMEType     = NULL;
+            pPortDef->format.image.pNativeRender = NULL;
+            pPortDef->format.image.pNativeWindow = NULL;
+            break;
+        default:
+            break;
+        }
+    }
+        break;
+    case OMX_IndexConfigVideoRoiInfo:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *pRoiInfo       = (EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *)pStructure;
+        OMX_S32                          nRoiMBInfoSize = 0;
+
+        if (nSize != sizeof(EXYNOS_OMX_VIDEO_CONFIG_ROIINFO))
+            break;
+
+        if ((pRoiInfo->bUseRoiInfo == OMX_TRUE) &&
+            (pRoiInfo->pRoiMBInfo != NULL) &&
+            (pRoiInfo->nRoiMBInfoSize > 0))
+            nRoiMBInfoSize = pRoiInfo->nRoiMBInfoSize;
+
+        /* the MB info follows the structure, as in Exynos_OMX_MakeDynamicConfig */
+        pRecord = Exynos_OSAL_Malloc(nSize + nRoiMBInfoSize);
+        if (pRecord == NULL)
+            return;
+
+        Exynos_OSAL_Memcpy(pRecord, pStructure, nSize);
+        Exynos_OSAL_Memcpy((OMX_PTR)((OMX_U8 *)pRecord + nSize), pRoiInfo->pRoiMBInfo, nRoiMBInfoSize);
+        ((EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *)pRecord)->pRoiMBInfo = NULL;
+
+        nSize += nRoiMBInfoSize;
+    }
+        break;
+    case OMX_IndexParamUseAndroidNativeBuffer:
+    case OMX_IndexParamUseAndroidNativeBuffer2:
+        /* a native buffer can not be replayed, the call is recorded without its structure */
+        nSize   = 0;
+        pRecord = NULL;
+        break;
+    default:
+        break;
+    }
+
+    Exynos_OSAL_TraceCall(pExynosComponent->hTrace, eType, (OMX_U32)nIndex, 0, pRecord, nSize);
+
+    if ((pRecord != NULL) &&
+        (pRecord != pStructure))
+        Exynos_OSAL_Free(pRecord);
+}
+
+static OMX_ERRORTYPE Exynos_OMX_Trace_SetParameter(
+    OMX_IN OMX_HANDLETYPE   hComponent,
+    OMX_IN OMX_INDEXTYPE    nIndex,
+    OMX_IN OMX_PTR          pParams)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OMX_Trace_Structure(pExynosComponent, TRACE_CALL_SET_PARAMETER, nIndex, pParams);
+
+    ret = pExynosComponent->traceEntry.SetParameter(hComponent, nIndex, pParams);
+
+EXIT:
+    return ret;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_Trace_SetConfig(
+    OMX_IN OMX_HANDLETYPE   hComponent,
+    OMX_IN OMX_INDEXTYPE    nIndex,
+    OMX_IN OMX_PTR          pConfigs)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (((int)nIndex == OMX_IndexConfigBufferBatch) &&
+        (pConfigs != NULL)) {
+        /* recorded as the individual calls, the header pointers mean nothing to a replay */
+        EXYNOS_OMX_CONFIG_BUFFER_BATCH *pBatch  = (EXYNOS_OMX_CONFIG_BUFFER_BATCH *)pConfigs;
+        OMX_BOOL                        bSecure = OMX_FALSE;
+        OMX_U32                         i;
+
+        if ((pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC) ||
+            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC) ||
+            (pBatch->nPortIndex != INPUT_PORT_INDEX))
+            bSecure = OMX_TRUE;
+
+        for (i = 0; (i < pBatch->nCount) && (i < EXYNOS_OMX_BUFFER_BATCH_MAX); i++) {
+            if (pBatch->pBuffers[i] != NULL)
+                Exynos_OSAL_TraceBuffer(pExynosComponent->hTrace,
+                                        (pBatch->nPortIndex == INPUT_PORT_INDEX)? TRACE_CALL_EMPTY_THIS_BUFFER:TRACE_CALL_FILL_THIS_BUFFER,
+                                        pBatch->pBuffers[i], bSecure);
+        }
+    } else {
+        Exynos_OMX_Trace_Structure(pExynosComponent, TRACE_CALL_SET_CONFIG, nIndex, pConfigs);
+    }
+
+    ret = pExynosComponent->traceEntry.SetConfig(hComponent, nIndex, pConfigs);
+
+EXIT:
+    return ret;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_Trace_EmptyThisBuffer(
+    OMX_IN OMX_HANDLETYPE        hComponent,
+    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+    OMX_BOOL                  bSecure          = OMX_FALSE;
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if ((pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC) ||
+        (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC))
+        bSecure = OMX_TRUE;
+
+    Exynos_OSAL_TraceBuffer(pExynosComponent->hTrace, TRACE_CALL_EMPTY_THIS_BUFFER, pBuffer, bSecure);
+
+    ret = pExynosComponent->traceEntry.EmptyThisBuffer(hComponent, pBuffer);
+
+EXIT:
+    return ret;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_Trace_FillThisBuffer(
+    OMX_IN OMX_HANDLETYPE        hComponent,
+    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OSAL_TraceBuffer(pExynosComponent->hTrace, TRACE_CALL_FILL_THIS_BUFFER, pBuffer, OMX_TRUE);
+
+    ret = pExynosComponent->traceEntry.FillThisBuffer(hComponent, pBuffer);
+
+EXIT:
+    return ret;
+}
+
+/* called by the core once the component is fully set up, the entry points are final by then */
+OMX_ERRORTYPE Exynos_OMX_TraceAttach(
+    OMX_IN OMX_HANDLETYPE   hComponent,
+    OMX_IN OMX_STRING       componentName)
+{
+    OMX_ERRORTYPE             ret              = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    FunctionIn();
+
+    if (hComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (pExynosComponent->hTrace != NULL)
+        goto EXIT;
+
+    ret = Exynos_OSAL_TraceCreate(&pExynosComponent->hTrace, componentName, (OMX_PTR)pExynosComponent);
+    if ((ret != OMX_ErrorNone) ||
+        (pExynosComponent->hTrace == NULL)) {
+        /* tracing is best effort, the component works as usual */
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    pExynosComponent->traceEntry.SendCommand     = pOMXComponent->SendCommand;
+    pExynosComponent->traceEntry.SetParameter    = pOMXComponent->SetParameter;
+    pExynosComponent->traceEntry.SetConfig       = pOMXComponent->SetConfig;
+    pExynosComponent->traceEntry.EmptyThisBuffer = pOMXComponent->EmptyThisBuffer;
+    pExynosComponent->traceEntry.FillThisBuffer  = pOMXComponent->FillThisBuffer;
+
+    pOMXComponent->SendCommand     = &Exynos_OMX_Trace_SendCommand;
+    pOMXComponent->SetParameter    = &Exynos_OMX_Trace_SetParameter;
+    pOMXComponent->SetConfig       = &Exynos_OMX_Trace_SetConfig;
+    pOMXComponent->EmptyThisBuffer = &Exynos_OMX_Trace_EmptyThisBuffer;
+    pOMXComponent->FillThisBuffer  = &Exynos_OMX_Trace_FillThisBuffer;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE Exynos_OMX_BaseComponent_Constructor(
     OMX_IN OMX_HANDLETYPE hComponent)
 {
@@ -2459,6 +3031,13 @@ OMX_ERRORTYPE Exynos_OMX_BaseComponent_Constructor(
         goto EXIT;
     }
 
+    ret = Exynos_OSAL_ConditionCreate(&pExynosComponent->hStateCondition);
+    if (ret != OMX_ErrorNone) {
+        ret = OMX_ErrorInsufficientResources;
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to ConditionCreate (0x%x)", pExynosComponent, __FUNCTION__, ret);
+        goto EXIT;
+    }
+
     pExynosComponent->bExitMessageHandlerThread = OMX_FALSE;
     Exynos_OSAL_QueueCreate(&pExynosComponent->messageQ, MAX_QUEUE_ELEMENTS);
     ret = Exynos_OSAL_ThreadCreate(&pExynosComponent->hMessageHandler, Exynos_OMX_MessageHandlerThread, pOMXComponent);
@@ -2472,6 +3051,16 @@ OMX_ERRORTYPE Exynos_OMX_BaseComponent_Constructor(
 
     Exynos_OSAL_QueueCreate(&pExynosComponent->HDR10plusConfigQ, MAX_QUEUE_ELEMENTS);
 
+    Exynos_OSAL_Memset(&pExynosComponent->HDR10plusRing, 0, sizeof(pExynosComponent->HDR10plusRing));
+    ret = Exynos_OSAL_MutexCreate(&pExynosComponent->HDR10plusRing.hMutex);
+    if (ret != OMX_ErrorNone) {
+        ret = OMX_ErrorInsufficientResources;
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to MutexCreate (0x%x)", pExynosComponent, __FUNCTION__, ret);
+        goto EXIT;
+    }
+
+    Exynos_OSAL_BenchCreate(&pExynosComponent->hBench, (OMX_PTR)pExynosComponent);
+
     pOMXComponent->GetComponentVersion = &Exynos_OMX_GetComponentVersion;
     pOMXComponent->SendCommand         = &Exynos_OMX_SendCommand;
     pOMXComponent->GetState            = &Exynos_OMX_GetState;
@@ -2523,6 +3112,10 @@ OMX_ERRORTYPE Exynos_OMX_BaseComponent_Destructor(
     }
     Exynos_OSAL_QueueTerminate(&pExynosComponent->HDR10plusConfigQ);
 
+    Exynos_OMX_HDR10PlusRing_Flush(pExynosComponent);
+    Exynos_OSAL_MutexTerminate(pExynosComponent->HDR10plusRing.hMutex);
+    pExynosComponent->HDR10plusRing.hMutex = NULL;
+
     Exynos_OMX_CommandQueue(pExynosComponent, (OMX_COMMANDTYPE)EXYNOS_OMX_CommandComponentDeInit, 0, NULL);
     Exynos_OSAL_SleepMillisec(0);
     Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->hSemaMsgWait, &semaValue);
@@ -2533,6 +3126,13 @@ OMX_ERRORTYPE Exynos_OMX_BaseComponent_Destructor(
     Exynos_OSAL_ThreadTerminate(pExynosComponent->hMessageHandler);
     pExynosComponent->hMessageHandler = NULL;
 
+    Exynos_OSAL_BenchTerminate(&pExynosComponent->hBench);
+    Exynos_OSAL_TraceTerminate(&pExynosComponent->hTrace);
+
+
+    Exynos_OSAL_ConditionTerminate(pExynosComponent->hStateCondition);
+    pExynosComponent->hStateCondition = NULL;
+
     Exynos_OSAL_MutexTerminate(pExynosComponent->compEventMutex);
     pExynosComponent->compMutex = NULL;
 
@@ -51,6 +51,33 @@ typedef struct _EXYNOS_OMX_TIMESTAMP
     OMX_U32   nStartFlags;
 } EXYNOS_OMX_TIMESTAMP;
 
+/* entry points replaced by the call tracer, see Exynos_OMX_TraceAttach */
+typedef struct _EXYNOS_OMX_TRACE_ENTRY
+{
+    OMX_ERRORTYPE (*SendCommand)(OMX_HANDLETYPE hComponent, OMX_COMMANDTYPE Cmd, OMX_U32 nParam1, OMX_PTR pCmdData);
+    OMX_ERRORTYPE (*SetParameter)(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pComponentParameterStructure);
+    OMX_ERRORTYPE (*SetConfig)(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pComponentConfigStructure);
+    OMX_ERRORTYPE (*EmptyThisBuffer)(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer);
+    OMX_ERRORTYPE (*FillThisBuffer)(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer);
+} EXYNOS_OMX_TRACE_ENTRY;
+
+/* live counters for OMX_IndexConfigVideoPipelineMetrics, only touched through EXYNOS_OMX_METRIC_* */
+typedef struct _EXYNOS_OMX_PIPELINE_METRICS
+{
+    OMX_S32 nHeldByCodec[ALL_PORT_NUM];
+    OMX_U32 nInputFrames;
+    OMX_U32 nOutputFrames;
+    OMX_U32 nDroppedFrames;
+    OMX_U32 nErrors;
+    OMX_U64 nCopiedBytes[ALL_PORT_NUM];    /* copies between client and codec buffers */
+} EXYNOS_OMX_PIPELINE_METRICS;
+
+#define EXYNOS_OMX_METRIC_INC(x)        __atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED)
+#define EXYNOS_OMX_METRIC_DEC(x)        __atomic_sub_fetch(&(x), 1, __ATOMIC_RELAXED)
+#define EXYNOS_OMX_METRIC_ADD(x, v)     __atomic_add_fetch(&(x), (v), __ATOMIC_RELAXED)
+#define EXYNOS_OMX_METRIC_SET(x, v)     __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#define EXYNOS_OMX_METRIC_GET(x)        __atomic_load_n(&(x), __ATOMIC_RELAXED)
+
 typedef struct _EXYNOS_OMX_BASECOMPONENT
 {
     OMX_STRING                  componentName;
@@ -59,6 +86,7 @@ typedef struct _EXYNOS_OMX_BASECOMPONENT
 
     OMX_STATETYPE               currentState;
     EXYNOS_OMX_TRANS_STATETYPE  transientState;
+    OMX_U64                     nStateSetTimeUs;    /* when the last StateSet was requested */
     OMX_BOOL                    abendState;
 
     EXYNOS_CODEC_TYPE           codecType;
@@ -66,6 +94,7 @@ typedef struct _EXYNOS_OMX_BASECOMPONENT
     OMX_MARKTYPE                propagateMarkType;
     OMX_HANDLETYPE              compMutex;
     OMX_HANDLETYPE              compEventMutex;
+    OMX_HANDLETYPE              hStateCondition;    /* buffer process threads wait on it while paused */
 
     OMX_HANDLETYPE              hComponentHandle;
 
@@ -99,7 +128,7 @@ typedef struct _EXYNOS_OMX_BASECOMPONENT
 
     /* HDR10+ */
     EXYNOS_QUEUE                     HDR10plusConfigQ;
-    EXYNOS_OMX_VIDEO_HDR10PLUS_INFO  HDR10plusList[MAX_BUFFER_REF];
+    EXYNOS_OMX_VIDEO_HDR10PLUS_RING  HDR10plusRing;
 
     OMX_BOOL bUseFlagEOF;
     OMX_BOOL bSaveFlagEOS;    /* bSaveFlagEOS is OMX_TRUE, if EOS flag is incoming. */
@@ -107,12 +136,20 @@ typedef struct _EXYNOS_OMX_BASECOMPONENT
 
     OMX_PTR                     vendorExts[MAX_VENDOR_EXT_NUM];
 
+    /* throughput/latency statistics, NULL unless debug.omx.bench is set */
+    OMX_HANDLETYPE              hBench;
+    EXYNOS_OMX_PIPELINE_METRICS metrics;
+
+    /* OMX call trace, NULL unless debug.omx.trace is set */
+    OMX_HANDLETYPE              hTrace;
+    EXYNOS_OMX_TRACE_ENTRY      traceEntry;
+
     OMX_ERRORTYPE (*exynos_codec_componentInit)(OMX_COMPONENTTYPE *pOMXComponent);
     OMX_ERRORTYPE (*exynos_codec_componentTerminate)(OMX_COMPONENTTYPE *pOMXComponent);
 
 #ifdef TUNNELING_SUPPORT
-    OMX_ERRORTYPE (*exynos_AllocateTunnelBuffer)(EXYNOS_OMX_BASEPORT *pOMXBasePort, OMX_U32 nPortIndex);
-    OMX_ERRORTYPE (*exynos_FreeTunnelBuffer)(EXYNOS_OMX_BASEPORT *pOMXBasePort, OMX_U32 nPortIndex);
+    OMX_ERRORTYPE (*exynos_AllocateTunnelBuffer)(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
+    OMX_ERRORTYPE (*exynos_FreeTunnelBuffer)(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
 #endif
 
     OMX_ERRORTYPE (*exynos_BufferProcessCreate)(OMX_HANDLETYPE pOMXComponent);
@@ -130,6 +167,10 @@ OMX_ERRORTYPE Exynos_OMX_SetParameter(
     OMX_INDEXTYPE  nParamIndex,
     OMX_PTR        pParams);
 
+void Exynos_OMX_GetPipelineMetrics(
+    EXYNOS_OMX_BASECOMPONENT                    *pExynosComponent,
+    EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS    *pMetrics);
+
 OMX_ERRORTYPE Exynos_OMX_GetConfig(
     OMX_HANDLETYPE hComponent,
     OMX_INDEXTYPE  nConfigIndex,
@@ -150,6 +191,7 @@ OMX_ERRORTYPE Exynos_OMX_SendEventCommand(EXYNOS_OMX_BASECOMPONENT *pExynosCompo
 void Exynos_OMX_Component_AbnormalTermination(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_BaseComponent_Constructor(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_BaseComponent_Destructor(OMX_HANDLETYPE hComponent);
+OMX_ERRORTYPE Exynos_OMX_TraceAttach(OMX_HANDLETYPE hComponent, OMX_STRING componentName);
 
 
 #ifdef __cplusplus
@@ -157,6 +199,13 @@ extern "C" {
 #endif
 
 OMX_ERRORTYPE Exynos_OMX_Check_SizeVersion(OMX_PTR header, OMX_U32 size);
+void Exynos_OMX_NotifyStateChange(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
+void Exynos_OMX_WakeBufferProcess(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_S32 nPortIndex);
+OMX_BOOL Exynos_OMX_BufferProcess_Yield(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex);
+
+OMX_ERRORTYPE Exynos_OMX_HDR10PlusRing_Put(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nTag, OMX_TICKS timeStamp, OMX_PTR pHDR10PlusInfo);
+OMX_PTR Exynos_OMX_HDR10PlusRing_Get(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nTag, OMX_TICKS timeStamp);
+void Exynos_OMX_HDR10PlusRing_Flush(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
 
 
 #ifdef __cplusplus
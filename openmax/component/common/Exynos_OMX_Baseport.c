@@ -35,6 +35,9 @@
 #include "Exynos_OSAL_Semaphore.h"
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_Bench.h"
+#include "Exynos_OSAL_Thread.h"
 
 #include "Exynos_OMX_Baseport.h"
 #include "Exynos_OMX_Basecomponent.h"
@@ -44,13 +47,125 @@
 //#define EXYNOS_LOG_OFF
 #include "Exynos_OSAL_Log.h"
 
-#ifdef PERFORMANCE_DEBUG
-#include "Exynos_OSAL_ETC.h"
-#endif
-
 #include "Exynos_OSAL_Platform.h"
 
 
+#ifdef TUNNELING_SUPPORT
+static OMX_ERRORTYPE Exynos_OMX_QueueClientBuffer(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex, OMX_BUFFERHEADERTYPE *pBuffer);
+
+/* a frame done on a supplier port goes to the peer instead of FillBufferDone */
+static OMX_ERRORTYPE Exynos_OMX_TunnelDeliverBuffer(
+    OMX_COMPONENTTYPE    *pOMXComponent,
+    OMX_BUFFERHEADERTYPE *bufferHeader)
+{
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pExynosPort       = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    EXYNOS_OMX_TUNNEL_BUFFER *pTunnelBuffer     = (EXYNOS_OMX_TUNNEL_BUFFER *)bufferHeader->pOutputPortPrivate;
+    OMX_BUFFERHEADERTYPE     *pPeerHeader       = NULL;
+    OMX_BOOL                  bQueued           = OMX_FALSE;
+
+    if (pTunnelBuffer == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] bufferHeader(%p) is not a tunnel buffer", pExynosComponent, __FUNCTION__, bufferHeader);
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pPeerHeader = pTunnelBuffer->pPeerHeader;
+
+    /* the supplier keeps its buffers while it is flushed or stopped */
+    if (CHECK_PORT_BEING_FLUSHED(pExynosPort) ||
+        CHECK_PORT_BEING_DISABLED(pExynosPort) ||
+        (pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle)) {
+        pTunnelBuffer->bHeld = OMX_TRUE;
+        goto EXIT;
+    }
+
+    /* an empty frame is not worth a round trip, it goes back to the supplier port right away */
+    if ((bufferHeader->nFilledLen == 0) &&
+        !(bufferHeader->nFlags & OMX_BUFFERFLAG_EOS)) {
+        bufferHeader->nOffset = 0;
+        bufferHeader->nFlags  = 0;
+
+        Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+        bQueued = (Exynos_OMX_QueueClientBuffer(pExynosComponent, OUTPUT_PORT_INDEX, bufferHeader) == OMX_ErrorNone)? OMX_TRUE:OMX_FALSE;
+        if (bQueued == OMX_TRUE)
+            Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+        else
+            pTunnelBuffer->bHeld = OMX_TRUE;
+        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+
+        if (bQueued == OMX_TRUE)
+            Exynos_OMX_WakeBufferProcess(pExynosComponent, OUTPUT_PORT_INDEX);
+
+        goto EXIT;
+    }
+
+    pPeerHeader->nFilledLen           = bufferHeader->nFilledLen;
+    pPeerHeader->nOffset              = bufferHeader->nOffset;
+    pPeerHeader->nFlags               = bufferHeader->nFlags;
+    pPeerHeader->nTimeStamp           = bufferHeader->nTimeStamp;
+    pPeerHeader->nTickCount           = bufferHeader->nTickCount;
+    pPeerHeader->hMarkTargetComponent = bufferHeader->hMarkTargetComponent;
+    pPeerHeader->pMarkData            = bufferHeader->pMarkData;
+
+    __atomic_add_fetch(&pTunnelBuffer->nRefCount, 1, __ATOMIC_ACQ_REL);
+
+    ret = OMX_EmptyThisBuffer(pExynosPort->tunneledComponent, pPeerHeader);
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] peer refused bufferHeader(%p) (0x%x), keeps it",
+                                            pExynosComponent, __FUNCTION__, pPeerHeader, ret);
+        __atomic_sub_fetch(&pTunnelBuffer->nRefCount, 1, __ATOMIC_ACQ_REL);
+        pTunnelBuffer->bHeld = OMX_TRUE;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader: %p -> peer(%p)", pExynosComponent, __FUNCTION__, bufferHeader, pPeerHeader);
+
+EXIT:
+    return ret;
+}
+
+/* a frame consumed on a non-supplier port goes back to the supplier instead of EmptyBufferDone */
+static OMX_ERRORTYPE Exynos_OMX_TunnelReturnBuffer(
+    OMX_COMPONENTTYPE    *pOMXComponent,
+    OMX_BUFFERHEADERTYPE *bufferHeader)
+{
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pExynosPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_TUNNEL_BUFFER *pTunnelBuffer     = (EXYNOS_OMX_TUNNEL_BUFFER *)bufferHeader->pOutputPortPrivate;
+    OMX_BUFFERHEADERTYPE     *pSupplierHeader   = NULL;
+
+    if (pTunnelBuffer == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] bufferHeader(%p) is not a tunnel buffer", pExynosComponent, __FUNCTION__, bufferHeader);
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pSupplierHeader = pTunnelBuffer->pSupplierHeader;
+
+    __atomic_sub_fetch(&pTunnelBuffer->nRefCount, 1, __ATOMIC_ACQ_REL);
+
+    pSupplierHeader->nFilledLen = 0;
+    pSupplierHeader->nOffset    = 0;
+
+    ret = OMX_FillThisBuffer(pExynosPort->tunneledComponent, pSupplierHeader);
+    if (ret != OMX_ErrorNone) {
+        /* the supplier takes it back with the rest when the port restarts or is freed */
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] supplier refused bufferHeader(%p) (0x%x)",
+                                            pExynosComponent, __FUNCTION__, pSupplierHeader, ret);
+        pTunnelBuffer->bHeld = OMX_TRUE;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader: %p -> supplier(%p)", pExynosComponent, __FUNCTION__, bufferHeader, pSupplierHeader);
+
+EXIT:
+    return ret;
+}
+#endif
+
 OMX_ERRORTYPE Exynos_OMX_InputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OMX_BUFFERHEADERTYPE* bufferHeader)
 {
     OMX_ERRORTYPE             ret = OMX_ErrorNone;
@@ -82,6 +197,13 @@ OMX_ERRORTYPE Exynos_OMX_InputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OMX
         (bufferHeader != NULL) &&
         (bufferHeader->pBuffer != NULL) &&
         (pExynosComponent->pCallbacks != NULL)) {
+#ifdef TUNNELING_SUPPORT
+        if (CHECK_PORT_TUNNELED(pExynosPort)) {
+            ret = Exynos_OMX_TunnelReturnBuffer(pOMXComponent, bufferHeader);
+            return ret;
+        }
+#endif
+
         pExynosComponent->pCallbacks->EmptyBufferDone(pOMXComponent,
                                                       pExynosComponent->callbackData,
                                                       bufferHeader);
@@ -138,6 +260,28 @@ OMX_ERRORTYPE Exynos_OMX_OutputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OM
         (bufferHeader != NULL) &&
         (bufferHeader->pBuffer != NULL) &&
         (pExynosComponent->pCallbacks != NULL)) {
+        if (bufferHeader->nFilledLen > 0) {
+            if (!(bufferHeader->nFlags & OMX_BUFFERFLAG_CODECCONFIG)) {
+                EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nOutputFrames);
+                Exynos_OSAL_BenchOutput(pExynosComponent->hBench, bufferHeader->nTimeStamp);
+            }
+        } else if (!(bufferHeader->nFlags & OMX_BUFFERFLAG_EOS) &&
+                   !CHECK_PORT_BEING_FLUSHED(pExynosPort) &&
+                   !CHECK_PORT_BEING_DISABLED(pExynosPort)) {
+            /* returned without a frame : discarded by the codec or the drop control */
+            EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nDroppedFrames);
+        }
+
+        if (bufferHeader->nFlags & OMX_BUFFERFLAG_DATACORRUPT)
+            EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nErrors);
+
+#ifdef TUNNELING_SUPPORT
+        if (CHECK_PORT_TUNNELED(pExynosPort)) {
+            ret = Exynos_OMX_TunnelDeliverBuffer(pOMXComponent, bufferHeader);
+            return ret;
+        }
+#endif
+
         pExynosComponent->pCallbacks->FillBufferDone(pOMXComponent,
                                                      pExynosComponent->callbackData,
                                                      bufferHeader);
@@ -148,6 +292,78 @@ OMX_ERRORTYPE Exynos_OMX_OutputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OM
     return ret;
 }
 
+typedef struct _EXYNOS_OMX_PORT_FLUSH {
+    OMX_COMPONENTTYPE  *pOMXComponent;
+    OMX_S32             nPortIndex;
+    OMX_BOOL            bEvent;
+    OMX_ERRORTYPE       ret;
+} EXYNOS_OMX_PORT_FLUSH;
+
+static OMX_ERRORTYPE Exynos_OMX_PortFlush(EXYNOS_OMX_PORT_FLUSH *pFlush)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = (EXYNOS_OMX_BASECOMPONENT *)pFlush->pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pExynosPort       = &(pExynosComponent->pExynosPort[pFlush->nPortIndex]);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] Flush %s Port", pExynosComponent, __FUNCTION__,
+                            (pFlush->nPortIndex == INPUT_PORT_INDEX)? "input":"output");
+    pFlush->ret = pExynosComponent->exynos_BufferFlush(pFlush->pOMXComponent, pFlush->nPortIndex, pFlush->bEvent);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] %s port flush time(us): wakeup(%lu) stop(%lu) header(%lu) drain(%lu) requeue(%lu) start(%lu)",
+                            pExynosComponent, __FUNCTION__, (pFlush->nPortIndex == INPUT_PORT_INDEX)? "input":"output",
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_WAKEUP],
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_STOP],
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_HEADER],
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_DRAIN],
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_REQUEUE],
+                            (unsigned long)pExynosPort->nFlushStepTime[FLUSH_STEP_START]);
+
+    return pFlush->ret;
+}
+
+/* the other port is flushed here while the message handler flushes the input port */
+static OMX_ERRORTYPE Exynos_OMX_PortFlushThread(OMX_PTR threadData)
+{
+    Exynos_OMX_PortFlush((EXYNOS_OMX_PORT_FLUSH *)threadData);
+
+    Exynos_OSAL_ThreadExit(NULL);
+
+    return OMX_ErrorNone;
+}
+
+static void Exynos_OMX_PortFlushDone(EXYNOS_OMX_PORT_FLUSH *pFlush)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent     = pFlush->pOMXComponent;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_S32                   nIndex            = pFlush->nPortIndex;
+
+    if (pFlush->ret != OMX_ErrorNone)
+        return;
+
+    pExynosComponent->pExynosPort[nIndex].portState = EXYNOS_OMX_PortStateIdle;
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
+
+#ifdef TUNNELING_SUPPORT
+    /* a supplier has no client to send the buffers again */
+    if (((pExynosComponent->currentState == OMX_StateExecuting) ||
+         (pExynosComponent->currentState == OMX_StatePause)) &&
+        (pExynosComponent->transientState == EXYNOS_OMX_TransStateMax))
+        Exynos_OMX_TunnelPortRestart(pOMXComponent, nIndex);
+#endif
+
+    if ((pFlush->bEvent == OMX_TRUE) &&
+        (pExynosComponent->pCallbacks != NULL)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] OMX_EventCmdComplete(Flush/%s port)",
+                                        pExynosComponent, __FUNCTION__, (nIndex == INPUT_PORT_INDEX)? "input":"output");
+
+        pExynosComponent->pCallbacks->EventHandler((OMX_HANDLETYPE)pOMXComponent,
+                                                   pExynosComponent->callbackData,
+                                                   OMX_EventCmdComplete,
+                                                   OMX_CommandFlush, nIndex, NULL);
+    }
+
+    return;
+}
+
 OMX_ERRORTYPE Exynos_OMX_BufferFlushProcess(
     OMX_COMPONENTTYPE  *pOMXComponent,
     OMX_S32             nPortIndex,
@@ -156,7 +372,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlushProcess(
     OMX_ERRORTYPE             ret               = OMX_ErrorNone;
     EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
     EXYNOS_OMX_BASEPORT      *pExynosPort       = NULL;
-    OMX_S32                   nIndex            = 0;
+    EXYNOS_OMX_PORT_FLUSH     flush[ALL_PORT_NUM];
+    OMX_HANDLETYPE            hFlushThread      = NULL;
 
     OMX_U32 i, cnt;
 
@@ -179,31 +396,54 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlushProcess(
         goto EXIT;
 
     cnt = (nPortIndex == ALL_PORT_INDEX)? ALL_PORT_NUM:1;
+
     for (i = 0; i < cnt; i++) {
-        if (nPortIndex == ALL_PORT_INDEX)
-            nIndex = i;
-        else
-            nIndex = nPortIndex;
+        flush[i].pOMXComponent  = pOMXComponent;
+        flush[i].nPortIndex     = (nPortIndex == ALL_PORT_INDEX)? (OMX_S32)i:nPortIndex;
+        flush[i].bEvent         = bEvent;
+        flush[i].ret            = OMX_ErrorNone;
+    }
 
-        pExynosPort = &(pExynosComponent->pExynosPort[nIndex]);
+    if (nPortIndex == ALL_PORT_INDEX) {
+        /* wake up the threads of every port at once,
+         * so that the later port is already released while the former is being flushed.
+         */
+        for (i = 0; i < cnt; i++) {
+            OMX_S32 nSemaCnt = 0;
 
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] Flush %s Port", pExynosComponent, __FUNCTION__,
-                                (nIndex == INPUT_PORT_INDEX)? "input":"output");
-        ret = pExynosComponent->exynos_BufferFlush(pOMXComponent, nIndex, bEvent);
-        if (ret == OMX_ErrorNone) {
-            pExynosPort->portState = EXYNOS_OMX_PortStateIdle;
-
-            if ((bEvent == OMX_TRUE) &&
-                (pExynosComponent->pCallbacks != NULL)) {
-                Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] OMX_EventCmdComplete(Flush/%s port)",
-                                                pExynosComponent, __FUNCTION__, (nIndex == INPUT_PORT_INDEX)? "input":"output");
-
-                pExynosComponent->pCallbacks->EventHandler((OMX_HANDLETYPE)pOMXComponent,
-                                                           pExynosComponent->callbackData,
-                                                           OMX_EventCmdComplete,
-                                                           OMX_CommandFlush, nIndex, NULL);
+            pExynosPort = &(pExynosComponent->pExynosPort[i]);
+
+            Exynos_OMX_NotifyStateChange(pExynosComponent);
+
+            if (pExynosPort->bufferSemID != NULL) {
+                Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &nSemaCnt);
+                if (nSemaCnt <= 0)
+                    Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
             }
         }
+
+        /* each port stops, drains and starts its own queue, the output port does it at the same time */
+        if (Exynos_OSAL_ThreadCreate(&hFlushThread,
+                                     Exynos_OMX_PortFlushThread,
+                                     &flush[OUTPUT_PORT_INDEX]) != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] flushes the ports one by one", pExynosComponent, __FUNCTION__);
+            hFlushThread = NULL;
+        }
+    }
+
+    for (i = 0; i < cnt; i++) {
+        if ((hFlushThread != NULL) &&
+            (flush[i].nPortIndex == OUTPUT_PORT_INDEX)) {
+            Exynos_OSAL_ThreadTerminate(hFlushThread);
+            hFlushThread = NULL;
+        } else {
+            Exynos_OMX_PortFlush(&flush[i]);
+        }
+
+        if (flush[i].ret != OMX_ErrorNone)
+            ret = flush[i].ret;
+
+        Exynos_OMX_PortFlushDone(&flush[i]);
     }
 
 EXIT:
@@ -224,6 +464,31 @@ EXIT:
     return ret;
 }
 
+void Exynos_OMX_ResetFlushStepTime(
+    EXYNOS_OMX_BASEPORT *pExynosPort,
+    OMX_U64             *pTimeStamp)
+{
+    Exynos_OSAL_Memset(pExynosPort->nFlushStepTime, 0, sizeof(pExynosPort->nFlushStepTime));
+    *pTimeStamp = Exynos_OSAL_GetSystemTimeUs();
+
+    return;
+}
+
+void Exynos_OMX_SetFlushStepTime(
+    EXYNOS_OMX_BASEPORT     *pExynosPort,
+    EXYNOS_OMX_FLUSH_STEP    eStep,
+    OMX_U64                 *pTimeStamp)
+{
+    OMX_U64 nCurTime = Exynos_OSAL_GetSystemTimeUs();
+
+    if (eStep < FLUSH_STEP_MAX)
+        pExynosPort->nFlushStepTime[eStep] += (OMX_U32)(nCurTime - *pTimeStamp);
+
+    *pTimeStamp = nCurTime;
+
+    return;
+}
+
 OMX_ERRORTYPE Exynos_OMX_DisablePort(
     OMX_COMPONENTTYPE  *pOMXComponent,
     OMX_S32             nPortIndex)
@@ -312,6 +577,7 @@ OMX_ERRORTYPE Exynos_OMX_PortDisableProcess(
                 goto EXIT;
 
             pExynosPort->portState = EXYNOS_OMX_PortStateDisabling;
+            Exynos_OMX_NotifyStateChange(pExynosComponent);
         }
 
         Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] Disable %s Port", pExynosComponent, __FUNCTION__,
@@ -325,6 +591,14 @@ OMX_ERRORTYPE Exynos_OMX_PortDisableProcess(
                         if (pMessage != NULL)
                             Exynos_OSAL_Free(pMessage);
                     }
+
+#ifdef TUNNELING_SUPPORT
+                    if (CHECK_PORT_TUNNELED(pExynosPort)) {
+                        ret = pExynosComponent->exynos_FreeTunnelBuffer(pOMXComponent, nIndex);
+                        if (ret != OMX_ErrorNone)
+                            goto EXIT;
+                    }
+#endif
                 }
 
                 if (pExynosPort->exceptionFlag == NEED_PORT_DISABLE)
@@ -391,8 +665,15 @@ OMX_ERRORTYPE Exynos_OMX_EnablePort(
             if (pExynosPort->semWaitPortEnable[i] != NULL)
                 Exynos_OSAL_SemaphorePost(pExynosPort->semWaitPortEnable[i]);
         }
+        Exynos_OMX_WakeBufferProcess(pExynosComponent, nPortIndex);
     }
 
+#ifdef TUNNELING_SUPPORT
+    if ((pExynosComponent->currentState == OMX_StateExecuting) ||
+        (pExynosComponent->currentState == OMX_StatePause))
+        Exynos_OMX_TunnelPortRestart(pOMXComponent, nPortIndex);
+#endif
+
     ret = OMX_ErrorNone;
 
 EXIT:
@@ -442,6 +723,17 @@ OMX_ERRORTYPE Exynos_OMX_PortEnableProcess(
         Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] Enable %s Port", pExynosComponent, __FUNCTION__,
                                 (nIndex == INPUT_PORT_INDEX)? "input":"output");
 
+#ifdef TUNNELING_SUPPORT
+        if (CHECK_PORT_TUNNELED(pExynosPort) &&
+            CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) &&
+            (pExynosComponent->currentState != OMX_StateLoaded) &&
+            !CHECK_PORT_POPULATED(pExynosPort)) {
+            ret = pExynosComponent->exynos_AllocateTunnelBuffer(pOMXComponent, nIndex);
+            if (ret != OMX_ErrorNone)
+                goto EXIT;
+        }
+#endif
+
         if (CHECK_PORT_POPULATED(pExynosPort)) {
             Exynos_OMX_SendEventCommand(pExynosComponent,
                                         ((nIndex == INPUT_PORT_INDEX)? EVENT_CMD_ENABLE_INPUT_PORT:EVENT_CMD_ENABLE_OUTPUT_PORT),
@@ -467,56 +759,39 @@ EXIT:
     return ret;
 }
 
-OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
-    OMX_IN OMX_HANDLETYPE        hComponent,
-    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+/* checks on the header itself, nothing is locked yet */
+static OMX_ERRORTYPE Exynos_OMX_CheckBufferHeader(
+    OMX_BUFFERHEADERTYPE *pBuffer,
+    OMX_U32               nPortIndex)
 {
-    OMX_ERRORTYPE                ret                = OMX_ErrorNone;
-    OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
-    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
-    EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
-    EXYNOS_OMX_MESSAGE          *message            = NULL;
-
-    OMX_U32 i = 0;
-    OMX_BOOL bFindBuffer = OMX_FALSE;
-
-    FunctionIn();
-
-    if (hComponent == NULL) {
-        ret = OMX_ErrorBadParameter;
-        goto EXIT;
-    }
-    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
-
-    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
-    if (ret != OMX_ErrorNone)
-        goto EXIT;
-
-    if (pOMXComponent->pComponentPrivate == NULL) {
-        ret = OMX_ErrorBadParameter;
-        goto EXIT;
-    }
-    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
-
-    if (pExynosComponent->currentState == OMX_StateInvalid) {
-        ret = OMX_ErrorInvalidState;
-        goto EXIT;
-    }
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
 
     if (pBuffer == NULL) {
         ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
 
-    if (pBuffer->nInputPortIndex != INPUT_PORT_INDEX) {
+    if (((nPortIndex == INPUT_PORT_INDEX) &&
+         (pBuffer->nInputPortIndex != INPUT_PORT_INDEX)) ||
+        ((nPortIndex == OUTPUT_PORT_INDEX) &&
+         (pBuffer->nOutputPortIndex != OUTPUT_PORT_INDEX))) {
         ret = OMX_ErrorBadPortIndex;
         goto EXIT;
     }
 
     ret = Exynos_OMX_Check_SizeVersion(pBuffer, sizeof(OMX_BUFFERHEADERTYPE));
-    if (ret != OMX_ErrorNone) {
-        goto EXIT;
-    }
+
+EXIT:
+    return ret;
+}
+
+/* whether the port takes client buffers in the current state */
+static OMX_ERRORTYPE Exynos_OMX_CheckPortSubmit(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nPortIndex)
+{
+    OMX_ERRORTYPE        ret         = OMX_ErrorNone;
+    EXYNOS_OMX_BASEPORT *pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
 
     if ((pExynosComponent->currentState != OMX_StateIdle) &&
         (pExynosComponent->currentState != OMX_StateExecuting) &&
@@ -525,63 +800,90 @@ OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
         goto EXIT;
     }
 
-    pExynosPort = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
     if ((!CHECK_PORT_ENABLED(pExynosPort)) ||
-        (CHECK_PORT_BEING_FLUSHED(pExynosPort) &&
-        (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
+        ((CHECK_PORT_BEING_FLUSHED(pExynosPort)) &&
+         (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
         ((pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle) &&
-        (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
+         (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
+                                (nPortIndex == INPUT_PORT_INDEX)? "INPUT":"OUTPUT",
                                 CHECK_PORT_ENABLED(pExynosPort), pExynosPort->portState,
                                 CHECK_PORT_TUNNELED(pExynosPort), CHECK_PORT_BUFFER_SUPPLIER(pExynosPort));
         ret = OMX_ErrorIncorrectStateOperation;
         goto EXIT;
     }
 
-    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
-    for (i = 0; i < pExynosPort->portDefinition.nBufferCountActual; i++) {
+EXIT:
+    return ret;
+}
+
+/* hPortMutex must be held, bufferSemID is posted by the caller */
+static OMX_ERRORTYPE Exynos_OMX_QueueClientBuffer(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U32                   nPortIndex,
+    OMX_BUFFERHEADERTYPE     *pBuffer)
+{
+    OMX_ERRORTYPE        ret         = OMX_ErrorNone;
+    EXYNOS_OMX_BASEPORT *pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+    EXYNOS_OMX_MESSAGE  *message     = NULL;
+    OMX_U32              nBufferNum  = MAX_BUFFER_NUM;
+    OMX_BOOL             bFindBuffer = OMX_FALSE;
+
+    OMX_U32 i = 0;
+
+    if (nPortIndex == INPUT_PORT_INDEX)
+        nBufferNum = pExynosPort->portDefinition.nBufferCountActual;
+
+    for (i = 0; i < nBufferNum; i++) {
         if (pBuffer == pExynosPort->extendBufferHeader[i].OMXBufferHeader) {
             if (pExynosPort->extendBufferHeader[i].bBufferInOMX == OMX_FALSE) {
                 pExynosPort->extendBufferHeader[i].bBufferInOMX = OMX_TRUE;
                 bFindBuffer = OMX_TRUE;
                 break;
             } else {
-                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] input buffer(%p) was already entered!", pExynosComponent, __FUNCTION__, pBuffer);
+                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] %s buffer(%p) was already entered!", pExynosComponent, __FUNCTION__,
+                                                    (nPortIndex == INPUT_PORT_INDEX)? "input":"output", pBuffer);
             }
         }
     }
 
     if (bFindBuffer == OMX_FALSE) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] EmptyThisBuffer is failed : %p", pExynosComponent, __FUNCTION__, pBuffer);
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] %s is failed : %p", pExynosComponent, __FUNCTION__,
+                                            (nPortIndex == INPUT_PORT_INDEX)? "EmptyThisBuffer":"FillThisBuffer", pBuffer);
         ret = OMX_ErrorBadParameter;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
 
 #ifdef PERFORMANCE_DEBUG
-    Exynos_OSAL_CountIncrease(pExynosPort->hBufferCount, pBuffer, INPUT_PORT_INDEX);
+    Exynos_OSAL_CountIncrease(pExynosPort->hBufferCount, pBuffer, nPortIndex);
 #endif
 
+    if ((nPortIndex == INPUT_PORT_INDEX) &&
+        (pBuffer->nFilledLen > 0) &&
+        !(pBuffer->nFlags & OMX_BUFFERFLAG_CODECCONFIG)) {
+        EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nInputFrames);
+        Exynos_OSAL_BenchInput(pExynosComponent->hBench, pBuffer->nTimeStamp);
+    }
+
     message = Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_MESSAGE));
     if (message == NULL) {
         ret = OMX_ErrorInsufficientResources;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
-    message->type       = EXYNOS_OMX_CommandEmptyBuffer;
+    message->type       = (nPortIndex == INPUT_PORT_INDEX)? EXYNOS_OMX_CommandEmptyBuffer:EXYNOS_OMX_CommandFillBuffer;
     message->param      = (OMX_U32) i;
     message->pCmdData   = (OMX_PTR)pBuffer;
 
-    ret = Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message);
-    if (ret != 0) {
+    if (Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message) != 0) {
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Buffer queue failed", pExynosComponent, __FUNCTION__);
+        Exynos_OSAL_Free(message);
         ret = OMX_ErrorUndefined;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
-    ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
 
-    if (pBuffer->nFlags & OMX_BUFFERFLAG_CODECCONFIG) {
+    if (nPortIndex == OUTPUT_PORT_INDEX) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader:%p", pExynosComponent, __FUNCTION__, pBuffer);
+    } else if (pBuffer->nFlags & OMX_BUFFERFLAG_CODECCONFIG) {
         Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] bufferHeader(CSD):%p, nAllocLen:%d, nFilledLen:%d, nOffset:%d, nFlags:%x",
                                             pExynosComponent, __FUNCTION__,
                                             pBuffer, pBuffer->nAllocLen, pBuffer->nFilledLen, pBuffer->nOffset, pBuffer->nFlags);
@@ -591,15 +893,141 @@ OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
                                                 pBuffer, pBuffer->nAllocLen, pBuffer->nFilledLen, pBuffer->nOffset, pBuffer->nFlags);
     }
 
+EXIT:
+    return ret;
+}
+
+#ifdef TUNNELING_SUPPORT
+/* only Exynos video ports can share frames, the others are refused */
+OMX_ERRORTYPE Exynos_OMX_TunnelCheckPeer(
+    OMX_HANDLETYPE                   hTunneledComp,
+    OMX_U32                          nTunneledPort,
+    OMX_DIRTYPE                      eDir,
+    OMX_PARAM_PORTDEFINITIONTYPE    *pPeerPortDef)
+{
+    OMX_ERRORTYPE   ret = OMX_ErrorNone;
+    OMX_VERSIONTYPE componentVersion;
+    OMX_VERSIONTYPE specVersion;
+    OMX_UUIDTYPE    componentUUID;
+    char            componentName[MAX_OMX_COMPONENT_NAME_SIZE];
+
+    FunctionIn();
+
+    if ((hTunneledComp == NULL) ||
+        (pPeerPortDef == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Memset(componentName, 0, sizeof(componentName));
+    ret = OMX_GetComponentVersion(hTunneledComp, componentName, &componentVersion, &specVersion, &componentUUID);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if (Exynos_OSAL_Strncmp(componentName, PREFIX_COMPONENT_NAME, Exynos_OSAL_Strlen(PREFIX_COMPONENT_NAME)) != 0) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] peer(%s) is not an exynos component", __FUNCTION__, componentName);
+        ret = OMX_ErrorPortsNotCompatible;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Memset(pPeerPortDef, 0, sizeof(OMX_PARAM_PORTDEFINITIONTYPE));
+    INIT_SET_SIZE_VERSION(pPeerPortDef, OMX_PARAM_PORTDEFINITIONTYPE);
+    pPeerPortDef->nPortIndex = nTunneledPort;
+
+    ret = OMX_GetParameter(hTunneledComp, OMX_IndexParamPortDefinition, pPeerPortDef);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if ((pPeerPortDef->eDir != eDir) ||
+        (pPeerPortDef->eDomain != OMX_PortDomainVideo)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] peer(%s) port(%d) dir(%d) domain(%d) does not match",
+                                            __FUNCTION__, componentName, nTunneledPort, pPeerPortDef->eDir, pPeerPortDef->eDomain);
+        ret = OMX_ErrorPortsNotCompatible;
+        goto EXIT;
+    }
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* requeues the frames a supplier port kept for itself and wakes the port up */
+OMX_ERRORTYPE Exynos_OMX_TunnelPortRestart(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex)
+{
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
+    EXYNOS_OMX_BASEPORT      *pExynosPort       = NULL;
+    OMX_S32                   nQueued           = 0;
+    OMX_S32                   nSemaCnt          = 0;
+
+    OMX_U32 i = 0;
+
+    FunctionIn();
+
+    if ((pOMXComponent == NULL) ||
+        (pOMXComponent->pComponentPrivate == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (nPortIndex >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+
+    if (!CHECK_PORT_TUNNELED(pExynosPort) ||
+        !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) ||
+        !CHECK_PORT_ENABLED(pExynosPort))
+        goto EXIT;
+
+    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+
+    for (i = 0; i < MAX_BUFFER_NUM; i++) {
+        OMX_BUFFERHEADERTYPE     *pBufferHeader = pExynosPort->extendBufferHeader[i].OMXBufferHeader;
+        EXYNOS_OMX_TUNNEL_BUFFER *pTunnelBuffer = NULL;
+
+        if (pBufferHeader == NULL)
+            continue;
+
+        pTunnelBuffer = (EXYNOS_OMX_TUNNEL_BUFFER *)pBufferHeader->pOutputPortPrivate;
+        if ((pTunnelBuffer == NULL) ||
+            (pTunnelBuffer->bHeld == OMX_FALSE))
+            continue;
+
+        pBufferHeader->nFilledLen = 0;
+        pBufferHeader->nOffset    = 0;
+        pBufferHeader->nFlags     = 0;
+
+        if (Exynos_OMX_QueueClientBuffer(pExynosComponent, nPortIndex, pBufferHeader) == OMX_ErrorNone)
+            pTunnelBuffer->bHeld = OMX_FALSE;
+    }
+
+    nQueued = Exynos_OSAL_GetElemNum(&pExynosPort->bufferQ);
+
     Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
 
+    /* buffers from the peer were posted already, only the difference is needed */
+    Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &nSemaCnt);
+    for (; nSemaCnt < nQueued; nSemaCnt++)
+        Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+    Exynos_OMX_WakeBufferProcess(pExynosComponent, nPortIndex);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] %s port: %d buffers queued", pExynosComponent, __FUNCTION__,
+                                        (nPortIndex == INPUT_PORT_INDEX)? "input":"output", nQueued);
+
 EXIT:
     FunctionOut();
 
     return ret;
 }
+#endif
 
-OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
+OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(
     OMX_IN OMX_HANDLETYPE        hComponent,
     OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
 {
@@ -607,10 +1035,6 @@ OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
     EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
-    EXYNOS_OMX_MESSAGE          *message            = NULL;
-
-    OMX_U32 i = 0;
-    OMX_BOOL bFindBuffer = OMX_FALSE;
 
     FunctionIn();
 
@@ -635,88 +1059,179 @@ OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
         goto EXIT;
     }
 
-    if (pBuffer == NULL) {
+    ret = Exynos_OMX_CheckBufferHeader(pBuffer, INPUT_PORT_INDEX);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    ret = Exynos_OMX_CheckPortSubmit(pExynosComponent, INPUT_PORT_INDEX);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    pExynosPort = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+
+    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+
+    ret = Exynos_OMX_QueueClientBuffer(pExynosComponent, INPUT_PORT_INDEX, pBuffer);
+    if (ret == OMX_ErrorNone)
+        ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+
+    Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+
+    if (ret == OMX_ErrorNone)
+        Exynos_OMX_WakeBufferProcess(pExynosComponent, INPUT_PORT_INDEX);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(
+    OMX_IN OMX_HANDLETYPE        hComponent,
+    OMX_IN OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    OMX_ERRORTYPE                ret                = OMX_ErrorNone;
+    OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
+    EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
+
+    FunctionIn();
+
+    if (hComponent == NULL) {
         ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
 
-    if (pBuffer->nOutputPortIndex != OUTPUT_PORT_INDEX) {
-        ret = OMX_ErrorBadPortIndex;
+    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
+    if (ret != OMX_ErrorNone)
         goto EXIT;
-    }
 
-    ret = Exynos_OMX_Check_SizeVersion(pBuffer, sizeof(OMX_BUFFERHEADERTYPE));
-    if (ret != OMX_ErrorNone) {
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
         goto EXIT;
     }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
 
-    if ((pExynosComponent->currentState != OMX_StateIdle) &&
-        (pExynosComponent->currentState != OMX_StateExecuting) &&
-        (pExynosComponent->currentState != OMX_StatePause)) {
-        ret = OMX_ErrorIncorrectStateOperation;
+    if (pExynosComponent->currentState == OMX_StateInvalid) {
+        ret = OMX_ErrorInvalidState;
         goto EXIT;
     }
 
-    pExynosPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
-    if ((!CHECK_PORT_ENABLED(pExynosPort)) ||
-        ((CHECK_PORT_BEING_FLUSHED(pExynosPort)) &&
-         (!CHECK_PORT_TUNNELED(pExynosPort) || !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))) ||
-        ((pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle) &&
-         (CHECK_PORT_TUNNELED(pExynosPort) && !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] enabled(%d), state(%x), tunneld(%d), supplier(%d)", pExynosComponent, __FUNCTION__,
-                                CHECK_PORT_ENABLED(pExynosPort), pExynosPort->portState,
-                                CHECK_PORT_TUNNELED(pExynosPort), CHECK_PORT_BUFFER_SUPPLIER(pExynosPort));
-        ret = OMX_ErrorIncorrectStateOperation;
+    ret = Exynos_OMX_CheckBufferHeader(pBuffer, OUTPUT_PORT_INDEX);
+    if (ret != OMX_ErrorNone)
         goto EXIT;
-    }
+
+    ret = Exynos_OMX_CheckPortSubmit(pExynosComponent, OUTPUT_PORT_INDEX);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    pExynosPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
 
     Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
-    for (i = 0; i < MAX_BUFFER_NUM; i++) {
-        if (pBuffer == pExynosPort->extendBufferHeader[i].OMXBufferHeader) {
-            if (pExynosPort->extendBufferHeader[i].bBufferInOMX == OMX_FALSE) {
-                pExynosPort->extendBufferHeader[i].bBufferInOMX = OMX_TRUE;
-                bFindBuffer = OMX_TRUE;
-                break;
-            } else {
-                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] output buffer(%p) was already entered!", pExynosComponent, __FUNCTION__, pBuffer);
-            }
-        }
+
+    ret = Exynos_OMX_QueueClientBuffer(pExynosComponent, OUTPUT_PORT_INDEX, pBuffer);
+    if (ret == OMX_ErrorNone)
+        ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+
+    Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+
+    if (ret == OMX_ErrorNone)
+        Exynos_OMX_WakeBufferProcess(pExynosComponent, OUTPUT_PORT_INDEX);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/*
+ * same checks as EmptyThisBuffer/FillThisBuffer but the port mutex is taken and the buffer thread is woken once.
+ * bufferSemID still counts buffers(flush and port disable drain it per buffer), it is posted once for every buffer queued.
+ */
+OMX_ERRORTYPE Exynos_OMX_SubmitBufferBatch(
+    OMX_IN OMX_HANDLETYPE                   hComponent,
+    OMX_IN EXYNOS_OMX_CONFIG_BUFFER_BATCH  *pBatch)
+{
+    OMX_ERRORTYPE                ret                = OMX_ErrorNone;
+    OMX_ERRORTYPE                headerRet          = OMX_ErrorNone;
+    OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
+    EXYNOS_OMX_BASEPORT         *pExynosPort        = NULL;
+    OMX_U32                      nValid             = 0;
+
+    OMX_U32 i = 0;
+
+    FunctionIn();
+
+    if ((hComponent == NULL) ||
+        (pBatch == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
     }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComponent;
 
-    if (bFindBuffer == OMX_FALSE) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] FillThisBuffer is failed : %p", pExynosComponent, __FUNCTION__, pBuffer);
+    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
         ret = OMX_ErrorBadParameter;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
         goto EXIT;
     }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
 
-#ifdef PERFORMANCE_DEBUG
-    Exynos_OSAL_CountIncrease(pExynosPort->hBufferCount, pBuffer, OUTPUT_PORT_INDEX);
-#endif
+    pBatch->nSubmitted = 0;
 
-    message = Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_MESSAGE));
-    if (message == NULL) {
-        ret = OMX_ErrorInsufficientResources;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+    if (pExynosComponent->currentState == OMX_StateInvalid) {
+        ret = OMX_ErrorInvalidState;
         goto EXIT;
     }
-    message->type       = EXYNOS_OMX_CommandFillBuffer;
-    message->param      = (OMX_U32) i;
-    message->pCmdData   = (OMX_PTR)pBuffer;
 
-    ret = Exynos_OSAL_Queue(&pExynosPort->bufferQ, (void *)message);
-    if (ret != 0) {
-        ret = OMX_ErrorUndefined;
-        Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
+    if (pBatch->nPortIndex >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
         goto EXIT;
     }
 
-    ret = Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
+    if (pBatch->nCount > EXYNOS_OMX_BUFFER_BATCH_MAX) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
 
-    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bufferHeader:%p", pExynosComponent, __FUNCTION__, pBuffer);
+    /* everything up to the first bad header is still submitted */
+    for (nValid = 0; nValid < pBatch->nCount; nValid++) {
+        headerRet = Exynos_OMX_CheckBufferHeader(pBatch->pBuffers[nValid], pBatch->nPortIndex);
+        if (headerRet != OMX_ErrorNone)
+            break;
+    }
+
+    ret = Exynos_OMX_CheckPortSubmit(pExynosComponent, pBatch->nPortIndex);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    pExynosPort = &pExynosComponent->pExynosPort[pBatch->nPortIndex];
+
+    Exynos_OSAL_MutexLock(pExynosPort->hPortMutex);
+
+    for (i = 0; i < nValid; i++) {
+        ret = Exynos_OMX_QueueClientBuffer(pExynosComponent, pBatch->nPortIndex, pBatch->pBuffers[i]);
+        if (ret != OMX_ErrorNone)
+            break;
+
+        pBatch->nSubmitted++;
+    }
+
+    for (i = 0; i < pBatch->nSubmitted; i++)
+        Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
 
     Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
 
+    if (pBatch->nSubmitted > 0)
+        Exynos_OMX_WakeBufferProcess(pExynosComponent, pBatch->nPortIndex);
+
+    if (ret == OMX_ErrorNone)
+        ret = headerRet;
+
 EXIT:
     FunctionOut();
 
@@ -838,6 +1353,8 @@ OMX_ERRORTYPE Exynos_OMX_FillThisBufferAgain(
 
     Exynos_OSAL_MutexUnlock(pExynosPort->hPortMutex);
 
+    Exynos_OMX_WakeBufferProcess(pExynosComponent, pExynosPort->portDefinition.nPortIndex);
+
 EXIT:
     FunctionOut();
 
@@ -911,6 +1428,7 @@ OMX_ERRORTYPE Exynos_OMX_Port_Constructor(OMX_HANDLETYPE hComponent)
     Exynos_OSAL_Memset(pExynosInputPort->bufferStateAllocate, 0, sizeof(OMX_U32) * MAX_BUFFER_NUM);
 
     pExynosInputPort->bufferSemID = NULL;
+    pExynosInputPort->hCodecReadyFd = -1;
     pExynosInputPort->assignedBufferNum = 0;
     pExynosInputPort->portState = EXYNOS_OMX_PortStateLoaded;
     pExynosInputPort->tunneledComponent = NULL;
@@ -974,6 +1492,7 @@ OMX_ERRORTYPE Exynos_OMX_Port_Constructor(OMX_HANDLETYPE hComponent)
     Exynos_OSAL_Memset(pExynosOutputPort->bufferStateAllocate, 0, sizeof(OMX_U32) * MAX_BUFFER_NUM);
 
     pExynosOutputPort->bufferSemID = NULL;
+    pExynosOutputPort->hCodecReadyFd = -1;
     pExynosOutputPort->assignedBufferNum = 0;
     pExynosOutputPort->portState = EXYNOS_OMX_PortStateLoaded;
     pExynosOutputPort->tunneledComponent = NULL;
@@ -66,6 +66,20 @@ typedef struct _EXYNOS_OMX_BUFFERHEADERTYPE
     unsigned long         buf_fd[MAX_BUFFER_PLANE];
 } EXYNOS_OMX_BUFFERHEADERTYPE;
 
+/*
+ * a frame buffer shared over a tunnel. it is allocated by the supplier(output) port
+ * and both headers point to it through pOutputPortPrivate.
+ */
+typedef struct _EXYNOS_OMX_TUNNEL_BUFFER
+{
+    OMX_BUFFERHEADERTYPE *pSupplierHeader;  /* header on the supplier port */
+    OMX_BUFFERHEADERTYPE *pPeerHeader;      /* header given by UseBuffer() of the peer */
+    unsigned long         fd;               /* dmabuf of the frame */
+    OMX_U32               nRefCount;        /* 1 while the peer holds the frame */
+    OMX_BOOL              bHeld;            /* came back while the peer could not take it */
+    OMX_BOOL              bCodecLayout;     /* written by MFC as it is(single fd NV12), not by CSC */
+} EXYNOS_OMX_TUNNEL_BUFFER;
+
 typedef struct _EXYNOS_OMX_DATABUFFER
 {
     OMX_HANDLETYPE        bufferMutex;
@@ -144,6 +158,17 @@ typedef enum _EXYNOS_OMX_PLANE
 */
 } EXYNOS_OMX_PLANE;
 
+typedef enum _EXYNOS_OMX_FLUSH_STEP
+{
+    FLUSH_STEP_WAKEUP = 0,  /* waking up buffer process threads */
+    FLUSH_STEP_STOP,        /* codec stop (streamoff) */
+    FLUSH_STEP_HEADER,      /* CSD parsing */
+    FLUSH_STEP_DRAIN,       /* returning buffers to the client */
+    FLUSH_STEP_REQUEUE,     /* codec buffers enqueue or reconfiguration */
+    FLUSH_STEP_START,       /* codec start (streamon) */
+    FLUSH_STEP_MAX,
+} EXYNOS_OMX_FLUSH_STEP;
+
 typedef struct _EXYNOS_OMX_BASEPORT
 {
     EXYNOS_OMX_BUFFERHEADERTYPE   *extendBufferHeader;
@@ -155,6 +180,8 @@ typedef struct _EXYNOS_OMX_BASEPORT
     OMX_S32                        assignedBufferNum;
     EXYNOS_OMX_PORT_STATETYPE      portState;
     OMX_HANDLETYPE                 semWaitPortEnable[ALL_WAY_NUM];
+    OMX_HANDLETYPE                 hProcessWorker[ALL_WAY_NUM];     /* set only when the worker pool runs the buffer process */
+    int                            hCodecReadyFd;                   /* readable when the codec queue of this port can be dequeued, -1: unknown */
 
     OMX_MARKTYPE                   markType;
 
@@ -178,8 +205,6 @@ typedef struct _EXYNOS_OMX_BASEPORT
     OMX_HANDLETYPE                 codecSemID;
     EXYNOS_QUEUE                   codecBufferQ;
 
-    OMX_HANDLETYPE                 pauseEvent;
-
     /* Buffer */
     union {
         EXYNOS_OMX_PORT_1WAY_DATABUFFER port1WayDataBuffer;
@@ -197,6 +222,9 @@ typedef struct _EXYNOS_OMX_BASEPORT
 
     OMX_TICKS                      latestTimeStamp;
 
+    /* elapsed time(us) of each step at the last flush */
+    OMX_U32                        nFlushStepTime[FLUSH_STEP_MAX];
+
     /* Protecting S/W Encoder uses SBWC by ConsumerUsage */
     OMX_BOOL                       bForceUseNonCompFormat;
 
@@ -215,13 +243,23 @@ OMX_ERRORTYPE Exynos_OMX_InputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OMX
 OMX_ERRORTYPE Exynos_OMX_OutputBufferReturn(OMX_COMPONENTTYPE *pOMXComponent, OMX_BUFFERHEADERTYPE *bufferHeader);
 
 OMX_ERRORTYPE Exynos_OMX_BufferFlushProcess(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 nPortIndex, OMX_BOOL bEvent);
+void Exynos_OMX_ResetFlushStepTime(EXYNOS_OMX_BASEPORT *pExynosPort, OMX_U64 *pTimeStamp);
+void Exynos_OMX_SetFlushStepTime(EXYNOS_OMX_BASEPORT *pExynosPort, EXYNOS_OMX_FLUSH_STEP eStep, OMX_U64 *pTimeStamp);
 
 OMX_ERRORTYPE Exynos_OMX_DisablePort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 nPortIndex);
 OMX_ERRORTYPE Exynos_OMX_PortDisableProcess(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 nPortIndex);
 OMX_ERRORTYPE Exynos_OMX_EnablePort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 nPortIndex);
 OMX_ERRORTYPE Exynos_OMX_PortEnableProcess(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 nPortIndex);
 
+#ifdef TUNNELING_SUPPORT
+OMX_ERRORTYPE Exynos_OMX_TunnelCheckPeer(OMX_HANDLETYPE hTunneledComp, OMX_U32 nTunneledPort, OMX_DIRTYPE eDir, OMX_PARAM_PORTDEFINITIONTYPE *pPeerPortDef);
+OMX_ERRORTYPE Exynos_OMX_TunnelPortRestart(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
+#endif
+
+OMX_ERRORTYPE Exynos_OMX_EmptyThisBuffer(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer);
+OMX_ERRORTYPE Exynos_OMX_FillThisBuffer(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer);
 OMX_ERRORTYPE Exynos_OMX_FillThisBufferAgain(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer);
+OMX_ERRORTYPE Exynos_OMX_SubmitBufferBatch(OMX_HANDLETYPE hComponent, EXYNOS_OMX_CONFIG_BUFFER_BATCH *pBatch);
 
 OMX_ERRORTYPE Exynos_OMX_Port_Constructor(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_Port_Destructor(OMX_HANDLETYPE hComponent);
@@ -39,6 +39,9 @@
 #include "Exynos_OSAL_Semaphore.h"
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_Bench.h"
+#include "Exynos_OSAL_WorkerPool.h"
+#include "Exynos_OSAL_MemPressure.h"
 
 #include "Exynos_OSAL_Platform.h"
 
@@ -189,6 +192,34 @@ void Exynos_Output_SetSupportFormat(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
     return ;
 }
 
+static void Exynos_Free_CodecBuffer(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    OMX_U32                      nPortIndex,
+    CODEC_DEC_BUFFER           **ppCodecBuffer,
+    int                          nIndex)
+{
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec  = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    int nPlaneCnt = 0;
+    int j;
+
+    if (ppCodecBuffer[nIndex] == NULL)
+        return;
+
+    nPlaneCnt = Exynos_GetPlaneFromPort(&pExynosComponent->pExynosPort[nPortIndex]);
+    for (j = 0; j < nPlaneCnt; j++) {
+        if (ppCodecBuffer[nIndex]->pVirAddr[j] != NULL) {
+            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] %s codec buffer[%d][%d] : %d",
+                                        pExynosComponent, __FUNCTION__,
+                                        (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
+                                        nIndex, j, ppCodecBuffer[nIndex]->fd[j]);
+            Exynos_OSAL_SharedMemory_Free(pVideoDec->hSharedMemory, ppCodecBuffer[nIndex]->pVirAddr[j]);
+        }
+    }
+
+    Exynos_OSAL_Free(ppCodecBuffer[nIndex]);
+    ppCodecBuffer[nIndex] = NULL;
+}
+
 void Exynos_Free_CodecBuffers(
     OMX_COMPONENTTYPE   *pOMXComponent,
     OMX_U32              nPortIndex)
@@ -197,36 +228,22 @@ void Exynos_Free_CodecBuffers(
     EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
     CODEC_DEC_BUFFER               **ppCodecBuffer      = NULL;
 
-    int nBufferCnt = 0, nPlaneCnt = 0;
-    int i, j;
+    int nBufferCnt = 0;
+    int i;
 
     FunctionIn();
 
     if (nPortIndex == INPUT_PORT_INDEX) {
         ppCodecBuffer = &(pVideoDec->pMFCDecInputBuffer[0]);
         nBufferCnt = MFC_INPUT_BUFFER_NUM_MAX;
+        pVideoDec->nMFCDecInputBufferNum = 0;
     } else {
         ppCodecBuffer = &(pVideoDec->pMFCDecOutputBuffer[0]);
         nBufferCnt = MFC_OUTPUT_BUFFER_NUM_MAX;
     }
 
-    nPlaneCnt = Exynos_GetPlaneFromPort(&pExynosComponent->pExynosPort[nPortIndex]);
-    for (i = 0; i < nBufferCnt; i++) {
-        if (ppCodecBuffer[i] != NULL) {
-            for (j = 0; j < nPlaneCnt; j++) {
-                if (ppCodecBuffer[i]->pVirAddr[j] != NULL) {
-                    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] %s codec buffer[%d][%d] : %d",
-                                                pExynosComponent, __FUNCTION__,
-                                                (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
-                                                i, j, ppCodecBuffer[i]->fd[j]);
-                    Exynos_OSAL_SharedMemory_Free(pVideoDec->hSharedMemory, ppCodecBuffer[i]->pVirAddr[j]);
-                }
-            }
-
-            Exynos_OSAL_Free(ppCodecBuffer[i]);
-            ppCodecBuffer[i] = NULL;
-        }
-    }
+    for (i = 0; i < nBufferCnt; i++)
+        Exynos_Free_CodecBuffer(pExynosComponent, nPortIndex, ppCodecBuffer, i);
 
     FunctionOut();
 }
@@ -293,6 +310,9 @@ OMX_ERRORTYPE Exynos_Allocate_CodecBuffers(
         ppCodecBuffer[i]->dataSize = 0;
     }
 
+    if (nPortIndex == INPUT_PORT_INDEX)
+        pVideoDec->nMFCDecInputBufferNum = nBufferCnt;
+
     FunctionOut();
 
     return OMX_ErrorNone;
@@ -305,6 +325,386 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Exynos_IsMemoryTrimmed(EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec)
+{
+    return ((pVideoDec->bTrimMemory == OMX_TRUE) ||
+            (__atomic_load_n(&pVideoDec->bMemoryPressure, __ATOMIC_ACQUIRE) == OMX_TRUE))? OMX_TRUE:OMX_FALSE;
+}
+
+/* the worker pool parks a buffer process step on these instead of sleeping in a MFC dequeue */
+void Exynos_Set_CodecReadyFd(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    ExynosVideoDecBufferOps     *pInbufOps,
+    ExynosVideoDecBufferOps     *pOutbufOps,
+    OMX_HANDLETYPE               hMFCHandle)
+{
+    int hFd = -1;
+
+    FunctionIn();
+
+    if (pExynosComponent == NULL)
+        goto EXIT;
+
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd  = -1;
+    pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd = -1;
+
+    /* no handle: the codec is closed */
+    if (hMFCHandle == NULL)
+        goto EXIT;
+
+    if ((pInbufOps != NULL) &&
+        (pInbufOps->Get_ReadyFd != NULL) &&
+        (pInbufOps->Get_ReadyFd(hMFCHandle, &hFd) == VIDEO_ERROR_NONE))
+        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd = hFd;
+
+    if ((pOutbufOps != NULL) &&
+        (pOutbufOps->Get_ReadyFd != NULL) &&
+        (pOutbufOps->Get_ReadyFd(hMFCHandle, &hFd) == VIDEO_ERROR_NONE))
+        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd = hFd;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] ready fd: input(%d) output(%d)", pExynosComponent, __FUNCTION__,
+                                        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd,
+                                        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd);
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+static OMX_U32 Exynos_Get_CodecInputBufferNum(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    return (Exynos_IsMemoryTrimmed(pVideoDec) == OMX_TRUE)? MFC_INPUT_BUFFER_NUM_MIN:MFC_INPUT_BUFFER_NUM_MAX;
+}
+
+/*
+ * shrinks or regrows the input codec buffers to Exynos_Get_CodecInputBufferNum().
+ * only valid while every input codec buffer is owned by the component (init, input flush).
+ * failing to regrow is not an error, decoding goes on with the buffers it has.
+ */
+static OMX_ERRORTYPE Exynos_Resize_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    CODEC_DEC_BUFFER               **ppCodecBuffer      = &(pVideoDec->pMFCDecInputBuffer[0]);
+    MEMORY_TYPE                      eMemoryType        = CACHED_MEMORY;
+
+    int nTarget = 0, nPlaneCnt = 0;
+    int i, j;
+
+    FunctionIn();
+
+    if (!(pInputPort->bufferProcessType & BUFFER_COPY) ||
+        (pVideoDec->nMFCDecInputBufferNum == 0) ||
+        (ppCodecBuffer[0] == NULL))
+        goto EXIT;
+
+    nTarget = (int)Exynos_Get_CodecInputBufferNum(pOMXComponent);
+    if (nTarget == (int)pVideoDec->nMFCDecInputBufferNum)
+        goto EXIT;
+
+    if (nTarget < (int)pVideoDec->nMFCDecInputBufferNum) {
+        for (i = nTarget; i < (int)pVideoDec->nMFCDecInputBufferNum; i++)
+            Exynos_Free_CodecBuffer(pExynosComponent, INPUT_PORT_INDEX, ppCodecBuffer, i);
+    } else {
+        if (pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC)
+            eMemoryType = SECURE_MEMORY;
+
+        nPlaneCnt = Exynos_GetPlaneFromPort(pInputPort);
+        for (i = pVideoDec->nMFCDecInputBufferNum; i < nTarget; i++) {
+            ppCodecBuffer[i] = (CODEC_DEC_BUFFER *)Exynos_OSAL_Malloc(sizeof(CODEC_DEC_BUFFER));
+            if (ppCodecBuffer[i] == NULL)
+                break;
+            Exynos_OSAL_Memset(ppCodecBuffer[i], 0, sizeof(CODEC_DEC_BUFFER));
+
+            for (j = 0; j < nPlaneCnt; j++) {
+                ppCodecBuffer[i]->pVirAddr[j] =
+                    (void *)Exynos_OSAL_SharedMemory_Alloc(pVideoDec->hSharedMemory, ppCodecBuffer[0]->bufferSize[j], eMemoryType);
+                if (ppCodecBuffer[i]->pVirAddr[j] == NULL)
+                    break;
+
+                ppCodecBuffer[i]->fd[j] =
+                    Exynos_OSAL_SharedMemory_VirtToION(pVideoDec->hSharedMemory, ppCodecBuffer[i]->pVirAddr[j]);
+                ppCodecBuffer[i]->bufferSize[j] = ppCodecBuffer[0]->bufferSize[j];
+            }
+
+            if (j < nPlaneCnt) {
+                Exynos_Free_CodecBuffer(pExynosComponent, INPUT_PORT_INDEX, ppCodecBuffer, i);
+                break;
+            }
+        }
+
+        if (i < nTarget) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] Failed to regrow input codec buffers(%d/%d)",
+                                                pExynosComponent, __FUNCTION__, i, nTarget);
+        }
+        nTarget = i;
+    }
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input codec buffers : %d -> %d",
+                                            pExynosComponent, __FUNCTION__, pVideoDec->nMFCDecInputBufferNum, nTarget);
+    pVideoDec->nMFCDecInputBufferNum = nTarget;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* codec init : allocates the input codec buffers and hands them all to the input */
+OMX_ERRORTYPE Exynos_Setup_CodecInputBuffers(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    unsigned int         nAllocLen[MAX_BUFFER_PLANE])
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    int i;
+
+    FunctionIn();
+
+    ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, Exynos_Get_CodecInputBufferNum(pOMXComponent), nAllocLen);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    for (i = 0; i < (int)pVideoDec->nMFCDecInputBufferNum; i++)
+        Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* input flush : every input codec buffer is back, so they are resized here before being handed out again */
+void Exynos_EnQueue_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    int i;
+
+    FunctionIn();
+
+    Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
+    Exynos_Resize_CodecInputBuffers(pOMXComponent);
+
+    for (i = 0; i < (int)pVideoDec->nMFCDecInputBufferNum; i++) {
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
+                                            pExynosComponent, __FUNCTION__,
+                                            i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
+
+        Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
+    }
+
+    FunctionOut();
+
+    return;
+}
+
+/* the input codec buffer MFC gave back, emptied for the next copy */
+CODEC_DEC_BUFFER *Exynos_Find_CodecInputBuffer(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_PTR              pVirAddr)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    CODEC_DEC_BUFFER                *pCodecBuffer       = NULL;
+
+    int i;
+
+    for (i = 0; i < (int)pVideoDec->nMFCDecInputBufferNum; i++) {
+        if (pVirAddr == pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
+            pCodecBuffer = pVideoDec->pMFCDecInputBuffer[i];
+            pCodecBuffer->dataSize = 0;
+            break;
+        }
+    }
+
+    return pCodecBuffer;
+}
+
+/* DPBs on top of what MFC requires, they cover the frames the client holds for display */
+OMX_U32 Exynos_Get_ExtraDPBNum(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
+        return 0;
+
+    return (Exynos_IsMemoryTrimmed(pVideoDec) == OMX_TRUE)? EXTRA_DPB_NUM_MIN:EXTRA_DPB_NUM;
+}
+
+OMX_BOOL Exynos_Check_ReusableCodecBuffers(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nFrameWidth,
+    OMX_U32              nFrameHeight,
+    unsigned int         nAllocLen[MAX_BUFFER_PLANE],
+    OMX_S32             *pBufferCnt)
+{
+    OMX_BOOL                         ret                = OMX_FALSE;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    CODEC_DEC_BUFFER               **ppCodecBuffer      = &(pVideoDec->pMFCDecOutputBuffer[0]);
+
+    int nBufferCnt = 0, nPlaneCnt = 0;
+    int i, j;
+
+    FunctionIn();
+
+    if (!(pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) ||
+        (pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pExynosComponent->bUseImgCrop == OMX_TRUE))
+        goto EXIT;
+
+    /* release oversized DPBs instead of keeping them around */
+    if (Exynos_IsMemoryTrimmed(pVideoDec) == OMX_TRUE)
+        goto EXIT;
+
+    /* client buffers are laid out by the current port geometry */
+    if ((nFrameWidth > pOutputPort->portDefinition.format.video.nFrameWidth) ||
+        (nFrameHeight > pOutputPort->portDefinition.format.video.nFrameHeight))
+        goto EXIT;
+
+    nPlaneCnt = Exynos_GetPlaneFromPort(pOutputPort);
+    for (i = 0; i < MFC_OUTPUT_BUFFER_NUM_MAX; i++) {
+        if (ppCodecBuffer[i] == NULL)
+            break;
+
+        for (j = 0; j < nPlaneCnt; j++) {
+            if (ppCodecBuffer[i]->bufferSize[j] < nAllocLen[j])
+                goto EXIT;
+        }
+
+        nBufferCnt++;
+    }
+
+    if (nBufferCnt < *pBufferCnt)
+        goto EXIT;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] reuse %d codec buffers for %dx%d (required: %d)",
+                                        pExynosComponent, __FUNCTION__,
+                                        nBufferCnt, nFrameWidth, nFrameHeight, *pBufferCnt);
+
+    *pBufferCnt = nBufferCnt;
+    ret = OMX_TRUE;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* on a resolution change: keeps the port and only reports the new crop when current DPBs fit */
+OMX_BOOL Exynos_Keep_CodecBuffers(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_BOOL             bFormatChanged,
+    OMX_U32              nFrameWidth,
+    OMX_U32              nFrameHeight,
+    unsigned int         nAllocLen[MAX_BUFFER_PLANE],
+    OMX_S32             *pBufferCnt)
+{
+    OMX_BOOL                         ret                = OMX_FALSE;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    FunctionIn();
+
+    if ((pVideoDec->bReconfigDPB == OMX_FALSE) ||
+        (bFormatChanged == OMX_TRUE) ||
+        (pVideoDec->exynos_codec_reuseAllBuffers == NULL))
+        goto EXIT;
+
+    if (Exynos_Check_ReusableCodecBuffers(pOMXComponent, nFrameWidth, nFrameHeight, nAllocLen, pBufferCnt) != OMX_TRUE)
+        goto EXIT;
+
+    pVideoDec->bReuseDPB = OMX_TRUE;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] send event(OMX_EventPortSettingsChanged) with crop",
+                                            pExynosComponent, __FUNCTION__);
+    /** Send crop info call back **/
+    (*(pExynosComponent->pCallbacks->EventHandler))
+        (pOMXComponent,
+         pExynosComponent->callbackData,
+         OMX_EventPortSettingsChanged, /* The command was completed */
+         OMX_DirOutput, /* This is the port index */
+         OMX_IndexConfigCommonOutputCrop,
+         NULL);
+
+    ret = OMX_TRUE;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* returns all DPBs to DstIn, MFC will be set up again with them */
+void Exynos_Detach_KeptCodecBuffers(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    FunctionIn();
+
+    if (pVideoDec->bReuseDPB == OMX_FALSE)
+        goto EXIT;
+
+    pVideoDec->exynos_codec_stop(pOMXComponent, OUTPUT_PORT_INDEX);
+    pVideoDec->exynos_codec_enqueueAllBuffer(pOMXComponent, OUTPUT_PORT_INDEX);
+    pVideoDec->exynos_codec_reuseAllBuffers(pOMXComponent, OMX_FALSE);
+
+    pOutputPort->exceptionFlag = GENERAL_STATE;
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+/* codec buffers are kept, only V4L2 buffers are set up for the new geometry */
+OMX_ERRORTYPE Exynos_Setup_KeptCodecBuffers(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    FunctionIn();
+
+    if (!(pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) ||
+        (pVideoDec->bReuseDPB == OMX_FALSE) ||
+        (pOutputPort->exceptionFlag != GENERAL_STATE))
+        goto EXIT;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] do DstSetup with current DPBs", pExynosComponent, __FUNCTION__);
+
+    pVideoDec->exynos_codec_stop(pOMXComponent, OUTPUT_PORT_INDEX);
+    ret = pVideoDec->exynos_codec_reuseAllBuffers(pOMXComponent, OMX_TRUE);
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to set up current DPBs(0x%x)", pExynosComponent, __FUNCTION__, ret);
+        goto EXIT;
+    }
+
+    pVideoDec->bReuseDPB    = OMX_FALSE;
+    pVideoDec->bReconfigDPB = OMX_FALSE;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 void Exynos_SetReorderTimestamp(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_U32                     *nIndex,
@@ -586,27 +986,28 @@ void Exynos_Wait_ProcessPause(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U3
 
     FunctionIn();
 
-    if (((pExynosComponent->currentState == OMX_StatePause) ||
-         (pExynosComponent->currentState == OMX_StateIdle) ||
-         (pExynosComponent->transientState == EXYNOS_OMX_TransStateLoadedToIdle) ||
-         (pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle)) &&
-        (pExynosComponent->transientState != EXYNOS_OMX_TransStateIdleToLoaded) &&
-        (!CHECK_PORT_BEING_FLUSHED(exynosOMXPort))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> pause : state(0x%x), transient state(0x%x)",
+    /* every writer of the state below calls Exynos_OMX_NotifyStateChange() after updating it */
+    Exynos_OSAL_ConditionLock(pExynosComponent->hStateCondition);
+    while (((pExynosComponent->currentState == OMX_StatePause) ||
+            (pExynosComponent->currentState == OMX_StateIdle) ||
+            (pExynosComponent->transientState == EXYNOS_OMX_TransStateLoadedToIdle) ||
+            (pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle)) &&
+           (pExynosComponent->transientState != EXYNOS_OMX_TransStateIdleToLoaded) &&
+           (!CHECK_PORT_BEING_FLUSHED(exynosOMXPort)) &&
+           (pVideoDec->bExitBufferProcessThread == OMX_FALSE)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] %s port -> pause : state(0x%x), transient state(0x%x)",
                                         pExynosComponent, __FUNCTION__,
                                         (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
                                         pExynosComponent->currentState, pExynosComponent->transientState);
-        Exynos_OSAL_SignalWait(pExynosComponent->pExynosPort[nPortIndex].pauseEvent, DEF_MAX_WAIT_TIME);
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> resume : state(0x%x), transient state(0x%x)",
-                                        pExynosComponent, __FUNCTION__,
-                                        (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
-                                        pExynosComponent->currentState, pExynosComponent->transientState);
-        if (pVideoDec->bExitBufferProcessThread)
-            goto EXIT;
-        Exynos_OSAL_SignalReset(pExynosComponent->pExynosPort[nPortIndex].pauseEvent);
+        if (Exynos_OSAL_WorkerCurrent() != NULL) {
+            /* a pool step must not sleep here, the state change kicks it again */
+            Exynos_OSAL_WorkerPark();
+            break;
+        }
+        Exynos_OSAL_ConditionWait(pExynosComponent->hStateCondition);
     }
+    Exynos_OSAL_ConditionUnlock(pExynosComponent->hStateCondition);
 
-EXIT:
     FunctionOut();
 
     return;
@@ -907,6 +1308,127 @@ EXIT:
     return ret;
 }
 
+/*
+ * 0 : not loaded ~ DROP_CONTROL_LOAD_MAX : fully loaded
+ * while the client has input waiting, output should go out at least as fast as real time.
+ * the speed is media time of returned output over system time, so frame rate and reordering do not matter
+ */
+OMX_U32 Exynos_Get_DecodeLoad(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    OMX_TICKS                        nOutputTimeStamp   = DEFAULT_TIMESTAMP_VAL;
+    OMX_U64                          nOutputTimeUs      = 0;
+    OMX_U64                          nElapsedUs         = 0;
+    OMX_S64                          nSpeed             = 0;
+
+    FunctionIn();
+
+    /* the time is stored before the timestamp */
+    nOutputTimeStamp = __atomic_load_n(&pVideoDec->nLastOutputTimeStamp, __ATOMIC_ACQUIRE);
+    nOutputTimeUs    = __atomic_load_n(&pVideoDec->nLastOutputTimeUs, __ATOMIC_RELAXED);
+
+    /* nothing returned yet, or the client is not waiting on the codec : output can not be faster than input */
+    if ((nOutputTimeStamp == DEFAULT_TIMESTAMP_VAL) ||
+        (Exynos_OSAL_GetElemNum(&pInputPort->bufferQ) <= 0)) {
+        pVideoDec->nDropWindowTimeUs = 0;
+        pVideoDec->nDecodeLoad       = 0;
+        goto EXIT;
+    }
+
+    if ((pVideoDec->nDropWindowTimeUs == 0) ||
+        (nOutputTimeUs < pVideoDec->nDropWindowTimeUs) ||
+        ((nOutputTimeUs - pVideoDec->nDropWindowTimeUs) > DROP_CONTROL_WINDOW_GAP_US) ||
+        (nOutputTimeStamp < pVideoDec->nDropWindowTimeStamp)) {
+        /* first output, a pause or a jump back in time */
+        pVideoDec->nDropWindowTimeStamp = nOutputTimeStamp;
+        pVideoDec->nDropWindowTimeUs    = nOutputTimeUs;
+        pVideoDec->nDecodeLoad          = 0;
+        goto EXIT;
+    }
+
+    nElapsedUs = nOutputTimeUs - pVideoDec->nDropWindowTimeUs;
+    if (nElapsedUs < DROP_CONTROL_WINDOW_US)
+        goto EXIT;
+
+    nSpeed = ((nOutputTimeStamp - pVideoDec->nDropWindowTimeStamp) * 100) / (OMX_S64)nElapsedUs;
+    if (nSpeed >= DROP_CONTROL_SPEED_LOW)
+        pVideoDec->nDecodeLoad = 0;
+    else if (nSpeed <= DROP_CONTROL_SPEED_HIGH)
+        pVideoDec->nDecodeLoad = DROP_CONTROL_LOAD_MAX;
+    else
+        pVideoDec->nDecodeLoad = (OMX_U32)(((DROP_CONTROL_SPEED_LOW - nSpeed) * DROP_CONTROL_LOAD_MAX) /
+                                           (DROP_CONTROL_SPEED_LOW - DROP_CONTROL_SPEED_HIGH));
+
+    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] output speed %d%%, load %d",
+                                        pExynosComponent, __FUNCTION__, (int)nSpeed, (int)pVideoDec->nDecodeLoad);
+
+    pVideoDec->nDropWindowTimeStamp = nOutputTimeStamp;
+    pVideoDec->nDropWindowTimeUs    = nOutputTimeUs;
+
+EXIT:
+    FunctionOut();
+
+    return pVideoDec->nDecodeLoad;
+}
+
+OMX_BOOL Exynos_Check_SkipInputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData)
+{
+    OMX_BOOL                         ret                = OMX_FALSE;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    FunctionIn();
+
+    if ((pVideoDec->bKeyFrameOnlyMode == OMX_FALSE) &&
+        (pVideoDec->bDropControl == OMX_FALSE))
+        goto EXIT;
+
+    /* bitstream can not be parsed in secure mode */
+    if (pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC)
+        goto EXIT;
+
+    /* EOS and CSD must always reach the codec */
+    if ((pSrcInputData->nFlags & (OMX_BUFFERFLAG_EOS | OMX_BUFFERFLAG_CODECCONFIG)) ||
+        (pSrcInputData->buffer.addr[0] == NULL) ||
+        (pSrcInputData->dataLen == 0))
+        goto EXIT;
+
+    if ((pVideoDec->bKeyFrameOnlyMode == OMX_TRUE) &&
+        (pVideoDec->exynos_codec_checkKeyFrame != NULL)) {
+        if (pVideoDec->exynos_codec_checkKeyFrame((OMX_U8 *)pSrcInputData->buffer.addr[0], pSrcInputData->dataLen) == OMX_FALSE)
+            ret = OMX_TRUE;
+
+        goto EXIT;
+    }
+
+    if ((pVideoDec->bDropControl == OMX_TRUE) &&
+        (pVideoDec->exynos_codec_checkNonRefFrame != NULL)) {
+        OMX_U32 nLoad = Exynos_Get_DecodeLoad(pOMXComponent, pSrcInputData);
+
+        if (nLoad == 0) {
+            pVideoDec->nDropCredit = 0;
+            goto EXIT;
+        }
+
+        if (pVideoDec->exynos_codec_checkNonRefFrame(pOMXComponent, (OMX_U8 *)pSrcInputData->buffer.addr[0], pSrcInputData->dataLen) == OMX_FALSE)
+            goto EXIT;
+
+        /* the more loaded, the more non-reference frames are dropped */
+        pVideoDec->nDropCredit += nLoad;
+        if (pVideoDec->nDropCredit >= DROP_CONTROL_LOAD_MAX) {
+            pVideoDec->nDropCredit -= DROP_CONTROL_LOAD_MAX;
+            ret = OMX_TRUE;
+        }
+    }
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL Exynos_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *srcInputData)
 {
     OMX_BOOL                         ret                = OMX_FALSE;
@@ -917,6 +1439,7 @@ OMX_BOOL Exynos_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
 
     OMX_BYTE pInputStream = NULL;
     OMX_U32 copySize = 0;
+    OMX_U32 prefixSize = 0;
 
     FunctionIn();
 
@@ -991,9 +1514,20 @@ OMX_BOOL Exynos_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
                 goto EXIT;
             }
 
+            if ((srcInputData->dataLen == 0) &&
+                (pVideoDec->exynos_codec_makeInputPrefix != NULL)) {
+                /* header goes in front while copying, so the codec does not have to shift the frame */
+                prefixSize = pVideoDec->exynos_codec_makeInputPrefix(pOMXComponent, pInputStream, copySize, inputUseBuffer->nFlags,
+                                                                    (OMX_U8 *)srcInputData->buffer.addr[0],
+                                                                    (srcInputData->allocSize - copySize));
+                srcInputData->dataLen       += prefixSize;
+                srcInputData->remainDataLen += prefixSize;
+            }
+
             if (copySize > 0) {
                 Exynos_OSAL_Memcpy((OMX_PTR)((char *)srcInputData->buffer.addr[0] + srcInputData->dataLen),
                                    pInputStream, copySize);
+                EXYNOS_OMX_METRIC_ADD(pExynosComponent->metrics.nCopiedBytes[INPUT_PORT_INDEX], copySize);
             }
 
             inputUseBuffer->dataLen         -= copySize;
@@ -1047,6 +1581,59 @@ EXIT:
     return ret;
 }
 
+#ifdef USE_ANDROID
+static void Exynos_ImgConvDone(
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    EXYNOS_OMX_DATABUFFER   *pDataBuffer,
+    OMX_ERRORTYPE            eResult)
+{
+    FunctionIn();
+
+    if (eResult == OMX_ErrorNone)
+        pDataBuffer->nFlags |= OMX_BUFFERFLAG_CONVERTEDIMAGE;
+
+    Exynos_OutputBufferReturn(pOMXComponent, pDataBuffer);
+
+    FunctionOut();
+
+    return;
+}
+
+/* tone mapping is done on the worker of image converter.
+ * every buffer goes through it to keep the order of output.
+ */
+static void Exynos_ImgConv_OutputBufferReturn(
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    EXYNOS_OMX_DATABUFFER   *pDataBuffer,
+    OMX_PTR                  pHDRDynamic)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *exynosOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    FunctionIn();
+
+    if ((pVideoDec->hImgConv == NULL) ||
+        (CHECK_PORT_BEING_FLUSHED(exynosOutputPort)))
+        goto DIRECT_RETURN;
+
+    /* the converter keeps its own copy of dataBuffer */
+    if (Exynos_OSAL_ImgConv_Request(pVideoDec->hImgConv, pOMXComponent, pDataBuffer, pHDRDynamic,
+                                    &Exynos_ImgConvDone) == OMX_ErrorNone) {
+        Exynos_ResetDataBuffer(pDataBuffer);
+        goto EXIT;
+    }
+
+DIRECT_RETURN:
+    Exynos_OutputBufferReturn(pOMXComponent, pDataBuffer);
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+#endif
+
 OMX_BOOL Exynos_Postprocess_OutputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *dstOutputData)
 {
     OMX_BOOL                         ret              = OMX_FALSE;
@@ -1119,6 +1706,8 @@ OMX_BOOL Exynos_Postprocess_OutputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
 
                 if (dstOutputData->remainDataLen > 0) {
                     ret = Exynos_CSC_OutputData(pOMXComponent, dstOutputData);
+                    if (ret == OMX_TRUE)
+                        EXYNOS_OMX_METRIC_ADD(pExynosComponent->metrics.nCopiedBytes[OUTPUT_PORT_INDEX], dstOutputData->remainDataLen);
                 } else {
                     ret = OMX_TRUE;
                 }
@@ -1133,16 +1722,10 @@ OMX_BOOL Exynos_Postprocess_OutputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
                         (outputUseBuffer->nFlags & OMX_BUFFERFLAG_EOS) ||
                         (CHECK_PORT_BEING_FLUSHED(exynosOutputPort))) {
 #ifdef USE_ANDROID
-                        if ((pVideoDec->hImgConv != NULL) &&
-                            (outputUseBuffer->remainDataLen > 0)) {
-                            if (Exynos_OSAL_ImgConv_Run(pVideoDec->hImgConv, pOMXComponent,
-                                                        (OMX_PTR)outputUseBuffer->bufferHeader->pBuffer,
-                                                        (OMX_PTR)&(pBufferInfo->HDRDynamic)) == OMX_ErrorNone) {
-                                outputUseBuffer->nFlags |= OMX_BUFFERFLAG_CONVERTEDIMAGE;
-                            }
-                        }
-#endif
+                        Exynos_ImgConv_OutputBufferReturn(pOMXComponent, outputUseBuffer, (OMX_PTR)&(pBufferInfo->HDRDynamic));
+#else
                         Exynos_OutputBufferReturn(pOMXComponent, outputUseBuffer);
+#endif
                     }
                 } else {
                     Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to CSC", pExynosComponent, __FUNCTION__);
@@ -1174,16 +1757,10 @@ OMX_BOOL Exynos_Postprocess_OutputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
                 (outputUseBuffer->nFlags & OMX_BUFFERFLAG_EOS) ||
                 (CHECK_PORT_BEING_FLUSHED(exynosOutputPort))) {
 #ifdef USE_ANDROID
-                if ((pVideoDec->hImgConv != NULL) &&
-                    (outputUseBuffer->remainDataLen > 0)) {
-                    if (Exynos_OSAL_ImgConv_Run(pVideoDec->hImgConv, pOMXComponent,
-                                                (OMX_PTR)outputUseBuffer->bufferHeader->pBuffer,
-                                                (OMX_PTR)&(pBufferInfo->HDRDynamic)) == OMX_ErrorNone) {
-                        outputUseBuffer->nFlags |= OMX_BUFFERFLAG_CONVERTEDIMAGE;
-                    }
-                }
-#endif
+                Exynos_ImgConv_OutputBufferReturn(pOMXComponent, outputUseBuffer, (OMX_PTR)&(pBufferInfo->HDRDynamic));
+#else
                 Exynos_OutputBufferReturn(pOMXComponent, outputUseBuffer);
+#endif
             } else {
                 Exynos_OMX_FillThisBufferAgain(pOMXComponent, outputUseBuffer->bufferHeader);
                 Exynos_ResetDataBuffer(outputUseBuffer);
@@ -1214,22 +1791,31 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
 
     FunctionIn();
 
+    ret = pVideoDec->srcInputStepRet;
+
     while (!pVideoDec->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
         Exynos_Wait_ProcessPause(pExynosComponent, INPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosInputPort)) ||
              (!CHECK_PORT_ENABLED(exynosInputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, INPUT_PORT_INDEX)) &&
                (!pVideoDec->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if ((CHECK_PORT_BEING_FLUSHED(exynosInputPort)) ||
                 (exynosOutputPort->exceptionFlag == INVALID_STATE))
@@ -1294,11 +1880,29 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
                 break;
             }
 
-            ret = pVideoDec->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+            if (Exynos_Check_SkipInputData(pOMXComponent, pSrcInputData) == OMX_TRUE) {
+                Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] skip a frame before decoding(dataLen: %d, timestamp: %lld us)",
+                                                    pExynosComponent, __FUNCTION__,
+                                                    pSrcInputData->dataLen, pSrcInputData->timeStamp);
+                ret = (OMX_ERRORTYPE)OMX_ErrorNoneSkipFrame;
+            } else {
+                Exynos_OSAL_WorkerBlockingBegin();
+                ret = pVideoDec->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+                Exynos_OSAL_WorkerBlockingEnd();
+                if (ret == OMX_ErrorNone)
+                    EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nHeldByCodec[INPUT_PORT_INDEX]);
+            }
+
             if (((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorCorruptedFrame) ||
-                ((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorCorruptedHeader)) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input data is weird(0x%x)",
-                                                        pExynosComponent, __FUNCTION__, ret);
+                ((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorCorruptedHeader) ||
+                ((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorNoneSkipFrame)) {
+                if ((EXYNOS_OMX_ERRORTYPE)ret != OMX_ErrorNoneSkipFrame) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input data is weird(0x%x)",
+                                                            pExynosComponent, __FUNCTION__, ret);
+                    EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nErrors);
+                } else {
+                    EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nDroppedFrames);
+                }
                 if (exynosInputPort->bufferProcessType & BUFFER_COPY) {
                     OMX_PTR codecBuffer;
                     codecBuffer = pSrcInputData->pPrivate;
@@ -1323,6 +1927,7 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
     }
 
 EXIT:
+    pVideoDec->srcInputStepRet = ret;
 
     FunctionOut();
 
@@ -1344,13 +1949,20 @@ OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent)
     Exynos_ResetCodecData(&srcOutputData);
 
     while (!pVideoDec->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
+        Exynos_Wait_ProcessPause(pExynosComponent, INPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosInputPort)) ||
              (!CHECK_PORT_ENABLED(exynosInputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
@@ -1360,15 +1972,24 @@ OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent)
                 if (Exynos_Check_BufferProcess_State(pExynosComponent, INPUT_PORT_INDEX) == OMX_FALSE)
                     break;
             }
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosInputPort))
                 break;
 
+            /* on the worker pool, the step parks until MFC gives a stream buffer back */
+            if (Exynos_OSAL_WorkerWaitFd(exynosInputPort->hCodecReadyFd) == OMX_FALSE)
+                break;
+
             Exynos_OSAL_MutexLock(srcOutputUseBuffer->bufferMutex);
+            Exynos_OSAL_WorkerBlockingBegin();
             ret = pVideoDec->exynos_codec_srcOutputProcess(pOMXComponent, &srcOutputData);
+            Exynos_OSAL_WorkerBlockingEnd();
 
             if (ret == OMX_ErrorNone) {
+                EXYNOS_OMX_METRIC_DEC(pExynosComponent->metrics.nHeldByCodec[INPUT_PORT_INDEX]);
+
                 if (exynosInputPort->bufferProcessType & BUFFER_COPY) {
                     OMX_PTR codecBuffer;
                     codecBuffer = srcOutputData.pPrivate;
@@ -1400,27 +2021,35 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
     EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
     EXYNOS_OMX_BASEPORT      *exynosOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
     EXYNOS_OMX_DATABUFFER    *dstInputUseBuffer = &exynosOutputPort->way.port2WayDataBuffer.inputDataBuffer;
-    EXYNOS_OMX_DATA           dstInputData;
+    EXYNOS_OMX_DATA          *pDstInputData = &pVideoDec->dstInputStepData;
 
     FunctionIn();
 
-    Exynos_ResetCodecData(&dstInputData);
+    ret = pVideoDec->dstInputStepRet;
 
     while (!pVideoDec->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
+        Exynos_Wait_ProcessPause(pExynosComponent, OUTPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosOutputPort)) ||
              (!CHECK_PORT_ENABLED(exynosOutputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, OUTPUT_PORT_INDEX)) &&
                (!pVideoDec->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if ((CHECK_PORT_BEING_FLUSHED(exynosOutputPort)) ||
                 (exynosOutputPort->exceptionFlag != GENERAL_STATE))
@@ -1440,7 +2069,7 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                         Exynos_OSAL_MutexUnlock(dstInputUseBuffer->bufferMutex);
                         break;
                     }
-                    Exynos_CodecBufferToData(pCodecBuffer, &dstInputData, OUTPUT_PORT_INDEX);
+                    Exynos_CodecBufferToData(pCodecBuffer, pDstInputData, OUTPUT_PORT_INDEX);
                 }
 
                 if (exynosOutputPort->bufferProcessType == BUFFER_SHARE) {
@@ -1457,7 +2086,7 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                             break;
                         }
 
-                        ret = Exynos_Shared_BufferToData(exynosOutputPort, dstInputUseBuffer, &dstInputData);
+                        ret = Exynos_Shared_BufferToData(exynosOutputPort, dstInputUseBuffer, pDstInputData);
                         if (ret != OMX_ErrorNone) {
                             dstInputUseBuffer->dataValid = OMX_FALSE;
                             Exynos_OSAL_MutexUnlock(dstInputUseBuffer->bufferMutex);
@@ -1468,7 +2097,7 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                             if ((exynosOutputPort->eMetaDataType == METADATA_TYPE_GRAPHIC) ||
                                 (exynosOutputPort->eMetaDataType == METADATA_TYPE_GRAPHIC_HANDLE)) {
                                 Exynos_OSAL_RefCount_Increase(pVideoDec->hRefHandle,
-                                                            dstInputData.bufferHeader->pBuffer,
+                                                            pDstInputData->bufferHeader->pBuffer,
                                                             exynosOutputPort);
                             }
                         }
@@ -1483,7 +2112,12 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                 }
             }
 
-            ret = pVideoDec->exynos_codec_dstInputProcess(pOMXComponent, &dstInputData);
+            Exynos_OSAL_WorkerBlockingBegin();
+            ret = pVideoDec->exynos_codec_dstInputProcess(pOMXComponent, pDstInputData);
+            Exynos_OSAL_WorkerBlockingEnd();
+            if (ret == OMX_ErrorNone)
+                EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nHeldByCodec[OUTPUT_PORT_INDEX]);
+
             if ((EXYNOS_OMX_ERRORTYPE)ret != OMX_ErrorOutputBufferUseYet) {
                 /*
                  * process data could be invalid by flush operation at next dstInputPorcess().
@@ -1491,7 +2125,7 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                  */
                 if ((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorNoneReuseBuffer) {
                     if (exynosOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
-                        Exynos_CodecBufferEnQueue(pExynosComponent, OUTPUT_PORT_INDEX, dstInputData.pPrivate);
+                        Exynos_CodecBufferEnQueue(pExynosComponent, OUTPUT_PORT_INDEX, pDstInputData->pPrivate);
                     }
 
                     if (exynosOutputPort->bufferProcessType == BUFFER_SHARE) {
@@ -1502,19 +2136,19 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                                 ReleaseDPB dpbFD[VIDEO_BUFFER_MAX_NUM];
                                 Exynos_OSAL_Memset(dpbFD, 0, sizeof(dpbFD));
 
-                                dpbFD[0].fd = dstInputData.buffer.fd[0];
+                                dpbFD[0].fd = pDstInputData->buffer.fd[0];
                                 dpbFD[1].fd = -1;
 
                                 Exynos_OSAL_RefCount_Decrease(pVideoDec->hRefHandle,
-                                            dstInputData.bufferHeader->pBuffer, dpbFD, exynosOutputPort);
+                                            pDstInputData->bufferHeader->pBuffer, dpbFD, exynosOutputPort);
                             }
                         }
 #endif
-                        Exynos_OMX_FillThisBufferAgain(hComponent, dstInputData.bufferHeader);
+                        Exynos_OMX_FillThisBufferAgain(hComponent, pDstInputData->bufferHeader);
                     }
                 }
 
-                Exynos_ResetCodecData(&dstInputData);
+                Exynos_ResetCodecData(pDstInputData);
             }
 
             Exynos_OSAL_MutexUnlock(dstInputUseBuffer->bufferMutex);
@@ -1522,6 +2156,7 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
     }
 
 EXIT:
+    pVideoDec->dstInputStepRet = ret;
 
     FunctionOut();
 
@@ -1541,21 +2176,28 @@ OMX_ERRORTYPE Exynos_OMX_DstOutputBufferProcess(OMX_HANDLETYPE hComponent)
     FunctionIn();
 
     while (!pVideoDec->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
         Exynos_Wait_ProcessPause(pExynosComponent, OUTPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosOutputPort)) ||
              (!CHECK_PORT_ENABLED(exynosOutputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, OUTPUT_PORT_INDEX)) &&
                (!pVideoDec->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosOutputPort))
                 break;
@@ -1579,7 +2221,17 @@ OMX_ERRORTYPE Exynos_OMX_DstOutputBufferProcess(OMX_HANDLETYPE hComponent)
 
             if ((dstOutputUseBuffer->dataValid == OMX_TRUE) ||
                 (exynosOutputPort->bufferProcessType == BUFFER_SHARE)) {
+                /* the client buffer stays in dstOutputUseBuffer until the frame is decoded */
+                if (Exynos_OSAL_WorkerWaitFd(exynosOutputPort->hCodecReadyFd) == OMX_FALSE) {
+                    Exynos_OSAL_MutexUnlock(dstOutputUseBuffer->bufferMutex);
+                    break;
+                }
+
+                Exynos_OSAL_WorkerBlockingBegin();
                 ret = pVideoDec->exynos_codec_dstOutputProcess(pOMXComponent, pDstOutputData);
+                Exynos_OSAL_WorkerBlockingEnd();
+                if (ret == OMX_ErrorNone)
+                    EXYNOS_OMX_METRIC_DEC(pExynosComponent->metrics.nHeldByCodec[OUTPUT_PORT_INDEX]);
             }
 
             if (((ret == OMX_ErrorNone) && (dstOutputUseBuffer->dataValid == OMX_TRUE)) ||
@@ -1633,8 +2285,9 @@ EXIT:
 
 static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessThread(OMX_PTR threadData)
 {
-    OMX_ERRORTYPE        ret            = OMX_ErrorNone;
-    OMX_COMPONENTTYPE   *pOMXComponent  = NULL;
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
 
     FunctionIn();
 
@@ -1648,8 +2301,12 @@ static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessThread(OMX_PTR threadData)
     if (ret != OMX_ErrorNone)
         goto EXIT;
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_SrcInputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_SRC_INPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1660,8 +2317,9 @@ EXIT:
 
 static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessThread(OMX_PTR threadData)
 {
-    OMX_ERRORTYPE        ret            = OMX_ErrorNone;
-    OMX_COMPONENTTYPE   *pOMXComponent  = NULL;
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
 
     FunctionIn();
 
@@ -1675,8 +2333,12 @@ static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessThread(OMX_PTR threadData)
     if (ret != OMX_ErrorNone)
         goto EXIT;
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_SrcOutputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_SRC_OUTPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1687,8 +2349,9 @@ EXIT:
 
 static OMX_ERRORTYPE Exynos_OMX_DstInputProcessThread(OMX_PTR threadData)
 {
-    OMX_ERRORTYPE        ret            = OMX_ErrorNone;
-    OMX_COMPONENTTYPE   *pOMXComponent  = NULL;
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
 
     FunctionIn();
 
@@ -1702,8 +2365,12 @@ static OMX_ERRORTYPE Exynos_OMX_DstInputProcessThread(OMX_PTR threadData)
     if (ret != OMX_ErrorNone)
         goto EXIT;
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_DstInputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_DST_INPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1714,8 +2381,9 @@ EXIT:
 
 static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessThread(OMX_PTR threadData)
 {
-    OMX_ERRORTYPE        ret            = OMX_ErrorNone;
-    OMX_COMPONENTTYPE   *pOMXComponent  = NULL;
+    OMX_ERRORTYPE             ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE        *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
 
     FunctionIn();
 
@@ -1729,8 +2397,12 @@ static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessThread(OMX_PTR threadData)
     if (ret != OMX_ErrorNone)
         goto EXIT;
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_DstOutputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_DST_OUTPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1739,16 +2411,101 @@ EXIT:
     return ret;
 }
 
+/* worker pool counterparts of the threads above */
+static void Exynos_OMX_BufferProcessStep(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_ERRORTYPE      (*pBufferProcess)(OMX_HANDLETYPE),
+    BENCH_THREAD_TYPE    eThread)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_U64                   nCpuTimeUs       = Exynos_OSAL_BenchStepBegin(pExynosComponent->hBench);
+
+    /* returns once the step parks or its time slice expires */
+    pBufferProcess(pOMXComponent);
+
+    Exynos_OSAL_BenchStepEnd(pExynosComponent->hBench, eThread, nCpuTimeUs);
+}
+
+static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_SrcInputBufferProcess, BENCH_THREAD_SRC_INPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_SrcOutputBufferProcess, BENCH_THREAD_SRC_OUTPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_DstInputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_DstInputBufferProcess, BENCH_THREAD_DST_INPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_DstOutputBufferProcess, BENCH_THREAD_DST_OUTPUT);
+
+    return OMX_ErrorNone;
+}
+
+static void Exynos_OMX_BufferProcess_Join(
+    OMX_HANDLETYPE  *pThread,
+    OMX_HANDLETYPE  *pWorker)
+{
+    OMX_HANDLETYPE hWorker = *pWorker;
+
+    if (hWorker != NULL) {
+        /* unpublish it first, Exynos_OMX_WakeBufferProcess() must not find it anymore */
+        *pWorker = NULL;
+        Exynos_OSAL_WorkerTerminate(&hWorker);
+    } else {
+        Exynos_OSAL_ThreadTerminate(*pThread);
+        *pThread = NULL;
+    }
+}
+
 OMX_ERRORTYPE Exynos_OMX_BufferProcess_Create(OMX_HANDLETYPE hComponent)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE               *pOMXComponent      = (OMX_COMPONENTTYPE *)hComponent;
     EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
     EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
 
     FunctionIn();
 
     pVideoDec->bExitBufferProcessThread = OMX_FALSE;
+    pVideoDec->srcInputStepRet          = OMX_ErrorNone;
+    pVideoDec->dstInputStepRet          = OMX_ErrorNone;
+    Exynos_ResetCodecData(&pVideoDec->dstInputStepData);
+
+    if (Exynos_OSAL_WorkerPool_Enabled() == OMX_TRUE) {
+        ret = Exynos_OSAL_WorkerCreate(&pOutputPort->hProcessWorker[OUTPUT_WAY_INDEX],
+                     Exynos_OMX_DstOutputProcessStep,
+                     pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pInputPort->hProcessWorker[OUTPUT_WAY_INDEX],
+                         Exynos_OMX_SrcOutputProcessStep,
+                         pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pOutputPort->hProcessWorker[INPUT_WAY_INDEX],
+                         Exynos_OMX_DstInputProcessStep,
+                         pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pInputPort->hProcessWorker[INPUT_WAY_INDEX],
+                         Exynos_OMX_SrcInputProcessStep,
+                         pOMXComponent);
+
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] buffer process runs on the worker pool(0x%x)", pExynosComponent, __FUNCTION__, ret);
+        goto EXIT;
+    }
 
     ret = Exynos_OSAL_ThreadCreate(&pVideoDec->hDstOutputThread,
                  Exynos_OMX_DstOutputProcessThread,
@@ -1784,6 +2541,7 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     FunctionIn();
 
     pVideoDec->bExitBufferProcessThread = OMX_TRUE;
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
 
     Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].bufferSemID, &countValue);
     if (countValue == 0)
@@ -1793,10 +2551,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
         Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].codecSemID);
 
     /* srcInput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoDec->hSrcInputThread);
-    pVideoDec->hSrcInputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoDec->hSrcInputThread, &pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hProcessWorker[INPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] src input thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -1809,10 +2565,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoDec->exynos_codec_bufferProcessRun(pOMXComponent, OUTPUT_PORT_INDEX);
 
     /* dstInput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoDec->hDstInputThread);
-    pVideoDec->hDstInputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoDec->hDstInputThread, &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hProcessWorker[INPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] dst input thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -1820,10 +2574,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoDec->exynos_codec_stop(pOMXComponent, INPUT_PORT_INDEX);
     pVideoDec->exynos_codec_bufferProcessRun(pOMXComponent, INPUT_PORT_INDEX);
 
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoDec->hSrcOutputThread);
-    pVideoDec->hSrcOutputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoDec->hSrcOutputThread, &pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hProcessWorker[OUTPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] src output thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -1831,13 +2583,14 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoDec->exynos_codec_stop(pOMXComponent, OUTPUT_PORT_INDEX);
     pVideoDec->exynos_codec_bufferProcessRun(pOMXComponent, OUTPUT_PORT_INDEX);
 
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoDec->hDstOutputThread);
-    pVideoDec->hDstOutputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoDec->hDstOutputThread, &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hProcessWorker[OUTPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] dst output thread is terminated", pExynosComponent, __FUNCTION__);
 
+    /* nothing waits on the codec any more, it is closed next */
+    Exynos_Set_CodecReadyFd(pExynosComponent, NULL, NULL, NULL);
+
     pExynosComponent->checkTimeStamp.needSetStartTimeStamp      = OMX_FALSE;
     pExynosComponent->checkTimeStamp.needCheckStartTimeStamp    = OMX_FALSE;
 
@@ -1847,6 +2600,20 @@ EXIT:
     return ret;
 }
 
+static void Exynos_OMX_VideoDecodeMemPressure(
+    OMX_PTR     pData,
+    OMX_BOOL    bPressure)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pData;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    /* applied at the next input flush or codec init */
+    __atomic_store_n(&pVideoDec->bMemoryPressure, bPressure, __ATOMIC_RELEASE);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] memory pressure : %s",
+                                            pExynosComponent, __FUNCTION__, (bPressure == OMX_TRUE)? "on":"off");
+}
+
 OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentInit(OMX_IN OMX_HANDLETYPE hComponent)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
@@ -1898,12 +2665,20 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
     Exynos_OSAL_Memset(pVideoDec, 0, sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
     pVideoDec->bForceHeaderParsing      = OMX_FALSE;
     pVideoDec->bReconfigDPB             = OMX_FALSE;
+    pVideoDec->bReuseDPB                = OMX_FALSE;
     pVideoDec->bDTSMode                 = OMX_FALSE;
     pVideoDec->bReorderMode             = OMX_FALSE;
     pVideoDec->eDataType                = DATA_TYPE_8BIT;
     pVideoDec->bQosChanged              = OMX_FALSE;
     pVideoDec->nQosRatio                = 0;
     pVideoDec->bThumbnailMode           = OMX_FALSE;
+    pVideoDec->bKeyFrameOnlyMode        = OMX_FALSE;
+    pVideoDec->bDropControl             = OMX_FALSE;
+    pVideoDec->nDropCredit              = 0;
+    pVideoDec->nLastOutputTimeStamp     = DEFAULT_TIMESTAMP_VAL;
+    pVideoDec->nLastOutputTimeUs        = 0;
+    pVideoDec->nDropWindowTimeUs        = 0;
+    pVideoDec->nDecodeLoad              = 0;
     pVideoDec->bSearchBlackBarChanged   = OMX_FALSE;
     pVideoDec->bSearchBlackBar          = OMX_FALSE;
     pVideoDec->nImageConvMode           = 1;
@@ -2024,6 +2799,17 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
     pExynosComponent->exynos_BufferProcessTerminate = &Exynos_OMX_BufferProcess_Terminate;
     pExynosComponent->exynos_BufferFlush            = &Exynos_OMX_BufferFlush;
 
+    if (Exynos_OSAL_MemPressure_Register(&pVideoDec->hMemPressure, Exynos_OMX_VideoDecodeMemPressure, (OMX_PTR)pExynosComponent) != OMX_ErrorNone) {
+        /* not fatal, trimming is still available by OMX_IndexConfigTrimMemory */
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] memory pressure monitor is not available", pExynosComponent, __FUNCTION__);
+        pVideoDec->hMemPressure = NULL;
+    }
+
+#ifdef USE_ANDROID
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-pipeline-metrics", (OMX_INDEXTYPE)OMX_IndexConfigVideoPipelineMetrics);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-trim-memory", (OMX_INDEXTYPE)OMX_IndexConfigTrimMemory);
+#endif
+
 EXIT:
     FunctionOut();
 
@@ -2064,6 +2850,11 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentDeinit(OMX_IN OMX_HANDLETYPE hCompo
     }
     pVideoDec = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
 
+    if (pVideoDec->hMemPressure != NULL) {
+        Exynos_OSAL_MemPressure_Unregister(pVideoDec->hMemPressure);
+        pVideoDec->hMemPressure = NULL;
+    }
+
 #ifdef USE_ANDROID
     if (pVideoDec->bDrvDPBManaging != OMX_TRUE)
         Exynos_OSAL_RefCount_Terminate(pVideoDec->hRefHandle);
@@ -2071,6 +2862,9 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentDeinit(OMX_IN OMX_HANDLETYPE hCompo
     Exynos_OSAL_ImgConv_Terminate(pVideoDec->hImgConv);
 
     Exynos_OSAL_ReleasePerformanceHandle(pVideoDec->pPerfHandle);
+
+    /* may already be done by the codec, freeing twice is harmless */
+    Exynos_OSAL_DelVendorExts(hComponent);
 #endif
 
     Exynos_OSAL_Free(pVideoDec);
@@ -48,6 +48,7 @@
 #define DEFAULT_VIDEO_OUTPUT_BUFFER_SIZE   (DEFAULT_FRAME_WIDTH * DEFAULT_FRAME_HEIGHT * 3) / 2
 
 #define MFC_INPUT_BUFFER_NUM_MAX            3
+#define MFC_INPUT_BUFFER_NUM_MIN            2   /* kept while memory is trimmed */
 
 /* min size of input buffer for DRC */
 #define DEFAULT_VIDEO_MIN_INPUT_BUFFER_SIZE     (1024 * 1024 * 3 / 2)  /* 1.5MB */
@@ -66,6 +67,7 @@
 #define OUTPUT_PORT_SUPPORTFORMAT_NUM_MAX        (OUTPUT_PORT_SUPPORTFORMAT_DEFAULT_NUM + 4)  /* NV12T, YV12, NV21, UNUSED */
 
 #define EXTRA_DPB_NUM                       5
+#define EXTRA_DPB_NUM_MIN                   2   /* kept while memory is trimmed */
 
 #define MFC_DEFAULT_INPUT_BUFFER_PLANE      1
 #define MFC_DEFAULT_OUTPUT_BUFFER_PLANE     2
@@ -77,6 +79,13 @@
 
 #define DEC_BLOCKS_PER_SECOND               979200 /* remove it and have to read a capability at media_codecs.xml */
 
+/* load-adaptive dropping of non-reference frames(bDropControl), load is output speed against real time */
+#define DROP_CONTROL_WINDOW_US              500000  /* output speed is measured over this much system time */
+#define DROP_CONTROL_WINDOW_GAP_US          2000000 /* no output for longer(pause), the measurement starts again */
+#define DROP_CONTROL_SPEED_LOW              95      /* % of real time, slower output starts dropping */
+#define DROP_CONTROL_SPEED_HIGH             75      /* % of real time, every non-reference frame is dropped */
+#define DROP_CONTROL_LOAD_MAX               100
+
 typedef struct
 {
     void *pAddrY;
@@ -129,6 +138,16 @@ typedef struct _EXYNOS_OMX_VIDEODEC_COMPONENT
     OMX_BOOL                bDiscardCSDError;          /* if it is true, discard a error event in CorruptedHeader case */
     OMX_BOOL                bForceHeaderParsing;
     OMX_BOOL                bThumbnailMode;
+    OMX_BOOL                bKeyFrameOnlyMode;         /* true: non-key frames are dropped before decoding */
+    OMX_U32                 nKeyFrameOnlySavedCountMin; /* output buffer counts before key frame only mode */
+    OMX_U32                 nKeyFrameOnlySavedCountActual;
+    OMX_BOOL                bDropControl;              /* true: non-reference frames are dropped under overload */
+    OMX_U32                 nDropCredit;               /* accumulated load, a frame is dropped at every DROP_CONTROL_LOAD_MAX */
+    OMX_TICKS               nLastOutputTimeStamp;      /* of the last frame returned to the client */
+    OMX_U64                 nLastOutputTimeUs;         /* system time it was returned at */
+    OMX_TICKS               nDropWindowTimeStamp;      /* output the speed is measured from */
+    OMX_U64                 nDropWindowTimeUs;         /* system time of that output, 0 : not measuring */
+    OMX_U32                 nDecodeLoad;               /* of the last measurement */
     OMX_BOOL                bDTSMode;                  /* true:Decoding Time Stamp, false:Presentation Time Stamp */
     OMX_BOOL                bReorderMode;              /* true:use Time Stamp reordering, don't care about a mode like as PTS or DTS */
     EXYNOS_OMX_DATA_TYPE    eDataType;
@@ -142,6 +161,12 @@ typedef struct _EXYNOS_OMX_VIDEODEC_COMPONENT
     OMX_U32                 nMinInBufSize;             /* required min size of input buffer for DRC */
     CODEC_DEC_BUFFER       *pMFCDecInputBuffer[MFC_INPUT_BUFFER_NUM_MAX];
     CODEC_DEC_BUFFER       *pMFCDecOutputBuffer[MFC_OUTPUT_BUFFER_NUM_MAX];
+    OMX_U32                 nMFCDecInputBufferNum;     /* allocated input codec buffers */
+
+    /* Memory Trimming */
+    OMX_BOOL                bTrimMemory;               /* requested by OMX_IndexConfigTrimMemory */
+    OMX_BOOL                bMemoryPressure;           /* reported by the PSI monitor thread */
+    OMX_HANDLETYPE          hMemPressure;
 
     /* Buffer Process */
     OMX_BOOL       bExitBufferProcessThread;
@@ -150,11 +175,17 @@ typedef struct _EXYNOS_OMX_VIDEODEC_COMPONENT
     OMX_HANDLETYPE hDstInputThread;
     OMX_HANDLETYPE hDstOutputThread;
 
+    /* kept across steps when the worker pool runs the buffer process */
+    OMX_ERRORTYPE   srcInputStepRet;
+    OMX_ERRORTYPE   dstInputStepRet;
+    EXYNOS_OMX_DATA dstInputStepData;
+
     /* Shared Memory Handle */
     OMX_HANDLETYPE hSharedMemory;
 
     /* For Reconfiguration DPB */
     OMX_BOOL bReconfigDPB;
+    OMX_BOOL bReuseDPB;     /* keep current DPBs, new resolution fits in them */
 
     /* For DPB Reference Handling (by OMX or MFC Driver) */
     OMX_BOOL bDrvDPBManaging;
@@ -192,8 +223,14 @@ typedef struct _EXYNOS_OMX_VIDEODEC_COMPONENT
     OMX_ERRORTYPE (*exynos_codec_getCodecOutputPrivateData) (OMX_PTR codecBuffer, OMX_PTR addr[], OMX_U32 size[]);
 
     OMX_ERRORTYPE (*exynos_codec_reconfigAllBuffers) (OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
+    /* bSetup: set MFC output up again with the kept codec buffers, otherwise only detach them */
+    OMX_ERRORTYPE (*exynos_codec_reuseAllBuffers) (OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup);
     OMX_BOOL      (*exynos_codec_checkFormatSupport)(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_COLOR_FORMATTYPE eColorFormat);
     OMX_ERRORTYPE (*exynos_codec_checkResolutionChange)(OMX_COMPONENTTYPE *pOMXComponent);
+    OMX_BOOL      (*exynos_codec_checkKeyFrame)(OMX_U8 *pInputStream, OMX_U32 streamSize);
+    OMX_BOOL      (*exynos_codec_checkNonRefFrame)(OMX_COMPONENTTYPE *pOMXComponent, OMX_U8 *pInputStream, OMX_U32 streamSize);
+    /* writes a header ahead of the payload copied into a codec buffer, returns its length (0: none) */
+    OMX_U32       (*exynos_codec_makeInputPrefix)(OMX_COMPONENTTYPE *pOMXComponent, OMX_U8 *pInputStream, OMX_U32 streamSize, OMX_U32 nFlags, OMX_U8 *pPrefix, OMX_U32 nSpace);
 
     OMX_ERRORTYPE (*exynos_codec_updateExtraInfo)(OMX_COMPONENTTYPE *pOMXComponent, ExynosVideoMeta *pMeta);
 } EXYNOS_OMX_VIDEODEC_COMPONENT;
@@ -207,7 +244,10 @@ void Exynos_Output_SetSupportFormat(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
 void Exynos_SetReorderTimestamp(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 *nIndex, OMX_TICKS timeStamp, OMX_U32 nFlags);
 void Exynos_GetReorderTimestamp(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, EXYNOS_OMX_CURRENT_FRAME_TIMESTAMP *sCurrentTimestamp, OMX_S32 nFrameIndex, OMX_S32 eFrameType);
 OMX_BOOL Exynos_Check_BufferProcess_State(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex);
+void Exynos_Wait_ProcessPause(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex);
 OMX_ERRORTYPE Exynos_CodecBufferToData(CODEC_DEC_BUFFER *codecBuffer, EXYNOS_OMX_DATA *pData, OMX_U32 nPortIndex);
+OMX_U32 Exynos_Get_DecodeLoad(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData);
+OMX_BOOL Exynos_Check_SkipInputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData);
 OMX_BOOL Exynos_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *srcInputData);
 OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent);
@@ -217,6 +257,15 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
 OMX_ERRORTYPE Exynos_OMX_VideoDecodeComponentDeinit(OMX_IN OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_Allocate_CodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex, int nBufferCnt, unsigned int nAllocSize[MAX_BUFFER_PLANE]);
 void Exynos_Free_CodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
+void Exynos_Set_CodecReadyFd(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, ExynosVideoDecBufferOps *pInbufOps, ExynosVideoDecBufferOps *pOutbufOps, OMX_HANDLETYPE hMFCHandle);
+OMX_ERRORTYPE Exynos_Setup_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent, unsigned int nAllocLen[MAX_BUFFER_PLANE]);
+void Exynos_EnQueue_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent);
+CODEC_DEC_BUFFER *Exynos_Find_CodecInputBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_PTR pVirAddr);
+OMX_U32 Exynos_Get_ExtraDPBNum(OMX_COMPONENTTYPE *pOMXComponent);
+OMX_BOOL Exynos_Check_ReusableCodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nFrameWidth, OMX_U32 nFrameHeight, unsigned int nAllocLen[MAX_BUFFER_PLANE], OMX_S32 *pBufferCnt);
+OMX_BOOL Exynos_Keep_CodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bFormatChanged, OMX_U32 nFrameWidth, OMX_U32 nFrameHeight, unsigned int nAllocLen[MAX_BUFFER_PLANE], OMX_S32 *pBufferCnt);
+void Exynos_Detach_KeptCodecBuffers(OMX_COMPONENTTYPE *pOMXComponent);
+OMX_ERRORTYPE Exynos_Setup_KeptCodecBuffers(OMX_COMPONENTTYPE *pOMXComponent);
 OMX_ERRORTYPE Exynos_ResetAllPortConfig(OMX_COMPONENTTYPE *pOMXComponent);
 
 #ifdef __cplusplus
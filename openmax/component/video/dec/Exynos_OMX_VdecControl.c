@@ -36,6 +36,7 @@
 #include "Exynos_OMX_Basecomponent.h"
 #include "Exynos_OSAL_Thread.h"
 #include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_WorkerPool.h"
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_ETC.h"
 #include "Exynos_OSAL_SharedMemory.h"
@@ -551,30 +552,257 @@ EXIT:
 }
 
 #ifdef TUNNELING_SUPPORT
-OMX_ERRORTYPE Exynos_OMX_AllocateTunnelBuffer(EXYNOS_OMX_BASEPORT *pOMXBasePort, OMX_U32 nPortIndex)
+static OMX_ERRORTYPE Exynos_OMX_TunnelSyncPeer(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    EXYNOS_OMX_BASEPORT         *pExynosPort)
 {
-    OMX_ERRORTYPE                 ret               = OMX_ErrorNone;
-    EXYNOS_OMX_BASEPORT          *pExynosPort       = NULL;
-    OMX_BUFFERHEADERTYPE         *temp_bufferHeader = NULL;
-    OMX_U8                       *temp_buffer       = NULL;
-    OMX_U32                       bufferSize        = 0;
-    OMX_PARAM_PORTDEFINITIONTYPE  portDefinition;
+    OMX_ERRORTYPE                 ret           = OMX_ErrorNone;
+    OMX_PARAM_PORTDEFINITIONTYPE *pPortDef      = &pExynosPort->portDefinition;
+    OMX_PARAM_PORTDEFINITIONTYPE  peerPortDef;
+
+    ret = Exynos_OMX_TunnelCheckPeer(pExynosPort->tunneledComponent, pExynosPort->tunneledPort,
+                                     OMX_DirInput, &peerPortDef);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    /* port settings may have changed since the tunnel was set up */
+    if (peerPortDef.nBufferCountActual > pPortDef->nBufferCountActual)
+        pPortDef->nBufferCountActual = peerPortDef.nBufferCountActual;
+
+    if ((peerPortDef.nBufferCountActual == pPortDef->nBufferCountActual) &&
+        (peerPortDef.format.video.nFrameWidth == pPortDef->format.video.nFrameWidth) &&
+        (peerPortDef.format.video.nFrameHeight == pPortDef->format.video.nFrameHeight) &&
+        (peerPortDef.format.video.eColorFormat == pPortDef->format.video.eColorFormat))
+        goto EXIT;
+
+    peerPortDef.nBufferCountActual           = pPortDef->nBufferCountActual;
+    peerPortDef.format.video.nFrameWidth     = pPortDef->format.video.nFrameWidth;
+    peerPortDef.format.video.nFrameHeight    = pPortDef->format.video.nFrameHeight;
+    peerPortDef.format.video.nStride         = pPortDef->format.video.nStride;
+    peerPortDef.format.video.nSliceHeight    = pPortDef->format.video.nSliceHeight;
+    peerPortDef.format.video.eColorFormat    = pPortDef->format.video.eColorFormat;
+
+    ret = OMX_SetParameter(pExynosPort->tunneledComponent, OMX_IndexParamPortDefinition, &peerPortDef);
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] peer(%p) refused port definition(0x%x)",
+                                            pExynosComponent, __FUNCTION__, pExynosPort->tunneledComponent, ret);
+        goto EXIT;
+    }
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
     return ret;
 }
 
-OMX_ERRORTYPE Exynos_OMX_FreeTunnelBuffer(EXYNOS_OMX_BASEPORT *pOMXBasePort, OMX_U32 nPortIndex)
+OMX_ERRORTYPE Exynos_OMX_AllocateTunnelBuffer(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = NULL;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = NULL;
+    EXYNOS_OMX_BASEPORT             *pExynosPort        = NULL;
+    EXYNOS_OMX_TUNNEL_BUFFER        *pTunnelBuffer      = NULL;
+    OMX_BUFFERHEADERTYPE            *pBufferHdr         = NULL;
+    OMX_U8                          *pBuffer            = NULL;
+    OMX_U32                          nBufferSize        = 0;
+    MEMORY_TYPE                      mem_type           = CACHED_MEMORY;
+    OMX_U32                          i                  = 0;
+
+    unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
+    unsigned int nDataLen[MAX_BUFFER_PLANE]  = {0, 0, 0};
+
+    FunctionIn();
+
+    if ((pOMXComponent == NULL) ||
+        (pOMXComponent->pComponentPrivate == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (pExynosComponent->hComponentHandle == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pVideoDec = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    if (nPortIndex != OUTPUT_PORT_INDEX) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+
+    if (!CHECK_PORT_TUNNELED(pExynosPort) ||
+        !CHECK_PORT_BUFFER_SUPPLIER(pExynosPort)) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+
+    ret = Exynos_OMX_TunnelSyncPeer(pExynosComponent, pExynosPort);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    nBufferSize = pExynosPort->portDefinition.nBufferSize;
+
+    /* MFC writes into these as into a graphic buffer, with the padding it needs */
+    if (pExynosPort->bufferProcessType == BUFFER_SHARE) {
+        Exynos_OSAL_GetPlaneSize(pExynosPort->portDefinition.format.video.eColorFormat, PLANE_SINGLE,
+                                 pExynosPort->portDefinition.format.video.nFrameWidth,
+                                 pExynosPort->portDefinition.format.video.nFrameHeight,
+                                 nDataLen, nAllocLen);
+        if (nAllocLen[0] > nBufferSize)
+            nBufferSize = nAllocLen[0];
+    }
+
+    if (pExynosPort->bNeedContigMem == OMX_TRUE)
+        mem_type |= CONTIG_MEMORY;
+
+    for (i = 0; i < pExynosPort->portDefinition.nBufferCountActual; i++) {
+        if (pExynosPort->bufferStateAllocate[i] != BUFFER_STATE_FREE)
+            continue;
+
+        pTunnelBuffer = (EXYNOS_OMX_TUNNEL_BUFFER *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_TUNNEL_BUFFER));
+        pBufferHdr    = (OMX_BUFFERHEADERTYPE *)Exynos_OSAL_Malloc(sizeof(OMX_BUFFERHEADERTYPE));
+        pBuffer       = Exynos_OSAL_SharedMemory_Alloc(pVideoDec->hSharedMemory, nBufferSize, mem_type);
+        if ((pTunnelBuffer == NULL) ||
+            (pBufferHdr == NULL) ||
+            (pBuffer == NULL)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to allocate tunnel buffer", pExynosComponent, __FUNCTION__);
+            ret = OMX_ErrorInsufficientResources;
+            goto FAIL;
+        }
+        Exynos_OSAL_Memset(pTunnelBuffer, 0, sizeof(EXYNOS_OMX_TUNNEL_BUFFER));
+        Exynos_OSAL_Memset(pBufferHdr, 0, sizeof(OMX_BUFFERHEADERTYPE));
+
+        INIT_SET_SIZE_VERSION(pBufferHdr, OMX_BUFFERHEADERTYPE);
+        pBufferHdr->pBuffer            = pBuffer;
+        pBufferHdr->nAllocLen          = nBufferSize;
+        pBufferHdr->nOutputPortIndex   = nPortIndex;
+        pBufferHdr->nInputPortIndex    = pExynosPort->tunneledPort;
+        pBufferHdr->pOutputPortPrivate = (OMX_PTR)pTunnelBuffer;
+
+        pTunnelBuffer->pSupplierHeader = pBufferHdr;
+        pTunnelBuffer->fd              = Exynos_OSAL_SharedMemory_VirtToION(pVideoDec->hSharedMemory, pBuffer);
+        pTunnelBuffer->bHeld           = OMX_TRUE;  /* queued once the port starts running */
+        pTunnelBuffer->bCodecLayout    = (pExynosPort->bufferProcessType == BUFFER_SHARE)? OMX_TRUE:OMX_FALSE;
+
+        /*
+         * the peer takes the same memory, so the client round trip goes away.
+         * in BUFFER_SHARE, MFC decodes into it by the fd and nothing is copied on the way.
+         */
+        ret = OMX_UseBuffer(pExynosPort->tunneledComponent, &pTunnelBuffer->pPeerHeader,
+                            pExynosPort->tunneledPort, NULL, nBufferSize, pBuffer);
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] peer(%p) refused buffer[%d](0x%x)",
+                                                pExynosComponent, __FUNCTION__, pExynosPort->tunneledComponent, i, ret);
+            goto FAIL;
+        }
+        pTunnelBuffer->pPeerHeader->pOutputPortPrivate = (OMX_PTR)pTunnelBuffer;
+
+        pExynosPort->extendBufferHeader[i].OMXBufferHeader = pBufferHdr;
+        pExynosPort->extendBufferHeader[i].buf_fd[0]       = pTunnelBuffer->fd;
+        pExynosPort->extendBufferHeader[i].bBufferInOMX    = OMX_FALSE;
+        pExynosPort->bufferStateAllocate[i]                = (BUFFER_STATE_ALLOCATED | HEADER_STATE_ALLOCATED);
+        pExynosPort->assignedBufferNum++;
+    }
+
+    pExynosPort->tunnelBufferNum = pExynosPort->assignedBufferNum;
+    if (pExynosPort->assignedBufferNum == pExynosPort->portDefinition.nBufferCountActual)
+        pExynosPort->portDefinition.bPopulated = OMX_TRUE;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] %d buffers(%d bytes) shared with peer(%p)", pExynosComponent, __FUNCTION__,
+                                        pExynosPort->tunnelBufferNum, nBufferSize, pExynosPort->tunneledComponent);
+
+    goto EXIT;
+
+FAIL:
+    if (pBuffer != NULL)
+        Exynos_OSAL_SharedMemory_Free(pVideoDec->hSharedMemory, pBuffer);
+    Exynos_OSAL_Free(pBufferHdr);
+    Exynos_OSAL_Free(pTunnelBuffer);
+
+    Exynos_OMX_FreeTunnelBuffer(pOMXComponent, nPortIndex);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+OMX_ERRORTYPE Exynos_OMX_FreeTunnelBuffer(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex)
 {
-    OMX_ERRORTYPE            ret                = OMX_ErrorNone;
-    EXYNOS_OMX_BASEPORT     *pExynosPort        = NULL;
-    OMX_BUFFERHEADERTYPE    *temp_bufferHeader  = NULL;
-    OMX_U8                  *temp_buffer        = NULL;
-    OMX_U32                  bufferSize         = 0;
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = NULL;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = NULL;
+    EXYNOS_OMX_BASEPORT             *pExynosPort        = NULL;
+    EXYNOS_OMX_TUNNEL_BUFFER        *pTunnelBuffer      = NULL;
+    OMX_BUFFERHEADERTYPE            *pBufferHdr         = NULL;
+    OMX_ERRORTYPE                    err                = OMX_ErrorNone;
+    OMX_U32                          i                  = 0;
+
+    FunctionIn();
+
+    if ((pOMXComponent == NULL) ||
+        (pOMXComponent->pComponentPrivate == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (pExynosComponent->hComponentHandle == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pVideoDec = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    if (nPortIndex != OUTPUT_PORT_INDEX) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
+
+    if (!CHECK_PORT_BUFFER_SUPPLIER(pExynosPort))
+        goto EXIT;
+
+    for (i = 0; i < MAX_BUFFER_NUM; i++) {
+        pBufferHdr = pExynosPort->extendBufferHeader[i].OMXBufferHeader;
+        if ((pBufferHdr == NULL) ||
+            !(pExynosPort->bufferStateAllocate[i] & BUFFER_STATE_ALLOCATED))
+            continue;
+
+        pTunnelBuffer = (EXYNOS_OMX_TUNNEL_BUFFER *)pBufferHdr->pOutputPortPrivate;
+        if (pTunnelBuffer != NULL) {
+            if (__atomic_load_n(&pTunnelBuffer->nRefCount, __ATOMIC_ACQUIRE) != 0)
+                Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] buffer[%d] is still held by peer", pExynosComponent, __FUNCTION__, i);
+
+            if (pTunnelBuffer->pPeerHeader != NULL) {
+                err = OMX_FreeBuffer(pExynosPort->tunneledComponent, pExynosPort->tunneledPort, pTunnelBuffer->pPeerHeader);
+                if (err != OMX_ErrorNone)
+                    Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] peer(%p) failed to free buffer[%d](0x%x)",
+                                                        pExynosComponent, __FUNCTION__, pExynosPort->tunneledComponent, i, err);
+            }
+
+            Exynos_OSAL_Free(pTunnelBuffer);
+        }
+
+        Exynos_OSAL_SharedMemory_Free(pVideoDec->hSharedMemory, pBufferHdr->pBuffer);
+        Exynos_OSAL_Free(pBufferHdr);
+
+        pExynosPort->extendBufferHeader[i].OMXBufferHeader = NULL;
+        pExynosPort->extendBufferHeader[i].buf_fd[0]       = 0;
+        pExynosPort->extendBufferHeader[i].bBufferInOMX    = OMX_FALSE;
+        pExynosPort->bufferStateAllocate[i]                = BUFFER_STATE_FREE;
+        pExynosPort->assignedBufferNum--;
+    }
+
+    pExynosPort->tunnelBufferNum           = 0;
+    pExynosPort->portDefinition.bPopulated = OMX_FALSE;
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
+    FunctionOut();
+
     return ret;
 }
 
@@ -585,10 +813,105 @@ OMX_ERRORTYPE Exynos_OMX_ComponentTunnelRequest(
     OMX_IN OMX_U32        nTunneledPort,
     OMX_INOUT OMX_TUNNELSETUPTYPE *pTunnelSetup)
 {
-    OMX_ERRORTYPE ret = OMX_ErrorNone;
+    OMX_ERRORTYPE                 ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE            *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT     *pExynosComponent  = NULL;
+    EXYNOS_OMX_BASEPORT          *pExynosPort       = NULL;
+    OMX_PARAM_PORTDEFINITIONTYPE  peerPortDef;
+
+    FunctionIn();
+
+    if (hComp == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComp;
+
+    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (nPort >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &pExynosComponent->pExynosPort[nPort];
+
+    if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+        CHECK_PORT_ENABLED(pExynosPort)) {
+        ret = OMX_ErrorIncorrectStateOperation;
+        goto EXIT;
+    }
+
+    if (hTunneledComp == NULL) {
+        /* tear down */
+        if (pExynosPort->tunnelFlags & EXYNOS_TUNNEL_SHARE_BUFFER) {
+            pExynosPort->bufferProcessType = BUFFER_COPY;
+            pExynosPort->ePlaneType        = PLANE_MULTIPLE;
+        }
+
+        pExynosPort->tunneledComponent = NULL;
+        pExynosPort->tunneledPort      = 0;
+        pExynosPort->tunnelFlags       = 0;
+        pExynosPort->tunnelBufferNum   = 0;
+        goto EXIT;
+    }
+
+    /* only decoded frames are handed over */
+    if (nPort != OUTPUT_PORT_INDEX) {
+        ret = OMX_ErrorTunnelingUnsupported;
+        goto EXIT;
+    }
+
+    if (pTunnelSetup == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (pExynosPort->eMetaDataType != METADATA_TYPE_DISABLED) {
+        ret = OMX_ErrorPortsNotCompatible;
+        goto EXIT;
+    }
+
+    ret = Exynos_OMX_TunnelCheckPeer(hTunneledComp, nTunneledPort, OMX_DirInput, &peerPortDef);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    pExynosPort->tunneledComponent = hTunneledComp;
+    pExynosPort->tunneledPort      = nTunneledPort;
+    pExynosPort->tunnelFlags       = EXYNOS_TUNNEL_ESTABLISHED | EXYNOS_TUNNEL_IS_SUPPLIER;
+    pExynosPort->bufferSupplier    = OMX_BufferSupplyOutput;
+
+    /*
+     * nobody looks at the frames on the way, so MFC decodes into the tunnel buffers
+     * in the NV12 layout the encoder MFC reads(one fd) and the copy out of the DPB goes away.
+     */
+    if ((pExynosPort->bufferProcessType == BUFFER_COPY) &&
+        (pExynosPort->ePlaneType == PLANE_MULTIPLE)) {
+        pExynosPort->portDefinition.format.video.eColorFormat = OMX_COLOR_FormatYUV420SemiPlanar;
+        pExynosPort->bufferProcessType = BUFFER_SHARE;
+        pExynosPort->ePlaneType        = PLANE_SINGLE;
+        pExynosPort->tunnelFlags      |= EXYNOS_TUNNEL_SHARE_BUFFER;
+        Exynos_SetPlaneToPort(pExynosPort, Exynos_OSAL_GetPlaneCount(OMX_COLOR_FormatYUV420SemiPlanar, PLANE_SINGLE));
+        Exynos_UpdateFrameSize(pOMXComponent);
+    }
+
+    /* the output port always supplies, the peer has no say in it */
+    pTunnelSetup->nTunnelFlags = 0;
+    pTunnelSetup->eSupplier    = OMX_BufferSupplyOutput;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] output port tunneled to peer(%p) port(%d)", pExynosComponent, __FUNCTION__,
+                                        hTunneledComp, nTunneledPort);
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
+    FunctionOut();
+
     return ret;
 }
 #endif
@@ -619,7 +942,6 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 por
     EXYNOS_OMX_DATABUFFER           *pDataPortBuffer[2] = {NULL, NULL};
     EXYNOS_OMX_MESSAGE              *message            = NULL;
 
-    OMX_S32 semValue = 0;
     int i = 0;
 
     FunctionIn();
@@ -649,15 +971,17 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 por
     }
     pExynosPort = &pExynosComponent->pExynosPort[portIndex];
 
-    while (Exynos_OSAL_GetElemNum(&pExynosPort->bufferQ) > 0) {
-        Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->pExynosPort[portIndex].bufferSemID, &semValue);
-        if (semValue == 0)
-            Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[portIndex].bufferSemID);
+#ifdef USE_ANDROID
+    /* buffers on the way of image conversion are returned first */
+    if (portIndex == OUTPUT_PORT_INDEX)
+        Exynos_OSAL_ImgConv_Flush(pVideoDec->hImgConv);
+#endif
 
-        Exynos_OSAL_SemaphoreWait(pExynosComponent->pExynosPort[portIndex].bufferSemID);
-        message = (EXYNOS_OMX_MESSAGE *)Exynos_OSAL_Dequeue(&pExynosPort->bufferQ);
-        if ((message != NULL) &&
-            (message->type != EXYNOS_OMX_CommandFakeBuffer)) {
+    /* the buffer process thread is already parked on bufferMutex,
+     * so the queue can be drained directly and the tokens are dropped at the end.
+     */
+    while ((message = (EXYNOS_OMX_MESSAGE *)Exynos_OSAL_Dequeue(&pExynosPort->bufferQ)) != NULL) {
+        if (message->type != EXYNOS_OMX_CommandFakeBuffer) {
             bufferHeader = (OMX_BUFFERHEADERTYPE *)message->pCmdData;
             bufferHeader->nFilledLen = 0;
 
@@ -671,6 +995,14 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 por
         message = NULL;
     }
 
+    /* HDR10+ info is bound to frames that will never come out after flush */
+    if (portIndex == INPUT_PORT_INDEX) {
+        Exynos_OMX_HDR10PlusRing_Flush(pExynosComponent);
+    } else if (portIndex == OUTPUT_PORT_INDEX) {
+        while (Exynos_OSAL_GetElemNum(&pExynosPort->HdrDynamicInfoQ) > 0)
+            Exynos_OSAL_Free(Exynos_OSAL_Dequeue(&pExynosPort->HdrDynamicInfoQ));
+    }
+
     Exynos_OMX_GetFlushBuffer(pExynosPort, pDataPortBuffer);
     if (portIndex == INPUT_PORT_INDEX) {
         if (pDataPortBuffer[0]->dataValid == OMX_TRUE)
@@ -719,17 +1051,8 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 por
 #endif
 
     if (pExynosPort->bufferSemID != NULL) {
-        while (1) {
-            OMX_S32 cnt = 0;
-            Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
-            if (cnt == 0)
-                break;
-            else if (cnt > 0)
-                Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
-            else if (cnt < 0)
-                Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
-            Exynos_OSAL_SleepMillisec(0);
-        }
+        while (Exynos_OSAL_SemaphoreTryWait(pExynosPort->bufferSemID) == OMX_ErrorNone)
+            continue;
     }
 
     Exynos_OSAL_ResetQueue(&pExynosPort->bufferQ);
@@ -754,6 +1077,7 @@ OMX_ERRORTYPE Exynos_OMX_ForceHeaderParsing(
     OMX_PTR  pCodecBuffer   = NULL;
     OMX_S32  nBufferCnt     = 0;
     OMX_BOOL bSubmitCSD     = OMX_FALSE;
+    OMX_BOOL bInputStarted  = OMX_FALSE;
 
     FunctionIn();
 
@@ -774,6 +1098,7 @@ OMX_ERRORTYPE Exynos_OMX_ForceHeaderParsing(
                 break;
             }
             ret = pVideoDec->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+            bInputStarted = OMX_TRUE;
 
             if (ret == OMX_ErrorNone)
                 bSubmitCSD = OMX_TRUE;
@@ -803,6 +1128,7 @@ OMX_ERRORTYPE Exynos_OMX_ForceHeaderParsing(
 
             if (Exynos_Preprocessor_InputData(pOMXComponent, pSrcInputData) == OMX_TRUE) {
                 ret = pVideoDec->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+                bInputStarted = OMX_TRUE;
 
                 if (ret == OMX_ErrorNone)
                     bSubmitCSD = OMX_TRUE;
@@ -861,7 +1187,9 @@ OMX_ERRORTYPE Exynos_OMX_ForceHeaderParsing(
     } while (1);
 
 EXIT:
-    pVideoDec->exynos_codec_stop(pOMXComponent, INPUT_PORT_INDEX);
+    /* input was already stopped by the caller, streamoff again only if CSD has been queued */
+    if (bInputStarted == OMX_TRUE)
+        pVideoDec->exynos_codec_stop(pOMXComponent, INPUT_PORT_INDEX);
 
     if (bSubmitCSD == OMX_TRUE) {
         ret = pVideoDec->exynos_codec_checkResolutionChange(pOMXComponent);
@@ -892,6 +1220,7 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     EXYNOS_OMX_BASEPORT             *pExynosPort        = NULL;
     EXYNOS_OMX_DATABUFFER           *flushPortBuffer[2] = {NULL, NULL};
     EXYNOS_OMX_PORT_STATETYPE        ePortState         = EXYNOS_OMX_PortStateInvalid;
+    OMX_U64                          nStepTime          = 0;
 
     FunctionIn();
 
@@ -928,7 +1257,9 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] OMX_CommandFlush start, port:%d, event:%d",
                                     pExynosComponent, __FUNCTION__, nPortIndex, bEvent);
 
-    Exynos_OSAL_SignalSet(pExynosPort->pauseEvent);
+    Exynos_OMX_ResetFlushStepTime(pExynosPort, &nStepTime);
+
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
 
     Exynos_OMX_GetFlushBuffer(pExynosPort, flushPortBuffer);
     if (flushPortBuffer[0] == NULL) {
@@ -940,21 +1271,23 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
         Exynos_OSAL_SemaphorePost(pExynosPort->codecSemID);
 
     if (pExynosPort->bufferSemID != NULL) {
-        while (1) {
-            OMX_S32 cnt = 0;
+        OMX_S32 cnt = 0;
+
+        /* a waiter can take the token right away, keep posting until one remains */
+        Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
+        while (cnt <= 0) {
+            Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
             Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
-            if (cnt > 0)
-                break;
-            else
-                Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
-            Exynos_OSAL_SleepMillisec(0);
         }
     }
 
     pVideoDec->exynos_codec_bufferProcessRun(pOMXComponent, nPortIndex);
     Exynos_OSAL_MutexLock(flushPortBuffer[0]->bufferMutex);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_WAKEUP, &nStepTime);
 
     pVideoDec->exynos_codec_stop(pOMXComponent, nPortIndex);
+    EXYNOS_OMX_METRIC_SET(pExynosComponent->metrics.nHeldByCodec[nPortIndex], 0);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_STOP, &nStepTime);
 
     if (flushPortBuffer[1] != NULL)
         Exynos_OSAL_MutexLock(flushPortBuffer[1]->bufferMutex);
@@ -963,8 +1296,10 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
         /* try to find a CSD buffer and parse it */
         Exynos_OMX_ForceHeaderParsing(pOMXComponent, flushPortBuffer[0], &(pExynosPort->processData));
     }
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_HEADER, &nStepTime);
 
     ret = Exynos_OMX_FlushPort(pOMXComponent, nPortIndex);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_DRAIN, &nStepTime);
 
     if ((ePortState == EXYNOS_OMX_PortStateFlushingForDisable) &&
         (pVideoDec->bReconfigDPB == OMX_TRUE)) {
@@ -974,10 +1309,17 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     } else if (pExynosComponent->pExynosPort[nPortIndex].bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
         pVideoDec->exynos_codec_enqueueAllBuffer(pOMXComponent, nPortIndex);
     }
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_REQUEUE, &nStepTime);
 
     Exynos_ResetCodecData(&pExynosPort->processData);
 
     if (ret == OMX_ErrorNone) {
+        /* the load is measured again from the first frame after the flush */
+        __atomic_store_n(&pVideoDec->nLastOutputTimeStamp, DEFAULT_TIMESTAMP_VAL, __ATOMIC_RELEASE);
+        pVideoDec->nDropWindowTimeUs = 0;
+        pVideoDec->nDecodeLoad       = 0;
+        pVideoDec->nDropCredit       = 0;
+
         if (nPortIndex == INPUT_PORT_INDEX) {
             pExynosComponent->checkTimeStamp.needSetStartTimeStamp = OMX_TRUE;
             pExynosComponent->checkTimeStamp.needCheckStartTimeStamp = OMX_FALSE;
@@ -994,6 +1336,7 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
             if (pVideoDec->bReconfigDPB != OMX_TRUE)
                 pVideoDec->exynos_codec_start(pOMXComponent, nPortIndex);
         }
+        Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_START, &nStepTime);
 
 #ifdef PERFORMANCE_DEBUG
         Exynos_OSAL_CountReset(pExynosPort->hBufferCount);
@@ -1056,8 +1399,11 @@ OMX_ERRORTYPE Exynos_InputBufferReturn(
                                 OMX_EventMark,
                                 0, 0, pBufferHdr->pMarkData);
             } else {
+                /* taken by the output side, which may be on the image converter's worker */
+                Exynos_OSAL_MutexLock(pExynosComponent->compMutex);
                 pExynosComponent->propagateMarkType.hMarkTargetComponent    = pBufferHdr->hMarkTargetComponent;
                 pExynosComponent->propagateMarkType.pMarkData               = pBufferHdr->pMarkData;
+                Exynos_OSAL_MutexUnlock(pExynosComponent->compMutex);
             }
         }
 
@@ -1106,7 +1452,11 @@ OMX_ERRORTYPE Exynos_InputBufferGetQueue(EXYNOS_OMX_BASECOMPONENT *pExynosCompon
         if (pVideoDec->bForceHeaderParsing != OMX_TRUE) {
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(bufferSemID)",
                                                         pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
+            if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->bufferSemID) != OMX_ErrorNone) {
+                /* parked on the worker pool, the step is kicked again when a buffer is queued */
+                ret = OMX_ErrorNotReady;
+                goto EXIT;
+            }
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(bufferSemID)",
                                                         pExynosComponent, __FUNCTION__);
         }
@@ -1183,6 +1533,15 @@ OMX_ERRORTYPE Exynos_OutputBufferReturn(
             (pBufferHdr->nFilledLen > 0))
             pBufferHdr->nFilledLen = pBufferHdr->nAllocLen;
 
+        if ((pBufferHdr->nFilledLen > 0) &&
+            (pExynosComponent->hComponentHandle != NULL)) {
+            EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+            __atomic_store_n(&pVideoDec->nLastOutputTimeUs, Exynos_OSAL_GetSystemTimeUs(), __ATOMIC_RELAXED);
+            __atomic_store_n(&pVideoDec->nLastOutputTimeStamp, pBufferHdr->nTimeStamp, __ATOMIC_RELEASE);
+        }
+
+        Exynos_OSAL_MutexLock(pExynosComponent->compMutex);
         if (pExynosComponent->propagateMarkType.hMarkTargetComponent != NULL) {
             pBufferHdr->hMarkTargetComponent = pExynosComponent->propagateMarkType.hMarkTargetComponent;
             pBufferHdr->pMarkData            = pExynosComponent->propagateMarkType.pMarkData;
@@ -1190,6 +1549,7 @@ OMX_ERRORTYPE Exynos_OutputBufferReturn(
             pExynosComponent->propagateMarkType.hMarkTargetComponent    = NULL;
             pExynosComponent->propagateMarkType.pMarkData               = NULL;
         }
+        Exynos_OSAL_MutexUnlock(pExynosComponent->compMutex);
 
         if ((pBufferHdr->nFlags & OMX_BUFFERFLAG_EOS) == OMX_BUFFERFLAG_EOS) {
             Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] send event(OMX_EventBufferFlag)",
@@ -1246,7 +1606,11 @@ OMX_ERRORTYPE Exynos_OutputBufferGetQueue(EXYNOS_OMX_BASECOMPONENT *pExynosCompo
                (!CHECK_PORT_BEING_FLUSHED(pExynosPort))) {
         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(bufferSemID)",
                                                     pExynosComponent, __FUNCTION__);
-        Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
+        if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->bufferSemID) != OMX_ErrorNone) {
+            /* parked on the worker pool, the step is kicked again when a buffer is queued */
+            ret = OMX_ErrorNotReady;
+            goto EXIT;
+        }
         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(bufferSemID)",
                                                     pExynosComponent, __FUNCTION__);
         if (outputUseBuffer->dataValid != OMX_TRUE) {
@@ -1365,6 +1729,7 @@ OMX_ERRORTYPE Exynos_CodecBufferEnQueue(EXYNOS_OMX_BASECOMPONENT *pExynosCompone
         goto EXIT;
     }
     Exynos_OSAL_SemaphorePost(pExynosPort->codecSemID);
+    Exynos_OMX_WakeBufferProcess(pExynosComponent, PortIndex);
 
     ret = OMX_ErrorNone;
 
@@ -1396,7 +1761,12 @@ OMX_ERRORTYPE Exynos_CodecBufferDeQueue(EXYNOS_OMX_BASECOMPONENT *pExynosCompone
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> wait(codecSemID)",
                                                 pExynosComponent, __FUNCTION__,
                                                 (PortIndex == INPUT_PORT_INDEX)? "input":"output");
-    Exynos_OSAL_SemaphoreWait(pExynosPort->codecSemID);
+    if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->codecSemID) != OMX_ErrorNone) {
+        /* parked on the worker pool, Exynos_CodecBufferEnQueue() kicks it again */
+        *data = NULL;
+        ret = OMX_ErrorNotReady;
+        goto EXIT;
+    }
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> wait(codecSemID)",
                                                 pExynosComponent, __FUNCTION__,
                                                 (PortIndex == INPUT_PORT_INDEX)? "input":"output");
@@ -1675,6 +2045,32 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeGetParameter(
         pCorruptedHeader->bDiscardEvent = pVideoDec->bDiscardCSDError;
     }
         break;
+    case OMX_IndexParamEnableKeyFrameOnlyMode:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pKeyFrameOnlyMode = (OMX_CONFIG_BOOLEANTYPE *)ComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pKeyFrameOnlyMode, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        pKeyFrameOnlyMode->bEnabled = pVideoDec->bKeyFrameOnlyMode;
+    }
+        break;
+    case OMX_IndexParamVideoDropControl:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pDropControl = (OMX_CONFIG_BOOLEANTYPE *)ComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pDropControl, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        pDropControl->bEnabled = pVideoDec->bDropControl;
+    }
+        break;
     case OMX_IndexParamVideoCompressedColorFormat:
     {
         OMX_PARAM_U32TYPE *pColorFormat = (OMX_PARAM_U32TYPE *)ComponentParameterStructure;
@@ -1948,6 +2344,66 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeSetParameter(
             pExynosOutputPort->portDefinition.nBufferCountActual = 1;
         }
 
+        ret = OMX_ErrorNone;
+    }
+        break;
+    case OMX_IndexParamEnableKeyFrameOnlyMode:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pKeyFrameOnlyMode = (OMX_CONFIG_BOOLEANTYPE *)ComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pKeyFrameOnlyMode, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+            (pVideoDec->bKeyFrameOnlyMode != pKeyFrameOnlyMode->bEnabled)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] key frame only mode can be changed at Loaded state only", pExynosComponent, __FUNCTION__);
+            ret = OMX_ErrorIncorrectStateOperation;
+            goto EXIT;
+        }
+
+        if (pVideoDec->bKeyFrameOnlyMode != pKeyFrameOnlyMode->bEnabled) {
+            EXYNOS_OMX_BASEPORT *pExynosOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+            if (pKeyFrameOnlyMode->bEnabled == OMX_TRUE) {
+                pVideoDec->nKeyFrameOnlySavedCountMin    = pExynosOutputPort->portDefinition.nBufferCountMin;
+                pVideoDec->nKeyFrameOnlySavedCountActual = pExynosOutputPort->portDefinition.nBufferCountActual;
+
+                /* no inter prediction, one buffer is decoded while the other is displayed */
+                pExynosOutputPort->portDefinition.nBufferCountMin    = 1;
+                pExynosOutputPort->portDefinition.nBufferCountActual = 2;
+            } else {
+                /* counts the client has set in the meantime are kept */
+                if (pExynosOutputPort->portDefinition.nBufferCountMin == 1)
+                    pExynosOutputPort->portDefinition.nBufferCountMin = pVideoDec->nKeyFrameOnlySavedCountMin;
+                if (pExynosOutputPort->portDefinition.nBufferCountActual == 2)
+                    pExynosOutputPort->portDefinition.nBufferCountActual = pVideoDec->nKeyFrameOnlySavedCountActual;
+            }
+        }
+
+        pVideoDec->bKeyFrameOnlyMode = pKeyFrameOnlyMode->bEnabled;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] key frame only mode : %s", pExynosComponent, __FUNCTION__,
+                                            (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE) ? "enable" : "disable");
+        ret = OMX_ErrorNone;
+    }
+        break;
+    case OMX_IndexParamVideoDropControl:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pDropControl = (OMX_CONFIG_BOOLEANTYPE *)ComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pDropControl, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        pVideoDec->bDropControl      = pDropControl->bEnabled;
+        pVideoDec->nDropCredit       = 0;
+        pVideoDec->nDropWindowTimeUs = 0;
+        pVideoDec->nDecodeLoad       = 0;
         ret = OMX_ErrorNone;
     }
         break;
@@ -2113,6 +2569,30 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeGetConfig(
         Exynos_OSAL_Memcpy(pBlackBarCropRect, &pVideoDec->blackBarCropRect, sizeof(OMX_CONFIG_RECTTYPE));
     }
         break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pConfigTrimMemory = (OMX_CONFIG_BOOLEANTYPE *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pConfigTrimMemory, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        pConfigTrimMemory->bEnabled = pVideoDec->bTrimMemory;
+    }
+        break;
+    case OMX_IndexConfigVideoPipelineMetrics:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *pMetrics = (EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_GetConfig(hComponent, nIndex, pComponentConfigStructure);
+        if (ret != OMX_ErrorNone)
+            goto EXIT;
+
+        pMetrics->nIonKB = (OMX_U32)(Exynos_OSAL_SharedMemory_GetAllocBytes(pVideoDec->hSharedMemory) >> 10);
+    }
+        break;
     case OMX_IndexConfigCommonInputCrop:
     {
         OMX_CONFIG_RECTTYPE *pDstRectType = (OMX_CONFIG_RECTTYPE *)pComponentConfigStructure;
@@ -2286,6 +2766,24 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeSetConfig(
         pVideoDec->bSearchBlackBar        = pConfigSearchBlackBar->bEnabled;
         pVideoDec->bSearchBlackBarChanged = OMX_TRUE;
 
+        ret = OMX_ErrorNone;
+    }
+        break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pConfigTrimMemory = (OMX_CONFIG_BOOLEANTYPE *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pConfigTrimMemory, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        /* applied at the next input flush or codec init */
+        pVideoDec->bTrimMemory = pConfigTrimMemory->bEnabled;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] trim memory : %d", pExynosComponent, __FUNCTION__, pVideoDec->bTrimMemory);
+
         ret = OMX_ErrorNone;
     }
         break;
@@ -2436,6 +2934,12 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeGetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_ENABLE_KEYFRAME_ONLY) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
     if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_BLACK_BAR_CROP_INFO) == 0) {
         *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigBlackBarCrop;
         goto EXIT;
@@ -2446,6 +2950,12 @@ OMX_ERRORTYPE Exynos_OMX_VideoDecodeGetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_TRIM_MEMORY) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigTrimMemory;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
 #ifdef USE_ANDROID
     if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_USE_ANB2) == 0) {
         *pIndexType = (OMX_INDEXTYPE) OMX_IndexParamUseAndroidNativeBuffer2;
@@ -2551,6 +3061,12 @@ OMX_ERRORTYPE Exynos_Shared_BufferToData(
 
     if (pExynosPort->eMetaDataType == METADATA_TYPE_DISABLED) {
         pData->buffer.addr[0] = pUseBuffer->bufferHeader->pBuffer;
+#ifdef TUNNELING_SUPPORT
+        /* a tunnel buffer is ION memory of this component, MFC takes it by the fd */
+        if (CHECK_PORT_BUFFER_SUPPLIER(pExynosPort) &&
+            (pUseBuffer->bufferHeader->pOutputPortPrivate != NULL))
+            pData->buffer.fd[0] = ((EXYNOS_OMX_TUNNEL_BUFFER *)pUseBuffer->bufferHeader->pOutputPortPrivate)->fd;
+#endif
     } else {
         /* metadata type */
         EXYNOS_OMX_MULTIPLANE_BUFFER bufferInfo;
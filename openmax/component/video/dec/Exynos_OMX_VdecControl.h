@@ -60,11 +60,11 @@ OMX_ERRORTYPE Exynos_OMX_FreeBuffer(
 
 #ifdef TUNNELING_SUPPORT
 OMX_ERRORTYPE Exynos_OMX_AllocateTunnelBuffer(
-    EXYNOS_OMX_BASEPORT *pOMXBasePort,
-    OMX_U32           nPortIndex);
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex);
 OMX_ERRORTYPE Exynos_OMX_FreeTunnelBuffer(
-    EXYNOS_OMX_BASEPORT *pOMXBasePort,
-    OMX_U32           nPortIndex);
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex);
 OMX_ERRORTYPE Exynos_OMX_ComponentTunnelRequest(
     OMX_IN  OMX_HANDLETYPE hComp,
     OMX_IN OMX_U32         nPort,
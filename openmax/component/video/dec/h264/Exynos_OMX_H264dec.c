@@ -340,6 +340,67 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Check_H264_KeyFrame(
+    OMX_U8 *pInputStream,
+    OMX_U32 streamSize)
+{
+    OMX_BOOL ret = OMX_TRUE;
+    OMX_U32  i;
+
+    FunctionIn();
+
+    /* the first slice decides, SEI/SPS/PPS/AUD ahead of it are skipped */
+    for (i = 0; (i + 3) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01)) {
+            OMX_U8 nNalType = pInputStream[i + 3] & 0x1F;
+
+            if ((nNalType >= 1) && (nNalType <= 5)) {  /* coded slice */
+                ret = (nNalType == 5)? OMX_TRUE:OMX_FALSE;  /* IDR */
+                break;
+            }
+
+            i += 3;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
+static OMX_BOOL Check_H264_NonRefFrame(
+    OMX_COMPONENTTYPE *pOMXComponent,
+    OMX_U8            *pInputStream,
+    OMX_U32            streamSize)
+{
+    OMX_BOOL ret = OMX_FALSE;
+    OMX_U32  i;
+
+    FunctionIn();
+
+    for (i = 0; (i + 3) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01)) {
+            OMX_U8 nNalType = pInputStream[i + 3] & 0x1F;
+
+            if ((nNalType >= 1) && (nNalType <= 5)) {  /* coded slice */
+                /* nal_ref_idc is 0 : nobody refers to this picture */
+                ret = ((nNalType != 5) && (((pInputStream[i + 3] >> 5) & 0x03) == 0))? OMX_TRUE:OMX_FALSE;
+                break;
+            }
+
+            i += 3;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -734,6 +795,8 @@ OMX_ERRORTYPE H264CodecReconfigAllBuffers(
         pBufferOps  = pH264Dec->hMFCH264Handle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -775,6 +838,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE H264CodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_H264DEC_HANDLE           *pH264Dec           = (EXYNOS_H264DEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pH264Dec->hMFCH264Handle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pH264Dec->hMFCH264Handle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pH264Dec->hMFCH264Handle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pH264Dec->hMFCH264Handle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pH264Dec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE H264CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
 {
     OMX_ERRORTYPE                  ret              = OMX_ErrorNone;
@@ -796,15 +893,7 @@ OMX_ERRORTYPE H264CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U3
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1145,8 +1234,7 @@ OMX_ERRORTYPE H264CodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1278,8 +1366,7 @@ OMX_ERRORTYPE H264CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     pH264Dec->hMFCH264Handle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        pH264Dec->hMFCH264Handle.maxDPBNum += EXTRA_DPB_NUM;
+    pH264Dec->hMFCH264Handle.maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pH264Dec->hMFCH264Handle.maxDPBNum);
 
     /* get interlace info */
@@ -1348,6 +1435,16 @@ OMX_ERRORTYPE H264CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pH264Dec->hMFCH264Handle.codecOutbufConf.nFrameWidth,
+                                     pH264Dec->hMFCH264Handle.codecOutbufConf.nFrameHeight,
+                                     pH264Dec->hMFCH264Handle.codecOutbufConf.nAlignPlaneSize,
+                                     &pH264Dec->hMFCH264Handle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pH264Dec->hMFCH264Handle.codecOutbufConf.nFrameWidth) ||
@@ -1585,7 +1682,8 @@ OMX_ERRORTYPE H264CodecSrcSetup(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DAT
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
     else if ((IS_CUSTOM_COMPONENT(pExynosComponent->componentName) == OMX_TRUE) &&
              (pH264Dec->hMFCH264Handle.nDisplayDelay <= MAX_H264_DISPLAYDELAY_VALIDNUM)) {
@@ -1803,7 +1901,9 @@ OMX_ERRORTYPE H264CodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2532,7 +2632,6 @@ OMX_ERRORTYPE Exynos_H264Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     ExynosVideoInstInfo *pVideoInstInfo = &(pH264Dec->hMFCH264Handle.videoInstInfo);
 
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2558,6 +2657,8 @@ OMX_ERRORTYPE Exynos_H264Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pH264Dec->hMFCH264Handle.pInbufOps, pH264Dec->hMFCH264Handle.pOutbufOps, pH264Dec->hMFCH264Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2569,13 +2670,10 @@ OMX_ERRORTYPE Exynos_H264Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
 
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2894,16 +2992,8 @@ OMX_ERRORTYPE Exynos_H264Dec_SrcOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX
         pSrcOutputData->allocSize       = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] == pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -3086,6 +3176,8 @@ OMX_ERRORTYPE Exynos_H264Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX
             pVideoDec->bReconfigDPB = OMX_TRUE;
             H264CodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
 #ifdef USE_S3D_SUPPORT
             pH264Dec->hMFCH264Handle.S3DFPArgmtType = OMX_SEC_FPARGMT_INVALID;
 #endif
@@ -3479,6 +3571,10 @@ OMX_ERRORTYPE Exynos_H264Dec_dstInputBufferProcess(OMX_COMPONENTTYPE *pOMXCompon
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pH264Dec->hMFCH264Handle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_H264Dec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -3746,9 +3842,12 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &H264CodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &H264CodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &H264CodecCheckResolution;
+    pVideoDec->exynos_codec_checkKeyFrame           = &Check_H264_KeyFrame;
+    pVideoDec->exynos_codec_checkNonRefFrame        = &Check_H264_NonRefFrame;
 
     pVideoDec->exynos_codec_updateExtraInfo = &H264CodecUpdateExtraInfo;
 
@@ -3795,6 +3894,8 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
     Exynos_OSAL_AddVendorExt(hComponent, "rtc-ext-dec-low-latency", (OMX_INDEXTYPE)OMX_IndexSkypeParamLowLatency);
 #endif
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-drop-control", (OMX_INDEXTYPE)OMX_IndexParamVideoDropControl);
 #endif
 
     pExynosComponent->currentState = OMX_StateLoaded;
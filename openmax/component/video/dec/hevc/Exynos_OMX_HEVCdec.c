@@ -343,6 +343,77 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Check_HEVC_KeyFrame(
+    OMX_U8     *pInputStream,
+    OMX_U32     streamSize)
+{
+    OMX_BOOL ret = OMX_TRUE;
+    OMX_U32  i;
+
+    FunctionIn();
+
+    /* the first slice decides, VPS/SPS/PPS/SEI/AUD ahead of it are skipped */
+    for (i = 0; (i + 3) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01)) {
+            OMX_U8 nNalType = (pInputStream[i + 3] >> 1) & 0x3F;
+
+            if (nNalType < 32) {  /* VCL */
+                ret = ((nNalType >= 16) && (nNalType <= 23))? OMX_TRUE:OMX_FALSE;  /* IRAP(BLA, IDR, CRA) */
+                break;
+            }
+
+            i += 3;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
+static OMX_BOOL Check_HEVC_NonRefFrame(
+    OMX_COMPONENTTYPE *pOMXComponent,
+    OMX_U8            *pInputStream,
+    OMX_U32            streamSize)
+{
+    OMX_BOOL                       ret              = OMX_FALSE;
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_HEVCDEC_HANDLE         *pHevcDec         = (EXYNOS_HEVCDEC_HANDLE *)pVideoDec->hCodecHandle;
+    OMX_U32                        i;
+
+    FunctionIn();
+
+    for (i = 0; (i + 4) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01)) {
+            OMX_U8  nNalType    = (pInputStream[i + 3] >> 1) & 0x3F;
+            OMX_U32 nTemporalId = (pInputStream[i + 4] & 0x07);
+
+            if (nNalType < 32) {  /* VCL */
+                nTemporalId = (nTemporalId > 0)? (nTemporalId - 1):0;
+                if (nTemporalId > pHevcDec->nMaxTemporalId)
+                    pHevcDec->nMaxTemporalId = nTemporalId;
+
+                /* sub-layer non-reference(even types below 16) can still be referred by higher sub-layers */
+                ret = ((nNalType < 16) &&
+                       ((nNalType & 0x01) == 0) &&
+                       (nTemporalId >= pHevcDec->nMaxTemporalId))? OMX_TRUE:OMX_FALSE;
+                break;
+            }
+
+            i += 3;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -647,6 +718,9 @@ OMX_ERRORTYPE HevcCodecStop(
 
     if ((nPortIndex == INPUT_PORT_INDEX) && (pInbufOps != NULL)) {
         pInbufOps->Stop(hMFCHandle);
+
+        /* the stream may restart at another layer structure after a flush or a seek */
+        pHevcDec->nMaxTemporalId = 0;
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) && (pOutbufOps != NULL)) {
         EXYNOS_OMX_BASEPORT *pOutputPort = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
 
@@ -747,6 +821,8 @@ OMX_ERRORTYPE HevcCodecReconfigAllBuffers(
         pBufferOps  = pHevcDec->hMFCHevcHandle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -788,6 +864,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE HevcCodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_HEVCDEC_HANDLE           *pHevcDec           = (EXYNOS_HEVCDEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pHevcDec->hMFCHevcHandle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pHevcDec->hMFCHevcHandle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pHevcDec->hMFCHevcHandle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pHevcDec->hMFCHevcHandle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pHevcDec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE HevcCodecEnQueueAllBuffer(
     OMX_COMPONENTTYPE  *pOMXComponent,
     OMX_U32             nPortIndex)
@@ -810,15 +920,7 @@ OMX_ERRORTYPE HevcCodecEnQueueAllBuffer(
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1327,8 +1429,7 @@ OMX_ERRORTYPE HevcCodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1467,8 +1568,7 @@ OMX_ERRORTYPE HevcCodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     pHevcDec->hMFCHevcHandle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        pHevcDec->hMFCHevcHandle.maxDPBNum += EXTRA_DPB_NUM;
+    pHevcDec->hMFCHevcHandle.maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pHevcDec->hMFCHevcHandle.maxDPBNum);
 
     pCropRectangle          = &(pOutputPort->cropRectangle[IMG_CROP_OUTPUT_PORT]);
@@ -1539,6 +1639,16 @@ OMX_ERRORTYPE HevcCodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pHevcDec->hMFCHevcHandle.codecOutbufConf.nFrameWidth,
+                                     pHevcDec->hMFCHevcHandle.codecOutbufConf.nFrameHeight,
+                                     pHevcDec->hMFCHevcHandle.codecOutbufConf.nAlignPlaneSize,
+                                     &pHevcDec->hMFCHevcHandle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pHevcDec->hMFCHevcHandle.codecOutbufConf.nFrameWidth) ||
@@ -1806,7 +1916,8 @@ OMX_ERRORTYPE HevcCodecSrcSetup(
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
     else if ((IS_CUSTOM_COMPONENT(pExynosComponent->componentName) == OMX_TRUE) &&
              (pHevcDec->hMFCHevcHandle.nDisplayDelay <= MAX_HEVC_DISPLAYDELAY_VALIDNUM)) {
@@ -2021,7 +2132,9 @@ OMX_ERRORTYPE HevcCodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2934,7 +3047,6 @@ OMX_ERRORTYPE Exynos_HevcDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
     ExynosVideoInstInfo *pVideoInstInfo = &(pHevcDec->hMFCHevcHandle.videoInstInfo);
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2960,6 +3072,8 @@ OMX_ERRORTYPE Exynos_HevcDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pHevcDec->hMFCHevcHandle.pInbufOps, pHevcDec->hMFCHevcHandle.pOutbufOps, pHevcDec->hMFCHevcHandle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2971,12 +3085,9 @@ OMX_ERRORTYPE Exynos_HevcDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -3295,17 +3406,8 @@ OMX_ERRORTYPE Exynos_HevcDec_SrcOut(
         pSrcOutputData->allocSize  = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -3492,6 +3594,8 @@ OMX_ERRORTYPE Exynos_HevcDec_DstOut(
             pVideoDec->bReconfigDPB = OMX_TRUE;
             HevcCodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
 #ifdef USE_S3D_SUPPORT
             pHevcDec->hMFCHevcHandle.S3DFPArgmtType = OMX_SEC_FPARGMT_INVALID;
 #endif
@@ -3891,6 +3995,10 @@ OMX_ERRORTYPE Exynos_HevcDec_dstInputBufferProcess(
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pHevcDec->hMFCHevcHandle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_HevcDec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -4161,9 +4269,12 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &HevcCodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &HevcCodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &HevcCodecCheckResolution;
+    pVideoDec->exynos_codec_checkKeyFrame           = &Check_HEVC_KeyFrame;
+    pVideoDec->exynos_codec_checkNonRefFrame        = &Check_HEVC_NonRefFrame;
 
     pVideoDec->exynos_codec_updateExtraInfo = &HevcCodecUpdateExtraInfo;
 
@@ -4210,6 +4321,8 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
 #ifdef USE_ANDROID
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-drop-control", (OMX_INDEXTYPE)OMX_IndexParamVideoDropControl);
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-imageformat-filter-enableInplace", (OMX_INDEXTYPE)OMX_IndexExynosParamImageConvertMode);
 #endif
 
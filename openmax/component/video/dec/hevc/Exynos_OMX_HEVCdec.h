@@ -84,6 +84,8 @@ typedef struct _EXYNOS_HEVCDEC_HANDLE
     OMX_HANDLETYPE hDestinationOutStartEvent;
 
     EXYNOS_QUEUE bypassBufferInfoQ;
+
+    OMX_U32 nMaxTemporalId;  /* the highest TemporalId seen, for dropping non-reference pictures */
 } EXYNOS_HEVCDEC_HANDLE;
 
 #ifdef __cplusplus
@@ -294,6 +294,32 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Check_Mpeg2_KeyFrame(
+    OMX_U8     *pInputStream,
+    OMX_U32     streamSize)
+{
+    OMX_BOOL ret = OMX_TRUE;
+    OMX_U32  i;
+
+    FunctionIn();
+
+    /* sequence/GOP headers ahead of the picture header are skipped */
+    for (i = 0; (i + 5) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01) &&
+            (pInputStream[i + 3] == 0x00)) {  /* picture start code */
+            /* temporal_reference(10) picture_coding_type(3) : 1 is I picture */
+            ret = (((pInputStream[i + 5] >> 3) & 0x07) == 0x01)? OMX_TRUE:OMX_FALSE;
+            break;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -677,6 +703,8 @@ OMX_ERRORTYPE Mpeg2CodecReconfigAllBuffers(
         pBufferOps = pMpeg2Dec->hMFCMpeg2Handle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -718,6 +746,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE Mpeg2CodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_MPEG2DEC_HANDLE          *pMpeg2Dec          = (EXYNOS_MPEG2DEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pMpeg2Dec->hMFCMpeg2Handle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pMpeg2Dec->hMFCMpeg2Handle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pMpeg2Dec->hMFCMpeg2Handle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pMpeg2Dec->hMFCMpeg2Handle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pMpeg2Dec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE Mpeg2CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
@@ -739,15 +801,7 @@ OMX_ERRORTYPE Mpeg2CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -948,8 +1002,7 @@ OMX_ERRORTYPE Mpeg2CodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1081,8 +1134,7 @@ OMX_ERRORTYPE Mpeg2CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     pMpeg2Dec->hMFCMpeg2Handle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        pMpeg2Dec->hMFCMpeg2Handle.maxDPBNum += EXTRA_DPB_NUM;
+    pMpeg2Dec->hMFCMpeg2Handle.maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pMpeg2Dec->hMFCMpeg2Handle.maxDPBNum);
 
     /* get interlace info */
@@ -1151,6 +1203,16 @@ OMX_ERRORTYPE Mpeg2CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pMpeg2Dec->hMFCMpeg2Handle.codecOutbufConf.nFrameWidth,
+                                     pMpeg2Dec->hMFCMpeg2Handle.codecOutbufConf.nFrameHeight,
+                                     pMpeg2Dec->hMFCMpeg2Handle.codecOutbufConf.nAlignPlaneSize,
+                                     &pMpeg2Dec->hMFCMpeg2Handle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pMpeg2Dec->hMFCMpeg2Handle.codecOutbufConf.nFrameWidth) ||
@@ -1385,7 +1447,8 @@ OMX_ERRORTYPE Mpeg2CodecSrcSetup(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DA
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
 
     if ((pDecOps->Enable_DTSMode != NULL) &&
@@ -1594,7 +1657,9 @@ OMX_ERRORTYPE Mpeg2CodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2186,7 +2251,6 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     ExynosVideoInstInfo *pVideoInstInfo = &(pMpeg2Dec->hMFCMpeg2Handle.videoInstInfo);
 
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2213,6 +2277,8 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pMpeg2Dec->hMFCMpeg2Handle.pInbufOps, pMpeg2Dec->hMFCMpeg2Handle.pOutbufOps, pMpeg2Dec->hMFCMpeg2Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2224,13 +2290,10 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
 
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2527,17 +2590,8 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_SrcOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OM
         pSrcOutputData->allocSize  = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -2704,6 +2758,8 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OM
             pVideoDec->bReconfigDPB = OMX_TRUE;
             Mpeg2CodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
         }
         ret = OMX_ErrorNone;
         goto EXIT;
@@ -3074,6 +3130,10 @@ OMX_ERRORTYPE Exynos_Mpeg2Dec_dstInputBufferProcess(OMX_COMPONENTTYPE *pOMXCompo
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pMpeg2Dec->hMFCMpeg2Handle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_Mpeg2Dec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -3328,9 +3388,11 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &Mpeg2CodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &Mpeg2CodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &Mpeg2CodecCheckResolution;
+    pVideoDec->exynos_codec_checkKeyFrame           = &Check_Mpeg2_KeyFrame;
 
     pVideoDec->exynos_codec_updateExtraInfo = &Mpeg2CodecUpdateExtraInfo;
 
@@ -3372,6 +3434,7 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
 #ifdef USE_ANDROID
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
 #endif
 
     pExynosComponent->currentState = OMX_StateLoaded;
@@ -341,6 +341,60 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Check_Mpeg4_KeyFrame(
+    OMX_U8    *pInputStream,
+    OMX_U32    streamSize)
+{
+    OMX_BOOL ret = OMX_TRUE;
+    OMX_U32  i;
+
+    FunctionIn();
+
+    /* VOS/VO/VOL/GOV headers ahead of the VOP are skipped */
+    for (i = 0; (i + 4) < streamSize; i++) {
+        if ((pInputStream[i] == 0x00) &&
+            (pInputStream[i + 1] == 0x00) &&
+            (pInputStream[i + 2] == 0x01) &&
+            (pInputStream[i + 3] == 0xB6)) {  /* VOP start code */
+            /* vop_coding_type(2) : 0 is I-VOP */
+            ret = ((pInputStream[i + 4] >> 6) == 0x00)? OMX_TRUE:OMX_FALSE;
+            break;
+        }
+    }
+
+    FunctionOut();
+
+    return ret;
+}
+
+static OMX_BOOL Check_H263_KeyFrame(
+    OMX_U8    *pInputStream,
+    OMX_U32    streamSize)
+{
+    OMX_BOOL ret = OMX_TRUE;
+
+    FunctionIn();
+
+    /* PSC(22) TR(8) PTYPE(13) : picture is at the head of a buffer */
+    if ((streamSize < 5) ||
+        (pInputStream[0] != 0x00) ||
+        (pInputStream[1] != 0x00) ||
+        ((pInputStream[2] & 0xFC) != 0x80))
+        goto EXIT;
+
+    /* source format 7 is PLUSPTYPE, let the codec decide */
+    if (((pInputStream[4] >> 2) & 0x07) == 0x07)
+        goto EXIT;
+
+    /* picture coding type : 0 is INTRA */
+    ret = (((pInputStream[4] >> 1) & 0x01) == 0x00)? OMX_TRUE:OMX_FALSE;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -723,6 +777,8 @@ OMX_ERRORTYPE Mpeg4CodecReconfigAllBuffers(
         pBufferOps = pMpeg4Dec->hMFCMpeg4Handle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -764,6 +820,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE Mpeg4CodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_MPEG4DEC_HANDLE          *pMpeg4Dec          = (EXYNOS_MPEG4DEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pMpeg4Dec->hMFCMpeg4Handle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pMpeg4Dec->hMFCMpeg4Handle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pMpeg4Dec->hMFCMpeg4Handle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pMpeg4Dec->hMFCMpeg4Handle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pMpeg4Dec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE Mpeg4CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
@@ -785,15 +875,7 @@ OMX_ERRORTYPE Mpeg4CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -938,8 +1020,7 @@ OMX_ERRORTYPE Mpeg4CodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1071,8 +1152,7 @@ OMX_ERRORTYPE Mpeg4CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     pMpeg4Dec->hMFCMpeg4Handle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        pMpeg4Dec->hMFCMpeg4Handle.maxDPBNum += EXTRA_DPB_NUM;
+    pMpeg4Dec->hMFCMpeg4Handle.maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pMpeg4Dec->hMFCMpeg4Handle.maxDPBNum);
 
     /* get interlace info */
@@ -1141,6 +1221,16 @@ OMX_ERRORTYPE Mpeg4CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pMpeg4Dec->hMFCMpeg4Handle.codecOutbufConf.nFrameWidth,
+                                     pMpeg4Dec->hMFCMpeg4Handle.codecOutbufConf.nFrameHeight,
+                                     pMpeg4Dec->hMFCMpeg4Handle.codecOutbufConf.nAlignPlaneSize,
+                                     &pMpeg4Dec->hMFCMpeg4Handle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pMpeg4Dec->hMFCMpeg4Handle.codecOutbufConf.nFrameWidth) ||
@@ -1377,7 +1467,8 @@ OMX_ERRORTYPE Mpeg4CodecSrcSetup(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DA
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
 
     if ((pDecOps->Enable_DTSMode != NULL) &&
@@ -1594,7 +1685,9 @@ OMX_ERRORTYPE Mpeg4CodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2320,7 +2413,6 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     ExynosVideoInstInfo *pVideoInstInfo = &(pMpeg4Dec->hMFCMpeg4Handle.videoInstInfo);
 
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2347,6 +2439,8 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pMpeg4Dec->hMFCMpeg4Handle.pInbufOps, pMpeg4Dec->hMFCMpeg4Handle.pOutbufOps, pMpeg4Dec->hMFCMpeg4Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2357,13 +2451,10 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
 
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2677,17 +2768,8 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_SrcOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OM
         pSrcOutputData->allocSize  = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -2854,6 +2936,8 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OM
             pVideoDec->bReconfigDPB = OMX_TRUE;
             Mpeg4CodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
         }
         ret = OMX_ErrorNone;
         goto EXIT;
@@ -3246,6 +3330,10 @@ OMX_ERRORTYPE Exynos_Mpeg4Dec_dstInputBufferProcess(OMX_COMPONENTTYPE *pOMXCompo
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pMpeg4Dec->hMFCMpeg4Handle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_Mpeg4Dec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -3528,9 +3616,14 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &Mpeg4CodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &Mpeg4CodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &Mpeg4CodecCheckResolution;
+    if (pMpeg4Dec->hMFCMpeg4Handle.codecType == CODEC_TYPE_MPEG4)
+        pVideoDec->exynos_codec_checkKeyFrame     = &Check_Mpeg4_KeyFrame;
+    else
+        pVideoDec->exynos_codec_checkKeyFrame     = &Check_H263_KeyFrame;
 
     pVideoDec->exynos_codec_updateExtraInfo = &Mpeg4CodecUpdateExtraInfo;
 
@@ -3577,6 +3670,7 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(OMX_HANDLETYPE hComponent
 
 #ifdef USE_ANDROID
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
 #endif
 
     pExynosComponent->currentState = OMX_StateLoaded;
@@ -355,33 +355,54 @@ OMX_BOOL Make_Stream_MetaData(
     return ret;
 }
 
-static OMX_BOOL Make_Stream_StartCode(
-    OMX_U8          *pInputStream,
-    OMX_U32         *pStreamSize,
-    WMV_FORMAT       wmvFormat)
+/* writes the start code of the format when pStartCode is given, returns its length (0: none) */
+static OMX_U32 Put_Stream_StartCode(
+    WMV_FORMAT       wmvFormat,
+    OMX_U8          *pStartCode)
 {
-    OMX_BOOL ret             = OMX_FALSE;
-    OMX_U8   vc1StartCode[4] = {0x00, 0x00, 0x01, 0x0d};
+    OMX_U8 vc1StartCode[4] = {0x00, 0x00, 0x01, 0x0d};
 
 #ifdef WMV3_ADDITIONAL_START_CODE
      /* first 4 bytes : size of Frame, second 4 bytes : present Time stamp */
-    OMX_U8  wmvStartCode[8] = {0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
+    OMX_U8 wmvStartCode[8] = {0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
 #endif
 
     switch ((int)wmvFormat) {
     case WMV_FORMAT_WMV3:
 #ifdef WMV3_ADDITIONAL_START_CODE
-        Exynos_OSAL_Memmove(pInputStream + 8, pInputStream, (*pStreamSize));
-        Exynos_OSAL_Memcpy(pInputStream, wmvStartCode, 8);
-        (*pStreamSize) += 8;
+        if (pStartCode != NULL)
+            Exynos_OSAL_Memcpy(pStartCode, wmvStartCode, sizeof(wmvStartCode));
+        return sizeof(wmvStartCode);
+#else
+        return 0;
 #endif
-        ret = OMX_TRUE;
-        break;
     case WMV_FORMAT_VC1:
-        /* Should find better way to shift data */
-        Exynos_OSAL_Memmove(pInputStream + 4, pInputStream, (*pStreamSize));
-        Exynos_OSAL_Memcpy(pInputStream, vc1StartCode, 4);
-        (*pStreamSize) += 4;
+        if (pStartCode != NULL)
+            Exynos_OSAL_Memcpy(pStartCode, vc1StartCode, sizeof(vc1StartCode));
+        return sizeof(vc1StartCode);
+    default:
+        return 0;
+    }
+}
+
+static OMX_BOOL Make_Stream_StartCode(
+    OMX_U8          *pInputStream,
+    OMX_U32         *pStreamSize,
+    WMV_FORMAT       wmvFormat)
+{
+    OMX_BOOL ret  = OMX_FALSE;
+    OMX_U32  nLen = 0;
+
+    switch ((int)wmvFormat) {
+    case WMV_FORMAT_WMV3:
+    case WMV_FORMAT_VC1:
+        /* only for buffers shared with the client, copied ones get it by Make_Stream_StartCodePrefix() */
+        nLen = Put_Stream_StartCode(wmvFormat, NULL);
+        if (nLen > 0) {
+            Exynos_OSAL_Memmove(pInputStream + nLen, pInputStream, (*pStreamSize));
+            Put_Stream_StartCode(wmvFormat, pInputStream);
+            (*pStreamSize) += nLen;
+        }
         ret = OMX_TRUE;
         break;
     default:
@@ -390,10 +411,45 @@ static OMX_BOOL Make_Stream_StartCode(
         break;
     }
 
-EXIT:
     return ret;
 }
 
+static OMX_U32 Make_Stream_StartCodePrefix(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U8              *pInputStream,
+    OMX_U32              streamSize,
+    OMX_U32              nFlags,
+    OMX_U8              *pPrefix,
+    OMX_U32              nSpace)
+{
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMVDEC_HANDLE          *pWmvDec          = (EXYNOS_WMVDEC_HANDLE *)pVideoDec->hCodecHandle;
+    WMV_FORMAT                     wmvFormat        = pWmvDec->hMFCWmvHandle.wmvFormat;
+    OMX_U32                        nLen             = 0;
+
+    pWmvDec->nStartCodePrefixLen = 0;
+
+    /* same decision as Exynos_WmvDec_SrcIn() would take, header data goes to WmvCodecSrcSetup() as it is.
+     * a first chunk too short to show a prefix code is left to SrcIn, which sees the whole frame
+     */
+    if ((pWmvDec->hMFCWmvHandle.bConfiguredMFCSrc == OMX_FALSE) ||
+        ((nFlags & OMX_BUFFERFLAG_EOS) == OMX_BUFFERFLAG_EOS) ||
+        (streamSize < 3) ||
+        (Check_Stream_PrefixCode(pInputStream, streamSize, wmvFormat) == OMX_TRUE))
+        return 0;
+
+    nLen = Put_Stream_StartCode(wmvFormat, NULL);
+    if ((nLen == 0) ||
+        (nSpace < nLen))  /* left to Exynos_WmvDec_SrcIn() to report */
+        return 0;
+
+    Put_Stream_StartCode(wmvFormat, pPrefix);
+    pWmvDec->nStartCodePrefixLen = nLen;
+
+    return nLen;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -776,6 +832,8 @@ OMX_ERRORTYPE WmvCodecReconfigAllBuffers(
         pBufferOps = pWmvDec->hMFCWmvHandle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -817,6 +875,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE WmvCodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMVDEC_HANDLE            *pWmvDec            = (EXYNOS_WMVDEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pWmvDec->hMFCWmvHandle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pWmvDec->hMFCWmvHandle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pWmvDec->hMFCWmvHandle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pWmvDec->hMFCWmvHandle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pWmvDec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE WmvCodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
 {
     OMX_ERRORTYPE                  ret              = OMX_ErrorNone;
@@ -838,15 +930,8 @@ OMX_ERRORTYPE WmvCodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
+        pWmvDec->nStartCodePrefixLen = 0;
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -991,8 +1076,7 @@ OMX_ERRORTYPE WmvCodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1124,8 +1208,7 @@ OMX_ERRORTYPE WmvCodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     pWmvDec->hMFCWmvHandle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        pWmvDec->hMFCWmvHandle.maxDPBNum += EXTRA_DPB_NUM;
+    pWmvDec->hMFCWmvHandle.maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pWmvDec->hMFCWmvHandle.maxDPBNum);
 
     /* get interlace info */
@@ -1194,6 +1277,16 @@ OMX_ERRORTYPE WmvCodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pWmvDec->hMFCWmvHandle.codecOutbufConf.nFrameWidth,
+                                     pWmvDec->hMFCWmvHandle.codecOutbufConf.nFrameHeight,
+                                     pWmvDec->hMFCWmvHandle.codecOutbufConf.nAlignPlaneSize,
+                                     &pWmvDec->hMFCWmvHandle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pWmvDec->hMFCWmvHandle.codecOutbufConf.nFrameWidth) ||
@@ -1438,7 +1531,8 @@ OMX_ERRORTYPE WmvCodecSrcSetup(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
 
     if ((pDecOps->Enable_DTSMode != NULL) &&
@@ -1663,7 +1757,9 @@ OMX_ERRORTYPE WmvCodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2339,7 +2435,6 @@ OMX_ERRORTYPE Exynos_WmvDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     ExynosVideoInstInfo *pVideoInstInfo = &(pWmvDec->hMFCWmvHandle.videoInstInfo);
 
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2366,6 +2461,8 @@ OMX_ERRORTYPE Exynos_WmvDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pWmvDec->hMFCWmvHandle.pInbufOps, pWmvDec->hMFCWmvHandle.pOutbufOps, pWmvDec->hMFCWmvHandle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2376,12 +2473,9 @@ OMX_ERRORTYPE Exynos_WmvDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2461,6 +2555,10 @@ OMX_ERRORTYPE Exynos_WmvDec_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
             }
 
             if (pWmvDec != NULL) {
+                if (pWmvDec->nStartCodeShiftSaved > 0)
+                    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] start code prefix saved memmove of %llu bytes",
+                                                            pExynosComponent, __FUNCTION__, (unsigned long long)pWmvDec->nStartCodeShiftSaved);
+
                 Exynos_OSAL_QueueTerminate(&pWmvDec->bypassBufferInfoQ);
 
                 Exynos_OSAL_SignalTerminate(pWmvDec->hDestinationInStartEvent);
@@ -2512,6 +2610,66 @@ EXIT:
     return ret;
 }
 
+/* the frame in the codec buffer gets its start code, ahead by Make_Stream_StartCodePrefix() or shifted in here */
+static OMX_ERRORTYPE WmvCodecPutStartCode(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    EXYNOS_OMX_DATA             *pSrcInputData,
+    OMX_U32                     *pFrameSize,
+    OMX_BOOL                    *pbStartCode)
+{
+    OMX_ERRORTYPE                  ret              = OMX_ErrorNone;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMVDEC_HANDLE          *pWmvDec          = (EXYNOS_WMVDEC_HANDLE *)pVideoDec->hCodecHandle;
+    OMX_U32                        oneFrameSize     = (*pFrameSize);
+    OMX_BOOL                       bStartCode       = OMX_FALSE;
+
+    if ((pWmvDec->nStartCodePrefixLen > 0) &&
+        ((pSrcInputData->nFlags & OMX_BUFFERFLAG_EOS) == OMX_BUFFERFLAG_EOS)) {
+        /* EOS came with a later chunk, a frame with EOS never gets a start code */
+        Exynos_OSAL_Memmove(pSrcInputData->buffer.addr[0],
+                            (OMX_U8 *)pSrcInputData->buffer.addr[0] + pWmvDec->nStartCodePrefixLen,
+                            oneFrameSize - pWmvDec->nStartCodePrefixLen);
+        oneFrameSize -= pWmvDec->nStartCodePrefixLen;
+        pWmvDec->nStartCodePrefixLen = 0;
+    }
+
+    if (pWmvDec->nStartCodePrefixLen > 0) {
+        /* the whole frame is what the memmove would have shifted */
+        bStartCode = OMX_TRUE;
+        if (oneFrameSize > pWmvDec->nStartCodePrefixLen)
+            pWmvDec->nStartCodeShiftSaved += (oneFrameSize - pWmvDec->nStartCodePrefixLen);
+        pWmvDec->nStartCodePrefixLen = 0;
+    } else {
+        bStartCode = Check_Stream_PrefixCode(pSrcInputData->buffer.addr[0], oneFrameSize, pWmvDec->hMFCWmvHandle.wmvFormat);
+    }
+
+    if ((bStartCode == OMX_FALSE) &&
+        ((pSrcInputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
+        OMX_U32 bufferSizeWithHeader;
+        if (pWmvDec->hMFCWmvHandle.wmvFormat == WMV_FORMAT_WMV3)
+            bufferSizeWithHeader = oneFrameSize + 8;
+        else if (pWmvDec->hMFCWmvHandle.wmvFormat == WMV_FORMAT_VC1)
+            bufferSizeWithHeader = oneFrameSize + 4;
+        else
+            bufferSizeWithHeader = 0;
+
+        if (pSrcInputData->allocSize < bufferSizeWithHeader) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] can not attach startcode due to lack of buffer space", pExynosComponent, __FUNCTION__);
+            ret = (OMX_ERRORTYPE)OMX_ErrorCorruptedFrame;
+            goto EXIT;
+        }
+
+        /* try to generate a start code */
+        bStartCode = Make_Stream_StartCode(pSrcInputData->buffer.addr[0], &oneFrameSize, pWmvDec->hMFCWmvHandle.wmvFormat);
+    }
+
+    (*pFrameSize)  = oneFrameSize;
+    (*pbStartCode) = bStartCode;
+
+EXIT:
+    return ret;
+}
+
 OMX_ERRORTYPE Exynos_WmvDec_SrcIn(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData)
 {
     OMX_ERRORTYPE                  ret               = OMX_ErrorNone;
@@ -2552,26 +2710,9 @@ OMX_ERRORTYPE Exynos_WmvDec_SrcIn(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_D
         }
     }
 
-    bStartCode = Check_Stream_PrefixCode(pSrcInputData->buffer.addr[0], oneFrameSize, pWmvDec->hMFCWmvHandle.wmvFormat);
-    if ((bStartCode == OMX_FALSE) &&
-        ((pSrcInputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
-        OMX_U32 bufferSizeWithHeader;
-        if (pWmvDec->hMFCWmvHandle.wmvFormat == WMV_FORMAT_WMV3)
-            bufferSizeWithHeader = oneFrameSize + 8;
-        else if (pWmvDec->hMFCWmvHandle.wmvFormat == WMV_FORMAT_VC1)
-            bufferSizeWithHeader = oneFrameSize + 4;
-        else
-            bufferSizeWithHeader = 0;
-
-        if (pSrcInputData->allocSize < bufferSizeWithHeader) {
-            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] can not attach startcode due to lack of buffer space", pExynosComponent, __FUNCTION__);
-            ret = (OMX_ERRORTYPE)OMX_ErrorCorruptedFrame;
-            goto EXIT;
-        }
-
-        /* try to generate a start code */
-        bStartCode = Make_Stream_StartCode(pSrcInputData->buffer.addr[0], &oneFrameSize, pWmvDec->hMFCWmvHandle.wmvFormat);
-    }
+    ret = WmvCodecPutStartCode(pExynosComponent, pSrcInputData, &oneFrameSize, &bStartCode);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
 
     if ((bStartCode == OMX_TRUE) ||
         ((pSrcInputData->nFlags & OMX_BUFFERFLAG_EOS) == OMX_BUFFERFLAG_EOS)) {
@@ -2712,17 +2853,8 @@ OMX_ERRORTYPE Exynos_WmvDec_SrcOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
         pSrcOutputData->allocSize  = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -2889,6 +3021,8 @@ OMX_ERRORTYPE Exynos_WmvDec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
             pVideoDec->bReconfigDPB = OMX_TRUE;
             WmvCodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
         }
         ret = OMX_ErrorNone;
         goto EXIT;
@@ -3275,6 +3409,10 @@ OMX_ERRORTYPE Exynos_WmvDec_dstInputBufferProcess(OMX_COMPONENTTYPE *pOMXCompone
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pWmvDec->hMFCWmvHandle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_WmvDec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -3535,9 +3673,12 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &WmvCodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &WmvCodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &WmvCodecCheckResolution;
+    pVideoDec->exynos_codec_checkKeyFrame           = NULL;  /* picture type is left to I-frame decoding of MFC */
+    pVideoDec->exynos_codec_makeInputPrefix         = &Make_Stream_StartCodePrefix;
 
     pVideoDec->exynos_codec_updateExtraInfo = &WmvCodecUpdateExtraInfo;
 
@@ -3579,6 +3720,7 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
 #ifdef USE_ANDROID
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
 #endif
 
     pExynosComponent->currentState = OMX_StateLoaded;
@@ -87,6 +87,10 @@ typedef struct _EXYNOS_WMVDEC_HANDLE
     OMX_HANDLETYPE hDestinationOutStartEvent;
 
     EXYNOS_QUEUE bypassBufferInfoQ;
+
+    /* start code put ahead of the frame while copying it into a codec buffer */
+    OMX_U32 nStartCodePrefixLen;
+    OMX_U64 nStartCodeShiftSaved;   /* bytes not memmoved thanks to it */
 } EXYNOS_WMVDEC_HANDLE;
 
 #ifdef __cplusplus
@@ -303,6 +303,97 @@ OMX_BOOL Check_VP9_StartCode(
     return OMX_TRUE;
 }
 
+static OMX_BOOL Check_VP9_KeyFrame(
+    OMX_U8     *pInputStream,
+    OMX_U32     streamSize)
+{
+    OMX_BOOL ret     = OMX_TRUE;
+    OMX_U8   nHeader = 0;
+    OMX_U32  nProfile, nBit;
+
+    FunctionIn();
+
+    if (streamSize < 1)
+        goto EXIT;
+
+    /* frame_marker(2) profile_low_bit(1) profile_high_bit(1) [reserved_zero(1)] show_existing_frame(1) frame_type(1) */
+    nHeader = pInputStream[0];
+    if ((nHeader >> 6) != 0x02)
+        goto EXIT;
+
+    nProfile = ((nHeader >> 5) & 0x01) | (((nHeader >> 4) & 0x01) << 1);
+    nBit     = (nProfile == 3)? 2:3;  /* position of show_existing_frame */
+
+    if ((nHeader >> nBit) & 0x01) {
+        ret = OMX_FALSE;  /* just shows a decoded frame again */
+        goto EXIT;
+    }
+
+    /* frame_type : 0 is KEY_FRAME */
+    ret = ((nHeader >> (nBit - 1)) & 0x01)? OMX_FALSE:OMX_TRUE;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+static OMX_BOOL Check_VP9_NonRefFrame(
+    OMX_COMPONENTTYPE *pOMXComponent,
+    OMX_U8            *pInputStream,
+    OMX_U32            streamSize)
+{
+    OMX_BOOL ret      = OMX_FALSE;
+    OMX_U32  nProfile = 0;
+    OMX_U32  nBitPos  = 0;
+    OMX_U32  nShowFrame, nErrorRes, nRefresh;
+    int i;
+
+#define VP9_READ_BIT(pos) ((pInputStream[(pos) >> 3] >> (7 - ((pos) & 0x07))) & 0x01)
+
+    FunctionIn();
+
+    if ((streamSize < 3) ||
+        ((pInputStream[0] >> 6) != 0x02))  /* frame_marker */
+        goto EXIT;
+
+    nProfile = VP9_READ_BIT(2) | (VP9_READ_BIT(3) << 1);
+    nBitPos  = (nProfile == 3)? 5:4;
+
+    /* show_existing_frame, KEY_FRAME */
+    if ((VP9_READ_BIT(nBitPos) == 1) ||
+        (VP9_READ_BIT(nBitPos + 1) == 0))
+        goto EXIT;
+
+    nShowFrame = VP9_READ_BIT(nBitPos + 2);
+    nErrorRes  = VP9_READ_BIT(nBitPos + 3);
+    nBitPos   += 4;
+
+    /* hidden frames(ARF) exist only to be referred, intra_only is kept as well */
+    if (nShowFrame == 0)
+        goto EXIT;
+
+    if (nErrorRes == 0)
+        nBitPos += 2;  /* reset_frame_context */
+
+    if (((nBitPos + 8) >> 3) >= streamSize)
+        goto EXIT;
+
+    /* refresh_frame_flags : no reference slot is updated by this frame */
+    nRefresh = 0;
+    for (i = 0; i < 8; i++)
+        nRefresh = (nRefresh << 1) | VP9_READ_BIT(nBitPos + i);
+
+    ret = (nRefresh == 0)? OMX_TRUE:OMX_FALSE;
+
+#undef VP9_READ_BIT
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL CheckFormatHWSupport(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_COLOR_FORMATTYPE         eColorFormat)
@@ -685,6 +776,8 @@ OMX_ERRORTYPE Vp9CodecReconfigAllBuffers(
         pBufferOps = pVp9Dec->hMFCVp9Handle.pOutbufOps;
 
         if (pExynosPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+            pVideoDec->bReuseDPB = OMX_FALSE;
+
             /**********************************/
             /* Codec Buffer Free & Unregister */
             /**********************************/
@@ -726,6 +819,40 @@ EXIT:
     return ret;
 }
 
+OMX_ERRORTYPE Vp9CodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_VP9DEC_HANDLE            *pVp9Dec            = (EXYNOS_VP9DEC_HANDLE *)pVideoDec->hCodecHandle;
+    void                            *hMFCHandle         = pVp9Dec->hMFCVp9Handle.hMFCHandle;
+    ExynosVideoDecBufferOps         *pOutbufOps         = pVp9Dec->hMFCVp9Handle.pOutbufOps;
+
+    FunctionIn();
+
+    if (bSetup == OMX_FALSE) {
+        pVp9Dec->hMFCVp9Handle.bConfiguredMFCDst = OMX_FALSE;
+        goto EXIT;
+    }
+
+    pOutbufOps->Clear_RegisteredBuffer(hMFCHandle);
+    pOutbufOps->Cleanup_Buffer(hMFCHandle);
+
+    if (pOutbufOps->Setup(hMFCHandle, MAX_OUTPUTBUFFER_NUM_DYNAMIC) != VIDEO_ERROR_NONE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to setup output buffer", pExynosComponent, __FUNCTION__);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pVp9Dec->hMFCVp9Handle.bConfiguredMFCDst = OMX_TRUE;
+    Exynos_OSAL_SignalSet(pVp9Dec->hDestinationOutStartEvent);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE VP9CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
@@ -747,15 +874,7 @@ OMX_ERRORTYPE VP9CodecEnQueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32
     }
 
     if (nPortIndex == INPUT_PORT_INDEX) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoDec->pMFCDecInputBuffer[i]->fd[0], pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1000,8 +1119,7 @@ OMX_ERRORTYPE Vp9CodecCheckResolution(OMX_COMPONENTTYPE *pOMXComponent)
 
     /* get dpb count */
     maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
-        maxDPBNum += EXTRA_DPB_NUM;
+    maxDPBNum += Exynos_Get_ExtraDPBNum(pOMXComponent);
 
     if (pExynosComponent->bUseImgCrop == OMX_FALSE) {
         pCropRectangle->nTop     = codecOutbufConf.cropRect.nTop;
@@ -1134,7 +1252,8 @@ OMX_ERRORTYPE Vp9CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     /* get dpb count */
     pVp9Dec->hMFCVp9Handle.maxDPBNum = pDecOps->Get_ActualBufferCount(hMFCHandle);
 #if 0  /* no needs EXTRA_DPB, it was confirmed codec team */
-    if (pVideoDec->bThumbnailMode == OMX_FALSE)
+    if ((pVideoDec->bThumbnailMode == OMX_FALSE) &&
+        (pVideoDec->bKeyFrameOnlyMode == OMX_FALSE))
         pVp9Dec->hMFCVp9Handle.maxDPBNum += EXTRA_DPB_NUM;
 #endif
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] maxDPBNum: %d", pExynosComponent, __FUNCTION__, pVp9Dec->hMFCVp9Handle.maxDPBNum);
@@ -1207,6 +1326,16 @@ OMX_ERRORTYPE Vp9CodecUpdateResolution(OMX_COMPONENTTYPE *pOMXComponent)
     }
 
     if (pOutputPort->bufferProcessType & (BUFFER_COPY | BUFFER_COPY_FORCE)) {
+        if (Exynos_Keep_CodecBuffers(pOMXComponent, bFormatChanged,
+                                     pVp9Dec->hMFCVp9Handle.codecOutbufConf.nFrameWidth,
+                                     pVp9Dec->hMFCVp9Handle.codecOutbufConf.nFrameHeight,
+                                     pVp9Dec->hMFCVp9Handle.codecOutbufConf.nAlignPlaneSize,
+                                     &pVp9Dec->hMFCVp9Handle.maxDPBNum) == OMX_TRUE) {
+            /* new resolution fits in current DPBs : port is kept, only crop info is changed */
+            ret = OMX_ErrorNone;
+            goto EXIT;
+        }
+
         if ((pVideoDec->bReconfigDPB) ||
             (bFormatChanged) ||
             (pInputPortDefinition->format.video.nFrameWidth != pVp9Dec->hMFCVp9Handle.codecOutbufConf.nFrameWidth) ||
@@ -1507,7 +1636,8 @@ OMX_ERRORTYPE VP9CodecSrcSetup(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA
         goto EXIT;
     }
 
-    if (pVideoDec->bThumbnailMode == OMX_TRUE)
+    if ((pVideoDec->bThumbnailMode == OMX_TRUE) ||
+        (pVideoDec->bKeyFrameOnlyMode == OMX_TRUE))
         pDecOps->Set_IFrameDecoding(hMFCHandle);
 
     if ((pDecOps->Enable_DTSMode != NULL) &&
@@ -1715,7 +1845,9 @@ OMX_ERRORTYPE VP9CodecDstSetup(OMX_COMPONENTTYPE *pOMXComponent)
             goto EXIT;
         }
 
-        if (pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) {
+        /* tunnel buffers are ION memory of this component, they are given by the fd at every DstIn */
+        if ((pExynosOutputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+            !CHECK_PORT_BUFFER_SUPPLIER(pExynosOutputPort)) {
             /*************/
             /*    TBD    */
             /*************/
@@ -2331,7 +2463,6 @@ OMX_ERRORTYPE Exynos_VP9Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     ExynosVideoInstInfo *pVideoInstInfo = &(pVp9Dec->hMFCVp9Handle.videoInstInfo);
 
     CSC_METHOD csc_method = CSC_METHOD_SW;
-    int i;
 
     FunctionIn();
 
@@ -2358,6 +2489,8 @@ OMX_ERRORTYPE Exynos_VP9Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pVp9Dec->hMFCVp9Handle.pInbufOps, pVp9Dec->hMFCVp9Handle.pOutbufOps, pVp9Dec->hMFCVp9Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pExynosInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
         unsigned int nAllocLen[MAX_BUFFER_PLANE] = {0, 0, 0};
@@ -2368,12 +2501,9 @@ OMX_ERRORTYPE Exynos_VP9Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
         Exynos_OSAL_SemaphoreCreate(&pExynosInputPort->codecSemID);
         Exynos_OSAL_QueueCreate(&pExynosInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Setup_CodecInputBuffers(pOMXComponent, nAllocLen);
         if (ret != OMX_ErrorNone)
             goto EXIT;
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
-            Exynos_CodecBufferEnQueue(pExynosComponent, INPUT_PORT_INDEX, pVideoDec->pMFCDecInputBuffer[i]);
     } else if (pExynosInputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2577,24 +2707,14 @@ OMX_ERRORTYPE Exynos_VP9Dec_SrcIn(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_D
                     goto EXIT;
                 }
 
-                for (i = 0; i < MAX_BUFFER_REF; i++) {
-                    if (pExynosComponent->HDR10plusList[i].bOccupied == OMX_FALSE) {
-                        int nParamSize = *(OMX_U32 *)pHDR10plusConfig;
-
-                        pExynosComponent->HDR10plusList[i].pHDR10PlusInfo = Exynos_OSAL_Malloc(nParamSize);
-                        if (pExynosComponent->HDR10plusList[i].pHDR10PlusInfo == NULL) {
-                            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to malloc", pExynosComponent, __FUNCTION__);
-                            ret = OMX_ErrorInsufficientResources;
-                            goto EXIT;
-                        }
-
-                        pExynosComponent->HDR10plusList[i].bOccupied = OMX_TRUE;
-                        pExynosComponent->HDR10plusList[i].nTag      = pVp9Dec->hMFCVp9Handle.indexTimestamp;
-                        Exynos_OSAL_Memcpy(pExynosComponent->HDR10plusList[i].pHDR10PlusInfo, pHDR10plusConfig, nParamSize);
-                        Exynos_OSAL_Free(pHDR10plusConfig);
-
-                        break;
-                    }
+                ret = Exynos_OMX_HDR10PlusRing_Put(pExynosComponent,
+                                                   pVp9Dec->hMFCVp9Handle.indexTimestamp,
+                                                   pSrcInputData->timeStamp,
+                                                   pHDR10plusConfig);
+                if (ret != OMX_ErrorNone) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to keep HDR10+ config", pExynosComponent, __FUNCTION__);
+                    Exynos_OSAL_Free(pHDR10plusConfig);
+                    goto EXIT;
                 }
             }
         }
@@ -2719,17 +2839,8 @@ OMX_ERRORTYPE Exynos_VP9Dec_SrcOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
         pSrcOutputData->allocSize  = pVideoBuffer->planes[0].allocSize;
 
         if (pExynosInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0]) {
-                    pVideoDec->pMFCDecInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoDec->pMFCDecInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecDecode;
                 goto EXIT;
@@ -2899,6 +3010,8 @@ OMX_ERRORTYPE Exynos_VP9Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
             pVideoDec->bReconfigDPB = OMX_TRUE;
             Vp9CodecUpdateResolution(pOMXComponent);
             pVideoDec->csc_set_format = OMX_FALSE;
+
+            Exynos_Detach_KeptCodecBuffers(pOMXComponent);
         }
         ret = OMX_ErrorNone;
         goto EXIT;
@@ -3024,26 +3137,24 @@ OMX_ERRORTYPE Exynos_VP9Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
     } else {
         /* Find HDR10+ info for framework */
         if (pVp9Dec->hMFCVp9Handle.videoInstInfo.supportInfo.dec.bHDRDynamicInfoSupport == VIDEO_TRUE) {
-            for (i = 0; i < MAX_BUFFER_REF; i++) {
-                if ((pExynosComponent->HDR10plusList[i].bOccupied == OMX_TRUE) &&
-                    (pExynosComponent->HDR10plusList[i].nTag == indexTimestamp)) {
-                    if (Exynos_OSAL_Queue(&pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].HdrDynamicInfoQ, (void *)pExynosComponent->HDR10plusList[i].pHDR10PlusInfo) != 0) {
-                        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] Failed to Queue HDR10+ info", pExynosComponent, __FUNCTION__);
-                        Exynos_OSAL_Free(pExynosComponent->HDR10plusList[i].pHDR10PlusInfo);
-                        pExynosComponent->HDR10plusList[i].pHDR10PlusInfo = NULL;
-                        pExynosComponent->HDR10plusList[i].bOccupied      = OMX_FALSE;
-
-                        break;
-                    }
-
-                    /* This code is for supporting HDR10Plus vendor path.
-                     * This will be removed if HWC supports official interface for HDR10Plus.
-                     */
-                    if ((pOutputPort->bufferProcessType == BUFFER_SHARE) &&
-                        (pVideoBuffer->planes[2].addr != NULL)) {
-                        VP9CodecUpdateHDR10PlusInfo(pOMXComponent, pVideoBuffer->planes[2].addr, (void *)pExynosComponent->HDR10plusList[i].pHDR10PlusInfo);
-                    }
+            /* timeStamp[] may already belong to a later frame that reused the tag */
+            OMX_PTR pHDR10PlusInfo = Exynos_OMX_HDR10PlusRing_Get(pExynosComponent,
+                                                                  indexTimestamp,
+                                                                  (OMX_TICKS)pVideoBuffer->timestamp);
+
+            if (pHDR10PlusInfo != NULL) {
+                /* This code is for supporting HDR10Plus vendor path.
+                 * This will be removed if HWC supports official interface for HDR10Plus.
+                 */
+                if ((pOutputPort->bufferProcessType == BUFFER_SHARE) &&
+                    (pVideoBuffer->planes[2].addr != NULL)) {
+                    VP9CodecUpdateHDR10PlusInfo(pOMXComponent, pVideoBuffer->planes[2].addr, pHDR10PlusInfo);
+                }
 
+                if (Exynos_OSAL_Queue(&pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].HdrDynamicInfoQ, pHDR10PlusInfo) != 0) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] Failed to Queue HDR10+ info", pExynosComponent, __FUNCTION__);
+                    Exynos_OSAL_Free(pHDR10PlusInfo);
+                } else {
                     Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] send event(OMX_EventConfigUpdate)",
                                                     pExynosComponent, __FUNCTION__);
                     /** Send ConfigUpdate Event call back **/
@@ -3054,8 +3165,6 @@ OMX_ERRORTYPE Exynos_VP9Dec_DstOut(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_
                          OMX_DirOutput,         /* This is the port index */
                          OMX_IndexConfigVideoHdr10PlusInfo,
                          NULL);
-
-                    break;
                 }
             }
         }
@@ -3311,6 +3420,10 @@ OMX_ERRORTYPE Exynos_VP9Dec_dstInputBufferProcess(OMX_COMPONENTTYPE *pOMXCompone
         }
     }
 
+    ret = Exynos_Setup_KeptCodecBuffers(pOMXComponent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
     if (pVp9Dec->hMFCVp9Handle.bConfiguredMFCDst == OMX_TRUE) {
         ret = Exynos_VP9Dec_DstIn(pOMXComponent, pDstInputData);
         if (ret != OMX_ErrorNone) {
@@ -3573,9 +3686,12 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
     pVideoDec->exynos_codec_getCodecOutputPrivateData = &GetCodecOutputPrivateData;
     pVideoDec->exynos_codec_reconfigAllBuffers        = &Vp9CodecReconfigAllBuffers;
+    pVideoDec->exynos_codec_reuseAllBuffers           = &Vp9CodecReuseAllBuffers;
 
     pVideoDec->exynos_codec_checkFormatSupport      = &CheckFormatHWSupport;
     pVideoDec->exynos_codec_checkResolutionChange   = &Vp9CodecCheckResolution;
+    pVideoDec->exynos_codec_checkKeyFrame           = &Check_VP9_KeyFrame;
+    pVideoDec->exynos_codec_checkNonRefFrame        = &Check_VP9_NonRefFrame;
 
     pVideoDec->exynos_codec_updateExtraInfo = &VP9CodecUpdateExtraInfo;
 
@@ -3617,6 +3733,8 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
 
 #ifdef USE_ANDROID
     Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-compressed-color-format", (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-keyframe-only", (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-dec-drop-control", (OMX_INDEXTYPE)OMX_IndexParamVideoDropControl);
 #endif
 
     pExynosComponent->currentState = OMX_StateLoaded;
@@ -38,6 +38,9 @@
 #include "Exynos_OSAL_SharedMemory.h"
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_Bench.h"
+#include "Exynos_OSAL_WorkerPool.h"
+#include "Exynos_OSAL_MemPressure.h"
 #include "ExynosVideoApi.h"
 #include "csc.h"
 
@@ -48,6 +51,10 @@
 #include "exynos_format.h"
 #endif
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 #undef  EXYNOS_LOG_TAG
 #define EXYNOS_LOG_TAG    "EXYNOS_VIDEO_ENC"
 //#define EXYNOS_LOG_OFF
@@ -250,6 +257,7 @@ void Exynos_Free_CodecBuffers(
     if (nPortIndex == INPUT_PORT_INDEX) {
         ppCodecBuffer = &(pVideoEnc->pMFCEncInputBuffer[0]);
         nBufferCnt = MFC_INPUT_BUFFER_NUM_MAX;
+        pVideoEnc->nMFCEncInputBufferNum = 0;
     } else {
         ppCodecBuffer = &(pVideoEnc->pMFCEncOutputBuffer[0]);
         nBufferCnt = MFC_OUTPUT_BUFFER_NUM_MAX;
@@ -276,6 +284,47 @@ void Exynos_Free_CodecBuffers(
     FunctionOut();
 }
 
+/* the worker pool parks a buffer process step on these instead of sleeping in a MFC dequeue */
+void Exynos_Set_CodecReadyFd(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    ExynosVideoEncBufferOps     *pInbufOps,
+    ExynosVideoEncBufferOps     *pOutbufOps,
+    OMX_HANDLETYPE               hMFCHandle)
+{
+    int hFd = -1;
+
+    FunctionIn();
+
+    if (pExynosComponent == NULL)
+        goto EXIT;
+
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd  = -1;
+    pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd = -1;
+
+    /* no handle: the codec is closed */
+    if (hMFCHandle == NULL)
+        goto EXIT;
+
+    if ((pInbufOps != NULL) &&
+        (pInbufOps->Get_ReadyFd != NULL) &&
+        (pInbufOps->Get_ReadyFd(hMFCHandle, &hFd) == VIDEO_ERROR_NONE))
+        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd = hFd;
+
+    if ((pOutbufOps != NULL) &&
+        (pOutbufOps->Get_ReadyFd != NULL) &&
+        (pOutbufOps->Get_ReadyFd(hMFCHandle, &hFd) == VIDEO_ERROR_NONE))
+        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd = hFd;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] ready fd: input(%d) output(%d)", pExynosComponent, __FUNCTION__,
+                                        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd,
+                                        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd);
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
 OMX_ERRORTYPE Exynos_Allocate_CodecBuffers(
     OMX_COMPONENTTYPE   *pOMXComponent,
     OMX_U32              nPortIndex,
@@ -339,6 +388,9 @@ OMX_ERRORTYPE Exynos_Allocate_CodecBuffers(
         ppCodecBuffer[i]->dataSize = 0;
     }
 
+    if (nPortIndex == INPUT_PORT_INDEX)
+        pVideoEnc->nMFCEncInputBufferNum = nBufferCnt;
+
     return OMX_ErrorNone;
 
 EXIT:
@@ -349,6 +401,68 @@ EXIT:
     return ret;
 }
 
+static OMX_BOOL Exynos_IsMemoryTrimmed(EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc)
+{
+    return ((pVideoEnc->bTrimMemory == OMX_TRUE) ||
+            (__atomic_load_n(&pVideoEnc->bMemoryPressure, __ATOMIC_ACQUIRE) == OMX_TRUE))? OMX_TRUE:OMX_FALSE;
+}
+
+/* taken when the input codec buffers are allocated, at the first input or a resolution change */
+static OMX_U32 Exynos_Get_CodecInputBufferNum(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    return (Exynos_IsMemoryTrimmed(pVideoEnc) == OMX_TRUE)? MFC_INPUT_BUFFER_NUM_MIN:MFC_INPUT_BUFFER_NUM_MAX;
+}
+
+void Exynos_EnQueue_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    int i;
+
+    FunctionIn();
+
+    Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
+
+    for (i = 0; i < (int)pVideoEnc->nMFCEncInputBufferNum; i++) {
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x), size(%d)",
+                                            pExynosComponent, __FUNCTION__,
+                                            i, pVideoEnc->pMFCEncInputBuffer[i]->fd[0], pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0],
+                                            pVideoEnc->pMFCEncInputBuffer[i]->bufferSize[0]);
+
+        Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
+    }
+
+    FunctionOut();
+
+    return;
+}
+
+/* the input codec buffer MFC gave back, emptied for the next CSC */
+CODEC_ENC_BUFFER *Exynos_Find_CodecInputBuffer(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_PTR              pVirAddr)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    CODEC_ENC_BUFFER                *pCodecBuffer       = NULL;
+
+    int i;
+
+    for (i = 0; i < (int)pVideoEnc->nMFCEncInputBufferNum; i++) {
+        if (pVirAddr == pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]) {
+            pCodecBuffer = pVideoEnc->pMFCEncInputBuffer[i];
+            pCodecBuffer->dataSize = 0;
+            break;
+        }
+    }
+
+    return pCodecBuffer;
+}
+
 OMX_BOOL Exynos_Check_BufferProcess_State(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex)
 {
     OMX_BOOL ret = OMX_FALSE;
@@ -465,39 +579,886 @@ EXIT:
 void Exynos_Wait_ProcessPause(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex)
 {
     EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc      = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
-    EXYNOS_OMX_BASEPORT             *exynosOMXPort  = NULL;
+    EXYNOS_OMX_BASEPORT             *exynosOMXPort  = &pExynosComponent->pExynosPort[nPortIndex];
 
     FunctionIn();
 
-    exynosOMXPort = &pExynosComponent->pExynosPort[nPortIndex];
-
-    if (((pExynosComponent->currentState == OMX_StatePause) ||
-        (pExynosComponent->currentState == OMX_StateIdle) ||
-        (pExynosComponent->transientState == EXYNOS_OMX_TransStateLoadedToIdle) ||
-        (pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle)) &&
-        (pExynosComponent->transientState != EXYNOS_OMX_TransStateIdleToLoaded) &&
-        (!CHECK_PORT_BEING_FLUSHED(exynosOMXPort))) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> pause : state(0x%x), transient state(0x%x)",
-                                        pExynosComponent, __FUNCTION__,
-                                        (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
-                                        pExynosComponent->currentState, pExynosComponent->transientState);
-        Exynos_OSAL_SignalWait(pExynosComponent->pExynosPort[nPortIndex].pauseEvent, DEF_MAX_WAIT_TIME);
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> resume : state(0x%x), transient state(0x%x)",
+    /* every writer of the state below calls Exynos_OMX_NotifyStateChange() after updating it */
+    Exynos_OSAL_ConditionLock(pExynosComponent->hStateCondition);
+    while (((pExynosComponent->currentState == OMX_StatePause) ||
+            (pExynosComponent->currentState == OMX_StateIdle) ||
+            (pExynosComponent->transientState == EXYNOS_OMX_TransStateLoadedToIdle) ||
+            (pExynosComponent->transientState == EXYNOS_OMX_TransStateExecutingToIdle)) &&
+           (pExynosComponent->transientState != EXYNOS_OMX_TransStateIdleToLoaded) &&
+           (!CHECK_PORT_BEING_FLUSHED(exynosOMXPort)) &&
+           (pVideoEnc->bExitBufferProcessThread == OMX_FALSE)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] %s port -> pause : state(0x%x), transient state(0x%x)",
                                         pExynosComponent, __FUNCTION__,
                                         (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
                                         pExynosComponent->currentState, pExynosComponent->transientState);
-        if (pVideoEnc->bExitBufferProcessThread)
+        if (Exynos_OSAL_WorkerCurrent() != NULL) {
+            /* a pool step must not sleep here, the state change kicks it again */
+            Exynos_OSAL_WorkerPark();
+            break;
+        }
+        Exynos_OSAL_ConditionWait(pExynosComponent->hStateCondition);
+    }
+    Exynos_OSAL_ConditionUnlock(pExynosComponent->hStateCondition);
+
+    FunctionOut();
+
+    return;
+}
+
+/* sum of luma and sum of absolute horizontal/vertical gradients over a 16 pixel wide block */
+static void Exynos_AdaptiveRoi_BlockStat(
+    OMX_U8  *pLuma,
+    OMX_U32  nStride,
+    OMX_U32  nRows,
+    OMX_U32 *pSum,
+    OMX_U32 *pActivity)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    static const OMX_U8 hMaskTable[ADAPTIVE_ROI_MB_SIZE] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+    uint8x16_t  hMask    = vld1q_u8(hMaskTable);  /* last lane has no right neighbour */
+    uint8x16_t  prevRow  = vld1q_u8(pLuma);
+    uint16x8_t  sum      = vdupq_n_u16(0);
+    uint16x8_t  activity = vdupq_n_u16(0);
+    uint64x2_t  total;
+    OMX_U32     y;
+
+    for (y = 0; y < nRows; y++) {
+        uint8x16_t curRow = vld1q_u8(pLuma + (y * nStride));
+
+        sum      = vpadalq_u8(sum, curRow);
+        activity = vpadalq_u8(activity, vandq_u8(vabdq_u8(curRow, vextq_u8(curRow, curRow, 1)), hMask));
+        activity = vpadalq_u8(activity, vabdq_u8(curRow, prevRow));  /* zero at the first row */
+        prevRow  = curRow;
+    }
+
+    total = vpaddlq_u32(vpaddlq_u16(sum));
+    *pSum = (OMX_U32)(vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1));
+
+    total = vpaddlq_u32(vpaddlq_u16(activity));
+    *pActivity = (OMX_U32)(vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1));
+#else
+    OMX_U8  *pRow     = NULL;
+    OMX_U32  sum      = 0;
+    OMX_U32  activity = 0;
+    OMX_U32  x, y;
+
+    for (y = 0; y < nRows; y++) {
+        pRow = pLuma + (y * nStride);
+
+        for (x = 0; x < ADAPTIVE_ROI_MB_SIZE; x++) {
+            sum += pRow[x];
+
+            if (x < (ADAPTIVE_ROI_MB_SIZE - 1))
+                activity += (pRow[x] > pRow[x + 1])? (pRow[x] - pRow[x + 1]):(pRow[x + 1] - pRow[x]);
+
+            if (y > 0)
+                activity += (pRow[x] > pRow[x - nStride])? (pRow[x] - pRow[x - nStride]):(pRow[x - nStride] - pRow[x]);
+        }
+    }
+
+    *pSum      = sum;
+    *pActivity = activity;
+#endif
+}
+
+/*
+ * builds a per-MB QP offset map from the luma plane of the converted frame as a
+ * RoiInfo dynamic config, so it is applied right before this frame is encoded.
+ * flat MBs get a lower QP (banding is visible there), busy MBs a higher one (masking),
+ * and MBs whose mean changed since the previous frame are treated as moving.
+ * the average activity of the previous frame is used as a reference to keep it single pass.
+ */
+static void Exynos_AdaptiveRoi_Analyze(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U8                   *pLuma,
+    OMX_U32                   nStride,
+    OMX_U32                   nWidth,
+    OMX_U32                   nHeight)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc  = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VIDEO_CONFIG_ROIINFO  roiInfo;
+    OMX_PTR                          pDynamicConfigCMD = NULL;
+
+    OMX_U32 nMBWidth        = (nWidth + ADAPTIVE_ROI_MB_SIZE - 1) / ADAPTIVE_ROI_MB_SIZE;
+    OMX_U32 nMBHeight       = (nHeight + ADAPTIVE_ROI_MB_SIZE - 1) / ADAPTIVE_ROI_MB_SIZE;
+    OMX_U32 nMBNum          = nMBWidth * nMBHeight;
+    OMX_U32 nAvgActivity    = pVideoEnc->nAdaptiveRoiAvgActivity;
+    OMX_U64 nTotalActivity  = 0;
+    OMX_U32 nRows, nSum, nActivity, nMean;
+    OMX_S32 nOffset;
+    OMX_U32 i, j, nMBIndex;
+
+    FunctionIn();
+
+    if ((pLuma == NULL) ||
+        (nMBNum == 0) ||
+        (nStride < (nMBWidth * ADAPTIVE_ROI_MB_SIZE)))
+        goto EXIT;
+
+    if (pVideoEnc->nAdaptiveRoiMBNum != nMBNum) {
+        /* first frame or resolution changed */
+        if (pVideoEnc->pAdaptiveRoiMap != NULL) {
+            Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMap);
+            pVideoEnc->pAdaptiveRoiMap = NULL;
+        }
+
+        if (pVideoEnc->pAdaptiveRoiMean != NULL) {
+            Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMean);
+            pVideoEnc->pAdaptiveRoiMean = NULL;
+        }
+
+        pVideoEnc->nAdaptiveRoiMBNum        = 0;
+        pVideoEnc->nAdaptiveRoiAvgActivity  = 0;
+        pVideoEnc->bAdaptiveRoiMeanValid    = OMX_FALSE;
+        nAvgActivity                        = 0;
+
+        pVideoEnc->pAdaptiveRoiMap  = (OMX_S8 *)Exynos_OSAL_Malloc(nMBNum);
+        pVideoEnc->pAdaptiveRoiMean = (OMX_U8 *)Exynos_OSAL_Malloc(nMBNum);
+        if ((pVideoEnc->pAdaptiveRoiMap == NULL) ||
+            (pVideoEnc->pAdaptiveRoiMean == NULL)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Malloc for ROI map(%d MBs)", pExynosComponent, __FUNCTION__, nMBNum);
+            goto EXIT;
+        }
+
+        pVideoEnc->nAdaptiveRoiMBNum = nMBNum;
+    }
+
+    for (j = 0; j < nMBHeight; j++) {
+        nRows = nHeight - (j * ADAPTIVE_ROI_MB_SIZE);
+        if (nRows > ADAPTIVE_ROI_MB_SIZE)
+            nRows = ADAPTIVE_ROI_MB_SIZE;
+
+        for (i = 0; i < nMBWidth; i++) {
+            nMBIndex = (j * nMBWidth) + i;
+
+            Exynos_AdaptiveRoi_BlockStat(pLuma + (j * ADAPTIVE_ROI_MB_SIZE * nStride) + (i * ADAPTIVE_ROI_MB_SIZE),
+                                         nStride, nRows, &nSum, &nActivity);
+
+            /* normalize a partial MB at the bottom edge */
+            nMean           = nSum / (nRows * ADAPTIVE_ROI_MB_SIZE);
+            nActivity       = (nActivity * ADAPTIVE_ROI_MB_SIZE) / nRows;
+            nTotalActivity += nActivity;
+
+            nOffset = 0;
+            if (nAvgActivity > 0) {
+                if ((nActivity * 4) < nAvgActivity)
+                    nOffset = -2;
+                else if ((nActivity * 2) < nAvgActivity)
+                    nOffset = -1;
+                else if (nActivity > (nAvgActivity * 4))
+                    nOffset = 2;
+                else if (nActivity > (nAvgActivity * 2))
+                    nOffset = 1;
+            }
+
+            if ((pVideoEnc->bAdaptiveRoiMeanValid == OMX_TRUE) &&
+                (abs((int)nMean - (int)pVideoEnc->pAdaptiveRoiMean[nMBIndex]) > ADAPTIVE_ROI_MOTION_THRESHOLD))
+                nOffset -= 1;
+
+            if (nOffset > ADAPTIVE_ROI_QP_OFFSET_MAX)
+                nOffset = ADAPTIVE_ROI_QP_OFFSET_MAX;
+            else if (nOffset < -ADAPTIVE_ROI_QP_OFFSET_MAX)
+                nOffset = -ADAPTIVE_ROI_QP_OFFSET_MAX;
+
+            pVideoEnc->pAdaptiveRoiMap[nMBIndex]  = (OMX_S8)nOffset;
+            pVideoEnc->pAdaptiveRoiMean[nMBIndex] = (OMX_U8)nMean;
+        }
+    }
+
+    pVideoEnc->nAdaptiveRoiAvgActivity  = (OMX_U32)(nTotalActivity / nMBNum);
+    pVideoEnc->bAdaptiveRoiMeanValid    = OMX_TRUE;
+
+    if (nAvgActivity == 0) {
+        /* no reference yet, leave the first frame to the rate control */
+        goto EXIT;
+    }
+
+    INIT_SET_SIZE_VERSION(&roiInfo, EXYNOS_OMX_VIDEO_CONFIG_ROIINFO);
+    roiInfo.nPortIndex      = INPUT_PORT_INDEX;
+    roiInfo.nUpperQpOffset  = ADAPTIVE_ROI_QP_OFFSET_MAX;
+    roiInfo.nLowerQpOffset  = -ADAPTIVE_ROI_QP_OFFSET_MAX;
+    roiInfo.bUseRoiInfo     = OMX_TRUE;
+    roiInfo.nRoiMBInfoSize  = (OMX_S32)nMBNum;
+    roiInfo.pRoiMBInfo      = (OMX_PTR)pVideoEnc->pAdaptiveRoiMap;
+
+    /* queued when the frame is sent to the codec */
+    pDynamicConfigCMD = Exynos_OMX_MakeDynamicConfig((OMX_INDEXTYPE)OMX_IndexConfigVideoRoiInfo, (OMX_PTR)&roiInfo);
+    if (pDynamicConfigCMD == NULL)
+        goto EXIT;
+
+    if (pVideoEnc->pAdaptiveRoiCMD != NULL)
+        Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiCMD);
+    pVideoEnc->pAdaptiveRoiCMD = pDynamicConfigCMD;
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+/* samples the converted luma sparsely and measures spatial/temporal complexity for the lookahead */
+static void Exynos_Lookahead_Analyze(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_U8                   *pLuma,
+    OMX_U32                   nStride,
+    OMX_U32                   nWidth,
+    OMX_U32                   nHeight)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc  = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LOOKAHEAD     *pLookahead = &pVideoEnc->lookahead;
+
+    OMX_U32 nSampleWidth    = nWidth / VENC_LOOKAHEAD_SAMPLE_STEP;
+    OMX_U32 nSampleHeight   = nHeight / VENC_LOOKAHEAD_SAMPLE_STEP;
+    OMX_U32 nSampleNum      = nSampleWidth * nSampleHeight;
+    OMX_U32 nSpatial        = 0;
+    OMX_U32 nTemporal       = 0;
+    OMX_U8 *pRow            = NULL;
+    OMX_U8 *pSample         = NULL;
+    OMX_U8  nValue;
+    OMX_U32 x, y;
+
+    FunctionIn();
+
+    pLookahead->bCurAnalyzed = OMX_FALSE;
+    pLookahead->bCurSceneCut = OMX_FALSE;
+
+    if ((pLuma == NULL) ||
+        (nSampleWidth < 2) ||
+        (nSampleHeight < 2))
+        goto EXIT;
+
+    if (pLookahead->nSampleNum != nSampleNum) {
+        if (pLookahead->pPrevSample != NULL) {
+            Exynos_OSAL_Free(pLookahead->pPrevSample);
+            pLookahead->pPrevSample = NULL;
+        }
+
+        pLookahead->nSampleNum          = 0;
+        pLookahead->bPrevSampleValid    = OMX_FALSE;
+
+        pLookahead->pPrevSample = (OMX_U8 *)Exynos_OSAL_Malloc(nSampleNum);
+        if (pLookahead->pPrevSample == NULL) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Malloc for samples(%d)", pExynosComponent, __FUNCTION__, nSampleNum);
             goto EXIT;
+        }
+
+        pLookahead->nSampleNum = nSampleNum;
+    }
+
+    for (y = 0; y < nSampleHeight; y++) {
+        pRow    = pLuma + (y * VENC_LOOKAHEAD_SAMPLE_STEP * nStride);
+        pSample = pLookahead->pPrevSample + (y * nSampleWidth);
+
+        for (x = 0; x < nSampleWidth; x++) {
+            nValue = pRow[x * VENC_LOOKAHEAD_SAMPLE_STEP];
+
+            if (x > 0)
+                nSpatial += abs((int)nValue - (int)pRow[(x - 1) * VENC_LOOKAHEAD_SAMPLE_STEP]);
+
+            if (y > 0)
+                nSpatial += abs((int)nValue - (int)pRow[(x * VENC_LOOKAHEAD_SAMPLE_STEP) - (VENC_LOOKAHEAD_SAMPLE_STEP * nStride)]);
+
+            if (pLookahead->bPrevSampleValid == OMX_TRUE)
+                nTemporal += abs((int)nValue - (int)pSample[x]);
+
+            pSample[x] = nValue;
+        }
+    }
+
+    nSpatial  /= nSampleNum;
+    nTemporal /= nSampleNum;
+
+    if ((pLookahead->bPrevSampleValid == OMX_TRUE) &&
+        (nTemporal > VENC_LOOKAHEAD_SCENECUT_THRESHOLD) &&
+        (nTemporal > (pLookahead->nAvgTemporal * 3)))
+        pLookahead->bCurSceneCut = OMX_TRUE;
+
+    /* restart the average at a cut, or the motion of the new scene is taken as cuts too */
+    if (pLookahead->bCurSceneCut == OMX_TRUE)
+        pLookahead->nAvgTemporal = nTemporal;
+    else
+        pLookahead->nAvgTemporal = ((pLookahead->nAvgTemporal * 7) + nTemporal) / 8;
+    pLookahead->nCurCost         = nSpatial + (nTemporal * 2);
+    pLookahead->bCurAnalyzed     = OMX_TRUE;
+    pLookahead->bPrevSampleValid = OMX_TRUE;
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+/* approximate luma, (R + 2G + B) / 4, of a 32bit RGB frame. G is at byte 1 or 2 of a pixel */
+static void Exynos_Venc_RGBToLuma(
+    OMX_U8  *pRGB,
+    OMX_U32  nRGBStride,    /* in bytes */
+    OMX_U32  nGreenIndex,
+    OMX_U32  nWidth,
+    OMX_U32  nHeight,
+    OMX_U8  *pLuma,
+    OMX_U32  nLumaStride)
+{
+    OMX_U8  *pSrc = NULL;
+    OMX_U8  *pDst = NULL;
+    OMX_U32  x, y;
+
+    for (y = 0; y < nHeight; y++) {
+        pSrc = pRGB + (y * nRGBStride);
+        pDst = pLuma + (y * nLumaStride);
+        x    = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        for (; (x + 16) <= nWidth; x += 16) {
+            uint8x16x4_t pixel = vld4q_u8(pSrc + (x * 4));
+            uint8x16_t   rb;
+
+            /* halving adds truncate the same way as the C path below */
+            if (nGreenIndex == 1) {
+                rb = vhaddq_u8(pixel.val[0], pixel.val[2]);
+                vst1q_u8(pDst + x, vhaddq_u8(rb, pixel.val[1]));
+            } else {
+                rb = vhaddq_u8(pixel.val[1], pixel.val[3]);
+                vst1q_u8(pDst + x, vhaddq_u8(rb, pixel.val[2]));
+            }
+        }
+#endif
+        for (; x < nWidth; x++) {
+            OMX_U8 *pPixel = pSrc + (x * 4) + nGreenIndex;
+
+            pDst[x] = (OMX_U8)(((((OMX_U32)pPixel[-1] + pPixel[1]) >> 1) + pPixel[0]) >> 1);
+        }
+
+        /* padding up to the MB boundary is read by the block statistics */
+        for (; x < nLumaStride; x++)
+            pDst[x] = pDst[nWidth - 1];
+    }
+
+    return;
+}
+
+/*
+ * runs the enabled analysis (adaptive ROI, lookahead) on a frame in the format MFC encodes,
+ * that is the CSC destination. 32bit RGB is reduced to luma first, NV12Tiled is skipped.
+ * nStride is in pixels.
+ */
+void Exynos_Venc_AnalyzeInput(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_COLOR_FORMATTYPE      eMFCColorFormat,
+    OMX_U8                   *pData,
+    OMX_U32                   nStride,
+    OMX_U32                   nWidth,
+    OMX_U32                   nHeight)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_U8  *pLuma          = NULL;
+    OMX_U32  nLumaStride    = nStride;
+    OMX_U32  nGreenIndex, nLumaSize;
+
+    FunctionIn();
+
+    if ((pData == NULL) ||
+        (nWidth == 0) ||
+        (nHeight == 0) ||
+        ((pVideoEnc->bAdaptiveRoi != OMX_TRUE) &&
+         (pVideoEnc->lookahead.nActiveDepth == 0)))
+        goto EXIT;
+
+    switch ((int)eMFCColorFormat) {
+    case OMX_COLOR_FormatYUV420Planar:
+    case OMX_COLOR_FormatYUV420SemiPlanar:
+    case OMX_SEC_COLOR_FormatNV21Linear:
+    case OMX_SEC_COLOR_FormatYVU420Planar:
+        /* 8bit linear luma is at the top of the first plane */
+        pLuma = pData;
+        break;
+    case OMX_COLOR_Format32bitARGB8888:     /* HAL_PIXEL_FORMAT_BGRA_8888 */
+    case OMX_COLOR_Format32bitBGRA8888:     /* HAL_PIXEL_FORMAT_EXYNOS_ARGB_8888 : A, R, G, B in memory */
+    case OMX_COLOR_Format32BitRGBA8888:     /* HAL_PIXEL_FORMAT_RGBA_8888 */
+        nGreenIndex = (eMFCColorFormat == OMX_COLOR_Format32bitBGRA8888)? 2:1;
+        nLumaStride = ALIGN(nWidth, ADAPTIVE_ROI_MB_SIZE);
+        nLumaSize   = nLumaStride * nHeight;
+
+        if (pVideoEnc->nAnalysisLumaSize < nLumaSize) {
+            if (pVideoEnc->pAnalysisLuma != NULL)
+                Exynos_OSAL_Free(pVideoEnc->pAnalysisLuma);
+
+            pVideoEnc->nAnalysisLumaSize = 0;
+            pVideoEnc->pAnalysisLuma     = (OMX_U8 *)Exynos_OSAL_Malloc(nLumaSize);
+            if (pVideoEnc->pAnalysisLuma == NULL) {
+                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Malloc for luma(%d)", pExynosComponent, __FUNCTION__, nLumaSize);
+                goto EXIT;
+            }
+
+            pVideoEnc->nAnalysisLumaSize = nLumaSize;
+        }
+
+        pLuma = pVideoEnc->pAnalysisLuma;
+        Exynos_Venc_RGBToLuma(pData, nStride * 4, nGreenIndex, nWidth, nHeight, pLuma, nLumaStride);
+        break;
+    default:
+        goto EXIT;
+    }
+
+    if (pVideoEnc->bAdaptiveRoi == OMX_TRUE)
+        Exynos_AdaptiveRoi_Analyze(pExynosComponent, pLuma, nLumaStride, nWidth, nHeight);
+
+    if (pVideoEnc->lookahead.nActiveDepth > 0)
+        Exynos_Lookahead_Analyze(pExynosComponent, pLuma, nLumaStride, nWidth, nHeight);
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+static void Exynos_Venc_QueueFrameConfig(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_PTR                   pDynamicConfigCMD)
+{
+    if (pDynamicConfigCMD == NULL)
+        return;
+
+    if (Exynos_OSAL_Queue(&pExynosComponent->dynamicConfigQ, pDynamicConfigCMD) != 0) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] dynamicConfigQ is full, config(0x%x) is dropped",
+                                            pExynosComponent, __FUNCTION__, *((OMX_S32 *)pDynamicConfigCMD));
+        Exynos_OSAL_Free(pDynamicConfigCMD);
+    }
+
+    return;
+}
+
+/* decides frame type, QP range and bitrate of the oldest held frame from the frames behind it */
+static void Exynos_Lookahead_Decide(
+    OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    EXYNOS_OMX_VENC_LOOKAHEAD       *pLookahead         = &pVideoEnc->lookahead;
+    EXYNOS_OMX_VENC_LOOKAHEAD_FRAME *pFrame             = &pLookahead->frame[pLookahead->nHead];
+    EXYNOS_OMX_VENC_LOOKAHEAD_FRAME *pNextFrame         = NULL;
+
+    OMX_U32 nWindowCost = 0;
+    OMX_U32 nAnalyzed   = 0;
+    OMX_U32 nBaseBitrate, nBitrate;
+    OMX_S32 nQpDelta    = 0;
+    OMX_U32 i;
+
+    FunctionIn();
+
+    if (pFrame->bAnalyzed == OMX_FALSE)
+        goto EXIT;
+
+    for (i = 0; i < pLookahead->nCount; i++) {
+        EXYNOS_OMX_VENC_LOOKAHEAD_FRAME *pWindow = &pLookahead->frame[(pLookahead->nHead + i) % VENC_LOOKAHEAD_DEPTH_MAX];
+
+        if (pWindow->bAnalyzed == OMX_TRUE) {
+            nWindowCost += pWindow->nCost;
+            nAnalyzed++;
+        }
+    }
+    nWindowCost /= nAnalyzed;
+
+    if (pLookahead->nCount > 1)
+        pNextFrame = &pLookahead->frame[(pLookahead->nHead + 1) % VENC_LOOKAHEAD_DEPTH_MAX];
+
+    /* 1. scene cut : start it with an IDR */
+    if (pFrame->bSceneCut == OMX_TRUE) {
+        OMX_CONFIG_INTRAREFRESHVOPTYPE intraRefresh;
+
+        INIT_SET_SIZE_VERSION(&intraRefresh, OMX_CONFIG_INTRAREFRESHVOPTYPE);
+        intraRefresh.nPortIndex      = OUTPUT_PORT_INDEX;
+        intraRefresh.IntraRefreshVOP = OMX_TRUE;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] scene cut at timestamp %lld", pExynosComponent, __FUNCTION__, pFrame->data.timeStamp);
+        Exynos_Venc_QueueFrameConfig(pExynosComponent,
+                                     Exynos_OMX_MakeDynamicConfig((OMX_INDEXTYPE)OMX_IndexConfigVideoIntraVOPRefresh, (OMX_PTR)&intraRefresh));
+    }
+
+    /* 2. QP range : bits spent right before a cut or on a frame simpler than what follows are mostly wasted */
+    if ((pNextFrame != NULL) &&
+        (pNextFrame->bSceneCut == OMX_TRUE)) {
+        nQpDelta = VENC_LOOKAHEAD_QP_DELTA;
+    } else if ((pFrame->nCost * 2) < nWindowCost) {
+        nQpDelta = VENC_LOOKAHEAD_QP_DELTA / 2;
+    } else if (pFrame->nCost > (nWindowCost * 2)) {
+        nQpDelta = -VENC_LOOKAHEAD_QP_DELTA;
+    }
+
+    if ((pLookahead->bBaseQpRange == OMX_TRUE) &&
+        (pLookahead->nQpDelta != nQpDelta)) {
+        OMX_VIDEO_QPRANGETYPE qpRange;
+
+        Exynos_OSAL_Memcpy(&qpRange, &pLookahead->baseQpRange, sizeof(qpRange));
+        if (nQpDelta > 0) {
+            /* raise the lower bound only */
+            qpRange.qpRangeI.nMinQP += nQpDelta;
+            qpRange.qpRangeP.nMinQP += nQpDelta;
+            qpRange.qpRangeB.nMinQP += nQpDelta;
+        } else if (nQpDelta < 0) {
+            /* lower the upper bound only */
+            qpRange.qpRangeI.nMaxQP += nQpDelta;
+            qpRange.qpRangeP.nMaxQP += nQpDelta;
+            qpRange.qpRangeB.nMaxQP += nQpDelta;
+        }
+
+        /* never cross the bounds of the base range */
+        if (qpRange.qpRangeI.nMinQP > qpRange.qpRangeI.nMaxQP)
+            qpRange.qpRangeI.nMinQP = qpRange.qpRangeI.nMaxQP;
+        if (qpRange.qpRangeP.nMinQP > qpRange.qpRangeP.nMaxQP)
+            qpRange.qpRangeP.nMinQP = qpRange.qpRangeP.nMaxQP;
+        if (qpRange.qpRangeB.nMinQP > qpRange.qpRangeB.nMaxQP)
+            qpRange.qpRangeB.nMinQP = qpRange.qpRangeB.nMaxQP;
+
+        Exynos_Venc_QueueFrameConfig(pExynosComponent,
+                                     Exynos_OMX_MakeDynamicConfig((OMX_INDEXTYPE)OMX_IndexConfigVideoQPRange, (OMX_PTR)&qpRange));
+        pLookahead->nQpDelta = nQpDelta;
+    }
+
+    /* 3. bitrate : follow the complexity of the window against the long term average, within +-25% */
+    pLookahead->nAvgCost = (pLookahead->nAvgCost == 0)? pFrame->nCost:(((pLookahead->nAvgCost * 15) + pFrame->nCost) / 16);
+
+    nBaseBitrate = pOutputPort->portDefinition.format.video.nBitrate;
+    if ((pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] != OMX_Video_ControlRateDisable) &&
+        (pLookahead->nAvgCost > 0) &&
+        (nBaseBitrate > 0)) {
+        nBitrate = (OMX_U32)(((OMX_U64)nBaseBitrate * nWindowCost) / pLookahead->nAvgCost);
+        if (nBitrate < ((nBaseBitrate / 4) * 3))
+            nBitrate = (nBaseBitrate / 4) * 3;
+        else if (nBitrate > ((nBaseBitrate / 4) * 5))
+            nBitrate = (nBaseBitrate / 4) * 5;
+
+        if ((pLookahead->nBitrate == 0) ||
+            ((OMX_U32)abs((int)nBitrate - (int)pLookahead->nBitrate) > (nBaseBitrate / 16))) {
+            OMX_VIDEO_CONFIG_BITRATETYPE bitrate;
+
+            INIT_SET_SIZE_VERSION(&bitrate, OMX_VIDEO_CONFIG_BITRATETYPE);
+            bitrate.nPortIndex     = OUTPUT_PORT_INDEX;
+            bitrate.nEncodeBitrate = nBitrate;
+
+            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] bitrate %d -> %d (cost: window %d, average %d)",
+                                                pExynosComponent, __FUNCTION__, pLookahead->nBitrate, nBitrate,
+                                                nWindowCost, pLookahead->nAvgCost);
+            Exynos_Venc_QueueFrameConfig(pExynosComponent,
+                                         Exynos_OMX_MakeDynamicConfig((OMX_INDEXTYPE)OMX_IndexConfigVideoBitrate, (OMX_PTR)&bitrate));
+            pLookahead->nBitrate = nBitrate;
+        }
+    }
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+void Exynos_Lookahead_Reset(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc  = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LOOKAHEAD     *pLookahead = NULL;
+    OMX_U32                        i;
+
+    FunctionIn();
+
+    if (pVideoEnc == NULL)
+        goto EXIT;
+
+    pLookahead = &pVideoEnc->lookahead;
 
-        Exynos_OSAL_SignalReset(pExynosComponent->pExynosPort[nPortIndex].pauseEvent);
+    /* held codec buffers are given back by the codec flush (enqueue all buffers) */
+    for (i = 0; i < VENC_LOOKAHEAD_DEPTH_MAX; i++) {
+        if (pLookahead->frame[i].pRoiConfigCMD != NULL) {
+            Exynos_OSAL_Free(pLookahead->frame[i].pRoiConfigCMD);
+            pLookahead->frame[i].pRoiConfigCMD = NULL;
+        }
+        Exynos_ResetCodecData(&pLookahead->frame[i].data);
+    }
+
+    if (pVideoEnc->pAdaptiveRoiCMD != NULL) {
+        Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiCMD);
+        pVideoEnc->pAdaptiveRoiCMD = NULL;
     }
 
+    pLookahead->nHead               = 0;
+    pLookahead->nCount              = 0;
+    pLookahead->bCurAnalyzed        = OMX_FALSE;
+    pLookahead->bPrevSampleValid    = OMX_FALSE;
+
 EXIT:
     FunctionOut();
 
     return;
 }
 
+void Exynos_Lookahead_Setup(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_VENC_LOOKAHEAD       *pLookahead         = &pVideoEnc->lookahead;
+    OMX_ERRORTYPE                    err                = OMX_ErrorNone;
+
+    FunctionIn();
+
+    pLookahead->nActiveDepth = 0;
+
+    if (pLookahead->nDepth == 0)
+        goto EXIT;
+
+    /* frames are held in codec buffers and analysed after CSC */
+    if ((pInputPort->bufferProcessType & BUFFER_COPY) != BUFFER_COPY) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] lookahead is disabled : input is not copied", pExynosComponent, __FUNCTION__);
+        goto EXIT;
+    }
+
+    /* holding frames back only adds latency to a real-time session */
+    if (((int)pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] == (int)OMX_Video_ControlRateConstantVTCall) ||
+        ((int)pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] == (int)OMX_Video_ControlRateConstantSkipFrames)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] lookahead is disabled : real-time rate control(0x%x)",
+                                            pExynosComponent, __FUNCTION__, pVideoEnc->eControlRate[OUTPUT_PORT_INDEX]);
+        goto EXIT;
+    }
+
+    Exynos_Lookahead_Reset(pExynosComponent);
+
+    INIT_SET_SIZE_VERSION(&pLookahead->baseQpRange, OMX_VIDEO_QPRANGETYPE);
+    pLookahead->baseQpRange.nPortIndex = OUTPUT_PORT_INDEX;
+    err = pOMXComponent->GetConfig((OMX_HANDLETYPE)pOMXComponent, (OMX_INDEXTYPE)OMX_IndexConfigVideoQPRange, &pLookahead->baseQpRange);
+    pLookahead->bBaseQpRange = (err == OMX_ErrorNone)? OMX_TRUE:OMX_FALSE;
+
+    pLookahead->nQpDelta        = 0;
+    pLookahead->nBitrate        = 0;
+    pLookahead->nAvgCost        = 0;
+    pLookahead->nAvgTemporal    = 0;
+    pLookahead->nActiveDepth    = (pLookahead->nDepth > VENC_LOOKAHEAD_DEPTH_MAX)? VENC_LOOKAHEAD_DEPTH_MAX:pLookahead->nDepth;
+
+    /* the held frames take input codec buffers, fewer of them are allocated while memory is trimmed */
+    if ((pLookahead->nActiveDepth + 2) > pVideoEnc->nMFCEncInputBufferNum)
+        pLookahead->nActiveDepth = (pVideoEnc->nMFCEncInputBufferNum > 2)? (pVideoEnc->nMFCEncInputBufferNum - 2):0;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] lookahead depth : %d (requested %d), QP range control : %s",
+                                            pExynosComponent, __FUNCTION__, pLookahead->nActiveDepth, pLookahead->nDepth,
+                                            (pLookahead->bBaseQpRange == OMX_TRUE)? "on":"off");
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+void Exynos_LTR_SetPolicy(
+    EXYNOS_OMX_BASECOMPONENT            *pExynosComponent,
+    EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY   *pLTRPolicy,
+    OMX_U32                              nLTRNum)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc   = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LTR_CONTROL   *pLTRControl = &pVideoEnc->ltrControl;
+
+    FunctionIn();
+
+    pLTRControl->nTemporalLayerCount = pLTRPolicy->nTemporalLayerCount;
+    pLTRControl->nRefreshPeriod      = (nLTRNum > 0)? pLTRPolicy->nLTRRefreshPeriod:0;
+    pLTRControl->nFrameCount         = 0;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] LTR policy // layer count: %d, refresh period: %d",
+                                            pExynosComponent, __FUNCTION__,
+                                            pLTRControl->nTemporalLayerCount, pLTRControl->nRefreshPeriod);
+
+    FunctionOut();
+
+    return;
+}
+
+void Exynos_LTR_ReportLoss(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_TICKS                 nTimeStamp)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc   = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LTR_CONTROL   *pLTRControl = &pVideoEnc->ltrControl;
+
+    FunctionIn();
+
+    /* the earliest report wins until recovery is issued */
+    if ((pLTRControl->bLossReported == OMX_FALSE) ||
+        (nTimeStamp < pLTRControl->lossTimeStamp))
+        pLTRControl->lossTimeStamp = nTimeStamp;
+
+    pLTRControl->bLossReported = OMX_TRUE;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] loss report : timestamp %lld us",
+                                            pExynosComponent, __FUNCTION__, nTimeStamp);
+
+    FunctionOut();
+
+    return;
+}
+
+/* issues the per-frame LTR controls before a frame is queued to MFC */
+void Exynos_LTR_Run(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    ExynosVideoEncOps        *pEncOps,
+    OMX_HANDLETYPE            hMFCHandle,
+    OMX_U32                   nLTRNum,
+    OMX_TICKS                 timeStamp)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc   = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LTR_CONTROL   *pLTRControl = &pVideoEnc->ltrControl;
+    OMX_BOOL                       bMark       = OMX_FALSE;
+
+    int nRefIndex  = -1;
+    int nMarkIndex = -1;
+    int i;
+
+    FunctionIn();
+
+    if (nLTRNum > OMX_VIDEO_MAX_LTR_FRAMES)
+        nLTRNum = OMX_VIDEO_MAX_LTR_FRAMES;
+
+    if (pLTRControl->bLossReported == OMX_TRUE) {
+        /* the newest LTR encoded before the lost frame is still intact on the receiver */
+        for (i = 0; i < (int)nLTRNum; i++) {
+            if (pLTRControl->bMarked[i] != OMX_TRUE)
+                continue;
+
+            if (pLTRControl->markedTimeStamp[i] >= pLTRControl->lossTimeStamp) {
+                pLTRControl->bMarked[i] = OMX_FALSE;
+                continue;
+            }
+
+            if ((nRefIndex < 0) ||
+                (pLTRControl->markedTimeStamp[i] > pLTRControl->markedTimeStamp[nRefIndex]))
+                nRefIndex = i;
+        }
+
+        if (nRefIndex >= 0) {
+            pEncOps->Set_UsedLTRFrame(hMFCHandle, (1 << nRefIndex));
+            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] recover from LTR[%d](%lld us), loss at %lld us",
+                                                    pExynosComponent, __FUNCTION__, nRefIndex,
+                                                    pLTRControl->markedTimeStamp[nRefIndex], pLTRControl->lossTimeStamp);
+        } else {
+            pEncOps->Set_FrameType(hMFCHandle, VIDEO_FRAME_I);
+            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] no usable LTR, recover with I-frame (loss at %lld us)",
+                                                    pExynosComponent, __FUNCTION__, pLTRControl->lossTimeStamp);
+        }
+
+        pLTRControl->bLossReported = OMX_FALSE;
+
+        /* the recovery frame is the first one the receiver has intact again, it is the next long-term reference */
+        bMark = OMX_TRUE;
+    } else if (pLTRControl->nRefreshPeriod > 0) {
+        pLTRControl->nFrameCount++;
+        if (pLTRControl->nFrameCount >= pLTRControl->nRefreshPeriod)
+            bMark = OMX_TRUE;
+    }
+
+    if ((bMark == OMX_TRUE) &&
+        (pLTRControl->nRefreshPeriod > 0) &&
+        (nLTRNum > 0)) {
+        /* a discarded slot first, the one referred by this frame is kept as long as another is available */
+        for (i = 0; i < (int)nLTRNum; i++) {
+            int nIndex = (pLTRControl->nNextIndex + i) % nLTRNum;
+
+            if ((nIndex != nRefIndex) &&
+                (pLTRControl->bMarked[nIndex] != OMX_TRUE)) {
+                nMarkIndex = nIndex;
+                break;
+            }
+        }
+
+        if (nMarkIndex < 0) {
+            nMarkIndex = pLTRControl->nNextIndex % nLTRNum;
+            if ((nMarkIndex == nRefIndex) && (nLTRNum > 1))
+                nMarkIndex = (nMarkIndex + 1) % nLTRNum;
+        }
+
+        pEncOps->Set_MarkLTRFrame(hMFCHandle, nMarkIndex + 1);
+
+        pLTRControl->bMarked[nMarkIndex]         = OMX_TRUE;
+        pLTRControl->markedTimeStamp[nMarkIndex] = timeStamp;
+        pLTRControl->nNextIndex                  = (nMarkIndex + 1) % nLTRNum;
+        pLTRControl->nFrameCount                 = 0;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] mark LTR[%d] at %lld us",
+                                                pExynosComponent, __FUNCTION__, nMarkIndex, timeStamp);
+    }
+
+    FunctionOut();
+
+    return;
+}
+
+/* sends a converted frame to the codec, through the lookahead window when it is active */
+OMX_ERRORTYPE Exynos_OMX_SrcInputSubmit(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    EXYNOS_OMX_DATA     *pSrcInputData)
+{
+    OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_VENC_LOOKAHEAD       *pLookahead         = &pVideoEnc->lookahead;
+    EXYNOS_OMX_VENC_LOOKAHEAD_FRAME *pFrame             = NULL;
+    OMX_BOOL                         bDrain             = OMX_FALSE;
+
+    FunctionIn();
+
+    if (pLookahead->nActiveDepth == 0) {
+        Exynos_Venc_QueueFrameConfig(pExynosComponent, pVideoEnc->pAdaptiveRoiCMD);
+        pVideoEnc->pAdaptiveRoiCMD = NULL;
+
+        ret = pVideoEnc->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+        if (ret == OMX_ErrorNone)
+            EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nHeldByCodec[INPUT_PORT_INDEX]);
+        goto EXIT;
+    }
+
+    /* hold the frame with its analysis */
+    pFrame = &pLookahead->frame[(pLookahead->nHead + pLookahead->nCount) % VENC_LOOKAHEAD_DEPTH_MAX];
+    Exynos_OSAL_Memcpy(&pFrame->data, pSrcInputData, sizeof(EXYNOS_OMX_DATA));
+    pFrame->pRoiConfigCMD   = pVideoEnc->pAdaptiveRoiCMD;
+    pFrame->bAnalyzed       = pLookahead->bCurAnalyzed;
+    pFrame->nCost           = pLookahead->nCurCost;
+    pFrame->bSceneCut       = pLookahead->bCurSceneCut;
+    pLookahead->nCount++;
+
+    pVideoEnc->pAdaptiveRoiCMD  = NULL;
+    pLookahead->bCurAnalyzed    = OMX_FALSE;
+
+    if (pSrcInputData->nFlags & OMX_BUFFERFLAG_EOS)
+        bDrain = OMX_TRUE;
+
+    while ((pLookahead->nCount >= pLookahead->nActiveDepth) ||
+           ((bDrain == OMX_TRUE) && (pLookahead->nCount > 0))) {
+        pFrame = &pLookahead->frame[pLookahead->nHead];
+
+        Exynos_Lookahead_Decide(pOMXComponent);
+        Exynos_Venc_QueueFrameConfig(pExynosComponent, pFrame->pRoiConfigCMD);
+        pFrame->pRoiConfigCMD = NULL;
+
+        ret = pVideoEnc->exynos_codec_srcInputProcess(pOMXComponent, &pFrame->data);
+        if (ret == OMX_ErrorNone)
+            EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nHeldByCodec[INPUT_PORT_INDEX]);
+
+        Exynos_ResetCodecData(&pFrame->data);
+        pLookahead->nHead = (pLookahead->nHead + 1) % VENC_LOOKAHEAD_DEPTH_MAX;
+        pLookahead->nCount--;
+
+        if ((EXYNOS_OMX_ERRORTYPE)ret == OMX_ErrorCodecInit)
+            break;
+    }
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_BOOL Exynos_CSC_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData)
 {
     OMX_BOOL                       ret                = OMX_FALSE;
@@ -810,6 +1771,12 @@ OMX_BOOL Exynos_CSC_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA
          */
         if (csc_method == CSC_METHOD_HW) {
             pSrcBuf[0]   = (void *)Exynos_OSAL_SharedMemory_VirtToION(pVideoEnc->hSharedMemory, (char *)pInputBuf);
+#ifdef TUNNELING_SUPPORT
+            /* memory of the peer is not known to our allocator */
+            if (CHECK_PORT_TUNNELED(pInputPort) &&
+                (pInputUseBuffer->bufferHeader->pOutputPortPrivate != NULL))
+                pSrcBuf[0] = (void *)((EXYNOS_OMX_TUNNEL_BUFFER *)pInputUseBuffer->bufferHeader->pOutputPortPrivate)->fd;
+#endif
             pSrcBuf[1]   = NULL;
             pSrcBuf[2]   = NULL;
         } else {
@@ -987,6 +1954,11 @@ OMX_BOOL Exynos_CSC_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA
         csc_ret = csc_convert(pVideoEnc->csc_handle);
     ret = (csc_ret != CSC_ErrorNone)? OMX_FALSE:OMX_TRUE;
 
+    /* the analysis reads the CSC destination, which is in the format MFC encodes */
+    if (ret == OMX_TRUE)
+        Exynos_Venc_AnalyzeInput(pExynosComponent, eSrcColorFormat, (OMX_U8 *)pSrcInputData->buffer.addr[0],
+                                 dstImgInfo.nStride, dstImgInfo.nImageWidth, dstImgInfo.nImageHeight);
+
     if (pInputPort->eMetaDataType & METADATA_TYPE_BUFFER_LOCK)
         Exynos_OSAL_UnlockMetaData(pInputBuf, pInputPort->eMetaDataType);
 
@@ -1124,6 +2096,8 @@ OMX_BOOL Exynos_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
                     ret = OMX_FALSE;
                     goto EXIT;
                 }
+
+                EXYNOS_OMX_METRIC_ADD(pExynosComponent->metrics.nCopiedBytes[INPUT_PORT_INDEX], copySize);
             }
 
             inputUseBuffer->dataLen         -= copySize;
@@ -1224,6 +2198,7 @@ OMX_BOOL Exynos_Postprocess_OutputData(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_
                     Exynos_OSAL_Memcpy((outputUseBuffer->bufferHeader->pBuffer + outputUseBuffer->dataLen),
                                        ((char *)dstOutputData->buffer.addr[0] + dstOutputData->usedDataLen),
                                        copySize);
+                    EXYNOS_OMX_METRIC_ADD(pExynosComponent->metrics.nCopiedBytes[OUTPUT_PORT_INDEX], copySize);
                 }
 
                 outputUseBuffer->dataLen += copySize;
@@ -1346,6 +2321,20 @@ OMX_ERRORTYPE Exynos_OMX_ExtensionSetup(OMX_HANDLETYPE hComponent)
         }
     }
 
+#ifdef TUNNELING_SUPPORT
+    /* frames the tunneled decoder MFC wrote in place go to MFC as they are, copied ones still go through CSC */
+    if ((pInputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        CHECK_PORT_TUNNELED(pInputPort) &&
+        !(pInputPort->bufferProcessType & BUFFER_COPY_FORCE) &&
+        (srcInputUseBuffer->bufferHeader != NULL) &&
+        (srcInputUseBuffer->bufferHeader->pOutputPortPrivate != NULL) &&
+        (((EXYNOS_OMX_TUNNEL_BUFFER *)srcInputUseBuffer->bufferHeader->pOutputPortPrivate)->bCodecLayout == OMX_TRUE) &&
+        (Exynos_OSAL_GetPlaneCount(eColorFormat, pInputPort->ePlaneType) == 1)) {
+        pInputPort->bufferProcessType = BUFFER_SHARE;
+        Exynos_SetPlaneToPort(pInputPort, 1);
+    }
+#endif
+
     /* forcefully have to use BUFFER_COPY mode, if blur filter is used or rotation is needed or image flip is needed*/
     if ((pVideoEnc->bUseBlurFilter == OMX_TRUE) ||
         (pVideoEnc->eRotationType != ROTATE_0) ||
@@ -1383,13 +2372,13 @@ OMX_ERRORTYPE Exynos_OMX_ExtensionSetup(OMX_HANDLETYPE hComponent)
         Exynos_SetPlaneToPort(pInputPort, Exynos_OSAL_GetPlaneCount(eActualFormat, pInputPort->ePlaneType));
         Exynos_OSAL_GetPlaneSize(eActualFormat, pInputPort->ePlaneType, nFrameWidth, nFrameHeight, nDataLen, nAllocLen);
 
-        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, MFC_INPUT_BUFFER_NUM_MAX, nAllocLen);
+        ret = Exynos_Allocate_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX, Exynos_Get_CodecInputBufferNum(pOMXComponent), nAllocLen);
         if (ret != OMX_ErrorNone) {
             Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Allocate_CodecBuffers", pExynosComponent, __FUNCTION__);
             goto EXIT;
         }
 
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)
+        for (i = 0; i < (int)pVideoEnc->nMFCEncInputBufferNum; i++)
             Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
     } else if (pInputPort->bufferProcessType == BUFFER_SHARE) {
         /*************/
@@ -1398,6 +2387,8 @@ OMX_ERRORTYPE Exynos_OMX_ExtensionSetup(OMX_HANDLETYPE hComponent)
         /* Does not require any actions. */
     }
 
+    Exynos_Lookahead_Setup(pOMXComponent);
+
 EXIT:
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] eActualFormat: 0x%x, eColorFormat: 0x%x, eBufferColorFormat: 0x%x, bufferProcessType: 0x%x",
                                             pExynosComponent, __FUNCTION__,
@@ -1421,21 +2412,28 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
     FunctionIn();
 
     while (!pVideoEnc->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
         Exynos_Wait_ProcessPause(pExynosComponent, INPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosInputPort)) ||
              (!CHECK_PORT_ENABLED(exynosInputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosInputPort->semWaitPortEnable[INPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, INPUT_PORT_INDEX)) &&
                (!pVideoEnc->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosInputPort))
                 break;
@@ -1482,7 +2480,9 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
 
                 if ((pVideoEnc->bFirstInput == OMX_TRUE) &&
                     (!CHECK_PORT_BEING_FLUSHED(exynosInputPort))) {
+                    Exynos_OSAL_WorkerBlockingBegin();
                     ret = Exynos_OMX_ExtensionSetup(hComponent);
+                    Exynos_OSAL_WorkerBlockingEnd();
                     if (ret != OMX_ErrorNone) {
                         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] send event(OMX_EventError)", pExynosComponent, __FUNCTION__);
                         (*(pExynosComponent->pCallbacks->EventHandler)) (pOMXComponent,
@@ -1506,7 +2506,9 @@ OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent)
                 break;
             }
 
-            ret = pVideoEnc->exynos_codec_srcInputProcess(pOMXComponent, pSrcInputData);
+            Exynos_OSAL_WorkerBlockingBegin();
+            ret = Exynos_OMX_SrcInputSubmit(pOMXComponent, pSrcInputData);
+            Exynos_OSAL_WorkerBlockingEnd();
 
             Exynos_ResetCodecData(pSrcInputData);
             Exynos_OSAL_MutexUnlock(srcInputUseBuffer->bufferMutex);
@@ -1538,13 +2540,20 @@ OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent)
     Exynos_ResetCodecData(&srcOutputData);
 
     while (!pVideoEnc->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
+        Exynos_Wait_ProcessPause(pExynosComponent, INPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosInputPort)) ||
              (!CHECK_PORT_ENABLED(exynosInputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosInputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
@@ -1554,17 +2563,26 @@ OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent)
                 if (Exynos_Check_BufferProcess_State(pExynosComponent, INPUT_PORT_INDEX) == OMX_FALSE)
                     break;
             }
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, INPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosInputPort))
                 break;
 
+            /* on the worker pool, the step parks until MFC gives a source frame back */
+            if (Exynos_OSAL_WorkerWaitFd(exynosInputPort->hCodecReadyFd) == OMX_FALSE)
+                break;
+
             Exynos_OSAL_MutexLock(srcOutputUseBuffer->bufferMutex);
             Exynos_OSAL_Memset(&srcOutputData, 0, sizeof(EXYNOS_OMX_DATA));
 
+            Exynos_OSAL_WorkerBlockingBegin();
             ret = pVideoEnc->exynos_codec_srcOutputProcess(pOMXComponent, &srcOutputData);
+            Exynos_OSAL_WorkerBlockingEnd();
 
             if (ret == OMX_ErrorNone) {
+                EXYNOS_OMX_METRIC_DEC(pExynosComponent->metrics.nHeldByCodec[INPUT_PORT_INDEX]);
+
                 if (exynosInputPort->bufferProcessType & BUFFER_COPY) {
                     OMX_PTR codecBuffer;
                     codecBuffer = srcOutputData.pPrivate;
@@ -1603,20 +2621,28 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
     Exynos_ResetCodecData(&dstInputData);
 
     while (!pVideoEnc->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
+        Exynos_Wait_ProcessPause(pExynosComponent, OUTPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosOutputPort)) ||
              (!CHECK_PORT_ENABLED(exynosOutputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosOutputPort->semWaitPortEnable[INPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, OUTPUT_PORT_INDEX)) &&
                (!pVideoEnc->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosOutputPort))
                 break;
@@ -1709,7 +2735,11 @@ OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent)
                 break;
             }
 
+            Exynos_OSAL_WorkerBlockingBegin();
             ret = pVideoEnc->exynos_codec_dstInputProcess(pOMXComponent, &dstInputData);
+            Exynos_OSAL_WorkerBlockingEnd();
+            if (ret == OMX_ErrorNone)
+                EXYNOS_OMX_METRIC_INC(pExynosComponent->metrics.nHeldByCodec[OUTPUT_PORT_INDEX]);
 
             Exynos_ResetCodecData(&dstInputData);
             Exynos_OSAL_MutexUnlock(dstInputUseBuffer->bufferMutex);
@@ -1736,21 +2766,28 @@ OMX_ERRORTYPE Exynos_OMX_DstOutputBufferProcess(OMX_HANDLETYPE hComponent)
     FunctionIn();
 
     while (!pVideoEnc->bExitBufferProcessThread) {
-        Exynos_OSAL_SleepMillisec(0);
+        if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+            break;
+
         Exynos_Wait_ProcessPause(pExynosComponent, OUTPUT_PORT_INDEX);
+        if (Exynos_OSAL_WorkerParked() == OMX_TRUE)
+            break;
+
         if ((exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX] != NULL) &&
             ((CHECK_PORT_BEING_DISABLED(exynosOutputPort)) ||
              (!CHECK_PORT_ENABLED(exynosOutputPort)))) {
             /* sema will be posted at PortEnable */
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(port enable)", pExynosComponent, __FUNCTION__);
-            Exynos_OSAL_SemaphoreWait(exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]);
+            if (Exynos_OSAL_WorkerSemaphoreWait(exynosOutputPort->semWaitPortEnable[OUTPUT_WAY_INDEX]) != OMX_ErrorNone)
+                break;
             Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(port enable)", pExynosComponent, __FUNCTION__);
             continue;
         }
 
         while ((Exynos_Check_BufferProcess_State(pExynosComponent, OUTPUT_PORT_INDEX)) &&
                (!pVideoEnc->bExitBufferProcessThread)) {
-            Exynos_OSAL_SleepMillisec(0);
+            if (Exynos_OMX_BufferProcess_Yield(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_TRUE)
+                break;
 
             if (CHECK_PORT_BEING_FLUSHED(exynosOutputPort))
                 break;
@@ -1774,8 +2811,19 @@ OMX_ERRORTYPE Exynos_OMX_DstOutputBufferProcess(OMX_HANDLETYPE hComponent)
             }
 
             if ((dstOutputUseBuffer->dataValid == OMX_TRUE) ||
-                (exynosOutputPort->bufferProcessType & BUFFER_SHARE))
+                (exynosOutputPort->bufferProcessType & BUFFER_SHARE)) {
+                /* the client buffer stays in dstOutputUseBuffer until the frame is encoded */
+                if (Exynos_OSAL_WorkerWaitFd(exynosOutputPort->hCodecReadyFd) == OMX_FALSE) {
+                    Exynos_OSAL_MutexUnlock(dstOutputUseBuffer->bufferMutex);
+                    break;
+                }
+
+                Exynos_OSAL_WorkerBlockingBegin();
                 ret = pVideoEnc->exynos_codec_dstOutputProcess(pOMXComponent, pDstOutputData);
+                Exynos_OSAL_WorkerBlockingEnd();
+                if (ret == OMX_ErrorNone)
+                    EXYNOS_OMX_METRIC_DEC(pExynosComponent->metrics.nHeldByCodec[OUTPUT_PORT_INDEX]);
+            }
 
             if (exynosOutputPort->bufferProcessType & BUFFER_SHARE) {
                 if (ret == OMX_ErrorNoneReuseBuffer)
@@ -1813,6 +2861,7 @@ static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessThread(OMX_PTR threadData)
 {
     OMX_ERRORTYPE                ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
 
     FunctionIn();
 
@@ -1826,8 +2875,12 @@ static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessThread(OMX_PTR threadData)
         goto EXIT;
     }
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_SrcInputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_SRC_INPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1840,6 +2893,7 @@ static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessThread(OMX_PTR threadData)
 {
     OMX_ERRORTYPE                ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
 
     FunctionIn();
 
@@ -1853,8 +2907,12 @@ static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessThread(OMX_PTR threadData)
         goto EXIT;
     }
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_SrcOutputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_SRC_OUTPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1867,6 +2925,7 @@ static OMX_ERRORTYPE Exynos_OMX_DstInputProcessThread(OMX_PTR threadData)
 {
     OMX_ERRORTYPE                ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
 
     FunctionIn();
 
@@ -1880,8 +2939,12 @@ static OMX_ERRORTYPE Exynos_OMX_DstInputProcessThread(OMX_PTR threadData)
         goto EXIT;
     }
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_DstInputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_DST_INPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1894,6 +2957,7 @@ static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessThread(OMX_PTR threadData)
 {
     OMX_ERRORTYPE                ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE           *pOMXComponent      = NULL;
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = NULL;
 
     FunctionIn();
 
@@ -1907,8 +2971,12 @@ static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessThread(OMX_PTR threadData)
         goto EXIT;
     }
 
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
     Exynos_OMX_DstOutputBufferProcess(pOMXComponent);
 
+    Exynos_OSAL_BenchThreadDone(pExynosComponent->hBench, BENCH_THREAD_DST_OUTPUT);
+
     Exynos_OSAL_ThreadExit(NULL);
 
 EXIT:
@@ -1917,17 +2985,99 @@ EXIT:
     return ret;
 }
 
+/* worker pool counterparts of the threads above */
+static void Exynos_OMX_BufferProcessStep(
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_ERRORTYPE      (*pBufferProcess)(OMX_HANDLETYPE),
+    BENCH_THREAD_TYPE    eThread)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_U64                   nCpuTimeUs       = Exynos_OSAL_BenchStepBegin(pExynosComponent->hBench);
+
+    /* returns once the step parks or its time slice expires */
+    pBufferProcess(pOMXComponent);
+
+    Exynos_OSAL_BenchStepEnd(pExynosComponent->hBench, eThread, nCpuTimeUs);
+}
+
+static OMX_ERRORTYPE Exynos_OMX_SrcInputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_SrcInputBufferProcess, BENCH_THREAD_SRC_INPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_SrcOutputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_SrcOutputBufferProcess, BENCH_THREAD_SRC_OUTPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_DstInputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_DstInputBufferProcess, BENCH_THREAD_DST_INPUT);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Exynos_OMX_DstOutputProcessStep(OMX_PTR pData)
+{
+    Exynos_OMX_BufferProcessStep((OMX_COMPONENTTYPE *)pData, Exynos_OMX_DstOutputBufferProcess, BENCH_THREAD_DST_OUTPUT);
+
+    return OMX_ErrorNone;
+}
+
+static void Exynos_OMX_BufferProcess_Join(
+    OMX_HANDLETYPE  *pThread,
+    OMX_HANDLETYPE  *pWorker)
+{
+    OMX_HANDLETYPE hWorker = *pWorker;
+
+    if (hWorker != NULL) {
+        /* unpublish it first, Exynos_OMX_WakeBufferProcess() must not find it anymore */
+        *pWorker = NULL;
+        Exynos_OSAL_WorkerTerminate(&hWorker);
+    } else {
+        Exynos_OSAL_ThreadTerminate(*pThread);
+        *pThread = NULL;
+    }
+}
+
 OMX_ERRORTYPE Exynos_OMX_BufferProcess_Create(OMX_HANDLETYPE hComponent)
 {
     OMX_ERRORTYPE                    ret                = OMX_ErrorNone;
     OMX_COMPONENTTYPE               *pOMXComponent      = (OMX_COMPONENTTYPE *)hComponent;
     EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
     EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
 
     FunctionIn();
 
     pVideoEnc->bExitBufferProcessThread = OMX_FALSE;
 
+    if (Exynos_OSAL_WorkerPool_Enabled() == OMX_TRUE) {
+        ret = Exynos_OSAL_WorkerCreate(&pOutputPort->hProcessWorker[OUTPUT_WAY_INDEX],
+                     Exynos_OMX_DstOutputProcessStep,
+                     pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pInputPort->hProcessWorker[OUTPUT_WAY_INDEX],
+                         Exynos_OMX_SrcOutputProcessStep,
+                         pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pOutputPort->hProcessWorker[INPUT_WAY_INDEX],
+                         Exynos_OMX_DstInputProcessStep,
+                         pOMXComponent);
+        if (ret == OMX_ErrorNone)
+            ret = Exynos_OSAL_WorkerCreate(&pInputPort->hProcessWorker[INPUT_WAY_INDEX],
+                         Exynos_OMX_SrcInputProcessStep,
+                         pOMXComponent);
+
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] buffer process runs on the worker pool(0x%x)", pExynosComponent, __FUNCTION__, ret);
+        goto EXIT;
+    }
+
     ret = Exynos_OSAL_ThreadCreate(&pVideoEnc->hDstOutputThread,
                  Exynos_OMX_DstOutputProcessThread,
                  pOMXComponent);
@@ -1962,6 +3112,7 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     FunctionIn();
 
     pVideoEnc->bExitBufferProcessThread = OMX_TRUE;
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
 
     Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].bufferSemID, &countValue);
     if (countValue == 0)
@@ -1972,10 +3123,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoEnc->exynos_codec_bufferProcessRun(pOMXComponent, OUTPUT_PORT_INDEX);
 
     /* srcInput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoEnc->hSrcInputThread);
-    pVideoEnc->hSrcInputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoEnc->hSrcInputThread, &pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hProcessWorker[INPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] src input thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -1987,10 +3136,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
         Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].codecSemID);
 
     /* dstInput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoEnc->hDstInputThread);
-    pVideoEnc->hDstInputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoEnc->hDstInputThread, &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hProcessWorker[INPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[INPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] dst input thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -1998,10 +3145,8 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoEnc->exynos_codec_bufferProcessRun(pOMXComponent, INPUT_PORT_INDEX);
 
     /* srcOutput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoEnc->hSrcOutputThread);
-    pVideoEnc->hSrcOutputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoEnc->hSrcOutputThread, &pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hProcessWorker[OUTPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[INPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] src output thread is terminated", pExynosComponent, __FUNCTION__);
 
@@ -2009,13 +3154,14 @@ OMX_ERRORTYPE Exynos_OMX_BufferProcess_Terminate(OMX_HANDLETYPE hComponent)
     pVideoEnc->exynos_codec_bufferProcessRun(pOMXComponent, OUTPUT_PORT_INDEX);
 
     /* dstOutput */
-    Exynos_OSAL_SignalSet(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].pauseEvent);
     Exynos_OSAL_SemaphorePost(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX]);
-    Exynos_OSAL_ThreadTerminate(pVideoEnc->hDstOutputThread);
-    pVideoEnc->hDstOutputThread = NULL;
+    Exynos_OMX_BufferProcess_Join(&pVideoEnc->hDstOutputThread, &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hProcessWorker[OUTPUT_WAY_INDEX]);
     Exynos_OSAL_Set_SemaphoreCount(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].semWaitPortEnable[OUTPUT_WAY_INDEX], 0);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] dst output thread is terminated", pExynosComponent, __FUNCTION__);
 
+    /* nothing waits on the codec any more, it is closed next */
+    Exynos_Set_CodecReadyFd(pExynosComponent, NULL, NULL, NULL);
+
     pExynosComponent->checkTimeStamp.needSetStartTimeStamp      = OMX_FALSE;
     pExynosComponent->checkTimeStamp.needCheckStartTimeStamp    = OMX_FALSE;
 
@@ -2025,6 +3171,20 @@ EXIT:
     return ret;
 }
 
+static void Exynos_OMX_VideoEncodeMemPressure(
+    OMX_PTR     pData,
+    OMX_BOOL    bPressure)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pData;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    /* applied when the input codec buffers are allocated next */
+    __atomic_store_n(&pVideoEnc->bMemoryPressure, bPressure, __ATOMIC_RELEASE);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] memory pressure : %s",
+                                            pExynosComponent, __FUNCTION__, (bPressure == OMX_TRUE)? "on":"off");
+}
+
 OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentInit(OMX_IN OMX_HANDLETYPE hComponent)
 {
     OMX_ERRORTYPE                  ret              = OMX_ErrorNone;
@@ -2092,6 +3252,8 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
 
     pVideoEnc->eRotationType    = ROTATE_0;
 
+    pVideoEnc->bAdaptiveRoi     = OMX_FALSE;
+
 #ifdef USE_ANDROID
     pVideoEnc->pPerfHandle = Exynos_OSAL_CreatePerformanceHandle(OMX_TRUE /* bIsEncoder = true */);
 #endif
@@ -2192,6 +3354,17 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
     pExynosComponent->exynos_BufferProcessTerminate = &Exynos_OMX_BufferProcess_Terminate;
     pExynosComponent->exynos_BufferFlush          = &Exynos_OMX_BufferFlush;
 
+    if (Exynos_OSAL_MemPressure_Register(&pVideoEnc->hMemPressure, Exynos_OMX_VideoEncodeMemPressure, (OMX_PTR)pExynosComponent) != OMX_ErrorNone) {
+        /* not fatal, trimming is still available by OMX_IndexConfigTrimMemory */
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] memory pressure monitor is not available", pExynosComponent, __FUNCTION__);
+        pVideoEnc->hMemPressure = NULL;
+    }
+
+#ifdef USE_ANDROID
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-pipeline-metrics", (OMX_INDEXTYPE)OMX_IndexConfigVideoPipelineMetrics);
+    Exynos_OSAL_AddVendorExt(hComponent, "sec-ext-trim-memory", (OMX_INDEXTYPE)OMX_IndexConfigTrimMemory);
+#endif
+
 EXIT:
     FunctionOut();
 
@@ -2234,8 +3407,16 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentDeinit(OMX_IN OMX_HANDLETYPE hCompo
     }
     pVideoEnc = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
 
+    if (pVideoEnc->hMemPressure != NULL) {
+        Exynos_OSAL_MemPressure_Unregister(pVideoEnc->hMemPressure);
+        pVideoEnc->hMemPressure = NULL;
+    }
+
 #ifdef USE_ANDROID
     Exynos_OSAL_ReleasePerformanceHandle(pVideoEnc->pPerfHandle);
+
+    /* may already be done by the codec, freeing twice is harmless */
+    Exynos_OSAL_DelVendorExts(hComponent);
 #endif
 
     if (pVideoEnc->bEncDRCSync == OMX_TRUE) {
@@ -2243,6 +3424,28 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentDeinit(OMX_IN OMX_HANDLETYPE hCompo
     }
     Exynos_OSAL_SignalTerminate(pVideoEnc->hEncDRCSyncEvent);
 
+    if (pVideoEnc->pAdaptiveRoiMap != NULL) {
+        Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMap);
+        pVideoEnc->pAdaptiveRoiMap = NULL;
+    }
+
+    if (pVideoEnc->pAdaptiveRoiMean != NULL) {
+        Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMean);
+        pVideoEnc->pAdaptiveRoiMean = NULL;
+    }
+
+    if (pVideoEnc->pAnalysisLuma != NULL) {
+        Exynos_OSAL_Free(pVideoEnc->pAnalysisLuma);
+        pVideoEnc->pAnalysisLuma = NULL;
+    }
+    pVideoEnc->nAnalysisLumaSize = 0;
+
+    Exynos_Lookahead_Reset(pExynosComponent);
+    if (pVideoEnc->lookahead.pPrevSample != NULL) {
+        Exynos_OSAL_Free(pVideoEnc->lookahead.pPrevSample);
+        pVideoEnc->lookahead.pPrevSample = NULL;
+    }
+
     Exynos_OSAL_Free(pVideoEnc);
     pExynosComponent->hComponentHandle = pVideoEnc = NULL;
 
@@ -33,6 +33,7 @@
 #include "Exynos_OSAL_Queue.h"
 #include "Exynos_OMX_Baseport.h"
 #include "Exynos_OMX_Basecomponent.h"
+#include "ExynosVideoApi.h"
 
 #define MAX_VIDEO_INPUTBUFFER_NUM    5
 #define MAX_VIDEO_OUTPUTBUFFER_NUM   4
@@ -45,6 +46,7 @@
 #define DEFAULT_VIDEO_OUTPUT_BUFFER_SIZE   (DEFAULT_FRAME_WIDTH * DEFAULT_FRAME_HEIGHT) * 3 / 2
 
 #define MFC_INPUT_BUFFER_NUM_MAX            5
+#define MFC_INPUT_BUFFER_NUM_MIN            2   /* kept while memory is trimmed, leaves no room for the lookahead */
 #define MFC_OUTPUT_BUFFER_NUM_MAX           4
 
 #define DEFAULT_MFC_INPUT_YBUFFER_SIZE      ALIGN_TO_16B(MAX_FRAME_WIDTH) * ALIGN_TO_16B(MAX_FRAME_HEIGHT)
@@ -67,6 +69,18 @@
 #define OMX_VIDEO_MAX_REF_FRAMES 3
 #define OMX_VIDEO_MAX_LTR_FRAMES 4 /* LTR */
 
+#define ADAPTIVE_ROI_MB_SIZE                16
+#define ADAPTIVE_ROI_QP_OFFSET_MAX          3
+#define ADAPTIVE_ROI_MOTION_THRESHOLD       6  /* MB luma mean change treated as motion */
+
+#define VENC_LOOKAHEAD_DEPTH_MAX            (MFC_INPUT_BUFFER_NUM_MAX - 2)  /* the other codec buffers keep MFC busy */
+#define VENC_LOOKAHEAD_SAMPLE_STEP          8   /* luma is sampled every 8 pixels for the analysis */
+#define VENC_LOOKAHEAD_SCENECUT_THRESHOLD   30  /* mean abs difference of the samples */
+#define VENC_LOOKAHEAD_QP_DELTA             2
+
+/* the lookahead changes the rate control per window, those changes are not worth an essential log */
+#define VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc)     (((pVideoEnc)->lookahead.nActiveDepth > 0)? EXYNOS_LOG_TRACE:EXYNOS_LOG_ESSENTIAL)
+
 #define ENC_BLOCKS_PER_SECOND               979200 /* remove it and have to read a capability at media_codecs.xml */
 
 #define GENERAL_TSVC_ENABLE (1 << 16)
@@ -91,6 +105,53 @@ typedef struct _CODEC_ENC_BUFFER
     int             dataSize;                     /* total data length */
 } CODEC_ENC_BUFFER;
 
+typedef struct _EXYNOS_OMX_VENC_LOOKAHEAD_FRAME
+{
+    EXYNOS_OMX_DATA  data;
+    OMX_PTR          pRoiConfigCMD;     /* adaptive ROI map made for this frame */
+    OMX_BOOL         bAnalyzed;
+    OMX_U32          nCost;
+    OMX_BOOL         bSceneCut;
+} EXYNOS_OMX_VENC_LOOKAHEAD_FRAME;
+
+typedef struct _EXYNOS_OMX_VENC_LOOKAHEAD
+{
+    OMX_U32                          nDepth;            /* requested by the client, 0 : disabled */
+    OMX_U32                          nActiveDepth;      /* decided at the first input */
+    EXYNOS_OMX_VENC_LOOKAHEAD_FRAME  frame[VENC_LOOKAHEAD_DEPTH_MAX];
+    OMX_U32                          nHead;
+    OMX_U32                          nCount;
+
+    /* result of the frame converted last */
+    OMX_BOOL                         bCurAnalyzed;
+    OMX_U32                          nCurCost;
+    OMX_BOOL                         bCurSceneCut;
+
+    OMX_U8                          *pPrevSample;
+    OMX_U32                          nSampleNum;
+    OMX_BOOL                         bPrevSampleValid;
+    OMX_U32                          nAvgTemporal;
+    OMX_U32                          nAvgCost;
+
+    OMX_VIDEO_QPRANGETYPE            baseQpRange;
+    OMX_BOOL                         bBaseQpRange;
+    OMX_S32                          nQpDelta;
+    OMX_U32                          nBitrate;          /* bitrate sent last, 0 : not yet */
+} EXYNOS_OMX_VENC_LOOKAHEAD;
+
+/* LTR marking and loss recovery run by the encoder itself(OMX_IndexConfigVideoLTRPolicy, OMX_IndexConfigVideoLossReport) */
+typedef struct _EXYNOS_OMX_VENC_LTR_CONTROL
+{
+    OMX_U32   nTemporalLayerCount;   /* pending layer change, 0 : none */
+    OMX_U32   nRefreshPeriod;
+    OMX_U32   nFrameCount;           /* frames since the last mark */
+    OMX_U32   nNextIndex;
+    OMX_BOOL  bMarked[OMX_VIDEO_MAX_LTR_FRAMES];
+    OMX_TICKS markedTimeStamp[OMX_VIDEO_MAX_LTR_FRAMES];
+    OMX_BOOL  bLossReported;
+    OMX_TICKS lossTimeStamp;
+} EXYNOS_OMX_VENC_LTR_CONTROL;
+
 typedef struct _EXYNOS_OMX_VIDEOENC_COMPONENT
 {
     OMX_HANDLETYPE hCodecHandle;
@@ -100,6 +161,12 @@ typedef struct _EXYNOS_OMX_VIDEOENC_COMPONENT
     OMX_U32  nPriority;
     CODEC_ENC_BUFFER *pMFCEncInputBuffer[MFC_INPUT_BUFFER_NUM_MAX];
     CODEC_ENC_BUFFER *pMFCEncOutputBuffer[MFC_OUTPUT_BUFFER_NUM_MAX];
+    OMX_U32           nMFCEncInputBufferNum;    /* allocated input codec buffers */
+
+    /* Memory Trimming */
+    OMX_BOOL          bTrimMemory;              /* requested by OMX_IndexConfigTrimMemory */
+    OMX_BOOL          bMemoryPressure;          /* reported by the PSI monitor thread */
+    OMX_HANDLETYPE    hMemPressure;
 
     /* Buffer Process */
     OMX_BOOL       bExitBufferProcessThread;
@@ -128,6 +195,20 @@ typedef struct _EXYNOS_OMX_VIDEOENC_COMPONENT
     EXYNOS_OMX_ROTATION_TYPE eRotationType;
     OMX_MIRRORTYPE           eMirrorType;
 
+    /* content adaptive ROI : per-MB QP offset from luma statistics */
+    OMX_BOOL                 bAdaptiveRoi;
+    OMX_S8                  *pAdaptiveRoiMap;
+    OMX_U8                  *pAdaptiveRoiMean;   /* MB luma means of the previous frame */
+    OMX_U32                  nAdaptiveRoiMBNum;
+    OMX_U32                  nAdaptiveRoiAvgActivity;    /* of the previous frame, 0 : not yet known */
+    OMX_BOOL                 bAdaptiveRoiMeanValid;
+    OMX_PTR                  pAdaptiveRoiCMD;   /* map of the frame converted last, not queued yet */
+    OMX_U8                  *pAnalysisLuma;     /* luma extracted from 32bit RGB input for the analysis */
+    OMX_U32                  nAnalysisLumaSize;
+
+    EXYNOS_OMX_VENC_LOOKAHEAD lookahead;
+    EXYNOS_OMX_VENC_LTR_CONTROL ltrControl;
+
     OMX_BOOL bFirstInput;
     OMX_BOOL bFirstOutput;
     OMX_BOOL bEncDRC;
@@ -166,7 +247,15 @@ void Exynos_UpdateFrameSize(OMX_COMPONENTTYPE *pOMXComponent);
 void Exynos_Input_SetSupportFormat(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
 OMX_COLOR_FORMATTYPE Exynos_Input_GetActualColorFormat(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
 OMX_BOOL Exynos_Check_BufferProcess_State(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex);
+void Exynos_Wait_ProcessPause(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nPortIndex);
 OMX_ERRORTYPE Exynos_CodecBufferToData(CODEC_ENC_BUFFER *codecBuffer, EXYNOS_OMX_DATA *pData, OMX_U32 nPortIndex);
+void Exynos_Lookahead_Reset(EXYNOS_OMX_BASECOMPONENT *pExynosComponent);
+void Exynos_Lookahead_Setup(OMX_COMPONENTTYPE *pOMXComponent);
+void Exynos_Venc_AnalyzeInput(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_COLOR_FORMATTYPE eMFCColorFormat, OMX_U8 *pData, OMX_U32 nStride, OMX_U32 nWidth, OMX_U32 nHeight);
+void Exynos_LTR_SetPolicy(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *pLTRPolicy, OMX_U32 nLTRNum);
+void Exynos_LTR_ReportLoss(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_TICKS nTimeStamp);
+void Exynos_LTR_Run(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, ExynosVideoEncOps *pEncOps, OMX_HANDLETYPE hMFCHandle, OMX_U32 nLTRNum, OMX_TICKS timeStamp);
+OMX_ERRORTYPE Exynos_OMX_SrcInputSubmit(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData);
 OMX_ERRORTYPE Exynos_OMX_SrcInputBufferProcess(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_SrcOutputBufferProcess(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OMX_DstInputBufferProcess(OMX_HANDLETYPE hComponent);
@@ -175,6 +264,9 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentInit(OMX_IN OMX_HANDLETYPE hCompone
 OMX_ERRORTYPE Exynos_OMX_VideoEncodeComponentDeinit(OMX_IN OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_Allocate_CodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex, int nBufferCnt, unsigned int nAllocLen[MAX_BUFFER_PLANE]);
 void Exynos_Free_CodecBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex);
+void Exynos_EnQueue_CodecInputBuffers(OMX_COMPONENTTYPE *pOMXComponent);
+CODEC_ENC_BUFFER *Exynos_Find_CodecInputBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_PTR pVirAddr);
+void Exynos_Set_CodecReadyFd(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, ExynosVideoEncBufferOps *pInbufOps, ExynosVideoEncBufferOps *pOutbufOps, OMX_HANDLETYPE hMFCHandle);
 OMX_ERRORTYPE Exynos_ResetAllPortConfig(OMX_COMPONENTTYPE *pOMXComponent);
 
 #ifdef __cplusplus
@@ -36,6 +36,7 @@
 #include "Exynos_OMX_Basecomponent.h"
 #include "Exynos_OSAL_Thread.h"
 #include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_WorkerPool.h"
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_ETC.h"
 #include "Exynos_OSAL_SharedMemory.h"
@@ -57,11 +58,12 @@ OMX_ERRORTYPE Exynos_OMX_UseBuffer(
     OMX_IN OMX_U8                   *pBuffer)
 {
     OMX_ERRORTYPE             ret               = OMX_ErrorNone;
-    OMX_COMPONENTTYPE        *pOMXComponent     = NULL;
-    EXYNOS_OMX_BASECOMPONENT *pExynosComponent  = NULL;
-    EXYNOS_OMX_BASEPORT      *pExynosPort       = NULL;
-    OMX_BUFFERHEADERTYPE     *pTempBufferHdr    = NULL;
-    OMX_U32                   i                 = 0;
+    OMX_COMPONENTTYPE             *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent  = NULL;
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc         = NULL;
+    EXYNOS_OMX_BASEPORT           *pExynosPort       = NULL;
+    OMX_BUFFERHEADERTYPE          *pTempBufferHdr    = NULL;
+    OMX_U32                        i                 = 0;
 
     FunctionIn();
 
@@ -89,7 +91,9 @@ OMX_ERRORTYPE Exynos_OMX_UseBuffer(
     }
     pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
 
-    if (pExynosPort->portState != EXYNOS_OMX_PortStateEnabling) {
+    /* a tunneled port gets its buffers whenever the supplier is ready */
+    if ((pExynosPort->portState != EXYNOS_OMX_PortStateEnabling) &&
+        !CHECK_PORT_TUNNELED(pExynosPort)) {
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] %s port : invalid state : comp state(0x%x), port state(0x%x), enabled(0x%x)",
                         pExynosComponent, __FUNCTION__,
                         (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
@@ -104,6 +108,37 @@ OMX_ERRORTYPE Exynos_OMX_UseBuffer(
         goto EXIT;
     }
 
+    /* MFC writes the stream straight into client buffers it can map,
+     * memory it doesn't know about gets the stream through a codec buffer copy.
+     * the mode is picked while loaded, MFC output is set up on the first frame
+     */
+    if ((nPortIndex == OUTPUT_PORT_INDEX) &&
+        (pExynosPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        (pExynosComponent->codecType != HW_VIDEO_ENC_SECURE_CODEC) &&
+        (pExynosComponent->hComponentHandle != NULL)) {
+        pVideoEnc = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+        if (Exynos_OSAL_SharedMemory_VirtToION(pVideoEnc->hSharedMemory, pBuffer) == 0) {
+            if (pExynosComponent->currentState != OMX_StateLoaded) {
+                if (pExynosPort->bufferProcessType & BUFFER_SHARE) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] output buffer(%p) is not ION memory, can't be copied after loaded",
+                                                        pExynosComponent, __FUNCTION__, pBuffer);
+                    ret = OMX_ErrorBadParameter;
+                    goto EXIT;
+                }
+            } else if (pExynosPort->bufferProcessType & BUFFER_SHARE) {
+                Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] output buffer(%p) is not ION memory, stream will be copied",
+                                                    pExynosComponent, __FUNCTION__, pBuffer);
+                /* codec init may already be done, it runs next to the buffer population */
+                ret = Exynos_CodecBufferCreate(pExynosComponent, nPortIndex);
+                if (ret != OMX_ErrorNone)
+                    goto EXIT;
+
+                pExynosPort->bufferProcessType = BUFFER_COPY;
+            }
+        }
+    }
+
     pTempBufferHdr = (OMX_BUFFERHEADERTYPE *)Exynos_OSAL_Malloc(sizeof(OMX_BUFFERHEADERTYPE));
     if (pTempBufferHdr == NULL) {
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to malloc", pExynosComponent, __FUNCTION__);
@@ -410,9 +445,11 @@ OMX_ERRORTYPE Exynos_OMX_FreeBuffer(
         goto EXIT;
     }
 
+    /* and the supplier takes them back on its own schedule */
     if ((pExynosPort->portState != EXYNOS_OMX_PortStateDisabling) &&
         (pExynosPort->portState != EXYNOS_OMX_PortStateFlushingForDisable) &&
-        (pExynosPort->portState != EXYNOS_OMX_PortStateInvalid)) {
+        (pExynosPort->portState != EXYNOS_OMX_PortStateInvalid) &&
+        !CHECK_PORT_TUNNELED(pExynosPort)) {
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] %s port : invalid state : comp state(0x%x), port state(0x%x), enabled(0x%x)",
                         pExynosComponent, __FUNCTION__,
                         (nPortIndex == INPUT_PORT_INDEX)? "input":"output",
@@ -513,33 +550,39 @@ EXIT:
 }
 
 #ifdef TUNNELING_SUPPORT
+/* the input port never supplies, the buffers belong to the peer */
 OMX_ERRORTYPE Exynos_OMX_AllocateTunnelBuffer(
-    EXYNOS_OMX_BASEPORT     *pOMXBasePort,
-    OMX_U32                  nPortIndex)
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex)
 {
-    OMX_ERRORTYPE                 ret               = OMX_ErrorNone;
-    EXYNOS_OMX_BASEPORT          *pExynosPort       = NULL;
-    OMX_BUFFERHEADERTYPE         *pTempBufferHdr    = NULL;
-    OMX_U8                       *pTempBuffer       = NULL;
-    OMX_U32                       nBufferSize       = 0;
-    OMX_PARAM_PORTDEFINITIONTYPE  portDefinition;
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    if (pOMXComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (nPortIndex != INPUT_PORT_INDEX)
+        ret = OMX_ErrorBadPortIndex;
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
     return ret;
 }
 
 OMX_ERRORTYPE Exynos_OMX_FreeTunnelBuffer(
-    EXYNOS_OMX_BASEPORT     *pOMXBasePort,
-    OMX_U32                  nPortIndex)
+    OMX_COMPONENTTYPE   *pOMXComponent,
+    OMX_U32              nPortIndex)
 {
-    OMX_ERRORTYPE            ret            = OMX_ErrorNone;
-    EXYNOS_OMX_BASEPORT     *pExynosPort    = NULL;
-    OMX_BUFFERHEADERTYPE    *pTempBufferHdr = NULL;
-    OMX_U8                  *pTempBuffer    = NULL;
-    OMX_U32                  nBufferSize    = 0;
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    if (pOMXComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (nPortIndex != INPUT_PORT_INDEX)
+        ret = OMX_ErrorBadPortIndex;
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
     return ret;
 }
@@ -551,10 +594,136 @@ OMX_ERRORTYPE Exynos_OMX_ComponentTunnelRequest(
     OMX_IN OMX_U32        nTunneledPort,
     OMX_INOUT OMX_TUNNELSETUPTYPE *pTunnelSetup)
 {
-    OMX_ERRORTYPE ret = OMX_ErrorNone;
+    OMX_ERRORTYPE                 ret               = OMX_ErrorNone;
+    OMX_COMPONENTTYPE            *pOMXComponent     = NULL;
+    EXYNOS_OMX_BASECOMPONENT     *pExynosComponent  = NULL;
+    EXYNOS_OMX_BASEPORT          *pExynosPort       = NULL;
+    OMX_PARAM_PORTDEFINITIONTYPE *pPortDef          = NULL;
+    OMX_PARAM_PORTDEFINITIONTYPE  peerPortDef;
+    OMX_U32                       nBufferCount      = 0;
+    OMX_U32                       i                 = 0;
+
+    FunctionIn();
+
+    if (hComp == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pOMXComponent = (OMX_COMPONENTTYPE *)hComp;
+
+    ret = Exynos_OMX_Check_SizeVersion(pOMXComponent, sizeof(OMX_COMPONENTTYPE));
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    if (pOMXComponent->pComponentPrivate == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    if (nPort >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &pExynosComponent->pExynosPort[nPort];
+    pPortDef    = &pExynosPort->portDefinition;
+
+    if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+        CHECK_PORT_ENABLED(pExynosPort)) {
+        ret = OMX_ErrorIncorrectStateOperation;
+        goto EXIT;
+    }
+
+    if (hTunneledComp == NULL) {
+        /* tear down */
+        if (pExynosPort->tunnelFlags & EXYNOS_TUNNEL_SHARE_BUFFER) {
+            pExynosPort->bufferProcessType = BUFFER_COPY;
+            pExynosPort->ePlaneType        = PLANE_MULTIPLE;
+        }
+
+        pExynosPort->tunneledComponent = NULL;
+        pExynosPort->tunneledPort      = 0;
+        pExynosPort->tunnelFlags       = 0;
+        pExynosPort->tunnelBufferNum   = 0;
+        goto EXIT;
+    }
+
+    /* the stream always goes back to the client */
+    if (nPort != INPUT_PORT_INDEX) {
+        ret = OMX_ErrorTunnelingUnsupported;
+        goto EXIT;
+    }
+
+    if (pTunnelSetup == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (pExynosPort->eMetaDataType != METADATA_TYPE_DISABLED) {
+        ret = OMX_ErrorPortsNotCompatible;
+        goto EXIT;
+    }
+
+    ret = Exynos_OMX_TunnelCheckPeer(hTunneledComp, nTunneledPort, OMX_DirOutput, &peerPortDef);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    /* frames are encoded as they come, there is no conversion on the way */
+    if (pExynosPort->supportFormat != NULL) {
+        for (i = 0; pExynosPort->supportFormat[i] != OMX_COLOR_FormatUnused; i++) {
+            if (pExynosPort->supportFormat[i] == peerPortDef.format.video.eColorFormat)
+                break;
+        }
+
+        if (pExynosPort->supportFormat[i] == OMX_COLOR_FormatUnused) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] unsupported color format(0x%x) from peer", pExynosComponent, __FUNCTION__,
+                                                peerPortDef.format.video.eColorFormat);
+            ret = OMX_ErrorPortsNotCompatible;
+            goto EXIT;
+        }
+    }
+
+    /* the same depth on both ends, so neither side runs ahead of the other */
+    nBufferCount = (pPortDef->nBufferCountActual > peerPortDef.nBufferCountActual)?
+                        pPortDef->nBufferCountActual:peerPortDef.nBufferCountActual;
+    if (nBufferCount > MAX_BUFFER_NUM) {
+        ret = OMX_ErrorPortsNotCompatible;
+        goto EXIT;
+    }
+
+    if (peerPortDef.nBufferCountActual != nBufferCount) {
+        peerPortDef.nBufferCountActual = nBufferCount;
+        ret = OMX_SetParameter(hTunneledComp, OMX_IndexParamPortDefinition, &peerPortDef);
+        if (ret != OMX_ErrorNone)
+            goto EXIT;
+    }
+
+    pPortDef->nBufferCountActual        = nBufferCount;
+    pPortDef->format.video.nFrameWidth  = peerPortDef.format.video.nFrameWidth;
+    pPortDef->format.video.nFrameHeight = peerPortDef.format.video.nFrameHeight;
+    pPortDef->format.video.nStride      = peerPortDef.format.video.nStride;
+    pPortDef->format.video.nSliceHeight = peerPortDef.format.video.nSliceHeight;
+    pPortDef->format.video.eColorFormat = peerPortDef.format.video.eColorFormat;
+
+    pExynosPort->tunneledComponent = hTunneledComp;
+    pExynosPort->tunneledPort      = nTunneledPort;
+    pExynosPort->tunnelFlags       = EXYNOS_TUNNEL_ESTABLISHED;
+    pExynosPort->bufferSupplier    = OMX_BufferSupplyOutput;
+
+    /* a frame the decoder MFC wrote in place is NV12 in one fd, it is read the same way */
+    if (pExynosPort->ePlaneType == PLANE_MULTIPLE) {
+        pExynosPort->ePlaneType   = PLANE_SINGLE;
+        pExynosPort->tunnelFlags |= EXYNOS_TUNNEL_SHARE_BUFFER;
+    }
+
+    pTunnelSetup->eSupplier = OMX_BufferSupplyOutput;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%p][%s] input port tunneled from peer(%p) port(%d), %d buffers", pExynosComponent, __FUNCTION__,
+                                        hTunneledComp, nTunneledPort, nBufferCount);
 
-    ret = OMX_ErrorTunnelingUnsupported;
 EXIT:
+    FunctionOut();
+
     return ret;
 }
 #endif
@@ -587,7 +756,6 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(
     OMX_BUFFERHEADERTYPE     *pBufferHdr        = NULL;
     EXYNOS_OMX_DATABUFFER    *pDataBuffer[2]    = {NULL, NULL};
     EXYNOS_OMX_MESSAGE       *pMessage          = NULL;
-    OMX_S32                   nSemaCnt          = 0;
     int                       i                 = 0;
 
     FunctionIn();
@@ -611,15 +779,11 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(
     }
     pExynosPort = &pExynosComponent->pExynosPort[nPortIndex];
 
-    while (Exynos_OSAL_GetElemNum(&pExynosPort->bufferQ) > 0) {
-        Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &nSemaCnt);
-        if (nSemaCnt == 0)
-            Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
-
-        Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
-        pMessage = (EXYNOS_OMX_MESSAGE *)Exynos_OSAL_Dequeue(&pExynosPort->bufferQ);
-        if ((pMessage != NULL) &&
-            (pMessage->type != EXYNOS_OMX_CommandFakeBuffer)) {
+    /* the buffer process thread is already parked on bufferMutex,
+     * so the queue can be drained directly and the tokens are dropped at the end.
+     */
+    while ((pMessage = (EXYNOS_OMX_MESSAGE *)Exynos_OSAL_Dequeue(&pExynosPort->bufferQ)) != NULL) {
+        if (pMessage->type != EXYNOS_OMX_CommandFakeBuffer) {
             pBufferHdr = (OMX_BUFFERHEADERTYPE *)pMessage->pCmdData;
             pBufferHdr->nFilledLen = 0;
 
@@ -633,6 +797,10 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(
         pMessage = NULL;
     }
 
+    /* frames held by the lookahead are dropped with the rest of the input */
+    if (nPortIndex == INPUT_PORT_INDEX)
+        Exynos_Lookahead_Reset(pExynosComponent);
+
     Exynos_OMX_GetFlushBuffer(pExynosPort, pDataBuffer);
     if ((pDataBuffer[0] != NULL) &&
         (pDataBuffer[0]->dataValid == OMX_TRUE)) {
@@ -679,17 +847,8 @@ OMX_ERRORTYPE Exynos_OMX_FlushPort(
     }
 
     if (pExynosPort->bufferSemID != NULL) {
-        while (1) {
-            OMX_S32 cnt = 0;
-            Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
-            if (cnt == 0)
-                break;
-            else if (cnt > 0)
-                Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
-            else if (cnt < 0)
-                Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
-            Exynos_OSAL_SleepMillisec(0);
-        }
+        while (Exynos_OSAL_SemaphoreTryWait(pExynosPort->bufferSemID) == OMX_ErrorNone)
+            continue;
     }
     Exynos_OSAL_ResetQueue(&pExynosPort->bufferQ);
 
@@ -709,6 +868,7 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = NULL;
     EXYNOS_OMX_BASEPORT             *pExynosPort        = NULL;
     EXYNOS_OMX_DATABUFFER           *pDataBuffer[2]     = {NULL, NULL};
+    OMX_U64                          nStepTime          = 0;
 
     FunctionIn();
 
@@ -744,7 +904,9 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] OMX_CommandFlush start, port:%d, event:%d",
                                     pExynosComponent, __FUNCTION__, nPortIndex, bEvent);
 
-    Exynos_OSAL_SignalSet(pExynosPort->pauseEvent);
+    Exynos_OMX_ResetFlushStepTime(pExynosPort, &nStepTime);
+
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
 
     Exynos_OMX_GetFlushBuffer(pExynosPort, pDataBuffer);
     if (pDataBuffer[0] == NULL) {
@@ -756,21 +918,24 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
         Exynos_OSAL_SemaphorePost(pExynosPort->codecSemID);
 
     if (pExynosPort->bufferSemID != NULL) {
-        while (1) {
-            OMX_S32 cnt = 0;
+        OMX_S32 cnt = 0;
+
+        /* a waiter can take the token right away, keep posting until one remains */
+        Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
+        while (cnt <= 0) {
+            Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
             Exynos_OSAL_Get_SemaphoreCount(pExynosPort->bufferSemID, &cnt);
-            if (cnt > 0)
-                break;
-            else
-                Exynos_OSAL_SemaphorePost(pExynosPort->bufferSemID);
-            Exynos_OSAL_SleepMillisec(0);
         }
     }
 
     pVideoEnc->exynos_codec_bufferProcessRun(pOMXComponent, nPortIndex);
 
     Exynos_OSAL_MutexLock(pDataBuffer[0]->bufferMutex);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_WAKEUP, &nStepTime);
+
     pVideoEnc->exynos_codec_stop(pOMXComponent, nPortIndex);
+    EXYNOS_OMX_METRIC_SET(pExynosComponent->metrics.nHeldByCodec[nPortIndex], 0);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_STOP, &nStepTime);
 
     if (pDataBuffer[1] != NULL)
         Exynos_OSAL_MutexLock(pDataBuffer[1]->bufferMutex);
@@ -778,9 +943,11 @@ OMX_ERRORTYPE Exynos_OMX_BufferFlush(
     ret = Exynos_OMX_FlushPort(pOMXComponent, nPortIndex);
     if (ret != OMX_ErrorNone)
         goto EXIT;
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_DRAIN, &nStepTime);
 
     if (pExynosPort->bufferProcessType & BUFFER_COPY)
         pVideoEnc->exynos_codec_enqueueAllBuffer(pOMXComponent, nPortIndex);
+    Exynos_OMX_SetFlushStepTime(pExynosPort, FLUSH_STEP_REQUEUE, &nStepTime);
 
     Exynos_ResetCodecData(&pExynosPort->processData);
 
@@ -904,7 +1071,11 @@ OMX_ERRORTYPE Exynos_InputBufferGetQueue(
                (!CHECK_PORT_BEING_FLUSHED(pExynosPort))) {
         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> wait(bufferSemID)",
                                                     pExynosComponent, __FUNCTION__);
-        Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
+        if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->bufferSemID) != OMX_ErrorNone) {
+            /* parked on the worker pool, the step is kicked again when a buffer is queued */
+            ret = OMX_ErrorNotReady;
+            goto EXIT;
+        }
         Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] input port -> post(bufferSemID)",
                                                     pExynosComponent, __FUNCTION__);
 
@@ -1046,7 +1217,11 @@ OMX_ERRORTYPE Exynos_OutputBufferGetQueue(
                (!CHECK_PORT_BEING_FLUSHED(pExynosPort))) {
        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> wait(bufferSemID)",
                                                 pExynosComponent, __FUNCTION__);
-        Exynos_OSAL_SemaphoreWait(pExynosPort->bufferSemID);
+        if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->bufferSemID) != OMX_ErrorNone) {
+            /* parked on the worker pool, the step is kicked again when a buffer is queued */
+            ret = OMX_ErrorNotReady;
+            goto EXIT;
+        }
        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] output port -> post(bufferSemID)",
                                                 pExynosComponent, __FUNCTION__);
         if (pDataBuffer->dataValid != OMX_TRUE) {
@@ -1135,6 +1310,53 @@ EXIT:
     return pBufferHdr;
 }
 
+OMX_ERRORTYPE Exynos_CodecBufferCreate(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    OMX_U32                      nPortIndex)
+{
+    OMX_ERRORTYPE          ret         = OMX_ErrorNone;
+    EXYNOS_OMX_BASEPORT   *pExynosPort = NULL;
+
+    FunctionIn();
+
+    if (pExynosComponent == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (nPortIndex >= pExynosComponent->portParam.nPorts) {
+        ret = OMX_ErrorBadPortIndex;
+        goto EXIT;
+    }
+    pExynosPort = &(pExynosComponent->pExynosPort[nPortIndex]);
+
+    /* the codec init and UseBuffer may both get here */
+    Exynos_OSAL_MutexLock(pExynosComponent->compMutex);
+
+    if (pExynosPort->codecSemID == NULL) {
+        ret = Exynos_OSAL_SemaphoreCreate(&pExynosPort->codecSemID);
+        if (ret == OMX_ErrorNone) {
+            ret = Exynos_OSAL_QueueCreate(&pExynosPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+            if (ret != OMX_ErrorNone) {
+                Exynos_OSAL_SemaphoreTerminate(pExynosPort->codecSemID);
+                pExynosPort->codecSemID = NULL;
+            }
+        }
+    }
+
+    Exynos_OSAL_MutexUnlock(pExynosComponent->compMutex);
+
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to create codec buffer queue (0x%x)", pExynosComponent, __FUNCTION__, ret);
+        ret = OMX_ErrorInsufficientResources;
+    }
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
 OMX_ERRORTYPE Exynos_CodecBufferEnqueue(
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
     OMX_U32                      nPortIndex,
@@ -1167,6 +1389,7 @@ OMX_ERRORTYPE Exynos_CodecBufferEnqueue(
         goto EXIT;
     }
     Exynos_OSAL_SemaphorePost(pExynosPort->codecSemID);
+    Exynos_OMX_WakeBufferProcess(pExynosComponent, nPortIndex);
 
     ret = OMX_ErrorNone;
 
@@ -1201,7 +1424,12 @@ OMX_ERRORTYPE Exynos_CodecBufferDequeue(
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> wait(codecSemID)",
                                             pExynosComponent, __FUNCTION__,
                                             (nPortIndex == INPUT_PORT_INDEX)? "input":"output");
-    Exynos_OSAL_SemaphoreWait(pExynosPort->codecSemID);
+    if (Exynos_OSAL_WorkerSemaphoreWait(pExynosPort->codecSemID) != OMX_ErrorNone) {
+        /* parked on the worker pool, Exynos_CodecBufferEnqueue() kicks it again */
+        *pData = NULL;
+        ret = OMX_ErrorNotReady;
+        goto EXIT;
+    }
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s port -> post(codecSemID)",
                                             pExynosComponent, __FUNCTION__,
                                             (nPortIndex == INPUT_PORT_INDEX)? "input":"output");
@@ -1523,6 +1751,24 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeGetParameter(
         pDisableDFR->bEnabled = pVideoEnc->bDisableDFR;
     }
         break;
+    case OMX_IndexParamVideoLookahead:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD *pLookahead = (EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLookahead, sizeof(EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLookahead->nPortIndex != INPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        pLookahead->nDepth = pVideoEnc->lookahead.nDepth;
+    }
+        break;
 #ifdef USE_ANDROID
     case OMX_IndexParamConsumerUsageBits:
     {
@@ -1876,6 +2122,31 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeSetParameter(
         pVideoEnc->bDisableDFR = pDisableDFR->bEnabled;
     }
         break;
+    case OMX_IndexParamVideoLookahead:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD *pLookahead = (EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLookahead, sizeof(EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLookahead->nPortIndex != INPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+            (pExynosComponent->currentState != OMX_StateWaitForResources)) {
+            ret = OMX_ErrorIncorrectStateOperation;
+            goto EXIT;
+        }
+
+        /* the depth actually used is bounded by VENC_LOOKAHEAD_DEPTH_MAX at the first input */
+        pVideoEnc->lookahead.nDepth = pLookahead->nDepth;
+    }
+        break;
     default:
     {
         ret = Exynos_OMX_SetParameter(hComponent, nParamIndex, pComponentParameterStructure);
@@ -1976,6 +2247,30 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeGetConfig(
         pBufferInfo->fd = Exynos_OSAL_SharedMemory_VirtToION(pVideoEnc->hSharedMemory, pBufferInfo->pVirAddr);
     }
         break;
+    case OMX_IndexConfigVideoPipelineMetrics:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *pMetrics = (EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_GetConfig(hComponent, nParamIndex, pComponentConfigStructure);
+        if (ret != OMX_ErrorNone)
+            goto EXIT;
+
+        pMetrics->nIonKB = (OMX_U32)(Exynos_OSAL_SharedMemory_GetAllocBytes(pVideoEnc->hSharedMemory) >> 10);
+    }
+        break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pConfigTrimMemory = (OMX_CONFIG_BOOLEANTYPE *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pConfigTrimMemory, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        pConfigTrimMemory->bEnabled = pVideoEnc->bTrimMemory;
+    }
+        break;
     case OMX_IndexConfigCommonInputCrop:
     {
         OMX_CONFIG_RECTTYPE *pDstRectType = (OMX_CONFIG_RECTTYPE *)pComponentConfigStructure;
@@ -2247,6 +2542,24 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeSetConfig(
         ret = (OMX_ERRORTYPE)OMX_ErrorNoneExpiration;
     }
         break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE *pConfigTrimMemory = (OMX_CONFIG_BOOLEANTYPE *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pConfigTrimMemory, sizeof(OMX_CONFIG_BOOLEANTYPE));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        /* applied when the input codec buffers are allocated next */
+        pVideoEnc->bTrimMemory = pConfigTrimMemory->bEnabled;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] trim memory : %d", pExynosComponent, __FUNCTION__, pVideoEnc->bTrimMemory);
+
+        ret = OMX_ErrorNone;
+    }
+        break;
     case OMX_IndexConfigCommonInputCrop:
     {
         OMX_CONFIG_RECTTYPE *pSrcRectType = (OMX_CONFIG_RECTTYPE *)pComponentConfigStructure;
@@ -2444,6 +2757,14 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeSetConfig(
     }
         break;
 #endif
+    case OMX_IndexConfigBufferBatch:
+    {
+        /* buffers are queued right away, this is not a dynamic config */
+        ret = Exynos_OMX_SetConfig(hComponent, nParamIndex, pComponentConfigStructure);
+        if (ret == OMX_ErrorNone)
+            ret = (OMX_ERRORTYPE)OMX_ErrorNoneExpiration;
+    }
+        break;
     default:
     {
         ret = Exynos_OMX_SetConfig(hComponent, nParamIndex, pComponentConfigStructure);
@@ -2541,6 +2862,18 @@ OMX_ERRORTYPE Exynos_OMX_VideoEncodeGetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(szParamName, EXYNOS_INDEX_CONFIG_TRIM_MEMORY) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigTrimMemory;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    if (Exynos_OSAL_Strcmp(szParamName, EXYNOS_INDEX_PARAM_VIDEO_LOOKAHEAD) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexParamVideoLookahead;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
 #ifdef USE_ANDROID
     if (Exynos_OSAL_Strcmp(szParamName, EXYNOS_INDEX_PARAM_STORE_METADATA_BUFFER) == 0) {
         *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamStoreMetaDataBuffer;
@@ -2598,6 +2931,11 @@ OMX_ERRORTYPE Exynos_Shared_BufferToData(
 
     if (pExynosPort->eMetaDataType == METADATA_TYPE_DISABLED) {
         pData->buffer.addr[0] = pUseBuffer->bufferHeader->pBuffer;
+#ifdef TUNNELING_SUPPORT
+        if (CHECK_PORT_TUNNELED(pExynosPort) &&
+            (pUseBuffer->bufferHeader->pOutputPortPrivate != NULL))
+            pData->buffer.fd[0] = ((EXYNOS_OMX_TUNNEL_BUFFER *)pUseBuffer->bufferHeader->pOutputPortPrivate)->fd;
+#endif
     } else {
         /* metadata type */
         EXYNOS_OMX_MULTIPLANE_BUFFER bufferInfo;
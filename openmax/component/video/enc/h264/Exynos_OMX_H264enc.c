@@ -575,7 +575,8 @@ static void Set_H264Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
 
     pH264Param->LTRFrames = pMFCH264Handle->nLTRFrames;
 
-    pH264Param->ROIEnable = (pMFCH264Handle->bRoiInfo == OMX_TRUE)? 1:0;
+    pH264Param->ROIEnable = ((pMFCH264Handle->bRoiInfo == OMX_TRUE) ||
+                             (pVideoEnc->bAdaptiveRoi == OMX_TRUE))? 1:0;
 
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] eControlRate: 0x%x", pExynosComponent, __FUNCTION__, pVideoEnc->eControlRate[OUTPUT_PORT_INDEX]);
     /* rate control related parameters */
@@ -679,7 +680,7 @@ static OMX_ERRORTYPE Change_H264Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosCompo
         if (pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] != OMX_Video_ControlRateDisable) {
             nValue = pConfigBitrate->nEncodeBitrate;
             pEncOps->Set_BitRate(pH264Enc->hMFCH264Handle.hMFCHandle, nValue);
-            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
+            Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
         }
     }
         break;
@@ -709,7 +710,7 @@ static OMX_ERRORTYPE Change_H264Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosCompo
 
         pEncOps->Set_QpRange(pMFCH264Handle->hMFCHandle, qpRange);
 
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] qp range: I(%d, %d), P(%d, %d), B(%d, %d)",
+        Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] qp range: I(%d, %d), P(%d, %d), B(%d, %d)",
                                     pExynosComponent, __FUNCTION__,
                                     qpRange.QpMin_I, qpRange.QpMax_I,
                                     qpRange.QpMin_P, qpRange.QpMax_P,
@@ -811,6 +812,20 @@ static OMX_ERRORTYPE Change_H264Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosCompo
         pEncOps->Set_IFrameRatio(pMFCH264Handle->hMFCHandle, pIFrameRatio->nU32);
     }
         break;
+    case OMX_IndexConfigVideoLTRPolicy:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *pLTRPolicy = (EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *)pConfigData;
+
+        Exynos_LTR_SetPolicy(pExynosComponent, pLTRPolicy, pMFCH264Handle->nLTRFrames);
+    }
+        break;
+    case OMX_IndexConfigVideoLossReport:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *pLossReport = (EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *)pConfigData;
+
+        Exynos_LTR_ReportLoss(pExynosComponent, pLossReport->nTimeStamp);
+    }
+        break;
     case OMX_IndexConfigCommonOutputSize:
     {
         OMX_FRAMESIZETYPE   *pFrameSize     = (OMX_FRAMESIZETYPE *)pConfigData;
@@ -890,6 +905,42 @@ EXIT:
     return ret;
 }
 
+static void H264Enc_RunLTRControl(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_TICKS                 timeStamp)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc      = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_H264ENC_HANDLE         *pH264Enc       = (EXYNOS_H264ENC_HANDLE *)pVideoEnc->hCodecHandle;
+    EXYNOS_MFC_H264ENC_HANDLE     *pMFCH264Handle = &pH264Enc->hMFCH264Handle;
+    EXYNOS_OMX_VENC_LTR_CONTROL   *pLTRControl    = &pVideoEnc->ltrControl;
+    ExynosVideoEncOps             *pEncOps        = pMFCH264Handle->pEncOps;
+
+    int i;
+
+    FunctionIn();
+
+    if (pLTRControl->nTemporalLayerCount > 0) {
+        TemporalLayerShareBuffer TemporalSVC;
+
+        Exynos_OSAL_Memset(&TemporalSVC, 0, sizeof(TemporalLayerShareBuffer));
+        TemporalSVC.nTemporalLayerCount = pLTRControl->nTemporalLayerCount;
+        for (i = 0; i < OMX_VIDEO_MAX_AVC_TEMPORAL_LAYERS; i++)
+            TemporalSVC.nTemporalLayerBitrateRatio[i] = pH264Enc->nTemporalLayerBitrateRatio[i];
+
+        if (pEncOps->Set_LayerChange(pMFCH264Handle->hMFCHandle, TemporalSVC) != VIDEO_ERROR_NONE)
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] Not supported control: Set_LayerChange", pExynosComponent, __FUNCTION__);
+
+        pH264Enc->nTemporalLayerCount    = pLTRControl->nTemporalLayerCount;
+        pLTRControl->nTemporalLayerCount = 0;
+    }
+
+    Exynos_LTR_Run(pExynosComponent, pEncOps, pMFCH264Handle->hMFCHandle, pMFCH264Handle->nLTRFrames, timeStamp);
+
+    FunctionOut();
+
+    return;
+}
+
 OMX_ERRORTYPE GetCodecOutputPrivateData(
     OMX_PTR  pCodecBuffer,
     OMX_PTR *pVirtAddr,
@@ -1302,16 +1353,7 @@ OMX_ERRORTYPE H264CodecEnqueueAllBuffer(
 
     if ((nPortIndex == INPUT_PORT_INDEX) &&
         (pH264Enc->bSourceStart == OMX_TRUE)) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)  {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x), size(%d)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoEnc->pMFCEncInputBuffer[i]->fd[0], pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0],
-                                                pVideoEnc->pMFCEncInputBuffer[i]->bufferSize[0]);
-
-            Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1639,8 +1681,10 @@ OMX_ERRORTYPE H264CodecSrcSetup(
         goto EXIT;
     }
 
+    /* frames of the tunnel peer are given by the fd at every SrcIn */
     if ((pInputPort->bufferProcessType & BUFFER_SHARE) &&
-        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED)) {
+        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        !CHECK_PORT_TUNNELED(pInputPort)) {
         /* data buffer */
         ret = OMX_ErrorNotImplemented;
         goto EXIT;
@@ -2013,6 +2057,24 @@ OMX_ERRORTYPE Exynos_H264Enc_GetParameter(
         pDstEnableRoiInfo->bEnableRoiInfo = pH264Enc->hMFCH264Handle.bRoiInfo;
     }
         break;
+    case OMX_IndexParamVideoEnableAdaptiveRoi:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *pDstAdaptiveRoi = (EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pDstAdaptiveRoi, sizeof(EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pDstAdaptiveRoi->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        pDstAdaptiveRoi->bEnableRoiInfo = pVideoEnc->bAdaptiveRoi;
+    }
+        break;
     case OMX_IndexParamVideoEnablePVC:
     {
         OMX_PARAM_U32TYPE *pEnablePVC = (OMX_PARAM_U32TYPE *)pComponentParameterStructure;
@@ -2506,6 +2568,31 @@ OMX_ERRORTYPE Exynos_H264Enc_SetParameter(
         pH264Enc->hMFCH264Handle.bRoiInfo = pSrcEnableRoiInfo->bEnableRoiInfo;
     }
         break;
+    case OMX_IndexParamVideoEnableAdaptiveRoi:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *pSrcAdaptiveRoi = (EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pSrcAdaptiveRoi, sizeof(EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pSrcAdaptiveRoi->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        if ((pH264Enc->hMFCH264Handle.videoInstInfo.supportInfo.enc.bRoiInfoSupport == VIDEO_FALSE) &&
+            (pSrcAdaptiveRoi->bEnableRoiInfo == OMX_TRUE)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] adaptive ROI needs Roi Info that is not supported", pExynosComponent, __FUNCTION__);
+            ret = OMX_ErrorUndefined;
+            goto EXIT;
+        }
+
+        pVideoEnc->bAdaptiveRoi = pSrcAdaptiveRoi->bEnableRoiInfo;
+    }
+        break;
     case OMX_IndexParamPortDefinition:
     {
         OMX_PARAM_PORTDEFINITIONTYPE    *pPortDef       = (OMX_PARAM_PORTDEFINITIONTYPE *)pComponentParameterStructure;
@@ -3001,6 +3088,62 @@ OMX_ERRORTYPE Exynos_H264Enc_SetConfig(
         }
     }
         break;
+    case OMX_IndexConfigVideoLTRPolicy:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *pLTRPolicy = (EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLTRPolicy, sizeof(EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLTRPolicy->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        if ((pLTRPolicy->nTemporalLayerCount > 0) &&
+            ((pH264Enc->hMFCH264Handle.bTemporalSVC == OMX_FALSE) ||
+             (pLTRPolicy->nTemporalLayerCount > pH264Enc->nMaxTemporalLayerCount))) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] layer count(%d) is invalid(MAX(%d))",
+                                                pExynosComponent, __FUNCTION__,
+                                                pLTRPolicy->nTemporalLayerCount, pH264Enc->nMaxTemporalLayerCount);
+            ret = OMX_ErrorBadParameter;
+            goto EXIT;
+        }
+
+        if (pLTRPolicy->nLTRRefreshPeriod > 0) {
+            if (pH264Enc->hMFCH264Handle.nLTRFrames == 0) {
+                /* LTR slots are reserved at codec init only */
+                if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+                    (pExynosComponent->currentState != OMX_StateIdle)) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] LTR is not enabled", pExynosComponent, __FUNCTION__);
+                    ret = OMX_ErrorIncorrectStateOperation;
+                    goto EXIT;
+                }
+
+                pH264Enc->hMFCH264Handle.nLTRFrames = OMX_VIDEO_MAX_LTR_FRAMES;
+            }
+        }
+    }
+        break;
+    case OMX_IndexConfigVideoLossReport:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *pLossReport = (EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLossReport, sizeof(EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLossReport->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+    }
+        break;
 #ifdef USE_ANDROID
     case OMX_IndexConfigAndroidVideoTemporalLayering:
     {
@@ -3158,6 +3301,12 @@ OMX_ERRORTYPE Exynos_H264Enc_GetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_VIDEO_ENABLE_ADAPTIVE_ROI) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamVideoEnableAdaptiveRoi;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
     if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_ENABLE_PVC) == 0) {
         *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamVideoEnablePVC;
         ret = OMX_ErrorNone;
@@ -3170,6 +3319,18 @@ OMX_ERRORTYPE Exynos_H264Enc_GetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_VIDEO_LTR_POLICY) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexConfigVideoLTRPolicy;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_VIDEO_LOSS_REPORT) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexConfigVideoLossReport;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
 #ifdef USE_ANDROID
     if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_PREPEND_SPSPPS_TO_IDR) == 0) {
         *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamPrependSPSPPSToIDR;
@@ -3293,6 +3454,8 @@ OMX_ERRORTYPE Exynos_H264Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pH264Enc->hMFCH264Handle.pInbufOps, pH264Enc->hMFCH264Handle.pOutbufOps, pH264Enc->hMFCH264Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     Exynos_SetPlaneToPort(pOutputPort, MFC_DEFAULT_OUTPUT_BUFFER_PLANE);
 
@@ -3300,8 +3463,7 @@ OMX_ERRORTYPE Exynos_H264Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     Exynos_OSAL_QueueCreate(&pInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
     if (pOutputPort->bufferProcessType & BUFFER_COPY) {
-        Exynos_OSAL_SemaphoreCreate(&pOutputPort->codecSemID);
-        Exynos_OSAL_QueueCreate(&pOutputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+        Exynos_CodecBufferCreate(pExynosComponent, OUTPUT_PORT_INDEX);
     } else if (pOutputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -3394,6 +3556,7 @@ OMX_ERRORTYPE Exynos_H264Enc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
                 Exynos_OSAL_QueueTerminate(&pExynosOutputPort->codecBufferQ);
                 Exynos_OSAL_SemaphoreTerminate(pExynosOutputPort->codecSemID);
                 pExynosOutputPort->codecSemID = NULL;
+                pExynosOutputPort->bufferProcessType = BUFFER_SHARE;  /* picked again by the next UseBuffer */
             } else if (pExynosOutputPort->bufferProcessType & BUFFER_SHARE) {
                 /*************/
                 /*    TBD    */
@@ -3523,6 +3686,10 @@ OMX_ERRORTYPE Exynos_H264Enc_SrcIn(
                                                         pSrcInputData->bufferHeader, pSrcInputData->nFlags,
                                                         pSrcInputData->timeStamp, (double)(pSrcInputData->timeStamp / 1E6),
                                                         pH264Enc->hMFCH264Handle.indexTimestamp);
+
+        if (pSrcInputData->dataLen > 0)
+            H264Enc_RunLTRControl(pExynosComponent, pSrcInputData->timeStamp);
+
         pEncOps->Set_FrameTag(hMFCHandle, pH264Enc->hMFCH264Handle.indexTimestamp);
         pH264Enc->hMFCH264Handle.indexTimestamp++;
         pH264Enc->hMFCH264Handle.indexTimestamp %= MAX_TIMESTAMP;
@@ -3699,17 +3866,8 @@ OMX_ERRORTYPE Exynos_H264Enc_SrcOut(
         }
 
         if (pInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]) {
-                    pVideoEnc->pMFCEncInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoEnc->pMFCEncInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecEncode;
                 goto EXIT;
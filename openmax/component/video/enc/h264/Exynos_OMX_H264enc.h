@@ -50,6 +50,7 @@ typedef struct _EXTRA_DATA
     OMX_U32   PPSLen;
 } EXTRA_DATA;
 
+/* LTR marking and recovery driven by EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY */
 typedef struct _EXYNOS_MFC_H264ENC_HANDLE
 {
     OMX_HANDLETYPE hMFCHandle;
@@ -3163,6 +3163,8 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pH264Enc->hMFCH264Handle.pInbufOps, pH264Enc->hMFCH264Handle.pOutbufOps, pH264Enc->hMFCH264Handle.hMFCHandle);
+
     pExynosComponent->currentState = OMX_StateLoaded;
 
     ret = OMX_ErrorNone;
@@ -556,8 +556,9 @@ static void Set_HEVCEnc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
     pHEVCParam->LoopFilterTcOffset    = 0;
     pHEVCParam->LoopFilterBetaOffset  = 0;
 
-    pHEVCParam->LongtermRefEnable     = 0;
-    pHEVCParam->LongtermUserRef       = 0;
+    /* LTRs are marked and referred by the encoder on each frame(LTR policy) */
+    pHEVCParam->LongtermRefEnable     = (pMFCHevcHandle->nLTRFrames > 0)? 1:0;
+    pHEVCParam->LongtermUserRef       = (pMFCHevcHandle->nLTRFrames > 0)? 1:0;
     pHEVCParam->LongtermStoreRef      = 0;
 
     pHEVCParam->DarkDisable           = 1;    /* disable adaptive rate control on dark region */
@@ -588,7 +589,8 @@ static void Set_HEVCEnc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
     else
         pHEVCParam->HierarType = EXYNOS_OMX_Hierarchical_P;
 
-    pHEVCParam->ROIEnable = (pMFCHevcHandle->bRoiInfo == OMX_TRUE)? 1:0;
+    pHEVCParam->ROIEnable = ((pMFCHevcHandle->bRoiInfo == OMX_TRUE) ||
+                             (pVideoEnc->bAdaptiveRoi == OMX_TRUE))? 1:0;
     pHEVCParam->GPBEnable = (ExynosVideoBoolType)pMFCHevcHandle->bGPBEnable;
 
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] eControlRate: 0x%x", pExynosComponent, __FUNCTION__, pVideoEnc->eControlRate[OUTPUT_PORT_INDEX]);
@@ -682,7 +684,7 @@ static void Change_HEVCEnc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
         if (pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] != OMX_Video_ControlRateDisable) {
             nValue = pConfigBitrate->nEncodeBitrate;
             pEncOps->Set_BitRate(pMFCHevcHandle->hMFCHandle, nValue);
-            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
+            Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
         }
     }
         break;
@@ -712,7 +714,7 @@ static void Change_HEVCEnc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
 
         pEncOps->Set_QpRange(pMFCHevcHandle->hMFCHandle, qpRange);
 
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] qp range: I(%d, %d), P(%d, %d), B(%d, %d)",
+        Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] qp range: I(%d, %d), P(%d, %d), B(%d, %d)",
                                     pExynosComponent, __FUNCTION__,
                                     qpRange.QpMin_I, qpRange.QpMax_I,
                                     qpRange.QpMin_P, qpRange.QpMax_P,
@@ -814,6 +816,20 @@ static void Change_HEVCEnc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
         pEncOps->Set_IFrameRatio(pMFCHevcHandle->hMFCHandle, pIFrameRatio->nU32);
     }
         break;
+    case OMX_IndexConfigVideoLTRPolicy:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *pLTRPolicy = (EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *)pConfigData;
+
+        Exynos_LTR_SetPolicy(pExynosComponent, pLTRPolicy, pMFCHevcHandle->nLTRFrames);
+    }
+        break;
+    case OMX_IndexConfigVideoLossReport:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *pLossReport = (EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *)pConfigData;
+
+        Exynos_LTR_ReportLoss(pExynosComponent, pLossReport->nTimeStamp);
+    }
+        break;
     case OMX_IndexConfigCommonOutputSize:
     {
         OMX_FRAMESIZETYPE   *pFrameSize     = (OMX_FRAMESIZETYPE *)pConfigData;
@@ -886,6 +902,42 @@ EXIT:
     return;
 }
 
+static void HEVCEnc_RunLTRControl(
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent,
+    OMX_TICKS                 timeStamp)
+{
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc      = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_HEVCENC_HANDLE         *pHevcEnc       = (EXYNOS_HEVCENC_HANDLE *)pVideoEnc->hCodecHandle;
+    EXYNOS_MFC_HEVCENC_HANDLE     *pMFCHevcHandle = &pHevcEnc->hMFCHevcHandle;
+    EXYNOS_OMX_VENC_LTR_CONTROL   *pLTRControl    = &pVideoEnc->ltrControl;
+    ExynosVideoEncOps             *pEncOps        = pMFCHevcHandle->pEncOps;
+
+    int i;
+
+    FunctionIn();
+
+    if (pLTRControl->nTemporalLayerCount > 0) {
+        TemporalLayerShareBuffer TemporalSVC;
+
+        Exynos_OSAL_Memset(&TemporalSVC, 0, sizeof(TemporalLayerShareBuffer));
+        TemporalSVC.nTemporalLayerCount = pLTRControl->nTemporalLayerCount;
+        for (i = 0; i < OMX_VIDEO_MAX_HEVC_TEMPORAL_LAYERS; i++)
+            TemporalSVC.nTemporalLayerBitrateRatio[i] = pHevcEnc->nTemporalLayerBitrateRatio[i];
+
+        if (pEncOps->Set_LayerChange(pMFCHevcHandle->hMFCHandle, TemporalSVC) != VIDEO_ERROR_NONE)
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] Not supported control: Set_LayerChange", pExynosComponent, __FUNCTION__);
+
+        pHevcEnc->nTemporalLayerCount    = pLTRControl->nTemporalLayerCount;
+        pLTRControl->nTemporalLayerCount = 0;
+    }
+
+    Exynos_LTR_Run(pExynosComponent, pEncOps, pMFCHevcHandle->hMFCHandle, pMFCHevcHandle->nLTRFrames, timeStamp);
+
+    FunctionOut();
+
+    return;
+}
+
 OMX_ERRORTYPE GetCodecOutputPrivateData(
     OMX_PTR  pCodecBuffer,
     OMX_PTR *pVirtAddr,
@@ -1297,15 +1349,7 @@ OMX_ERRORTYPE HEVCCodecEnqueueAllBuffer(
 
     if ((nPortIndex == INPUT_PORT_INDEX) &&
         (pHevcEnc->bSourceStart == OMX_TRUE)) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)  {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoEnc->pMFCEncInputBuffer[i]->fd[0], pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1814,8 +1858,10 @@ OMX_ERRORTYPE HEVCCodecSrcSetup(
         goto EXIT;
     }
 
+    /* frames of the tunnel peer are given by the fd at every SrcIn */
     if ((pInputPort->bufferProcessType & BUFFER_SHARE) &&
-        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED)) {
+        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        !CHECK_PORT_TUNNELED(pInputPort)) {
         /* data buffer */
         ret = OMX_ErrorNotImplemented;
         goto EXIT;
@@ -2170,6 +2216,24 @@ OMX_ERRORTYPE Exynos_HEVCEnc_GetParameter(
         pDstEnableRoiInfo->bEnableRoiInfo = pHevcEnc->hMFCHevcHandle.bRoiInfo;
     }
         break;
+    case OMX_IndexParamVideoEnableAdaptiveRoi:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *pDstAdaptiveRoi = (EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pDstAdaptiveRoi, sizeof(EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pDstAdaptiveRoi->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        pDstAdaptiveRoi->bEnableRoiInfo = pVideoEnc->bAdaptiveRoi;
+    }
+        break;
     case OMX_IndexParamVideoEnablePVC:
     {
         OMX_PARAM_U32TYPE *pEnablePVC  = (OMX_PARAM_U32TYPE *)pComponentParameterStructure;
@@ -2645,6 +2709,31 @@ OMX_ERRORTYPE Exynos_HEVCEnc_SetParameter(
         pHevcEnc->hMFCHevcHandle.bRoiInfo = pSrcEnableRoiInfo->bEnableRoiInfo;
     }
         break;
+    case OMX_IndexParamVideoEnableAdaptiveRoi:
+    {
+        EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *pSrcAdaptiveRoi = (EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO *)pComponentParameterStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pSrcAdaptiveRoi, sizeof(EXYNOS_OMX_VIDEO_PARAM_ENABLE_ROIINFO));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pSrcAdaptiveRoi->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        if ((pHevcEnc->hMFCHevcHandle.videoInstInfo.supportInfo.enc.bRoiInfoSupport == VIDEO_FALSE) &&
+            (pSrcAdaptiveRoi->bEnableRoiInfo == OMX_TRUE)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%p][%s] adaptive ROI needs Roi Info that is not supported", pExynosComponent, __FUNCTION__);
+            ret = OMX_ErrorUndefined;
+            goto EXIT;
+        }
+
+        pVideoEnc->bAdaptiveRoi = pSrcAdaptiveRoi->bEnableRoiInfo;
+    }
+        break;
     case OMX_IndexParamVideoEnablePVC:
     {
         OMX_PARAM_U32TYPE *pEnablePVC  = (OMX_PARAM_U32TYPE *)pComponentParameterStructure;
@@ -3038,6 +3127,62 @@ OMX_ERRORTYPE Exynos_HEVCEnc_SetConfig(
         }
     }
         break;
+    case OMX_IndexConfigVideoLTRPolicy:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *pLTRPolicy = (EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLTRPolicy, sizeof(EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLTRPolicy->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        if ((pLTRPolicy->nTemporalLayerCount > 0) &&
+            ((pHevcEnc->hMFCHevcHandle.bTemporalSVC == OMX_FALSE) ||
+             (pLTRPolicy->nTemporalLayerCount > pHevcEnc->nMaxTemporalLayerCount))) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] layer count(%d) is invalid(MAX(%d))",
+                                                pExynosComponent, __FUNCTION__,
+                                                pLTRPolicy->nTemporalLayerCount, pHevcEnc->nMaxTemporalLayerCount);
+            ret = OMX_ErrorBadParameter;
+            goto EXIT;
+        }
+
+        if (pLTRPolicy->nLTRRefreshPeriod > 0) {
+            if (pHevcEnc->hMFCHevcHandle.nLTRFrames == 0) {
+                /* LTR is enabled at codec init only */
+                if ((pExynosComponent->currentState != OMX_StateLoaded) &&
+                    (pExynosComponent->currentState != OMX_StateIdle)) {
+                    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] LTR is not enabled", pExynosComponent, __FUNCTION__);
+                    ret = OMX_ErrorIncorrectStateOperation;
+                    goto EXIT;
+                }
+
+                pHevcEnc->hMFCHevcHandle.nLTRFrames = OMX_VIDEO_MAX_LTR_FRAMES;
+            }
+        }
+    }
+        break;
+    case OMX_IndexConfigVideoLossReport:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *pLossReport = (EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT *)pComponentConfigStructure;
+
+        ret = Exynos_OMX_Check_SizeVersion(pLossReport, sizeof(EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT));
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Failed to Check_SizeVersion", pExynosComponent, __FUNCTION__);
+            goto EXIT;
+        }
+
+        if (pLossReport->nPortIndex != OUTPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+    }
+        break;
 #ifdef USE_ANDROID
     case OMX_IndexConfigAndroidVideoTemporalLayering:
     {
@@ -3191,6 +3336,24 @@ OMX_ERRORTYPE Exynos_HEVCEnc_GetExtensionIndex(
         goto EXIT;
     }
 
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_VIDEO_LTR_POLICY) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexConfigVideoLTRPolicy;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_CONFIG_VIDEO_LOSS_REPORT) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexConfigVideoLossReport;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
+    if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_VIDEO_ENABLE_ADAPTIVE_ROI) == 0) {
+        *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamVideoEnableAdaptiveRoi;
+        ret = OMX_ErrorNone;
+        goto EXIT;
+    }
+
     if (Exynos_OSAL_Strcmp(cParameterName, EXYNOS_INDEX_PARAM_ENABLE_PVC) == 0) {
         *pIndexType = (OMX_INDEXTYPE)OMX_IndexParamVideoEnablePVC;
         ret = OMX_ErrorNone;
@@ -3343,6 +3506,8 @@ OMX_ERRORTYPE Exynos_HEVCEnc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pHevcEnc->hMFCHevcHandle.pInbufOps, pHevcEnc->hMFCHevcHandle.pOutbufOps, pHevcEnc->hMFCHevcHandle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     Exynos_SetPlaneToPort(pOutputPort, MFC_DEFAULT_OUTPUT_BUFFER_PLANE);
 
@@ -3350,8 +3515,7 @@ OMX_ERRORTYPE Exynos_HEVCEnc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     Exynos_OSAL_QueueCreate(&pInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
     if (pOutputPort->bufferProcessType & BUFFER_COPY) {
-        Exynos_OSAL_SemaphoreCreate(&pOutputPort->codecSemID);
-        Exynos_OSAL_QueueCreate(&pOutputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+        Exynos_CodecBufferCreate(pExynosComponent, OUTPUT_PORT_INDEX);
     } else if (pOutputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -3443,6 +3607,7 @@ OMX_ERRORTYPE Exynos_HEVCEnc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
                 Exynos_OSAL_QueueTerminate(&pExynosOutputPort->codecBufferQ);
                 Exynos_OSAL_SemaphoreTerminate(pExynosOutputPort->codecSemID);
                 pExynosOutputPort->codecSemID = NULL;
+                pExynosOutputPort->bufferProcessType = BUFFER_SHARE;  /* picked again by the next UseBuffer */
             } else if (pExynosOutputPort->bufferProcessType & BUFFER_SHARE) {
                 /*************/
                 /*    TBD    */
@@ -3558,6 +3723,9 @@ OMX_ERRORTYPE Exynos_HEVCEnc_SrcIn(
                                                         pSrcInputData->timeStamp, (double)(pSrcInputData->timeStamp / 1E6),
                                                         pHevcEnc->hMFCHevcHandle.indexTimestamp);
 
+        if (pSrcInputData->dataLen > 0)
+            HEVCEnc_RunLTRControl(pExynosComponent, pSrcInputData->timeStamp);
+
         pEncOps->Set_FrameTag(hMFCHandle, pHevcEnc->hMFCHevcHandle.indexTimestamp);
         pHevcEnc->hMFCHevcHandle.indexTimestamp++;
         pHevcEnc->hMFCHevcHandle.indexTimestamp %= MAX_TIMESTAMP;
@@ -3739,17 +3907,8 @@ OMX_ERRORTYPE Exynos_HEVCEnc_SrcOut(
         }
 
         if (pInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]) {
-                    pVideoEnc->pMFCEncInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoEnc->pMFCEncInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecEncode;
                 goto EXIT;
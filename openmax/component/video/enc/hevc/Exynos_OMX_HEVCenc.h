@@ -49,6 +49,7 @@ typedef struct _EXYNOS_MFC_HEVCENC_HANDLE
     OMX_BOOL bWeightedPrediction;
     OMX_BOOL bHDRDynamicInfo;
     OMX_BOOL bGPBEnable;
+    OMX_U32  nLTRFrames;    /* LTR slots under the encoder's LTR policy, 0 : disabled */
 
     ExynosVideoEncOps       *pEncOps;
     ExynosVideoEncBufferOps *pInbufOps;
@@ -3145,6 +3145,8 @@ OSCL_EXPORT_REF OMX_ERRORTYPE Exynos_OMX_ComponentInit(
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pHevcEnc->hMFCHevcHandle.pInbufOps, pHevcEnc->hMFCHevcHandle.pOutbufOps, pHevcEnc->hMFCHevcHandle.hMFCHandle);
+
     pExynosComponent->currentState = OMX_StateLoaded;
 
     ret = OMX_ErrorNone;
@@ -490,7 +490,7 @@ static void Change_VP8Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
             /* bitrate : main */
             nValue = pConfigBitrate->nEncodeBitrate;
             pEncOps->Set_BitRate(pMFCVp8Handle->hMFCHandle, nValue);
-            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
+            Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
             /* bitrate : layer */
             TemporalLayerShareBuffer TemporalSVC;
             Exynos_OSAL_Memset(&TemporalSVC, 0, sizeof(TemporalLayerShareBuffer));
@@ -535,7 +535,7 @@ static void Change_VP8Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
 
         pEncOps->Set_QpRange(pMFCVp8Handle->hMFCHandle, qpRange);
 
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] qp range: I(%d, %d), P(%d, %d)",
+        Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] qp range: I(%d, %d), P(%d, %d)",
                                     pExynosComponent, __FUNCTION__,
                                     qpRange.QpMin_I, qpRange.QpMax_I,
                                     qpRange.QpMin_P, qpRange.QpMax_P);
@@ -1013,15 +1013,7 @@ OMX_ERRORTYPE VP8CodecEnqueueAllBuffer(
 
     if ((nPortIndex == INPUT_PORT_INDEX) &&
         (pVp8Enc->bSourceStart == OMX_TRUE)) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)  {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoEnc->pMFCEncInputBuffer[i]->fd[0], pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1323,8 +1315,10 @@ OMX_ERRORTYPE VP8CodecSrcSetup(
         goto EXIT;
     }
 
+    /* frames of the tunnel peer are given by the fd at every SrcIn */
     if ((pInputPort->bufferProcessType & BUFFER_SHARE) &&
-        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED)) {
+        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        !CHECK_PORT_TUNNELED(pInputPort)) {
         /* data buffer */
         ret = OMX_ErrorNotImplemented;
         goto EXIT;
@@ -2408,6 +2402,8 @@ OMX_ERRORTYPE Exynos_VP8Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pVp8Enc->hMFCVp8Handle.pInbufOps, pVp8Enc->hMFCVp8Handle.pOutbufOps, pVp8Enc->hMFCVp8Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     Exynos_SetPlaneToPort(pOutputPort, MFC_DEFAULT_OUTPUT_BUFFER_PLANE);
 
@@ -2415,8 +2411,7 @@ OMX_ERRORTYPE Exynos_VP8Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     Exynos_OSAL_QueueCreate(&pInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
     if (pOutputPort->bufferProcessType & BUFFER_COPY) {
-        Exynos_OSAL_SemaphoreCreate(&pOutputPort->codecSemID);
-        Exynos_OSAL_QueueCreate(&pOutputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+        Exynos_CodecBufferCreate(pExynosComponent, OUTPUT_PORT_INDEX);
     } else if (pOutputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2503,6 +2498,7 @@ OMX_ERRORTYPE Exynos_VP8Enc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
                 Exynos_OSAL_QueueTerminate(&pExynosOutputPort->codecBufferQ);
                 Exynos_OSAL_SemaphoreTerminate(pExynosOutputPort->codecSemID);
                 pExynosOutputPort->codecSemID = NULL;
+                pExynosOutputPort->bufferProcessType = BUFFER_SHARE;  /* picked again by the next UseBuffer */
             } else if (pExynosOutputPort->bufferProcessType & BUFFER_SHARE) {
                 /*************/
                 /*    TBD    */
@@ -2785,17 +2781,8 @@ OMX_ERRORTYPE Exynos_VP8Enc_SrcOut(
         }
 
         if (pInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]) {
-                    pVideoEnc->pMFCEncInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoEnc->pMFCEncInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecEncode;
                 goto EXIT;
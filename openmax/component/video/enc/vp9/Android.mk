@@ -76,4 +76,8 @@ endif
 
 LOCAL_CFLAGS += -Wno-unused-variable -Wno-unused-label -Wno-unused-function
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_SHARED_LIBRARY)
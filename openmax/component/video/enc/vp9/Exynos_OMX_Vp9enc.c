@@ -560,7 +560,7 @@ static void Change_VP9Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
             /* bitrate : main */
             nValue = pConfigBitrate->nEncodeBitrate;
             pEncOps->Set_BitRate(pMFCVp9Handle->hMFCHandle, nValue);
-            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
+            Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] bitrate: %d", pExynosComponent, __FUNCTION__, nValue);
             /* bitrate : layer */
             TemporalLayerShareBuffer TemporalSVC;
             Exynos_OSAL_Memset(&TemporalSVC, 0, sizeof(TemporalLayerShareBuffer));
@@ -605,7 +605,7 @@ static void Change_VP9Enc_Param(EXYNOS_OMX_BASECOMPONENT *pExynosComponent)
 
         pEncOps->Set_QpRange(pMFCVp9Handle->hMFCHandle, qpRange);
 
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] qp range: I(%d, %d), P(%d, %d)",
+        Exynos_OSAL_Log(VENC_RC_CHANGE_LOG_LEVEL(pVideoEnc), "[%p][%s] qp range: I(%d, %d), P(%d, %d)",
                                     pExynosComponent, __FUNCTION__,
                                     qpRange.QpMin_I, qpRange.QpMax_I,
                                     qpRange.QpMin_P, qpRange.QpMax_P);
@@ -1083,15 +1083,7 @@ OMX_ERRORTYPE VP9CodecEnqueueAllBuffer(
 
     if ((nPortIndex == INPUT_PORT_INDEX) &&
         (pVp9Enc->bSourceStart == OMX_TRUE)) {
-        Exynos_CodecBufferReset(pExynosComponent, INPUT_PORT_INDEX);
-
-        for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++)  {
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%p][%s] CodecBuffer(input) [%d]: FD(0x%x), VA(0x%x)",
-                                                pExynosComponent, __FUNCTION__,
-                                                i, pVideoEnc->pMFCEncInputBuffer[i]->fd[0], pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]);
-
-            Exynos_CodecBufferEnqueue(pExynosComponent, INPUT_PORT_INDEX, pVideoEnc->pMFCEncInputBuffer[i]);
-        }
+        Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
 
         pInbufOps->Clear_Queue(hMFCHandle);
     } else if ((nPortIndex == OUTPUT_PORT_INDEX) &&
@@ -1392,8 +1384,10 @@ OMX_ERRORTYPE VP9CodecSrcSetup(
         goto EXIT;
     }
 
+    /* frames of the tunnel peer are given by the fd at every SrcIn */
     if ((pInputPort->bufferProcessType & BUFFER_SHARE) &&
-        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED)) {
+        (pInputPort->eMetaDataType == METADATA_TYPE_DISABLED) &&
+        !CHECK_PORT_TUNNELED(pInputPort)) {
         /* data buffer */
         ret = OMX_ErrorNotImplemented;
         goto EXIT;
@@ -2371,6 +2365,8 @@ OMX_ERRORTYPE Exynos_VP9Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         goto EXIT;
     }
 
+    Exynos_Set_CodecReadyFd(pExynosComponent, pVp9Enc->hMFCVp9Handle.pInbufOps, pVp9Enc->hMFCVp9Handle.pOutbufOps, pVp9Enc->hMFCVp9Handle.hMFCHandle);
+
     Exynos_SetPlaneToPort(pInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
     Exynos_SetPlaneToPort(pOutputPort, MFC_DEFAULT_OUTPUT_BUFFER_PLANE);
 
@@ -2378,8 +2374,7 @@ OMX_ERRORTYPE Exynos_VP9Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     Exynos_OSAL_QueueCreate(&pInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
 
     if (pOutputPort->bufferProcessType & BUFFER_COPY) {
-        Exynos_OSAL_SemaphoreCreate(&pOutputPort->codecSemID);
-        Exynos_OSAL_QueueCreate(&pOutputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+        Exynos_CodecBufferCreate(pExynosComponent, OUTPUT_PORT_INDEX);
     } else if (pOutputPort->bufferProcessType & BUFFER_SHARE) {
         /*************/
         /*    TBD    */
@@ -2466,6 +2461,7 @@ OMX_ERRORTYPE Exynos_VP9Enc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
                 Exynos_OSAL_QueueTerminate(&pExynosOutputPort->codecBufferQ);
                 Exynos_OSAL_SemaphoreTerminate(pExynosOutputPort->codecSemID);
                 pExynosOutputPort->codecSemID = NULL;
+                pExynosOutputPort->bufferProcessType = BUFFER_SHARE;  /* picked again by the next UseBuffer */
             } else if (pExynosOutputPort->bufferProcessType & BUFFER_SHARE) {
                 /*************/
                 /*    TBD    */
@@ -2748,17 +2744,8 @@ OMX_ERRORTYPE Exynos_VP9Enc_SrcOut(
         }
 
         if (pInputPort->bufferProcessType & BUFFER_COPY) {
-            int i;
-            for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
-                if (pSrcOutputData->buffer.addr[0] ==
-                        pVideoEnc->pMFCEncInputBuffer[i]->pVirAddr[0]) {
-                    pVideoEnc->pMFCEncInputBuffer[i]->dataSize = 0;
-                    pSrcOutputData->pPrivate = pVideoEnc->pMFCEncInputBuffer[i];
-                    break;
-                }
-            }
-
-            if (i >= MFC_INPUT_BUFFER_NUM_MAX) {
+            pSrcOutputData->pPrivate = Exynos_Find_CodecInputBuffer(pOMXComponent, pSrcOutputData->buffer.addr[0]);
+            if (pSrcOutputData->pPrivate == NULL) {
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] Can not find a codec buffer", pExynosComponent, __FUNCTION__);
                 ret = (OMX_ERRORTYPE)OMX_ErrorCodecEncode;
                 goto EXIT;
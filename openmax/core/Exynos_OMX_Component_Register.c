@@ -32,6 +32,7 @@
 #include <errno.h>
 #include <assert.h>
 #include <dirent.h>
+#include <pthread.h>
 
 #include "OMX_Component.h"
 #include "Exynos_OSAL_Memory.h"
@@ -480,6 +481,79 @@ static char *gDisableComponents[] = {
 };
 #endif
 
+/*
+ * component libraries stay loaded until the core is deinitialized,
+ * so creating the same component again skips dlopen() and dlsym()
+ */
+typedef struct _EXYNOS_OMX_LIBRARY_CACHE
+{
+    OMX_U8          libName[MAX_OMX_COMPONENT_LIBNAME_SIZE];
+    OMX_HANDLETYPE  libHandle;
+    OMX_ERRORTYPE (*ComponentInit)(OMX_HANDLETYPE hComponent, OMX_STRING componentName);
+} EXYNOS_OMX_LIBRARY_CACHE;
+
+static EXYNOS_OMX_LIBRARY_CACHE gLibraryCache[MAX_OMX_COMPONENT_NUM];
+static int                      gLibraryCacheNum = 0;
+static pthread_mutex_t          gLibraryCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static EXYNOS_OMX_LIBRARY_CACHE *Exynos_OMX_LibraryCache_Get(OMX_STRING libName)
+{
+    EXYNOS_OMX_LIBRARY_CACHE *pCache    = NULL;
+    OMX_HANDLETYPE            libHandle = NULL;
+    int i;
+
+    pthread_mutex_lock(&gLibraryCacheMutex);
+
+    for (i = 0; i < gLibraryCacheNum; i++) {
+        if (Exynos_OSAL_Strcmp(libName, (OMX_STRING)gLibraryCache[i].libName) == 0) {
+            pCache = &gLibraryCache[i];
+            goto EXIT;
+        }
+    }
+
+    if (gLibraryCacheNum >= MAX_OMX_COMPONENT_NUM)
+        goto EXIT;
+
+    libHandle = Exynos_OSAL_dlopen(libName, RTLD_NOW);
+    if (libHandle == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlopen(%s)", __FUNCTION__, libName);
+        goto EXIT;
+    }
+
+    pCache = &gLibraryCache[gLibraryCacheNum];
+    pCache->ComponentInit = Exynos_OSAL_dlsym(libHandle, "Exynos_OMX_ComponentInit");
+    if (pCache->ComponentInit == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlsym(Exynos_OMX_ComponentInit)", __FUNCTION__);
+        Exynos_OSAL_dlclose(libHandle);
+        pCache = NULL;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Strcpy((OMX_STRING)pCache->libName, libName);
+    pCache->libHandle = libHandle;
+    gLibraryCacheNum++;
+
+EXIT:
+    pthread_mutex_unlock(&gLibraryCacheMutex);
+
+    return pCache;
+}
+
+static void Exynos_OMX_LibraryCache_Clear(void)
+{
+    int i;
+
+    pthread_mutex_lock(&gLibraryCacheMutex);
+
+    for (i = 0; i < gLibraryCacheNum; i++) {
+        Exynos_OSAL_dlclose(gLibraryCache[i].libHandle);
+        Exynos_OSAL_Memset(&gLibraryCache[i], 0, sizeof(gLibraryCache[i]));
+    }
+    gLibraryCacheNum = 0;
+
+    pthread_mutex_unlock(&gLibraryCacheMutex);
+}
+
 static void registComponent(
     char                         *sLibName,
     EXYNOS_OMX_COMPONENT_REGLIST *pComponentList,
@@ -698,6 +772,8 @@ OMX_ERRORTYPE Exynos_OMX_Component_Unregister(EXYNOS_OMX_COMPONENT_REGLIST *comp
 {
     OMX_ERRORTYPE ret = OMX_ErrorNone;
 
+    Exynos_OMX_LibraryCache_Clear();
+
     Exynos_OSAL_Free(componentList);
 
 EXIT:
@@ -739,42 +815,31 @@ OMX_ERRORTYPE Exynos_OMX_ComponentAPICheck(OMX_COMPONENTTYPE *component)
 
 OMX_ERRORTYPE Exynos_OMX_ComponentLoad(EXYNOS_OMX_COMPONENT *exynos_component)
 {
-    OMX_ERRORTYPE      ret           = OMX_ErrorNone;
-    OMX_HANDLETYPE     libHandle     = NULL;
-    OMX_COMPONENTTYPE *pOMXComponent = NULL;
+    OMX_ERRORTYPE             ret           = OMX_ErrorNone;
+    EXYNOS_OMX_LIBRARY_CACHE *pCache        = NULL;
+    OMX_COMPONENTTYPE        *pOMXComponent = NULL;
 
     FunctionIn();
 
-    OMX_ERRORTYPE (*Exynos_OMX_ComponentInit)(OMX_HANDLETYPE hComponent, OMX_STRING componentName);
-
-    libHandle = Exynos_OSAL_dlopen((OMX_STRING)exynos_component->libName, RTLD_NOW);
-    if (libHandle == NULL) {
+    /* the handle is owned by the cache, so it is not kept in exynos_component */
+    pCache = Exynos_OMX_LibraryCache_Get((OMX_STRING)exynos_component->libName);
+    if (pCache == NULL) {
         ret = OMX_ErrorInvalidComponentName;
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlopen(%s)", __FUNCTION__, exynos_component->libName);
-        goto EXIT;
-    }
-
-    Exynos_OMX_ComponentInit = Exynos_OSAL_dlsym(libHandle, "Exynos_OMX_ComponentInit");
-    if (Exynos_OMX_ComponentInit == NULL) {
-        Exynos_OSAL_dlclose(libHandle);
-        ret = OMX_ErrorInvalidComponent;
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlsym(Exynos_OMX_ComponentInit)", __FUNCTION__);
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to load %s", __FUNCTION__, exynos_component->libName);
         goto EXIT;
     }
 
     pOMXComponent = (OMX_COMPONENTTYPE *)Exynos_OSAL_Malloc(sizeof(OMX_COMPONENTTYPE));
     if (pOMXComponent == NULL) {
-        Exynos_OSAL_dlclose(libHandle);
         ret = OMX_ErrorInsufficientResources;
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__);
         goto EXIT;
     }
     INIT_SET_SIZE_VERSION(pOMXComponent, OMX_COMPONENTTYPE);
 
-    ret = (*Exynos_OMX_ComponentInit)((OMX_HANDLETYPE)pOMXComponent, (OMX_STRING)exynos_component->componentName);
+    ret = (*pCache->ComponentInit)((OMX_HANDLETYPE)pOMXComponent, (OMX_STRING)exynos_component->componentName);
     if (ret != OMX_ErrorNone) {
         Exynos_OSAL_Free(pOMXComponent);
-        Exynos_OSAL_dlclose(libHandle);
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OMX_ComponentInit() (ret:0x%x)", __FUNCTION__, ret);
         ret = OMX_ErrorInsufficientResources;
         goto EXIT;
@@ -784,13 +849,12 @@ OMX_ERRORTYPE Exynos_OMX_ComponentLoad(EXYNOS_OMX_COMPONENT *exynos_component)
                 pOMXComponent->ComponentDeInit(pOMXComponent);
 
             Exynos_OSAL_Free(pOMXComponent);
-            Exynos_OSAL_dlclose(libHandle);
             ret = OMX_ErrorInvalidComponent;
             Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OMX_ComponentAPICheck()", __FUNCTION__);
             goto EXIT;
         }
 
-        exynos_component->libHandle     = libHandle;
+        exynos_component->libHandle     = NULL;
         exynos_component->pOMXComponent = pOMXComponent;
         ret = OMX_ErrorNone;
     }
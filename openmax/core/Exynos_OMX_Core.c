@@ -39,6 +39,7 @@
 #include "Exynos_OMX_Resourcemanager.h"
 #include "Exynos_OSAL_Event.h"
 #include "Exynos_OMX_Basecomponent.h"
+#include "Exynos_OSAL_Bench.h"
 
 #undef  EXYNOS_LOG_TAG
 #define EXYNOS_LOG_TAG    "EXYNOS_OMX_CORE"
@@ -59,13 +60,15 @@ static pthread_mutex_t gMutex;
 
 OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_Init(void)
 {
-    OMX_ERRORTYPE ret = OMX_ErrorNone;
+    OMX_ERRORTYPE ret          = OMX_ErrorNone;
+    OMX_U64       nStartTimeUs = 0;
 
     FunctionIn();
 
     pthread_mutex_lock(&gMutex);
 
     if (gInitialized == 0) {
+        nStartTimeUs = Exynos_OSAL_GetSystemTimeUs();
         Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] core is not initialized", __FUNCTION__);
         if (Exynos_OMX_Component_Register(&gComponentList, &gComponentNum)) {
             ret = OMX_ErrorInsufficientResources;
@@ -86,7 +89,8 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_Init(void)
         }
 
         gInitialized = 1;
-        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] core is initialized", __FUNCTION__);
+        Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%s] core is initialized in %lld us", __FUNCTION__,
+                                            (long long)(Exynos_OSAL_GetSystemTimeUs() - nStartTimeUs));
     }
 
     gRefCount++;
@@ -169,9 +173,13 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_GetHandle(
     OMX_IN  OMX_PTR pAppData,
     OMX_IN  OMX_CALLBACKTYPE *pCallBacks)
 {
-    OMX_ERRORTYPE         ret = OMX_ErrorNone;
-    EXYNOS_OMX_COMPONENT *loadComponent;
-    EXYNOS_OMX_COMPONENT *currentComponent;
+    OMX_ERRORTYPE             ret = OMX_ErrorNone;
+    EXYNOS_OMX_COMPONENT     *loadComponent;
+    EXYNOS_OMX_COMPONENT     *currentComponent;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+    OMX_U64                   nStartTimeUs     = Exynos_OSAL_GetSystemTimeUs();
+    OMX_U64                   nLoadTimeUs      = 0;
+    OMX_U64                   nElapsedUs       = 0;
     unsigned int i = 0;
 
     FunctionIn();
@@ -206,6 +214,7 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_GetHandle(
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OMX_ComponentLoad()", __FUNCTION__);
                 goto EXIT;
             }
+            nLoadTimeUs = Exynos_OSAL_GetSystemTimeUs() - nStartTimeUs;
 
             ret = loadComponent->pOMXComponent->SetCallbacks(loadComponent->pOMXComponent, pCallBacks, pAppData);
             if (ret != OMX_ErrorNone) {
@@ -215,6 +224,8 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_GetHandle(
                 goto EXIT;
             }
 
+            Exynos_OMX_TraceAttach(loadComponent->pOMXComponent, cComponentName);
+
             Exynos_OSAL_MutexLock(ghLoadComponentListMutex);
             ret = Exynos_OMX_Get_Resource(loadComponent->pOMXComponent);
             if (ret != OMX_ErrorNone) {
@@ -238,7 +249,13 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_GetHandle(
 
             *pHandle = loadComponent->pOMXComponent;
             ret = OMX_ErrorNone;
-            Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] %s is created", __FUNCTION__, cComponentName);
+
+            pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)loadComponent->pOMXComponent->pComponentPrivate;
+            nElapsedUs       = Exynos_OSAL_GetSystemTimeUs() - nStartTimeUs;
+            Exynos_OSAL_BenchPhase(pExynosComponent->hBench, BENCH_PHASE_GET_HANDLE, nElapsedUs);
+
+            Exynos_OSAL_Log(EXYNOS_LOG_INFO, "[%s] %s is created in %lld us (load %lld us)", __FUNCTION__, cComponentName,
+                                                (long long)nElapsedUs, (long long)nLoadTimeUs);
             goto EXIT;
         }
     }
@@ -312,6 +329,58 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_SetupTunnel(
     OMX_IN OMX_HANDLETYPE hInput,
     OMX_IN OMX_U32 nPortInput)
 {
+#ifdef TUNNELING_SUPPORT
+    OMX_ERRORTYPE        ret            = OMX_ErrorNone;
+    OMX_COMPONENTTYPE   *pOutput        = (OMX_COMPONENTTYPE *)hOutput;
+    OMX_COMPONENTTYPE   *pInput         = (OMX_COMPONENTTYPE *)hInput;
+    OMX_TUNNELSETUPTYPE  tunnelSetup;
+
+    FunctionIn();
+
+    if ((pOutput == NULL) &&
+        (pInput == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    tunnelSetup.nTunnelFlags = 0;
+    tunnelSetup.eSupplier    = OMX_BufferSupplyUnspecified;
+
+    /* the output side is asked first, the input side confirms or refuses */
+    if (pOutput != NULL) {
+        if (pOutput->ComponentTunnelRequest == NULL) {
+            ret = OMX_ErrorTunnelingUnsupported;
+            goto EXIT;
+        }
+
+        ret = pOutput->ComponentTunnelRequest(hOutput, nPortOutput, hInput, nPortInput, &tunnelSetup);
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] output(%p) refused tunnel(0x%x)", __FUNCTION__, hOutput, ret);
+            goto EXIT;
+        }
+    }
+
+    if (pInput != NULL) {
+        if (pInput->ComponentTunnelRequest == NULL)
+            ret = OMX_ErrorTunnelingUnsupported;
+        else
+            ret = pInput->ComponentTunnelRequest(hInput, nPortInput, hOutput, nPortOutput, &tunnelSetup);
+
+        if (ret != OMX_ErrorNone) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] input(%p) refused tunnel(0x%x)", __FUNCTION__, hInput, ret);
+
+            /* cancel the half made tunnel */
+            if (pOutput != NULL)
+                pOutput->ComponentTunnelRequest(hOutput, nPortOutput, NULL, 0, NULL);
+            goto EXIT;
+        }
+    }
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+#else
     OMX_ERRORTYPE ret = OMX_ErrorNotImplemented;
 
     OMX_PTR srcComponent    = hOutput;
@@ -322,6 +391,7 @@ OMX_API OMX_ERRORTYPE OMX_APIENTRY Exynos_OMX_SetupTunnel(
 
 EXIT:
     return ret;
+#endif
 }
 
 OMX_API OMX_ERRORTYPE Exynos_OMX_GetContentPipe(
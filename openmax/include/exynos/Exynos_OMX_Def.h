@@ -162,6 +162,22 @@ typedef enum _EXYNOS_OMX_INDEXTYPE
     OMX_IndexParamVideoChromaQP                 = 0x7F000030,
 #define EXYNOS_INDEX_PARAM_VIDEO_DISABLE_HBENCODING "OMX.SEC.index.disableHBEncoding"
     OMX_IndexParamVideoDisableHBEncoding        = 0x7F000031,
+#define EXYNOS_INDEX_PARAM_ENABLE_KEYFRAME_ONLY "OMX.SEC.index.enableKeyFrameOnlyMode"
+    OMX_IndexParamEnableKeyFrameOnlyMode        = 0x7F000032,
+#define EXYNOS_INDEX_CONFIG_VIDEO_LTR_POLICY "OMX.SEC.index.LTRPolicy"
+    OMX_IndexConfigVideoLTRPolicy               = 0x7F000033,
+#define EXYNOS_INDEX_CONFIG_VIDEO_LOSS_REPORT "OMX.SEC.index.LossReport"
+    OMX_IndexConfigVideoLossReport              = 0x7F000034,
+#define EXYNOS_INDEX_PARAM_VIDEO_ENABLE_ADAPTIVE_ROI "OMX.SEC.index.enableAdaptiveRoi"
+    OMX_IndexParamVideoEnableAdaptiveRoi        = 0x7F000035,
+#define EXYNOS_INDEX_PARAM_VIDEO_LOOKAHEAD "OMX.SEC.index.Lookahead"
+    OMX_IndexParamVideoLookahead                = 0x7F000036,
+#define EXYNOS_INDEX_CONFIG_VIDEO_PIPELINE_METRICS "OMX.SEC.index.PipelineMetrics"
+    OMX_IndexConfigVideoPipelineMetrics         = 0x7F000037,
+#define EXYNOS_INDEX_CONFIG_BUFFER_BATCH "OMX.SEC.index.BufferBatch"
+    OMX_IndexConfigBufferBatch                  = 0x7F000038,
+#define EXYNOS_INDEX_CONFIG_TRIM_MEMORY "OMX.SEC.index.TrimMemory"
+    OMX_IndexConfigTrimMemory                   = 0x7F000039,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // for extension codec spec
@@ -328,6 +344,7 @@ typedef enum _EXYNOS_OMX_ERRORTYPE
     OMX_ErrorCorruptedHeader    = (OMX_S32) OMX_ErrorStreamCorrupt, /* 0x90000012, */
     OMX_ErrorNoneExpiration     = (OMX_S32) 0x90000013,
     OMX_ErrorNoneReuseBuffer    = (OMX_S32) 0x90000014,
+    OMX_ErrorNoneSkipFrame      = (OMX_S32) 0x90000015,
 } EXYNOS_OMX_ERRORTYPE;
 
 typedef enum _EXYNOS_OMX_COMMANDTYPE
@@ -570,6 +587,67 @@ typedef struct _EXYNOS_OMX_VIDEO_CONFIG_TEMPORALSVC {
     OMX_U32         nMaxQuantizer;
 } EXYNOS_OMX_VIDEO_CONFIG_TEMPORALSVC;
 
+typedef struct _EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY {
+    OMX_U32         nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32         nPortIndex;
+    OMX_U32         nTemporalLayerCount;    /* 0 : keep the current layering */
+    OMX_U32         nLTRRefreshPeriod;      /* frames between LTR marks, 0 : no refresh */
+} EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY;
+
+typedef struct _EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT {
+    OMX_U32         nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32         nPortIndex;
+    OMX_TICKS       nTimeStamp;             /* the first frame the receiver could not decode */
+} EXYNOS_OMX_VIDEO_CONFIG_LOSSREPORT;
+
+typedef struct _EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD {
+    OMX_U32         nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32         nPortIndex;
+    OMX_U32         nDepth;                 /* frames held back before encoding, 0 : disabled */
+} EXYNOS_OMX_VIDEO_PARAM_LOOKAHEAD;
+
+/* read only snapshot, each value is sampled without locking so they are not mutually consistent */
+typedef struct _EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS {
+    OMX_U32         nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32         nInputQueued;           /* client buffers waiting in bufferQ */
+    OMX_U32         nOutputQueued;
+    OMX_U32         nInputCodecQueued;      /* free internal buffers in codecBufferQ */
+    OMX_U32         nOutputCodecQueued;
+    OMX_U32         nInputHeldByCodec;      /* buffers queued to the MFC and not dequeued yet */
+    OMX_U32         nOutputHeldByCodec;
+    OMX_U32         nPendingConfigs;        /* dynamicConfigQ entries */
+    OMX_U32         nReorderSlots;          /* timestamp reorder table occupancy */
+    OMX_U32         nInputFrames;           /* cumulative from component creation */
+    OMX_U32         nOutputFrames;
+    OMX_U32         nDroppedFrames;
+    OMX_U32         nErrors;
+    OMX_U32         nInputCopiedKB;         /* bytes copied between client and codec buffers */
+    OMX_U32         nOutputCopiedKB;
+    OMX_U32         nIonKB;                 /* ion memory allocated by the component */
+} EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS;
+
+#define EXYNOS_OMX_BUFFER_BATCH_MAX     32
+
+/*
+ * EmptyThisBuffer/FillThisBuffer for several headers at once (SetConfig only).
+ * headers are validated and queued in order, nSubmitted tells how many went in when an error is returned.
+ * in-process only : pBuffers are the component's own header pointers, which a client behind IPC(IOMX, HIDL)
+ * does not have and the IPC layer does not translate inside a vendor config. the Android vendor extension
+ * does not export this index, it is reached through OMX_GetExtensionIndex() on the OMX core.
+ */
+typedef struct _EXYNOS_OMX_CONFIG_BUFFER_BATCH {
+    OMX_U32                  nSize;
+    OMX_VERSIONTYPE          nVersion;
+    OMX_U32                  nPortIndex;    /* INPUT_PORT_INDEX : empty, OUTPUT_PORT_INDEX : fill */
+    OMX_U32                  nCount;
+    OMX_U32                  nSubmitted;    /* [out] */
+    OMX_BUFFERHEADERTYPE    *pBuffers[EXYNOS_OMX_BUFFER_BATCH_MAX];
+} EXYNOS_OMX_CONFIG_BUFFER_BATCH;
+
 typedef enum _EXYNOS_OMX_BLUR_MODE
 {
     BLUR_MODE_NONE          = 0x00,
@@ -926,11 +1004,20 @@ typedef struct _EXYNOS_OMX_VIDEO_COLORASPECTS {
 
 #define MAX_HDR10PLUS_SIZE 1024
 typedef struct _EXYNOS_OMX_VIDEO_HDR10PLUS_INFO {
-    OMX_BOOL bOccupied;
-    OMX_U32  nTag;
-    OMX_PTR  pHDR10PlusInfo;
+    OMX_BOOL  bOccupied;
+    OMX_U32   nTag;
+    OMX_TICKS timeStamp;
+    OMX_PTR   pHDR10PlusInfo;
 } EXYNOS_OMX_VIDEO_HDR10PLUS_INFO;
 
+/* HDR10+ payloads waiting for their output frame, slot is chosen by frame tag */
+#define MAX_HDR10PLUS_RING_NUM MAX_TIMESTAMP
+typedef struct _EXYNOS_OMX_VIDEO_HDR10PLUS_RING {
+    EXYNOS_OMX_VIDEO_HDR10PLUS_INFO  entry[MAX_HDR10PLUS_RING_NUM];
+    OMX_U32                          nCount;
+    OMX_HANDLETYPE                   hMutex;
+} EXYNOS_OMX_VIDEO_HDR10PLUS_RING;
+
 #ifdef USE_KHRONOS_OMX_HEADER
 /**
  * Structure for configuring video compression intra refresh period
@@ -125,6 +125,7 @@
  */
 #define EXYNOS_TUNNEL_ESTABLISHED 0x0001
 #define EXYNOS_TUNNEL_IS_SUPPLIER 0x0002
+#define EXYNOS_TUNNEL_SHARE_BUFFER 0x0004    /* frames are decoded into and encoded from the tunnel buffers as they are */
 
 #define CHECK_PORT_BEING_FLUSHED(port)                 (((port)->portState == EXYNOS_OMX_PortStateFlushing) || ((port)->portState == EXYNOS_OMX_PortStateFlushingForDisable))
 #define CHECK_PORT_BEING_DISABLED(port)                ((port)->portState == EXYNOS_OMX_PortStateDisabling)
@@ -46,6 +46,10 @@ endif
 
 LOCAL_CFLAGS += -Wno-unused-variable -Wno-unused-label
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
 
 #################################
@@ -91,6 +95,10 @@ endif
 
 LOCAL_CFLAGS += -Wno-unused-variable -Wno-unused-label
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
 endif  # for Skype HD
 
@@ -113,7 +121,10 @@ LOCAL_SRC_FILES := \
 	Exynos_OSAL_Semaphore.c \
 	Exynos_OSAL_Library.c \
 	Exynos_OSAL_Log.c \
-	Exynos_OSAL_SharedMemory.c
+	Exynos_OSAL_SharedMemory.c \
+	Exynos_OSAL_Bench.c \
+	Exynos_OSAL_Trace.c \
+	Exynos_OSAL_MemPressure.c
 
 LOCAL_PRELINK_MODULE := false
 LOCAL_MODULE := libExynosOMX_OSAL
@@ -222,4 +233,8 @@ endif
 
 LOCAL_CFLAGS += -Wno-unused-variable -Wno-unused-label
 
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+LOCAL_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
 include $(BUILD_STATIC_LIBRARY)
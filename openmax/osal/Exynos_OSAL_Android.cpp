@@ -2442,7 +2442,6 @@ OMX_ERRORTYPE Exynos_OSAL_GetConfig(
         DescribeHDR10PlusInfoParams *pParams         = (DescribeHDR10PlusInfoParams *)pComponentConfigStructure;
         DescribeHDR10PlusInfoParams *pOutParams      = NULL;
         OMX_U32                      nPortIndex      = pParams->nPortIndex;
-        int i;
 
         if ((pExynosComponent->codecType == HW_VIDEO_DEC_CODEC) ||
             (pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC)) {
@@ -2474,17 +2473,6 @@ OMX_ERRORTYPE Exynos_OSAL_GetConfig(
             Exynos_OSAL_Memcpy(pParams->nValue, pOutParams->nValue, pOutParams->nParamSizeUsed);
             pParams->nParamSizeUsed = pOutParams->nParamSizeUsed;
 
-            for (i = 0; i < MAX_BUFFER_REF; i++) {
-                if ((pOutParams == pExynosComponent->HDR10plusList[i].pHDR10PlusInfo) &&
-                    (pExynosComponent->HDR10plusList[i].bOccupied == OMX_TRUE)) {
-                    pExynosComponent->HDR10plusList[i].bOccupied      = OMX_FALSE;
-                    pExynosComponent->HDR10plusList[i].nTag           = -1;
-                    pExynosComponent->HDR10plusList[i].pHDR10PlusInfo = NULL;
-
-                    break;
-                }
-            }
-
             Exynos_OSAL_Free(pOutParams);
         }
     }
@@ -2986,6 +2974,169 @@ OMX_U32 Exynos_OSAL_GetDisplayExtraBufferCount(void)
     return 2;  /* min count */
 }
 
+/* same order as the fields of EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS */
+static const char *pipelineMetricsKeys[] = {
+    "input-queued",
+    "output-queued",
+    "input-codec-queued",
+    "output-codec-queued",
+    "input-held-by-codec",
+    "output-held-by-codec",
+    "pending-configs",
+    "reorder-slots",
+    "input-frames",
+    "output-frames",
+    "dropped-frames",
+    "errors",
+    "input-copied-kb",
+    "output-copied-kb",
+    "ion-kb",
+};
+#define PIPELINE_METRICS_KEY_NUM (sizeof(pipelineMetricsKeys) / sizeof(pipelineMetricsKeys[0]))
+
+/* codec types a vendor extension is registered for */
+#define VENDOR_EXT_CODEC(x)     (1 << (x))
+#define VENDOR_EXT_ANY          (~0U)
+#define VENDOR_EXT_ENC          (VENDOR_EXT_CODEC(HW_VIDEO_ENC_CODEC) | VENDOR_EXT_CODEC(HW_VIDEO_ENC_SECURE_CODEC))
+#define VENDOR_EXT_DEC          (VENDOR_EXT_CODEC(HW_VIDEO_DEC_CODEC) | VENDOR_EXT_CODEC(HW_VIDEO_DEC_SECURE_CODEC))
+
+typedef struct _EXYNOS_OSAL_VENDOR_EXT_DESC
+{
+    OMX_U32                         nIndex;
+    OMX_DIRTYPE                     eDir;
+    OMX_U32                         nCodecMask;
+    OMX_ANDROID_VENDOR_VALUETYPE    eValueType;
+    OMX_U32                         nParamCount;
+    const char * const             *ppKeys;
+} EXYNOS_OSAL_VENDOR_EXT_DESC;
+
+/*
+ * per component registration. only the descriptor and the caller's name are kept at creation,
+ * OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE is built from the descriptor on the first query.
+ */
+typedef struct _EXYNOS_OSAL_VENDOR_EXT
+{
+    const EXYNOS_OSAL_VENDOR_EXT_DESC       *pDesc;
+    OMX_U32                                  nNameHash;
+    const char                              *pName;
+    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pConfig;
+} EXYNOS_OSAL_VENDOR_EXT;
+
+static const char * const enableKeys[]          = { "enable" };
+static const char * const disableKeys[]         = { "disable" };
+static const char * const valueKeys[]           = { "value" };
+static const char * const numberKeys[]          = { "number" };
+static const char * const qpRangeKeys[]         = { "I-minQP", "I-maxQP", "P-minQP", "P-maxQP", "B-minQP", "B-maxQP" };
+static const char * const chromaQPKeys[]        = { "cr", "cb" };
+#ifdef USE_SKYPE_HD
+static const char * const temporalLayerKeys[]   = { "max-p-count", "max-b-count" };
+static const char * const maxLTRKeys[]          = { "max-count" };
+static const char * const numLTRKeys[]          = { "num-ltr-frames" };
+static const char * const preprocessKeys[]      = { "max-downscale-factor", "rotation" };
+static const char * const profileLevelKeys[]    = { "profile", "level" };
+static const char * const sarKeys[]             = { "width", "height" };
+static const char * const spacingKeys[]         = { "spacing" };
+static const char * const configLTRKeys[]       = { "mark-frame", "use-frame" };
+static const char * const timestampKeys[]       = { "timestamp" };
+static const char * const bitrateKeys[]         = { "value", "bitrate" };
+#endif
+
+#define VENDOR_EXT_DESC(index, dir, codec, type, keys) \
+    { (OMX_U32)(index), (dir), (codec), (type), (sizeof(keys) / sizeof((keys)[0])), (keys) }
+
+static const EXYNOS_OSAL_VENDOR_EXT_DESC vendorExtDescs[] = {
+    VENDOR_EXT_DESC(OMX_IndexConfigVideoQPRange,                        OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, qpRangeKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamNumberRefPframes,                     OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, numberKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoEnableGPB,                       OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexExynosParamBufferCopy,                     OMX_DirOutput,  VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoDropControl,                     OMX_DirInput,   VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamEnableKeyFrameOnlyMode,               OMX_DirInput,   VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoDisableDFR,                      OMX_DirInput,   VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, disableKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoCompressedColorFormat,           OMX_DirOutput,  VENDOR_EXT_DEC, OMX_AndroidVendorValueInt32, valueKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoChromaQP,                        OMX_DirInput,   VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, chromaQPKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoDisableHBEncoding,               OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, disableKeys),
+#ifdef USE_SKYPE_HD
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamDriverVersion,                   OMX_DirOutput,  VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, numberKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamLowLatency,                      OMX_DirOutput,  VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderMaxTemporalLayerCount,    OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, temporalLayerKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderMaxLTR,                   OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, maxLTRKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderLTR,                      OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, numLTRKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderPreprocess,               OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, preprocessKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoProfileLevelCurrent,             OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, profileLevelKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderSar,                      OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, sarKeys),
+    VENDOR_EXT_DESC(OMX_IndexParamVideoAvc,                             OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, spacingKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeConfigEncoderLTR,                     OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, configLTRKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeConfigQP,                             OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, valueKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeConfigBasePid,                        OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, valueKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamEncoderInputControl,             OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, enableKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeConfigEncoderInputTrigger,            OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt64, timestampKeys),
+    VENDOR_EXT_DESC(OMX_IndexSkypeParamVideoBitrate,                    OMX_DirOutput,  VENDOR_EXT_ENC, OMX_AndroidVendorValueInt32, bitrateKeys),
+#endif  // USE_SKYPE_HD
+    VENDOR_EXT_DESC(OMX_IndexExynosParamImageConvertMode,               OMX_DirOutput,  VENDOR_EXT_CODEC(HW_VIDEO_DEC_CODEC), OMX_AndroidVendorValueInt32, valueKeys),
+    VENDOR_EXT_DESC(OMX_IndexConfigVideoPipelineMetrics,                OMX_DirOutput,  VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, pipelineMetricsKeys),
+    VENDOR_EXT_DESC(OMX_IndexConfigTrimMemory,                          OMX_DirOutput,  VENDOR_EXT_ANY, OMX_AndroidVendorValueInt32, enableKeys),
+};
+#define VENDOR_EXT_DESC_NUM (sizeof(vendorExtDescs) / sizeof(vendorExtDescs[0]))
+
+static const EXYNOS_OSAL_VENDOR_EXT_DESC *Exynos_OSAL_FindVendorExtDesc(OMX_U32 nIndex)
+{
+    OMX_U32 i;
+
+    for (i = 0; i < VENDOR_EXT_DESC_NUM; i++) {
+        if (vendorExtDescs[i].nIndex == nIndex)
+            return &vendorExtDescs[i];
+    }
+
+    return NULL;
+}
+
+/* builds the extension config from its descriptor at the first query */
+static OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *Exynos_OSAL_GetVendorExtConfig(
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent,
+    EXYNOS_OSAL_VENDOR_EXT      *pVendorExt)
+{
+    const EXYNOS_OSAL_VENDOR_EXT_DESC       *pDesc      = pVendorExt->pDesc;
+    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pConfig    = NULL;
+    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pExpected  = NULL;
+
+    OMX_U32 i;
+    int nSize;
+
+    pConfig = __atomic_load_n(&pVendorExt->pConfig, __ATOMIC_ACQUIRE);
+    if (pConfig != NULL)
+        return pConfig;
+
+    nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((pDesc->nParamCount - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
+
+    pConfig = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
+    if (pConfig == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%p] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
+        return NULL;
+    }
+    Exynos_OSAL_Memset(pConfig, 0, nSize);
+
+    InitOMXParams(pConfig, nSize);
+    Exynos_OSAL_Strcpy((OMX_PTR)pConfig->cName, (OMX_PTR)pVendorExt->pName);
+
+    pConfig->nIndex          = pDesc->nIndex;
+    pConfig->eDir            = pDesc->eDir;
+    pConfig->nParamCount     = pDesc->nParamCount;
+
+    for (i = 0; i < pDesc->nParamCount; i++) {
+        Exynos_OSAL_Strcpy((OMX_PTR)pConfig->param[i].cKey, (OMX_PTR)pDesc->ppKeys[i]);
+        pConfig->param[i].eValueType = pDesc->eValueType;
+    }
+
+    /* the config is never changed after it is published, the loser of a race drops its copy */
+    if (!__atomic_compare_exchange_n(&pVendorExt->pConfig, &pExpected, pConfig,
+                                     false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        Exynos_OSAL_Free(pConfig);
+        pConfig = pExpected;
+    }
+
+    return pConfig;
+}
+
 OMX_ERRORTYPE Exynos_OSAL_AddVendorExt(
     OMX_HANDLETYPE  hComponent,
     OMX_STRING      cExtName,
@@ -2995,7 +3146,8 @@ OMX_ERRORTYPE Exynos_OSAL_AddVendorExt(
     OMX_COMPONENTTYPE                       *pOMXComponent      = NULL;
     EXYNOS_OMX_BASECOMPONENT                *pExynosComponent   = NULL;
     OMX_PTR                                 *pVendorExts        = NULL;
-    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pVendorExt         = NULL;
+    EXYNOS_OSAL_VENDOR_EXT                  *pVendorExt         = NULL;
+    const EXYNOS_OSAL_VENDOR_EXT_DESC       *pDesc              = NULL;
 
     OMX_U32 i;
     int nSlotIndex = -1;
@@ -3033,802 +3185,33 @@ OMX_ERRORTYPE Exynos_OSAL_AddVendorExt(
         goto EXIT;
     }
 
-    switch ((int)nIndex) {
-    case OMX_IndexConfigVideoQPRange:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((6 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexConfigVideoQPRange;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 6;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"I-minQP");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"I-maxQP");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[2].cKey, (OMX_PTR)"P-minQP");
-            pVendorExt->param[2].eValueType = OMX_AndroidVendorValueInt32;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[3].cKey, (OMX_PTR)"P-maxQP");
-            pVendorExt->param[3].eValueType = OMX_AndroidVendorValueInt32;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[4].cKey, (OMX_PTR)"B-minQP");
-            pVendorExt->param[4].eValueType = OMX_AndroidVendorValueInt32;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[5].cKey, (OMX_PTR)"B-maxQP");
-            pVendorExt->param[5].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamNumberRefPframes:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamNumberRefPframes;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"number");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamVideoEnableGPB:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoEnableGPB;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"enable");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexExynosParamBufferCopy:
-    {
-        int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-        pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-        if (pVendorExt == NULL) {
-            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-            ret = OMX_ErrorInsufficientResources;
-            goto EXIT;
-        }
-        Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-        InitOMXParams(pVendorExt, nSize);
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-        pVendorExt->nIndex          = (OMX_U32)OMX_IndexExynosParamBufferCopy;
-        pVendorExt->eDir            = OMX_DirOutput;
-        pVendorExt->nParamCount     = 1;
-
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"enable");
-        pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-        pVendorExts[nSlotIndex] = pVendorExt;
-    }
-        break;
-    case OMX_IndexParamVideoDropControl:
-    {
-        int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-        pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-        if (pVendorExt == NULL) {
-            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-            ret = OMX_ErrorInsufficientResources;
-            goto EXIT;
-        }
-        Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-        InitOMXParams(pVendorExt, nSize);
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-        pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoDropControl;
-        pVendorExt->eDir            = OMX_DirInput;
-        pVendorExt->nParamCount     = 1;
-
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"enable");
-        pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-        pVendorExts[nSlotIndex] = pVendorExt;
-    }
-        break;
-    case OMX_IndexParamVideoDisableDFR:
-    {
-        int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-        pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-        if (pVendorExt == NULL) {
-            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-            ret = OMX_ErrorInsufficientResources;
-            goto EXIT;
-        }
-        Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-        InitOMXParams(pVendorExt, nSize);
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-        pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoDisableDFR;
-        pVendorExt->eDir            = OMX_DirInput;
-        pVendorExt->nParamCount     = 1;
-
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"disable");
-        pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-        pVendorExts[nSlotIndex] = pVendorExt;
-    }
-        break;
-    case OMX_IndexParamVideoCompressedColorFormat:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_DEC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_DEC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoCompressedColorFormat;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"value");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamVideoChromaQP:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoChromaQP;
-            pVendorExt->eDir            = OMX_DirInput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"cr");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"cb");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamVideoDisableHBEncoding:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoDisableHBEncoding;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"disable");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-#ifdef USE_SKYPE_HD
-    case OMX_IndexSkypeParamDriverVersion:
-    {
-        int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-        pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-        if (pVendorExt == NULL) {
-            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-            ret = OMX_ErrorInsufficientResources;
-            goto EXIT;
-        }
-        Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-        InitOMXParams(pVendorExt, nSize);
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-        pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamDriverVersion;
-        pVendorExt->eDir            = OMX_DirOutput;
-        pVendorExt->nParamCount     = 1;
-
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"number");
-        pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-        pVendorExts[nSlotIndex] = pVendorExt;
-    }
-        break;
-    case OMX_IndexSkypeParamLowLatency:
-    {
-        int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-        pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-        if (pVendorExt == NULL) {
-            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-            ret = OMX_ErrorInsufficientResources;
-            goto EXIT;
-        }
-        Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-        InitOMXParams(pVendorExt, nSize);
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-        pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamLowLatency;
-        pVendorExt->eDir            = OMX_DirOutput;
-        pVendorExt->nParamCount     = 1;
-
-        Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"enable");
-        pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-        pVendorExts[nSlotIndex] = pVendorExt;
-    }
-        break;
-    case OMX_IndexSkypeParamEncoderMaxTemporalLayerCount:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderMaxTemporalLayerCount;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"max-p-count");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"max-b-count");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeParamEncoderMaxLTR:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderMaxLTR;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"max-count");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeParamEncoderLTR:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderLTR;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"num-ltr-frames");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeParamEncoderPreprocess:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderPreprocess;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"max-downscale-factor");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"rotation");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamVideoProfileLevelCurrent:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoProfileLevelCurrent;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"profile");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"level");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeParamEncoderSar:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderSar;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"width");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"height");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexParamVideoAvc:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexParamVideoAvc;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"spacing");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeConfigEncoderLTR:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeConfigEncoderLTR;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"mark-frame");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"use-frame");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeConfigQP:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeConfigQP;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"value");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeConfigBasePid:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeConfigBasePid;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"value");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
+    pDesc = Exynos_OSAL_FindVendorExtDesc((OMX_U32)nIndex);
+    if (pDesc == NULL)
+        goto EXIT;
 
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
+    if (!(pDesc->nCodecMask & VENDOR_EXT_CODEC(pExynosComponent->codecType))) {
+        ret = OMX_ErrorUnsupportedIndex;
+        goto EXIT;
     }
-        break;
-    case OMX_IndexSkypeParamEncoderInputControl:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamEncoderInputControl;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
 
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"enable");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    case OMX_IndexSkypeConfigEncoderInputTrigger:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
-
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeConfigEncoderInputTrigger;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"timestamp");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt64;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
+    if (Exynos_OSAL_Strlen(cExtName) >= OMX_MAX_STRINGNAME_SIZE) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
     }
-        break;
-    case OMX_IndexSkypeParamVideoBitrate:
-    {
-        if ((pExynosComponent->codecType == HW_VIDEO_ENC_CODEC) ||
-            (pExynosComponent->codecType == HW_VIDEO_ENC_SECURE_CODEC)) {
-
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE) + ((2 - 1) * sizeof(OMX_CONFIG_ANDROID_VENDOR_PARAMTYPE));
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
-
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
 
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexSkypeParamVideoBitrate;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 2;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"value");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[1].cKey, (OMX_PTR)"bitrate");
-            pVendorExt->param[1].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
+    pVendorExt = (EXYNOS_OSAL_VENDOR_EXT *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_VENDOR_EXT));
+    if (pVendorExt == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%p] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
     }
-        break;
-#endif  // USE_SKYPE_HD
-    case OMX_IndexExynosParamImageConvertMode:
-    {
-        if (pExynosComponent->codecType == HW_VIDEO_DEC_CODEC) {
-            int nSize = sizeof(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
-
-            pVendorExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)Exynos_OSAL_Malloc(nSize);
-            if (pVendorExt == NULL) {
-                Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s][%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__, pExynosComponent);
-                ret = OMX_ErrorInsufficientResources;
-                goto EXIT;
-            }
-            Exynos_OSAL_Memset(pVendorExt, 0, nSize);
 
-            InitOMXParams(pVendorExt, nSize);
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->cName, (OMX_PTR)cExtName);
+    pVendorExt->pDesc       = pDesc;
+    pVendorExt->nNameHash   = Exynos_OSAL_HashString(cExtName);
+    pVendorExt->pName       = cExtName;
+    pVendorExt->pConfig     = NULL;
 
-            pVendorExt->nIndex          = (OMX_U32)OMX_IndexExynosParamImageConvertMode;
-            pVendorExt->eDir            = OMX_DirOutput;
-            pVendorExt->nParamCount     = 1;
-
-            Exynos_OSAL_Strcpy((OMX_PTR)pVendorExt->param[0].cKey, (OMX_PTR)"value");
-            pVendorExt->param[0].eValueType = OMX_AndroidVendorValueInt32;
-
-            pVendorExts[nSlotIndex] = pVendorExt;
-        } else {
-            ret = OMX_ErrorUnsupportedIndex;
-            goto EXIT;
-        }
-    }
-        break;
-    default:
-        break;
-    }
+    pVendorExts[nSlotIndex] = pVendorExt;
 
     Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s][%p] vendor extension(name:%s, index:0x%x) is added",
                                             __FUNCTION__, pExynosComponent, cExtName, nIndex);
@@ -3845,7 +3228,7 @@ void Exynos_OSAL_DelVendorExts(OMX_HANDLETYPE hComponent)
     OMX_COMPONENTTYPE                       *pOMXComponent      = NULL;
     EXYNOS_OMX_BASECOMPONENT                *pExynosComponent   = NULL;
     OMX_PTR                                 *pVendorExts        = NULL;
-    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pVendorExt         = NULL;
+    EXYNOS_OSAL_VENDOR_EXT                  *pVendorExt         = NULL;
 
     OMX_U32 i;
 
@@ -3869,8 +3252,12 @@ void Exynos_OSAL_DelVendorExts(OMX_HANDLETYPE hComponent)
     pVendorExts = pExynosComponent->vendorExts;
 
     for (i = 0; i < MAX_VENDOR_EXT_NUM; i++) {
-        if (pVendorExts[i] != NULL) {
-            Exynos_OSAL_Free(pVendorExts[i]);
+        pVendorExt = (EXYNOS_OSAL_VENDOR_EXT *)pVendorExts[i];
+        if (pVendorExt != NULL) {
+            if (pVendorExt->pConfig != NULL)
+                Exynos_OSAL_Free(pVendorExt->pConfig);
+
+            Exynos_OSAL_Free(pVendorExt);
             pVendorExts[i] = NULL;
         }
     }
@@ -3921,7 +3308,11 @@ OMX_ERRORTYPE Exynos_OSAL_GetVendorExt(
         goto EXIT;
     }
 
-    pSrcExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)pExynosComponent->vendorExts[pDstExt->nIndex];
+    pSrcExt = Exynos_OSAL_GetVendorExtConfig(pExynosComponent, (EXYNOS_OSAL_VENDOR_EXT *)pExynosComponent->vendorExts[pDstExt->nIndex]);
+    if (pSrcExt == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
 
     ret = Exynos_OMX_Check_SizeVersion(pDstExt, pSrcExt->nSize);
     if (ret != OMX_ErrorNone) {
@@ -4053,6 +3444,26 @@ OMX_ERRORTYPE Exynos_OSAL_GetVendorExt(
         }
     }
         break;
+    case OMX_IndexParamEnableKeyFrameOnlyMode:
+    {
+        OMX_CONFIG_BOOLEANTYPE keyFrameOnly;
+
+        Exynos_OSAL_Memset(&keyFrameOnly, 0, sizeof(keyFrameOnly));
+        InitOMXParams(&keyFrameOnly, sizeof(keyFrameOnly));
+
+        ret = pOMXComponent->GetParameter(hComponent, (OMX_INDEXTYPE)pSrcExt->nIndex, (OMX_PTR)&keyFrameOnly);
+        if (ret == OMX_ErrorNone) {
+            Exynos_OSAL_Memcpy(pDstExt->cName, pSrcExt->cName, sizeof(pDstExt->cName));
+            pDstExt->eDir = pSrcExt->eDir;
+            pDstExt->nParamCount = pSrcExt->nParamCount;
+
+            Exynos_OSAL_Memcpy(pDstExt->param[0].cKey, pSrcExt->param[0].cKey, sizeof(pSrcExt->param[0].cKey));
+            pDstExt->param[0].eValueType    = pSrcExt->param[0].eValueType;
+            pDstExt->param[0].bSet          = OMX_TRUE;
+            pDstExt->param[0].nInt32        = keyFrameOnly.bEnabled;
+        }
+    }
+        break;
     case OMX_IndexParamVideoDisableDFR:
     {
         OMX_CONFIG_BOOLEANTYPE disableDFR;
@@ -4420,6 +3831,49 @@ OMX_ERRORTYPE Exynos_OSAL_GetVendorExt(
     }
         break;
 #endif  // USE_SKYPE_HD
+    case OMX_IndexConfigVideoPipelineMetrics:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS metrics;
+        OMX_U32 *pValues = &metrics.nInputQueued;
+
+        Exynos_OSAL_Memset(&metrics, 0, sizeof(metrics));
+        InitOMXParams(&metrics, sizeof(metrics));
+
+        ret = pOMXComponent->GetConfig(hComponent, (OMX_INDEXTYPE)pSrcExt->nIndex, (OMX_PTR)&metrics);
+        if (ret == OMX_ErrorNone) {
+            Exynos_OSAL_Memcpy(pDstExt->cName, pSrcExt->cName, sizeof(pDstExt->cName));
+            pDstExt->eDir = pSrcExt->eDir;
+            pDstExt->nParamCount = pSrcExt->nParamCount;
+
+            for (i = 0; i < pSrcExt->nParamCount; i++) {
+                Exynos_OSAL_Memcpy(pDstExt->param[i].cKey, pSrcExt->param[i].cKey, sizeof(pSrcExt->param[i].cKey));
+                pDstExt->param[i].eValueType = pSrcExt->param[i].eValueType;
+                pDstExt->param[i].bSet       = OMX_TRUE;
+                pDstExt->param[i].nInt32     = (OMX_S32)pValues[i];
+            }
+        }
+    }
+        break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE trimMemory;
+
+        Exynos_OSAL_Memset(&trimMemory, 0, sizeof(trimMemory));
+        InitOMXParams(&trimMemory, sizeof(trimMemory));
+
+        ret = pOMXComponent->GetConfig(hComponent, (OMX_INDEXTYPE)pSrcExt->nIndex, (OMX_PTR)&trimMemory);
+        if (ret == OMX_ErrorNone) {
+            Exynos_OSAL_Memcpy(pDstExt->cName, pSrcExt->cName, sizeof(pDstExt->cName));
+            pDstExt->eDir = pSrcExt->eDir;
+            pDstExt->nParamCount = pSrcExt->nParamCount;
+
+            Exynos_OSAL_Memcpy(pDstExt->param[0].cKey, pSrcExt->param[0].cKey, sizeof(pSrcExt->param[0].cKey));
+            pDstExt->param[0].eValueType    = pSrcExt->param[0].eValueType;
+            pDstExt->param[0].bSet          = OMX_TRUE;
+            pDstExt->param[0].nInt32        = trimMemory.bEnabled;
+        }
+    }
+        break;
     default:
         break;
     }
@@ -4439,8 +3893,10 @@ OMX_ERRORTYPE Exynos_OSAL_SetVendorExt(
     EXYNOS_OMX_BASECOMPONENT                *pExynosComponent   = NULL;
     OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pDstExt            = NULL;
     OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pSrcExt            = NULL;
+    EXYNOS_OSAL_VENDOR_EXT                  *pVendorExt         = NULL;
 
     OMX_U32 i;
+    OMX_U32 nNameHash = 0;
 
     FunctionIn();
 
@@ -4464,24 +3920,33 @@ OMX_ERRORTYPE Exynos_OSAL_SetVendorExt(
 
     pSrcExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)pConfig;
 
+    nNameHash = Exynos_OSAL_HashString((const char *)pSrcExt->cName);
+
     for (i = 0; i < MAX_VENDOR_EXT_NUM; i++) {
-        pDstExt = (OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *)pExynosComponent->vendorExts[i];
-        if (pDstExt == NULL)
+        pVendorExt = (EXYNOS_OSAL_VENDOR_EXT *)pExynosComponent->vendorExts[i];
+        if (pVendorExt == NULL)
             break;
 
-        if (!Exynos_OSAL_Strcmp(pDstExt->cName, pSrcExt->cName))
+        if ((pVendorExt->nNameHash == nNameHash) &&
+            (!Exynos_OSAL_Strcmp((OMX_PTR)pVendorExt->pName, (OMX_PTR)pSrcExt->cName)))
             break;
 
-        pDstExt = NULL;
+        pVendorExt = NULL;
     }
 
-    if (pDstExt == NULL) {
+    if (pVendorExt == NULL) {
         Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%p][%s] vendor extension(name:%s) is not supported",
                                             __FUNCTION__, pExynosComponent, pSrcExt->cName);
         ret = OMX_ErrorUnsupportedSetting;
         goto EXIT;
     }
 
+    pDstExt = Exynos_OSAL_GetVendorExtConfig(pExynosComponent, pVendorExt);
+    if (pDstExt == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
     ret = Exynos_OMX_Check_SizeVersion(pSrcExt, pDstExt->nSize);
     if (ret != OMX_ErrorNone)
         goto EXIT;
@@ -4595,6 +4060,21 @@ OMX_ERRORTYPE Exynos_OSAL_SetVendorExt(
         ret = pOMXComponent->SetParameter(hComponent, (OMX_INDEXTYPE)pDstExt->nIndex, (OMX_PTR)&dropControl);
     }
         break;
+    case OMX_IndexParamEnableKeyFrameOnlyMode:
+    {
+        OMX_CONFIG_BOOLEANTYPE keyFrameOnly;
+
+        Exynos_OSAL_Memset(&keyFrameOnly, 0, sizeof(keyFrameOnly));
+        InitOMXParams(&keyFrameOnly, sizeof(keyFrameOnly));
+
+        if (pSrcExt->param[0].bSet == OMX_TRUE) {
+            if (!Exynos_OSAL_Strcmp((OMX_PTR)pSrcExt->param[0].cKey, (OMX_PTR)"enable"))
+                keyFrameOnly.bEnabled = (OMX_BOOL)pSrcExt->param[0].nInt32;
+        }
+
+        ret = pOMXComponent->SetParameter(hComponent, (OMX_INDEXTYPE)pDstExt->nIndex, (OMX_PTR)&keyFrameOnly);
+    }
+        break;
     case OMX_IndexParamVideoDisableDFR:
     {
         OMX_CONFIG_BOOLEANTYPE disableDFR;
@@ -4911,6 +4391,27 @@ OMX_ERRORTYPE Exynos_OSAL_SetVendorExt(
     }
         break;
 #endif  // USE_SKYPE_HD
+    case OMX_IndexConfigVideoPipelineMetrics:
+    {
+        /* read only */
+        ret = OMX_ErrorUnsupportedSetting;
+    }
+        break;
+    case OMX_IndexConfigTrimMemory:
+    {
+        OMX_CONFIG_BOOLEANTYPE trimMemory;
+
+        Exynos_OSAL_Memset(&trimMemory, 0, sizeof(trimMemory));
+        InitOMXParams(&trimMemory, sizeof(trimMemory));
+
+        if (pSrcExt->param[0].bSet == OMX_TRUE) {
+            if (!Exynos_OSAL_Strcmp((OMX_PTR)pSrcExt->param[0].cKey, (OMX_PTR)"enable"))
+                trimMemory.bEnabled = (OMX_BOOL)pSrcExt->param[0].nInt32;
+        }
+
+        ret = pOMXComponent->SetConfig(hComponent, (OMX_INDEXTYPE)pDstExt->nIndex, (OMX_PTR)&trimMemory);
+    }
+        break;
     default:
         break;
     }
@@ -60,6 +60,7 @@ void Exynos_OSAL_ColorSpaceToColorAspects(int colorSpace, EXYNOS_OMX_VIDEO_COLOR
 OMX_ERRORTYPE setHDR10PlusInfoForFramework(OMX_COMPONENTTYPE *pOMXComponent, void *pHDRDynamicInfo);
 OMX_ERRORTYPE setHDR10PlusInfoForVendorPath(OMX_COMPONENTTYPE *pOMXComponent, void *pExynosHDR10PlusInfo, void *pHDRDynamicInfo);
 
+/* cExtName is kept, not copied. it must live as long as the component, e.g. a string literal */
 OMX_ERRORTYPE Exynos_OSAL_AddVendorExt(OMX_HANDLETYPE hComponent, OMX_STRING cExtName, OMX_INDEXTYPE nIndex);
 void          Exynos_OSAL_DelVendorExts(OMX_HANDLETYPE hComponent);
 OMX_ERRORTYPE Exynos_OSAL_GetVendorExt(OMX_HANDLETYPE hComponent, OMX_PTR pConfig);
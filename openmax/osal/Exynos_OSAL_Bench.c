@@ -0,0 +1,422 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_Bench.c
+ * @brief       per component throughput/latency statistics
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_Bench.h"
+
+#undef  EXYNOS_LOG_TAG
+#define EXYNOS_LOG_TAG    "EXYNOS_OSAL_BENCH"
+//#define EXYNOS_LOG_OFF
+#include "Exynos_OSAL_Log.h"
+
+typedef struct _BENCH_LATENCY_SLOT
+{
+    OMX_BOOL  bUsed;
+    OMX_TICKS timeStamp;
+    OMX_U64   nInTimeUs;
+} BENCH_LATENCY_SLOT;
+
+typedef struct _EXYNOS_OSAL_BENCH
+{
+    OMX_HANDLETYPE      hMutex;
+    OMX_PTR             pOwner;
+
+    OMX_U64             nStartTimeUs;   /* first input */
+    OMX_U64             nLastTimeUs;    /* last output */
+    OMX_U32             nInputCount;
+    OMX_U32             nOutputCount;
+
+    BENCH_LATENCY_SLOT  slot[BENCH_LATENCY_SLOT_MAX];
+    OMX_U32             nSlotIndex;
+    OMX_U32             histogram[BENCH_LATENCY_HISTO_MAX + 1];
+    OMX_U32             nLatencyCount;
+    OMX_U64             nLatencySumUs;
+    OMX_U64             nLatencyMaxUs;
+
+    OMX_U64             nThreadCpuUs[BENCH_THREAD_MAX];
+
+    OMX_U64             nPhaseUs[BENCH_PHASE_MAX];
+    OMX_U64             nExecutingTimeUs;
+} EXYNOS_OSAL_BENCH;
+
+static const char *benchThreadName[BENCH_THREAD_MAX] = {
+    "SrcIn", "SrcOut", "DstIn", "DstOut",
+};
+
+static const char *benchPhaseName[BENCH_PHASE_MAX] = {
+    "GetHandle", "Loaded->Idle", "Idle->Executing", "first frame",
+};
+
+static OMX_BOOL Exynos_OSAL_Bench_Enabled(void)
+{
+#ifdef USE_ANDROID
+    char benchProp[PROPERTY_VALUE_MAX] = { 0, };
+
+    if ((property_get("debug.omx.bench", benchProp, NULL) > 0) &&
+        (benchProp[0] == '1'))
+        return OMX_TRUE;
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_BENCH");
+
+    if ((pEnv != NULL) &&
+        (pEnv[0] == '1'))
+        return OMX_TRUE;
+#endif
+
+    return OMX_FALSE;
+}
+
+static OMX_U32 Exynos_OSAL_Bench_GetStatus(const char *pKey)
+{
+    FILE    *fp     = NULL;
+    char     line[128];
+    size_t   nLen   = strlen(pKey);
+    OMX_U32  nValue = 0;
+
+    fp = fopen("/proc/self/status", "r");
+    if (fp == NULL)
+        return 0;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, pKey, nLen) == 0) {
+            nValue = (OMX_U32)strtoul(line + nLen, NULL, 10);
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    return nValue;
+}
+
+static OMX_U64 Exynos_OSAL_Bench_ThreadCpuUs(void)
+{
+    struct timespec cpuTime;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) != 0)
+        return 0;
+
+    return ((OMX_U64)cpuTime.tv_sec * 1000000) + ((OMX_U64)cpuTime.tv_nsec / 1000);
+}
+
+static OMX_U32 Exynos_OSAL_Bench_Percentile(
+    EXYNOS_OSAL_BENCH   *pBench,
+    OMX_U32              nPercent)
+{
+    OMX_U64 nTarget = ((OMX_U64)pBench->nLatencyCount * nPercent + 99) / 100;
+    OMX_U64 nSum    = 0;
+    int     i;
+
+    if (pBench->nLatencyCount == 0)
+        return 0;
+
+    for (i = 0; i <= BENCH_LATENCY_HISTO_MAX; i++) {
+        nSum += pBench->histogram[i];
+        if (nSum >= nTarget)
+            return (OMX_U32)i;
+    }
+
+    return BENCH_LATENCY_HISTO_MAX;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_BenchCreate(
+    OMX_HANDLETYPE  *pBenchHandle,
+    OMX_PTR          pOwner)
+{
+    OMX_ERRORTYPE        ret    = OMX_ErrorNone;
+    EXYNOS_OSAL_BENCH   *pBench = NULL;
+
+    if (pBenchHandle == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    *pBenchHandle = NULL;
+
+    /* the handle stays NULL when disabled, every hook then returns at once */
+    if (Exynos_OSAL_Bench_Enabled() != OMX_TRUE)
+        goto EXIT;
+
+    pBench = (EXYNOS_OSAL_BENCH *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_BENCH));
+    if (pBench == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    Exynos_OSAL_Memset(pBench, 0, sizeof(EXYNOS_OSAL_BENCH));
+
+    ret = Exynos_OSAL_MutexCreate(&pBench->hMutex);
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Free(pBench);
+        goto EXIT;
+    }
+
+    pBench->pOwner = pOwner;
+    *pBenchHandle  = (OMX_HANDLETYPE)pBench;
+
+EXIT:
+    return ret;
+}
+
+void Exynos_OSAL_BenchTerminate(OMX_HANDLETYPE *pBenchHandle)
+{
+    EXYNOS_OSAL_BENCH *pBench = NULL;
+
+    if ((pBenchHandle == NULL) ||
+        (*pBenchHandle == NULL))
+        return;
+
+    pBench = (EXYNOS_OSAL_BENCH *)*pBenchHandle;
+
+    Exynos_OSAL_BenchReport((OMX_HANDLETYPE)pBench);
+
+    Exynos_OSAL_MutexTerminate(pBench->hMutex);
+    Exynos_OSAL_Free(pBench);
+
+    *pBenchHandle = NULL;
+}
+
+void Exynos_OSAL_BenchInput(
+    OMX_HANDLETYPE  hBench,
+    OMX_TICKS       timeStamp)
+{
+    EXYNOS_OSAL_BENCH   *pBench = (EXYNOS_OSAL_BENCH *)hBench;
+    BENCH_LATENCY_SLOT  *pSlot  = NULL;
+    OMX_U64              nNowUs = 0;
+
+    if (pBench == NULL)
+        return;
+
+    nNowUs = Exynos_OSAL_GetSystemTimeUs();
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+
+    if (pBench->nInputCount == 0)
+        pBench->nStartTimeUs = nNowUs;
+    pBench->nInputCount++;
+
+    /* the oldest slot is recycled when the client never gets it back */
+    pSlot = &pBench->slot[pBench->nSlotIndex];
+    pSlot->bUsed     = OMX_TRUE;
+    pSlot->timeStamp = timeStamp;
+    pSlot->nInTimeUs = nNowUs;
+    pBench->nSlotIndex = (pBench->nSlotIndex + 1) % BENCH_LATENCY_SLOT_MAX;
+
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+}
+
+void Exynos_OSAL_BenchOutput(
+    OMX_HANDLETYPE  hBench,
+    OMX_TICKS       timeStamp)
+{
+    EXYNOS_OSAL_BENCH   *pBench     = (EXYNOS_OSAL_BENCH *)hBench;
+    OMX_U64              nNowUs     = 0;
+    OMX_U64              nLatencyUs = 0;
+    OMX_U32              nBucket    = 0;
+    int                  i;
+
+    if (pBench == NULL)
+        return;
+
+    nNowUs = Exynos_OSAL_GetSystemTimeUs();
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+
+    if ((pBench->nOutputCount == 0) &&
+        (pBench->nExecutingTimeUs != 0))
+        pBench->nPhaseUs[BENCH_PHASE_FIRST_FRAME] = nNowUs - pBench->nExecutingTimeUs;
+
+    pBench->nOutputCount++;
+    pBench->nLastTimeUs = nNowUs;
+
+    for (i = 0; i < BENCH_LATENCY_SLOT_MAX; i++) {
+        if ((pBench->slot[i].bUsed == OMX_TRUE) &&
+            (pBench->slot[i].timeStamp == timeStamp)) {
+            nLatencyUs = nNowUs - pBench->slot[i].nInTimeUs;
+            pBench->slot[i].bUsed = OMX_FALSE;
+
+            nBucket = (OMX_U32)(nLatencyUs / 1000);
+            if (nBucket > BENCH_LATENCY_HISTO_MAX)
+                nBucket = BENCH_LATENCY_HISTO_MAX;
+
+            pBench->histogram[nBucket]++;
+            pBench->nLatencyCount++;
+            pBench->nLatencySumUs += nLatencyUs;
+            if (nLatencyUs > pBench->nLatencyMaxUs)
+                pBench->nLatencyMaxUs = nLatencyUs;
+            break;
+        }
+    }
+
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+}
+
+void Exynos_OSAL_BenchThreadDone(
+    OMX_HANDLETYPE      hBench,
+    BENCH_THREAD_TYPE   eThread)
+{
+    EXYNOS_OSAL_BENCH   *pBench     = (EXYNOS_OSAL_BENCH *)hBench;
+    OMX_U64              nCpuTimeUs = 0;
+
+    if ((pBench == NULL) ||
+        (eThread >= BENCH_THREAD_MAX))
+        return;
+
+    /* must be called by the thread itself, right before it exits */
+    nCpuTimeUs = Exynos_OSAL_Bench_ThreadCpuUs();
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+    pBench->nThreadCpuUs[eThread] += nCpuTimeUs;
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+}
+
+OMX_U64 Exynos_OSAL_BenchStepBegin(OMX_HANDLETYPE hBench)
+{
+    if (hBench == NULL)
+        return 0;
+
+    return Exynos_OSAL_Bench_ThreadCpuUs();
+}
+
+void Exynos_OSAL_BenchStepEnd(
+    OMX_HANDLETYPE      hBench,
+    BENCH_THREAD_TYPE   eThread,
+    OMX_U64             nBeginUs)
+{
+    EXYNOS_OSAL_BENCH   *pBench     = (EXYNOS_OSAL_BENCH *)hBench;
+    OMX_U64              nCpuTimeUs = 0;
+
+    if ((pBench == NULL) ||
+        (eThread >= BENCH_THREAD_MAX))
+        return;
+
+    /* a pool thread runs steps of many workers, so only the step itself is charged */
+    nCpuTimeUs = Exynos_OSAL_Bench_ThreadCpuUs();
+    if (nCpuTimeUs <= nBeginUs)
+        return;
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+    pBench->nThreadCpuUs[eThread] += (nCpuTimeUs - nBeginUs);
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+}
+
+void Exynos_OSAL_BenchPhase(
+    OMX_HANDLETYPE      hBench,
+    BENCH_PHASE_TYPE    ePhase,
+    OMX_U64             nDurationUs)
+{
+    EXYNOS_OSAL_BENCH *pBench = (EXYNOS_OSAL_BENCH *)hBench;
+
+    if ((pBench == NULL) ||
+        (ePhase >= BENCH_PHASE_FIRST_FRAME))
+        return;
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+
+    /* only the first run of each phase counts toward startup */
+    if (pBench->nPhaseUs[ePhase] == 0)
+        pBench->nPhaseUs[ePhase] = nDurationUs;
+
+    if ((ePhase == BENCH_PHASE_IDLE_TO_EXECUTING) &&
+        (pBench->nExecutingTimeUs == 0))
+        pBench->nExecutingTimeUs = Exynos_OSAL_GetSystemTimeUs();
+
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+}
+
+void Exynos_OSAL_BenchReport(OMX_HANDLETYPE hBench)
+{
+    EXYNOS_OSAL_BENCH   *pBench     = (EXYNOS_OSAL_BENCH *)hBench;
+    OMX_U64              nElapsedUs = 0;
+    OMX_U32              nFps100    = 0;    /* fps x 100 */
+    OMX_U32              nAvgMs     = 0;
+    struct rusage        usage;
+    int                  i;
+
+    if (pBench == NULL)
+        return;
+
+    Exynos_OSAL_MutexLock(pBench->hMutex);
+
+    if (pBench->nLastTimeUs > pBench->nStartTimeUs)
+        nElapsedUs = pBench->nLastTimeUs - pBench->nStartTimeUs;
+
+    if (nElapsedUs > 0)
+        nFps100 = (OMX_U32)(((OMX_U64)pBench->nOutputCount * 100000000) / nElapsedUs);
+
+    if (pBench->nLatencyCount > 0)
+        nAvgMs = (OMX_U32)((pBench->nLatencySumUs / pBench->nLatencyCount) / 1000);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] frames in(%d) out(%d) for %lld ms, %d.%02d fps",
+                                            pBench->pOwner, __FUNCTION__,
+                                            pBench->nInputCount, pBench->nOutputCount,
+                                            (long long)(nElapsedUs / 1000), nFps100 / 100, nFps100 % 100);
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] latency(ms) avg(%d) p50(%d) p90(%d) p99(%d) max(%lld), samples(%d)",
+                                            pBench->pOwner, __FUNCTION__, nAvgMs,
+                                            Exynos_OSAL_Bench_Percentile(pBench, 50),
+                                            Exynos_OSAL_Bench_Percentile(pBench, 90),
+                                            Exynos_OSAL_Bench_Percentile(pBench, 99),
+                                            (long long)(pBench->nLatencyMaxUs / 1000), pBench->nLatencyCount);
+
+    for (i = 0; i < BENCH_THREAD_MAX; i++) {
+        if (pBench->nThreadCpuUs[i] == 0)
+            continue;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] %s thread cpu time %lld us (%lld us/frame)",
+                                                pBench->pOwner, __FUNCTION__, benchThreadName[i],
+                                                (long long)pBench->nThreadCpuUs[i],
+                                                (long long)((pBench->nOutputCount > 0)? (pBench->nThreadCpuUs[i] / pBench->nOutputCount):0));
+    }
+
+    for (i = 0; i < BENCH_PHASE_MAX; i++) {
+        if (pBench->nPhaseUs[i] == 0)
+            continue;
+
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] startup %s %lld us",
+                                                pBench->pOwner, __FUNCTION__, benchPhaseName[i],
+                                                (long long)pBench->nPhaseUs[i]);
+    }
+
+    Exynos_OSAL_MutexUnlock(pBench->hMutex);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] process memory high-water mark %d kB",
+                                            pBench->pOwner, __FUNCTION__, Exynos_OSAL_Bench_GetStatus("VmHWM:"));
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] process threads(%d) context switches voluntary(%ld) involuntary(%ld)",
+                                                pBench->pOwner, __FUNCTION__, Exynos_OSAL_Bench_GetStatus("Threads:"),
+                                                (long)usage.ru_nvcsw, (long)usage.ru_nivcsw);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_Bench.h
+ * @brief       per component throughput/latency statistics
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef Exynos_OSAL_BENCH
+#define Exynos_OSAL_BENCH
+
+#include "OMX_Types.h"
+#include "OMX_Core.h"
+
+/* enabled by "debug.omx.bench" property (EXYNOS_OMX_BENCH env on non-android) */
+#define BENCH_LATENCY_SLOT_MAX      64
+#define BENCH_LATENCY_HISTO_MAX     1000    /* 1ms step, the last bucket holds everything above */
+
+typedef enum _BENCH_THREAD_TYPE
+{
+    BENCH_THREAD_SRC_INPUT = 0,
+    BENCH_THREAD_SRC_OUTPUT,
+    BENCH_THREAD_DST_INPUT,
+    BENCH_THREAD_DST_OUTPUT,
+    BENCH_THREAD_MAX,
+} BENCH_THREAD_TYPE;
+
+typedef enum _BENCH_PHASE_TYPE
+{
+    BENCH_PHASE_GET_HANDLE = 0,
+    BENCH_PHASE_LOADED_TO_IDLE,
+    BENCH_PHASE_IDLE_TO_EXECUTING,
+    BENCH_PHASE_FIRST_FRAME,        /* Executing to the first output, filled in by the bench itself */
+    BENCH_PHASE_MAX,
+} BENCH_PHASE_TYPE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OMX_ERRORTYPE Exynos_OSAL_BenchCreate(OMX_HANDLETYPE *pBenchHandle, OMX_PTR pOwner);
+void Exynos_OSAL_BenchTerminate(OMX_HANDLETYPE *pBenchHandle);
+void Exynos_OSAL_BenchInput(OMX_HANDLETYPE hBench, OMX_TICKS timeStamp);
+void Exynos_OSAL_BenchOutput(OMX_HANDLETYPE hBench, OMX_TICKS timeStamp);
+void Exynos_OSAL_BenchThreadDone(OMX_HANDLETYPE hBench, BENCH_THREAD_TYPE eThread);
+OMX_U64 Exynos_OSAL_BenchStepBegin(OMX_HANDLETYPE hBench);
+void Exynos_OSAL_BenchStepEnd(OMX_HANDLETYPE hBench, BENCH_THREAD_TYPE eThread, OMX_U64 nBeginUs);
+void Exynos_OSAL_BenchPhase(OMX_HANDLETYPE hBench, BENCH_PHASE_TYPE ePhase, OMX_U64 nDurationUs);
+void Exynos_OSAL_BenchReport(OMX_HANDLETYPE hBench);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #ifdef USE_ANDROID
 #include <system/graphics.h>
 #else
@@ -45,7 +46,6 @@
 
 
 #ifdef PERFORMANCE_DEBUG
-#include <time.h>
 #include "Exynos_OSAL_Mutex.h"
 
 #define INPUT_PORT_INDEX    0
@@ -124,6 +124,25 @@ size_t Exynos_OSAL_Strlen(const char *str)
     return strlen(str);
 }
 
+OMX_U32 Exynos_OSAL_Hash(const void *pData, size_t nSize)
+{
+    const OMX_U8 *pByte = (const OMX_U8 *)pData;
+    OMX_U32       nHash = 2166136261U;
+    size_t        i;
+
+    for (i = 0; i < nSize; i++) {
+        nHash ^= pByte[i];
+        nHash *= 16777619U;
+    }
+
+    return nHash;
+}
+
+OMX_U32 Exynos_OSAL_HashString(const char *str)
+{
+    return Exynos_OSAL_Hash(str, strlen(str));
+}
+
 static OMX_S32 Exynos_OSAL_MeasureTime(struct timeval *start, struct timeval *stop)
 {
     signed long sec, usec, time;
@@ -202,6 +221,15 @@ void Exynos_OSAL_PerfPrint(OMX_STRING prefix, PERF_ID_TYPE id)
                 Exynos_OSAL_PerfOver30ms(id));
 }
 
+OMX_U64 Exynos_OSAL_GetSystemTimeUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((OMX_U64)now.tv_sec * 1000000) + ((OMX_U64)now.tv_nsec / 1000);
+}
+
 unsigned int Exynos_OSAL_GetPlaneCount(
     OMX_COLOR_FORMATTYPE eOMXFormat,
     PLANE_TYPE           ePlaneType)
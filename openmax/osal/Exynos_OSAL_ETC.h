@@ -48,6 +48,10 @@ const char* Exynos_OSAL_Strstr(const char *str1, const char *str2);
 size_t Exynos_OSAL_Strcat(OMX_PTR dest, OMX_PTR src);
 size_t Exynos_OSAL_Strlen(const char *str);
 
+/* FNV-1a, for table lookups and change detection only */
+OMX_U32 Exynos_OSAL_Hash(const void *pData, size_t nSize);
+OMX_U32 Exynos_OSAL_HashString(const char *str);
+
 /* perf */
 typedef enum _PERF_ID_TYPE {
     PERF_ID_CSC = 0,
@@ -66,6 +70,8 @@ OMX_U32 Exynos_OSAL_PerfFrameCount(PERF_ID_TYPE id);
 int Exynos_OSAL_PerfOver30ms(PERF_ID_TYPE id);
 void Exynos_OSAL_PerfPrint(OMX_STRING prefix, PERF_ID_TYPE id);
 
+OMX_U64 Exynos_OSAL_GetSystemTimeUs(void);
+
 unsigned int Exynos_OSAL_GetPlaneCount(OMX_COLOR_FORMATTYPE eOMXFormat, PLANE_TYPE ePlaneType);
 void Exynos_OSAL_GetPlaneSize(OMX_COLOR_FORMATTYPE eColorFormat, PLANE_TYPE ePlaneType, OMX_U32 nWidth, OMX_U32 nHeight, unsigned int nDataLen[MAX_BUFFER_PLANE], unsigned int nAllocLen[MAX_BUFFER_PLANE]);
 OMX_U32 Exynos_OSAL_GetOutBufferSize(OMX_U32 nWidth, OMX_U32 nHeight, OMX_U32 nDefaultBufferSize);
@@ -218,3 +218,119 @@ EXIT:
 
     return ret;
 }
+
+OMX_ERRORTYPE Exynos_OSAL_ConditionCreate(OMX_HANDLETYPE *conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond;
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    if (conditionHandle == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    cond = (Exynos_OSAL_THREADCONDITION *)Exynos_OSAL_Malloc(sizeof(Exynos_OSAL_THREADCONDITION));
+    if (!cond) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Memset(cond, 0, sizeof(Exynos_OSAL_THREADCONDITION));
+
+    ret = Exynos_OSAL_MutexCreate(&cond->mutex);
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Free(cond);
+        goto EXIT;
+    }
+
+    if (pthread_cond_init(&cond->condition, NULL)) {
+        Exynos_OSAL_MutexTerminate(cond->mutex);
+        Exynos_OSAL_Free(cond);
+        ret = OMX_ErrorUndefined;
+        goto EXIT;
+    }
+
+    *conditionHandle = (OMX_HANDLETYPE)cond;
+
+EXIT:
+    return ret;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_ConditionTerminate(OMX_HANDLETYPE conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond = (Exynos_OSAL_THREADCONDITION *)conditionHandle;
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    if (!cond) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (pthread_cond_destroy(&cond->condition)) {
+        ret = OMX_ErrorUndefined;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_MutexTerminate(cond->mutex);
+    Exynos_OSAL_Free(cond);
+
+EXIT:
+    return ret;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_ConditionLock(OMX_HANDLETYPE conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond = (Exynos_OSAL_THREADCONDITION *)conditionHandle;
+
+    if (!cond)
+        return OMX_ErrorBadParameter;
+
+    return Exynos_OSAL_MutexLock(cond->mutex);
+}
+
+OMX_ERRORTYPE Exynos_OSAL_ConditionUnlock(OMX_HANDLETYPE conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond = (Exynos_OSAL_THREADCONDITION *)conditionHandle;
+
+    if (!cond)
+        return OMX_ErrorBadParameter;
+
+    return Exynos_OSAL_MutexUnlock(cond->mutex);
+}
+
+/* ConditionLock must be held, it is released while sleeping */
+OMX_ERRORTYPE Exynos_OSAL_ConditionWait(OMX_HANDLETYPE conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond = (Exynos_OSAL_THREADCONDITION *)conditionHandle;
+
+    if (!cond)
+        return OMX_ErrorBadParameter;
+
+    if (pthread_cond_wait(&cond->condition, (pthread_mutex_t *)(cond->mutex)))
+        return OMX_ErrorUndefined;
+
+    return OMX_ErrorNone;
+}
+
+/* whatever the waiters test must be updated before this is called */
+OMX_ERRORTYPE Exynos_OSAL_ConditionBroadcast(OMX_HANDLETYPE conditionHandle)
+{
+    Exynos_OSAL_THREADCONDITION *cond = (Exynos_OSAL_THREADCONDITION *)conditionHandle;
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    if (!cond) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    ret = Exynos_OSAL_MutexLock(cond->mutex);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    pthread_cond_broadcast(&cond->condition);
+
+    Exynos_OSAL_MutexUnlock(cond->mutex);
+
+EXIT:
+    return ret;
+}
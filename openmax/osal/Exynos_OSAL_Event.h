@@ -41,6 +41,13 @@ typedef struct _Exynos_OSAL_THREADEVENT
     pthread_cond_t condition;
 } Exynos_OSAL_THREADEVENT;
 
+/* no stored signal: waiters re-check their own predicate under ConditionLock */
+typedef struct _Exynos_OSAL_THREADCONDITION
+{
+    OMX_HANDLETYPE mutex;
+    pthread_cond_t condition;
+} Exynos_OSAL_THREADCONDITION;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +60,13 @@ OMX_ERRORTYPE Exynos_OSAL_SignalReset(OMX_HANDLETYPE eventHandle);
 OMX_ERRORTYPE Exynos_OSAL_SignalSet(OMX_HANDLETYPE eventHandle);
 OMX_ERRORTYPE Exynos_OSAL_SignalWait(OMX_HANDLETYPE eventHandle, OMX_U32 ms);
 
+OMX_ERRORTYPE Exynos_OSAL_ConditionCreate(OMX_HANDLETYPE *conditionHandle);
+OMX_ERRORTYPE Exynos_OSAL_ConditionTerminate(OMX_HANDLETYPE conditionHandle);
+OMX_ERRORTYPE Exynos_OSAL_ConditionLock(OMX_HANDLETYPE conditionHandle);
+OMX_ERRORTYPE Exynos_OSAL_ConditionUnlock(OMX_HANDLETYPE conditionHandle);
+OMX_ERRORTYPE Exynos_OSAL_ConditionWait(OMX_HANDLETYPE conditionHandle);
+OMX_ERRORTYPE Exynos_OSAL_ConditionBroadcast(OMX_HANDLETYPE conditionHandle);
+
 
 #ifdef __cplusplus
 }
@@ -37,6 +37,10 @@
 #include "Exynos_OSAL_Library.h"
 #include "Exynos_OSAL_ETC.h"
 #include "Exynos_OSAL_Platform.h"
+#include "Exynos_OSAL_Thread.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_Event.h"
 
 #include "Exynos_OSAL_ImageConverter.h"
 
@@ -62,6 +66,8 @@ using namespace android;
 
 #define LUMINANCE_DIV_FACTOR 10000.0
 
+#define IMG_CONV_JOB_NUM    MAX_BUFFER_REF  /* no more than the output buffers */
+
 #define LIB_NAME            "libImageFormatConverter.so"
 #define LIB_FN_NAME_INIT    "CL_HDR2SDR_ARM_init"
 #define LIB_FN_NAME_DEINIT  "CL_HDR2SDR_ARM_deinit"
@@ -129,6 +135,15 @@ typedef OMX_BOOL (*ConvertInitFunc)(const unsigned int width, const unsigned int
 typedef void     (*ConvertDeinitFunc)(void *user_data);
 typedef OMX_BOOL (*ConvertRunFunc)(HDR2SDR_config_params_t *In_params, HDR2SDR_config_params_t *Out_params, HDR10PLUS_DYNAMIC_INFO *meta, unsigned int mastering_max_luminance, void *user_data);
 
+typedef struct _IMG_CONV_JOB {
+    OMX_COMPONENTTYPE       *pOMXComponent;
+    EXYNOS_OMX_DATABUFFER    dataBuffer;
+    OMX_PTR                  pBuffer;   /* NULL : nothing to convert, just keeps an order */
+    OMX_BOOL                 bHasDynamic;
+    HDR10PLUS_DYNAMIC_INFO   sDynamicInfo;
+    IMG_CONV_DONE_FUNC       pDoneFunc;
+} IMG_CONV_JOB;
+
 typedef struct _EXYNOS_OMX_IMG_CONV_HANDLE {
     void                    *pLibHandle;
     ConvertInitFunc          Init;
@@ -136,98 +151,85 @@ typedef struct _EXYNOS_OMX_IMG_CONV_HANDLE {
     ConvertRunFunc           Run;
     void                    *pUserData;
     OMX_BOOL                 bHasDynamicInfo;
-    HDR10PLUS_DYNAMIC_INFO  *pDynamicInfo;
+    HDR10PLUS_DYNAMIC_INFO   sDynamicInfo;  /* the latest one, used until the next */
+
+    /* worker, jobs are done in the order of request */
+    OMX_HANDLETYPE           hThread;
+    OMX_HANDLETYPE           hJobSem;
+    OMX_HANDLETYPE           hJobMutex;
+    OMX_HANDLETYPE           hIdleEvent;
+    IMG_CONV_JOB             jobs[IMG_CONV_JOB_NUM];
+    OMX_U32                  nJobHead;      /* worker only */
+    OMX_U32                  nJobTail;
+    OMX_U32                  nPendingJobs;
+    OMX_BOOL                 bSkipConvert;
+    OMX_BOOL                 bExitThread;
 } EXYNOS_OMX_IMG_CONV_HANDLE;
 
-
-OMX_HANDLETYPE Exynos_OSAL_ImgConv_Create(
-    OMX_U32 nWidth,
-    OMX_U32 nHeight,
-    OMX_U32 nMode)
+static void ImgConv_DeriveDynamicInfo(
+    ExynosHdrDynamicInfo    *DY,
+    HDR10PLUS_DYNAMIC_INFO  *pInfo)
 {
-    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = NULL;
+    HDR10PLUS_DYNAMIC_INFO &info = *pInfo;
 
-    pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_IMG_CONV_HANDLE));
-    if (pHandle == NULL) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__);
-        goto EXIT;
-    }
+    memset(&info, 0, sizeof(info));
 
-    pHandle->pDynamicInfo = (HDR10PLUS_DYNAMIC_INFO *)Exynos_OSAL_Malloc(sizeof(HDR10PLUS_DYNAMIC_INFO));
-    if (pHandle->pDynamicInfo == NULL) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__);
-        Exynos_OSAL_Free(pHandle);
-        pHandle = NULL;
-        goto EXIT;
+    info.country_code           = DY->data.country_code;
+    info.provider_code          = DY->data.provider_code;
+    info.provider_oriented_code = DY->data.provider_oriented_code;
+    info.application_identifier = DY->data.application_identifier;
+    info.application_version    = DY->data.application_version;
+#ifdef USE_FULL_ST2094_40
+    info.display_max_luminance  = DY->data.targeted_system_display_maximum_luminance;
+    for (int i = 0; i < 3; i++) {
+        info.maxscl[i] = DY->data.maxscl[0][i];
     }
 
-    pHandle->pLibHandle = Exynos_OSAL_dlopen(LIB_NAME, RTLD_NOW|RTLD_GLOBAL);
-    if (pHandle->pLibHandle == NULL) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] Failed to Exynos_OSAL_dlopen() : reason(%s)",
-                                __FUNCTION__, Exynos_OSAL_dlerror());
-        Exynos_OSAL_Free(pHandle->pDynamicInfo);
-        Exynos_OSAL_Free(pHandle);
-        pHandle = NULL;
-        goto EXIT;
+    info.avg_maxrgb = DY->data.average_maxrgb[0];
+    info.num_maxrgb_percentiles = DY->data.num_maxrgb_percentiles[0];
+    for (int i = 0; i < info.num_maxrgb_percentiles; i++) {
+        info.maxrgb_percentages[i] = DY->data.maxrgb_percentages[0][i];
+        info.maxrgb_percentiles[i] = DY->data.maxrgb_percentiles[0][i];
     }
 
-    pHandle->Init   = (ConvertInitFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_INIT);
-    pHandle->Deinit = (ConvertDeinitFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_DEINIT);
-    pHandle->Run    = (ConvertRunFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_RUN);
+    info.tone_mapping_flag          = DY->data.tone_mapping.tone_mapping_flag[0];
+    info.knee_point_x               = DY->data.tone_mapping.knee_point_x[0];
+    info.knee_point_y               = DY->data.tone_mapping.knee_point_y[0];
+    info.num_bezier_curve_anchors   = DY->data.tone_mapping.num_bezier_curve_anchors[0];
 
-    if ((pHandle->Init == NULL) ||
-        (pHandle->Deinit == NULL) ||
-        (pHandle->Run == NULL)) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlsym()", __FUNCTION__);
-        Exynos_OSAL_dlclose(pHandle->pLibHandle);
-        Exynos_OSAL_Free(pHandle->pDynamicInfo);
-        Exynos_OSAL_Free(pHandle);
-        pHandle = NULL;
-        goto EXIT;
+    for (int i = 0; i < info.num_bezier_curve_anchors; i++) {
+        info.bezier_curve_anchors[i] = DY->data.tone_mapping.bezier_curve_anchors[0][i];
     }
-
-    if (pHandle->Init(nWidth, nHeight, ((nMode == 0)? NORMAL:HI_JACK), &pHandle->pUserData, false) != OMX_TRUE) {
-        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Init()", __FUNCTION__);
-        Exynos_OSAL_dlclose(pHandle->pLibHandle);
-        Exynos_OSAL_Free(pHandle->pDynamicInfo);
-        Exynos_OSAL_Free(pHandle);
-        pHandle = NULL;
-        goto EXIT;
+#else // USE_FULL_ST2094_40
+    info.display_max_luminance  = DY->data.display_maximum_luminance;
+    for (int i = 0; i < 3; i++) {
+        info.maxscl[i] = DY->data.maxscl[i];
     }
 
-    pHandle->bHasDynamicInfo = OMX_FALSE;
-
-EXIT:
-    return (OMX_HANDLETYPE)pHandle;
-}
-
-void Exynos_OSAL_ImgConv_Terminate(OMX_HANDLETYPE hImgConv)
-{
-    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
-
-    if (pHandle == NULL)
-        return;
-
-    if (pHandle->Deinit != NULL)
-        pHandle->Deinit(pHandle->pUserData);
-
-    Exynos_OSAL_dlclose(pHandle->pLibHandle);
+    info.num_maxrgb_percentiles = DY->data.num_maxrgb_percentiles;
+    for (int i = 0; i < info.num_maxrgb_percentiles; i++) {
+        info.maxrgb_percentages[i] = DY->data.maxrgb_percentages[i];
+        info.maxrgb_percentiles[i] = DY->data.maxrgb_percentiles[i];
+    }
 
-    if (pHandle->pDynamicInfo != NULL)
-        Exynos_OSAL_Free(pHandle->pDynamicInfo);
+    info.tone_mapping_flag          = DY->data.tone_mapping.tone_mapping_flag;
+    info.knee_point_x               = DY->data.tone_mapping.knee_point_x;
+    info.knee_point_y               = DY->data.tone_mapping.knee_point_y;
+    info.num_bezier_curve_anchors   = DY->data.tone_mapping.num_bezier_curve_anchors;
 
-    Exynos_OSAL_Free(pHandle);
-    pHandle = NULL;
+    for (int i = 0; i < info.num_bezier_curve_anchors; i++) {
+        info.bezier_curve_anchors[i] = DY->data.tone_mapping.bezier_curve_anchors[i];
+    }
+#endif
 }
 
-OMX_ERRORTYPE Exynos_OSAL_ImgConv_Run(
-    OMX_HANDLETYPE           hImgConv,
-    OMX_COMPONENTTYPE       *pOMXComponent,
-    OMX_PTR                  pBuffer,
-    OMX_PTR                  pHDRDynamic)
+static OMX_ERRORTYPE ImgConv_Convert(
+    EXYNOS_OMX_IMG_CONV_HANDLE  *pHandle,
+    OMX_COMPONENTTYPE           *pOMXComponent,
+    OMX_PTR                      pBuffer,
+    HDR10PLUS_DYNAMIC_INFO      *pDynamicInfo)
 {
     OMX_ERRORTYPE                ret              = OMX_ErrorNone;
-    EXYNOS_OMX_IMG_CONV_HANDLE  *pHandle          = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
     EXYNOS_OMX_BASECOMPONENT    *pExynosComponent = NULL;
     EXYNOS_OMX_BASEPORT         *pExynosPort      = NULL;
 
@@ -247,16 +249,6 @@ OMX_ERRORTYPE Exynos_OSAL_ImgConv_Run(
     HDR2SDR_config_params_t inConfig, outConfig;
     OMX_U16 max_display_luminance_cd_m2 = 0;
 
-    int i;
-
-    if ((pHandle == NULL) ||
-        (pOMXComponent == NULL) ||
-        (pBuffer == NULL)) {
-        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] invalid parameters", __FUNCTION__);
-        ret = OMX_ErrorBadParameter;
-        goto EXIT;
-    }
-
     pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
 
     if (pExynosComponent->codecType == HW_VIDEO_DEC_CODEC) {
@@ -320,71 +312,15 @@ OMX_ERRORTYPE Exynos_OSAL_ImgConv_Run(
 
     outConfig.color_format = P010_LINEAR;
 
-    if (pHDRDynamic != NULL) {
-        ExynosHdrDynamicInfo *DY = (ExynosHdrDynamicInfo *)pHDRDynamic;
-
-        if (DY->valid != 0) {
-            HDR10PLUS_DYNAMIC_INFO info;
-            memset(&info, 0, sizeof(info));
-
-            info.country_code           = DY->data.country_code;
-            info.provider_code          = DY->data.provider_code;
-            info.provider_oriented_code = DY->data.provider_oriented_code;
-            info.application_identifier = DY->data.application_identifier;
-            info.application_version    = DY->data.application_version;
-#ifdef USE_FULL_ST2094_40
-            info.display_max_luminance  = DY->data.targeted_system_display_maximum_luminance;
-            for (int i = 0; i < 3; i++) {
-                info.maxscl[i] = DY->data.maxscl[0][i];
-            }
-
-            info.avg_maxrgb = DY->data.average_maxrgb[0];
-            info.num_maxrgb_percentiles = DY->data.num_maxrgb_percentiles[0];
-            for (int i = 0; i < info.num_maxrgb_percentiles; i++) {
-                info.maxrgb_percentages[i] = DY->data.maxrgb_percentages[0][i];
-                info.maxrgb_percentiles[i] = DY->data.maxrgb_percentiles[0][i];
-            }
-
-            info.tone_mapping_flag          = DY->data.tone_mapping.tone_mapping_flag[0];
-            info.knee_point_x               = DY->data.tone_mapping.knee_point_x[0];
-            info.knee_point_y               = DY->data.tone_mapping.knee_point_y[0];
-            info.num_bezier_curve_anchors   = DY->data.tone_mapping.num_bezier_curve_anchors[0];
-
-            for (int i = 0; i < info.num_bezier_curve_anchors; i++) {
-                info.bezier_curve_anchors[i] = DY->data.tone_mapping.bezier_curve_anchors[0][i];
-            }
-#else // USE_FULL_ST2094_40
-            info.display_max_luminance  = DY->data.display_maximum_luminance;
-            for (int i = 0; i < 3; i++) {
-                info.maxscl[i] = DY->data.maxscl[i];
-            }
-
-            info.num_maxrgb_percentiles = DY->data.num_maxrgb_percentiles;
-            for (int i = 0; i < info.num_maxrgb_percentiles; i++) {
-                info.maxrgb_percentages[i] = DY->data.maxrgb_percentages[i];
-                info.maxrgb_percentiles[i] = DY->data.maxrgb_percentiles[i];
-            }
-
-            info.tone_mapping_flag          = DY->data.tone_mapping.tone_mapping_flag;
-            info.knee_point_x               = DY->data.tone_mapping.knee_point_x;
-            info.knee_point_y               = DY->data.tone_mapping.knee_point_y;
-            info.num_bezier_curve_anchors   = DY->data.tone_mapping.num_bezier_curve_anchors;
-
-            for (int i = 0; i < info.num_bezier_curve_anchors; i++) {
-                info.bezier_curve_anchors[i] = DY->data.tone_mapping.bezier_curve_anchors[i];
-            }
-#endif
-            if (memcmp(pHandle->pDynamicInfo, &info, sizeof(info))) {
-                pHandle->bHasDynamicInfo = OMX_TRUE;
-                memcpy(pHandle->pDynamicInfo, &info, sizeof(info));
-            }
-        }
+    if (pDynamicInfo != NULL) {
+        pHandle->sDynamicInfo    = *pDynamicInfo;
+        pHandle->bHasDynamicInfo = OMX_TRUE;
     }
 
     max_display_luminance_cd_m2 = (int)((pExynosPort->HDRStaticInfo.nMaxDisplayLuminance / LUMINANCE_DIV_FACTOR) + 0.5);
 
     if (pHandle->Run != NULL) {
-        pHandle->Run(&inConfig, &outConfig, ((pHandle->bHasDynamicInfo == OMX_TRUE)? pHandle->pDynamicInfo:NULL),
+        pHandle->Run(&inConfig, &outConfig, ((pHandle->bHasDynamicInfo == OMX_TRUE)? &pHandle->sDynamicInfo:NULL),
                         max_display_luminance_cd_m2, pHandle->pUserData);
     } else {
         ret = OMX_ErrorBadParameter;
@@ -398,6 +334,275 @@ EXIT:
      return ret;
 }
 
+static OMX_ERRORTYPE ImgConv_ThreadFunc(OMX_PTR pThreadData)
+{
+    EXYNOS_OMX_IMG_CONV_HANDLE  *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)pThreadData;
+    IMG_CONV_JOB                *pJob    = NULL;
+    OMX_ERRORTYPE                eResult = OMX_ErrorNone;
+
+    while (pHandle->bExitThread == OMX_FALSE) {
+        Exynos_OSAL_SemaphoreWait(pHandle->hJobSem);
+
+        if (pHandle->bExitThread == OMX_TRUE)
+            break;
+
+        /* a post follows each job written at the tail */
+        pJob = &pHandle->jobs[pHandle->nJobHead];
+        pHandle->nJobHead = (pHandle->nJobHead + 1) % IMG_CONV_JOB_NUM;
+
+        if ((pJob->pBuffer != NULL) &&
+            (pHandle->bSkipConvert == OMX_FALSE)) {
+            eResult = ImgConv_Convert(pHandle, pJob->pOMXComponent, pJob->pBuffer,
+                                      ((pJob->bHasDynamic == OMX_TRUE)? &pJob->sDynamicInfo:NULL));
+        } else {
+            eResult = OMX_ErrorNotReady;
+        }
+
+        pJob->pDoneFunc(pJob->pOMXComponent, &pJob->dataBuffer, eResult);
+
+        Exynos_OSAL_MutexLock(pHandle->hJobMutex);
+        pHandle->nPendingJobs--;
+        if (pHandle->nPendingJobs == 0)
+            Exynos_OSAL_SignalSet(pHandle->hIdleEvent);
+        Exynos_OSAL_MutexUnlock(pHandle->hJobMutex);
+    }
+
+    Exynos_OSAL_ThreadExit(NULL);
+
+    return OMX_ErrorNone;
+}
+
+static void ImgConv_DestroyWorker(EXYNOS_OMX_IMG_CONV_HANDLE *pHandle)
+{
+    if (pHandle->hThread != NULL) {
+        pHandle->bExitThread = OMX_TRUE;
+        Exynos_OSAL_SemaphorePost(pHandle->hJobSem);
+        Exynos_OSAL_ThreadTerminate(pHandle->hThread);
+        pHandle->hThread = NULL;
+    }
+
+    if (pHandle->hIdleEvent != NULL) {
+        Exynos_OSAL_SignalTerminate(pHandle->hIdleEvent);
+        pHandle->hIdleEvent = NULL;
+    }
+
+    if (pHandle->hJobMutex != NULL) {
+        Exynos_OSAL_MutexTerminate(pHandle->hJobMutex);
+        pHandle->hJobMutex = NULL;
+    }
+
+    if (pHandle->hJobSem != NULL) {
+        Exynos_OSAL_SemaphoreTerminate(pHandle->hJobSem);
+        pHandle->hJobSem = NULL;
+    }
+}
+
+static OMX_ERRORTYPE ImgConv_CreateWorker(EXYNOS_OMX_IMG_CONV_HANDLE *pHandle)
+{
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    ret = Exynos_OSAL_SemaphoreCreate(&pHandle->hJobSem);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    ret = Exynos_OSAL_MutexCreate(&pHandle->hJobMutex);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    ret = Exynos_OSAL_SignalCreate(&pHandle->hIdleEvent);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+    Exynos_OSAL_SignalSet(pHandle->hIdleEvent);
+
+    pHandle->bExitThread = OMX_FALSE;
+    ret = Exynos_OSAL_ThreadCreate(&pHandle->hThread, (OMX_PTR)ImgConv_ThreadFunc, (OMX_PTR)pHandle);
+
+EXIT:
+    if (ret != OMX_ErrorNone) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to create a worker(0x%x)", __FUNCTION__, ret);
+        ImgConv_DestroyWorker(pHandle);
+    }
+
+    return ret;
+}
+
+OMX_HANDLETYPE Exynos_OSAL_ImgConv_Create(
+    OMX_U32 nWidth,
+    OMX_U32 nHeight,
+    OMX_U32 nMode)
+{
+    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = NULL;
+
+    pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OMX_IMG_CONV_HANDLE));
+    if (pHandle == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_Malloc()", __FUNCTION__);
+        goto EXIT;
+    }
+    Exynos_OSAL_Memset(pHandle, 0, sizeof(EXYNOS_OMX_IMG_CONV_HANDLE));
+
+    pHandle->pLibHandle = Exynos_OSAL_dlopen(LIB_NAME, RTLD_NOW|RTLD_GLOBAL);
+    if (pHandle->pLibHandle == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] Failed to Exynos_OSAL_dlopen() : reason(%s)",
+                                __FUNCTION__, Exynos_OSAL_dlerror());
+        Exynos_OSAL_Free(pHandle);
+        pHandle = NULL;
+        goto EXIT;
+    }
+
+    pHandle->Init   = (ConvertInitFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_INIT);
+    pHandle->Deinit = (ConvertDeinitFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_DEINIT);
+    pHandle->Run    = (ConvertRunFunc)Exynos_OSAL_dlsym(pHandle->pLibHandle, (const char *)LIB_FN_NAME_RUN);
+
+    if ((pHandle->Init == NULL) ||
+        (pHandle->Deinit == NULL) ||
+        (pHandle->Run == NULL)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_dlsym()", __FUNCTION__);
+        Exynos_OSAL_dlclose(pHandle->pLibHandle);
+        Exynos_OSAL_Free(pHandle);
+        pHandle = NULL;
+        goto EXIT;
+    }
+
+    if (pHandle->Init(nWidth, nHeight, ((nMode == 0)? NORMAL:HI_JACK), &pHandle->pUserData, false) != OMX_TRUE) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Init()", __FUNCTION__);
+        Exynos_OSAL_dlclose(pHandle->pLibHandle);
+        Exynos_OSAL_Free(pHandle);
+        pHandle = NULL;
+        goto EXIT;
+    }
+
+    if (ImgConv_CreateWorker(pHandle) != OMX_ErrorNone) {
+        pHandle->Deinit(pHandle->pUserData);
+        Exynos_OSAL_dlclose(pHandle->pLibHandle);
+        Exynos_OSAL_Free(pHandle);
+        pHandle = NULL;
+        goto EXIT;
+    }
+
+EXIT:
+    return (OMX_HANDLETYPE)pHandle;
+}
+
+void Exynos_OSAL_ImgConv_Terminate(OMX_HANDLETYPE hImgConv)
+{
+    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
+
+    if (pHandle == NULL)
+        return;
+
+    /* every requested buffer should be given back before leaving */
+    Exynos_OSAL_ImgConv_Flush(hImgConv);
+    ImgConv_DestroyWorker(pHandle);
+
+    if (pHandle->Deinit != NULL)
+        pHandle->Deinit(pHandle->pUserData);
+
+    Exynos_OSAL_dlclose(pHandle->pLibHandle);
+
+    Exynos_OSAL_Free(pHandle);
+    pHandle = NULL;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_ImgConv_Run(
+    OMX_HANDLETYPE           hImgConv,
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    OMX_PTR                  pBuffer,
+    OMX_PTR                  pHDRDynamic)
+{
+    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
+
+    if ((pHandle == NULL) ||
+        (pOMXComponent == NULL) ||
+        (pBuffer == NULL)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] invalid parameters", __FUNCTION__);
+        return OMX_ErrorBadParameter;
+    }
+
+    if ((pHDRDynamic != NULL) &&
+        (((ExynosHdrDynamicInfo *)pHDRDynamic)->valid != 0)) {
+        HDR10PLUS_DYNAMIC_INFO info;
+
+        ImgConv_DeriveDynamicInfo((ExynosHdrDynamicInfo *)pHDRDynamic, &info);
+
+        return ImgConv_Convert(pHandle, pOMXComponent, pBuffer, &info);
+    }
+
+    return ImgConv_Convert(pHandle, pOMXComponent, pBuffer, NULL);
+}
+
+OMX_ERRORTYPE Exynos_OSAL_ImgConv_Request(
+    OMX_HANDLETYPE           hImgConv,
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    EXYNOS_OMX_DATABUFFER   *pDataBuffer,
+    OMX_PTR                  pHDRDynamic,
+    IMG_CONV_DONE_FUNC       pDoneFunc)
+{
+    OMX_ERRORTYPE                ret     = OMX_ErrorNone;
+    EXYNOS_OMX_IMG_CONV_HANDLE  *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
+    ExynosHdrDynamicInfo        *DY      = (ExynosHdrDynamicInfo *)pHDRDynamic;
+    IMG_CONV_JOB                *pJob    = NULL;
+
+    if ((pHandle == NULL) ||
+        (pOMXComponent == NULL) ||
+        (pDataBuffer == NULL) ||
+        (pDoneFunc == NULL)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] invalid parameters", __FUNCTION__);
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_MutexLock(pHandle->hJobMutex);
+    if (pHandle->nPendingJobs >= IMG_CONV_JOB_NUM) {
+        Exynos_OSAL_MutexUnlock(pHandle->hJobMutex);
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] too many jobs(%d)", __FUNCTION__, IMG_CONV_JOB_NUM);
+        ret = OMX_ErrorUndefined;
+        goto EXIT;
+    }
+
+    pJob = &pHandle->jobs[pHandle->nJobTail];
+    pHandle->nJobTail = (pHandle->nJobTail + 1) % IMG_CONV_JOB_NUM;
+    pHandle->nPendingJobs++;
+    Exynos_OSAL_SignalReset(pHandle->hIdleEvent);
+    Exynos_OSAL_MutexUnlock(pHandle->hJobMutex);
+
+    pJob->pOMXComponent = pOMXComponent;
+    pJob->dataBuffer    = *pDataBuffer;
+    pJob->pBuffer       = NULL;
+    pJob->bHasDynamic   = OMX_FALSE;
+    pJob->pDoneFunc     = pDoneFunc;
+
+    if ((pDataBuffer->remainDataLen > 0) &&
+        (pDataBuffer->bufferHeader != NULL))
+        pJob->pBuffer = (OMX_PTR)pDataBuffer->bufferHeader->pBuffer;
+
+    /* only the part the converter takes is kept, the metadata goes with the codec buffer */
+    if ((pJob->pBuffer != NULL) &&
+        (DY != NULL) &&
+        (DY->valid != 0)) {
+        ImgConv_DeriveDynamicInfo(DY, &pJob->sDynamicInfo);
+        pJob->bHasDynamic = OMX_TRUE;
+    }
+
+    Exynos_OSAL_SemaphorePost(pHandle->hJobSem);
+
+EXIT:
+    return ret;
+}
+
+void Exynos_OSAL_ImgConv_Flush(OMX_HANDLETYPE hImgConv)
+{
+    EXYNOS_OMX_IMG_CONV_HANDLE *pHandle = (EXYNOS_OMX_IMG_CONV_HANDLE *)hImgConv;
+
+    if ((pHandle == NULL) ||
+        (pHandle->hThread == NULL))
+        return;
+
+    /* pending buffers are given back as they are */
+    pHandle->bSkipConvert = OMX_TRUE;
+    Exynos_OSAL_SignalWait(pHandle->hIdleEvent, DEF_MAX_WAIT_TIME);
+    pHandle->bSkipConvert = OMX_FALSE;
+}
+
 #ifdef __cplusplus
 }
 #endif
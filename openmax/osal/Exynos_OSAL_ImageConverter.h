@@ -30,6 +30,11 @@
 
 #include "OMX_Types.h"
 #include "OMX_Component.h"
+#include "Exynos_OMX_Baseport.h"
+
+/* called on the worker once a requested buffer is done, eResult is OMX_ErrorNone if it is converted.
+ * pDataBuffer is the converter's copy of the requested one, valid only during the call. */
+typedef void (*IMG_CONV_DONE_FUNC)(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATABUFFER *pDataBuffer, OMX_ERRORTYPE eResult);
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +42,8 @@ extern "C" {
 OMX_HANDLETYPE Exynos_OSAL_ImgConv_Create(OMX_U32 nWidth, OMX_U32 nHeight, OMX_U32 nMode);
 void Exynos_OSAL_ImgConv_Terminate(OMX_HANDLETYPE hImgConv);
 OMX_ERRORTYPE Exynos_OSAL_ImgConv_Run(OMX_HANDLETYPE hImgConv, OMX_COMPONENTTYPE *pOMXComponent, OMX_PTR pBuffer, OMX_PTR pHDRDynamic);
+OMX_ERRORTYPE Exynos_OSAL_ImgConv_Request(OMX_HANDLETYPE hImgConv, OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATABUFFER *pDataBuffer, OMX_PTR pHDRDynamic, IMG_CONV_DONE_FUNC pDoneFunc);
+void Exynos_OSAL_ImgConv_Flush(OMX_HANDLETYPE hImgConv);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,313 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_MemPressure.c
+ * @brief       system memory pressure notification based on PSI
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_MemPressure.h"
+
+#undef  EXYNOS_LOG_TAG
+#define EXYNOS_LOG_TAG    "EXYNOS_OSAL_MEMPRESSURE"
+//#define EXYNOS_LOG_OFF
+#include "Exynos_OSAL_Log.h"
+
+#define MEMPRESSURE_PATH_LEN        256
+
+typedef struct _EXYNOS_OSAL_MEMPRESSURE_CLIENT
+{
+    struct _EXYNOS_OSAL_MEMPRESSURE_CLIENT *pNext;
+    EXYNOS_OSAL_MEMPRESSURE_CALLBACK        pCallback;
+    OMX_PTR                                 pData;
+} EXYNOS_OSAL_MEMPRESSURE_CLIENT;
+
+typedef struct _EXYNOS_OSAL_MEMPRESSURE_MONITOR
+{
+    pthread_mutex_t                  mutex;
+    EXYNOS_OSAL_MEMPRESSURE_CLIENT  *pClients;
+    OMX_BOOL                         bThreadRunning;
+    int                              nWakeFd;       /* wakes the thread up when a client is gone */
+    OMX_BOOL                         bPressure;
+} EXYNOS_OSAL_MEMPRESSURE_MONITOR;
+
+/* one monitor per process image the OSAL is linked into */
+static EXYNOS_OSAL_MEMPRESSURE_MONITOR gMemPressure = {
+    PTHREAD_MUTEX_INITIALIZER, NULL, OMX_FALSE, -1, OMX_FALSE,
+};
+
+static void Exynos_OSAL_MemPressure_GetPath(char *pPath)
+{
+#ifdef USE_ANDROID
+    property_get("debug.omx.psi.path", pPath, MEMPRESSURE_DEFAULT_PATH);
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_PSI_PATH");
+
+    snprintf(pPath, MEMPRESSURE_PATH_LEN, "%s", (pEnv != NULL)? pEnv:MEMPRESSURE_DEFAULT_PATH);
+#endif
+}
+
+static OMX_U64 Exynos_OSAL_MemPressure_GetHoldUs(void)
+{
+    int nHoldMs = MEMPRESSURE_HOLD_MS;
+#ifdef USE_ANDROID
+    char holdProp[PROPERTY_VALUE_MAX] = { 0, };
+
+    if (property_get("debug.omx.psi.hold", holdProp, NULL) > 0)
+        nHoldMs = atoi(holdProp);
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_PSI_HOLD");
+
+    if (pEnv != NULL)
+        nHoldMs = atoi(pEnv);
+#endif
+
+    return (nHoldMs > 0)? ((OMX_U64)nHoldMs * 1000):0;
+}
+
+/* "some avg10=1.23 avg60=..." */
+static double Exynos_OSAL_MemPressure_ReadAvg10(int fd)
+{
+    char        buf[256];
+    const char *pAvg = NULL;
+    ssize_t     nRead;
+
+    nRead = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (nRead <= 0)
+        return 0.0;
+    buf[nRead] = '\0';
+
+    pAvg = Exynos_OSAL_Strstr(buf, "some avg10=");
+    if (pAvg == NULL)
+        return 0.0;
+
+    return strtod(pAvg + Exynos_OSAL_Strlen("some avg10="), NULL);
+}
+
+/* mutex must be held */
+static void Exynos_OSAL_MemPressure_Notify(EXYNOS_OSAL_MEMPRESSURE_MONITOR *pMonitor, OMX_BOOL bPressure)
+{
+    EXYNOS_OSAL_MEMPRESSURE_CLIENT *pClient = NULL;
+
+    __atomic_store_n(&pMonitor->bPressure, bPressure, __ATOMIC_RELAXED);
+
+    for (pClient = pMonitor->pClients; pClient != NULL; pClient = pClient->pNext)
+        pClient->pCallback(pClient->pData, bPressure);
+}
+
+static void *Exynos_OSAL_MemPressure_Thread(void *pArg)
+{
+    EXYNOS_OSAL_MEMPRESSURE_MONITOR *pMonitor = (EXYNOS_OSAL_MEMPRESSURE_MONITOR *)pArg;
+    struct pollfd   fds[2];
+    char            path[MEMPRESSURE_PATH_LEN] = { 0, };
+    OMX_BOOL        bTrigger    = OMX_FALSE;
+    OMX_BOOL        bPressure   = OMX_FALSE;
+    OMX_U64         nLastStall  = 0;
+    OMX_U64         nValue      = 0;
+    OMX_U64         nHoldUs     = Exynos_OSAL_MemPressure_GetHoldUs();
+    double          avg10       = 0.0;
+    int             fd          = -1;
+
+    Exynos_OSAL_MemPressure_GetPath(path);
+
+    /* a trigger can only be armed on procfs, anything else is a file in the same format */
+    if (!Exynos_OSAL_Strncmp(path, "/proc/", Exynos_OSAL_Strlen("/proc/"))) {
+        fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if ((fd >= 0) &&
+            (write(fd, MEMPRESSURE_TRIGGER, Exynos_OSAL_Strlen(MEMPRESSURE_TRIGGER) + 1) > 0)) {
+            bTrigger = OMX_TRUE;
+        } else if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    if (fd < 0)
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] can not open %s(%d), memory pressure is not monitored", __FUNCTION__, path, errno);
+        pthread_mutex_lock(&pMonitor->mutex);
+        pMonitor->bThreadRunning = OMX_FALSE;
+        pthread_mutex_unlock(&pMonitor->mutex);
+        return NULL;
+    }
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] monitoring %s (%s)", __FUNCTION__, path, (bTrigger == OMX_TRUE)? "trigger":"polling");
+
+    while (1) {
+        /* without a trigger procfs reports POLLERR|POLLPRI at once, the file is only read by the timeout */
+        fds[0].fd      = (bTrigger == OMX_TRUE)? fd:-1;
+        fds[0].events  = POLLPRI;
+        fds[0].revents = 0;
+        fds[1].fd      = pMonitor->nWakeFd;
+        fds[1].events  = POLLIN;
+        fds[1].revents = 0;
+
+        if ((poll(fds, 2, MEMPRESSURE_POLL_MS) < 0) &&
+            (errno != EINTR)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] poll failed(%d)", __FUNCTION__, errno);
+            usleep(MEMPRESSURE_POLL_MS * 1000);
+        }
+
+        if ((fds[1].revents & POLLIN) &&
+            (read(pMonitor->nWakeFd, &nValue, sizeof(nValue)) != sizeof(nValue)) &&
+            (errno != EAGAIN)) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] failed to read the wake fd(%d)", __FUNCTION__, errno);
+        }
+
+        avg10 = Exynos_OSAL_MemPressure_ReadAvg10(fd);
+
+        if (((bTrigger == OMX_TRUE) && (fds[0].revents & POLLPRI)) ||
+            (avg10 >= MEMPRESSURE_HIGH_AVG10)) {
+            nLastStall = Exynos_OSAL_GetSystemTimeUs();
+            bPressure  = OMX_TRUE;
+        } else if ((avg10 < MEMPRESSURE_LOW_AVG10) &&
+                   ((Exynos_OSAL_GetSystemTimeUs() - nLastStall) >= nHoldUs)) {
+            bPressure  = OMX_FALSE;
+        }
+
+        pthread_mutex_lock(&pMonitor->mutex);
+        if (pMonitor->pClients == NULL) {
+            __atomic_store_n(&pMonitor->bPressure, OMX_FALSE, __ATOMIC_RELAXED);
+            pMonitor->bThreadRunning = OMX_FALSE;
+            pthread_mutex_unlock(&pMonitor->mutex);
+            break;
+        }
+
+        if (bPressure != pMonitor->bPressure) {
+            Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] memory pressure %s (avg10: %.2f)",
+                                                    __FUNCTION__, (bPressure == OMX_TRUE)? "on":"off", avg10);
+            Exynos_OSAL_MemPressure_Notify(pMonitor, bPressure);
+        }
+        pthread_mutex_unlock(&pMonitor->mutex);
+    }
+
+    close(fd);
+
+    return NULL;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_MemPressure_Register(
+    OMX_HANDLETYPE                      *phClient,
+    EXYNOS_OSAL_MEMPRESSURE_CALLBACK     pCallback,
+    OMX_PTR                              pData)
+{
+    OMX_ERRORTYPE                    ret        = OMX_ErrorNone;
+    EXYNOS_OSAL_MEMPRESSURE_MONITOR *pMonitor   = &gMemPressure;
+    EXYNOS_OSAL_MEMPRESSURE_CLIENT  *pClient    = NULL;
+    pthread_t                        thread;
+    pthread_attr_t                   attr;
+
+    if ((phClient == NULL) ||
+        (pCallback == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    pClient = (EXYNOS_OSAL_MEMPRESSURE_CLIENT *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_MEMPRESSURE_CLIENT));
+    if (pClient == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    pClient->pCallback  = pCallback;
+    pClient->pData      = pData;
+
+    pthread_mutex_lock(&pMonitor->mutex);
+
+    if (pMonitor->nWakeFd < 0)
+        pMonitor->nWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    pClient->pNext      = pMonitor->pClients;
+    pMonitor->pClients  = pClient;
+
+    if ((pMonitor->bThreadRunning == OMX_FALSE) &&
+        (pMonitor->nWakeFd >= 0)) {
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&thread, &attr, Exynos_OSAL_MemPressure_Thread, (void *)pMonitor) == 0)
+            pMonitor->bThreadRunning = OMX_TRUE;
+        else
+            Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] failed to create a monitor thread", __FUNCTION__);
+        pthread_attr_destroy(&attr);
+    }
+
+    /* let a late client know the current state */
+    if (pMonitor->bPressure == OMX_TRUE)
+        pCallback(pData, OMX_TRUE);
+
+    pthread_mutex_unlock(&pMonitor->mutex);
+
+    *phClient = (OMX_HANDLETYPE)pClient;
+
+EXIT:
+    return ret;
+}
+
+/* the callback is not called anymore once this returns */
+void Exynos_OSAL_MemPressure_Unregister(OMX_HANDLETYPE hClient)
+{
+    EXYNOS_OSAL_MEMPRESSURE_MONITOR  *pMonitor = &gMemPressure;
+    EXYNOS_OSAL_MEMPRESSURE_CLIENT  **ppLink   = NULL;
+    OMX_U64                           nValue   = 1;
+
+    if (hClient == NULL)
+        return;
+
+    pthread_mutex_lock(&pMonitor->mutex);
+
+    for (ppLink = &pMonitor->pClients; *ppLink != NULL; ppLink = &(*ppLink)->pNext) {
+        if (*ppLink == (EXYNOS_OSAL_MEMPRESSURE_CLIENT *)hClient) {
+            *ppLink = (*ppLink)->pNext;
+            break;
+        }
+    }
+
+    /* the thread exits by itself when it finds no client, at the latest after a poll period */
+    if ((pMonitor->pClients == NULL) &&
+        (pMonitor->nWakeFd >= 0) &&
+        (write(pMonitor->nWakeFd, &nValue, sizeof(nValue)) != sizeof(nValue))) {
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] failed to wake the monitor thread(%d)", __FUNCTION__, errno);
+    }
+
+    pthread_mutex_unlock(&pMonitor->mutex);
+
+    Exynos_OSAL_Free(hClient);
+}
+
+OMX_BOOL Exynos_OSAL_MemPressure_Get(void)
+{
+    return __atomic_load_n(&gMemPressure.bPressure, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,61 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_MemPressure.h
+ * @brief       system memory pressure notification based on PSI
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef Exynos_OSAL_MEMPRESSURE
+#define Exynos_OSAL_MEMPRESSURE
+
+#include "OMX_Types.h"
+#include "OMX_Core.h"
+
+/*
+ * one monitor thread per process watches "/proc/pressure/memory".
+ * the path can be changed by "debug.omx.psi.path" property (EXYNOS_OMX_PSI_PATH env on non-android),
+ * a regular file in the PSI format is polled instead of using a PSI trigger.
+ * the hold time can be changed in ms by "debug.omx.psi.hold" property (EXYNOS_OMX_PSI_HOLD env).
+ * both are read when the monitor thread starts.
+ */
+#define MEMPRESSURE_DEFAULT_PATH        "/proc/pressure/memory"
+#define MEMPRESSURE_TRIGGER             "some 300000 2000000"   /* 300ms stall in 2s, unprivileged triggers need a 2s multiple window */
+#define MEMPRESSURE_POLL_MS             1000
+#define MEMPRESSURE_HOLD_MS             10000   /* pressure is kept after the last stall seen */
+#define MEMPRESSURE_HIGH_AVG10          10.0    /* enter pressure, % of stall time */
+#define MEMPRESSURE_LOW_AVG10           2.0     /* leave pressure */
+
+/* called on the monitor thread when the state changes and on register, must not block */
+typedef void (*EXYNOS_OSAL_MEMPRESSURE_CALLBACK)(OMX_PTR pData, OMX_BOOL bPressure);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OMX_ERRORTYPE Exynos_OSAL_MemPressure_Register(OMX_HANDLETYPE *phClient, EXYNOS_OSAL_MEMPRESSURE_CALLBACK pCallback, OMX_PTR pData);
+void          Exynos_OSAL_MemPressure_Unregister(OMX_HANDLETYPE hClient);
+OMX_BOOL      Exynos_OSAL_MemPressure_Get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -125,7 +125,7 @@ int Exynos_OSAL_Queue(EXYNOS_QUEUE *queueHandle, void *data)
     }
     queue->last->data = data;
     queue->last = queue->last->qNext;
-    queue->numElem++;
+    __atomic_add_fetch(&queue->numElem, 1, __ATOMIC_RELAXED);
 
     Exynos_OSAL_MutexUnlock(queue->qMutex);
     return 0;
@@ -147,7 +147,7 @@ void *Exynos_OSAL_Dequeue(EXYNOS_QUEUE *queueHandle)
     data = queue->first->data;
     queue->first->data = NULL;
     queue->first = queue->first->qNext;
-    queue->numElem--;
+    __atomic_sub_fetch(&queue->numElem, 1, __ATOMIC_RELAXED);
 
     Exynos_OSAL_MutexUnlock(queue->qMutex);
     return data;
@@ -166,6 +166,16 @@ int Exynos_OSAL_GetElemNum(EXYNOS_QUEUE *queueHandle)
     return ElemNum;
 }
 
+/* lock free read for statistics, the value may be stale by the time it is used */
+int Exynos_OSAL_PeekElemNum(EXYNOS_QUEUE *queueHandle)
+{
+    EXYNOS_QUEUE *queue = (EXYNOS_QUEUE *)queueHandle;
+    if (queue == NULL)
+        return -1;
+
+    return __atomic_load_n(&queue->numElem, __ATOMIC_RELAXED);
+}
+
 int Exynos_OSAL_SetElemNum(EXYNOS_QUEUE *queueHandle, int ElemNum)
 {
     EXYNOS_QUEUE *queue = (EXYNOS_QUEUE *)queueHandle;
@@ -173,7 +183,7 @@ int Exynos_OSAL_SetElemNum(EXYNOS_QUEUE *queueHandle, int ElemNum)
         return -1;
 
     Exynos_OSAL_MutexLock(queue->qMutex);
-    queue->numElem = ElemNum;
+    __atomic_store_n(&queue->numElem, ElemNum, __ATOMIC_RELAXED);
     Exynos_OSAL_MutexUnlock(queue->qMutex);
     return ElemNum;
 }
@@ -194,7 +204,7 @@ int Exynos_OSAL_ResetQueue(EXYNOS_QUEUE *queueHandle)
         currentqelem = currentqelem->qNext;
     }
     queue->last = queue->first;
-    queue->numElem = 0x00;
+    __atomic_store_n(&queue->numElem, 0, __ATOMIC_RELAXED);
     Exynos_OSAL_MutexUnlock(queue->qMutex);
 
     return 0;
@@ -58,6 +58,7 @@ OMX_ERRORTYPE Exynos_OSAL_QueueTerminate(EXYNOS_QUEUE *queueHandle);
 int           Exynos_OSAL_Queue(EXYNOS_QUEUE *queueHandle, void *data);
 void         *Exynos_OSAL_Dequeue(EXYNOS_QUEUE *queueHandle);
 int           Exynos_OSAL_GetElemNum(EXYNOS_QUEUE *queueHandle);
+int           Exynos_OSAL_PeekElemNum(EXYNOS_QUEUE *queueHandle);
 int           Exynos_OSAL_SetElemNum(EXYNOS_QUEUE *queueHandle, int ElemNum);
 int           Exynos_OSAL_ResetQueue(EXYNOS_QUEUE *queueHandle);
 
@@ -35,6 +35,7 @@
 #ifdef USE_ANDROID
 #include <log/log.h>
 #include <cutils/atomic.h>
+#include <cutils/properties.h>
 #endif
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -44,6 +45,7 @@
 #include "Exynos_OSAL_Mutex.h"
 #include "Exynos_OSAL_Memory.h"
 #include "Exynos_OSAL_SharedMemory.h"
+#include "Exynos_OSAL_MemPressure.h"
 
 #include "Exynos_OSAL_ETC.h"
 
@@ -53,6 +55,7 @@
 
 static int mem_cnt = 0;
 static int map_cnt = 0;
+static OMX_U64 mem_bytes = 0;  /* ion bytes allocated by every handle */
 
 struct EXYNOS_SHAREDMEM_LIST;
 typedef struct _EXYNOS_SHAREDMEM_LIST
@@ -61,6 +64,8 @@ typedef struct _EXYNOS_SHAREDMEM_LIST
     OMX_PTR                        mapAddr;
     OMX_U32                        allocSize;
     OMX_BOOL                       owner;
+    unsigned int                   mask;
+    unsigned int                   flag;
     struct _EXYNOS_SHAREDMEM_LIST *pNextMemory;
 } EXYNOS_SHAREDMEM_LIST;
 
@@ -69,8 +74,367 @@ typedef struct _EXYNOS_SHARED_MEMORY
     unsigned long          hIONHandle;
     EXYNOS_SHAREDMEM_LIST *pAllocMemory;
     OMX_HANDLETYPE         hSMMutex;
+    OMX_U64                nAllocBytes;
 } EXYNOS_SHARED_MEMORY;
 
+static void Exynos_OSAL_SharedMemory_Account(EXYNOS_SHARED_MEMORY *pHandle, OMX_S64 nBytes)
+{
+    __atomic_add_fetch(&pHandle->nAllocBytes, (OMX_U64)nBytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&mem_bytes, (OMX_U64)nBytes, __ATOMIC_RELAXED);
+}
+
+/*
+ * secure buffers released by one session are kept here and handed to the next one,
+ * protected heap allocation is slow and fragments easily.
+ * the budget is set in MB by "debug.omx.secure.pool" property (EXYNOS_OMX_SECURE_POOL env on non-android),
+ * the pool is off unless it is set. the first secure allocation of the process reserves the whole
+ * budget in buffers of its own size and keeps them for the life of the process, the input buffers
+ * of a secure session come first. so the budget should be what one session takes, e.g. 5 MB for
+ * three 1.5 MB input buffers, anything above stays pinned in the carveout unused.
+ *
+ * a buffer never goes to another session with data of the previous owner.
+ * what the CPU can map is cleared on release, protected memory can not be, so it stays with
+ * its owner for reconfigurations and is replaced by a fresh heap buffer when the owner closes.
+ * the replacement is allocated synchronously, a secure session close takes that much longer.
+ * everything is given back to the heap under memory pressure.
+ */
+#define SECURE_POOL_DEFAULT_MB      0
+#define SECURE_POOL_SLOT_NUM        32
+#define SECURE_POOL_FIT_SLACK(s)    ((s) >> 2)  /* a pooled buffer may be 25% larger than requested */
+
+typedef struct _EXYNOS_SECURE_POOL_SLOT
+{
+    long            IONBuffer;
+    OMX_U32         allocSize;
+    unsigned int    mask;
+    unsigned int    flag;
+    OMX_HANDLETYPE  hOwner;     /* the session whose data it still holds, NULL once cleared */
+} EXYNOS_SECURE_POOL_SLOT;
+
+typedef struct _EXYNOS_SECURE_POOL
+{
+    pthread_mutex_t         mutex;
+    OMX_BOOL                bConfigured;
+    OMX_BOOL                bReserved;
+    OMX_BOOL                bMemPressure;   /* follows the PSI monitor, for the life of the process */
+    OMX_U64                 nBudget;
+    OMX_U64                 nPooledBytes;
+    int                     nSlots;
+    EXYNOS_SECURE_POOL_SLOT slots[SECURE_POOL_SLOT_NUM];
+    OMX_U32                 nHit;
+    OMX_U32                 nMiss;
+} EXYNOS_SECURE_POOL;
+
+static EXYNOS_SECURE_POOL gSecurePool = {
+    PTHREAD_MUTEX_INITIALIZER, OMX_FALSE, OMX_FALSE, OMX_FALSE, 0, 0, 0, { { 0, 0, 0, 0, NULL } }, 0, 0,
+};
+
+/* mutex must be held */
+static void Exynos_OSAL_SecurePool_Configure(EXYNOS_SECURE_POOL *pPool)
+{
+    int nMB = SECURE_POOL_DEFAULT_MB;
+
+#ifdef USE_ANDROID
+    char poolProp[PROPERTY_VALUE_MAX] = { 0, };
+
+    if (property_get("debug.omx.secure.pool", poolProp, NULL) > 0)
+        nMB = atoi(poolProp);
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_SECURE_POOL");
+
+    if (pEnv != NULL)
+        nMB = atoi(pEnv);
+#endif
+
+    pPool->nBudget     = (nMB > 0)? ((OMX_U64)nMB << 20):0;
+    pPool->bConfigured = OMX_TRUE;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] secure pool budget : %d MB", __FUNCTION__, (nMB > 0)? nMB:0);
+}
+
+/* mutex must be held */
+static void Exynos_OSAL_SecurePool_Drain(EXYNOS_SECURE_POOL *pPool)
+{
+    int i;
+
+    for (i = 0; i < pPool->nSlots; i++)
+        close(pPool->slots[i].IONBuffer);
+
+    if (pPool->nSlots > 0)
+        Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] released %d buffers(%llu KB)",
+                                                __FUNCTION__, pPool->nSlots, (unsigned long long)(pPool->nPooledBytes >> 10));
+
+    pPool->nSlots       = 0;
+    pPool->nPooledBytes = 0;
+    pPool->bReserved    = OMX_FALSE;  /* the next secure session reserves again */
+}
+
+/* called on the PSI monitor thread */
+static void Exynos_OSAL_SecurePool_MemPressure(OMX_PTR pData, OMX_BOOL bPressure)
+{
+    EXYNOS_SECURE_POOL *pPool = (EXYNOS_SECURE_POOL *)pData;
+
+    if (bPressure == OMX_FALSE)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+    Exynos_OSAL_SecurePool_Drain(pPool);
+    pthread_mutex_unlock(&pPool->mutex);
+}
+
+/*
+ * allocates clean buffers of the given shapes and pools them as far as the budget allows.
+ * the heap is called without the mutex, a slow protected allocation does not stall other sessions.
+ */
+static int Exynos_OSAL_SecurePool_Fill(
+    EXYNOS_SHARED_MEMORY    *pHandle,
+    EXYNOS_SECURE_POOL_SLOT *pShapes,
+    int                      nShapes)
+{
+    EXYNOS_SECURE_POOL *pPool     = &gSecurePool;
+    long                IONBuffer = -1;
+    int                 nFilled   = 0;
+    int                 i;
+
+    for (i = 0; i < nShapes; i++) {
+        if (Exynos_OSAL_MemPressure_Get() == OMX_TRUE)
+            break;
+
+        IONBuffer = (long)exynos_ion_alloc(pHandle->hIONHandle, pShapes[i].allocSize, pShapes[i].mask, pShapes[i].flag);
+        if (IONBuffer < 0)
+            break;
+
+        pthread_mutex_lock(&pPool->mutex);
+        if ((pPool->nSlots >= SECURE_POOL_SLOT_NUM) ||
+            ((pPool->nPooledBytes + pShapes[i].allocSize) > pPool->nBudget)) {
+            pthread_mutex_unlock(&pPool->mutex);
+            close(IONBuffer);
+            break;
+        }
+
+        pPool->slots[pPool->nSlots]           = pShapes[i];
+        pPool->slots[pPool->nSlots].IONBuffer = IONBuffer;
+        pPool->slots[pPool->nSlots].hOwner    = NULL;
+        pPool->nSlots++;
+        pPool->nPooledBytes += pShapes[i].allocSize;
+        pthread_mutex_unlock(&pPool->mutex);
+
+        nFilled++;
+    }
+
+    return nFilled;
+}
+
+/* the first secure allocation reserves the budget and starts following memory pressure */
+static void Exynos_OSAL_SecurePool_Reserve(
+    EXYNOS_SHARED_MEMORY   *pHandle,
+    OMX_U32                 size,
+    unsigned int            mask,
+    unsigned int            flag)
+{
+    EXYNOS_SECURE_POOL      *pPool      = &gSecurePool;
+    EXYNOS_SECURE_POOL_SLOT  shapes[SECURE_POOL_SLOT_NUM];
+    OMX_HANDLETYPE           hClient    = NULL;
+    OMX_BOOL                 bRegister  = OMX_FALSE;
+    int                      nShapes    = 0;
+
+    if (size == 0)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    if (pPool->bConfigured == OMX_FALSE)
+        Exynos_OSAL_SecurePool_Configure(pPool);
+
+    if ((pPool->nBudget == 0) ||
+        (pPool->bReserved == OMX_TRUE) ||
+        (Exynos_OSAL_MemPressure_Get() == OMX_TRUE)) {
+        pthread_mutex_unlock(&pPool->mutex);
+        return;
+    }
+
+    pPool->bReserved = OMX_TRUE;
+
+    if (pPool->bMemPressure == OMX_FALSE) {
+        pPool->bMemPressure = OMX_TRUE;
+        bRegister = OMX_TRUE;
+    }
+
+    while ((nShapes < (SECURE_POOL_SLOT_NUM - pPool->nSlots)) &&
+           ((pPool->nPooledBytes + ((OMX_U64)size * (nShapes + 1))) <= pPool->nBudget)) {
+        shapes[nShapes].allocSize = size;
+        shapes[nShapes].mask      = mask;
+        shapes[nShapes].flag      = flag;
+        nShapes++;
+    }
+
+    pthread_mutex_unlock(&pPool->mutex);
+
+    /* the monitor calls back under its own lock, so it is never taken with the pool mutex held */
+    if ((bRegister == OMX_TRUE) &&
+        (Exynos_OSAL_MemPressure_Register(&hClient, Exynos_OSAL_SecurePool_MemPressure, (OMX_PTR)pPool) != OMX_ErrorNone))
+        Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] secure pool does not follow memory pressure", __FUNCTION__);
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] reserved %d/%d buffers(%u bytes)",
+                                            __FUNCTION__, Exynos_OSAL_SecurePool_Fill(pHandle, shapes, nShapes), nShapes, size);
+}
+
+/*
+ * a closing session takes what still holds its data out of the pool, fresh buffers take their place.
+ * the protected heap is called here on the closing thread, nothing is deferred
+ */
+static void Exynos_OSAL_SecurePool_Release(EXYNOS_SHARED_MEMORY *pHandle)
+{
+    EXYNOS_SECURE_POOL      *pPool      = &gSecurePool;
+    EXYNOS_SECURE_POOL_SLOT  shapes[SECURE_POOL_SLOT_NUM];
+    int                      nShapes    = 0;
+    int                      i;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    for (i = 0; i < pPool->nSlots; i++) {
+        if (pPool->slots[i].hOwner != (OMX_HANDLETYPE)pHandle)
+            continue;
+
+        close(pPool->slots[i].IONBuffer);
+        shapes[nShapes++] = pPool->slots[i];
+
+        pPool->nPooledBytes -= pPool->slots[i].allocSize;
+        pPool->slots[i]      = pPool->slots[--pPool->nSlots];
+        i--;
+    }
+
+    pthread_mutex_unlock(&pPool->mutex);
+
+    if (nShapes > 0) {
+        OMX_U64 nStartUs = Exynos_OSAL_GetSystemTimeUs();
+        int     nFilled  = Exynos_OSAL_SecurePool_Fill(pHandle, shapes, nShapes);
+
+        Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] replaced %d/%d buffers in %llu us",
+                                            __FUNCTION__, nFilled, nShapes,
+                                            (unsigned long long)(Exynos_OSAL_GetSystemTimeUs() - nStartUs));
+    }
+}
+
+/* returns a pooled buffer and updates *pSize to its real size, or -1 */
+static long Exynos_OSAL_SecurePool_Get(
+    EXYNOS_SHARED_MEMORY   *pHandle,
+    OMX_U32                *pSize,
+    unsigned int            mask,
+    unsigned int            flag)
+{
+    EXYNOS_SECURE_POOL *pPool     = &gSecurePool;
+    long                IONBuffer = -1;
+    int                 nBest     = -1;
+    int                 i;
+
+    Exynos_OSAL_SecurePool_Reserve(pHandle, *pSize, mask, flag);
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    if (pPool->nBudget == 0)
+        goto EXIT;
+
+    for (i = 0; i < pPool->nSlots; i++) {
+        EXYNOS_SECURE_POOL_SLOT *pSlot = &pPool->slots[i];
+
+        if ((pSlot->mask != mask) ||
+            (pSlot->flag != flag) ||
+            ((pSlot->hOwner != NULL) && (pSlot->hOwner != (OMX_HANDLETYPE)pHandle)) ||
+            (pSlot->allocSize < *pSize) ||
+            (pSlot->allocSize > (*pSize + SECURE_POOL_FIT_SLACK(*pSize))))
+            continue;
+
+        if ((nBest < 0) ||
+            (pSlot->allocSize < pPool->slots[nBest].allocSize))
+            nBest = i;
+    }
+
+    if (nBest < 0) {
+        pPool->nMiss++;
+        goto EXIT;
+    }
+
+    IONBuffer = pPool->slots[nBest].IONBuffer;
+    *pSize    = pPool->slots[nBest].allocSize;
+
+    pPool->nPooledBytes -= pPool->slots[nBest].allocSize;
+    pPool->slots[nBest]  = pPool->slots[--pPool->nSlots];
+    pPool->nHit++;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] reuse fd(%ld) size(%u), hit(%u) miss(%u)",
+                                        __FUNCTION__, IONBuffer, *pSize, pPool->nHit, pPool->nMiss);
+
+EXIT:
+    pthread_mutex_unlock(&pPool->mutex);
+
+    return IONBuffer;
+}
+
+/* takes over the buffer of a released element if it fits in the budget */
+static OMX_BOOL Exynos_OSAL_SecurePool_Put(
+    EXYNOS_SHARED_MEMORY    *pHandle,
+    EXYNOS_SHAREDMEM_LIST   *pElement)
+{
+    EXYNOS_SECURE_POOL *pPool   = &gSecurePool;
+    OMX_BOOL            bKept   = OMX_FALSE;
+    OMX_PTR             pScrub  = MAP_FAILED;
+
+    if (!(pElement->flag & ION_FLAG_PROTECTED))
+        return OMX_FALSE;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    if (pPool->bConfigured == OMX_FALSE)
+        Exynos_OSAL_SecurePool_Configure(pPool);
+
+    if (Exynos_OSAL_MemPressure_Get() == OMX_TRUE) {
+        /* give everything back to the heap */
+        Exynos_OSAL_SecurePool_Drain(pPool);
+        goto EXIT;
+    }
+
+    if ((pPool->nBudget == 0) ||
+        (pPool->nSlots >= SECURE_POOL_SLOT_NUM) ||
+        ((pPool->nPooledBytes + pElement->allocSize) > pPool->nBudget))
+        goto EXIT;
+
+    pPool->slots[pPool->nSlots].IONBuffer = (long)pElement->IONBuffer;
+    pPool->slots[pPool->nSlots].allocSize = pElement->allocSize;
+    pPool->slots[pPool->nSlots].mask      = pElement->mask;
+    pPool->slots[pPool->nSlots].flag      = pElement->flag;
+    pPool->slots[pPool->nSlots].hOwner    = (OMX_HANDLETYPE)pHandle;
+
+    /* a stand-in heap or a build without protection, cleared here and free for any session */
+    pScrub = Exynos_OSAL_Mmap(NULL, pElement->allocSize, PROT_READ | PROT_WRITE, MAP_SHARED, pElement->IONBuffer, 0);
+    if (pScrub != MAP_FAILED) {
+        Exynos_OSAL_Memset(pScrub, 0, pElement->allocSize);
+        Exynos_OSAL_Munmap(pScrub, pElement->allocSize);
+        pPool->slots[pPool->nSlots].hOwner = NULL;
+    }
+
+    pPool->nSlots++;
+    pPool->nPooledBytes += pElement->allocSize;
+
+    bKept = OMX_TRUE;
+
+EXIT:
+    pthread_mutex_unlock(&pPool->mutex);
+
+    return bKept;
+}
+
+OMX_U64 Exynos_OSAL_SharedMemory_GetSecurePoolBytes(void)
+{
+    OMX_U64 nBytes = 0;
+
+    pthread_mutex_lock(&gSecurePool.mutex);
+    nBytes = gSecurePool.nPooledBytes;
+    pthread_mutex_unlock(&gSecurePool.mutex);
+
+    return nBytes;
+}
+
 
 OMX_HANDLETYPE Exynos_OSAL_SharedMemory_Open()
 {
@@ -129,14 +493,15 @@ void Exynos_OSAL_SharedMemory_Close(OMX_HANDLETYPE handle)
                 Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] Failed to Exynos_OSAL_Munmap", __FUNCTION__);
         }
 
-        pDeleteElement->mapAddr = NULL;
-        pDeleteElement->allocSize = 0;
-
         if (pDeleteElement->owner) {
-            /* free a ion_buffer */
-            close(pDeleteElement->IONBuffer);
+            /* free a ion_buffer, or keep it for the next secure session */
+            if (Exynos_OSAL_SecurePool_Put(pHandle, pDeleteElement) == OMX_FALSE)
+                close(pDeleteElement->IONBuffer);
             mem_cnt--;
+            Exynos_OSAL_SharedMemory_Account(pHandle, -(OMX_S64)pDeleteElement->allocSize);
         }
+        pDeleteElement->mapAddr = NULL;
+        pDeleteElement->allocSize = 0;
         pDeleteElement->IONBuffer = 0;
 
         Exynos_OSAL_Free(pDeleteElement);
@@ -147,6 +512,8 @@ void Exynos_OSAL_SharedMemory_Close(OMX_HANDLETYPE handle)
     pHandle->pAllocMemory = pSMList = NULL;
     Exynos_OSAL_MutexUnlock(pHandle->hSMMutex);
 
+    Exynos_OSAL_SecurePool_Release(pHandle);
+
     Exynos_OSAL_MutexTerminate(pHandle->hSMMutex);
     pHandle->hSMMutex = NULL;
 
@@ -222,7 +589,11 @@ OMX_PTR Exynos_OSAL_SharedMemory_Alloc(OMX_HANDLETYPE handle, OMX_U32 size, MEMO
     if (flag & ION_FLAG_CACHED)  /* use improved cache oprs */
         flag |= ION_FLAG_CACHED_NEEDS_SYNC;
 
-    if ((IONBuffer = exynos_ion_alloc(pHandle->hIONHandle, size, mask, flag)) < 0) {
+    if (flag & ION_FLAG_PROTECTED)
+        IONBuffer = Exynos_OSAL_SecurePool_Get(pHandle, &size, mask, flag);
+
+    if ((IONBuffer < 0) &&
+        ((IONBuffer = exynos_ion_alloc(pHandle->hIONHandle, size, mask, flag)) < 0)) {
         Exynos_OSAL_Log(EXYNOS_LOG_WARNING, "[%s] Failed to exynos_ion_alloc(mask:%x, flag:%x)", __FUNCTION__, mask, flag);
         if (memoryType == CONTIG_MEMORY) {
             /* retry at normal area */
@@ -253,6 +624,8 @@ OMX_PTR Exynos_OSAL_SharedMemory_Alloc(OMX_HANDLETYPE handle, OMX_U32 size, MEMO
     pElement->IONBuffer   = (unsigned long)IONBuffer;
     pElement->mapAddr     = pBuffer;
     pElement->allocSize   = size;
+    pElement->mask        = mask;
+    pElement->flag        = flag;
     pElement->pNextMemory = NULL;
 
     Exynos_OSAL_MutexLock(pHandle->hSMMutex);
@@ -269,6 +642,7 @@ OMX_PTR Exynos_OSAL_SharedMemory_Alloc(OMX_HANDLETYPE handle, OMX_U32 size, MEMO
     Exynos_OSAL_MutexUnlock(pHandle->hSMMutex);
 
     mem_cnt++;
+    Exynos_OSAL_SharedMemory_Account(pHandle, (OMX_S64)size);
     Exynos_OSAL_Log(EXYNOS_LOG_TRACE, "[%s] count: %d", __FUNCTION__, mem_cnt);
 
 EXIT:
@@ -320,14 +694,15 @@ void Exynos_OSAL_SharedMemory_Free(OMX_HANDLETYPE handle, OMX_PTR pBuffer)
         }
     }
 
-    pDeleteElement->mapAddr = NULL;
-    pDeleteElement->allocSize = 0;
-
     if (pDeleteElement->owner) {
-        /* free a ion_buffer */
-        close(pDeleteElement->IONBuffer);
+        /* free a ion_buffer, or keep it for the next secure session */
+        if (Exynos_OSAL_SecurePool_Put(pHandle, pDeleteElement) == OMX_FALSE)
+            close(pDeleteElement->IONBuffer);
         mem_cnt--;
+        Exynos_OSAL_SharedMemory_Account(pHandle, -(OMX_S64)pDeleteElement->allocSize);
     }
+    pDeleteElement->mapAddr = NULL;
+    pDeleteElement->allocSize = 0;
     pDeleteElement->IONBuffer = 0;
 
     Exynos_OSAL_Free(pDeleteElement);
@@ -544,3 +919,14 @@ OMX_PTR Exynos_OSAL_SharedMemory_IONToVirt(OMX_HANDLETYPE handle, unsigned long
 EXIT:
     return pBuffer;
 }
+
+/* bytes allocated through the handle, or by every handle of the process when handle is NULL */
+OMX_U64 Exynos_OSAL_SharedMemory_GetAllocBytes(OMX_HANDLETYPE handle)
+{
+    EXYNOS_SHARED_MEMORY *pHandle = (EXYNOS_SHARED_MEMORY *)handle;
+
+    if (pHandle == NULL)
+        return __atomic_load_n(&mem_bytes, __ATOMIC_RELAXED);
+
+    return __atomic_load_n(&pHandle->nAllocBytes, __ATOMIC_RELAXED);
+}
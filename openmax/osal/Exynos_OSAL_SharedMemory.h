@@ -53,6 +53,9 @@ OMX_PTR Exynos_OSAL_SharedMemory_IONToVirt(OMX_HANDLETYPE handle, unsigned long
 OMX_PTR Exynos_OSAL_SharedMemory_Map(OMX_HANDLETYPE handle, OMX_U32 size, unsigned long ionfd);
 void Exynos_OSAL_SharedMemory_Unmap(OMX_HANDLETYPE handle, unsigned long ionfd);
 
+OMX_U64 Exynos_OSAL_SharedMemory_GetAllocBytes(OMX_HANDLETYPE handle);
+OMX_U64 Exynos_OSAL_SharedMemory_GetSecurePoolBytes(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,420 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_Trace.c
+ * @brief       OMX call trace recorder/reader
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_Trace.h"
+
+#undef  EXYNOS_LOG_TAG
+#define EXYNOS_LOG_TAG    "EXYNOS_OSAL_TRACE"
+//#define EXYNOS_LOG_OFF
+#include "Exynos_OSAL_Log.h"
+
+#define TRACE_PATH_SIZE     256
+
+typedef struct _EXYNOS_OSAL_TRACE
+{
+    OMX_HANDLETYPE  hMutex;
+    FILE           *fp;
+    TRACE_LEVEL     eLevel;
+    OMX_U64         nStartTimeUs;
+    OMX_U32         nRecordCount;
+    OMX_BOOL        bError;
+} EXYNOS_OSAL_TRACE;
+
+typedef struct _EXYNOS_OSAL_TRACE_READER
+{
+    FILE           *fp;
+    OMX_PTR         pPayload;
+    OMX_U32         nPayloadSize;
+    OMX_U64         nStartTimeUs;   /* replay start, set by the first wait */
+} EXYNOS_OSAL_TRACE_READER;
+
+static TRACE_LEVEL Exynos_OSAL_Trace_GetLevel(
+    char    *pDir,
+    int      nDirSize)
+{
+    int nLevel = 0;
+
+#ifdef USE_ANDROID
+    char traceProp[PROPERTY_VALUE_MAX] = { 0, };
+
+    if (property_get("debug.omx.trace", traceProp, NULL) > 0)
+        nLevel = atoi(traceProp);
+
+    property_get("debug.omx.trace.dir", pDir, TRACE_DEFAULT_DIR);
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_TRACE");
+
+    if (pEnv != NULL)
+        nLevel = atoi(pEnv);
+
+    pEnv = getenv("EXYNOS_OMX_TRACE_DIR");
+    snprintf(pDir, nDirSize, "%s", (pEnv != NULL)? pEnv:TRACE_DEFAULT_DIR);
+#endif
+
+    if (nLevel <= (int)TRACE_LEVEL_OFF)
+        return TRACE_LEVEL_OFF;
+
+    if (nLevel >= (int)TRACE_LEVEL_PAYLOAD)
+        return TRACE_LEVEL_PAYLOAD;
+
+    return TRACE_LEVEL_HASH;
+}
+
+static void Exynos_OSAL_Trace_Write(
+    EXYNOS_OSAL_TRACE           *pTrace,
+    EXYNOS_OSAL_TRACE_RECORD    *pRecord,
+    OMX_PTR                      pPayload)
+{
+    OMX_U64 nNowUs = Exynos_OSAL_GetSystemTimeUs();
+
+    Exynos_OSAL_MutexLock(pTrace->hMutex);
+
+    if (pTrace->bError == OMX_TRUE)
+        goto EXIT;
+
+    if (pTrace->nRecordCount == 0)
+        pTrace->nStartTimeUs = nNowUs;
+
+    pRecord->nTimeUs = nNowUs - pTrace->nStartTimeUs;
+
+    if ((fwrite(pRecord, sizeof(*pRecord), 1, pTrace->fp) != 1) ||
+        ((pRecord->nPayloadLen > 0) &&
+         (fwrite(pPayload, pRecord->nPayloadLen, 1, pTrace->fp) != 1))) {
+        /* stop recording rather than leave a torn file behind */
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] failed to write a record, trace is stopped", __FUNCTION__);
+        pTrace->bError = OMX_TRUE;
+        goto EXIT;
+    }
+
+    pTrace->nRecordCount++;
+
+EXIT:
+    Exynos_OSAL_MutexUnlock(pTrace->hMutex);
+}
+
+OMX_ERRORTYPE Exynos_OSAL_TraceCreate(
+    OMX_HANDLETYPE  *pTraceHandle,
+    OMX_STRING       componentName,
+    OMX_PTR          pOwner)
+{
+    OMX_ERRORTYPE                    ret    = OMX_ErrorNone;
+    EXYNOS_OSAL_TRACE               *pTrace = NULL;
+    EXYNOS_OSAL_TRACE_FILE_HEADER    header;
+    TRACE_LEVEL                      eLevel = TRACE_LEVEL_OFF;
+    char                             dir[TRACE_PATH_SIZE] = { 0, };
+    char                             path[TRACE_PATH_SIZE];
+
+    if (pTraceHandle == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    *pTraceHandle = NULL;
+
+    /* the handle stays NULL when disabled, nothing is wrapped then */
+    eLevel = Exynos_OSAL_Trace_GetLevel(dir, sizeof(dir));
+    if (eLevel == TRACE_LEVEL_OFF)
+        goto EXIT;
+
+    pTrace = (EXYNOS_OSAL_TRACE *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_TRACE));
+    if (pTrace == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    Exynos_OSAL_Memset(pTrace, 0, sizeof(EXYNOS_OSAL_TRACE));
+
+    snprintf(path, sizeof(path), "%s/omx_trace_%d_%p.bin", dir, (int)getpid(), pOwner);
+    pTrace->fp = fopen(path, "wb");
+    if (pTrace->fp == NULL) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] failed to open %s", __FUNCTION__, path);
+        Exynos_OSAL_Free(pTrace);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    Exynos_OSAL_Memset(&header, 0, sizeof(header));
+    header.nMagic   = TRACE_FILE_MAGIC;
+    header.nVersion = TRACE_FILE_VERSION;
+    header.nLevel   = (OMX_U32)eLevel;
+    if (componentName != NULL)
+        snprintf(header.componentName, sizeof(header.componentName), "%s", componentName);
+
+    if ((fwrite(&header, sizeof(header), 1, pTrace->fp) != 1) ||
+        (Exynos_OSAL_MutexCreate(&pTrace->hMutex) != OMX_ErrorNone)) {
+        fclose(pTrace->fp);
+        Exynos_OSAL_Free(pTrace);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    pTrace->eLevel = eLevel;
+    *pTraceHandle  = (OMX_HANDLETYPE)pTrace;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%p][%s] recording %s to %s (level %d)",
+                                            pOwner, __FUNCTION__, header.componentName, path, (int)eLevel);
+
+EXIT:
+    return ret;
+}
+
+void Exynos_OSAL_TraceTerminate(OMX_HANDLETYPE *pTraceHandle)
+{
+    EXYNOS_OSAL_TRACE *pTrace = NULL;
+
+    if ((pTraceHandle == NULL) ||
+        (*pTraceHandle == NULL))
+        return;
+
+    pTrace = (EXYNOS_OSAL_TRACE *)*pTraceHandle;
+
+    Exynos_OSAL_Log(EXYNOS_LOG_ESSENTIAL, "[%s] %d records", __FUNCTION__, pTrace->nRecordCount);
+
+    fclose(pTrace->fp);
+    Exynos_OSAL_MutexTerminate(pTrace->hMutex);
+    Exynos_OSAL_Free(pTrace);
+
+    *pTraceHandle = NULL;
+}
+
+void Exynos_OSAL_TraceCall(
+    OMX_HANDLETYPE   hTrace,
+    TRACE_CALL_TYPE  eType,
+    OMX_U32          nIndex,
+    OMX_U32          nParam,
+    OMX_PTR          pData,
+    OMX_U32          nDataLen)
+{
+    EXYNOS_OSAL_TRACE_RECORD record;
+
+    if (hTrace == NULL)
+        return;
+
+    if (pData == NULL)
+        nDataLen = 0;
+
+    /* parameter structures are always kept, a replay can not go without them */
+    Exynos_OSAL_Memset(&record, 0, sizeof(record));
+    record.eType       = (OMX_U32)eType;
+    record.nIndex      = nIndex;
+    record.nParam      = nParam;
+    record.nDataLen    = nDataLen;
+    record.nPayloadLen = nDataLen;
+
+    Exynos_OSAL_Trace_Write((EXYNOS_OSAL_TRACE *)hTrace, &record, pData);
+}
+
+void Exynos_OSAL_TraceBuffer(
+    OMX_HANDLETYPE           hTrace,
+    TRACE_CALL_TYPE          eType,
+    OMX_BUFFERHEADERTYPE    *pBufferHeader,
+    OMX_BOOL                 bSecure)
+{
+    EXYNOS_OSAL_TRACE           *pTrace = (EXYNOS_OSAL_TRACE *)hTrace;
+    EXYNOS_OSAL_TRACE_RECORD     record;
+    OMX_U8                      *pData  = NULL;
+
+    if ((pTrace == NULL) ||
+        (pBufferHeader == NULL))
+        return;
+
+    Exynos_OSAL_Memset(&record, 0, sizeof(record));
+    record.eType      = (OMX_U32)eType;
+    record.nTimeStamp = (OMX_S64)pBufferHeader->nTimeStamp;
+    record.nParam     = pBufferHeader->nFlags;
+
+    if (eType == TRACE_CALL_EMPTY_THIS_BUFFER) {
+        record.nIndex   = pBufferHeader->nInputPortIndex;
+        record.nDataLen = pBufferHeader->nFilledLen;
+
+        /* pBuffer of a secure component is not CPU accessible */
+        if ((bSecure == OMX_FALSE) &&
+            (pBufferHeader->pBuffer != NULL) &&
+            (pBufferHeader->nFilledLen > 0)) {
+            pData        = pBufferHeader->pBuffer + pBufferHeader->nOffset;
+            record.nHash = Exynos_OSAL_Hash(pData, pBufferHeader->nFilledLen);
+
+            if (pTrace->eLevel == TRACE_LEVEL_PAYLOAD)
+                record.nPayloadLen = pBufferHeader->nFilledLen;
+        }
+    } else {
+        record.nIndex   = pBufferHeader->nOutputPortIndex;
+        record.nDataLen = pBufferHeader->nAllocLen;
+    }
+
+    Exynos_OSAL_Trace_Write(pTrace, &record, (OMX_PTR)pData);
+}
+
+OMX_ERRORTYPE Exynos_OSAL_TraceReaderOpen(
+    OMX_HANDLETYPE                  *pReaderHandle,
+    const char                      *pPath,
+    EXYNOS_OSAL_TRACE_FILE_HEADER   *pHeader)
+{
+    OMX_ERRORTYPE                    ret     = OMX_ErrorNone;
+    EXYNOS_OSAL_TRACE_READER        *pReader = NULL;
+    EXYNOS_OSAL_TRACE_FILE_HEADER    header;
+
+    if ((pReaderHandle == NULL) ||
+        (pPath == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    *pReaderHandle = NULL;
+
+    pReader = (EXYNOS_OSAL_TRACE_READER *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_TRACE_READER));
+    if (pReader == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    Exynos_OSAL_Memset(pReader, 0, sizeof(EXYNOS_OSAL_TRACE_READER));
+
+    pReader->fp = fopen(pPath, "rb");
+    if (pReader->fp == NULL) {
+        Exynos_OSAL_Free(pReader);
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if ((fread(&header, sizeof(header), 1, pReader->fp) != 1) ||
+        (header.nMagic != TRACE_FILE_MAGIC) ||
+        (header.nVersion != TRACE_FILE_VERSION)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] %s is not a trace file", __FUNCTION__, pPath);
+        fclose(pReader->fp);
+        Exynos_OSAL_Free(pReader);
+        ret = OMX_ErrorFormatNotDetected;
+        goto EXIT;
+    }
+    header.componentName[TRACE_NAME_SIZE - 1] = '\0';
+
+    if (pHeader != NULL)
+        Exynos_OSAL_Memcpy(pHeader, &header, sizeof(header));
+
+    *pReaderHandle = (OMX_HANDLETYPE)pReader;
+
+EXIT:
+    return ret;
+}
+
+/* the payload stays valid until the next call */
+OMX_ERRORTYPE Exynos_OSAL_TraceReaderNext(
+    OMX_HANDLETYPE               hReader,
+    EXYNOS_OSAL_TRACE_RECORD    *pRecord,
+    OMX_PTR                     *ppPayload)
+{
+    OMX_ERRORTYPE                ret     = OMX_ErrorNone;
+    EXYNOS_OSAL_TRACE_READER    *pReader = (EXYNOS_OSAL_TRACE_READER *)hReader;
+    OMX_PTR                      pNew    = NULL;
+
+    if ((pReader == NULL) ||
+        (pRecord == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    if (ppPayload != NULL)
+        *ppPayload = NULL;
+
+    if (fread(pRecord, sizeof(*pRecord), 1, pReader->fp) != 1) {
+        ret = OMX_ErrorNoMore;
+        goto EXIT;
+    }
+
+    if (pRecord->nPayloadLen == 0)
+        goto EXIT;
+
+    if (pRecord->nPayloadLen > pReader->nPayloadSize) {
+        pNew = Exynos_OSAL_Malloc(pRecord->nPayloadLen);
+        if (pNew == NULL) {
+            ret = OMX_ErrorInsufficientResources;
+            goto EXIT;
+        }
+
+        Exynos_OSAL_Free(pReader->pPayload);
+        pReader->pPayload     = pNew;
+        pReader->nPayloadSize = pRecord->nPayloadLen;
+    }
+
+    if (fread(pReader->pPayload, pRecord->nPayloadLen, 1, pReader->fp) != 1) {
+        ret = OMX_ErrorStreamCorrupt;
+        goto EXIT;
+    }
+
+    if (ppPayload != NULL)
+        *ppPayload = pReader->pPayload;
+
+EXIT:
+    return ret;
+}
+
+/* keeps the recorded pacing, the first call marks the replay start */
+void Exynos_OSAL_TraceReaderWait(
+    OMX_HANDLETYPE               hReader,
+    EXYNOS_OSAL_TRACE_RECORD    *pRecord)
+{
+    EXYNOS_OSAL_TRACE_READER    *pReader = (EXYNOS_OSAL_TRACE_READER *)hReader;
+    OMX_U64                      nNowUs  = 0;
+    OMX_U64                      nDueUs  = 0;
+
+    if ((pReader == NULL) ||
+        (pRecord == NULL))
+        return;
+
+    nNowUs = Exynos_OSAL_GetSystemTimeUs();
+    if (pReader->nStartTimeUs == 0)
+        pReader->nStartTimeUs = nNowUs - pRecord->nTimeUs;
+
+    nDueUs = pReader->nStartTimeUs + pRecord->nTimeUs;
+    if (nDueUs > nNowUs)
+        usleep((useconds_t)(nDueUs - nNowUs));
+}
+
+void Exynos_OSAL_TraceReaderClose(OMX_HANDLETYPE *pReaderHandle)
+{
+    EXYNOS_OSAL_TRACE_READER *pReader = NULL;
+
+    if ((pReaderHandle == NULL) ||
+        (*pReaderHandle == NULL))
+        return;
+
+    pReader = (EXYNOS_OSAL_TRACE_READER *)*pReaderHandle;
+
+    fclose(pReader->fp);
+    if (pReader->pPayload != NULL)
+        Exynos_OSAL_Free(pReader->pPayload);
+    Exynos_OSAL_Free(pReader);
+
+    *pReaderHandle = NULL;
+}
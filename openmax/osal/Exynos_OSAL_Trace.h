@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_Trace.h
+ * @brief       OMX call trace recorder/reader
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef Exynos_OSAL_TRACE
+#define Exynos_OSAL_TRACE
+
+#include "OMX_Types.h"
+#include "OMX_Core.h"
+
+/*
+ * enabled by "debug.omx.trace" property (EXYNOS_OMX_TRACE env on non-android)
+ *   1 : buffer payloads are hashed
+ *   2 : buffer payloads are stored as well
+ * files are written to "debug.omx.trace.dir" (EXYNOS_OMX_TRACE_DIR), TRACE_DEFAULT_DIR by default
+ */
+#define TRACE_DEFAULT_DIR       "/data/vendor/media"
+#define TRACE_FILE_MAGIC        0x52544F45  /* "EOTR" */
+#define TRACE_FILE_VERSION      2   /* 2: no addresses in parameter structures */
+#define TRACE_NAME_SIZE         128
+
+typedef enum _TRACE_LEVEL
+{
+    TRACE_LEVEL_OFF     = 0,
+    TRACE_LEVEL_HASH,
+    TRACE_LEVEL_PAYLOAD,
+} TRACE_LEVEL;
+
+typedef enum _TRACE_CALL_TYPE
+{
+    TRACE_CALL_SEND_COMMAND = 1,
+    TRACE_CALL_SET_PARAMETER,
+    TRACE_CALL_SET_CONFIG,
+    TRACE_CALL_EMPTY_THIS_BUFFER,
+    TRACE_CALL_FILL_THIS_BUFFER,
+} TRACE_CALL_TYPE;
+
+typedef struct _EXYNOS_OSAL_TRACE_FILE_HEADER
+{
+    OMX_U32 nMagic;
+    OMX_U32 nVersion;
+    OMX_U32 nLevel;
+    OMX_U32 nReserved;
+    char    componentName[TRACE_NAME_SIZE];
+} EXYNOS_OSAL_TRACE_FILE_HEADER;
+
+/* every record is followed by nPayloadLen bytes */
+typedef struct _EXYNOS_OSAL_TRACE_RECORD
+{
+    OMX_U64 nTimeUs;        /* relative to the first record */
+    OMX_S64 nTimeStamp;     /* buffer calls only */
+    OMX_U32 eType;          /* TRACE_CALL_TYPE */
+    OMX_U32 nIndex;         /* command, param/config index or port index */
+    OMX_U32 nParam;         /* command param or buffer flags */
+    OMX_U32 nDataLen;       /* size of the structure or nFilledLen */
+    OMX_U32 nHash;          /* FNV-1a of the buffer data */
+    OMX_U32 nPayloadLen;
+} EXYNOS_OSAL_TRACE_RECORD;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* recorder */
+OMX_ERRORTYPE Exynos_OSAL_TraceCreate(OMX_HANDLETYPE *pTraceHandle, OMX_STRING componentName, OMX_PTR pOwner);
+void Exynos_OSAL_TraceTerminate(OMX_HANDLETYPE *pTraceHandle);
+void Exynos_OSAL_TraceCall(OMX_HANDLETYPE hTrace, TRACE_CALL_TYPE eType, OMX_U32 nIndex, OMX_U32 nParam, OMX_PTR pData, OMX_U32 nDataLen);
+void Exynos_OSAL_TraceBuffer(OMX_HANDLETYPE hTrace, TRACE_CALL_TYPE eType, OMX_BUFFERHEADERTYPE *pBufferHeader, OMX_BOOL bSecure);
+
+/* reader, used by replay harnesses */
+OMX_ERRORTYPE Exynos_OSAL_TraceReaderOpen(OMX_HANDLETYPE *pReaderHandle, const char *pPath, EXYNOS_OSAL_TRACE_FILE_HEADER *pHeader);
+OMX_ERRORTYPE Exynos_OSAL_TraceReaderNext(OMX_HANDLETYPE hReader, EXYNOS_OSAL_TRACE_RECORD *pRecord, OMX_PTR *ppPayload);
+void Exynos_OSAL_TraceReaderWait(OMX_HANDLETYPE hReader, EXYNOS_OSAL_TRACE_RECORD *pRecord);
+void Exynos_OSAL_TraceReaderClose(OMX_HANDLETYPE *pReaderHandle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,742 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_WorkerPool.c
+ * @brief       shared worker pool running buffer process steps
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OSAL_WorkerPool.h"
+
+#undef  EXYNOS_LOG_TAG
+#define EXYNOS_LOG_TAG    "EXYNOS_OSAL_WORKERPOOL"
+//#define EXYNOS_LOG_OFF
+#include "Exynos_OSAL_Log.h"
+
+typedef enum _WORKER_STATE
+{
+    WORKER_STATE_IDLE = 0,      /* parked, runs again when signaled */
+    WORKER_STATE_QUEUED,
+    WORKER_STATE_RUNNING,
+} WORKER_STATE;
+
+typedef struct _EXYNOS_OSAL_WORKER
+{
+    struct _EXYNOS_OSAL_WORKER *pNext;      /* run queue */
+    struct _EXYNOS_OSAL_WORKER *pNextAll;   /* every created worker */
+
+    EXYNOS_OSAL_WORKER_STEP     pStepFunc;
+    OMX_PTR                     pData;
+
+    /* protected by the pool mutex */
+    WORKER_STATE                eState;
+    OMX_BOOL                    bSignaled;
+    OMX_BOOL                    bTerminating;
+    pthread_cond_t              doneCond;
+
+    /* touched by the running step only */
+    OMX_BOOL                    bParked;
+    OMX_BOOL                    bRequeue;
+    OMX_U32                     nBlockingDepth;
+    OMX_U64                     nStepStartUs;
+    int                         hWaitFd;        /* registered with the pool epoll, -1: none */
+} EXYNOS_OSAL_WORKER;
+
+typedef struct _EXYNOS_OSAL_WORKER_POOL
+{
+    pthread_mutex_t      mutex;
+
+    EXYNOS_OSAL_WORKER  *pHead;
+    EXYNOS_OSAL_WORKER  *pTail;
+    EXYNOS_OSAL_WORKER  *pAll;
+
+    OMX_U32              nWorkers;
+    OMX_U32              nThreads;
+    OMX_U32              nIdle;         /* threads in epoll_wait */
+    OMX_U32              nBlocked;      /* threads inside a blocking call, not counted against nTarget */
+    OMX_U32              nTarget;
+    OMX_U32              nCpus;
+
+    /*
+     * idle threads wait on hEpoll, which has the fds of parked steps and hKickFd.
+     * a ready fd runs its worker on the thread that got it, hKickFd wakes one for the run queue.
+     * both are opened with the first worker and kept for the process.
+     */
+    int                  hEpoll;
+    int                  hKickFd;
+    OMX_BOOL             bKicked;       /* hKickFd is written and not read yet */
+} EXYNOS_OSAL_WORKER_POOL;
+
+/*
+ * one pool per process. this file is built into libExynosOMX_Resourcemanager,
+ * the shared library every component loads, not into the static OSAL library.
+ */
+static EXYNOS_OSAL_WORKER_POOL gWorkerPool = {
+    PTHREAD_MUTEX_INITIALIZER,
+    NULL, NULL, NULL, 0, 0, 0, 0, 0, 0, -1, -1, OMX_FALSE,
+};
+
+static __thread EXYNOS_OSAL_WORKER *gpCurrentWorker = NULL;
+static __thread OMX_BOOL            gbKickPending   = OMX_FALSE;
+
+OMX_BOOL Exynos_OSAL_WorkerPool_Enabled(void)
+{
+#ifdef USE_ANDROID
+    char poolProp[PROPERTY_VALUE_MAX] = { 0, };
+
+    if ((property_get("debug.omx.workerpool", poolProp, NULL) > 0) &&
+        (poolProp[0] == '1'))
+        return OMX_TRUE;
+#else
+    const char *pEnv = getenv("EXYNOS_OMX_WORKER_POOL");
+
+    if ((pEnv != NULL) &&
+        (pEnv[0] == '1'))
+        return OMX_TRUE;
+#endif
+
+    return OMX_FALSE;
+}
+
+static void *Exynos_OSAL_WorkerPool_Thread(void *pArg);
+
+/*
+ * pool mutex must be held. one write wakes one idle thread, which kicks again if there is more.
+ * the write is left to Exynos_OSAL_WorkerPool_Unlock(), a thread woken under the mutex only blocks on it.
+ */
+static void Exynos_OSAL_WorkerPool_WakeIdle(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    if ((pPool->nIdle == 0) ||
+        (pPool->bKicked == OMX_TRUE))
+        return;
+
+    pPool->bKicked = OMX_TRUE;
+    gbKickPending  = OMX_TRUE;
+}
+
+static void Exynos_OSAL_WorkerPool_Unlock(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    uint64_t nValue = 1;
+
+    pthread_mutex_unlock(&pPool->mutex);
+
+    if (gbKickPending == OMX_FALSE)
+        return;
+
+    gbKickPending = OMX_FALSE;
+
+    if (write(pPool->hKickFd, &nValue, sizeof(nValue)) != sizeof(nValue)) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] can not kick the pool: %d", __FUNCTION__, errno);
+        pthread_mutex_lock(&pPool->mutex);
+        pPool->bKicked = OMX_FALSE;
+        pthread_mutex_unlock(&pPool->mutex);
+    }
+}
+
+/* pool mutex must be held */
+static void Exynos_OSAL_WorkerPool_Spawn(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    pthread_t      thread;
+    pthread_attr_t attr;
+
+    if ((pPool->nThreads - pPool->nBlocked) >= pPool->nTarget)
+        return;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attr, Exynos_OSAL_WorkerPool_Thread, (void *)pPool) == 0) {
+        pPool->nThreads++;
+    } else {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] failed to spawn a pool thread(%d running)", __FUNCTION__, pPool->nThreads);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+/* pool mutex must be held */
+static void Exynos_OSAL_WorkerPool_Kick(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    if (pPool->pHead == NULL)
+        return;
+
+    /* running threads take the queue after their step, another one only helps with a cpu free */
+    if ((pPool->nThreads - pPool->nIdle - pPool->nBlocked) >= pPool->nCpus)
+        return;
+
+    if (pPool->nIdle > 0) {
+        Exynos_OSAL_WorkerPool_WakeIdle(pPool);
+        return;
+    }
+
+    Exynos_OSAL_WorkerPool_Spawn(pPool);
+}
+
+/* pool mutex must be held */
+static void Exynos_OSAL_WorkerPool_Append(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker)
+{
+    pWorker->eState = WORKER_STATE_QUEUED;
+    pWorker->pNext  = NULL;
+
+    if (pPool->pTail != NULL)
+        pPool->pTail->pNext = pWorker;
+    else
+        pPool->pHead = pWorker;
+    pPool->pTail = pWorker;
+}
+
+/* pool mutex must be held */
+static void Exynos_OSAL_WorkerPool_Enqueue(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker)
+{
+    Exynos_OSAL_WorkerPool_Append(pPool, pWorker);
+    Exynos_OSAL_WorkerPool_Kick(pPool);
+}
+
+/* pool mutex must be held */
+static void Exynos_OSAL_WorkerPool_Remove(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker)
+{
+    EXYNOS_OSAL_WORKER **ppCur  = &pPool->pHead;
+    EXYNOS_OSAL_WORKER  *pPrev  = NULL;
+
+    while (*ppCur != NULL) {
+        if (*ppCur == pWorker) {
+            *ppCur = pWorker->pNext;
+            if (pPool->pTail == pWorker)
+                pPool->pTail = pPrev;
+            break;
+        }
+        pPrev = *ppCur;
+        ppCur = &((*ppCur)->pNext);
+    }
+
+    pWorker->pNext = NULL;
+}
+
+/* pool mutex must be held */
+static OMX_BOOL Exynos_OSAL_WorkerPool_IsAlive(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker)
+{
+    EXYNOS_OSAL_WORKER *pCur = pPool->pAll;
+
+    while (pCur != NULL) {
+        if (pCur == pWorker)
+            return OMX_TRUE;
+        pCur = pCur->pNextAll;
+    }
+
+    return OMX_FALSE;
+}
+
+/*
+ * pool mutex must be held. bQueueOnly: the caller runs the queue itself.
+ * the caller may race with the terminate path, only touch a registered worker.
+ */
+static void Exynos_OSAL_WorkerPool_Signal(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker,
+    OMX_BOOL                 bQueueOnly)
+{
+    if ((Exynos_OSAL_WorkerPool_IsAlive(pPool, pWorker) == OMX_FALSE) ||
+        (pWorker->bTerminating == OMX_TRUE))
+        return;
+
+    if (pWorker->eState == WORKER_STATE_IDLE) {
+        if (bQueueOnly == OMX_TRUE)
+            Exynos_OSAL_WorkerPool_Append(pPool, pWorker);
+        else
+            Exynos_OSAL_WorkerPool_Enqueue(pPool, pWorker);
+    } else if (pWorker->eState == WORKER_STATE_RUNNING) {
+        pWorker->bSignaled = OMX_TRUE;
+    }
+}
+
+/* pool mutex is held on entry and on return, it is released while waiting */
+static void Exynos_OSAL_WorkerPool_Wait(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    struct epoll_event  events[WORKER_POLL_EVENTS];
+    uint64_t            nValue;
+    int                 nReady;
+    int                 i;
+
+    pPool->nIdle++;
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+    nReady = epoll_wait(pPool->hEpoll, events, WORKER_POLL_EVENTS, -1);
+    if ((nReady < 0) &&
+        (errno != EINTR))
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] epoll_wait is failed(%d)", __FUNCTION__, errno);
+
+    pthread_mutex_lock(&pPool->mutex);
+    pPool->nIdle--;
+
+    /* fds are registered one shot, so each ready one is handed to a single thread */
+    for (i = 0; i < nReady; i++) {
+        if (events[i].data.ptr == NULL) {
+            if (read(pPool->hKickFd, &nValue, sizeof(nValue)) < 0)
+                nValue = 0;
+            pPool->bKicked = OMX_FALSE;
+        } else {
+            Exynos_OSAL_WorkerPool_Signal(pPool, (EXYNOS_OSAL_WORKER *)events[i].data.ptr, OMX_TRUE);
+        }
+    }
+}
+
+/* pool mutex must be held */
+static OMX_ERRORTYPE Exynos_OSAL_WorkerPool_Open(EXYNOS_OSAL_WORKER_POOL *pPool)
+{
+    struct epoll_event event;
+
+    if (pPool->hEpoll >= 0)
+        return OMX_ErrorNone;
+
+    pPool->hEpoll  = epoll_create1(EPOLL_CLOEXEC);
+    pPool->hKickFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((pPool->hEpoll < 0) ||
+        (pPool->hKickFd < 0))
+        goto ERROR;
+
+    /* edge triggered, a kick wakes one thread and not every idle one */
+    Exynos_OSAL_Memset(&event, 0, sizeof(event));
+    event.events   = EPOLLIN | EPOLLET;
+    event.data.ptr = NULL;
+    if (epoll_ctl(pPool->hEpoll, EPOLL_CTL_ADD, pPool->hKickFd, &event) != 0)
+        goto ERROR;
+
+    return OMX_ErrorNone;
+
+ERROR:
+    Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] can not open the pool epoll: %d", __FUNCTION__, errno);
+
+    if (pPool->hKickFd >= 0)
+        close(pPool->hKickFd);
+    if (pPool->hEpoll >= 0)
+        close(pPool->hEpoll);
+    pPool->hKickFd = -1;
+    pPool->hEpoll  = -1;
+
+    return OMX_ErrorInsufficientResources;
+}
+
+static void *Exynos_OSAL_WorkerPool_Thread(void *pArg)
+{
+    EXYNOS_OSAL_WORKER_POOL *pPool   = (EXYNOS_OSAL_WORKER_POOL *)pArg;
+    EXYNOS_OSAL_WORKER      *pWorker = NULL;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    while (1) {
+        /*
+         * surplus threads left over from a blocking section retire here,
+         * a few are kept as spares so that the next blocking section does not spawn one again
+         */
+        if (((pPool->nThreads - pPool->nBlocked) > pPool->nTarget) &&
+            (pPool->nThreads > (pPool->nTarget + WORKER_POOL_SPARE_THREADS)))
+            break;
+
+        if (pPool->pHead == NULL) {
+            if (pPool->nWorkers == 0)
+                break;
+
+            Exynos_OSAL_WorkerPool_Wait(pPool);
+            continue;
+        }
+
+        pWorker = pPool->pHead;
+        pPool->pHead = pWorker->pNext;
+        if (pPool->pHead == NULL)
+            pPool->pTail = NULL;
+        pWorker->pNext     = NULL;
+        pWorker->eState    = WORKER_STATE_RUNNING;
+        pWorker->bSignaled = OMX_FALSE;
+
+        /* more than one got ready at once, another thread takes the rest */
+        if (pPool->pHead != NULL)
+            Exynos_OSAL_WorkerPool_Kick(pPool);
+
+        Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+        pWorker->bParked        = OMX_FALSE;
+        pWorker->bRequeue       = OMX_FALSE;
+        pWorker->nBlockingDepth = 0;
+        pWorker->nStepStartUs   = Exynos_OSAL_GetSystemTimeUs();
+
+        gpCurrentWorker = pWorker;
+        pWorker->pStepFunc(pWorker->pData);
+        gpCurrentWorker = NULL;
+
+        pthread_mutex_lock(&pPool->mutex);
+
+        if (pWorker->bTerminating == OMX_TRUE) {
+            pWorker->eState = WORKER_STATE_IDLE;
+            pthread_cond_broadcast(&pWorker->doneCond);
+        } else if ((pWorker->bRequeue == OMX_TRUE) ||
+                   (pWorker->bSignaled == OMX_TRUE)) {
+            /* this thread takes the queue next, waking another one for it only costs a switch */
+            Exynos_OSAL_WorkerPool_Append(pPool, pWorker);
+        } else {
+            pWorker->eState = WORKER_STATE_IDLE;
+        }
+    }
+
+    pPool->nThreads--;
+
+    /* the next idle one retires or takes over the queue */
+    Exynos_OSAL_WorkerPool_WakeIdle(pPool);
+
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+    return NULL;
+}
+
+OMX_ERRORTYPE Exynos_OSAL_WorkerCreate(
+    OMX_HANDLETYPE          *pWorkerHandle,
+    EXYNOS_OSAL_WORKER_STEP  pStepFunc,
+    OMX_PTR                  pData)
+{
+    OMX_ERRORTYPE            ret     = OMX_ErrorNone;
+    EXYNOS_OSAL_WORKER_POOL *pPool   = &gWorkerPool;
+    EXYNOS_OSAL_WORKER      *pWorker = NULL;
+    long                     nCpus   = 0;
+
+    FunctionIn();
+
+    if ((pWorkerHandle == NULL) ||
+        (pStepFunc == NULL)) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    pWorker = (EXYNOS_OSAL_WORKER *)Exynos_OSAL_Malloc(sizeof(EXYNOS_OSAL_WORKER));
+    if (pWorker == NULL) {
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+    Exynos_OSAL_Memset(pWorker, 0, sizeof(EXYNOS_OSAL_WORKER));
+
+    if (pthread_cond_init(&pWorker->doneCond, NULL) != 0) {
+        Exynos_OSAL_Free(pWorker);
+        ret = OMX_ErrorUndefined;
+        goto EXIT;
+    }
+
+    pWorker->pStepFunc = pStepFunc;
+    pWorker->pData     = pData;
+    pWorker->eState    = WORKER_STATE_IDLE;
+    pWorker->hWaitFd   = -1;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    if (Exynos_OSAL_WorkerPool_Open(pPool) != OMX_ErrorNone) {
+        Exynos_OSAL_WorkerPool_Unlock(pPool);
+        pthread_cond_destroy(&pWorker->doneCond);
+        Exynos_OSAL_Free(pWorker);
+        ret = OMX_ErrorInsufficientResources;
+        goto EXIT;
+    }
+
+    if (pPool->nTarget == 0) {
+        nCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        pPool->nCpus   = (nCpus > 1)? (OMX_U32)nCpus:1;
+        pPool->nTarget = (nCpus > WORKER_POOL_MIN_THREADS)? (OMX_U32)nCpus:WORKER_POOL_MIN_THREADS;
+    }
+
+    pWorker->pNextAll = pPool->pAll;
+    pPool->pAll = pWorker;
+    pPool->nWorkers++;
+
+    /* the first step finds out on its own whether there is something to do */
+    Exynos_OSAL_WorkerPool_Enqueue(pPool, pWorker);
+
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+    *pWorkerHandle = (OMX_HANDLETYPE)pWorker;
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+/* waits for a running step to return, the step must have been told to finish beforehand */
+void Exynos_OSAL_WorkerTerminate(OMX_HANDLETYPE *pWorkerHandle)
+{
+    EXYNOS_OSAL_WORKER_POOL  *pPool   = &gWorkerPool;
+    EXYNOS_OSAL_WORKER       *pWorker = NULL;
+    EXYNOS_OSAL_WORKER      **ppCur   = NULL;
+
+    FunctionIn();
+
+    if ((pWorkerHandle == NULL) ||
+        (*pWorkerHandle == NULL))
+        goto EXIT;
+
+    pWorker = (EXYNOS_OSAL_WORKER *)*pWorkerHandle;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    pWorker->bTerminating = OMX_TRUE;
+
+    if (pWorker->eState == WORKER_STATE_QUEUED) {
+        Exynos_OSAL_WorkerPool_Remove(pPool, pWorker);
+        pWorker->eState = WORKER_STATE_IDLE;
+    }
+
+    while (pWorker->eState == WORKER_STATE_RUNNING)
+        pthread_cond_wait(&pWorker->doneCond, &pPool->mutex);
+
+    for (ppCur = &pPool->pAll; *ppCur != NULL; ppCur = &((*ppCur)->pNextAll)) {
+        if (*ppCur == pWorker) {
+            *ppCur = pWorker->pNextAll;
+            break;
+        }
+    }
+    pPool->nWorkers--;
+
+    /* idle threads retire once the last worker is gone */
+    if (pPool->nWorkers == 0)
+        Exynos_OSAL_WorkerPool_WakeIdle(pPool);
+
+    /* the fd is still open here, the owner closes it after the buffer process is gone */
+    if (pWorker->hWaitFd >= 0)
+        epoll_ctl(pPool->hEpoll, EPOLL_CTL_DEL, pWorker->hWaitFd, NULL);
+
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+    pthread_cond_destroy(&pWorker->doneCond);
+    Exynos_OSAL_Free(pWorker);
+    *pWorkerHandle = NULL;
+
+EXIT:
+    FunctionOut();
+
+    return;
+}
+
+void Exynos_OSAL_WorkerSignal(OMX_HANDLETYPE hWorker)
+{
+    EXYNOS_OSAL_WORKER_POOL *pPool   = &gWorkerPool;
+    EXYNOS_OSAL_WORKER      *pWorker = (EXYNOS_OSAL_WORKER *)hWorker;
+
+    if (pWorker == NULL)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+    Exynos_OSAL_WorkerPool_Signal(pPool, pWorker, OMX_FALSE);
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+}
+
+OMX_HANDLETYPE Exynos_OSAL_WorkerCurrent(void)
+{
+    return (OMX_HANDLETYPE)gpCurrentWorker;
+}
+
+void Exynos_OSAL_WorkerPark(void)
+{
+    if (gpCurrentWorker != NULL)
+        gpCurrentWorker->bParked = OMX_TRUE;
+}
+
+OMX_BOOL Exynos_OSAL_WorkerParked(void)
+{
+    if (gpCurrentWorker == NULL)
+        return OMX_FALSE;
+
+    return gpCurrentWorker->bParked;
+}
+
+/*
+ * replaces sched_yield() at the top of a buffer process loop.
+ * returns OMX_TRUE when the step has to unwind and hand its thread back.
+ */
+OMX_BOOL Exynos_OSAL_WorkerYield(void)
+{
+    EXYNOS_OSAL_WORKER *pWorker = gpCurrentWorker;
+
+    if ((pWorker == NULL) ||
+        (pWorker->nBlockingDepth > 0)) {
+        sched_yield();
+        return OMX_FALSE;
+    }
+
+    if ((pWorker->bParked == OMX_TRUE) ||
+        (pWorker->bRequeue == OMX_TRUE))
+        return OMX_TRUE;
+
+    if ((Exynos_OSAL_GetSystemTimeUs() - pWorker->nStepStartUs) >= WORKER_TIME_SLICE_US) {
+        pWorker->bRequeue = OMX_TRUE;
+        return OMX_TRUE;
+    }
+
+    return OMX_FALSE;
+}
+
+/* brackets a call that may sleep in the kernel, another thread takes over the queue meanwhile */
+void Exynos_OSAL_WorkerBlockingBegin(void)
+{
+    EXYNOS_OSAL_WORKER_POOL *pPool   = &gWorkerPool;
+    EXYNOS_OSAL_WORKER      *pWorker = gpCurrentWorker;
+
+    if (pWorker == NULL)
+        return;
+
+    if (pWorker->nBlockingDepth++ > 0)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+    pPool->nBlocked++;
+    /* someone has to be left on the epoll for the parked steps, even with the queue empty */
+    if (pPool->pHead != NULL)
+        Exynos_OSAL_WorkerPool_Kick(pPool);
+    else if (pPool->nIdle == 0)
+        Exynos_OSAL_WorkerPool_Spawn(pPool);
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+}
+
+void Exynos_OSAL_WorkerBlockingEnd(void)
+{
+    EXYNOS_OSAL_WORKER_POOL *pPool   = &gWorkerPool;
+    EXYNOS_OSAL_WORKER      *pWorker = gpCurrentWorker;
+
+    if ((pWorker == NULL) ||
+        (pWorker->nBlockingDepth == 0))
+        return;
+
+    if (--pWorker->nBlockingDepth > 0)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+    pPool->nBlocked--;
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+}
+
+/*
+ * blocks like Exynos_OSAL_SemaphoreWait() on a plain thread.
+ * inside a step it parks instead and returns OMX_ErrorNotReady,
+ * whoever posts the semaphore signals the worker afterwards.
+ */
+OMX_ERRORTYPE Exynos_OSAL_WorkerSemaphoreWait(OMX_HANDLETYPE semaphoreHandle)
+{
+    EXYNOS_OSAL_WORKER *pWorker = gpCurrentWorker;
+
+    if ((pWorker == NULL) ||
+        (pWorker->nBlockingDepth > 0))
+        return Exynos_OSAL_SemaphoreWait(semaphoreHandle);
+
+    if (Exynos_OSAL_SemaphoreTryWait(semaphoreHandle) == OMX_ErrorNone)
+        return OMX_ErrorNone;
+
+    pWorker->bParked = OMX_TRUE;
+
+    return OMX_ErrorNotReady;
+}
+
+static OMX_ERRORTYPE Exynos_OSAL_WorkerPool_Watch(
+    EXYNOS_OSAL_WORKER_POOL *pPool,
+    EXYNOS_OSAL_WORKER      *pWorker,
+    int                      hFd)
+{
+    OMX_ERRORTYPE       ret    = OMX_ErrorNone;
+    struct epoll_event  event;
+    int                 hEpoll = -1;
+
+    pthread_mutex_lock(&pPool->mutex);
+
+    hEpoll = pPool->hEpoll;
+
+    if ((pWorker->hWaitFd >= 0) &&
+        (pWorker->hWaitFd != hFd)) {
+        epoll_ctl(hEpoll, EPOLL_CTL_DEL, pWorker->hWaitFd, NULL);
+        pWorker->hWaitFd = -1;
+    }
+
+    /* level triggered, so a fd that got ready after the check in the caller fires at once */
+    Exynos_OSAL_Memset(&event, 0, sizeof(event));
+    event.events   = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = (void *)pWorker;
+
+    if ((epoll_ctl(hEpoll, EPOLL_CTL_MOD, hFd, &event) != 0) &&
+        ((errno != ENOENT) ||
+         (epoll_ctl(hEpoll, EPOLL_CTL_ADD, hFd, &event) != 0))) {
+        Exynos_OSAL_Log(EXYNOS_LOG_ERROR, "[%s] can not watch fd(%d): %d", __FUNCTION__, hFd, errno);
+        ret = OMX_ErrorUndefined;
+        goto EXIT;
+    }
+
+    pWorker->hWaitFd = hFd;
+
+EXIT:
+    Exynos_OSAL_WorkerPool_Unlock(pPool);
+
+    return ret;
+}
+
+/*
+ * called before a call that sleeps until hFd is readable(a MFC dequeue).
+ * inside a step it parks the worker and returns OMX_FALSE when hFd is not readable yet,
+ * the pool thread that sees it ready runs the worker. OMX_TRUE lets the caller go on.
+ */
+OMX_BOOL Exynos_OSAL_WorkerWaitFd(int hFd)
+{
+    EXYNOS_OSAL_WORKER *pWorker = gpCurrentWorker;
+    struct pollfd       pollFd;
+
+    if ((pWorker == NULL) ||
+        (pWorker->nBlockingDepth > 0) ||
+        (hFd < 0))
+        return OMX_TRUE;
+
+    pollFd.fd      = hFd;
+    pollFd.events  = POLLIN;
+    pollFd.revents = 0;
+
+    /* an error is left to the call itself */
+    if (poll(&pollFd, 1, 0) != 0)
+        return OMX_TRUE;
+
+    /* when it can not be watched the call blocks, BlockingBegin() covers it */
+    if (Exynos_OSAL_WorkerPool_Watch(&gWorkerPool, pWorker, hFd) != OMX_ErrorNone)
+        return OMX_TRUE;
+
+    pWorker->bParked = OMX_TRUE;
+
+    return OMX_FALSE;
+}
@@ -0,0 +1,73 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OSAL_WorkerPool.h
+ * @brief       shared worker pool running buffer process steps
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef Exynos_OSAL_WORKERPOOL
+#define Exynos_OSAL_WORKERPOOL
+
+#include "OMX_Types.h"
+#include "OMX_Core.h"
+
+/*
+ * enabled by "debug.omx.workerpool" property (EXYNOS_OMX_WORKER_POOL env on non-android).
+ * the pool is shared by every component of the process.
+ *
+ * a worker is a step function that is run by one pool thread at a time, so the steps of
+ * a worker never run concurrently. a step runs until it parks (nothing to do) or its time
+ * slice expires, and it is run again when the worker is signaled or requeued.
+ * everything that may make a parked step runnable must call Exynos_OSAL_WorkerSignal()
+ * after updating the state the step looks at.
+ */
+#define WORKER_POOL_MIN_THREADS     2
+#define WORKER_POOL_SPARE_THREADS   2
+#define WORKER_TIME_SLICE_US        1000
+#define WORKER_POLL_EVENTS          16
+
+typedef OMX_ERRORTYPE (*EXYNOS_OSAL_WORKER_STEP)(OMX_PTR pData);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OMX_BOOL      Exynos_OSAL_WorkerPool_Enabled(void);
+
+OMX_ERRORTYPE Exynos_OSAL_WorkerCreate(OMX_HANDLETYPE *pWorkerHandle, EXYNOS_OSAL_WORKER_STEP pStepFunc, OMX_PTR pData);
+void          Exynos_OSAL_WorkerTerminate(OMX_HANDLETYPE *pWorkerHandle);
+void          Exynos_OSAL_WorkerSignal(OMX_HANDLETYPE hWorker);
+
+/* called from inside a step, they fall back to the plain thread behavior elsewhere */
+OMX_HANDLETYPE Exynos_OSAL_WorkerCurrent(void);
+void          Exynos_OSAL_WorkerPark(void);
+OMX_BOOL      Exynos_OSAL_WorkerParked(void);
+OMX_BOOL      Exynos_OSAL_WorkerYield(void);
+void          Exynos_OSAL_WorkerBlockingBegin(void);
+void          Exynos_OSAL_WorkerBlockingEnd(void);
+OMX_ERRORTYPE Exynos_OSAL_WorkerSemaphoreWait(OMX_HANDLETYPE semaphoreHandle);
+OMX_BOOL      Exynos_OSAL_WorkerWaitFd(int hFd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+LOCAL_PATH := $(call my-dir)
+
+# unit tests of the component and OSAL layers, built with "mm tests".
+# they run without MFC: codec hooks and kernel interfaces are faked in each test.
+
+EXYNOS_OMX_TEST_C_INCLUDES := \
+	$(EXYNOS_OMX_INC)/exynos \
+	$(EXYNOS_OMX_TOP)/osal \
+	$(EXYNOS_OMX_TOP)/core \
+	$(EXYNOS_OMX_COMPONENT)/common \
+	$(EXYNOS_OMX_COMPONENT)/video/dec \
+	$(EXYNOS_OMX_COMPONENT)/video/enc \
+	$(EXYNOS_OMX_TOP)/test \
+	$(EXYNOS_VIDEO_CODEC)/include \
+	$(TOP)/hardware/samsung_slsi-linaro/exynos/include
+
+EXYNOS_OMX_TEST_STATIC_LIBRARIES := \
+	libExynosOMX_Basecomponent \
+	libExynosOMX_OSAL \
+	libVendorVideoApi \
+	libExynosVideoApi
+
+EXYNOS_OMX_TEST_SHARED_LIBRARIES := \
+	libc \
+	libcutils \
+	libutils \
+	libdl \
+	liblog \
+	libion \
+	libhardware \
+	libhidlbase \
+	libui \
+	libexynosgraphicbuffer \
+	libstagefright_foundation \
+	libexynosv4l2 \
+	libion_exynos \
+	libcsc \
+	libExynosOMX_Resourcemanager \
+	libepicoperator
+
+EXYNOS_OMX_TEST_CFLAGS :=
+
+ifeq ($(BOARD_USE_KHRONOS_OMX_HEADER), true)
+EXYNOS_OMX_TEST_CFLAGS += -DUSE_KHRONOS_OMX_HEADER
+EXYNOS_OMX_TEST_C_INCLUDES += $(EXYNOS_OMX_INC)/khronos
+else
+ifeq ($(BOARD_USE_ANDROID), true)
+EXYNOS_OMX_TEST_HEADER_LIBRARIES := media_plugin_headers
+EXYNOS_OMX_TEST_CFLAGS += -DUSE_ANDROID
+endif
+endif
+
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+EXYNOS_OMX_TEST_CFLAGS += -DTUNNELING_SUPPORT
+endif
+
+EXYNOS_OMX_TEST_CFLAGS += -Wno-unused-variable -Wno-unused-label -Wno-unused-parameter
+
+# $(1): test name, built from Exynos_OMX_Test_$(1).c
+# $(2): libExynosOMX_Vdec or libExynosOMX_Venc, they can not be linked together
+# $(3): directory of a codec whose source the test includes, optional
+# $(4): extra cflags of the codec, optional
+define exynos-omx-test
+include $(CLEAR_VARS)
+LOCAL_MODULE := ExynosOMX_Test_$(1)
+LOCAL_MODULE_TAGS := tests
+LOCAL_PROPRIETARY_MODULE := true
+LOCAL_SRC_FILES := Exynos_OMX_Test.c Exynos_OMX_Test_$(1).c
+LOCAL_C_INCLUDES := $(EXYNOS_OMX_TEST_C_INCLUDES) $(3)
+LOCAL_HEADER_LIBRARIES := $(EXYNOS_OMX_TEST_HEADER_LIBRARIES)
+LOCAL_CFLAGS := $(EXYNOS_OMX_TEST_CFLAGS) $(4)
+LOCAL_STATIC_LIBRARIES := $(2) $(EXYNOS_OMX_TEST_STATIC_LIBRARIES)
+LOCAL_SHARED_LIBRARIES := $(EXYNOS_OMX_TEST_SHARED_LIBRARIES)
+include $(BUILD_EXECUTABLE)
+endef
+
+EXYNOS_OMX_VDEC_TESTS := \
+	DpbReuse \
+	KeyFrameOnly \
+	DropControl \
+	BufferBatch \
+	PauseWait \
+	HDR10PlusRing \
+	TraceRecord \
+	MemPressure
+
+ifeq ($(EXYNOS_OMX_SUPPORT_TUNNELING), true)
+EXYNOS_OMX_VDEC_TESTS += Tunnel
+endif
+
+$(foreach t,$(EXYNOS_OMX_VDEC_TESTS),$(eval $(call exynos-omx-test,$(t),libExynosOMX_Vdec)))
+
+EXYNOS_OMX_VENC_TESTS := \
+	LTRControl \
+	AdaptiveRoi \
+	Lookahead \
+	ExtensionIndex
+
+$(foreach t,$(EXYNOS_OMX_VENC_TESTS),$(eval $(call exynos-omx-test,$(t),libExynosOMX_Venc)))
+
+# bitstream parsers are private to each codec
+$(eval $(call exynos-omx-test,NonRefH264,libExynosOMX_Vdec,$(EXYNOS_OMX_COMPONENT)/video/dec/h264))
+$(eval $(call exynos-omx-test,NonRefHEVC,libExynosOMX_Vdec,$(EXYNOS_OMX_COMPONENT)/video/dec/hevc,-DUSE_HEVC_SUPPORT))
+$(eval $(call exynos-omx-test,NonRefVP9,libExynosOMX_Vdec,$(EXYNOS_OMX_COMPONENT)/video/dec/vp9,-DUSE_VP9_SUPPORT))
+$(eval $(call exynos-omx-test,WmvStartCode,libExynosOMX_Vdec,$(EXYNOS_OMX_COMPONENT)/video/dec/vc1))
+
+# exynos_ion_* of libion_exynos are replaced by memfd in the test
+$(eval $(call exynos-omx-test,SecurePool,libExynosOMX_Vdec))
+$(eval $(call exynos-omx-test,EncUseBuffer,libExynosOMX_Venc))
+
+# the image converter loads this in place of the vendor libImageFormatConverter.so,
+# installed aside so that only the test picks it up through LD_LIBRARY_PATH
+ifeq ($(BOARD_USE_ANDROID), true)
+include $(CLEAR_VARS)
+LOCAL_MODULE := libExynosOMX_ImgConvStub
+LOCAL_MODULE_STEM := libImageFormatConverter
+LOCAL_MODULE_RELATIVE_PATH := omx_test
+LOCAL_MODULE_TAGS := tests
+LOCAL_PROPRIETARY_MODULE := true
+LOCAL_SRC_FILES := Exynos_OMX_ImgConvStub.c
+LOCAL_C_INCLUDES := $(EXYNOS_OMX_TEST_C_INCLUDES)
+LOCAL_HEADER_LIBRARIES := $(EXYNOS_OMX_TEST_HEADER_LIBRARIES)
+LOCAL_CFLAGS := $(EXYNOS_OMX_TEST_CFLAGS)
+include $(BUILD_SHARED_LIBRARY)
+
+$(eval $(call exynos-omx-test,ImgConv,libExynosOMX_Vdec))
+
+# vendor extensions are in Exynos_OSAL_Android.cpp
+$(eval $(call exynos-omx-test,VendorExt,libExynosOMX_Venc))
+endif
+
+# the MFC model replaces the device part of libExynosVideoApi
+ifeq ($(BOARD_USE_MOCK_CODEC), true)
+$(eval $(call exynos-omx-test,MockCodec,libExynosOMX_Vdec,$(EXYNOS_VIDEO_CODEC)/osal/include,-DUSE_MOCK_CODEC))
+endif
+
+# IL clients of the OMX core, see Exynos_OMX_Client.c
+# $(1): tool name, built from Exynos_OMX_$(1).c
+define exynos-omx-tool
+include $(CLEAR_VARS)
+LOCAL_MODULE := ExynosOMX_$(1)
+LOCAL_MODULE_TAGS := optional
+LOCAL_PROPRIETARY_MODULE := true
+LOCAL_SRC_FILES := Exynos_OMX_Client.c Exynos_OMX_$(1).c
+LOCAL_C_INCLUDES := $(EXYNOS_OMX_TEST_C_INCLUDES)
+LOCAL_HEADER_LIBRARIES := $(EXYNOS_OMX_TEST_HEADER_LIBRARIES)
+LOCAL_CFLAGS := $(EXYNOS_OMX_TEST_CFLAGS)
+LOCAL_STATIC_LIBRARIES := libExynosOMX_OSAL
+LOCAL_SHARED_LIBRARIES := $(EXYNOS_OMX_TEST_SHARED_LIBRARIES) libExynosOMX_Core
+include $(BUILD_EXECUTABLE)
+endef
+
+# streams a file through a component and reports its performance
+$(eval $(call exynos-omx-tool,Bench))
+
+# replays a debug.omx.trace recording(Exynos_OSAL_Trace.c)
+$(eval $(call exynos-omx-tool,Replay))
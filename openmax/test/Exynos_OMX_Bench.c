@@ -0,0 +1,1110 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Bench.c
+ * @brief       streams a file through a component loaded by the OMX core and
+ *              reports fps, latency, cpu time per thread and memory.
+ *              decoders take H.264/HEVC elementary stream(start code framed),
+ *              encoders take raw NV12 frames.
+ *              with libExynosVideoApi built by BOARD_USE_MOCK_CODEC it runs
+ *              without MFC, see ExynosVideo_OSAL_Mock.c.
+ *              -s seeks back to the first unit from the middle of the stream
+ *              and reports the flush and the seek-to-first-frame latency.
+ *              -p pauses and resumes from the middle of the stream, one after
+ *              the frame of the former resume, and reports the pause command
+ *              and the resume-to-first-frame latency.
+ *              -m queries the pipeline metrics from another thread at the
+ *              given interval while streaming, the way a watchdog would, and
+ *              reports what a query costs and the last snapshot.
+ *              -u gives output buffers from the heap by UseBuffer, which an
+ *              encoder can't share with MFC and copies the stream into.
+ *              every session reports its startup phases up to the first
+ *              frame out, -r runs more sessions on the same core the way a
+ *              media server does.
+ *              -e transcodes, the decoder of -c feeds the given encoder and
+ *              the encoded frames are counted. the client copies every
+ *              decoded frame into an encoder input buffer, or with -t the
+ *              output port is tunneled to the encoder and the frames don't
+ *              come to the client at all. the cpu time per frame tells
+ *              the two apart.
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#include "OMX_Core.h"
+#include "OMX_Component.h"
+#include "OMX_Video.h"
+#include "Exynos_OMX_Def.h"
+#include "Exynos_OMX_Client.h"
+
+#define BENCH_DEFAULT_FPS       30
+#define BENCH_DEFAULT_BITRATE   (10 * 1000 * 1000)
+#define BENCH_PAUSE_US          2000    /* the codec finishes the frames it has while paused */
+#define BENCH_METRICS_SAMPLES   65536
+
+typedef struct _BENCH_UNIT
+{
+    OMX_U8 *pData;
+    OMX_U32 nSize;
+} BENCH_UNIT;
+
+typedef struct _BENCH_CONTEXT
+{
+    EXYNOS_OMX_CLIENT    client;
+    OMX_BOOL             bDecoder;
+    OMX_U32              nWidth;
+    OMX_U32              nHeight;
+    OMX_U32              nFramerate;
+    OMX_U32              nBitrate;
+
+    /* input file, an access unit or a raw frame per unit */
+    OMX_U8              *pFile;
+    BENCH_UNIT          *pUnit;
+    OMX_U32              nUnits;
+    OMX_U32              nNextUnit;
+    OMX_BOOL             bInputEOS;
+
+    /* startup of the session, up to the first frame out */
+    OMX_S64              nInitUs;
+    OMX_S64              nOpenStartUs;
+    OMX_S64              nOpenUs;
+    OMX_S64              nIdleUs;
+    OMX_S64              nExecutingUs;
+    OMX_S64              nFirstFrameUs;
+
+    /* statistics, the output side is updated under the client lock */
+    OMX_S64              nStartUs;
+    OMX_S64              nEndUs;
+    OMX_S64             *pInputUs;          /* by frame index */
+    OMX_U32             *pLatencyUs;
+    OMX_U32              nInputFrames;
+    OMX_U32              nOutputFrames;
+    OMX_U64              nOutputBytes;
+
+    /* seeks, a pending one ends at the first frame out after the flush */
+    OMX_U32              nSeeks;
+    OMX_U32              nSeekDone;
+    OMX_BOOL             bSeekPending;
+    OMX_S64              nSeekStartUs;
+    OMX_U32             *pFlushUs;
+    OMX_U32             *pSeekUs;
+
+    /* pause and resume, a pending resume ends at the first frame out */
+    OMX_U32              nPauses;
+    OMX_U32              nPauseDone;
+    OMX_BOOL             bResumePending;
+    OMX_S64              nResumeStartUs;
+    OMX_U32             *pPauseUs;
+    OMX_U32             *pResumeUs;
+
+    /* pipeline metrics, queried by its own thread while streaming */
+    OMX_U32                                     nMetricsIntervalUs;
+    OMX_INDEXTYPE                               eMetricsIndex;
+    pthread_t                                   metricsThread;
+    OMX_BOOL                                    bMetricsRunning;
+    OMX_U32                                     nMetricsQueries;
+    OMX_U32                                    *pMetricsUs;
+    EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS    metrics;
+
+    OMX_BOOL             bUseHeap;
+
+    /* transcode, the client is the decoder and the encoder takes its frames */
+    EXYNOS_OMX_CLIENT    encoder;
+    const char          *pEncoderName;
+    OMX_BOOL             bTunnel;
+    pthread_t            drainThread;
+    OMX_BOOL             bDraining;
+    OMX_U64              nRelayBytes;       /* copied by the client, under the decoder client lock */
+    OMX_S64              nCpuStartUs;
+} BENCH_CONTEXT;
+
+static OMX_S64 Bench_NowUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((OMX_S64)now.tv_sec * 1000000LL) + (now.tv_nsec / 1000);
+}
+
+/* of every thread in the process */
+static OMX_S64 Bench_CpuUs(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return ((OMX_S64)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000LL) +
+           usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+static OMX_TICKS Bench_FrameTime(BENCH_CONTEXT *pContext, OMX_U32 nFrame)
+{
+    return ((OMX_TICKS)nFrame * 1000000LL) / pContext->nFramerate;
+}
+
+static OMX_S32 Bench_FrameIndex(BENCH_CONTEXT *pContext, OMX_TICKS timeStamp)
+{
+    OMX_S64 nIndex = ((timeStamp * pContext->nFramerate) + 500000LL) / 1000000LL;
+
+    return ((nIndex >= 0) && (nIndex < (OMX_S64)pContext->nUnits))? (OMX_S32)nIndex:-1;
+}
+
+/* an access unit closes when a slice starts a new picture or a parameter set follows a slice */
+static OMX_BOOL Bench_IsNewPicture(OMX_BOOL bHEVC, OMX_U8 *pNal, OMX_U32 nSize, OMX_BOOL *pVCL)
+{
+    OMX_U32 nType;
+
+    if (nSize < 3)
+        return OMX_FALSE;
+
+    if (bHEVC == OMX_TRUE) {
+        nType = (pNal[0] >> 1) & 0x3F;
+        if (nType < 32) {
+            *pVCL = OMX_TRUE;
+            return (pNal[2] & 0x80)? OMX_TRUE:OMX_FALSE;    /* first_slice_segment_in_pic_flag */
+        }
+        *pVCL = OMX_FALSE;
+        return ((nType >= 32) && (nType <= 40))? OMX_TRUE:OMX_FALSE;
+    }
+
+    nType = pNal[0] & 0x1F;
+    if ((nType >= 1) && (nType <= 5)) {
+        *pVCL = OMX_TRUE;
+        return (pNal[1] & 0x80)? OMX_TRUE:OMX_FALSE;        /* first_mb_in_slice is 0 */
+    }
+    *pVCL = OMX_FALSE;
+    return ((nType >= 6) && (nType <= 9))? OMX_TRUE:OMX_FALSE;
+}
+
+static OMX_U32 Bench_SplitStream(BENCH_CONTEXT *pContext, OMX_U32 nFileSize, OMX_BOOL bHEVC)
+{
+    OMX_U8   *pFile     = pContext->pFile;
+    OMX_U32   nUnits    = 0;
+    OMX_U32   nStart    = 0;
+    OMX_BOOL  bHasVCL   = OMX_FALSE;
+    OMX_BOOL  bVCL      = OMX_FALSE;
+    OMX_U32   i;
+
+    pContext->pUnit = (BENCH_UNIT *)calloc((nFileSize / 4) + 1, sizeof(BENCH_UNIT));
+    if (pContext->pUnit == NULL)
+        return 0;
+
+    for (i = 0; (i + 3) < nFileSize; i++) {
+        if ((pFile[i] != 0) || (pFile[i + 1] != 0) || (pFile[i + 2] != 1))
+            continue;
+
+        if ((Bench_IsNewPicture(bHEVC, &pFile[i + 3], nFileSize - (i + 3), &bVCL) == OMX_TRUE) &&
+            (bHasVCL == OMX_TRUE)) {
+            /* a 4 byte start code belongs to the next unit */
+            OMX_U32 nEnd = ((i > 0) && (pFile[i - 1] == 0))? (i - 1):i;
+
+            pContext->pUnit[nUnits].pData = &pFile[nStart];
+            pContext->pUnit[nUnits].nSize = nEnd - nStart;
+            nUnits++;
+
+            nStart  = nEnd;
+            bHasVCL = OMX_FALSE;
+        }
+
+        if (bVCL == OMX_TRUE)
+            bHasVCL = OMX_TRUE;
+
+        i += 2;
+    }
+
+    if (nStart < nFileSize) {
+        pContext->pUnit[nUnits].pData = &pFile[nStart];
+        pContext->pUnit[nUnits].nSize = nFileSize - nStart;
+        nUnits++;
+    }
+
+    return nUnits;
+}
+
+static OMX_BOOL Bench_LoadInput(BENCH_CONTEXT *pContext, const char *pPath, const char *pComponentName, OMX_U32 nMaxFrames)
+{
+    FILE    *pFp        = NULL;
+    long     nFileSize  = 0;
+    OMX_U32  nFrameSize = (pContext->nWidth * pContext->nHeight * 3) / 2;
+    OMX_U32  i;
+
+    pFp = fopen(pPath, "rb");
+    if (pFp == NULL) {
+        printf("can not open %s: %s\n", pPath, strerror(errno));
+        return OMX_FALSE;
+    }
+
+    fseek(pFp, 0, SEEK_END);
+    nFileSize = ftell(pFp);
+    fseek(pFp, 0, SEEK_SET);
+
+    pContext->pFile = (OMX_U8 *)malloc((nFileSize > 0)? nFileSize:1);
+    if ((pContext->pFile == NULL) ||
+        (fread(pContext->pFile, 1, nFileSize, pFp) != (size_t)nFileSize)) {
+        fclose(pFp);
+        return OMX_FALSE;
+    }
+    fclose(pFp);
+
+    if (pContext->bDecoder == OMX_TRUE) {
+        pContext->nUnits = Bench_SplitStream(pContext, (OMX_U32)nFileSize,
+                                             (strstr(pComponentName, "HEVC") != NULL)? OMX_TRUE:OMX_FALSE);
+    } else {
+        pContext->nUnits = (OMX_U32)nFileSize / nFrameSize;
+        pContext->pUnit  = (BENCH_UNIT *)calloc(pContext->nUnits + 1, sizeof(BENCH_UNIT));
+        for (i = 0; (pContext->pUnit != NULL) && (i < pContext->nUnits); i++) {
+            pContext->pUnit[i].pData = pContext->pFile + (i * nFrameSize);
+            pContext->pUnit[i].nSize = nFrameSize;
+        }
+    }
+
+    if ((nMaxFrames > 0) &&
+        (pContext->nUnits > nMaxFrames))
+        pContext->nUnits = nMaxFrames;
+
+    pContext->pInputUs   = (OMX_S64 *)calloc(pContext->nUnits + 1, sizeof(OMX_S64));
+    pContext->pLatencyUs = (OMX_U32 *)calloc(pContext->nUnits + 1, sizeof(OMX_U32));
+    pContext->pFlushUs   = (OMX_U32 *)calloc(pContext->nSeeks + 1, sizeof(OMX_U32));
+    pContext->pSeekUs    = (OMX_U32 *)calloc(pContext->nSeeks + 1, sizeof(OMX_U32));
+    pContext->pPauseUs   = (OMX_U32 *)calloc(pContext->nPauses + 1, sizeof(OMX_U32));
+    pContext->pResumeUs  = (OMX_U32 *)calloc(pContext->nPauses + 1, sizeof(OMX_U32));
+    pContext->pMetricsUs = (OMX_U32 *)calloc(BENCH_METRICS_SAMPLES, sizeof(OMX_U32));
+
+    return ((pContext->nUnits > 0) &&
+            (pContext->pInputUs != NULL) && (pContext->pLatencyUs != NULL) &&
+            (pContext->pFlushUs != NULL) && (pContext->pSeekUs != NULL) &&
+            (pContext->pPauseUs != NULL) && (pContext->pResumeUs != NULL) &&
+            (pContext->pMetricsUs != NULL))? OMX_TRUE:OMX_FALSE;
+}
+
+/* called by the client under its lock */
+static void Bench_FillBufferDone(EXYNOS_OMX_CLIENT *pClient, OMX_BUFFERHEADERTYPE *pBufferHeader)
+{
+    BENCH_CONTEXT *pContext = (BENCH_CONTEXT *)pClient->pAppData;
+    OMX_S64        nNowUs   = Bench_NowUs();
+    OMX_S32        nIndex;
+
+    if ((pBufferHeader->nFilledLen > 0) &&
+        !(pBufferHeader->nFlags & OMX_BUFFERFLAG_CODECCONFIG)) {
+        if (pContext->nFirstFrameUs == 0)
+            pContext->nFirstFrameUs = nNowUs;
+
+        nIndex = Bench_FrameIndex(pContext, pBufferHeader->nTimeStamp);
+        if ((nIndex >= 0) &&
+            (pContext->pInputUs[nIndex] != 0) &&
+            (pContext->nOutputFrames < pContext->nUnits))
+            pContext->pLatencyUs[pContext->nOutputFrames] = (OMX_U32)(nNowUs - pContext->pInputUs[nIndex]);
+
+        pContext->nOutputFrames++;
+        pContext->nOutputBytes += pBufferHeader->nFilledLen;
+
+        if (pContext->bSeekPending == OMX_TRUE) {
+            pContext->pSeekUs[pContext->nSeekDone - 1] = (OMX_U32)(nNowUs - pContext->nSeekStartUs);
+            pContext->bSeekPending = OMX_FALSE;
+        }
+
+        if (pContext->bResumePending == OMX_TRUE) {
+            pContext->pResumeUs[pContext->nPauseDone - 1] = (OMX_U32)(nNowUs - pContext->nResumeStartUs);
+            pContext->bResumePending = OMX_FALSE;
+        }
+    }
+
+    if (pBufferHeader->nFlags & OMX_BUFFERFLAG_EOS)
+        pContext->nEndUs = nNowUs;
+}
+
+static OMX_ERRORTYPE Bench_SetupPorts(BENCH_CONTEXT *pContext, EXYNOS_OMX_CLIENT *pClient, OMX_BOOL bDecoder)
+{
+    OMX_PARAM_PORTDEFINITIONTYPE    portDef;
+    OMX_VIDEO_PARAM_BITRATETYPE     bitrate;
+    OMX_ERRORTYPE                   ret;
+
+    CLIENT_INIT_PARAM(portDef);
+    portDef.nPortIndex = CLIENT_INPUT_PORT;
+    ret = OMX_GetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    portDef.format.video.nFrameWidth    = pContext->nWidth;
+    portDef.format.video.nFrameHeight   = pContext->nHeight;
+    portDef.format.video.nStride        = pContext->nWidth;
+    portDef.format.video.nSliceHeight   = pContext->nHeight;
+    portDef.format.video.xFramerate     = pContext->nFramerate << 16;
+    if (bDecoder == OMX_FALSE)
+        portDef.format.video.eColorFormat = OMX_COLOR_FormatYUV420SemiPlanar;
+
+    ret = OMX_SetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    if (bDecoder == OMX_TRUE)
+        return OMX_ErrorNone;
+
+    CLIENT_INIT_PARAM(portDef);
+    portDef.nPortIndex = CLIENT_OUTPUT_PORT;
+    ret = OMX_GetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    portDef.format.video.nFrameWidth    = pContext->nWidth;
+    portDef.format.video.nFrameHeight   = pContext->nHeight;
+    portDef.format.video.nBitrate       = pContext->nBitrate;
+    portDef.format.video.xFramerate     = pContext->nFramerate << 16;
+
+    ret = OMX_SetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    CLIENT_INIT_PARAM(bitrate);
+    bitrate.nPortIndex = CLIENT_OUTPUT_PORT;
+    if (OMX_GetParameter(pClient->hComponent, OMX_IndexParamVideoBitrate, &bitrate) == OMX_ErrorNone) {
+        bitrate.nTargetBitrate = pContext->nBitrate;
+        bitrate.eControlRate   = OMX_Video_ControlRateVariable;
+        OMX_SetParameter(pClient->hComponent, OMX_IndexParamVideoBitrate, &bitrate);
+    }
+
+    return OMX_ErrorNone;
+}
+
+/* the decoder gives NV12 the way the encoder takes it, either way the frames go */
+static OMX_ERRORTYPE Bench_SetupTranscode(BENCH_CONTEXT *pContext)
+{
+    OMX_VIDEO_PARAM_PORTFORMATTYPE  portFormat;
+    OMX_ERRORTYPE                   ret;
+
+    CLIENT_INIT_PARAM(portFormat);
+    portFormat.nPortIndex = CLIENT_OUTPUT_PORT;
+    ret = OMX_GetParameter(pContext->client.hComponent, OMX_IndexParamVideoPortFormat, &portFormat);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    portFormat.eColorFormat = OMX_COLOR_FormatYUV420SemiPlanar;
+    ret = OMX_SetParameter(pContext->client.hComponent, OMX_IndexParamVideoPortFormat, &portFormat);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    if (pContext->bTunnel == OMX_FALSE)
+        return OMX_ErrorNone;
+
+    ret = OMX_SetupTunnel(pContext->client.hComponent, CLIENT_OUTPUT_PORT, pContext->encoder.hComponent, CLIENT_INPUT_PORT);
+    if (ret != OMX_ErrorNone)
+        printf("the decoder output is not tunneled to the encoder: 0x%x\n", ret);
+
+    return ret;
+}
+
+/* both ends of a transcode move together, a tunneled port is populated by the other end */
+static OMX_ERRORTYPE Bench_SetState(BENCH_CONTEXT *pContext, OMX_STATETYPE eState)
+{
+    OMX_ERRORTYPE ret;
+
+    if (pContext->encoder.hComponent == NULL)
+        return ExynosClient_SetState(&pContext->client, eState);
+
+    ret = ExynosClient_SendState(&pContext->encoder, eState);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_SendState(&pContext->client, eState);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitState(&pContext->encoder, eState);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitState(&pContext->client, eState);
+
+    return ret;
+}
+
+/* the tunnel buffers are allocated again by the decoder for the new geometry */
+static OMX_ERRORTYPE Bench_TunnelReconfigure(BENCH_CONTEXT *pContext)
+{
+    OMX_ERRORTYPE ret;
+
+    pthread_mutex_lock(&pContext->client.lock);
+    pContext->client.bReconfigure = OMX_FALSE;
+    pthread_mutex_unlock(&pContext->client.lock);
+
+    ret = OMX_SendCommand(pContext->encoder.hComponent, OMX_CommandPortDisable, CLIENT_INPUT_PORT, NULL);
+    if (ret == OMX_ErrorNone)
+        ret = OMX_SendCommand(pContext->client.hComponent, OMX_CommandPortDisable, CLIENT_OUTPUT_PORT, NULL);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(&pContext->encoder, OMX_CommandPortDisable, CLIENT_INPUT_PORT);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(&pContext->client, OMX_CommandPortDisable, CLIENT_OUTPUT_PORT);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    ret = OMX_SendCommand(pContext->encoder.hComponent, OMX_CommandPortEnable, CLIENT_INPUT_PORT, NULL);
+    if (ret == OMX_ErrorNone)
+        ret = OMX_SendCommand(pContext->client.hComponent, OMX_CommandPortEnable, CLIENT_OUTPUT_PORT, NULL);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(&pContext->encoder, OMX_CommandPortEnable, CLIENT_INPUT_PORT);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(&pContext->client, OMX_CommandPortEnable, CLIENT_OUTPUT_PORT);
+
+    return ret;
+}
+
+/*
+ * called by the decoder client under its lock. the frame is copied into an encoder input buffer
+ * the way a client without a tunnel does, the decoder waits for one meanwhile.
+ */
+static void Bench_RelayFrame(EXYNOS_OMX_CLIENT *pClient, OMX_BUFFERHEADERTYPE *pBufferHeader)
+{
+    BENCH_CONTEXT           *pContext = (BENCH_CONTEXT *)pClient->pAppData;
+    OMX_BUFFERHEADERTYPE    *pInput   = NULL;
+
+    /* flushed */
+    if ((pBufferHeader->nFilledLen == 0) &&
+        !(pBufferHeader->nFlags & OMX_BUFFERFLAG_EOS))
+        return;
+
+    if ((ExynosClient_WaitBuffer(&pContext->encoder, &pInput, NULL) != OMX_ErrorNone) ||
+        (pInput == NULL))
+        return;
+
+    pInput->nOffset    = 0;
+    pInput->nFilledLen = (pBufferHeader->nFilledLen < pInput->nAllocLen)? pBufferHeader->nFilledLen:pInput->nAllocLen;
+    pInput->nFlags     = pBufferHeader->nFlags;
+    pInput->nTimeStamp = pBufferHeader->nTimeStamp;
+    memcpy(pInput->pBuffer, pBufferHeader->pBuffer + pBufferHeader->nOffset, pInput->nFilledLen);
+    pContext->nRelayBytes += pInput->nFilledLen;
+
+    OMX_EmptyThisBuffer(pContext->encoder.hComponent, pInput);
+}
+
+/* gives the encoder outputs back, the transcode ends with the encoder EOS */
+static void *Bench_DrainThread(void *pArg)
+{
+    BENCH_CONTEXT           *pContext = (BENCH_CONTEXT *)pArg;
+    OMX_BUFFERHEADERTYPE    *pOutput  = NULL;
+
+    while (ExynosClient_WaitBuffer(&pContext->encoder, NULL, &pOutput) == OMX_ErrorNone) {
+        if (pOutput == NULL)
+            break;
+
+        pOutput->nFilledLen = 0;
+        pOutput->nFlags     = 0;
+        if (OMX_FillThisBuffer(pContext->encoder.hComponent, pOutput) != OMX_ErrorNone)
+            break;
+    }
+
+    /* a tunneled decoder has no output of its own to end the stream */
+    pthread_mutex_lock(&pContext->client.lock);
+    pContext->client.bOutputEOS = OMX_TRUE;
+    pthread_cond_broadcast(&pContext->client.cond);
+    pthread_mutex_unlock(&pContext->client.lock);
+
+    return NULL;
+}
+
+/* every buffer is back when both flushes complete, a frame out after that is decoded from the new position */
+static OMX_ERRORTYPE Bench_Seek(BENCH_CONTEXT *pContext)
+{
+    EXYNOS_OMX_CLIENT   *pClient    = &pContext->client;
+    OMX_S64              nStartUs   = Bench_NowUs();
+    OMX_ERRORTYPE        ret        = OMX_ErrorNone;
+
+    ret = OMX_SendCommand(pClient->hComponent, OMX_CommandFlush, OMX_ALL, NULL);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(pClient, OMX_CommandFlush, CLIENT_INPUT_PORT);
+    if (ret == OMX_ErrorNone)
+        ret = ExynosClient_WaitCommand(pClient, OMX_CommandFlush, CLIENT_OUTPUT_PORT);
+
+    pthread_mutex_lock(&pClient->lock);
+    pContext->pFlushUs[pContext->nSeekDone] = (OMX_U32)(Bench_NowUs() - nStartUs);
+    pContext->nSeekDone++;
+    pContext->nSeekStartUs = nStartUs;
+    pContext->bSeekPending = OMX_TRUE;
+    pthread_mutex_unlock(&pClient->lock);
+
+    /* the first unit carries the parameter sets */
+    pContext->nNextUnit = 0;
+
+    return ret;
+}
+
+/* the buffer threads park on Pause and have to be back at the first frame after Executing */
+static OMX_ERRORTYPE Bench_PauseResume(BENCH_CONTEXT *pContext)
+{
+    EXYNOS_OMX_CLIENT   *pClient    = &pContext->client;
+    OMX_S64              nStartUs   = Bench_NowUs();
+    OMX_ERRORTYPE        ret        = OMX_ErrorNone;
+
+    ret = ExynosClient_SetState(pClient, OMX_StatePause);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    pContext->pPauseUs[pContext->nPauseDone] = (OMX_U32)(Bench_NowUs() - nStartUs);
+    usleep(BENCH_PAUSE_US);
+
+    pthread_mutex_lock(&pClient->lock);
+    pContext->nPauseDone++;
+    pContext->nResumeStartUs = Bench_NowUs();
+    pContext->bResumePending = OMX_TRUE;
+    pthread_mutex_unlock(&pClient->lock);
+
+    return ExynosClient_SetState(pClient, OMX_StateExecuting);
+}
+
+static OMX_BOOL Bench_IsPauseDue(BENCH_CONTEXT *pContext)
+{
+    OMX_BOOL bDue = OMX_FALSE;
+
+    pthread_mutex_lock(&pContext->client.lock);
+    if ((pContext->nPauseDone < pContext->nPauses) &&
+        (pContext->bResumePending == OMX_FALSE) &&
+        (pContext->bInputEOS == OMX_FALSE) &&
+        (pContext->nNextUnit >= (pContext->nUnits / 2)))
+        bDue = OMX_TRUE;
+    pthread_mutex_unlock(&pContext->client.lock);
+
+    return bDue;
+}
+
+/* GetConfig of the metrics takes no port mutex, a query must not hold the pipeline up */
+static void *Bench_MetricsThread(void *pArg)
+{
+    BENCH_CONTEXT                               *pContext = (BENCH_CONTEXT *)pArg;
+    EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS     metrics;
+    OMX_S64                                      nStartUs;
+
+    while (__atomic_load_n(&pContext->bMetricsRunning, __ATOMIC_ACQUIRE) == OMX_TRUE) {
+        CLIENT_INIT_PARAM(metrics);
+        nStartUs = Bench_NowUs();
+        if (OMX_GetConfig(pContext->client.hComponent, pContext->eMetricsIndex, &metrics) != OMX_ErrorNone)
+            break;
+
+        if (pContext->nMetricsQueries < BENCH_METRICS_SAMPLES)
+            pContext->pMetricsUs[pContext->nMetricsQueries] = (OMX_U32)(Bench_NowUs() - nStartUs);
+        pContext->nMetricsQueries++;
+        pContext->metrics = metrics;
+
+        usleep(pContext->nMetricsIntervalUs);
+    }
+
+    return NULL;
+}
+
+static OMX_ERRORTYPE Bench_StartMetrics(BENCH_CONTEXT *pContext)
+{
+    OMX_ERRORTYPE ret;
+
+    ret = OMX_GetExtensionIndex(pContext->client.hComponent, (OMX_STRING)EXYNOS_INDEX_CONFIG_VIDEO_PIPELINE_METRICS,
+                                &pContext->eMetricsIndex);
+    if (ret != OMX_ErrorNone) {
+        printf("%s is not supported: 0x%x\n", EXYNOS_INDEX_CONFIG_VIDEO_PIPELINE_METRICS, ret);
+        return ret;
+    }
+
+    pContext->bMetricsRunning = OMX_TRUE;
+    if (pthread_create(&pContext->metricsThread, NULL, Bench_MetricsThread, pContext) != 0) {
+        pContext->bMetricsRunning = OMX_FALSE;
+        return OMX_ErrorInsufficientResources;
+    }
+
+    return OMX_ErrorNone;
+}
+
+static void Bench_StopMetrics(BENCH_CONTEXT *pContext)
+{
+    if (pContext->bMetricsRunning == OMX_FALSE)
+        return;
+
+    __atomic_store_n(&pContext->bMetricsRunning, OMX_FALSE, __ATOMIC_RELEASE);
+    pthread_join(pContext->metricsThread, NULL);
+}
+
+/* streams every unit and waits for the EOS on the output */
+static OMX_ERRORTYPE Bench_Stream(BENCH_CONTEXT *pContext)
+{
+    EXYNOS_OMX_CLIENT       *pClient = &pContext->client;
+    OMX_BUFFERHEADERTYPE    *pInput  = NULL;
+    OMX_BUFFERHEADERTYPE    *pOutput = NULL;
+    BENCH_UNIT              *pUnit   = NULL;
+    OMX_U32                  nFrame  = 0;
+    OMX_ERRORTYPE            ret     = OMX_ErrorNone;
+
+    pContext->nStartUs    = Bench_NowUs();
+    pContext->nCpuStartUs = Bench_CpuUs();
+
+    if (pContext->encoder.hComponent != NULL) {
+        if (pthread_create(&pContext->drainThread, NULL, Bench_DrainThread, pContext) != 0)
+            return OMX_ErrorInsufficientResources;
+        pContext->bDraining = OMX_TRUE;
+    }
+
+    while (ret == OMX_ErrorNone) {
+        if ((pContext->nSeekDone < pContext->nSeeks) &&
+            (pContext->nNextUnit >= (pContext->nUnits / 2))) {
+            ret = Bench_Seek(pContext);
+            continue;
+        }
+
+        if (Bench_IsPauseDue(pContext) == OMX_TRUE) {
+            ret = Bench_PauseResume(pContext);
+            if (ret != OMX_ErrorNone)
+                break;
+        }
+
+        pInput = NULL;
+        ret = ExynosClient_WaitBuffer(pClient, (pContext->bInputEOS == OMX_FALSE)? &pInput:NULL, &pOutput);
+        if ((ret != OMX_ErrorNone) ||
+            (pClient->bOutputEOS == OMX_TRUE))
+            break;
+
+        if ((pInput == NULL) &&
+            (pOutput == NULL)) {
+            if (pContext->bTunnel == OMX_TRUE)
+                ret = Bench_TunnelReconfigure(pContext);
+            else
+                ret = ExynosClient_Reconfigure(pClient);
+            continue;
+        }
+
+        if (pInput != NULL) {
+            nFrame = pContext->nNextUnit;
+            pInput->nOffset    = 0;
+            pInput->nFilledLen = 0;
+            pInput->nFlags     = 0;
+            pInput->nTimeStamp = Bench_FrameTime(pContext, nFrame);
+
+            if (nFrame < pContext->nUnits) {
+                pUnit = &pContext->pUnit[nFrame];
+                pInput->nFilledLen = (pUnit->nSize < pInput->nAllocLen)? pUnit->nSize:pInput->nAllocLen;
+                memcpy(pInput->pBuffer, pUnit->pData, pInput->nFilledLen);
+                pInput->nFlags = OMX_BUFFERFLAG_ENDOFFRAME;
+                pContext->pInputUs[nFrame] = Bench_NowUs();
+                pContext->nNextUnit++;
+                pContext->nInputFrames++;
+            }
+
+            if (pContext->nNextUnit >= pContext->nUnits) {
+                pInput->nFlags |= OMX_BUFFERFLAG_EOS;
+                pContext->bInputEOS = OMX_TRUE;
+            }
+
+            ret = OMX_EmptyThisBuffer(pContext->client.hComponent, pInput);
+        }
+
+        if ((ret == OMX_ErrorNone) &&
+            (pOutput != NULL)) {
+            pOutput->nFilledLen = 0;
+            pOutput->nFlags     = 0;
+            ret = OMX_FillThisBuffer(pContext->client.hComponent, pOutput);
+        }
+    }
+
+    if (pContext->bDraining == OMX_TRUE) {
+        if (ret != OMX_ErrorNone) {
+            pthread_mutex_lock(&pContext->encoder.lock);
+            pContext->encoder.bError = OMX_TRUE;
+            pthread_cond_broadcast(&pContext->encoder.cond);
+            pthread_mutex_unlock(&pContext->encoder.lock);
+        }
+
+        pthread_join(pContext->drainThread, NULL);
+        pContext->bDraining = OMX_FALSE;
+    }
+
+    if (pContext->nEndUs == 0)
+        pContext->nEndUs = Bench_NowUs();
+
+    return ret;
+}
+
+static int Bench_CompareU32(const void *pA, const void *pB)
+{
+    OMX_U32 nA = *(const OMX_U32 *)pA;
+    OMX_U32 nB = *(const OMX_U32 *)pB;
+
+    return (nA > nB) - (nA < nB);
+}
+
+/* sorts the samples */
+static void Bench_ReportPercentile(const char *pName, OMX_U32 *pSamples, OMX_U32 nSamples)
+{
+    qsort(pSamples, nSamples, sizeof(OMX_U32), Bench_CompareU32);
+    printf("  %s(us) p50 %lu, p90 %lu, p99 %lu, max %lu\n", pName,
+           (unsigned long)pSamples[(nSamples * 50) / 100],
+           (unsigned long)pSamples[(nSamples * 90) / 100],
+           (unsigned long)pSamples[(nSamples * 99) / 100],
+           (unsigned long)pSamples[nSamples - 1]);
+}
+
+static void Bench_ReportThreads(void)
+{
+    char            path[64];
+    char            line[512];
+    DIR            *pDir    = NULL;
+    struct dirent  *pEntry  = NULL;
+    FILE           *pFp     = NULL;
+    long            nTicks  = sysconf(_SC_CLK_TCK);
+
+    pDir = opendir("/proc/self/task");
+    if (pDir == NULL)
+        return;
+
+    while ((pEntry = readdir(pDir)) != NULL) {
+        char               *pName = NULL;
+        char               *pEnd  = NULL;
+        unsigned long long  nUser = 0, nSystem = 0;
+
+        if (pEntry->d_name[0] == '.')
+            continue;
+
+        snprintf(path, sizeof(path), "/proc/self/task/%s/stat", pEntry->d_name);
+        pFp = fopen(path, "r");
+        if (pFp == NULL)
+            continue;
+
+        if (fgets(line, sizeof(line), pFp) != NULL) {
+            /* pid (comm) state ..., utime and stime are the 14th and 15th fields */
+            pName = strchr(line, '(');
+            pEnd  = strrchr(line, ')');
+            if ((pName != NULL) &&
+                (pEnd != NULL) &&
+                (sscanf(pEnd + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &nUser, &nSystem) == 2)) {
+                *pEnd = '\0';
+                printf("  thread %-6s %-16s user %6llu ms, system %6llu ms\n", pEntry->d_name, pName + 1,
+                       (nUser * 1000) / nTicks, (nSystem * 1000) / nTicks);
+            }
+        }
+
+        fclose(pFp);
+    }
+
+    closedir(pDir);
+}
+
+static void Bench_ReportMemory(void)
+{
+    char  line[128];
+    FILE *pFp = fopen("/proc/self/status", "r");
+
+    if (pFp == NULL)
+        return;
+
+    while (fgets(line, sizeof(line), pFp) != NULL) {
+        if ((strncmp(line, "VmHWM:", 6) == 0) ||
+            (strncmp(line, "VmRSS:", 6) == 0))
+            printf("  %s", line);
+    }
+
+    fclose(pFp);
+}
+
+/* the core init is paid by the first session only */
+static void Bench_ReportStartup(BENCH_CONTEXT *pContext)
+{
+    OMX_S64 nStartUs = pContext->nOpenStartUs - pContext->nInitUs;
+
+    if ((pContext->nExecutingUs == 0) ||
+        (pContext->nFirstFrameUs == 0))
+        return;
+
+    printf("  startup(us): init %lu, get handle %lu, loaded->idle %lu, idle->executing %lu, first frame %lu\n",
+           (unsigned long)pContext->nInitUs,
+           (unsigned long)(pContext->nOpenUs - pContext->nOpenStartUs),
+           (unsigned long)(pContext->nIdleUs - pContext->nOpenUs),
+           (unsigned long)(pContext->nExecutingUs - pContext->nIdleUs),
+           (unsigned long)(pContext->nFirstFrameUs - pContext->nExecutingUs));
+    printf("  time to first frame(us) %lu\n", (unsigned long)(pContext->nFirstFrameUs - nStartUs));
+}
+
+/* taken before the teardown, the component threads are still there */
+static void Bench_Report(BENCH_CONTEXT *pContext, const char *pComponentName)
+{
+    OMX_S64 nElapsedUs  = pContext->nEndUs - pContext->nStartUs;
+    OMX_S64 nCpuUs      = Bench_CpuUs() - pContext->nCpuStartUs;
+    OMX_U32 nSamples    = (pContext->nOutputFrames < pContext->nUnits)? pContext->nOutputFrames:pContext->nUnits;
+
+    printf("%s: %lu frames in, %lu frames out(%llu bytes) for %lld ms\n", pComponentName,
+           (unsigned long)pContext->nInputFrames, (unsigned long)pContext->nOutputFrames,
+           (unsigned long long)pContext->nOutputBytes,
+           (long long)(nElapsedUs / 1000));
+
+    if (nElapsedUs > 0)
+        printf("  %.2f fps\n", ((double)pContext->nOutputFrames * 1000000.0) / (double)nElapsedUs);
+
+    if (pContext->nOutputFrames > 0)
+        printf("  cpu %lld ms, %lu us per frame\n", (long long)(nCpuUs / 1000),
+               (unsigned long)(nCpuUs / pContext->nOutputFrames));
+
+    if (pContext->encoder.hComponent != NULL)
+        printf("  %s to %s, %llu KB copied by the client\n", (pContext->bTunnel == OMX_TRUE)? "tunneled":"relayed",
+               pContext->pEncoderName, (unsigned long long)(pContext->nRelayBytes / 1024));
+
+    Bench_ReportStartup(pContext);
+
+    if (nSamples > 0)
+        Bench_ReportPercentile("latency", pContext->pLatencyUs, nSamples);
+
+    if (pContext->nSeekDone > 0) {
+        printf("  %lu seeks\n", (unsigned long)pContext->nSeekDone);
+        Bench_ReportPercentile("flush", pContext->pFlushUs, pContext->nSeekDone);
+        Bench_ReportPercentile("seek to first frame", pContext->pSeekUs, pContext->nSeekDone);
+    }
+
+    if (pContext->nMetricsQueries > 0) {
+        EXYNOS_OMX_VIDEO_CONFIG_PIPELINE_METRICS *pMetrics = &pContext->metrics;
+
+        printf("  %lu metrics queries every %lu us\n", (unsigned long)pContext->nMetricsQueries,
+               (unsigned long)pContext->nMetricsIntervalUs);
+        Bench_ReportPercentile("metrics query", pContext->pMetricsUs,
+                               (pContext->nMetricsQueries < BENCH_METRICS_SAMPLES)? pContext->nMetricsQueries:BENCH_METRICS_SAMPLES);
+        printf("  last metrics: queued %lu/%lu, held by codec %lu/%lu, frames %lu/%lu, dropped %lu, errors %lu, copied %lu/%lu KB\n",
+               (unsigned long)pMetrics->nInputQueued, (unsigned long)pMetrics->nOutputQueued,
+               (unsigned long)pMetrics->nInputHeldByCodec, (unsigned long)pMetrics->nOutputHeldByCodec,
+               (unsigned long)pMetrics->nInputFrames, (unsigned long)pMetrics->nOutputFrames,
+               (unsigned long)pMetrics->nDroppedFrames, (unsigned long)pMetrics->nErrors,
+               (unsigned long)pMetrics->nInputCopiedKB, (unsigned long)pMetrics->nOutputCopiedKB);
+    }
+
+    if (pContext->nPauseDone > 0) {
+        /* the last resume may end with the stream, before a frame */
+        OMX_U32 nResumed = pContext->nPauseDone - ((pContext->bResumePending == OMX_TRUE)? 1:0);
+
+        printf("  %lu pauses\n", (unsigned long)pContext->nPauseDone);
+        Bench_ReportPercentile("pause", pContext->pPauseUs, pContext->nPauseDone);
+        if (nResumed > 0)
+            Bench_ReportPercentile("resume to first frame", pContext->pResumeUs, nResumed);
+    }
+
+    Bench_ReportThreads();
+    Bench_ReportMemory();
+}
+
+static void Bench_Usage(const char *pName)
+{
+    printf("usage: %s -c <component> -i <input> -w <width> -h <height> [-n <frames>] [-f <fps>] [-b <bitrate>] [-s <seeks>] [-p <pauses>] [-m <metrics interval us>] [-r <sessions>] [-u] [-e <encoder> [-t]]\n", pName);
+    printf("  decoders take an H.264/HEVC elementary stream, encoders take raw NV12 frames\n");
+    printf("  -e transcodes the stream of the decoder, -t through a tunnel instead of a copy of the client\n");
+}
+
+/* a session starts from a fresh handle, the input and the core stay */
+static void Bench_ResetSession(BENCH_CONTEXT *pContext)
+{
+    memset(&pContext->client, 0, sizeof(pContext->client));
+    pContext->client.FillBufferDone = Bench_FillBufferDone;
+    pContext->client.pAppData       = pContext;
+    pContext->client.port[CLIENT_OUTPUT_PORT].bUseHeap = pContext->bUseHeap;
+
+    memset(&pContext->encoder, 0, sizeof(pContext->encoder));
+    if (pContext->pEncoderName != NULL) {
+        /* the frames are counted out of the encoder */
+        pContext->client.FillBufferDone  = (pContext->bTunnel == OMX_TRUE)? NULL:Bench_RelayFrame;
+        pContext->encoder.FillBufferDone = Bench_FillBufferDone;
+        pContext->encoder.pAppData       = pContext;
+        pContext->client.port[CLIENT_OUTPUT_PORT].bTunneled = pContext->bTunnel;
+        pContext->encoder.port[CLIENT_INPUT_PORT].bTunneled = pContext->bTunnel;
+    }
+
+    memset(pContext->pInputUs, 0, (pContext->nUnits + 1) * sizeof(OMX_S64));
+    memset(pContext->pLatencyUs, 0, (pContext->nUnits + 1) * sizeof(OMX_U32));
+
+    pContext->nNextUnit       = 0;
+    pContext->bInputEOS       = OMX_FALSE;
+    pContext->nInitUs         = 0;
+    pContext->nOpenStartUs    = 0;
+    pContext->nOpenUs         = 0;
+    pContext->nIdleUs         = 0;
+    pContext->nExecutingUs    = 0;
+    pContext->nFirstFrameUs   = 0;
+    pContext->nStartUs        = 0;
+    pContext->nEndUs          = 0;
+    pContext->nInputFrames    = 0;
+    pContext->nOutputFrames   = 0;
+    pContext->nOutputBytes    = 0;
+    pContext->nSeekDone       = 0;
+    pContext->bSeekPending    = OMX_FALSE;
+    pContext->nPauseDone      = 0;
+    pContext->bResumePending  = OMX_FALSE;
+    pContext->nMetricsQueries = 0;
+    pContext->nRelayBytes     = 0;
+}
+
+static OMX_ERRORTYPE Bench_Session(BENCH_CONTEXT *pContext, const char *pComponentName)
+{
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    pContext->nOpenStartUs = Bench_NowUs();
+    ret = ExynosClient_Open(&pContext->client, pComponentName);
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+    pContext->nOpenUs = Bench_NowUs();
+
+    if (pContext->pEncoderName != NULL) {
+        ret = ExynosClient_Open(&pContext->encoder, pContext->pEncoderName);
+        if (ret != OMX_ErrorNone)
+            goto EXIT;
+    }
+
+    ret = Bench_SetupPorts(pContext, &pContext->client, pContext->bDecoder);
+    if ((ret == OMX_ErrorNone) &&
+        (pContext->encoder.hComponent != NULL)) {
+        ret = Bench_SetupPorts(pContext, &pContext->encoder, OMX_FALSE);
+        if (ret == OMX_ErrorNone)
+            ret = Bench_SetupTranscode(pContext);
+    }
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+
+    ret = Bench_SetState(pContext, OMX_StateIdle);
+    if (ret != OMX_ErrorNone)
+        goto EXIT_FREE;
+    pContext->nIdleUs = Bench_NowUs();
+
+    ret = Bench_SetState(pContext, OMX_StateExecuting);
+    if (ret == OMX_ErrorNone) {
+        pContext->nExecutingUs = Bench_NowUs();
+        if (pContext->nMetricsIntervalUs > 0)
+            ret = Bench_StartMetrics(pContext);
+    }
+
+    if (ret == OMX_ErrorNone)
+        ret = Bench_Stream(pContext);
+
+    Bench_StopMetrics(pContext);
+
+    Bench_Report(pContext, pComponentName);
+
+    /* every buffer comes back on the way to Idle */
+    Bench_SetState(pContext, OMX_StateIdle);
+
+EXIT_FREE:
+    if (Bench_SetState(pContext, OMX_StateLoaded) != OMX_ErrorNone) {
+        ExynosClient_FreeBuffers(&pContext->client, CLIENT_INPUT_PORT);
+        ExynosClient_FreeBuffers(&pContext->client, CLIENT_OUTPUT_PORT);
+        ExynosClient_FreeBuffers(&pContext->encoder, CLIENT_INPUT_PORT);
+        ExynosClient_FreeBuffers(&pContext->encoder, CLIENT_OUTPUT_PORT);
+    }
+
+EXIT:
+    if (pContext->encoder.hComponent != NULL)
+        ExynosClient_Close(&pContext->encoder);
+    ExynosClient_Close(&pContext->client);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    BENCH_CONTEXT   context;
+    const char     *pComponentName  = NULL;
+    const char     *pInputPath      = NULL;
+    OMX_U32         nMaxFrames      = 0;
+    OMX_U32         nSessions       = 1;
+    OMX_S64         nInitUs         = 0;
+    OMX_ERRORTYPE   ret             = OMX_ErrorNone;
+    OMX_U32         i;
+    int             opt;
+
+    memset(&context, 0, sizeof(context));
+    context.nFramerate = BENCH_DEFAULT_FPS;
+    context.nBitrate   = BENCH_DEFAULT_BITRATE;
+
+    while ((opt = getopt(argc, argv, "c:i:w:h:n:f:b:s:p:m:r:ue:t")) != -1) {
+        switch (opt) {
+        case 'c': pComponentName     = optarg; break;
+        case 'i': pInputPath         = optarg; break;
+        case 'w': context.nWidth     = (OMX_U32)atoi(optarg); break;
+        case 'h': context.nHeight    = (OMX_U32)atoi(optarg); break;
+        case 'n': nMaxFrames         = (OMX_U32)atoi(optarg); break;
+        case 'f': context.nFramerate = (OMX_U32)atoi(optarg); break;
+        case 'b': context.nBitrate   = (OMX_U32)atoi(optarg); break;
+        case 's': context.nSeeks     = (OMX_U32)atoi(optarg); break;
+        case 'p': context.nPauses    = (OMX_U32)atoi(optarg); break;
+        case 'm': context.nMetricsIntervalUs = (OMX_U32)atoi(optarg); break;
+        case 'r': nSessions          = (OMX_U32)atoi(optarg); break;
+        case 'u': context.bUseHeap   = OMX_TRUE; break;
+        case 'e': context.pEncoderName = optarg; break;
+        case 't': context.bTunnel    = OMX_TRUE; break;
+        default:
+            Bench_Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((pComponentName == NULL) ||
+        (pInputPath == NULL) ||
+        (context.nWidth == 0) ||
+        (context.nHeight == 0) ||
+        (context.nFramerate == 0) ||
+        (nSessions == 0) ||
+        ((context.bTunnel == OMX_TRUE) && (context.pEncoderName == NULL))) {
+        Bench_Usage(argv[0]);
+        return 1;
+    }
+
+    context.bDecoder = (strstr(pComponentName, ".Decoder") != NULL)? OMX_TRUE:OMX_FALSE;
+    if ((context.pEncoderName != NULL) &&
+        (context.bDecoder == OMX_FALSE)) {
+        Bench_Usage(argv[0]);
+        return 1;
+    }
+    if (Bench_LoadInput(&context, pInputPath, pComponentName, nMaxFrames) != OMX_TRUE) {
+        printf("no frame is found in %s\n", pInputPath);
+        return 1;
+    }
+
+    /* the component keeps its own statistics as well(Exynos_OSAL_Bench) */
+    setenv("EXYNOS_OMX_BENCH", "1", 0);
+
+    /* a reference of its own keeps the core initialized over the sessions, the component libraries with it */
+    nInitUs = Bench_NowUs();
+    ret = OMX_Init();
+    if (ret != OMX_ErrorNone)
+        goto EXIT;
+    nInitUs = Bench_NowUs() - nInitUs;
+
+    for (i = 0; (i < nSessions) && (ret == OMX_ErrorNone); i++) {
+        Bench_ResetSession(&context);
+        if (i == 0)
+            context.nInitUs = nInitUs;
+
+        if (nSessions > 1)
+            printf("session %lu\n", (unsigned long)(i + 1));
+        ret = Bench_Session(&context, pComponentName);
+    }
+
+    OMX_Deinit();
+
+EXIT:
+    free(context.pMetricsUs);
+    free(context.pResumeUs);
+    free(context.pPauseUs);
+    free(context.pSeekUs);
+    free(context.pFlushUs);
+    free(context.pLatencyUs);
+    free(context.pInputUs);
+    free(context.pUnit);
+    free(context.pFile);
+
+    return (ret == OMX_ErrorNone)? 0:1;
+}
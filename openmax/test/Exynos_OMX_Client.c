@@ -0,0 +1,496 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Client.c
+ * @brief       minimal IL client of the OMX core, shared by the bench and replay tools
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "Exynos_OMX_Client.h"
+
+static void ExynosClient_Deadline(struct timespec *pDeadline)
+{
+    clock_gettime(CLOCK_REALTIME, pDeadline);
+    pDeadline->tv_sec += CLIENT_TIMEOUT_SEC;
+}
+
+static OMX_ERRORTYPE ExynosClient_EventHandler(
+    OMX_HANDLETYPE  hComponent,
+    OMX_PTR         pAppData,
+    OMX_EVENTTYPE   eEvent,
+    OMX_U32         nData1,
+    OMX_U32         nData2,
+    OMX_PTR         pEventData)
+{
+    EXYNOS_OMX_CLIENT *pClient = (EXYNOS_OMX_CLIENT *)pAppData;
+
+    pthread_mutex_lock(&pClient->lock);
+
+    switch (eEvent) {
+    case OMX_EventCmdComplete:
+        if (pClient->nEvents < CLIENT_MAX_EVENTS) {
+            pClient->event[pClient->nEvents].nCommand = nData1;
+            pClient->event[pClient->nEvents].nData    = nData2;
+            pClient->nEvents++;
+        }
+        break;
+    case OMX_EventPortSettingsChanged:
+        if ((nData1 == CLIENT_OUTPUT_PORT) &&
+            ((nData2 == 0) || (nData2 == OMX_IndexParamPortDefinition)))
+            pClient->bReconfigure = OMX_TRUE;
+        break;
+    case OMX_EventError:
+        printf("component error 0x%x(0x%x)\n", (unsigned int)nData1, (unsigned int)nData2);
+        pClient->bError = OMX_TRUE;
+        break;
+    default:
+        break;
+    }
+
+    pthread_cond_broadcast(&pClient->cond);
+    pthread_mutex_unlock(&pClient->lock);
+
+    return OMX_ErrorNone;
+}
+
+/* under the lock */
+static void ExynosClient_ReturnBuffer(
+    EXYNOS_OMX_CLIENT       *pClient,
+    OMX_U32                  nPortIndex,
+    OMX_BUFFERHEADERTYPE    *pBufferHeader)
+{
+    EXYNOS_CLIENT_PORT *pPort = &pClient->port[nPortIndex];
+    OMX_U32             i;
+
+    for (i = 0; i < pPort->nBuffers; i++) {
+        if (pPort->pHeader[i] == pBufferHeader)
+            pPort->bOwned[i] = OMX_TRUE;
+    }
+
+    pthread_cond_broadcast(&pClient->cond);
+}
+
+static OMX_ERRORTYPE ExynosClient_EmptyBufferDone(
+    OMX_HANDLETYPE          hComponent,
+    OMX_PTR                 pAppData,
+    OMX_BUFFERHEADERTYPE   *pBufferHeader)
+{
+    EXYNOS_OMX_CLIENT *pClient = (EXYNOS_OMX_CLIENT *)pAppData;
+
+    pthread_mutex_lock(&pClient->lock);
+    ExynosClient_ReturnBuffer(pClient, CLIENT_INPUT_PORT, pBufferHeader);
+    pthread_mutex_unlock(&pClient->lock);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE ExynosClient_FillBufferDone(
+    OMX_HANDLETYPE          hComponent,
+    OMX_PTR                 pAppData,
+    OMX_BUFFERHEADERTYPE   *pBufferHeader)
+{
+    EXYNOS_OMX_CLIENT *pClient = (EXYNOS_OMX_CLIENT *)pAppData;
+
+    pthread_mutex_lock(&pClient->lock);
+
+    if (pClient->FillBufferDone != NULL)
+        pClient->FillBufferDone(pClient, pBufferHeader);
+
+    if (pBufferHeader->nFlags & OMX_BUFFERFLAG_EOS)
+        pClient->bOutputEOS = OMX_TRUE;
+
+    ExynosClient_ReturnBuffer(pClient, CLIENT_OUTPUT_PORT, pBufferHeader);
+    pthread_mutex_unlock(&pClient->lock);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_CALLBACKTYPE gClientCallbacks = {
+    ExynosClient_EventHandler,
+    ExynosClient_EmptyBufferDone,
+    ExynosClient_FillBufferDone,
+};
+
+OMX_ERRORTYPE ExynosClient_Open(
+    EXYNOS_OMX_CLIENT   *pClient,
+    const char          *pComponentName)
+{
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+
+    pthread_mutex_init(&pClient->lock, NULL);
+    pthread_cond_init(&pClient->cond, NULL);
+
+    ret = OMX_Init();
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    ret = OMX_GetHandle(&pClient->hComponent, (OMX_STRING)pComponentName, pClient, &gClientCallbacks);
+    if (ret != OMX_ErrorNone) {
+        printf("%s is not loaded: 0x%x\n", pComponentName, ret);
+        pClient->hComponent = NULL;
+        OMX_Deinit();
+    }
+
+    return ret;
+}
+
+void ExynosClient_Close(EXYNOS_OMX_CLIENT *pClient)
+{
+    if (pClient->hComponent != NULL) {
+        OMX_FreeHandle(pClient->hComponent);
+        pClient->hComponent = NULL;
+        OMX_Deinit();
+    }
+
+    pthread_cond_destroy(&pClient->cond);
+    pthread_mutex_destroy(&pClient->lock);
+}
+
+OMX_ERRORTYPE ExynosClient_WaitCommand(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_COMMANDTYPE      eCommand,
+    OMX_U32              nData)
+{
+    struct timespec  deadline;
+    OMX_ERRORTYPE    ret = OMX_ErrorTimeout;
+    OMX_U32          i;
+
+    ExynosClient_Deadline(&deadline);
+
+    pthread_mutex_lock(&pClient->lock);
+    while (ret != OMX_ErrorNone) {
+        for (i = 0; i < pClient->nEvents; i++) {
+            if ((pClient->event[i].nCommand == (OMX_U32)eCommand) &&
+                (pClient->event[i].nData == nData)) {
+                pClient->nEvents--;
+                memmove(&pClient->event[i], &pClient->event[i + 1], sizeof(EXYNOS_CLIENT_EVENT) * (pClient->nEvents - i));
+                ret = OMX_ErrorNone;
+                break;
+            }
+        }
+
+        if (ret == OMX_ErrorNone)
+            break;
+
+        if ((pClient->bError == OMX_TRUE) ||
+            (pthread_cond_timedwait(&pClient->cond, &pClient->lock, &deadline) == ETIMEDOUT)) {
+            printf("command(%d, %d) is not completed\n", (int)eCommand, (int)nData);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pClient->lock);
+
+    return ret;
+}
+
+OMX_ERRORTYPE ExynosClient_AllocateBuffers(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    OMX_PARAM_PORTDEFINITIONTYPE  portDef;
+    EXYNOS_CLIENT_PORT           *pPort = &pClient->port[nPortIndex];
+    OMX_ERRORTYPE                 ret;
+    OMX_U32                       i;
+
+    if (pPort->bTunneled == OMX_TRUE) {
+        pPort->nBuffers = 0;
+        return OMX_ErrorNone;
+    }
+
+    CLIENT_INIT_PARAM(portDef);
+    portDef.nPortIndex = nPortIndex;
+    ret = OMX_GetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    pPort->nBuffers = (portDef.nBufferCountActual < CLIENT_MAX_BUFFERS)? portDef.nBufferCountActual:CLIENT_MAX_BUFFERS;
+
+    for (i = 0; i < pPort->nBuffers; i++) {
+        if (pPort->bUseHeap == OMX_TRUE) {
+            pPort->pHeap[i] = (OMX_U8 *)malloc(portDef.nBufferSize);
+            if (pPort->pHeap[i] == NULL)
+                ret = OMX_ErrorInsufficientResources;
+            else
+                ret = OMX_UseBuffer(pClient->hComponent, &pPort->pHeader[i], nPortIndex, pClient, portDef.nBufferSize, pPort->pHeap[i]);
+        } else {
+            ret = OMX_AllocateBuffer(pClient->hComponent, &pPort->pHeader[i], nPortIndex, pClient, portDef.nBufferSize);
+        }
+        if (ret != OMX_ErrorNone) {
+            free(pPort->pHeap[i]);
+            pPort->pHeap[i] = NULL;
+            printf("port(%d) buffer(%d) of %d bytes is not allocated: 0x%x\n",
+                   (int)nPortIndex, (int)i, (int)portDef.nBufferSize, ret);
+            pPort->nBuffers = i;
+            return ret;
+        }
+        pPort->bOwned[i] = OMX_TRUE;
+    }
+
+    return OMX_ErrorNone;
+}
+
+void ExynosClient_FreeBuffers(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    EXYNOS_CLIENT_PORT *pPort = &pClient->port[nPortIndex];
+    OMX_U32             i;
+
+    for (i = 0; i < pPort->nBuffers; i++) {
+        OMX_FreeBuffer(pClient->hComponent, nPortIndex, pPort->pHeader[i]);
+        free(pPort->pHeap[i]);
+        pPort->pHeap[i] = NULL;
+    }
+
+    pPort->nBuffers = 0;
+}
+
+static OMX_BOOL ExynosClient_IsEnabled(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    OMX_PARAM_PORTDEFINITIONTYPE portDef;
+
+    CLIENT_INIT_PARAM(portDef);
+    portDef.nPortIndex = nPortIndex;
+    if (OMX_GetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &portDef) != OMX_ErrorNone)
+        return OMX_FALSE;
+
+    return portDef.bEnabled;
+}
+
+/* buffers with the component come back by a flush, a disable or a move to Idle */
+static void ExynosClient_WaitReturned(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    EXYNOS_CLIENT_PORT  *pPort = &pClient->port[nPortIndex];
+    struct timespec      deadline;
+    OMX_U32              i, nOwned;
+
+    ExynosClient_Deadline(&deadline);
+
+    pthread_mutex_lock(&pClient->lock);
+    while (1) {
+        for (i = 0, nOwned = 0; i < pPort->nBuffers; i++)
+            nOwned += (pPort->bOwned[i] == OMX_TRUE)? 1:0;
+
+        if ((nOwned == pPort->nBuffers) ||
+            (pthread_cond_timedwait(&pClient->cond, &pClient->lock, &deadline) == ETIMEDOUT))
+            break;
+    }
+    pthread_mutex_unlock(&pClient->lock);
+}
+
+/* the buffers of the client are given or freed here, the completion is up to ExynosClient_WaitState() */
+OMX_ERRORTYPE ExynosClient_SendState(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_STATETYPE        eState)
+{
+    OMX_STATETYPE eCurrent = OMX_StateInvalid;
+    OMX_ERRORTYPE ret;
+
+    OMX_GetState(pClient->hComponent, &eCurrent);
+
+    ret = OMX_SendCommand(pClient->hComponent, OMX_CommandStateSet, eState, NULL);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    if ((eCurrent == OMX_StateLoaded) &&
+        (eState == OMX_StateIdle)) {
+        /* a port disabled in Loaded is populated by its enable later */
+        if (ExynosClient_IsEnabled(pClient, CLIENT_INPUT_PORT) == OMX_TRUE)
+            ret = ExynosClient_AllocateBuffers(pClient, CLIENT_INPUT_PORT);
+        if ((ret == OMX_ErrorNone) &&
+            (ExynosClient_IsEnabled(pClient, CLIENT_OUTPUT_PORT) == OMX_TRUE))
+            ret = ExynosClient_AllocateBuffers(pClient, CLIENT_OUTPUT_PORT);
+        if (ret != OMX_ErrorNone)
+            return ret;
+    }
+
+    if ((eCurrent == OMX_StateIdle) &&
+        (eState == OMX_StateLoaded)) {
+        ExynosClient_FreeBuffers(pClient, CLIENT_INPUT_PORT);
+        ExynosClient_FreeBuffers(pClient, CLIENT_OUTPUT_PORT);
+    }
+
+    return OMX_ErrorNone;
+}
+
+OMX_ERRORTYPE ExynosClient_WaitState(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_STATETYPE        eState)
+{
+    OMX_ERRORTYPE ret;
+
+    ret = ExynosClient_WaitCommand(pClient, OMX_CommandStateSet, eState);
+
+    if ((ret == OMX_ErrorNone) &&
+        (eState == OMX_StateIdle)) {
+        ExynosClient_WaitReturned(pClient, CLIENT_INPUT_PORT);
+        ExynosClient_WaitReturned(pClient, CLIENT_OUTPUT_PORT);
+    }
+
+    return ret;
+}
+
+/* tunneled components move together, each by ExynosClient_SendState() before any ExynosClient_WaitState() */
+OMX_ERRORTYPE ExynosClient_SetState(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_STATETYPE        eState)
+{
+    OMX_ERRORTYPE ret;
+
+    ret = ExynosClient_SendState(pClient, eState);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    return ExynosClient_WaitState(pClient, eState);
+}
+
+OMX_ERRORTYPE ExynosClient_DisablePort(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    OMX_ERRORTYPE ret;
+
+    ret = OMX_SendCommand(pClient->hComponent, OMX_CommandPortDisable, nPortIndex, NULL);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    /* the disable flushes the port, every buffer is freed once it is back */
+    ExynosClient_WaitReturned(pClient, nPortIndex);
+    ExynosClient_FreeBuffers(pClient, nPortIndex);
+
+    return ExynosClient_WaitCommand(pClient, OMX_CommandPortDisable, nPortIndex);
+}
+
+OMX_ERRORTYPE ExynosClient_EnablePort(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    OMX_STATETYPE eState = OMX_StateInvalid;
+    OMX_ERRORTYPE ret;
+
+    ret = OMX_SendCommand(pClient->hComponent, OMX_CommandPortEnable, nPortIndex, NULL);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    /* buffers are populated only out of Loaded */
+    OMX_GetState(pClient->hComponent, &eState);
+    if (eState != OMX_StateLoaded) {
+        ret = ExynosClient_AllocateBuffers(pClient, nPortIndex);
+        if (ret != OMX_ErrorNone)
+            return ret;
+    }
+
+    return ExynosClient_WaitCommand(pClient, OMX_CommandPortEnable, nPortIndex);
+}
+
+/* the decoder found the real geometry, the output port is built again */
+OMX_ERRORTYPE ExynosClient_Reconfigure(EXYNOS_OMX_CLIENT *pClient)
+{
+    OMX_ERRORTYPE ret;
+
+    pthread_mutex_lock(&pClient->lock);
+    pClient->bReconfigure = OMX_FALSE;
+    pthread_mutex_unlock(&pClient->lock);
+
+    ret = ExynosClient_DisablePort(pClient, CLIENT_OUTPUT_PORT);
+    if (ret != OMX_ErrorNone)
+        return ret;
+
+    return ExynosClient_EnablePort(pClient, CLIENT_OUTPUT_PORT);
+}
+
+/* under the lock */
+static OMX_BUFFERHEADERTYPE *ExynosClient_TakeBuffer(
+    EXYNOS_OMX_CLIENT   *pClient,
+    OMX_U32              nPortIndex)
+{
+    EXYNOS_CLIENT_PORT *pPort = &pClient->port[nPortIndex];
+    OMX_U32             i;
+
+    for (i = 0; i < pPort->nBuffers; i++) {
+        if (pPort->bOwned[i] == OMX_TRUE) {
+            pPort->bOwned[i] = OMX_FALSE;
+            return pPort->pHeader[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * takes a buffer of each port asked for by a non NULL pointer.
+ * returns with no buffer when the output reaches EOS, a reconfiguration is due or an error is reported.
+ */
+OMX_ERRORTYPE ExynosClient_WaitBuffer(
+    EXYNOS_OMX_CLIENT        *pClient,
+    OMX_BUFFERHEADERTYPE    **ppInput,
+    OMX_BUFFERHEADERTYPE    **ppOutput)
+{
+    struct timespec  deadline;
+    OMX_ERRORTYPE    ret = OMX_ErrorNone;
+
+    if (ppInput != NULL)
+        *ppInput = NULL;
+    if (ppOutput != NULL)
+        *ppOutput = NULL;
+
+    ExynosClient_Deadline(&deadline);
+
+    pthread_mutex_lock(&pClient->lock);
+    while (1) {
+        if ((pClient->bOutputEOS == OMX_TRUE) ||
+            (pClient->bError == OMX_TRUE) ||
+            (pClient->bReconfigure == OMX_TRUE))
+            break;
+
+        if (ppInput != NULL)
+            *ppInput = ExynosClient_TakeBuffer(pClient, CLIENT_INPUT_PORT);
+
+        if (ppOutput != NULL)
+            *ppOutput = ExynosClient_TakeBuffer(pClient, CLIENT_OUTPUT_PORT);
+
+        if (((ppInput != NULL) && (*ppInput != NULL)) ||
+            ((ppOutput != NULL) && (*ppOutput != NULL)))
+            break;
+
+        if (pthread_cond_timedwait(&pClient->cond, &pClient->lock, &deadline) == ETIMEDOUT) {
+            printf("no buffer is returned for %d sec\n", CLIENT_TIMEOUT_SEC);
+            pClient->bError = OMX_TRUE;
+            ret = OMX_ErrorTimeout;
+            break;
+        }
+    }
+
+    if (pClient->bError == OMX_TRUE)
+        ret = OMX_ErrorUndefined;
+    pthread_mutex_unlock(&pClient->lock);
+
+    return ret;
+}
@@ -0,0 +1,104 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Client.h
+ * @brief       minimal IL client of the OMX core, shared by the bench and replay tools
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef EXYNOS_OMX_CLIENT_H
+#define EXYNOS_OMX_CLIENT_H
+
+#include <pthread.h>
+
+#include "OMX_Core.h"
+#include "OMX_Component.h"
+
+#define CLIENT_MAX_BUFFERS      32
+#define CLIENT_MAX_EVENTS       16
+#define CLIENT_TIMEOUT_SEC      10
+
+#define CLIENT_INPUT_PORT       0
+#define CLIENT_OUTPUT_PORT      1
+
+#define CLIENT_INIT_PARAM(param)                                \
+    do {                                                        \
+        memset(&(param), 0, sizeof(param));                     \
+        (param).nSize = sizeof(param);                          \
+        (param).nVersion.s.nVersionMajor = 1;                   \
+        (param).nVersion.s.nVersionMinor = 1;                   \
+    } while (0)
+
+typedef struct _EXYNOS_CLIENT_EVENT
+{
+    OMX_U32 nCommand;
+    OMX_U32 nData;
+} EXYNOS_CLIENT_EVENT;
+
+typedef struct _EXYNOS_CLIENT_PORT
+{
+    OMX_BUFFERHEADERTYPE *pHeader[CLIENT_MAX_BUFFERS];
+    OMX_BOOL              bOwned[CLIENT_MAX_BUFFERS];   /* with the client, not the component */
+    OMX_U8               *pHeap[CLIENT_MAX_BUFFERS];    /* client memory given by UseBuffer */
+    OMX_U32               nBuffers;
+    OMX_BOOL              bUseHeap;
+    OMX_BOOL              bTunneled;                    /* populated by the tunnel peer, no buffer of the client */
+} EXYNOS_CLIENT_PORT;
+
+typedef struct _EXYNOS_OMX_CLIENT
+{
+    OMX_HANDLETYPE       hComponent;
+
+    pthread_mutex_t      lock;
+    pthread_cond_t       cond;
+    EXYNOS_CLIENT_PORT   port[2];
+    EXYNOS_CLIENT_EVENT  event[CLIENT_MAX_EVENTS];
+    OMX_U32              nEvents;
+    OMX_BOOL             bReconfigure;
+    OMX_BOOL             bOutputEOS;
+    OMX_BOOL             bError;
+
+    /* optional, called under the lock before the buffer is given back to the client */
+    void               (*FillBufferDone)(struct _EXYNOS_OMX_CLIENT *pClient, OMX_BUFFERHEADERTYPE *pBufferHeader);
+    OMX_PTR              pAppData;
+} EXYNOS_OMX_CLIENT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OMX_ERRORTYPE ExynosClient_Open(EXYNOS_OMX_CLIENT *pClient, const char *pComponentName);
+void ExynosClient_Close(EXYNOS_OMX_CLIENT *pClient);
+OMX_ERRORTYPE ExynosClient_WaitCommand(EXYNOS_OMX_CLIENT *pClient, OMX_COMMANDTYPE eCommand, OMX_U32 nData);
+OMX_ERRORTYPE ExynosClient_SetState(EXYNOS_OMX_CLIENT *pClient, OMX_STATETYPE eState);
+OMX_ERRORTYPE ExynosClient_SendState(EXYNOS_OMX_CLIENT *pClient, OMX_STATETYPE eState);
+OMX_ERRORTYPE ExynosClient_WaitState(EXYNOS_OMX_CLIENT *pClient, OMX_STATETYPE eState);
+OMX_ERRORTYPE ExynosClient_AllocateBuffers(EXYNOS_OMX_CLIENT *pClient, OMX_U32 nPortIndex);
+void ExynosClient_FreeBuffers(EXYNOS_OMX_CLIENT *pClient, OMX_U32 nPortIndex);
+OMX_ERRORTYPE ExynosClient_DisablePort(EXYNOS_OMX_CLIENT *pClient, OMX_U32 nPortIndex);
+OMX_ERRORTYPE ExynosClient_EnablePort(EXYNOS_OMX_CLIENT *pClient, OMX_U32 nPortIndex);
+OMX_ERRORTYPE ExynosClient_Reconfigure(EXYNOS_OMX_CLIENT *pClient);
+OMX_ERRORTYPE ExynosClient_WaitBuffer(EXYNOS_OMX_CLIENT *pClient, OMX_BUFFERHEADERTYPE **ppInput, OMX_BUFFERHEADERTYPE **ppOutput);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
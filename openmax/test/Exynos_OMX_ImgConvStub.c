@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_ImgConvStub.c
+ * @brief       libImageFormatConverter.so that only counts its calls,
+ *              loaded by Exynos_OSAL_ImageConverter.cpp in place of the real one
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdbool.h>
+
+#include "Exynos_OMX_Test.h"
+
+static EXYNOS_TEST_IMG_CONV_STUB gStub;
+static int gUserData;
+
+OMX_BOOL CL_HDR2SDR_ARM_init(const unsigned int width, const unsigned int height, const int algo, void **user_data, const bool usage)
+{
+    gStub.nInitCount++;
+    gStub.nWidth  = width;
+    gStub.nHeight = height;
+    gStub.nAlgo   = (OMX_U32)algo;
+
+    *user_data = &gUserData;
+
+    return OMX_TRUE;
+}
+
+void CL_HDR2SDR_ARM_deinit(void *user_data)
+{
+    if (user_data == &gUserData)
+        gStub.nDeinitCount++;
+}
+
+OMX_BOOL CL_HDR2SDR_ARM_convert(void *In_params, void *Out_params, void *meta, unsigned int mastering_max_luminance, void *user_data)
+{
+    gStub.nConvertCount++;
+
+    return OMX_TRUE;
+}
+
+EXYNOS_TEST_IMG_CONV_STUB *ExynosTest_ImgConvStub_Get(void)
+{
+    return &gStub;
+}
@@ -0,0 +1,349 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Replay.c
+ * @brief       replays a trace of debug.omx.trace(Exynos_OSAL_Trace) against the recorded component.
+ *              commands, parameters and configs are sent as recorded, buffers are allocated here.
+ *              input payloads are replayed when the trace is level 2, otherwise zero filled
+ *              buffers of the recorded size are sent.
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "OMX_Core.h"
+#include "OMX_Component.h"
+#include "Exynos_OMX_Def.h"
+#include "Exynos_OSAL_Trace.h"
+#include "Exynos_OMX_Client.h"
+
+#define REPLAY_MAX_SKIP     16
+
+typedef struct _REPLAY_CONTEXT
+{
+    EXYNOS_OMX_CLIENT    client;
+    OMX_HANDLETYPE       hReader;
+    OMX_BOOL             bPaced;
+    OMX_U32              skipIndex[REPLAY_MAX_SKIP];
+    OMX_U32              nSkipIndex;
+
+    OMX_U32              nReplayed;
+    OMX_U32              nSkipped;
+    OMX_U32              nFailed;
+    OMX_U32              nOutputFrames;
+} REPLAY_CONTEXT;
+
+/* called by the client under its lock */
+static void Replay_FillBufferDone(EXYNOS_OMX_CLIENT *pClient, OMX_BUFFERHEADERTYPE *pBufferHeader)
+{
+    REPLAY_CONTEXT *pContext = (REPLAY_CONTEXT *)pClient->pAppData;
+
+    if (pBufferHeader->nFilledLen > 0)
+        pContext->nOutputFrames++;
+}
+
+/* the recorded client reacts to EOS and port changes by itself, its calls follow in the trace */
+static OMX_BUFFERHEADERTYPE *Replay_TakeBuffer(REPLAY_CONTEXT *pContext, OMX_U32 nPortIndex)
+{
+    EXYNOS_OMX_CLIENT    *pClient = &pContext->client;
+    OMX_BUFFERHEADERTYPE *pBuffer = NULL;
+
+    while (ExynosClient_WaitBuffer(pClient,
+                                   (nPortIndex == CLIENT_INPUT_PORT)? &pBuffer:NULL,
+                                   (nPortIndex == CLIENT_OUTPUT_PORT)? &pBuffer:NULL) == OMX_ErrorNone) {
+        if (pBuffer != NULL)
+            break;
+
+        pthread_mutex_lock(&pClient->lock);
+        pClient->bReconfigure = OMX_FALSE;
+        pClient->bOutputEOS   = OMX_FALSE;
+        pthread_mutex_unlock(&pClient->lock);
+    }
+
+    return pBuffer;
+}
+
+static OMX_ERRORTYPE Replay_Command(REPLAY_CONTEXT *pContext, OMX_COMMANDTYPE eCommand, OMX_U32 nParam)
+{
+    EXYNOS_OMX_CLIENT   *pClient = &pContext->client;
+    OMX_ERRORTYPE        ret     = OMX_ErrorNone;
+    OMX_U32              nPort;
+
+    switch (eCommand) {
+    case OMX_CommandStateSet:
+        ret = ExynosClient_SetState(pClient, (OMX_STATETYPE)nParam);
+        break;
+    case OMX_CommandPortDisable:
+    case OMX_CommandPortEnable:
+        /* OMX_ALL is sent port by port, the client waits for one port at a time */
+        for (nPort = CLIENT_INPUT_PORT; (ret == OMX_ErrorNone) && (nPort <= CLIENT_OUTPUT_PORT); nPort++) {
+            if ((nParam != OMX_ALL) &&
+                (nParam != nPort))
+                continue;
+
+            if (eCommand == OMX_CommandPortDisable)
+                ret = ExynosClient_DisablePort(pClient, nPort);
+            else
+                ret = ExynosClient_EnablePort(pClient, nPort);
+        }
+        break;
+    case OMX_CommandFlush:
+        ret = OMX_SendCommand(pClient->hComponent, OMX_CommandFlush, nParam, NULL);
+        for (nPort = CLIENT_INPUT_PORT; (ret == OMX_ErrorNone) && (nPort <= CLIENT_OUTPUT_PORT); nPort++) {
+            if ((nParam == OMX_ALL) ||
+                (nParam == nPort))
+                ret = ExynosClient_WaitCommand(pClient, OMX_CommandFlush, nPort);
+        }
+        break;
+    default:
+        /* a mark refers to data of the recorded process */
+        pContext->nSkipped++;
+        break;
+    }
+
+    return ret;
+}
+
+static OMX_ERRORTYPE Replay_Buffer(REPLAY_CONTEXT *pContext, EXYNOS_OSAL_TRACE_RECORD *pRecord, OMX_PTR pPayload)
+{
+    EXYNOS_OMX_CLIENT    *pClient = &pContext->client;
+    OMX_BUFFERHEADERTYPE *pBuffer = NULL;
+    OMX_U32               nPort   = (pRecord->eType == TRACE_CALL_EMPTY_THIS_BUFFER)? CLIENT_INPUT_PORT:CLIENT_OUTPUT_PORT;
+
+    pBuffer = Replay_TakeBuffer(pContext, nPort);
+    if (pBuffer == NULL)
+        return OMX_ErrorTimeout;
+
+    if (nPort == CLIENT_OUTPUT_PORT) {
+        pBuffer->nFilledLen = 0;
+        pBuffer->nFlags     = 0;
+        return OMX_FillThisBuffer(pClient->hComponent, pBuffer);
+    }
+
+    pBuffer->nOffset    = 0;
+    pBuffer->nFilledLen = (pRecord->nDataLen < pBuffer->nAllocLen)? pRecord->nDataLen:pBuffer->nAllocLen;
+    pBuffer->nFlags     = pRecord->nParam;
+    pBuffer->nTimeStamp = (OMX_TICKS)pRecord->nTimeStamp;
+
+    if ((pPayload != NULL) &&
+        (pRecord->nPayloadLen >= pBuffer->nFilledLen))
+        memcpy(pBuffer->pBuffer, pPayload, pBuffer->nFilledLen);
+    else
+        memset(pBuffer->pBuffer, 0, pBuffer->nFilledLen);
+
+    return OMX_EmptyThisBuffer(pClient->hComponent, pBuffer);
+}
+
+static OMX_BOOL Replay_IsSkipped(REPLAY_CONTEXT *pContext, OMX_U32 nIndex)
+{
+    OMX_U32 i;
+
+    for (i = 0; i < pContext->nSkipIndex; i++) {
+        if (pContext->skipIndex[i] == nIndex)
+            return OMX_TRUE;
+    }
+
+    return OMX_FALSE;
+}
+
+/* the recorder leaves addresses out of a structure(Exynos_OMX_Trace_Structure), they are put back here */
+static void Replay_RestorePointers(REPLAY_CONTEXT *pContext, EXYNOS_OSAL_TRACE_RECORD *pRecord, OMX_PTR pPayload)
+{
+    EXYNOS_OMX_CLIENT *pClient = &pContext->client;
+
+    switch ((int)pRecord->nIndex) {
+    case OMX_IndexParamPortDefinition:
+    {
+        OMX_PARAM_PORTDEFINITIONTYPE *pPortDef = (OMX_PARAM_PORTDEFINITIONTYPE *)pPayload;
+        OMX_PARAM_PORTDEFINITIONTYPE  current;
+
+        if (pRecord->nDataLen != sizeof(OMX_PARAM_PORTDEFINITIONTYPE))
+            break;
+
+        memset(&current, 0, sizeof(current));
+        current.nSize      = sizeof(current);
+        current.nVersion   = pPortDef->nVersion;
+        current.nPortIndex = pPortDef->nPortIndex;
+        if (OMX_GetParameter(pClient->hComponent, OMX_IndexParamPortDefinition, &current) != OMX_ErrorNone)
+            break;
+
+        switch (pPortDef->eDomain) {
+        case OMX_PortDomainAudio:
+            pPortDef->format.audio.cMIMEType     = current.format.audio.cMIMEType;
+            pPortDef->format.audio.pNativeRender = current.format.audio.pNativeRender;
+            break;
+        case OMX_PortDomainVideo:
+            pPortDef->format.video.cMIMEType     = current.format.video.cMIMEType;
+            pPortDef->format.video.pNativeRender = current.format.video.pNativeRender;
+            pPortDef->format.video.pNativeWindow = current.format.video.pNativeWindow;
+            break;
+        case OMX_PortDomainImage:
+            pPortDef->format.image.cMIMEType     = current.format.image.cMIMEType;
+            pPortDef->format.image.pNativeRender = current.format.image.pNativeRender;
+            pPortDef->format.image.pNativeWindow = current.format.image.pNativeWindow;
+            break;
+        default:
+            break;
+        }
+    }
+        break;
+    case OMX_IndexConfigVideoRoiInfo:
+    {
+        EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *pRoiInfo = (EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *)pPayload;
+
+        /* the MB info was recorded after the structure */
+        if (pRecord->nDataLen > sizeof(EXYNOS_OMX_VIDEO_CONFIG_ROIINFO))
+            pRoiInfo->pRoiMBInfo = (OMX_PTR)((OMX_U8 *)pPayload + sizeof(EXYNOS_OMX_VIDEO_CONFIG_ROIINFO));
+    }
+        break;
+    default:
+        break;
+    }
+}
+
+static void Replay_Run(REPLAY_CONTEXT *pContext)
+{
+    EXYNOS_OMX_CLIENT           *pClient  = &pContext->client;
+    EXYNOS_OSAL_TRACE_RECORD     record;
+    OMX_PTR                      pPayload = NULL;
+    OMX_ERRORTYPE                ret      = OMX_ErrorNone;
+
+    while (Exynos_OSAL_TraceReaderNext(pContext->hReader, &record, &pPayload) == OMX_ErrorNone) {
+        if (pContext->bPaced == OMX_TRUE)
+            Exynos_OSAL_TraceReaderWait(pContext->hReader, &record);
+
+        switch (record.eType) {
+        case TRACE_CALL_SEND_COMMAND:
+            ret = Replay_Command(pContext, (OMX_COMMANDTYPE)record.nIndex, record.nParam);
+            break;
+        case TRACE_CALL_SET_PARAMETER:
+        case TRACE_CALL_SET_CONFIG:
+            if ((pPayload == NULL) ||
+                (Replay_IsSkipped(pContext, record.nIndex) == OMX_TRUE)) {
+                pContext->nSkipped++;
+                continue;
+            }
+
+            Replay_RestorePointers(pContext, &record, pPayload);
+
+            if (record.eType == TRACE_CALL_SET_PARAMETER)
+                ret = OMX_SetParameter(pClient->hComponent, (OMX_INDEXTYPE)record.nIndex, pPayload);
+            else
+                ret = OMX_SetConfig(pClient->hComponent, (OMX_INDEXTYPE)record.nIndex, pPayload);
+            break;
+        case TRACE_CALL_EMPTY_THIS_BUFFER:
+        case TRACE_CALL_FILL_THIS_BUFFER:
+            ret = Replay_Buffer(pContext, &record, pPayload);
+            break;
+        default:
+            pContext->nSkipped++;
+            continue;
+        }
+
+        pContext->nReplayed++;
+
+        if (ret != OMX_ErrorNone) {
+            /* the recorded client may have seen the same error, the replay goes on */
+            printf("record(%lu) type %lu index 0x%lx: 0x%x\n", (unsigned long)pContext->nReplayed,
+                   (unsigned long)record.eType, (unsigned long)record.nIndex, ret);
+            pContext->nFailed++;
+            if (pClient->bError == OMX_TRUE)
+                break;
+        }
+    }
+}
+
+static void Replay_Usage(const char *pName)
+{
+    printf("usage: %s [-r] [-x <index>]... <trace file>\n", pName);
+    printf("  -r : as fast as possible, the recorded pacing is kept by default\n");
+    printf("  -x : skips SetParameter/SetConfig of an index(hex), e.g. an index that needs a native window\n");
+}
+
+int main(int argc, char **argv)
+{
+    REPLAY_CONTEXT                   context;
+    EXYNOS_OSAL_TRACE_FILE_HEADER    header;
+    OMX_STATETYPE                    eState = OMX_StateInvalid;
+    int                              opt;
+
+    memset(&context, 0, sizeof(context));
+    context.bPaced = OMX_TRUE;
+
+    while ((opt = getopt(argc, argv, "rx:")) != -1) {
+        switch (opt) {
+        case 'r':
+            context.bPaced = OMX_FALSE;
+            break;
+        case 'x':
+            if (context.nSkipIndex < REPLAY_MAX_SKIP)
+                context.skipIndex[context.nSkipIndex++] = (OMX_U32)strtoul(optarg, NULL, 16);
+            break;
+        default:
+            Replay_Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        Replay_Usage(argv[0]);
+        return 1;
+    }
+
+    if (Exynos_OSAL_TraceReaderOpen(&context.hReader, argv[optind], &header) != OMX_ErrorNone) {
+        printf("%s is not a trace file\n", argv[optind]);
+        return 1;
+    }
+
+    printf("replaying %s(level %lu) of %s\n", argv[optind], (unsigned long)header.nLevel, header.componentName);
+
+    context.client.FillBufferDone = Replay_FillBufferDone;
+    context.client.pAppData       = &context;
+
+    if (ExynosClient_Open(&context.client, header.componentName) == OMX_ErrorNone) {
+        Replay_Run(&context);
+
+        /* a trace cut short leaves the component up */
+        OMX_GetState(context.client.hComponent, &eState);
+        if ((eState == OMX_StateExecuting) ||
+            (eState == OMX_StatePause)) {
+            ExynosClient_SetState(&context.client, OMX_StateIdle);
+            eState = OMX_StateIdle;
+        }
+
+        if ((eState == OMX_StateIdle) &&
+            (ExynosClient_SetState(&context.client, OMX_StateLoaded) != OMX_ErrorNone)) {
+            ExynosClient_FreeBuffers(&context.client, CLIENT_INPUT_PORT);
+            ExynosClient_FreeBuffers(&context.client, CLIENT_OUTPUT_PORT);
+        }
+
+        printf("%lu records replayed(%lu failed, %lu skipped), %lu frames out\n",
+               (unsigned long)context.nReplayed, (unsigned long)context.nFailed,
+               (unsigned long)context.nSkipped, (unsigned long)context.nOutputFrames);
+    }
+
+    ExynosClient_Close(&context.client);
+    Exynos_OSAL_TraceReaderClose(&context.hReader);
+
+    return ((context.nReplayed > 0) && (context.nFailed == 0))? 0:1;
+}
@@ -0,0 +1,126 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test.c
+ * @brief       helpers shared by the component unit tests
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Test.h"
+
+int               gTestFailCount = 0;
+EXYNOS_TEST_EVENT gTestEvent;
+
+static OMX_ERRORTYPE ExynosTest_EventHandler(
+    OMX_HANDLETYPE  hComponent,
+    OMX_PTR         pAppData,
+    OMX_EVENTTYPE   eEvent,
+    OMX_U32         nData1,
+    OMX_U32         nData2,
+    OMX_PTR         pEventData)
+{
+    gTestEvent.nCount++;
+    gTestEvent.eEvent = eEvent;
+    gTestEvent.nData1 = nData1;
+    gTestEvent.nData2 = nData2;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_CALLBACKTYPE gTestCallbacks = {
+    .EventHandler    = &ExynosTest_EventHandler,
+    .EmptyBufferDone = NULL,
+    .FillBufferDone  = NULL,
+};
+
+OMX_COMPONENTTYPE *ExynosTest_CreateComponent(OMX_U32 nHandleSize)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = NULL;
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    pOMXComponent    = (OMX_COMPONENTTYPE *)calloc(1, sizeof(OMX_COMPONENTTYPE));
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)calloc(1, sizeof(EXYNOS_OMX_BASECOMPONENT));
+    if ((pOMXComponent == NULL) ||
+        (pExynosComponent == NULL))
+        goto ERROR;
+
+    pExynosComponent->pExynosPort = (EXYNOS_OMX_BASEPORT *)calloc(ALL_PORT_NUM, sizeof(EXYNOS_OMX_BASEPORT));
+    pExynosComponent->hComponentHandle = calloc(1, nHandleSize);
+    if ((pExynosComponent->pExynosPort == NULL) ||
+        (pExynosComponent->hComponentHandle == NULL))
+        goto ERROR;
+
+    INIT_SET_SIZE_VERSION(pOMXComponent, OMX_COMPONENTTYPE);
+
+    /* no codec behind the ports, as the port constructor leaves them */
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].hCodecReadyFd  = -1;
+    pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].hCodecReadyFd = -1;
+
+    pExynosComponent->portParam.nPorts = ALL_PORT_NUM;
+    pExynosComponent->pCallbacks       = &gTestCallbacks;
+    pExynosComponent->currentState     = OMX_StateExecuting;
+    pExynosComponent->transientState   = EXYNOS_OMX_TransStateMax;
+    pOMXComponent->pComponentPrivate   = (OMX_PTR)pExynosComponent;
+
+    memset(&gTestEvent, 0, sizeof(gTestEvent));
+
+    return pOMXComponent;
+
+ERROR:
+    if (pExynosComponent != NULL) {
+        free(pExynosComponent->pExynosPort);
+        free(pExynosComponent->hComponentHandle);
+        free(pExynosComponent);
+    }
+    free(pOMXComponent);
+
+    return NULL;
+}
+
+void ExynosTest_DestroyComponent(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = NULL;
+
+    if (pOMXComponent == NULL)
+        return;
+
+    pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    if (pExynosComponent != NULL) {
+        free(pExynosComponent->pExynosPort);
+        free(pExynosComponent->hComponentHandle);
+        free(pExynosComponent);
+    }
+    free(pOMXComponent);
+}
+
+OMX_TICKS ExynosTest_GetTimeUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((OMX_TICKS)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
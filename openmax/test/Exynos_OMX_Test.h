@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test.h
+ * @brief       helpers shared by the component unit tests
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef EXYNOS_OMX_TEST
+#define EXYNOS_OMX_TEST
+
+#include <stdio.h>
+
+#include "OMX_Component.h"
+#include "Exynos_OMX_Def.h"
+#include "Exynos_OMX_Basecomponent.h"
+
+extern int gTestFailCount;
+
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);              \
+            gTestFailCount++;                                                   \
+        }                                                                       \
+    } while (0)
+
+#define TEST_RUN(func)                                                          \
+    do {                                                                        \
+        int nFailBefore = gTestFailCount;                                       \
+        func();                                                                 \
+        printf("%s %s\n", (gTestFailCount == nFailBefore)? "PASS":"FAIL", #func); \
+    } while (0)
+
+#define TEST_RESULT()    ((gTestFailCount == 0)? 0:1)
+
+/* the last event a fake component sent to its client */
+typedef struct _EXYNOS_TEST_EVENT
+{
+    OMX_U32       nCount;
+    OMX_EVENTTYPE eEvent;
+    OMX_U32       nData1;
+    OMX_U32       nData2;
+} EXYNOS_TEST_EVENT;
+
+extern EXYNOS_TEST_EVENT gTestEvent;
+
+/* what the stub of libImageFormatConverter.so was called with, see Exynos_OMX_ImgConvStub.c */
+typedef struct _EXYNOS_TEST_IMG_CONV_STUB
+{
+    OMX_U32 nInitCount;
+    OMX_U32 nDeinitCount;
+    OMX_U32 nConvertCount;
+    OMX_U32 nWidth;
+    OMX_U32 nHeight;
+    OMX_U32 nAlgo;
+} EXYNOS_TEST_IMG_CONV_STUB;
+
+#define EXYNOS_TEST_IMG_CONV_STUB_GET   "ExynosTest_ImgConvStub_Get"
+typedef EXYNOS_TEST_IMG_CONV_STUB *(*EXYNOS_TEST_IMG_CONV_STUB_GET_FUNC)(void);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* a component with two ports and no codec, hComponentHandle points to nHandleSize zeroed bytes */
+OMX_COMPONENTTYPE *ExynosTest_CreateComponent(OMX_U32 nHandleSize);
+void ExynosTest_DestroyComponent(OMX_COMPONENTTYPE *pOMXComponent);
+OMX_TICKS ExynosTest_GetTimeUs(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_AdaptiveRoi.c
+ * @brief       input analysis of the encoder on the CSC destination, with a host benchmark
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Venc.h"
+#include "Exynos_OSAL_Memory.h"
+
+#define TEST_WIDTH          1920
+#define TEST_HEIGHT         1080
+#define TEST_BENCH_FRAMES   30
+
+/* a flat left half and a textured right half, shifted by nShift pixels */
+static OMX_U8 Test_Luma(OMX_U32 x, OMX_U32 y, OMX_U32 nShift)
+{
+    if (x < (TEST_WIDTH / 2))
+        return 100;
+
+    return (OMX_U8)(((x + nShift) * 37) ^ (y * 11));
+}
+
+static OMX_U8 *Test_MakeNV12(OMX_U32 nShift)
+{
+    OMX_U8  *pFrame = (OMX_U8 *)malloc(TEST_WIDTH * TEST_HEIGHT * 3 / 2);
+    OMX_U32  x, y;
+
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++)
+            pFrame[(y * TEST_WIDTH) + x] = Test_Luma(x, y, nShift);
+    }
+    memset(pFrame + (TEST_WIDTH * TEST_HEIGHT), 128, TEST_WIDTH * TEST_HEIGHT / 2);
+
+    return pFrame;
+}
+
+/* gray pixels, so the luma of the RGB frame is the same as the NV12 one */
+static OMX_U8 *Test_MakeRGB(OMX_U32 nShift, OMX_U32 nAlphaIndex)
+{
+    OMX_U8  *pFrame = (OMX_U8 *)malloc(TEST_WIDTH * TEST_HEIGHT * 4);
+    OMX_U8  *pPixel = NULL;
+    OMX_U32  x, y;
+
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            pPixel = pFrame + (((y * TEST_WIDTH) + x) * 4);
+            memset(pPixel, Test_Luma(x, y, nShift), 4);
+            pPixel[nAlphaIndex] = 0xFF;
+        }
+    }
+
+    return pFrame;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    pVideoEnc->bAdaptiveRoi = OMX_TRUE;
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyEncoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMap);
+    Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiMean);
+    Exynos_OSAL_Free(pVideoEnc->pAdaptiveRoiCMD);
+    Exynos_OSAL_Free(pVideoEnc->pAnalysisLuma);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_Analyze(OMX_COMPONENTTYPE *pOMXComponent, OMX_COLOR_FORMATTYPE eFormat, OMX_U8 *pFrame)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_Venc_AnalyzeInput(pExynosComponent, eFormat, pFrame, TEST_WIDTH, TEST_WIDTH, TEST_HEIGHT);
+}
+
+/* runs two frames and keeps the map of the second one */
+static void Test_RunTwoFrames(OMX_COLOR_FORMATTYPE eFormat, OMX_U8 *pFirst, OMX_U8 *pSecond, OMX_S8 *pMap, OMX_BOOL *pHasCMD)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    Test_Analyze(pOMXComponent, eFormat, pFirst);
+    /* the first frame has no reference activity */
+    TEST_CHECK(pVideoEnc->pAdaptiveRoiCMD == NULL);
+
+    Test_Analyze(pOMXComponent, eFormat, pSecond);
+    *pHasCMD = (pVideoEnc->pAdaptiveRoiCMD != NULL)? OMX_TRUE:OMX_FALSE;
+    if (pVideoEnc->pAdaptiveRoiMap != NULL)
+        memcpy(pMap, pVideoEnc->pAdaptiveRoiMap, pVideoEnc->nAdaptiveRoiMBNum);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_RGBAIsAnalyzed(void)
+{
+    OMX_U32   nMBNum    = (TEST_WIDTH / 16) * ((TEST_HEIGHT + 15) / 16);
+    OMX_S8   *pYUVMap   = (OMX_S8 *)calloc(1, nMBNum);
+    OMX_S8   *pRGBMap   = (OMX_S8 *)calloc(1, nMBNum);
+    OMX_U8   *pYUV[2]   = { Test_MakeNV12(0), Test_MakeNV12(4) };
+    OMX_U8   *pRGB[2]   = { Test_MakeRGB(0, 3), Test_MakeRGB(4, 3) };
+    OMX_BOOL  bYUVCMD   = OMX_FALSE;
+    OMX_BOOL  bRGBCMD   = OMX_FALSE;
+    OMX_U32   i, nFlat = 0, nBusy = 0;
+
+    Test_RunTwoFrames(OMX_COLOR_FormatYUV420SemiPlanar, pYUV[0], pYUV[1], pYUVMap, &bYUVCMD);
+    Test_RunTwoFrames(OMX_COLOR_Format32BitRGBA8888, pRGB[0], pRGB[1], pRGBMap, &bRGBCMD);
+
+    TEST_CHECK(bYUVCMD == OMX_TRUE);
+    TEST_CHECK(bRGBCMD == OMX_TRUE);
+
+    /* gray RGB reduces to the same luma, so the same map */
+    TEST_CHECK(memcmp(pYUVMap, pRGBMap, nMBNum) == 0);
+
+    for (i = 0; i < nMBNum; i++) {
+        if (pRGBMap[i] < 0)
+            nFlat++;
+        else if (pRGBMap[i] > 0)
+            nBusy++;
+    }
+    TEST_CHECK((nFlat > 0) && (nBusy > 0));
+
+    for (i = 0; i < 2; i++) {
+        free(pYUV[i]);
+        free(pRGB[i]);
+    }
+    free(pYUVMap);
+    free(pRGBMap);
+}
+
+static void Test_RGBByteOrder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_U8                          *pFrame             = NULL;
+    OMX_U32                          x;
+
+    /* alpha leading in memory, it must not leak into the luma */
+    pFrame = Test_MakeRGB(0, 0);
+    Test_Analyze(pOMXComponent, OMX_COLOR_Format32bitBGRA8888, pFrame);
+    TEST_CHECK(pVideoEnc->pAnalysisLuma != NULL);
+    for (x = 0; (pVideoEnc->pAnalysisLuma != NULL) && (x < TEST_WIDTH); x++)
+        TEST_CHECK(pVideoEnc->pAnalysisLuma[x] == Test_Luma(x, 0, 0));
+    free(pFrame);
+
+    /* alpha trailing */
+    pFrame = Test_MakeRGB(0, 3);
+    Test_Analyze(pOMXComponent, OMX_COLOR_Format32bitARGB8888, pFrame);
+    for (x = 0; (pVideoEnc->pAnalysisLuma != NULL) && (x < TEST_WIDTH); x++)
+        TEST_CHECK(pVideoEnc->pAnalysisLuma[((TEST_HEIGHT - 1) * TEST_WIDTH) + x] == Test_Luma(x, TEST_HEIGHT - 1, 0));
+    free(pFrame);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_TiledIsSkipped(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_U8                          *pFrame             = Test_MakeNV12(0);
+
+    /* no linear luma to look at */
+    Test_Analyze(pOMXComponent, (OMX_COLOR_FORMATTYPE)OMX_SEC_COLOR_FormatNV12Tiled, pFrame);
+    TEST_CHECK(pVideoEnc->nAdaptiveRoiMBNum == 0);
+    TEST_CHECK(pVideoEnc->bAdaptiveRoiMeanValid == OMX_FALSE);
+
+    free(pFrame);
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+/* analysis cost per 1080p frame, reported only : it depends on the host */
+static void Test_Benchmark(void)
+{
+    OMX_COMPONENTTYPE   *pOMXComponent  = NULL;
+    OMX_U8              *pYUV[2]        = { Test_MakeNV12(0), Test_MakeNV12(4) };
+    OMX_U8              *pRGB[2]        = { Test_MakeRGB(0, 3), Test_MakeRGB(4, 3) };
+    OMX_TICKS            nStart;
+    OMX_U32              i;
+
+    pOMXComponent = Test_CreateEncoder();
+    nStart = ExynosTest_GetTimeUs();
+    for (i = 0; i < TEST_BENCH_FRAMES; i++)
+        Test_Analyze(pOMXComponent, OMX_COLOR_FormatYUV420SemiPlanar, pYUV[i % 2]);
+    printf("  1080p NV12 : %lld us/frame\n", (long long)((ExynosTest_GetTimeUs() - nStart) / TEST_BENCH_FRAMES));
+    Test_DestroyEncoder(pOMXComponent);
+
+    pOMXComponent = Test_CreateEncoder();
+    nStart = ExynosTest_GetTimeUs();
+    for (i = 0; i < TEST_BENCH_FRAMES; i++)
+        Test_Analyze(pOMXComponent, OMX_COLOR_Format32BitRGBA8888, pRGB[i % 2]);
+    printf("  1080p RGBA : %lld us/frame (luma extraction included)\n", (long long)((ExynosTest_GetTimeUs() - nStart) / TEST_BENCH_FRAMES));
+    Test_DestroyEncoder(pOMXComponent);
+
+    for (i = 0; i < 2; i++) {
+        free(pYUV[i]);
+        free(pRGB[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_RGBAIsAnalyzed);
+    TEST_RUN(Test_RGBByteOrder);
+    TEST_RUN(Test_TiledIsSkipped);
+    TEST_RUN(Test_Benchmark);
+
+    return TEST_RESULT();
+}
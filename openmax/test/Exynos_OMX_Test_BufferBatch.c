@@ -0,0 +1,220 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_BufferBatch.c
+ * @brief       OMX.SEC.index.BufferBatch against EmptyThisBuffer, with the submit cost of both
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Baseport.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_Queue.h"
+#include "Exynos_OSAL_Memory.h"
+
+#define TEST_BUFFER_NUM     EXYNOS_OMX_BUFFER_BATCH_MAX
+#define TEST_ITERATIONS     2000
+
+static OMX_BUFFERHEADERTYPE gHeader[TEST_BUFFER_NUM];
+
+static OMX_COMPONENTTYPE *Test_CreatePort(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(OMX_U32));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pInputPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    int                       i;
+
+    pInputPort->portDefinition.bEnabled           = OMX_TRUE;
+    pInputPort->portDefinition.nBufferCountActual = TEST_BUFFER_NUM;
+    pInputPort->portState                         = EXYNOS_OMX_PortStateIdle;
+    pInputPort->extendBufferHeader = (EXYNOS_OMX_BUFFERHEADERTYPE *)calloc(MAX_BUFFER_NUM, sizeof(EXYNOS_OMX_BUFFERHEADERTYPE));
+
+    Exynos_OSAL_MutexCreate(&pInputPort->hPortMutex);
+    Exynos_OSAL_SemaphoreCreate(&pInputPort->bufferSemID);
+    Exynos_OSAL_QueueCreate(&pInputPort->bufferQ, MAX_QUEUE_ELEMENTS);
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        INIT_SET_SIZE_VERSION(&gHeader[i], OMX_BUFFERHEADERTYPE);
+        gHeader[i].nInputPortIndex  = INPUT_PORT_INDEX;
+        gHeader[i].nOutputPortIndex = OUTPUT_PORT_INDEX;
+        gHeader[i].nFilledLen       = 16;
+        pInputPort->extendBufferHeader[i].OMXBufferHeader = &gHeader[i];
+    }
+
+    return pOMXComponent;
+}
+
+/* what the buffer thread would do : one semaphore wait per queued buffer */
+static int Test_Drain(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pInputPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    OMX_S32                   nSemaCnt         = 0;
+    int                       nQueued          = Exynos_OSAL_GetElemNum(&pInputPort->bufferQ);
+    int                       bMatched         = 0;
+    int                       i;
+
+    Exynos_OSAL_Get_SemaphoreCount(pInputPort->bufferSemID, &nSemaCnt);
+    bMatched = (nSemaCnt == nQueued);
+
+    for (i = 0; i < nQueued; i++) {
+        Exynos_OSAL_SemaphoreTryWait(pInputPort->bufferSemID);
+        Exynos_OSAL_Free(Exynos_OSAL_Dequeue(&pInputPort->bufferQ));
+    }
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        pInputPort->extendBufferHeader[i].bBufferInOMX = OMX_FALSE;
+
+    return bMatched;
+}
+
+static void Test_DestroyPort(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pInputPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+
+    Test_Drain(pOMXComponent);
+    Exynos_OSAL_QueueTerminate(&pInputPort->bufferQ);
+    Exynos_OSAL_SemaphoreTerminate(pInputPort->bufferSemID);
+    Exynos_OSAL_MutexTerminate(pInputPort->hPortMutex);
+    free(pInputPort->extendBufferHeader);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_SetBatch(EXYNOS_OMX_CONFIG_BUFFER_BATCH *pBatch, int nCount)
+{
+    int i;
+
+    INIT_SET_SIZE_VERSION(pBatch, EXYNOS_OMX_CONFIG_BUFFER_BATCH);
+    pBatch->nPortIndex = INPUT_PORT_INDEX;
+    pBatch->nCount     = nCount;
+    for (i = 0; i < nCount; i++)
+        pBatch->pBuffers[i] = &gHeader[i];
+}
+
+static void Test_SemaphoreCountsBuffers(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent = Test_CreatePort();
+    EXYNOS_OMX_CONFIG_BUFFER_BATCH   batch;
+
+    Test_SetBatch(&batch, 8);
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorNone);
+    TEST_CHECK(batch.nSubmitted == 8);
+    TEST_CHECK(Test_Drain(pOMXComponent));
+
+    /* a buffer that is already in the component stops the batch */
+    Test_SetBatch(&batch, 1);
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorNone);
+    Test_SetBatch(&batch, 4);
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorBadParameter);
+    TEST_CHECK(batch.nSubmitted == 0);
+    TEST_CHECK(Test_Drain(pOMXComponent));
+
+    Test_DestroyPort(pOMXComponent);
+}
+
+static void Test_BadHeaderStopsBatch(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent = Test_CreatePort();
+    EXYNOS_OMX_CONFIG_BUFFER_BATCH   batch;
+
+    Test_SetBatch(&batch, 6);
+    batch.pBuffers[3] = NULL;
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorBadParameter);
+    TEST_CHECK(batch.nSubmitted == 3);
+    TEST_CHECK(Test_Drain(pOMXComponent));
+
+    Test_SetBatch(&batch, EXYNOS_OMX_BUFFER_BATCH_MAX + 1);
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorBadParameter);
+    TEST_CHECK(batch.nSubmitted == 0);
+
+    Test_DestroyPort(pOMXComponent);
+}
+
+static void Test_PortNotReady(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreatePort();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_CONFIG_BUFFER_BATCH   batch;
+
+    Test_SetBatch(&batch, 4);
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].portState = EXYNOS_OMX_PortStateFlushing;
+    TEST_CHECK(Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch) == OMX_ErrorIncorrectStateOperation);
+    TEST_CHECK(batch.nSubmitted == 0);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pExynosComponent->pExynosPort[INPUT_PORT_INDEX].bufferQ) == 0);
+
+    Test_DestroyPort(pOMXComponent);
+}
+
+/* not a pass/fail check, the numbers depend on the host */
+static void Test_SubmitCost(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreatePort();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_CONFIG_BUFFER_BATCH   batch;
+    OMX_TICKS                        nSingleUs          = 0;
+    OMX_TICKS                        nBatchUs           = 0;
+    OMX_TICKS                        nStart;
+    int                              nCount;
+    int                              i, j;
+
+    for (nCount = 4; nCount <= TEST_BUFFER_NUM; nCount *= 2) {
+        nSingleUs = 0;
+        nBatchUs  = 0;
+
+        for (i = 0; i < TEST_ITERATIONS; i++) {
+            nStart = ExynosTest_GetTimeUs();
+            for (j = 0; j < nCount; j++)
+                Exynos_OMX_EmptyThisBuffer(pOMXComponent, &gHeader[j]);
+            nSingleUs += ExynosTest_GetTimeUs() - nStart;
+            TEST_CHECK(Exynos_OSAL_GetElemNum(&pInputPort->bufferQ) == nCount);
+            Test_Drain(pOMXComponent);
+
+            Test_SetBatch(&batch, nCount);
+            nStart = ExynosTest_GetTimeUs();
+            Exynos_OMX_SubmitBufferBatch(pOMXComponent, &batch);
+            nBatchUs += ExynosTest_GetTimeUs() - nStart;
+            TEST_CHECK(batch.nSubmitted == (OMX_U32)nCount);
+            Test_Drain(pOMXComponent);
+        }
+
+        printf("  %2d buffers: EmptyThisBuffer %.3f us/buffer, batch %.3f us/buffer\n", nCount,
+               (double)nSingleUs / (TEST_ITERATIONS * nCount), (double)nBatchUs / (TEST_ITERATIONS * nCount));
+    }
+
+    Test_DestroyPort(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_SemaphoreCountsBuffers);
+    TEST_RUN(Test_BadHeaderStopsBatch);
+    TEST_RUN(Test_PortNotReady);
+    TEST_RUN(Test_SubmitCost);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,270 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_DpbReuse.c
+ * @brief       reuse-vs-reallocate decision for DPBs on a resolution change
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+
+#define TEST_DPB_NUM        4
+#define TEST_DPB_Y_SIZE     (1920 * 1088)
+#define TEST_DPB_C_SIZE     (1920 * 1088 / 2)
+
+typedef struct _TEST_CODEC_CALLS
+{
+    int nStop;
+    int nEnqueueAll;
+    int nDetach;
+    int nSetup;
+} TEST_CODEC_CALLS;
+
+static TEST_CODEC_CALLS gCodecCalls;
+static CODEC_DEC_BUFFER gDPB[TEST_DPB_NUM];
+
+static OMX_ERRORTYPE Test_CodecStop(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
+{
+    gCodecCalls.nStop++;
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_CodecEnqueueAllBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nPortIndex)
+{
+    gCodecCalls.nEnqueueAll++;
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_CodecReuseAllBuffers(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bSetup)
+{
+    if (bSetup == OMX_TRUE)
+        gCodecCalls.nSetup++;
+    else
+        gCodecCalls.nDetach++;
+
+    return OMX_ErrorNone;
+}
+
+/* a 1080p copy-mode decoder holding TEST_DPB_NUM two-plane DPBs */
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    int i;
+
+    pOutputPort->bufferProcessType                        = BUFFER_COPY;
+    pOutputPort->portDefinition.format.video.nFrameWidth  = 1920;
+    pOutputPort->portDefinition.format.video.nFrameHeight = 1088;
+    pOutputPort->processData.buffer.nPlanes               = 2;
+    pOutputPort->exceptionFlag                            = GENERAL_STATE;
+
+    for (i = 0; i < TEST_DPB_NUM; i++) {
+        gDPB[i].bufferSize[0] = TEST_DPB_Y_SIZE;
+        gDPB[i].bufferSize[1] = TEST_DPB_C_SIZE;
+        pVideoDec->pMFCDecOutputBuffer[i] = &gDPB[i];
+    }
+
+    pVideoDec->bReconfigDPB                  = OMX_TRUE;
+    pVideoDec->exynos_codec_stop             = &Test_CodecStop;
+    pVideoDec->exynos_codec_enqueueAllBuffer = &Test_CodecEnqueueAllBuffer;
+    pVideoDec->exynos_codec_reuseAllBuffers  = &Test_CodecReuseAllBuffers;
+
+    memset(&gCodecCalls, 0, sizeof(gCodecCalls));
+
+    return pOMXComponent;
+}
+
+static OMX_BOOL Test_Check(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 nWidth, OMX_U32 nHeight, OMX_S32 *pDPBNum)
+{
+    unsigned int nAllocLen[MAX_BUFFER_PLANE] = { nWidth * nHeight, nWidth * nHeight / 2, 0 };
+
+    return Exynos_Check_ReusableCodecBuffers(pOMXComponent, nWidth, nHeight, nAllocLen, pDPBNum);
+}
+
+static void Test_ReuseWhenSmaller(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    OMX_S32            nDPBNum       = 3;
+
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_TRUE);
+    /* every kept DPB is handed to MFC, not only the required ones */
+    TEST_CHECK(nDPBNum == TEST_DPB_NUM);
+
+    nDPBNum = TEST_DPB_NUM;
+    TEST_CHECK(Test_Check(pOMXComponent, 1920, 1088, &nDPBNum) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_ReallocateWhenLarger(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    OMX_S32            nDPBNum       = 3;
+
+    /* client buffers are laid out for 1920x1088 */
+    TEST_CHECK(Test_Check(pOMXComponent, 3840, 2160, &nDPBNum) == OMX_FALSE);
+    TEST_CHECK(Test_Check(pOMXComponent, 1088, 1920, &nDPBNum) == OMX_FALSE);
+    TEST_CHECK(nDPBNum == 3);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_ReallocateWhenPlaneTooSmall(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    OMX_S32            nDPBNum       = 3;
+    unsigned int       nAllocLen[MAX_BUFFER_PLANE] = { TEST_DPB_Y_SIZE, TEST_DPB_C_SIZE + 1, 0 };
+
+    /* 10bit or different alignment needs more per plane at the same geometry */
+    TEST_CHECK(Exynos_Check_ReusableCodecBuffers(pOMXComponent, 1920, 1088, nAllocLen, &nDPBNum) == OMX_FALSE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_ReallocateWhenMoreDPBs(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    OMX_S32            nDPBNum       = TEST_DPB_NUM + 1;
+
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_FALSE);
+    TEST_CHECK(nDPBNum == TEST_DPB_NUM + 1);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_ReallocateByMode(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_S32                          nDPBNum            = 3;
+
+    pOutputPort->bufferProcessType = BUFFER_SHARE;
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_FALSE);
+    pOutputPort->bufferProcessType = BUFFER_COPY;
+
+    pVideoDec->bThumbnailMode = OMX_TRUE;
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_FALSE);
+    pVideoDec->bThumbnailMode = OMX_FALSE;
+
+    pExynosComponent->bUseImgCrop = OMX_TRUE;
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_FALSE);
+    pExynosComponent->bUseImgCrop = OMX_FALSE;
+
+    /* oversized DPBs are released under memory pressure */
+    pVideoDec->bMemoryPressure = OMX_TRUE;
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_FALSE);
+    pVideoDec->bMemoryPressure = OMX_FALSE;
+
+    TEST_CHECK(Test_Check(pOMXComponent, 1280, 720, &nDPBNum) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_KeepSendsCropEvent(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_S32                          nDPBNum            = 3;
+    unsigned int                     nAllocLen[MAX_BUFFER_PLANE] = { 1280 * 720, 1280 * 720 / 2, 0 };
+
+    /* not in a DPB reconfiguration, a format change or no codec support: nothing is kept */
+    pVideoDec->bReconfigDPB = OMX_FALSE;
+    TEST_CHECK(Exynos_Keep_CodecBuffers(pOMXComponent, OMX_FALSE, 1280, 720, nAllocLen, &nDPBNum) == OMX_FALSE);
+    pVideoDec->bReconfigDPB = OMX_TRUE;
+
+    TEST_CHECK(Exynos_Keep_CodecBuffers(pOMXComponent, OMX_TRUE, 1280, 720, nAllocLen, &nDPBNum) == OMX_FALSE);
+
+    pVideoDec->exynos_codec_reuseAllBuffers = NULL;
+    TEST_CHECK(Exynos_Keep_CodecBuffers(pOMXComponent, OMX_FALSE, 1280, 720, nAllocLen, &nDPBNum) == OMX_FALSE);
+    pVideoDec->exynos_codec_reuseAllBuffers = &Test_CodecReuseAllBuffers;
+
+    TEST_CHECK(pVideoDec->bReuseDPB == OMX_FALSE);
+    TEST_CHECK(gTestEvent.nCount == 0);
+
+    TEST_CHECK(Exynos_Keep_CodecBuffers(pOMXComponent, OMX_FALSE, 1280, 720, nAllocLen, &nDPBNum) == OMX_TRUE);
+    TEST_CHECK(pVideoDec->bReuseDPB == OMX_TRUE);
+    TEST_CHECK(gTestEvent.nCount == 1);
+    TEST_CHECK(gTestEvent.eEvent == OMX_EventPortSettingsChanged);
+    TEST_CHECK(gTestEvent.nData1 == OMX_DirOutput);
+    TEST_CHECK(gTestEvent.nData2 == OMX_IndexConfigCommonOutputCrop);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_DetachThenSetup(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    /* nothing to do unless the DPBs were kept */
+    Exynos_Detach_KeptCodecBuffers(pOMXComponent);
+    TEST_CHECK(Exynos_Setup_KeptCodecBuffers(pOMXComponent) == OMX_ErrorNone);
+    TEST_CHECK((gCodecCalls.nStop == 0) && (gCodecCalls.nDetach == 0) && (gCodecCalls.nSetup == 0));
+
+    /* the resolution change raised a flush, a kept DPB set skips it */
+    pVideoDec->bReuseDPB       = OMX_TRUE;
+    pOutputPort->exceptionFlag = NEED_PORT_FLUSH;
+    TEST_CHECK(Exynos_Setup_KeptCodecBuffers(pOMXComponent) == OMX_ErrorNone);
+    TEST_CHECK(gCodecCalls.nSetup == 0);
+
+    Exynos_Detach_KeptCodecBuffers(pOMXComponent);
+    TEST_CHECK(gCodecCalls.nStop == 1);
+    TEST_CHECK(gCodecCalls.nEnqueueAll == 1);
+    TEST_CHECK(gCodecCalls.nDetach == 1);
+    TEST_CHECK(pOutputPort->exceptionFlag == GENERAL_STATE);
+
+    TEST_CHECK(Exynos_Setup_KeptCodecBuffers(pOMXComponent) == OMX_ErrorNone);
+    TEST_CHECK(gCodecCalls.nStop == 2);
+    TEST_CHECK(gCodecCalls.nSetup == 1);
+    TEST_CHECK(pVideoDec->bReuseDPB == OMX_FALSE);
+    TEST_CHECK(pVideoDec->bReconfigDPB == OMX_FALSE);
+
+    /* done once */
+    TEST_CHECK(Exynos_Setup_KeptCodecBuffers(pOMXComponent) == OMX_ErrorNone);
+    TEST_CHECK(gCodecCalls.nSetup == 1);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_ReuseWhenSmaller);
+    TEST_RUN(Test_ReallocateWhenLarger);
+    TEST_RUN(Test_ReallocateWhenPlaneTooSmall);
+    TEST_RUN(Test_ReallocateWhenMoreDPBs);
+    TEST_RUN(Test_ReallocateByMode);
+    TEST_RUN(Test_KeepSendsCropEvent);
+    TEST_RUN(Test_DetachThenSetup);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,299 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_DropControl.c
+ * @brief       load estimation and non-reference frame dropping of the decoder
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+
+#define TEST_INPUT_BUFFER_NUM   8
+#define TEST_FRAME_US           33333
+
+static OMX_U8  gStream[16];
+static OMX_U32 gNonRefCalls;
+
+/* every frame is a non-reference frame */
+static OMX_BOOL Test_CheckNonRefFrame(OMX_COMPONENTTYPE *pOMXComponent, OMX_U8 *pInputStream, OMX_U32 streamSize)
+{
+    gNonRefCalls++;
+    return OMX_TRUE;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+
+    pInputPort->portDefinition.nBufferCountActual = TEST_INPUT_BUFFER_NUM;
+    Exynos_OSAL_QueueCreate(&pInputPort->bufferQ, MAX_QUEUE_ELEMENTS);
+
+    pVideoDec->bDropControl                  = OMX_TRUE;
+    pVideoDec->nLastOutputTimeStamp          = DEFAULT_TIMESTAMP_VAL;
+    pVideoDec->exynos_codec_checkNonRefFrame = &Test_CheckNonRefFrame;
+
+    gNonRefCalls = 0;
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyDecoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OSAL_QueueTerminate(&pExynosComponent->pExynosPort[INPUT_PORT_INDEX].bufferQ);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_SetPending(OMX_COMPONENTTYPE *pOMXComponent, int nPending)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pInputPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+
+    while (Exynos_OSAL_GetElemNum(&pInputPort->bufferQ) > nPending)
+        Exynos_OSAL_Dequeue(&pInputPort->bufferQ);
+
+    while (Exynos_OSAL_GetElemNum(&pInputPort->bufferQ) < nPending)
+        Exynos_OSAL_Queue(&pInputPort->bufferQ, gStream);
+}
+
+static void Test_SetInput(EXYNOS_OMX_DATA *pData, OMX_TICKS nTimeStamp)
+{
+    memset(pData, 0, sizeof(*pData));
+    pData->buffer.addr[0] = gStream;
+    pData->dataLen        = sizeof(gStream);
+    pData->timeStamp      = nTimeStamp;
+}
+
+/* as Exynos_OutputBufferReturn() leaves it */
+static void Test_SetOutput(OMX_COMPONENTTYPE *pOMXComponent, OMX_TICKS nTimeStamp, OMX_U64 nTimeUs)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    pVideoDec->nLastOutputTimeStamp = nTimeStamp;
+    pVideoDec->nLastOutputTimeUs    = nTimeUs;
+}
+
+/* output went out at nSpeed % of real time during the last window */
+static OMX_U32 Test_LoadAtSpeed(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pData, OMX_S64 nSpeed)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_TICKS                        nTimeStamp         = pVideoDec->nLastOutputTimeStamp;
+    OMX_U64                          nTimeUs            = pVideoDec->nLastOutputTimeUs;
+
+    Test_SetOutput(pOMXComponent, nTimeStamp + ((DROP_CONTROL_WINDOW_US * nSpeed) / 100), nTimeUs + DROP_CONTROL_WINDOW_US);
+
+    return Exynos_Get_DecodeLoad(pOMXComponent, pData);
+}
+
+static void Test_LoadFromOutputSpeed(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    EXYNOS_OMX_DATA    data;
+
+    Test_SetInput(&data, 0);
+    Test_SetPending(pOMXComponent, 1);
+
+    /* nothing returned yet */
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+
+    /* the first output starts the measurement */
+    Test_SetOutput(pOMXComponent, 0, 1000000);
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 100) == 0);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 200) == 0);  /* preroll */
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, DROP_CONTROL_SPEED_LOW) == 0);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, (DROP_CONTROL_SPEED_LOW + DROP_CONTROL_SPEED_HIGH) / 2) == DROP_CONTROL_LOAD_MAX / 2);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, DROP_CONTROL_SPEED_HIGH) == DROP_CONTROL_LOAD_MAX);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 0) == DROP_CONTROL_LOAD_MAX);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_LoadWindow(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_DATA                  data;
+
+    Test_SetInput(&data, 0);
+    Test_SetPending(pOMXComponent, 1);
+    Test_SetOutput(pOMXComponent, 0, 1000000);
+    Exynos_Get_DecodeLoad(pOMXComponent, &data);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 0) == DROP_CONTROL_LOAD_MAX);
+
+    /* within a window the last load holds */
+    Test_SetOutput(pOMXComponent, pVideoDec->nLastOutputTimeStamp + DROP_CONTROL_WINDOW_US,
+                                  pVideoDec->nLastOutputTimeUs + (DROP_CONTROL_WINDOW_US / 2));
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == DROP_CONTROL_LOAD_MAX);
+
+    /* no input waiting : the codec is starved, not loaded */
+    Test_SetPending(pOMXComponent, 0);
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+    Test_SetPending(pOMXComponent, 1);
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 0) == DROP_CONTROL_LOAD_MAX);
+
+    /* a pause : no output for a while, the measurement starts again */
+    Test_SetOutput(pOMXComponent, pVideoDec->nLastOutputTimeStamp + TEST_FRAME_US,
+                                  pVideoDec->nLastOutputTimeUs + DROP_CONTROL_WINDOW_GAP_US + 1);
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+    TEST_CHECK(Test_LoadAtSpeed(pOMXComponent, &data, 0) == DROP_CONTROL_LOAD_MAX);
+
+    /* a jump back in media time */
+    Test_SetOutput(pOMXComponent, 0, pVideoDec->nLastOutputTimeUs + DROP_CONTROL_WINDOW_US);
+    TEST_CHECK(Exynos_Get_DecodeLoad(pOMXComponent, &data) == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+/* frames returned at real time : not loaded, whatever the frame rate and the input order */
+static void Test_RealTimePlayback(OMX_U64 nFrameUs, OMX_U32 nReorder)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+    EXYNOS_OMX_DATA    data;
+    OMX_U32            nMaxLoad      = 0;
+    OMX_U64            nStartUs      = 1000000;
+    OMX_U32            i;
+
+    /* the client keeps every input buffer queued */
+    Test_SetPending(pOMXComponent, TEST_INPUT_BUFFER_NUM);
+
+    for (i = 0; i < 300; i++) {
+        OMX_U32 nLoad;
+
+        /* input runs ahead of output by the reorder depth plus the queued buffers */
+        Test_SetInput(&data, (OMX_TICKS)((i + nReorder + TEST_INPUT_BUFFER_NUM) * nFrameUs));
+        if (i > 0)
+            Test_SetOutput(pOMXComponent, (OMX_TICKS)((i - 1) * nFrameUs), nStartUs + ((i - 1) * nFrameUs) + ((i % 3) * 1000));
+
+        nLoad = Exynos_Get_DecodeLoad(pOMXComponent, &data);
+        if (nLoad > nMaxLoad)
+            nMaxLoad = nLoad;
+    }
+
+    TEST_CHECK(nMaxLoad == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_NotLoadedAtRealTime(void)
+{
+    Test_RealTimePlayback(TEST_FRAME_US, 0);
+    Test_RealTimePlayback(TEST_FRAME_US, 3);    /* B-frames */
+    Test_RealTimePlayback(200000, 0);           /* 5 fps */
+    Test_RealTimePlayback(1000000, 2);          /* 1 fps */
+}
+
+static void Test_DropCadence(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_DATA                  data;
+    int                              nDropped           = 0;
+    int                              i;
+
+    /* not loaded : the bitstream is not even parsed */
+    Test_SetInput(&data, 0);
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+    TEST_CHECK(gNonRefCalls == 0);
+
+    Test_SetPending(pOMXComponent, 1);
+    Test_SetOutput(pOMXComponent, 0, 1000000);
+    Exynos_Get_DecodeLoad(pOMXComponent, &data);
+
+    /* half loaded : every second non-reference frame */
+    Test_LoadAtSpeed(pOMXComponent, &data, (DROP_CONTROL_SPEED_LOW + DROP_CONTROL_SPEED_HIGH) / 2);
+    for (i = 0; i < 10; i++) {
+        if (Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_TRUE)
+            nDropped++;
+    }
+    TEST_CHECK(nDropped == 5);
+
+    /* fully loaded : all of them */
+    nDropped = 0;
+    Test_LoadAtSpeed(pOMXComponent, &data, DROP_CONTROL_SPEED_HIGH);
+    for (i = 0; i < 10; i++) {
+        if (Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_TRUE)
+            nDropped++;
+    }
+    TEST_CHECK(nDropped == 10);
+
+    /* back to normal : the credit is cleared */
+    Test_LoadAtSpeed(pOMXComponent, &data, 100);
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+    TEST_CHECK(pVideoDec->nDropCredit == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_NeverDropped(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_DATA                  data;
+
+    Test_SetPending(pOMXComponent, TEST_INPUT_BUFFER_NUM);
+
+    Test_SetInput(&data, 0);
+    data.nFlags = OMX_BUFFERFLAG_EOS;
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+
+    Test_SetInput(&data, 0);
+    data.nFlags = OMX_BUFFERFLAG_CODECCONFIG;
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+
+    Test_SetInput(&data, 0);
+    pExynosComponent->codecType = HW_VIDEO_DEC_SECURE_CODEC;
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+    pExynosComponent->codecType = HW_VIDEO_DEC_CODEC;
+
+    pVideoDec->bDropControl = OMX_FALSE;
+    TEST_CHECK(Exynos_Check_SkipInputData(pOMXComponent, &data) == OMX_FALSE);
+
+    TEST_CHECK(gNonRefCalls == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_LoadFromOutputSpeed);
+    TEST_RUN(Test_LoadWindow);
+    TEST_RUN(Test_NotLoadedAtRealTime);
+    TEST_RUN(Test_DropCadence);
+    TEST_RUN(Test_NeverDropped);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,212 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_EncUseBuffer.c
+ * @brief       encoder output buffers given by UseBuffer, shared with MFC when ION, copied otherwise
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Venc.h"
+#include "Exynos_OMX_VencControl.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_Queue.h"
+#include "Exynos_OSAL_SharedMemory.h"
+
+#define TEST_BUFFER_NUM     4
+#define TEST_BUFFER_SIZE    (64 * 1024)
+
+/* ion is faked by memfd */
+int exynos_ion_open(void)
+{
+    return (int)syscall(__NR_memfd_create, "test-ion", 0);
+}
+
+int exynos_ion_close(int fd)
+{
+    return close(fd);
+}
+
+int exynos_ion_alloc(int fd, size_t len, unsigned int heap_mask, unsigned int flags)
+{
+    int hFD = (int)syscall(__NR_memfd_create, "test-ion-buffer", 0);
+
+    if ((hFD >= 0) &&
+        (ftruncate(hFD, len) != 0)) {
+        close(hFD);
+        hFD = -1;
+    }
+
+    return hFD;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(void)
+{
+    OMX_COMPONENTTYPE             *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc        = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT           *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    pExynosComponent->codecType        = HW_VIDEO_ENC_CODEC;
+    pExynosComponent->currentState     = OMX_StateLoaded;
+    pExynosComponent->transientState   = EXYNOS_OMX_TransStateLoadedToIdle;
+    Exynos_OSAL_MutexCreate(&pExynosComponent->compMutex);
+
+    pVideoEnc->hSharedMemory = Exynos_OSAL_SharedMemory_Open();
+
+    pOutputPort->portDefinition.bEnabled           = OMX_TRUE;
+    pOutputPort->portDefinition.nBufferCountActual = TEST_BUFFER_NUM;
+    pOutputPort->portState                         = EXYNOS_OMX_PortStateEnabling;
+    pOutputPort->eMetaDataType                     = METADATA_TYPE_DISABLED;
+    pOutputPort->bufferProcessType                 = BUFFER_SHARE;
+    pOutputPort->extendBufferHeader  = (EXYNOS_OMX_BUFFERHEADERTYPE *)calloc(MAX_BUFFER_NUM, sizeof(EXYNOS_OMX_BUFFERHEADERTYPE));
+    pOutputPort->bufferStateAllocate = (OMX_U32 *)calloc(MAX_BUFFER_NUM, sizeof(OMX_U32));
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyEncoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc        = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT           *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    int                            i;
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        free(pOutputPort->extendBufferHeader[i].OMXBufferHeader);
+
+    if (pOutputPort->codecSemID != NULL) {
+        Exynos_OSAL_QueueTerminate(&pOutputPort->codecBufferQ);
+        Exynos_OSAL_SemaphoreTerminate(pOutputPort->codecSemID);
+    }
+
+    Exynos_OSAL_SharedMemory_Close(pVideoEnc->hSharedMemory);
+    Exynos_OSAL_MutexTerminate(pExynosComponent->compMutex);
+    free(pOutputPort->extendBufferHeader);
+    free(pOutputPort->bufferStateAllocate);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_IonStaysShared(void)
+{
+    OMX_COMPONENTTYPE             *pOMXComponent    = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc        = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT           *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_BUFFERHEADERTYPE          *pHeader          = NULL;
+    OMX_PTR                        pBuffer[TEST_BUFFER_NUM];
+    int                            i;
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        pBuffer[i] = Exynos_OSAL_SharedMemory_Alloc(pVideoEnc->hSharedMemory, TEST_BUFFER_SIZE, NORMAL_MEMORY);
+        TEST_CHECK(pBuffer[i] != NULL);
+        TEST_CHECK(Exynos_OMX_UseBuffer(pOMXComponent, &pHeader, OUTPUT_PORT_INDEX, NULL, TEST_BUFFER_SIZE, pBuffer[i]) == OMX_ErrorNone);
+    }
+
+    /* MFC writes into them, nothing to copy through */
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_SHARE);
+    TEST_CHECK(pOutputPort->codecSemID == NULL);
+    TEST_CHECK(pOutputPort->portDefinition.bPopulated == OMX_TRUE);
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        Exynos_OSAL_SharedMemory_Free(pVideoEnc->hSharedMemory, pBuffer[i]);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_HeapIsCopied(void)
+{
+    OMX_COMPONENTTYPE             *pOMXComponent    = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT           *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_BUFFERHEADERTYPE          *pHeader          = NULL;
+    OMX_HANDLETYPE                 hCodecSem        = NULL;
+    OMX_PTR                        pData            = NULL;
+    OMX_U8                        *pBuffer[TEST_BUFFER_NUM];
+    int                            i;
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        pBuffer[i] = (OMX_U8 *)malloc(TEST_BUFFER_SIZE);
+        TEST_CHECK(Exynos_OMX_UseBuffer(pOMXComponent, &pHeader, OUTPUT_PORT_INDEX, NULL, TEST_BUFFER_SIZE, pBuffer[i]) == OMX_ErrorNone);
+    }
+
+    /* the codec init already ran next to the population, the copy queue is made on the spot */
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_COPY);
+    TEST_CHECK(pOutputPort->codecSemID != NULL);
+    hCodecSem = pOutputPort->codecSemID;
+
+    TEST_CHECK(Exynos_CodecBufferEnqueue(pExynosComponent, OUTPUT_PORT_INDEX, (OMX_PTR)pBuffer[0]) == OMX_ErrorNone);
+    TEST_CHECK(Exynos_CodecBufferDequeue(pExynosComponent, OUTPUT_PORT_INDEX, &pData) == OMX_ErrorNone);
+    TEST_CHECK(pData == (OMX_PTR)pBuffer[0]);
+
+    /* a codec init coming after that keeps the queue */
+    TEST_CHECK(Exynos_CodecBufferCreate(pExynosComponent, OUTPUT_PORT_INDEX) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->codecSemID == hCodecSem);
+
+    Test_DestroyEncoder(pOMXComponent);
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        free(pBuffer[i]);
+}
+
+static void Test_ModeKeptAfterLoaded(void)
+{
+    OMX_COMPONENTTYPE             *pOMXComponent    = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT *pVideoEnc        = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT           *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_BUFFERHEADERTYPE          *pHeader          = NULL;
+    OMX_U8                        *pHeap            = (OMX_U8 *)malloc(TEST_BUFFER_SIZE);
+    OMX_PTR                        pIon             = Exynos_OSAL_SharedMemory_Alloc(pVideoEnc->hSharedMemory, TEST_BUFFER_SIZE, NORMAL_MEMORY);
+
+    /* a port enable while executing, MFC output is already set up as shared */
+    pExynosComponent->currentState   = OMX_StateExecuting;
+    pExynosComponent->transientState = EXYNOS_OMX_TransStateMax;
+
+    TEST_CHECK(Exynos_OMX_UseBuffer(pOMXComponent, &pHeader, OUTPUT_PORT_INDEX, NULL, TEST_BUFFER_SIZE, pHeap) == OMX_ErrorBadParameter);
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_SHARE);
+    TEST_CHECK(pOutputPort->assignedBufferNum == 0);
+
+    /* and as copied, any memory can take the copy */
+    pOutputPort->bufferProcessType = BUFFER_COPY;
+    TEST_CHECK(Exynos_OMX_UseBuffer(pOMXComponent, &pHeader, OUTPUT_PORT_INDEX, NULL, TEST_BUFFER_SIZE, pIon) == OMX_ErrorNone);
+    TEST_CHECK(Exynos_OMX_UseBuffer(pOMXComponent, &pHeader, OUTPUT_PORT_INDEX, NULL, TEST_BUFFER_SIZE, pHeap) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_COPY);
+
+    Exynos_OSAL_SharedMemory_Free(pVideoEnc->hSharedMemory, pIon);
+    Test_DestroyEncoder(pOMXComponent);
+    free(pHeap);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_IonStaysShared);
+    TEST_RUN(Test_HeapIsCopied);
+    TEST_RUN(Test_ModeKeptAfterLoaded);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,150 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_ExtensionIndex.c
+ * @brief       vendor extension names resolved through the encoder layers,
+ *              with the per call cost of the lookup and of the SetConfig switch chain
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Venc.h"
+#include "Exynos_OMX_VencControl.h"
+
+#define TEST_ITERATIONS     200000
+#define TEST_BITRATE        4000000
+
+/* first and last name of the video layer, then one the base layer resolves */
+static const char *gNames[] = {
+    EXYNOS_INDEX_CONFIG_VIDEO_INTRAPERIOD,
+    EXYNOS_INDEX_PARAM_VIDEO_LOOKAHEAD,
+    EXYNOS_INDEX_CONFIG_BUFFER_BATCH,
+};
+#define TEST_NAME_NUM (sizeof(gNames) / sizeof(gNames[0]))
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    pVideoEnc->eControlRate[OUTPUT_PORT_INDEX] = OMX_Video_ControlRateVariable;
+
+    pOMXComponent->GetExtensionIndex = &Exynos_OMX_VideoEncodeGetExtensionIndex;
+    pOMXComponent->SetConfig         = &Exynos_OMX_VideoEncodeSetConfig;
+
+    return pOMXComponent;
+}
+
+static void Test_ResolvedByLayers(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_INDEXTYPE                nIndex[TEST_NAME_NUM];
+    OMX_INDEXTYPE                nAgain;
+    OMX_U32                      i, j;
+
+    for (i = 0; i < TEST_NAME_NUM; i++) {
+        nIndex[i] = OMX_IndexComponentStartUnused;
+        TEST_CHECK(pOMXComponent->GetExtensionIndex(pOMXComponent, (OMX_STRING)gNames[i], &nIndex[i]) == OMX_ErrorNone);
+        TEST_CHECK(nIndex[i] != OMX_IndexComponentStartUnused);
+
+        for (j = 0; j < i; j++)
+            TEST_CHECK(nIndex[j] != nIndex[i]);
+    }
+
+    /* the mapping is fixed for the lifetime of the component */
+    for (i = 0; i < TEST_NAME_NUM; i++) {
+        TEST_CHECK(pOMXComponent->GetExtensionIndex(pOMXComponent, (OMX_STRING)gNames[i], &nAgain) == OMX_ErrorNone);
+        TEST_CHECK(nAgain == nIndex[i]);
+    }
+
+    TEST_CHECK(pOMXComponent->GetExtensionIndex(pOMXComponent, (OMX_STRING)"OMX.SEC.index.Unknown", &nAgain) == OMX_ErrorBadParameter);
+
+    pExynosComponent->currentState = OMX_StateInvalid;
+    TEST_CHECK(pOMXComponent->GetExtensionIndex(pOMXComponent, (OMX_STRING)gNames[0], &nAgain) == OMX_ErrorInvalidState);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static double Test_LookupNs(OMX_COMPONENTTYPE *pOMXComponent, const char *pName)
+{
+    OMX_INDEXTYPE   nIndex;
+    OMX_TICKS       nStart;
+    int             i;
+
+    nStart = ExynosTest_GetTimeUs();
+    for (i = 0; i < TEST_ITERATIONS; i++)
+        pOMXComponent->GetExtensionIndex(pOMXComponent, (OMX_STRING)pName, &nIndex);
+
+    return (double)(ExynosTest_GetTimeUs() - nStart) * 1000 / TEST_ITERATIONS;
+}
+
+static double Test_SetConfigNs(OMX_COMPONENTTYPE *pOMXComponent, OMX_INDEXTYPE nIndex, OMX_PTR pConfig)
+{
+    OMX_TICKS   nStart;
+    int         i;
+
+    nStart = ExynosTest_GetTimeUs();
+    for (i = 0; i < TEST_ITERATIONS; i++)
+        pOMXComponent->SetConfig(pOMXComponent, nIndex, pConfig);
+
+    return (double)(ExynosTest_GetTimeUs() - nStart) * 1000 / TEST_ITERATIONS;
+}
+
+/*
+ * not a pass/fail check, the numbers depend on the host.
+ * the SetConfig cost of an index the video layer handles is set against one the base layer rejects
+ * after both switches, the difference is what an index to handler table could take away.
+ */
+static void Test_PerCallCost(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_VIDEO_CONFIG_BITRATETYPE     bitrate;
+    OMX_U32                          i;
+
+    for (i = 0; i < TEST_NAME_NUM; i++)
+        printf("  GetExtensionIndex(%s): %.1f ns\n", gNames[i], Test_LookupNs(pOMXComponent, gNames[i]));
+
+    INIT_SET_SIZE_VERSION(&bitrate, OMX_VIDEO_CONFIG_BITRATETYPE);
+    bitrate.nPortIndex     = OUTPUT_PORT_INDEX;
+    bitrate.nEncodeBitrate = TEST_BITRATE;
+
+    printf("  SetConfig(bitrate): %.1f ns, SetConfig(unsupported): %.1f ns\n",
+           Test_SetConfigNs(pOMXComponent, OMX_IndexConfigVideoBitrate, &bitrate),
+           Test_SetConfigNs(pOMXComponent, OMX_IndexComponentStartUnused, &bitrate));
+    TEST_CHECK(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portDefinition.format.video.nBitrate == TEST_BITRATE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_ResolvedByLayers);
+    TEST_RUN(Test_PerCallCost);
+
+    return TEST_RESULT();
+}
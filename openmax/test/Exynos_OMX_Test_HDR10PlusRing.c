@@ -0,0 +1,183 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_HDR10PlusRing.c
+ * @brief       association of HDR10+ info with the frame it came with
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_Mutex.h"
+
+#define TEST_FRAME_US   33333
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    /* made by the base component constructor, which the fake one skips */
+    Exynos_OSAL_MutexCreate(&pExynosComponent->HDR10plusRing.hMutex);
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyDecoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OMX_HDR10PlusRing_Flush(pExynosComponent);
+    Exynos_OSAL_MutexTerminate(pExynosComponent->HDR10plusRing.hMutex);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+/* each payload records the frame it belongs to */
+static OMX_PTR Test_Payload(OMX_TICKS timeStamp)
+{
+    OMX_TICKS *pPayload = (OMX_TICKS *)Exynos_OSAL_Malloc(sizeof(OMX_TICKS));
+
+    *pPayload = timeStamp;
+
+    return pPayload;
+}
+
+static OMX_BOOL Test_GetMatches(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_U32 nTag, OMX_TICKS timeStamp)
+{
+    OMX_TICKS *pPayload = (OMX_TICKS *)Exynos_OMX_HDR10PlusRing_Get(pExynosComponent, nTag, timeStamp);
+    OMX_BOOL   bMatch   = OMX_FALSE;
+
+    if (pPayload != NULL) {
+        bMatch = (*pPayload == timeStamp)? OMX_TRUE:OMX_FALSE;
+        Exynos_OSAL_Free(pPayload);
+    }
+
+    return bMatch;
+}
+
+static void Test_InOrder(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    int i;
+
+    for (i = 0; i < 4; i++)
+        TEST_CHECK(Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, i, i * TEST_FRAME_US, Test_Payload(i * TEST_FRAME_US)) == OMX_ErrorNone);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 4);
+
+    for (i = 0; i < 4; i++)
+        TEST_CHECK(Test_GetMatches(pExynosComponent, i, i * TEST_FRAME_US) == OMX_TRUE);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 0);
+
+    /* taken once */
+    TEST_CHECK(Exynos_OMX_HDR10PlusRing_Get(pExynosComponent, 0, 0) == NULL);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_Reordered(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    /* decode order I P B B, display order I B B P */
+    OMX_TICKS decodeTs[4]  = { 0, 3 * TEST_FRAME_US, 1 * TEST_FRAME_US, 2 * TEST_FRAME_US };
+    OMX_U32   displayTag[4] = { 0, 2, 3, 1 };
+
+    int i;
+
+    for (i = 0; i < 4; i++)
+        Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, i, decodeTs[i], Test_Payload(decodeTs[i]));
+
+    for (i = 0; i < 4; i++)
+        TEST_CHECK(Test_GetMatches(pExynosComponent, displayTag[i], decodeTs[displayTag[i]]) == OMX_TRUE);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_WrapAround(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_U32                   nTag             = 5;
+    OMX_TICKS                 oldTs            = 10 * TEST_FRAME_US;
+    OMX_TICKS                 newTs            = (10 + MAX_TIMESTAMP) * TEST_FRAME_US;
+
+    /* a held back frame's tag is reused by a newer one before it is output */
+    Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, nTag, oldTs, Test_Payload(oldTs));
+    Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, nTag, newTs, Test_Payload(newTs));
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 1);
+
+    /* the old frame gets nothing rather than the newer frame's info */
+    TEST_CHECK(Exynos_OMX_HDR10PlusRing_Get(pExynosComponent, nTag, oldTs) == NULL);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 1);
+
+    /* which is still there for its own frame */
+    TEST_CHECK(Test_GetMatches(pExynosComponent, nTag, newTs) == OMX_TRUE);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 0);
+
+    /* the same with the tag taken before the old frame's info is put */
+    Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, nTag, newTs, Test_Payload(newTs));
+    TEST_CHECK(Exynos_OMX_HDR10PlusRing_Get(pExynosComponent, nTag, oldTs) == NULL);
+    TEST_CHECK(Test_GetMatches(pExynosComponent, nTag, newTs) == OMX_TRUE);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_Flush(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    int i;
+
+    for (i = 0; i < MAX_HDR10PLUS_RING_NUM; i++)
+        Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, i, i, Test_Payload(i));
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == MAX_HDR10PLUS_RING_NUM);
+
+    Exynos_OMX_HDR10PlusRing_Flush(pExynosComponent);
+    TEST_CHECK(pExynosComponent->HDR10plusRing.nCount == 0);
+
+    for (i = 0; i < MAX_HDR10PLUS_RING_NUM; i++)
+        TEST_CHECK(pExynosComponent->HDR10plusRing.entry[i].bOccupied == OMX_FALSE);
+
+    TEST_CHECK(Exynos_OMX_HDR10PlusRing_Get(pExynosComponent, 0, 0) == NULL);
+    TEST_CHECK(Exynos_OMX_HDR10PlusRing_Put(pExynosComponent, 0, 0, NULL) == OMX_ErrorBadParameter);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_InOrder);
+    TEST_RUN(Test_Reordered);
+    TEST_RUN(Test_WrapAround);
+    TEST_RUN(Test_Flush);
+
+    return TEST_RESULT();
+}
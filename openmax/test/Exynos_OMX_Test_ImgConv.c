@@ -0,0 +1,241 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_ImgConv.c
+ * @brief       image converter worker, through the dlopen path with a stub converter.
+ *              run with the stub first in the search path:
+ *              LD_LIBRARY_PATH=/vendor/lib64/omx_test ExynosOMX_Test_ImgConv
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_ImageConverter.h"
+
+#define TEST_FRAME_US   33333
+
+typedef struct _TEST_IMG_CONV_DONE {
+    OMX_U32         nCount;
+    OMX_TICKS       timeStamp[MAX_BUFFER_REF];
+    OMX_ERRORTYPE   eResult[MAX_BUFFER_REF];
+
+    /* the first buffer is held on the worker while these are set */
+    OMX_HANDLETYPE  hEntered;
+    OMX_HANDLETYPE  hRelease;
+} TEST_IMG_CONV_DONE;
+
+static TEST_IMG_CONV_DONE gDone;
+
+static void *gStubLibHandle;
+
+static EXYNOS_TEST_IMG_CONV_STUB *Test_GetStub(void)
+{
+    EXYNOS_TEST_IMG_CONV_STUB_GET_FUNC pGetFunc = NULL;
+
+    /* the one Exynos_OSAL_ImgConv_Create() has loaded,
+     * kept open so that the counts outlive Exynos_OSAL_ImgConv_Terminate()
+     */
+    if (gStubLibHandle == NULL)
+        gStubLibHandle = dlopen("libImageFormatConverter.so", RTLD_NOW | RTLD_NOLOAD);
+    if (gStubLibHandle == NULL)
+        return NULL;
+
+    pGetFunc = (EXYNOS_TEST_IMG_CONV_STUB_GET_FUNC)dlsym(gStubLibHandle, EXYNOS_TEST_IMG_CONV_STUB_GET);
+    if (pGetFunc == NULL) {
+        printf("libImageFormatConverter.so is not the stub, check LD_LIBRARY_PATH\n");
+        return NULL;
+    }
+
+    return pGetFunc();
+}
+
+static void Test_Done(
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    EXYNOS_OMX_DATABUFFER   *pDataBuffer,
+    OMX_ERRORTYPE            eResult)
+{
+    OMX_HANDLETYPE hRelease = gDone.hRelease;
+
+    if (gDone.nCount < MAX_BUFFER_REF) {
+        gDone.timeStamp[gDone.nCount] = pDataBuffer->timeStamp;
+        gDone.eResult[gDone.nCount]   = eResult;
+    }
+    gDone.nCount++;
+
+    if (hRelease != NULL) {
+        Exynos_OSAL_SemaphorePost(gDone.hEntered);
+        Exynos_OSAL_SemaphoreWait(hRelease);
+    }
+}
+
+static void Test_CreateTerminate(void)
+{
+    OMX_HANDLETYPE             hImgConv = NULL;
+    EXYNOS_TEST_IMG_CONV_STUB *pStub    = NULL;
+    EXYNOS_TEST_IMG_CONV_STUB  before;
+
+    hImgConv = Exynos_OSAL_ImgConv_Create(1920, 1080, 0);
+    TEST_CHECK(hImgConv != NULL);
+    if (hImgConv == NULL)
+        return;
+
+    pStub = Test_GetStub();
+    TEST_CHECK(pStub != NULL);
+    if (pStub == NULL) {
+        Exynos_OSAL_ImgConv_Terminate(hImgConv);
+        return;
+    }
+
+    TEST_CHECK(pStub->nInitCount == 1);
+    TEST_CHECK((pStub->nWidth == 1920) && (pStub->nHeight == 1080));
+    TEST_CHECK(pStub->nAlgo == 1);     /* NORMAL */
+
+    before = *pStub;
+    Exynos_OSAL_ImgConv_Terminate(hImgConv);
+    TEST_CHECK(pStub->nDeinitCount == before.nDeinitCount + 1);
+
+    /* mode 1 asks for the other algorithm */
+    hImgConv = Exynos_OSAL_ImgConv_Create(3840, 2160, 1);
+    TEST_CHECK(hImgConv != NULL);
+    pStub = Test_GetStub();
+    if (pStub != NULL) {
+        TEST_CHECK((pStub->nWidth == 3840) && (pStub->nHeight == 2160));
+        TEST_CHECK(pStub->nAlgo == 2);     /* HI_JACK */
+    }
+    Exynos_OSAL_ImgConv_Terminate(hImgConv);
+}
+
+static void Test_Order(void)
+{
+    OMX_COMPONENTTYPE         *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    OMX_HANDLETYPE             hImgConv      = Exynos_OSAL_ImgConv_Create(1920, 1080, 0);
+    EXYNOS_TEST_IMG_CONV_STUB *pStub         = Test_GetStub();
+    OMX_BUFFERHEADERTYPE       bufferHeader;
+    EXYNOS_OMX_DATABUFFER      dataBuffer;
+    OMX_U8                     payload[16];
+    OMX_U32                    nConvertBefore;
+
+    int i;
+
+    TEST_CHECK((hImgConv != NULL) && (pStub != NULL));
+    if ((hImgConv == NULL) || (pStub == NULL))
+        goto EXIT;
+    nConvertBefore = pStub->nConvertCount;
+
+    memset(&gDone, 0, sizeof(gDone));
+    memset(&bufferHeader, 0, sizeof(bufferHeader));
+    bufferHeader.pBuffer = payload;
+
+    /* frames and empty buffers(e.g. EOS) come back in the order they were requested.
+     * one local dataBuffer is reused, so each request must be kept as a copy.
+     */
+    for (i = 0; i < 8; i++) {
+        memset(&dataBuffer, 0, sizeof(dataBuffer));
+        dataBuffer.bufferHeader  = &bufferHeader;
+        dataBuffer.remainDataLen = (i % 3 == 2)? 0:sizeof(payload);
+        dataBuffer.timeStamp     = i * TEST_FRAME_US;
+
+        TEST_CHECK(Exynos_OSAL_ImgConv_Request(hImgConv, pOMXComponent, &dataBuffer, NULL, &Test_Done) == OMX_ErrorNone);
+    }
+
+    Exynos_OSAL_ImgConv_Flush(hImgConv);
+    TEST_CHECK(gDone.nCount == 8);
+
+    for (i = 0; i < 8; i++) {
+        TEST_CHECK(gDone.timeStamp[i] == i * TEST_FRAME_US);
+        /* no frame of a software codec is converted */
+        TEST_CHECK(gDone.eResult[i] != OMX_ErrorNone);
+    }
+    TEST_CHECK(pStub->nConvertCount == nConvertBefore);
+
+EXIT:
+    Exynos_OSAL_ImgConv_Terminate(hImgConv);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_Full(void)
+{
+    OMX_COMPONENTTYPE         *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    OMX_HANDLETYPE             hImgConv      = Exynos_OSAL_ImgConv_Create(1920, 1080, 0);
+    EXYNOS_OMX_DATABUFFER      dataBuffer;
+    OMX_HANDLETYPE             hRelease      = NULL;
+
+    int i;
+
+    TEST_CHECK(hImgConv != NULL);
+    if (hImgConv == NULL)
+        goto EXIT;
+
+    memset(&gDone, 0, sizeof(gDone));
+    Exynos_OSAL_SemaphoreCreate(&gDone.hEntered);
+    Exynos_OSAL_SemaphoreCreate(&gDone.hRelease);
+
+    memset(&dataBuffer, 0, sizeof(dataBuffer));
+    TEST_CHECK(Exynos_OSAL_ImgConv_Request(hImgConv, pOMXComponent, &dataBuffer, NULL, &Test_Done) == OMX_ErrorNone);
+    Exynos_OSAL_SemaphoreWait(gDone.hEntered);
+
+    /* jobs are not allocated, there are no more than the output buffers */
+    for (i = 1; i < MAX_BUFFER_REF; i++) {
+        dataBuffer.timeStamp = i * TEST_FRAME_US;
+        TEST_CHECK(Exynos_OSAL_ImgConv_Request(hImgConv, pOMXComponent, &dataBuffer, NULL, &Test_Done) == OMX_ErrorNone);
+    }
+    TEST_CHECK(Exynos_OSAL_ImgConv_Request(hImgConv, pOMXComponent, &dataBuffer, NULL, &Test_Done) != OMX_ErrorNone);
+
+    /* the rest go through without stopping */
+    hRelease       = gDone.hRelease;
+    gDone.hRelease = NULL;
+    Exynos_OSAL_SemaphorePost(hRelease);
+
+    Exynos_OSAL_ImgConv_Flush(hImgConv);
+    TEST_CHECK(gDone.nCount == MAX_BUFFER_REF);
+    for (i = 0; i < MAX_BUFFER_REF; i++)
+        TEST_CHECK(gDone.timeStamp[i] == i * TEST_FRAME_US);
+
+    /* and a slot is free again */
+    TEST_CHECK(Exynos_OSAL_ImgConv_Request(hImgConv, pOMXComponent, &dataBuffer, NULL, &Test_Done) == OMX_ErrorNone);
+    Exynos_OSAL_ImgConv_Flush(hImgConv);
+    TEST_CHECK(gDone.nCount == MAX_BUFFER_REF + 1);
+
+    Exynos_OSAL_SemaphoreTerminate(hRelease);
+    Exynos_OSAL_SemaphoreTerminate(gDone.hEntered);
+    gDone.hEntered = NULL;
+
+EXIT:
+    Exynos_OSAL_ImgConv_Terminate(hImgConv);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_CreateTerminate);
+    TEST_RUN(Test_Order);
+    TEST_RUN(Test_Full);
+
+    if (gStubLibHandle != NULL)
+        dlclose(gStubLibHandle);
+
+    return TEST_RESULT();
+}
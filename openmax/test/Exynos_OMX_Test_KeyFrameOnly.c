@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_KeyFrameOnly.c
+ * @brief       output buffer counts around key frame only mode
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OMX_VdecControl.h"
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    pExynosComponent->currentState             = OMX_StateLoaded;
+    pOutputPort->portDefinition.nBufferCountMin    = 4;
+    pOutputPort->portDefinition.nBufferCountActual = 6;
+
+    return pOMXComponent;
+}
+
+static OMX_ERRORTYPE Test_SetKeyFrameOnly(OMX_COMPONENTTYPE *pOMXComponent, OMX_BOOL bEnabled)
+{
+    OMX_CONFIG_BOOLEANTYPE keyFrameOnly;
+
+    INIT_SET_SIZE_VERSION(&keyFrameOnly, OMX_CONFIG_BOOLEANTYPE);
+    keyFrameOnly.bEnabled = bEnabled;
+
+    return Exynos_OMX_VideoDecodeSetParameter(pOMXComponent, (OMX_INDEXTYPE)OMX_IndexParamEnableKeyFrameOnlyMode, &keyFrameOnly);
+}
+
+static void Test_RestoreOnDisable(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_TRUE) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountMin == 1);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountActual == 2);
+
+    /* enabling twice must not save the reduced counts */
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_TRUE) == OMX_ErrorNone);
+
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_FALSE) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountMin == 4);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountActual == 6);
+
+    /* disabling twice changes nothing */
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_FALSE) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountMin == 4);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountActual == 6);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_KeepClientCount(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_TRUE) == OMX_ErrorNone);
+
+    /* the client asked for more buffers while in key frame only mode */
+    pOutputPort->portDefinition.nBufferCountActual = 3;
+
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_FALSE) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountMin == 4);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountActual == 3);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_LoadedStateOnly(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    pExynosComponent->currentState = OMX_StateIdle;
+
+    TEST_CHECK(Test_SetKeyFrameOnly(pOMXComponent, OMX_TRUE) == OMX_ErrorIncorrectStateOperation);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountMin == 4);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferCountActual == 6);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_RestoreOnDisable);
+    TEST_RUN(Test_KeepClientCount);
+    TEST_RUN(Test_LoadedStateOnly);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,247 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_LTRControl.c
+ * @brief       LTR marking and loss recovery of the encoder on a mock MFC
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Venc.h"
+
+#define TEST_LTR_NUM        OMX_VIDEO_MAX_LTR_FRAMES
+#define TEST_REFRESH        10
+#define TEST_FRAME_US       33333
+
+/* controls the encoder issued for one frame, -1 : not issued */
+typedef struct _TEST_FRAME_CONTROLS
+{
+    int nMark;
+    int nUsedMask;
+    int nFrameType;
+} TEST_FRAME_CONTROLS;
+
+static TEST_FRAME_CONTROLS gControls;
+static ExynosVideoEncOps   gEncOps;
+
+static ExynosVideoErrorType Test_SetMarkLTRFrame(void *pHandle, int nLongTermFrmIdx)
+{
+    gControls.nMark = nLongTermFrmIdx - 1;
+    return VIDEO_ERROR_NONE;
+}
+
+static ExynosVideoErrorType Test_SetUsedLTRFrame(void *pHandle, int nUsedLTRFrameNum)
+{
+    gControls.nUsedMask = nUsedLTRFrameNum;
+    return VIDEO_ERROR_NONE;
+}
+
+static ExynosVideoErrorType Test_SetFrameType(void *pHandle, ExynosVideoFrameType frameType)
+{
+    gControls.nFrameType = frameType;
+    return VIDEO_ERROR_NONE;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(OMX_U32 nRefreshPeriod)
+{
+    OMX_COMPONENTTYPE                   *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT            *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEO_CONFIG_LTRPOLICY    policy;
+
+    memset(&gEncOps, 0, sizeof(gEncOps));
+    gEncOps.Set_MarkLTRFrame = &Test_SetMarkLTRFrame;
+    gEncOps.Set_UsedLTRFrame = &Test_SetUsedLTRFrame;
+    gEncOps.Set_FrameType    = &Test_SetFrameType;
+
+    memset(&policy, 0, sizeof(policy));
+    policy.nLTRRefreshPeriod = nRefreshPeriod;
+    Exynos_LTR_SetPolicy(pExynosComponent, &policy, TEST_LTR_NUM);
+
+    return pOMXComponent;
+}
+
+/* encodes frame nFrame, as MFC would see the controls */
+static void Test_Encode(OMX_COMPONENTTYPE *pOMXComponent, int nFrame)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    gControls.nMark      = -1;
+    gControls.nUsedMask  = -1;
+    gControls.nFrameType = -1;
+
+    Exynos_LTR_Run(pExynosComponent, &gEncOps, NULL, TEST_LTR_NUM, (OMX_TICKS)nFrame * TEST_FRAME_US);
+}
+
+static void Test_PeriodicMarks(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateEncoder(TEST_REFRESH);
+    int                nMarks        = 0;
+    int                i;
+
+    for (i = 1; i <= (TEST_REFRESH * (TEST_LTR_NUM + 1)); i++) {
+        Test_Encode(pOMXComponent, i);
+
+        if ((i % TEST_REFRESH) == 0) {
+            /* round robin over the slots */
+            TEST_CHECK(gControls.nMark == (nMarks % TEST_LTR_NUM));
+            nMarks++;
+        } else {
+            TEST_CHECK(gControls.nMark == -1);
+        }
+
+        TEST_CHECK(gControls.nUsedMask == -1);
+        TEST_CHECK(gControls.nFrameType == -1);
+    }
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_RecoveryFrameIsMarked(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder(TEST_REFRESH);
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    int                          i;
+
+    /* LTR[0] at frame 10, LTR[1] at frame 20 */
+    for (i = 1; i <= 25; i++)
+        Test_Encode(pOMXComponent, i);
+
+    /* frame 22 was lost : LTR[1] is intact on the receiver */
+    Exynos_LTR_ReportLoss(pExynosComponent, 22 * TEST_FRAME_US);
+    Test_Encode(pOMXComponent, 26);
+    TEST_CHECK(gControls.nUsedMask == (1 << 1));
+    TEST_CHECK(gControls.nFrameType == -1);
+
+    /* the recovery frame itself is the next LTR, not the frame after it */
+    TEST_CHECK(gControls.nMark == 2);
+
+    /* the refresh period restarts from the recovery frame */
+    for (i = 27; i < 36; i++) {
+        Test_Encode(pOMXComponent, i);
+        TEST_CHECK(gControls.nMark == -1);
+    }
+    Test_Encode(pOMXComponent, 36);
+    TEST_CHECK(gControls.nMark == 3);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_LaterMarksDiscarded(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder(TEST_REFRESH);
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    int                          i;
+
+    /* LTR[0..2] at frame 10, 20, 30 */
+    for (i = 1; i <= 35; i++)
+        Test_Encode(pOMXComponent, i);
+
+    /* late report of frame 15 : LTR[1] and LTR[2] depend on lost data */
+    Exynos_LTR_ReportLoss(pExynosComponent, 18 * TEST_FRAME_US);
+    Exynos_LTR_ReportLoss(pExynosComponent, 15 * TEST_FRAME_US);
+    Test_Encode(pOMXComponent, 36);
+    TEST_CHECK(gControls.nUsedMask == (1 << 0));
+
+    /* free slots are used first, the referred one is kept */
+    TEST_CHECK(gControls.nMark == 3);
+
+    for (i = 37; i <= 46; i++)
+        Test_Encode(pOMXComponent, i);
+    TEST_CHECK(gControls.nMark == 1);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_NoUsableLTR(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder(TEST_REFRESH);
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    int                          i;
+
+    for (i = 1; i <= 5; i++)
+        Test_Encode(pOMXComponent, i);
+
+    Exynos_LTR_ReportLoss(pExynosComponent, 3 * TEST_FRAME_US);
+    Test_Encode(pOMXComponent, 6);
+    TEST_CHECK(gControls.nUsedMask == -1);
+    TEST_CHECK(gControls.nFrameType == VIDEO_FRAME_I);
+    TEST_CHECK(gControls.nMark == 0);
+
+    /* handled once */
+    Test_Encode(pOMXComponent, 7);
+    TEST_CHECK((gControls.nFrameType == -1) && (gControls.nMark == -1));
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_AllSlotsInUse(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder(TEST_REFRESH);
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    int                          i;
+
+    /* every slot holds an LTR, the next one in turn is LTR[0] at frame 10 */
+    for (i = 1; i <= (TEST_REFRESH * TEST_LTR_NUM) + 5; i++)
+        Test_Encode(pOMXComponent, i);
+
+    /* recovering from LTR[0] : it is not overwritten by the recovery frame */
+    Exynos_LTR_ReportLoss(pExynosComponent, 12 * TEST_FRAME_US);
+    Test_Encode(pOMXComponent, 50);
+    TEST_CHECK(gControls.nUsedMask == (1 << 0));
+    TEST_CHECK(gControls.nMark == 1);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_NoPolicy(void)
+{
+    OMX_COMPONENTTYPE           *pOMXComponent      = Test_CreateEncoder(0);
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    int                          i;
+
+    for (i = 1; i <= 30; i++) {
+        Test_Encode(pOMXComponent, i);
+        TEST_CHECK(gControls.nMark == -1);
+    }
+
+    /* nothing tracked : an I-frame is the only way back */
+    Exynos_LTR_ReportLoss(pExynosComponent, 20 * TEST_FRAME_US);
+    Test_Encode(pOMXComponent, 31);
+    TEST_CHECK(gControls.nFrameType == VIDEO_FRAME_I);
+    TEST_CHECK(gControls.nMark == -1);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_PeriodicMarks);
+    TEST_RUN(Test_RecoveryFrameIsMarked);
+    TEST_RUN(Test_LaterMarksDiscarded);
+    TEST_RUN(Test_NoUsableLTR);
+    TEST_RUN(Test_AllSlotsInUse);
+    TEST_RUN(Test_NoPolicy);
+
+    return TEST_RESULT();
+}
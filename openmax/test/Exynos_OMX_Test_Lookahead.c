@@ -0,0 +1,326 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_Lookahead.c
+ * @brief       lookahead rate control of the encoder on a mock encoder
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Venc.h"
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_Queue.h"
+
+#define TEST_WIDTH          320
+#define TEST_HEIGHT         240
+#define TEST_DEPTH          4
+#define TEST_FRAMES         40
+#define TEST_CUT            20      /* first frame of the second scene */
+#define TEST_BITRATE        4000000
+#define TEST_MIN_QP         10
+#define TEST_MAX_QP         40
+
+/* what the mock encoder had applied when it encoded a frame */
+typedef struct _TEST_ENCODED_FRAME
+{
+    OMX_TICKS timeStamp;
+    OMX_BOOL  bIDR;
+    OMX_U32   nMinQP;
+    OMX_U32   nMaxQP;
+    OMX_U32   nBitrate;
+} TEST_ENCODED_FRAME;
+
+typedef struct _TEST_MOCK_ENCODER
+{
+    OMX_U32             nMinQP;
+    OMX_U32             nMaxQP;
+    OMX_U32             nBitrate;
+    TEST_ENCODED_FRAME  frame[TEST_FRAMES];
+    OMX_U32             nEncoded;
+} TEST_MOCK_ENCODER;
+
+static TEST_MOCK_ENCODER gMock;
+
+/* applies the configs queued for the frame, as the codecs do right before encoding it */
+static OMX_ERRORTYPE Mock_SrcInputProcess(OMX_COMPONENTTYPE *pOMXComponent, EXYNOS_OMX_DATA *pSrcInputData)
+{
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    TEST_ENCODED_FRAME          *pFrame             = &gMock.frame[gMock.nEncoded];
+    OMX_PTR                      pConfigCMD         = NULL;
+    OMX_PTR                      pConfig            = NULL;
+
+    if (gMock.nEncoded >= TEST_FRAMES)
+        return OMX_ErrorOverflow;
+
+    memset(pFrame, 0, sizeof(*pFrame));
+
+    while ((pConfigCMD = Exynos_OSAL_Dequeue(&pExynosComponent->dynamicConfigQ)) != NULL) {
+        pConfig = (OMX_PTR)((OMX_U8 *)pConfigCMD + sizeof(OMX_U32));
+
+        switch (*((OMX_S32 *)pConfigCMD)) {
+        case OMX_IndexConfigVideoIntraVOPRefresh:
+            pFrame->bIDR = ((OMX_CONFIG_INTRAREFRESHVOPTYPE *)pConfig)->IntraRefreshVOP;
+            break;
+        case OMX_IndexConfigVideoQPRange:
+            gMock.nMinQP = ((OMX_VIDEO_QPRANGETYPE *)pConfig)->qpRangeP.nMinQP;
+            gMock.nMaxQP = ((OMX_VIDEO_QPRANGETYPE *)pConfig)->qpRangeP.nMaxQP;
+            break;
+        case OMX_IndexConfigVideoBitrate:
+            gMock.nBitrate = ((OMX_VIDEO_CONFIG_BITRATETYPE *)pConfig)->nEncodeBitrate;
+            break;
+        default:
+            break;
+        }
+
+        Exynos_OSAL_Free(pConfigCMD);
+    }
+
+    pFrame->timeStamp = pSrcInputData->timeStamp;
+    pFrame->nMinQP    = gMock.nMinQP;
+    pFrame->nMaxQP    = gMock.nMaxQP;
+    pFrame->nBitrate  = gMock.nBitrate;
+    gMock.nEncoded++;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Mock_GetConfig(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pConfig)
+{
+    OMX_VIDEO_QPRANGETYPE *pQpRange = (OMX_VIDEO_QPRANGETYPE *)pConfig;
+
+    if ((int)nIndex != (int)OMX_IndexConfigVideoQPRange)
+        return OMX_ErrorUnsupportedIndex;
+
+    pQpRange->qpRangeI.nMinQP = pQpRange->qpRangeP.nMinQP = pQpRange->qpRangeB.nMinQP = TEST_MIN_QP;
+    pQpRange->qpRangeI.nMaxQP = pQpRange->qpRangeP.nMaxQP = pQpRange->qpRangeB.nMaxQP = TEST_MAX_QP;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(OMX_VIDEO_CONTROLRATETYPE eControlRate)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    Exynos_OSAL_QueueCreate(&pExynosComponent->dynamicConfigQ, MAX_QUEUE_ELEMENTS);
+    pOMXComponent->GetConfig = &Mock_GetConfig;
+
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].bufferProcessType          = BUFFER_COPY;
+    pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portDefinition.format.video.nBitrate = TEST_BITRATE;
+    pVideoEnc->eControlRate[OUTPUT_PORT_INDEX]   = eControlRate;
+    pVideoEnc->exynos_codec_srcInputProcess      = &Mock_SrcInputProcess;
+    pVideoEnc->lookahead.nDepth                  = TEST_DEPTH;
+    pVideoEnc->nMFCEncInputBufferNum             = MFC_INPUT_BUFFER_NUM_MAX;  /* as allocated for the first input */
+
+    memset(&gMock, 0, sizeof(gMock));
+    gMock.nMinQP   = TEST_MIN_QP;
+    gMock.nMaxQP   = TEST_MAX_QP;
+    gMock.nBitrate = TEST_BITRATE;
+
+    Exynos_Lookahead_Setup(pOMXComponent);
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyEncoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    Exynos_Lookahead_Reset(pExynosComponent);
+    Exynos_OSAL_Free(pVideoEnc->lookahead.pPrevSample);
+    Exynos_OSAL_Free(pVideoEnc->pAnalysisLuma);
+
+    while (Exynos_OSAL_GetElemNum(&pExynosComponent->dynamicConfigQ) > 0)
+        Exynos_OSAL_Free(Exynos_OSAL_Dequeue(&pExynosComponent->dynamicConfigQ));
+    Exynos_OSAL_QueueTerminate(&pExynosComponent->dynamicConfigQ);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+/* a static textured scene, then an inverted one panning by 2 pixels a frame */
+static void Test_MakeFrame(OMX_U8 *pLuma, OMX_U32 nFrame)
+{
+    OMX_U32 x, y;
+    OMX_U8  nValue;
+
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            if (nFrame < TEST_CUT) {
+                nValue = (x < (TEST_WIDTH / 2))? 100:(OMX_U8)((x * 37) ^ (y * 11));
+            } else {
+                OMX_U32 nX = x + ((nFrame - TEST_CUT) * 2);
+                nValue = (OMX_U8)(255 - ((x < (TEST_WIDTH / 2))? 100:(OMX_U8)((nX * 37) ^ (y * 11))));
+            }
+
+            pLuma[(y * TEST_WIDTH) + x] = nValue;
+        }
+    }
+}
+
+/* CSC, analysis and submission of each input, as the input thread does */
+static void Test_EncodeAll(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT    *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_U8                      *pFrame             = (OMX_U8 *)malloc(TEST_WIDTH * TEST_HEIGHT * 3 / 2);
+    EXYNOS_OMX_DATA              data;
+    OMX_U32                      i;
+
+    memset(pFrame + (TEST_WIDTH * TEST_HEIGHT), 128, TEST_WIDTH * TEST_HEIGHT / 2);
+
+    for (i = 0; i < TEST_FRAMES; i++) {
+        Test_MakeFrame(pFrame, i);
+        Exynos_Venc_AnalyzeInput(pExynosComponent, OMX_COLOR_FormatYUV420SemiPlanar, pFrame, TEST_WIDTH, TEST_WIDTH, TEST_HEIGHT);
+
+        memset(&data, 0, sizeof(data));
+        data.buffer.addr[0] = pFrame;
+        data.timeStamp      = i;
+        data.nFlags         = (i == (TEST_FRAMES - 1))? OMX_BUFFERFLAG_EOS:0;
+        Exynos_OMX_SrcInputSubmit(pOMXComponent, &data);
+    }
+
+    free(pFrame);
+}
+
+static void Test_FramesInOrder(void)
+{
+    OMX_COMPONENTTYPE   *pOMXComponent = Test_CreateEncoder(OMX_Video_ControlRateVariable);
+    OMX_U32              i;
+
+    Test_EncodeAll(pOMXComponent);
+
+    /* the window is drained at EOS */
+    TEST_CHECK(gMock.nEncoded == TEST_FRAMES);
+    for (i = 0; i < gMock.nEncoded; i++)
+        TEST_CHECK(gMock.frame[i].timeStamp == (OMX_TICKS)i);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_SceneCut(void)
+{
+    OMX_COMPONENTTYPE   *pOMXComponent = Test_CreateEncoder(OMX_Video_ControlRateVariable);
+    OMX_U32              i;
+
+    Test_EncodeAll(pOMXComponent);
+
+    /* one IDR at the cut, the motion of the new scene is not a cut again */
+    for (i = 0; i < gMock.nEncoded; i++)
+        TEST_CHECK(gMock.frame[i].bIDR == ((i == TEST_CUT)? OMX_TRUE:OMX_FALSE));
+
+    /* the frame right before the cut is known ahead and gets fewer bits */
+    TEST_CHECK(gMock.frame[TEST_CUT - 1].nMinQP == (TEST_MIN_QP + VENC_LOOKAHEAD_QP_DELTA));
+    TEST_CHECK(gMock.frame[TEST_CUT - 1].nMaxQP == TEST_MAX_QP);
+
+    /* a static scene keeps the base range */
+    TEST_CHECK(gMock.frame[TEST_CUT / 2].nMinQP == TEST_MIN_QP);
+    TEST_CHECK(gMock.frame[TEST_CUT / 2].nMaxQP == TEST_MAX_QP);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_BitrateFollowsComplexity(void)
+{
+    OMX_COMPONENTTYPE   *pOMXComponent = Test_CreateEncoder(OMX_Video_ControlRateVariable);
+    OMX_U32              i;
+
+    Test_EncodeAll(pOMXComponent);
+
+    for (i = 0; i < gMock.nEncoded; i++) {
+        TEST_CHECK(gMock.frame[i].nBitrate >= ((TEST_BITRATE / 4) * 3));
+        TEST_CHECK(gMock.frame[i].nBitrate <= ((TEST_BITRATE / 4) * 5));
+    }
+
+    /* raised ahead of the busy scene, not after it started */
+    TEST_CHECK(gMock.frame[TEST_CUT / 2].nBitrate == TEST_BITRATE);
+    TEST_CHECK(gMock.frame[TEST_CUT - 1].nBitrate > TEST_BITRATE);
+    TEST_CHECK(gMock.frame[TEST_CUT + 4].nBitrate > TEST_BITRATE);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_RealTimeDisabled(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder((OMX_VIDEO_CONTROLRATETYPE)OMX_Video_ControlRateConstantVTCall);
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_U8                          *pFrame             = (OMX_U8 *)calloc(1, TEST_WIDTH * TEST_HEIGHT * 3 / 2);
+    EXYNOS_OMX_DATA                  data;
+
+    TEST_CHECK(pVideoEnc->lookahead.nActiveDepth == 0);
+
+    /* the frame goes to the codec right away */
+    memset(&data, 0, sizeof(data));
+    data.buffer.addr[0] = pFrame;
+    Exynos_OMX_SrcInputSubmit(pOMXComponent, &data);
+    TEST_CHECK(gMock.nEncoded == 1);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pExynosComponent->dynamicConfigQ) == 0);
+
+    free(pFrame);
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_TrimmedMemoryDisabled(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder(OMX_Video_ControlRateVariable);
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    TEST_CHECK(pVideoEnc->lookahead.nActiveDepth > 0);
+
+    /* the input codec buffers were allocated under memory pressure */
+    pVideoEnc->nMFCEncInputBufferNum = MFC_INPUT_BUFFER_NUM_MIN;
+    Exynos_Lookahead_Setup(pOMXComponent);
+    TEST_CHECK(pVideoEnc->lookahead.nActiveDepth == 0);
+
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+static void Test_RGBAIsAnalyzed(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateEncoder(OMX_Video_ControlRateVariable);
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEOENC_COMPONENT   *pVideoEnc          = (EXYNOS_OMX_VIDEOENC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_U8                          *pFrame             = (OMX_U8 *)calloc(1, TEST_WIDTH * TEST_HEIGHT * 4);
+
+    /* MFC takes RGB as is, the analysis still has to see it */
+    Exynos_Venc_AnalyzeInput(pExynosComponent, OMX_COLOR_Format32BitRGBA8888, pFrame, TEST_WIDTH, TEST_WIDTH, TEST_HEIGHT);
+    TEST_CHECK(pVideoEnc->lookahead.bCurAnalyzed == OMX_TRUE);
+
+    free(pFrame);
+    Test_DestroyEncoder(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_FramesInOrder);
+    TEST_RUN(Test_SceneCut);
+    TEST_RUN(Test_BitrateFollowsComplexity);
+    TEST_RUN(Test_RealTimeDisabled);
+    TEST_RUN(Test_TrimmedMemoryDisabled);
+    TEST_RUN(Test_RGBAIsAnalyzed);
+
+    return TEST_RESULT();
+}
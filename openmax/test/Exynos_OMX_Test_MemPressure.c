@@ -0,0 +1,246 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_MemPressure.c
+ * @brief       PSI monitor driven by a fake pressure file, and what a decoder trims under pressure
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OMX_VdecControl.h"
+#include "Exynos_OSAL_MemPressure.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_Queue.h"
+
+#define TEST_HOLD_MS        200
+#define TEST_WAIT_MS        (MEMPRESSURE_POLL_MS * 3)
+#define TEST_DPB_SIZE       (1920 * 1088)
+
+/* "debug.omx.psi.path" and "debug.omx.psi.hold" on android */
+#define TEST_PSI_PATH       "/data/local/tmp/exynos_omx_psi"
+
+typedef struct _TEST_CLIENT
+{
+    int         nCalls;
+    OMX_BOOL    bPressure;
+} TEST_CLIENT;
+
+static char gPsiPath[256];
+static char gInputStream[MFC_INPUT_BUFFER_NUM_MAX];
+
+static void Test_WritePsi(const char *pAvg10)
+{
+    FILE *fp = fopen(gPsiPath, "w");
+
+    if (fp == NULL)
+        return;
+
+    fprintf(fp, "some avg10=%s avg60=0.00 avg300=0.00 total=0\n", pAvg10);
+    fprintf(fp, "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+    fclose(fp);
+}
+
+static void Test_Callback(OMX_PTR pData, OMX_BOOL bPressure)
+{
+    TEST_CLIENT *pClient = (TEST_CLIENT *)pData;
+
+    __atomic_store_n(&pClient->bPressure, bPressure, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&pClient->nCalls, 1, __ATOMIC_RELEASE);
+}
+
+static OMX_BOOL Test_WaitPressure(TEST_CLIENT *pClient, OMX_BOOL bPressure, int nTimeoutMs)
+{
+    OMX_TICKS nEnd = ExynosTest_GetTimeUs() + ((OMX_TICKS)nTimeoutMs * 1000);
+
+    while (ExynosTest_GetTimeUs() < nEnd) {
+        if ((__atomic_load_n(&pClient->nCalls, __ATOMIC_ACQUIRE) > 0) &&
+            (__atomic_load_n(&pClient->bPressure, __ATOMIC_ACQUIRE) == bPressure))
+            return OMX_TRUE;
+        usleep(10 * 1000);
+    }
+
+    return OMX_FALSE;
+}
+
+static void Test_MonitorFollowsFile(void)
+{
+    TEST_CLIENT     client      = { 0, OMX_FALSE };
+    TEST_CLIENT     lateClient  = { 0, OMX_FALSE };
+    OMX_HANDLETYPE  hClient     = NULL;
+    OMX_HANDLETYPE  hLateClient = NULL;
+    OMX_TICKS       nStart;
+    int             nCalls;
+
+    Test_WritePsi("0.00");
+    TEST_CHECK(Exynos_OSAL_MemPressure_Register(&hClient, Test_Callback, &client) == OMX_ErrorNone);
+    TEST_CHECK(Exynos_OSAL_MemPressure_Get() == OMX_FALSE);
+
+    /* a stall above the high mark turns it on within a poll period */
+    nStart = ExynosTest_GetTimeUs();
+    Test_WritePsi("35.50");
+    TEST_CHECK(Test_WaitPressure(&client, OMX_TRUE, TEST_WAIT_MS) == OMX_TRUE);
+    TEST_CHECK(Exynos_OSAL_MemPressure_Get() == OMX_TRUE);
+    printf("  pressure on after %lld ms\n", (long long)(ExynosTest_GetTimeUs() - nStart) / 1000);
+
+    /* a late client learns the current state on register */
+    TEST_CHECK(Exynos_OSAL_MemPressure_Register(&hLateClient, Test_Callback, &lateClient) == OMX_ErrorNone);
+    TEST_CHECK(lateClient.nCalls == 1);
+    TEST_CHECK(lateClient.bPressure == OMX_TRUE);
+    Exynos_OSAL_MemPressure_Unregister(hLateClient);
+
+    /* between the marks nothing changes */
+    Test_WritePsi("5.00");
+    usleep((MEMPRESSURE_POLL_MS + TEST_HOLD_MS) * 1000);
+    TEST_CHECK(client.bPressure == OMX_TRUE);
+
+    /* below the low mark it turns off once the hold time passed */
+    nStart = ExynosTest_GetTimeUs();
+    Test_WritePsi("0.10");
+    TEST_CHECK(Test_WaitPressure(&client, OMX_FALSE, TEST_WAIT_MS + TEST_HOLD_MS) == OMX_TRUE);
+    TEST_CHECK(Exynos_OSAL_MemPressure_Get() == OMX_FALSE);
+    printf("  pressure off after %lld ms\n", (long long)(ExynosTest_GetTimeUs() - nStart) / 1000);
+
+    /* nothing is called once unregistered */
+    Exynos_OSAL_MemPressure_Unregister(hClient);
+    nCalls = client.nCalls;
+    Test_WritePsi("60.00");
+    usleep((MEMPRESSURE_POLL_MS * 3 / 2) * 1000);
+    TEST_CHECK(client.nCalls == nCalls);
+    TEST_CHECK(Exynos_OSAL_MemPressure_Get() == OMX_FALSE);
+}
+
+/* a copy-mode decoder holding MFC_INPUT_BUFFER_NUM_MAX input codec buffers and one large DPB */
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_BASEPORT             *pOutputPort        = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    int i;
+
+    pInputPort->bufferProcessType = BUFFER_COPY;
+    Exynos_SetPlaneToPort(pInputPort, MFC_DEFAULT_INPUT_BUFFER_PLANE);
+    Exynos_OSAL_SemaphoreCreate(&pInputPort->codecSemID);
+    Exynos_OSAL_QueueCreate(&pInputPort->codecBufferQ, MAX_QUEUE_ELEMENTS);
+
+    /* no shared memory handle, the addresses only have to be told apart */
+    for (i = 0; i < MFC_INPUT_BUFFER_NUM_MAX; i++) {
+        pVideoDec->pMFCDecInputBuffer[i] = (CODEC_DEC_BUFFER *)calloc(1, sizeof(CODEC_DEC_BUFFER));
+        pVideoDec->pMFCDecInputBuffer[i]->pVirAddr[0] = &gInputStream[i];
+        pVideoDec->pMFCDecInputBuffer[i]->fd[0]       = -1;
+    }
+    pVideoDec->nMFCDecInputBufferNum = MFC_INPUT_BUFFER_NUM_MAX;
+
+    pOutputPort->bufferProcessType = BUFFER_COPY;
+    pOutputPort->portDefinition.format.video.nFrameWidth  = 1920;
+    pOutputPort->portDefinition.format.video.nFrameHeight = 1088;
+    Exynos_SetPlaneToPort(pOutputPort, 1);
+    pVideoDec->pMFCDecOutputBuffer[0] = (CODEC_DEC_BUFFER *)calloc(1, sizeof(CODEC_DEC_BUFFER));
+    pVideoDec->pMFCDecOutputBuffer[0]->bufferSize[0] = TEST_DPB_SIZE;
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyDecoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_OMX_BASEPORT             *pInputPort         = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+
+    Exynos_Free_CodecBuffers(pOMXComponent, INPUT_PORT_INDEX);
+    free(pVideoDec->pMFCDecOutputBuffer[0]);
+
+    Exynos_OSAL_QueueTerminate(&pInputPort->codecBufferQ);
+    Exynos_OSAL_SemaphoreTerminate(pInputPort->codecSemID);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_DecoderTrims(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    unsigned int                     nAllocLen[MAX_BUFFER_PLANE] = { TEST_DPB_SIZE / 2, 0, 0 };
+    OMX_S32                          nBufferCnt         = 1;
+
+    /* calm: everything is kept */
+    TEST_CHECK(Exynos_Get_ExtraDPBNum(pOMXComponent) == EXTRA_DPB_NUM);
+    TEST_CHECK(Exynos_Check_ReusableCodecBuffers(pOMXComponent, 1280, 720, nAllocLen, &nBufferCnt) == OMX_TRUE);
+    Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
+    TEST_CHECK(pVideoDec->nMFCDecInputBufferNum == MFC_INPUT_BUFFER_NUM_MAX);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pExynosComponent->pExynosPort[INPUT_PORT_INDEX].codecBufferQ) == MFC_INPUT_BUFFER_NUM_MAX);
+    TEST_CHECK(Exynos_Find_CodecInputBuffer(pOMXComponent, &gInputStream[MFC_INPUT_BUFFER_NUM_MAX - 1]) == pVideoDec->pMFCDecInputBuffer[MFC_INPUT_BUFFER_NUM_MAX - 1]);
+
+    /* what the monitor callback sets */
+    pVideoDec->bMemoryPressure = OMX_TRUE;
+
+    TEST_CHECK(Exynos_Get_ExtraDPBNum(pOMXComponent) == EXTRA_DPB_NUM_MIN);
+    nBufferCnt = 1;
+    TEST_CHECK(Exynos_Check_ReusableCodecBuffers(pOMXComponent, 1280, 720, nAllocLen, &nBufferCnt) == OMX_FALSE);
+
+    /* the next input flush gives the spare input codec buffers back */
+    Exynos_EnQueue_CodecInputBuffers(pOMXComponent);
+    TEST_CHECK(pVideoDec->nMFCDecInputBufferNum == MFC_INPUT_BUFFER_NUM_MIN);
+    TEST_CHECK(pVideoDec->pMFCDecInputBuffer[MFC_INPUT_BUFFER_NUM_MAX - 1] == NULL);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pExynosComponent->pExynosPort[INPUT_PORT_INDEX].codecBufferQ) == MFC_INPUT_BUFFER_NUM_MIN);
+    TEST_CHECK(Exynos_Find_CodecInputBuffer(pOMXComponent, &gInputStream[MFC_INPUT_BUFFER_NUM_MAX - 1]) == NULL);
+
+    /* thumbnails never get extra DPBs */
+    pVideoDec->bThumbnailMode = OMX_TRUE;
+    TEST_CHECK(Exynos_Get_ExtraDPBNum(pOMXComponent) == 0);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    char holdMs[16];
+
+#ifdef USE_ANDROID
+    snprintf(gPsiPath, sizeof(gPsiPath), "%s", TEST_PSI_PATH);
+    snprintf(holdMs, sizeof(holdMs), "%d", TEST_HOLD_MS);
+    property_set("debug.omx.psi.path", gPsiPath);
+    property_set("debug.omx.psi.hold", holdMs);
+#else
+    snprintf(gPsiPath, sizeof(gPsiPath), "/tmp/exynos_omx_psi.%d", (int)getpid());
+    snprintf(holdMs, sizeof(holdMs), "%d", TEST_HOLD_MS);
+    setenv("EXYNOS_OMX_PSI_PATH", gPsiPath, 1);
+    setenv("EXYNOS_OMX_PSI_HOLD", holdMs, 1);
+#endif
+
+    TEST_RUN(Test_MonitorFollowsFile);
+    TEST_RUN(Test_DecoderTrims);
+
+    unlink(gPsiPath);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,802 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_MockCodec.c
+ * @brief       the Exynos video API on the mock MFC(ExynosVideo_OSAL_Mock.c),
+ *              and the worker pool against a thread per queue on top of it.
+ *              needs libExynosVideoApi built with BOARD_USE_MOCK_CODEC
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_WorkerPool.h"
+#include "ExynosVideoApi.h"
+
+#define TEST_WIDTH          320
+#define TEST_HEIGHT         240
+#define TEST_LUMA_SIZE      (TEST_WIDTH * TEST_HEIGHT)
+#define TEST_STREAM_SIZE    (64 * 1024)
+#define TEST_BUFFERS        4
+#define TEST_FRAMES         9
+#define TEST_IDR_PERIOD     4
+#define TEST_FRAME_US       2000
+#define TEST_SCALE_FRAMES   30
+#define TEST_SCALE_MAX      16
+
+/* ion is faked by memfd, the mock codec does not need more */
+int exynos_ion_open(void)
+{
+    return (int)syscall(__NR_memfd_create, "test-ion", 0);
+}
+
+int exynos_ion_close(int fd)
+{
+    return close(fd);
+}
+
+int exynos_ion_alloc(int fd, size_t len, unsigned int heap_mask, unsigned int flags)
+{
+    int hFD = (int)syscall(__NR_memfd_create, "test-ion-buffer", 0);
+
+    if ((hFD >= 0) &&
+        (ftruncate(hFD, len) != 0)) {
+        close(hFD);
+        hFD = -1;
+    }
+
+    return hFD;
+}
+
+/* a dmabuf of the client, a plane per fd */
+typedef struct _TEST_BUFFER
+{
+    void            *pAddr[3];
+    unsigned long    fd[3];
+    unsigned int     nAllocLen[3];
+    unsigned int     nDataSize[3];
+    int              nPlanes;
+} TEST_BUFFER;
+
+typedef struct _TEST_SESSION
+{
+    void                    *hCodec;
+    ExynosVideoDecOps        decOps;
+    ExynosVideoDecBufferOps  decInOps;
+    ExynosVideoDecBufferOps  decOutOps;
+    ExynosVideoEncOps        encOps;
+    ExynosVideoEncBufferOps  encInOps;
+    ExynosVideoEncBufferOps  encOutOps;
+    TEST_BUFFER              inbuf[TEST_BUFFERS];
+    TEST_BUFFER              outbuf[TEST_BUFFERS];
+    OMX_BUFFERHEADERTYPE     header[TEST_BUFFERS];
+} TEST_SESSION;
+
+static void Test_AllocBuffer(TEST_BUFFER *pBuffer, int nPlanes, unsigned int nSize0, unsigned int nSize1)
+{
+    int i;
+
+    memset(pBuffer, 0, sizeof(*pBuffer));
+    pBuffer->nPlanes      = nPlanes;
+    pBuffer->nAllocLen[0] = nSize0;
+    pBuffer->nAllocLen[1] = nSize1;
+
+    for (i = 0; i < nPlanes; i++) {
+        pBuffer->fd[i]    = (unsigned long)exynos_ion_alloc(0, pBuffer->nAllocLen[i], 0, 0);
+        pBuffer->pAddr[i] = mmap(NULL, pBuffer->nAllocLen[i], PROT_READ | PROT_WRITE, MAP_SHARED, (int)pBuffer->fd[i], 0);
+    }
+}
+
+static void Test_FreeBuffer(TEST_BUFFER *pBuffer)
+{
+    int i;
+
+    for (i = 0; i < pBuffer->nPlanes; i++) {
+        munmap(pBuffer->pAddr[i], pBuffer->nAllocLen[i]);
+        close((int)pBuffer->fd[i]);
+    }
+
+    memset(pBuffer, 0, sizeof(*pBuffer));
+}
+
+static TEST_BUFFER *Test_FindBuffer(TEST_BUFFER *pList, void *pAddr)
+{
+    int i;
+
+    for (i = 0; i < TEST_BUFFERS; i++) {
+        if (pList[i].pAddr[0] == pAddr)
+            return &pList[i];
+    }
+
+    return NULL;
+}
+
+static ExynosVideoErrorType Test_QueueDecoderOutput(TEST_SESSION *pSession, TEST_BUFFER *pBuffer)
+{
+    pBuffer->nDataSize[0] = 0;
+    pBuffer->nDataSize[1] = 0;
+
+    return pSession->decOutOps.ExtensionEnqueue(pSession->hCodec, pBuffer->pAddr, pBuffer->fd,
+                                                pBuffer->nAllocLen, pBuffer->nDataSize, pBuffer->nPlanes, NULL);
+}
+
+static ExynosVideoErrorType Test_DecodeFrame(TEST_SESSION *pSession, int nFrame, unsigned int nSize, OMX_U32 nFlags)
+{
+    TEST_BUFFER             *pBuffer = &pSession->inbuf[nFrame % TEST_BUFFERS];
+    OMX_BUFFERHEADERTYPE    *pHeader = &pSession->header[nFrame % TEST_BUFFERS];
+
+    pBuffer->nDataSize[0] = nSize;
+    pHeader->nFlags       = nFlags;
+    pHeader->nTimeStamp   = (OMX_TICKS)nFrame * 33333;
+
+    pSession->decOps.Set_FrameTag(pSession->hCodec, nFrame);
+
+    return pSession->decInOps.ExtensionEnqueue(pSession->hCodec, pBuffer->pAddr, pBuffer->fd,
+                                               pBuffer->nAllocLen, pBuffer->nDataSize, 1, pHeader);
+}
+
+static OMX_BOOL Test_InitDecoder(TEST_SESSION *pSession)
+{
+    ExynosVideoInstInfo  instInfo;
+    ExynosVideoGeometry  geometry;
+    int                  i;
+
+    memset(pSession, 0, sizeof(*pSession));
+    pSession->decOps.nSize    = sizeof(pSession->decOps);
+    pSession->decInOps.nSize  = sizeof(pSession->decInOps);
+    pSession->decOutOps.nSize = sizeof(pSession->decOutOps);
+
+    if (Exynos_Video_Register_Decoder(&pSession->decOps, &pSession->decInOps, &pSession->decOutOps) != VIDEO_ERROR_NONE)
+        return OMX_FALSE;
+
+    memset(&instInfo, 0, sizeof(instInfo));
+    instInfo.eCodecType  = VIDEO_CODING_AVC;
+    instInfo.nMemoryType = VIDEO_MEMORY_DMABUF;
+    if (Exynos_Video_GetInstInfo(&instInfo, VIDEO_TRUE) != VIDEO_ERROR_NONE)
+        return OMX_FALSE;
+
+    pSession->hCodec = pSession->decOps.Init(&instInfo);
+    if (pSession->hCodec == NULL)
+        return OMX_FALSE;
+
+    pSession->decInOps.Set_Shareable(pSession->hCodec);
+    pSession->decOutOps.Set_Shareable(pSession->hCodec);
+
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.eCompressionFormat = VIDEO_CODING_AVC;
+    geometry.nSizeImage         = TEST_STREAM_SIZE;
+    geometry.nPlaneCnt          = 1;
+    if ((pSession->decInOps.Set_Geometry(pSession->hCodec, &geometry) != VIDEO_ERROR_NONE) ||
+        (pSession->decInOps.Setup(pSession->hCodec, TEST_BUFFERS) != VIDEO_ERROR_NONE))
+        return OMX_FALSE;
+
+    for (i = 0; i < TEST_BUFFERS; i++)
+        Test_AllocBuffer(&pSession->inbuf[i], 1, TEST_STREAM_SIZE, 0);
+
+    return OMX_TRUE;
+}
+
+/* same order as the codec components: header, geometry, then the DPB */
+static OMX_BOOL Test_OpenDecoder(TEST_SESSION *pSession)
+{
+    ExynosVideoGeometry  geometry;
+    ExynosVideoBuffer    videoBuffer;
+    int                  i;
+
+    if (Test_InitDecoder(pSession) != OMX_TRUE)
+        return OMX_FALSE;
+
+    /* the header is the first stream, the driver gives it back after parsing */
+    if ((Test_DecodeFrame(pSession, 0, 100, OMX_BUFFERFLAG_CODECCONFIG) != VIDEO_ERROR_NONE) ||
+        (pSession->decInOps.Run(pSession->hCodec) != VIDEO_ERROR_NONE) ||
+        (pSession->decInOps.ExtensionDequeue(pSession->hCodec, &videoBuffer) != VIDEO_ERROR_NONE) ||
+        (videoBuffer.planes[0].addr != pSession->inbuf[0].pAddr[0]))
+        return OMX_FALSE;
+
+    memset(&geometry, 0, sizeof(geometry));
+    if (pSession->decOutOps.Get_Geometry(pSession->hCodec, &geometry) != VIDEO_ERROR_NONE)
+        return OMX_FALSE;
+
+    geometry.eColorFormat = VIDEO_COLORFORMAT_NV12M;
+    geometry.nPlaneCnt    = 2;
+    if ((pSession->decOutOps.Set_Geometry(pSession->hCodec, &geometry) != VIDEO_ERROR_NONE) ||
+        (pSession->decOutOps.Setup(pSession->hCodec, TEST_BUFFERS) != VIDEO_ERROR_NONE))
+        return OMX_FALSE;
+
+    for (i = 0; i < TEST_BUFFERS; i++) {
+        Test_AllocBuffer(&pSession->outbuf[i], 2, TEST_LUMA_SIZE, TEST_LUMA_SIZE / 2);
+        if (Test_QueueDecoderOutput(pSession, &pSession->outbuf[i]) != VIDEO_ERROR_NONE)
+            return OMX_FALSE;
+    }
+
+    return (pSession->decOutOps.Run(pSession->hCodec) == VIDEO_ERROR_NONE)? OMX_TRUE:OMX_FALSE;
+}
+
+static void Test_CloseSession(TEST_SESSION *pSession, OMX_BOOL bDecoder)
+{
+    int i;
+
+    if (pSession->hCodec != NULL) {
+        if (bDecoder == OMX_TRUE) {
+            pSession->decInOps.Stop(pSession->hCodec);
+            pSession->decOutOps.Stop(pSession->hCodec);
+            pSession->decOps.Finalize(pSession->hCodec);
+        } else {
+            pSession->encInOps.Stop(pSession->hCodec);
+            pSession->encOutOps.Stop(pSession->hCodec);
+            pSession->encOps.Finalize(pSession->hCodec);
+        }
+        pSession->hCodec = NULL;
+    }
+
+    for (i = 0; i < TEST_BUFFERS; i++) {
+        Test_FreeBuffer(&pSession->inbuf[i]);
+        Test_FreeBuffer(&pSession->outbuf[i]);
+    }
+}
+
+static void Test_DecoderHeader(void)
+{
+    ExynosVideoInstInfo  instInfo;
+    TEST_SESSION         session;
+    ExynosVideoGeometry  geometry;
+
+    memset(&instInfo, 0, sizeof(instInfo));
+    instInfo.eCodecType = VIDEO_CODING_AVC;
+    TEST_CHECK(Exynos_Video_GetInstInfo(&instInfo, VIDEO_TRUE) == VIDEO_ERROR_NONE);
+    TEST_CHECK(instInfo.HwVersion == (int)MFC_1220);
+    TEST_CHECK(instInfo.supportInfo.dec.bDrvDPBManageSupport == VIDEO_TRUE);
+
+    /* no geometry until the header is parsed */
+    TEST_CHECK(Test_InitDecoder(&session) == OMX_TRUE);
+    memset(&geometry, 0, sizeof(geometry));
+    TEST_CHECK(session.decOutOps.Get_Geometry(session.hCodec, &geometry) == VIDEO_ERROR_HEADERINFO);
+    Test_CloseSession(&session, OMX_TRUE);
+
+    TEST_CHECK(Test_OpenDecoder(&session) == OMX_TRUE);
+
+    memset(&geometry, 0, sizeof(geometry));
+    TEST_CHECK(session.decOutOps.Get_Geometry(session.hCodec, &geometry) == VIDEO_ERROR_NONE);
+    TEST_CHECK(geometry.nFrameWidth == TEST_WIDTH);
+    TEST_CHECK(geometry.nFrameHeight == TEST_HEIGHT);
+    TEST_CHECK(geometry.cropRect.nWidth == TEST_WIDTH);
+    TEST_CHECK(session.decOps.Get_ActualBufferCount(session.hCodec) > 0);
+
+    Test_CloseSession(&session, OMX_TRUE);
+}
+
+static void Test_DecoderFrames(void)
+{
+    TEST_SESSION         session;
+    ExynosVideoBuffer    videoBuffer;
+    TEST_BUFFER         *pBuffer = NULL;
+    int                  i;
+
+    TEST_CHECK(Test_OpenDecoder(&session) == OMX_TRUE);
+
+    for (i = 0; i < TEST_FRAMES; i++) {
+        TEST_CHECK(Test_DecodeFrame(&session, i, 1000, 0) == VIDEO_ERROR_NONE);
+
+        memset(&videoBuffer, 0, sizeof(videoBuffer));
+        TEST_CHECK(session.decOutOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+        TEST_CHECK(videoBuffer.displayStatus == VIDEO_FRAME_STATUS_DISPLAY_DECODING);
+        TEST_CHECK(videoBuffer.planes[0].dataSize == TEST_LUMA_SIZE);
+        TEST_CHECK(videoBuffer.planes[1].dataSize == (TEST_LUMA_SIZE / 2));
+        TEST_CHECK(videoBuffer.frameType == ((i == 0)? VIDEO_FRAME_I:VIDEO_FRAME_P));
+        TEST_CHECK(session.decOps.Get_FrameTag(session.hCodec) == i);
+
+        pBuffer = Test_FindBuffer(session.outbuf, videoBuffer.planes[0].addr);
+        TEST_CHECK(pBuffer != NULL);
+        if (pBuffer != NULL)
+            TEST_CHECK(Test_QueueDecoderOutput(&session, pBuffer) == VIDEO_ERROR_NONE);
+
+        memset(&videoBuffer, 0, sizeof(videoBuffer));
+        TEST_CHECK(session.decInOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+        TEST_CHECK(videoBuffer.planes[0].addr == session.inbuf[i % TEST_BUFFERS].pAddr[0]);
+
+    }
+
+    /* an empty stream is EOS, the driver finishes with an empty frame */
+    TEST_CHECK(Test_DecodeFrame(&session, TEST_FRAMES, 0, OMX_BUFFERFLAG_EOS) == VIDEO_ERROR_NONE);
+    memset(&videoBuffer, 0, sizeof(videoBuffer));
+    TEST_CHECK(session.decOutOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+    TEST_CHECK(videoBuffer.displayStatus == VIDEO_FRAME_STATUS_DECODING_FINISHED);
+    TEST_CHECK(videoBuffer.planes[0].dataSize == 0);
+    TEST_CHECK(session.decOps.Get_FrameTag(session.hCodec) == TEST_FRAMES);
+
+    Test_CloseSession(&session, OMX_TRUE);
+}
+
+static void *Test_DequeueThread(void *pArg)
+{
+    TEST_SESSION        *pSession = (TEST_SESSION *)pArg;
+    ExynosVideoBuffer    videoBuffer;
+
+    return (void *)(unsigned long)pSession->decOutOps.ExtensionDequeue(pSession->hCodec, &videoBuffer);
+}
+
+static void Test_StreamOffWakesDequeue(void)
+{
+    TEST_SESSION    session;
+    pthread_t       hThread;
+    void           *pResult = NULL;
+
+    TEST_CHECK(Test_OpenDecoder(&session) == OMX_TRUE);
+
+    /* no stream is queued, the thread blocks until the port is stopped */
+    TEST_CHECK(pthread_create(&hThread, NULL, Test_DequeueThread, &session) == 0);
+    usleep(20 * 1000);
+    TEST_CHECK(session.decOutOps.Stop(session.hCodec) == VIDEO_ERROR_NONE);
+    pthread_join(hThread, &pResult);
+    TEST_CHECK((ExynosVideoErrorType)(unsigned long)pResult != VIDEO_ERROR_NONE);
+
+    Test_CloseSession(&session, OMX_TRUE);
+}
+
+static void Test_SharedHardware(void)
+{
+    TEST_SESSION        session[2];
+    ExynosVideoBuffer   videoBuffer;
+    OMX_TICKS           nStartUs;
+    OMX_TICKS           nElapsedUs;
+    int                 i, j;
+
+    TEST_CHECK(Test_OpenDecoder(&session[0]) == OMX_TRUE);
+    TEST_CHECK(Test_OpenDecoder(&session[1]) == OMX_TRUE);
+
+    /* both sessions queue at once, one MFC decodes their frames one by one */
+    nStartUs = ExynosTest_GetTimeUs();
+    for (i = 1; i < TEST_BUFFERS; i++) {
+        for (j = 0; j < 2; j++)
+            TEST_CHECK(Test_DecodeFrame(&session[j], i, 1000, 0) == VIDEO_ERROR_NONE);
+    }
+
+    for (i = 1; i < TEST_BUFFERS; i++) {
+        for (j = 0; j < 2; j++)
+            TEST_CHECK(session[j].decOutOps.ExtensionDequeue(session[j].hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+    }
+    nElapsedUs = ExynosTest_GetTimeUs() - nStartUs;
+
+    TEST_CHECK(nElapsedUs >= ((TEST_BUFFERS - 1) * 2 * TEST_FRAME_US));
+
+    Test_CloseSession(&session[0], OMX_TRUE);
+    Test_CloseSession(&session[1], OMX_TRUE);
+}
+
+static void Test_Encoder(void)
+{
+    ExynosVideoInstInfo      instInfo;
+    TEST_SESSION             session;
+    ExynosVideoGeometry      geometry;
+    ExynosVideoBuffer        videoBuffer;
+    TEST_BUFFER             *pBuffer = NULL;
+    OMX_BUFFERHEADERTYPE    *pHeader = NULL;
+    unsigned char           *pStream = NULL;
+    int                      i;
+
+    memset(&session, 0, sizeof(session));
+    session.encOps.nSize    = sizeof(session.encOps);
+    session.encInOps.nSize  = sizeof(session.encInOps);
+    session.encOutOps.nSize = sizeof(session.encOutOps);
+    TEST_CHECK(Exynos_Video_Register_Encoder(&session.encOps, &session.encInOps, &session.encOutOps) == VIDEO_ERROR_NONE);
+
+    memset(&instInfo, 0, sizeof(instInfo));
+    instInfo.eCodecType  = VIDEO_CODING_AVC;
+    instInfo.nMemoryType = VIDEO_MEMORY_DMABUF;
+    TEST_CHECK(Exynos_Video_GetInstInfo(&instInfo, VIDEO_FALSE) == VIDEO_ERROR_NONE);
+    session.hCodec = session.encOps.Init(&instInfo);
+    TEST_CHECK(session.hCodec != NULL);
+    if (session.hCodec == NULL)
+        return;
+
+    session.encInOps.Set_Shareable(session.hCodec);
+    session.encOutOps.Set_Shareable(session.hCodec);
+    TEST_CHECK(session.encOps.Set_IDRPeriod(session.hCodec, TEST_IDR_PERIOD) == VIDEO_ERROR_NONE);
+
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.nFrameWidth  = TEST_WIDTH;
+    geometry.nFrameHeight = TEST_HEIGHT;
+    geometry.nStride      = TEST_WIDTH;
+    geometry.eColorFormat = VIDEO_COLORFORMAT_NV12M;
+    geometry.nPlaneCnt    = 2;
+    TEST_CHECK(session.encInOps.Set_Geometry(session.hCodec, &geometry) == VIDEO_ERROR_NONE);
+    TEST_CHECK(session.encInOps.Get_Geometry(session.hCodec, &geometry) == VIDEO_ERROR_NONE);
+    TEST_CHECK(geometry.nSizeImage == TEST_LUMA_SIZE);
+
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.eCompressionFormat = VIDEO_CODING_AVC;
+    geometry.nSizeImage         = TEST_STREAM_SIZE;
+    geometry.nPlaneCnt          = 1;
+    TEST_CHECK(session.encOutOps.Set_Geometry(session.hCodec, &geometry) == VIDEO_ERROR_NONE);
+
+    TEST_CHECK(session.encInOps.Setup(session.hCodec, TEST_BUFFERS) == VIDEO_ERROR_NONE);
+    TEST_CHECK(session.encOutOps.Setup(session.hCodec, TEST_BUFFERS) == VIDEO_ERROR_NONE);
+
+    for (i = 0; i < TEST_BUFFERS; i++) {
+        Test_AllocBuffer(&session.inbuf[i], 2, TEST_LUMA_SIZE, TEST_LUMA_SIZE / 2);
+        Test_AllocBuffer(&session.outbuf[i], 1, TEST_STREAM_SIZE, 0);
+        TEST_CHECK(session.encOutOps.ExtensionEnqueue(session.hCodec, session.outbuf[i].pAddr, session.outbuf[i].fd,
+                                                      session.outbuf[i].nAllocLen, session.outbuf[i].nDataSize, 1, NULL) == VIDEO_ERROR_NONE);
+    }
+
+    TEST_CHECK(session.encInOps.Run(session.hCodec) == VIDEO_ERROR_NONE);
+    TEST_CHECK(session.encOutOps.Run(session.hCodec) == VIDEO_ERROR_NONE);
+
+    for (i = 0; i <= TEST_FRAMES; i++) {
+        pBuffer = &session.inbuf[i % TEST_BUFFERS];
+        pHeader = &session.header[i % TEST_BUFFERS];
+
+        pBuffer->nDataSize[0] = (i < TEST_FRAMES)? TEST_LUMA_SIZE:0;
+        pBuffer->nDataSize[1] = (i < TEST_FRAMES)? (TEST_LUMA_SIZE / 2):0;
+        pHeader->nFlags       = (i < TEST_FRAMES)? 0:OMX_BUFFERFLAG_EOS;
+        pHeader->nTimeStamp   = (OMX_TICKS)i * 33333;
+
+        if (i == 6)
+            session.encOps.Set_FrameType(session.hCodec, VIDEO_FRAME_I);
+
+        session.encOps.Set_FrameTag(session.hCodec, i);
+        TEST_CHECK(session.encInOps.ExtensionEnqueue(session.hCodec, pBuffer->pAddr, pBuffer->fd,
+                                                     pBuffer->nAllocLen, pBuffer->nDataSize, 2, pHeader) == VIDEO_ERROR_NONE);
+
+        memset(&videoBuffer, 0, sizeof(videoBuffer));
+        TEST_CHECK(session.encOutOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+
+        if (i == 0) {
+            /* SPS and PPS come first, with start codes */
+            pStream = (unsigned char *)videoBuffer.planes[0].addr;
+            TEST_CHECK(session.encOps.Get_FrameTag(session.hCodec) == -1);
+            TEST_CHECK(videoBuffer.planes[0].dataSize > 5);
+            TEST_CHECK((pStream[0] == 0) && (pStream[1] == 0) && (pStream[2] == 0) && (pStream[3] == 1));
+            TEST_CHECK((pStream[4] & 0x1F) == 7);
+
+            pBuffer = Test_FindBuffer(session.outbuf, videoBuffer.planes[0].addr);
+            if (pBuffer != NULL)
+                session.encOutOps.ExtensionEnqueue(session.hCodec, pBuffer->pAddr, pBuffer->fd,
+                                                   pBuffer->nAllocLen, pBuffer->nDataSize, 1, NULL);
+
+            memset(&videoBuffer, 0, sizeof(videoBuffer));
+            TEST_CHECK(session.encOutOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+        }
+
+        TEST_CHECK(session.encOps.Get_FrameTag(session.hCodec) == i);
+        TEST_CHECK(videoBuffer.timestamp == (int64_t)i * 33333);
+
+        if (i < TEST_FRAMES) {
+            int bIFrame = (((i % TEST_IDR_PERIOD) == 0) || (i == 6))? 1:0;
+
+            TEST_CHECK(videoBuffer.planes[0].dataSize > 0);
+            TEST_CHECK(videoBuffer.frameType == (bIFrame? VIDEO_FRAME_I:VIDEO_FRAME_P));
+        } else {
+            TEST_CHECK(videoBuffer.planes[0].dataSize == 0);
+        }
+
+        pBuffer = Test_FindBuffer(session.outbuf, videoBuffer.planes[0].addr);
+        TEST_CHECK(pBuffer != NULL);
+        if (pBuffer != NULL)
+            session.encOutOps.ExtensionEnqueue(session.hCodec, pBuffer->pAddr, pBuffer->fd,
+                                               pBuffer->nAllocLen, pBuffer->nDataSize, 1, NULL);
+
+        memset(&videoBuffer, 0, sizeof(videoBuffer));
+        TEST_CHECK(session.encInOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+    }
+
+    Test_CloseSession(&session, OMX_FALSE);
+}
+
+static int Test_IsReadable(int hFd, int nTimeoutMs)
+{
+    struct pollfd pollFd;
+
+    pollFd.fd      = hFd;
+    pollFd.events  = POLLIN;
+    pollFd.revents = 0;
+
+    return (poll(&pollFd, 1, nTimeoutMs) == 1)? 1:0;
+}
+
+static void Test_ReadyFd(void)
+{
+    TEST_SESSION        session;
+    ExynosVideoBuffer   videoBuffer;
+    int                 hSrcFd = -1;
+    int                 hDstFd = -1;
+
+    TEST_CHECK(Test_OpenDecoder(&session) == OMX_TRUE);
+    TEST_CHECK(session.decInOps.Get_ReadyFd(session.hCodec, &hSrcFd) == VIDEO_ERROR_NONE);
+    TEST_CHECK(session.decOutOps.Get_ReadyFd(session.hCodec, &hDstFd) == VIDEO_ERROR_NONE);
+    TEST_CHECK((hSrcFd >= 0) && (hDstFd >= 0) && (hSrcFd != hDstFd));
+
+    /* nothing is decoded yet */
+    TEST_CHECK(Test_IsReadable(hDstFd, 0) == 0);
+
+    /* readable once the frame is done on the hardware, not when it is queued */
+    TEST_CHECK(Test_DecodeFrame(&session, 1, 1000, 0) == VIDEO_ERROR_NONE);
+    TEST_CHECK(Test_IsReadable(hDstFd, 0) == 0);
+    TEST_CHECK(Test_IsReadable(hDstFd, 100) == 1);
+    TEST_CHECK(Test_IsReadable(hSrcFd, 0) == 1);
+
+    TEST_CHECK(session.decOutOps.ExtensionDequeue(session.hCodec, &videoBuffer) == VIDEO_ERROR_NONE);
+    TEST_CHECK(Test_IsReadable(hDstFd, 0) == 0);
+
+    /* stop makes it readable, so a parked waiter comes back */
+    TEST_CHECK(session.decOutOps.Stop(session.hCodec) == VIDEO_ERROR_NONE);
+    TEST_CHECK(Test_IsReadable(hDstFd, 0) == 1);
+
+    Test_CloseSession(&session, OMX_TRUE);
+}
+
+/* one decoding session of the scaling run, its two queues are served like the buffer process does */
+typedef struct _TEST_STREAM
+{
+    TEST_SESSION     session;
+    int              hSrcFd;
+    int              hDstFd;
+    int              nQueued;
+    int              nConsumed;
+    int              nDecoded;
+    int              nSteps;
+    OMX_BOOL         bError;
+    OMX_HANDLETYPE   hDone;
+} TEST_STREAM;
+
+static void Test_StreamFeed(TEST_STREAM *pStream)
+{
+    ExynosVideoBuffer videoBuffer;
+
+    if (pStream->session.decInOps.ExtensionDequeue(pStream->session.hCodec, &videoBuffer) != VIDEO_ERROR_NONE) {
+        pStream->bError = OMX_TRUE;
+        return;
+    }
+    pStream->nConsumed++;
+
+    if (pStream->nQueued < TEST_SCALE_FRAMES) {
+        pStream->nQueued++;
+        if (Test_DecodeFrame(&pStream->session, pStream->nQueued, 1000, 0) != VIDEO_ERROR_NONE)
+            pStream->bError = OMX_TRUE;
+    }
+}
+
+static void Test_StreamDrain(TEST_STREAM *pStream)
+{
+    ExynosVideoBuffer    videoBuffer;
+    TEST_BUFFER         *pBuffer = NULL;
+
+    if (pStream->session.decOutOps.ExtensionDequeue(pStream->session.hCodec, &videoBuffer) != VIDEO_ERROR_NONE) {
+        pStream->bError = OMX_TRUE;
+        return;
+    }
+    pStream->nDecoded++;
+
+    pBuffer = Test_FindBuffer(pStream->session.outbuf, videoBuffer.planes[0].addr);
+    if ((pBuffer == NULL) ||
+        (Test_QueueDecoderOutput(&pStream->session, pBuffer) != VIDEO_ERROR_NONE))
+        pStream->bError = OMX_TRUE;
+}
+
+static void *Test_FeedThread(void *pArg)
+{
+    TEST_STREAM *pStream = (TEST_STREAM *)pArg;
+
+    while ((pStream->nConsumed < TEST_SCALE_FRAMES) &&
+           (pStream->bError == OMX_FALSE))
+        Test_StreamFeed(pStream);
+
+    return NULL;
+}
+
+static void *Test_DrainThread(void *pArg)
+{
+    TEST_STREAM *pStream = (TEST_STREAM *)pArg;
+
+    while ((pStream->nDecoded < TEST_SCALE_FRAMES) &&
+           (pStream->bError == OMX_FALSE))
+        Test_StreamDrain(pStream);
+
+    return NULL;
+}
+
+/* the same loops as pool steps: park on the ready fd instead of sleeping in the dequeue */
+static OMX_ERRORTYPE Test_FeedStep(OMX_PTR pData)
+{
+    TEST_STREAM *pStream = (TEST_STREAM *)pData;
+
+    __sync_fetch_and_add(&pStream->nSteps, 1);
+
+    while ((pStream->nConsumed < TEST_SCALE_FRAMES) &&
+           (pStream->bError == OMX_FALSE)) {
+        if (Exynos_OSAL_WorkerYield() == OMX_TRUE)
+            return OMX_ErrorNone;
+        if (Exynos_OSAL_WorkerWaitFd(pStream->hSrcFd) == OMX_FALSE)
+            return OMX_ErrorNone;
+        Test_StreamFeed(pStream);
+    }
+
+    Exynos_OSAL_WorkerPark();
+    Exynos_OSAL_SemaphorePost(pStream->hDone);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_DrainStep(OMX_PTR pData)
+{
+    TEST_STREAM *pStream = (TEST_STREAM *)pData;
+
+    __sync_fetch_and_add(&pStream->nSteps, 1);
+
+    while ((pStream->nDecoded < TEST_SCALE_FRAMES) &&
+           (pStream->bError == OMX_FALSE)) {
+        if (Exynos_OSAL_WorkerYield() == OMX_TRUE)
+            return OMX_ErrorNone;
+        if (Exynos_OSAL_WorkerWaitFd(pStream->hDstFd) == OMX_FALSE)
+            return OMX_ErrorNone;
+        Test_StreamDrain(pStream);
+    }
+
+    Exynos_OSAL_WorkerPark();
+    Exynos_OSAL_SemaphorePost(pStream->hDone);
+
+    return OMX_ErrorNone;
+}
+
+static OMX_BOOL Test_OpenStream(TEST_STREAM *pStream)
+{
+    int i;
+
+    memset(pStream, 0, sizeof(*pStream));
+    if ((Test_OpenDecoder(&pStream->session) != OMX_TRUE) ||
+        (pStream->session.decInOps.Get_ReadyFd(pStream->session.hCodec, &pStream->hSrcFd) != VIDEO_ERROR_NONE) ||
+        (pStream->session.decOutOps.Get_ReadyFd(pStream->session.hCodec, &pStream->hDstFd) != VIDEO_ERROR_NONE) ||
+        (Exynos_OSAL_SemaphoreCreate(&pStream->hDone) != OMX_ErrorNone))
+        return OMX_FALSE;
+
+    /* the header buffer came back, every stream buffer is free */
+    for (i = 0; i < TEST_BUFFERS; i++) {
+        pStream->nQueued++;
+        if (Test_DecodeFrame(&pStream->session, pStream->nQueued, 1000, 0) != VIDEO_ERROR_NONE)
+            return OMX_FALSE;
+    }
+
+    return OMX_TRUE;
+}
+
+static void Test_CloseStream(TEST_STREAM *pStream)
+{
+    Test_CloseSession(&pStream->session, OMX_TRUE);
+    if (pStream->hDone != NULL)
+        Exynos_OSAL_SemaphoreTerminate(pStream->hDone);
+}
+
+static OMX_TICKS Test_CpuTimeUs(struct rusage *pUsage)
+{
+    return ((OMX_TICKS)(pUsage->ru_utime.tv_sec + pUsage->ru_stime.tv_sec) * 1000000) +
+           pUsage->ru_utime.tv_usec + pUsage->ru_stime.tv_usec;
+}
+
+/* not a pass/fail check on the numbers: the hardware clock bounds both, the cost around it differs */
+static void Test_RunSessions(int nSessions, OMX_BOOL bPool)
+{
+    TEST_STREAM     *pStreams = (TEST_STREAM *)calloc(nSessions, sizeof(TEST_STREAM));
+    pthread_t        hThreads[TEST_SCALE_MAX * 2];
+    OMX_HANDLETYPE   hWorkers[TEST_SCALE_MAX * 2];
+    struct rusage    start, end;
+    OMX_TICKS        nStartUs, nElapsedUs;
+    int              nSteps = 0;
+    int              bOpened = 1;
+    int              i;
+
+    TEST_CHECK(pStreams != NULL);
+    if (pStreams == NULL)
+        return;
+
+    for (i = 0; i < nSessions; i++) {
+        if (Test_OpenStream(&pStreams[i]) != OMX_TRUE)
+            bOpened = 0;
+    }
+    TEST_CHECK(bOpened == 1);
+
+    getrusage(RUSAGE_SELF, &start);
+    nStartUs = ExynosTest_GetTimeUs();
+
+    for (i = 0; (i < nSessions) && bOpened; i++) {
+        if (bPool == OMX_TRUE) {
+            TEST_CHECK(Exynos_OSAL_WorkerCreate(&hWorkers[i * 2], Test_FeedStep, &pStreams[i]) == OMX_ErrorNone);
+            TEST_CHECK(Exynos_OSAL_WorkerCreate(&hWorkers[(i * 2) + 1], Test_DrainStep, &pStreams[i]) == OMX_ErrorNone);
+        } else {
+            TEST_CHECK(pthread_create(&hThreads[i * 2], NULL, Test_FeedThread, &pStreams[i]) == 0);
+            TEST_CHECK(pthread_create(&hThreads[(i * 2) + 1], NULL, Test_DrainThread, &pStreams[i]) == 0);
+        }
+    }
+
+    for (i = 0; (i < nSessions) && bOpened; i++) {
+        if (bPool == OMX_TRUE) {
+            Exynos_OSAL_SemaphoreWait(pStreams[i].hDone);
+            Exynos_OSAL_SemaphoreWait(pStreams[i].hDone);
+            Exynos_OSAL_WorkerTerminate(&hWorkers[i * 2]);
+            Exynos_OSAL_WorkerTerminate(&hWorkers[(i * 2) + 1]);
+        } else {
+            pthread_join(hThreads[i * 2], NULL);
+            pthread_join(hThreads[(i * 2) + 1], NULL);
+        }
+    }
+
+    nElapsedUs = ExynosTest_GetTimeUs() - nStartUs;
+    getrusage(RUSAGE_SELF, &end);
+
+    for (i = 0; i < nSessions; i++) {
+        TEST_CHECK(pStreams[i].bError == OMX_FALSE);
+        TEST_CHECK(pStreams[i].nDecoded == TEST_SCALE_FRAMES);
+        nSteps += pStreams[i].nSteps;
+        Test_CloseStream(&pStreams[i]);
+    }
+
+    /* frames of every session go through one hardware, the first ones were queued before the start */
+    TEST_CHECK(nElapsedUs >= ((OMX_TICKS)nSessions * (TEST_SCALE_FRAMES - TEST_BUFFERS) * TEST_FRAME_US));
+
+    printf("  %2d sessions, %s: %.1f fps/session, cpu %lld us, %ld context switches",
+           nSessions, (bPool == OMX_TRUE)? "pool   ":"threads",
+           (double)TEST_SCALE_FRAMES * 1000000 / nElapsedUs,
+           (long long)(Test_CpuTimeUs(&end) - Test_CpuTimeUs(&start)),
+           (end.ru_nvcsw + end.ru_nivcsw) - (start.ru_nvcsw + start.ru_nivcsw));
+    if (bPool == OMX_TRUE)
+        printf(", %d steps", nSteps);
+    printf("\n");
+
+    free(pStreams);
+}
+
+static void Test_SessionScale(void)
+{
+    int nSessions;
+
+    for (nSessions = 1; nSessions <= TEST_SCALE_MAX; nSessions *= 4) {
+        Test_RunSessions(nSessions, OMX_FALSE);
+        Test_RunSessions(nSessions, OMX_TRUE);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    char value[32];
+
+    snprintf(value, sizeof(value), "%dx%d", TEST_WIDTH, TEST_HEIGHT);
+    setenv("EXYNOS_VIDEO_MOCK_SIZE", value, 1);
+    snprintf(value, sizeof(value), "%d", TEST_FRAME_US);
+    setenv("EXYNOS_VIDEO_MOCK_FRAME_US", value, 1);
+
+    TEST_RUN(Test_DecoderHeader);
+    TEST_RUN(Test_DecoderFrames);
+    TEST_RUN(Test_StreamOffWakesDequeue);
+    TEST_RUN(Test_SharedHardware);
+    TEST_RUN(Test_Encoder);
+    TEST_RUN(Test_ReadyFd);
+    TEST_RUN(Test_SessionScale);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_NonRefH264.c
+ * @brief       non-reference frame detection of H.264 on canned bitstreams
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+/* the parser is private to the codec, it is built into the test */
+#include "Exynos_OMX_H264dec.c"
+
+#include "Exynos_OMX_Test.h"
+
+#define TEST_NONREF(pOMXComponent, stream) \
+    Check_H264_NonRefFrame(pOMXComponent, (OMX_U8 *)(stream), sizeof(stream))
+
+static const OMX_U8 gSliceNonRef[] = { 0x00, 0x00, 0x00, 0x01, 0x01, 0x9a, 0x01 };  /* nal_ref_idc 0, non-IDR */
+static const OMX_U8 gSliceRef[]    = { 0x00, 0x00, 0x00, 0x01, 0x41, 0x9a, 0x01 };  /* nal_ref_idc 2, non-IDR */
+static const OMX_U8 gSliceIDR[]    = { 0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84 };
+static const OMX_U8 gAUDNonRef[]   = { 0x00, 0x00, 0x00, 0x01, 0x09, 0xf0,          /* AUD */
+                                       0x00, 0x00, 0x01, 0x06, 0x05, 0x01, 0x80,    /* SEI */
+                                       0x00, 0x00, 0x01, 0x01, 0x9e, 0x02 };
+static const OMX_U8 gSPSOnly[]     = { 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0xc0, 0x1e };
+static const OMX_U8 gTruncated[]   = { 0x00, 0x00, 0x01 };
+
+static void Test_SliceType(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gSliceNonRef) == OMX_TRUE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gSliceRef) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gSliceIDR) == OMX_FALSE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_SkipNonVCL(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+
+    /* the first coded slice decides */
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gAUDNonRef) == OMX_TRUE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gSPSOnly) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTruncated) == OMX_FALSE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_SliceType);
+    TEST_RUN(Test_SkipNonVCL);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,117 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_NonRefHEVC.c
+ * @brief       non-reference frame detection of HEVC on canned bitstreams
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+/* the parser is private to the codec, it is built into the test */
+#include "Exynos_OMX_HEVCdec.c"
+
+#include "Exynos_OMX_Test.h"
+
+#define TEST_NONREF(pOMXComponent, stream) \
+    Check_HEVC_NonRefFrame(pOMXComponent, (OMX_U8 *)(stream), sizeof(stream))
+
+/* nal_unit_type << 1, nuh_temporal_id_plus1 */
+static const OMX_U8 gTrailN_T0[] = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0xaf };
+static const OMX_U8 gTrailR_T0[] = { 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0xaf };
+static const OMX_U8 gTrailR_T2[] = { 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0xaf };
+static const OMX_U8 gTrailN_T2[] = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x03, 0xaf };
+static const OMX_U8 gRadlR_T0[]  = { 0x00, 0x00, 0x00, 0x01, 0x0e, 0x01, 0xaf };
+static const OMX_U8 gIDR[]       = { 0x00, 0x00, 0x00, 0x01, 0x26, 0x01, 0xaf };
+static const OMX_U8 gVPSTrailN[] = { 0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 0x0c,    /* VPS */
+                                     0x00, 0x00, 0x01, 0x00, 0x01, 0xaf };
+
+static EXYNOS_HEVCDEC_HANDLE   gHevcDec;
+static ExynosVideoDecBufferOps gInbufOps;
+
+static ExynosVideoErrorType Test_Stop(void *pHandle)
+{
+    return VIDEO_ERROR_NONE;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    memset(&gHevcDec, 0, sizeof(gHevcDec));
+    memset(&gInbufOps, 0, sizeof(gInbufOps));
+
+    gInbufOps.Stop                      = &Test_Stop;
+    gHevcDec.hMFCHevcHandle.pInbufOps   = &gInbufOps;
+    pVideoDec->hCodecHandle             = (OMX_HANDLETYPE)&gHevcDec;
+
+    return pOMXComponent;
+}
+
+static void Test_SingleLayer(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailN_T0) == OMX_TRUE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailR_T0) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gRadlR_T0) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gIDR) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gVPSTrailN) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_TemporalLayers(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailR_T2) == OMX_FALSE);
+    TEST_CHECK(gHevcDec.nMaxTemporalId == 2);
+
+    /* a sub-layer non-reference picture can still be referred by higher sub-layers */
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailN_T0) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailN_T2) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_FlushResetsLayers(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = Test_CreateDecoder();
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailR_T2) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailN_T0) == OMX_FALSE);
+
+    /* the stream restarts with a single layer after a seek */
+    TEST_CHECK(HevcCodecStop(pOMXComponent, INPUT_PORT_INDEX) == OMX_ErrorNone);
+    TEST_CHECK(gHevcDec.nMaxTemporalId == 0);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTrailN_T0) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_SingleLayer);
+    TEST_RUN(Test_TemporalLayers);
+    TEST_RUN(Test_FlushResetsLayers);
+
+    return TEST_RESULT();
+}
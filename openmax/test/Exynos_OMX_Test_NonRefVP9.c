@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_NonRefVP9.c
+ * @brief       non-reference frame detection of VP9 on canned bitstreams
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+/* the parser is private to the codec, it is built into the test */
+#include "Exynos_OMX_Vp9dec.c"
+
+#include "Exynos_OMX_Test.h"
+
+#define TEST_NONREF(pOMXComponent, stream) \
+    Check_VP9_NonRefFrame(pOMXComponent, (OMX_U8 *)(stream), sizeof(stream))
+
+/* frame_marker, profile, show_existing_frame, frame_type, show_frame, error_resilient_mode, ... */
+static const OMX_U8 gInterNoRefresh[]  = { 0x86, 0x00, 0x00, 0x00 };
+static const OMX_U8 gInterRefresh[]    = { 0x86, 0x04, 0x00, 0x00 };  /* refresh_frame_flags 0x10 */
+static const OMX_U8 gInterRefreshLsb[] = { 0x86, 0x00, 0x40, 0x00 };  /* refresh_frame_flags 0x01 */
+static const OMX_U8 gErrResNoRefresh[] = { 0x87, 0x00, 0x00, 0x00 };
+static const OMX_U8 gErrResRefresh[]   = { 0x87, 0x01, 0x00, 0x00 };  /* refresh_frame_flags 0x01 */
+static const OMX_U8 gKeyFrame[]        = { 0x82, 0x49, 0x83, 0x42 };
+static const OMX_U8 gHiddenFrame[]     = { 0x84, 0x00, 0x00, 0x00 };
+static const OMX_U8 gShowExisting[]    = { 0x88, 0x00, 0x00, 0x00 };
+static const OMX_U8 gProfile3[]        = { 0xb3, 0x00, 0x00, 0x00 };  /* profile 3 has a reserved_zero bit */
+static const OMX_U8 gNoMarker[]        = { 0x06, 0x00, 0x00, 0x00 };
+static const OMX_U8 gTruncated[]       = { 0x86, 0x00 };
+
+static void Test_InterFrame(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gInterNoRefresh) == OMX_TRUE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gInterRefresh) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gInterRefreshLsb) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gErrResNoRefresh) == OMX_TRUE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gErrResRefresh) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gProfile3) == OMX_TRUE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_AlwaysKept(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gKeyFrame) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gHiddenFrame) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gShowExisting) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gNoMarker) == OMX_FALSE);
+    TEST_CHECK(TEST_NONREF(pOMXComponent, gTruncated) == OMX_FALSE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_InterFrame);
+    TEST_RUN(Test_AlwaysKept);
+
+    return TEST_RESULT();
+}
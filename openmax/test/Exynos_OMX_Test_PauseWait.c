@@ -0,0 +1,345 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_PauseWait.c
+ * @brief       the four buffer process threads of the decoder sleeping on hStateCondition
+ *              while paused or flushing, with the wake latency of a state change
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OSAL_Event.h"
+
+#define TEST_THREAD_NUM         4
+#define TEST_PAUSE_US           200000
+#define TEST_PAUSE_CPU_US       20000   /* a spinning thread alone takes the whole pause */
+#define TEST_ROUNDS             2000
+#define TEST_ROUND_TIMEOUT_US   1000000
+
+typedef struct _TEST_WAITER
+{
+    OMX_COMPONENTTYPE   *pOMXComponent;
+    OMX_U32              nPortIndex;
+    OMX_BOOL             bFlush;
+    OMX_TICKS            nMaxUs;
+    OMX_TICKS            nSumUs;
+} TEST_WAITER;
+
+static volatile OMX_TICKS   gWakeTime;
+static volatile int         gRound;
+static volatile int         gArrived;
+static volatile int         gWoken;
+static volatile int         gExited;
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OSAL_ConditionCreate(&pExynosComponent->hStateCondition);
+    pExynosComponent->currentState = OMX_StatePause;
+
+    return pOMXComponent;
+}
+
+static void Test_DestroyDecoder(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    Exynos_OSAL_ConditionTerminate(pExynosComponent->hStateCondition);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static OMX_TICKS Test_GetCpuTimeUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((OMX_TICKS)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static OMX_BOOL Test_WaitCount(volatile int *pCount, int nExpected)
+{
+    OMX_TICKS nStart = ExynosTest_GetTimeUs();
+
+    while (__atomic_load_n(pCount, __ATOMIC_ACQUIRE) < nExpected) {
+        if ((ExynosTest_GetTimeUs() - nStart) > TEST_ROUND_TIMEOUT_US)
+            return OMX_FALSE;
+        usleep(100);
+    }
+
+    return OMX_TRUE;
+}
+
+static void *Test_SrcInputThread(void *pArg)
+{
+    Exynos_OMX_SrcInputBufferProcess((OMX_HANDLETYPE)pArg);
+    __atomic_add_fetch(&gExited, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+static void *Test_SrcOutputThread(void *pArg)
+{
+    Exynos_OMX_SrcOutputBufferProcess((OMX_HANDLETYPE)pArg);
+    __atomic_add_fetch(&gExited, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+static void *Test_DstInputThread(void *pArg)
+{
+    Exynos_OMX_DstInputBufferProcess((OMX_HANDLETYPE)pArg);
+    __atomic_add_fetch(&gExited, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+static void *Test_DstOutputThread(void *pArg)
+{
+    Exynos_OMX_DstOutputBufferProcess((OMX_HANDLETYPE)pArg);
+    __atomic_add_fetch(&gExited, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+/* none of the four buffer process threads may spin while the component is paused or the ports are flushed */
+static void Test_ThreadsSleep(OMX_BOOL bFlush)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    void                          *(*threadFunc[TEST_THREAD_NUM])(void *) = {
+                                        Test_SrcInputThread, Test_SrcOutputThread, Test_DstInputThread, Test_DstOutputThread };
+    pthread_t                        thread[TEST_THREAD_NUM];
+    OMX_TICKS                        nCpuUs;
+    OMX_TICKS                        nExitUs;
+    int                              i;
+
+    if (bFlush == OMX_TRUE) {
+        /* the flush itself runs on the component thread, the buffer threads only have to stay out of it */
+        pExynosComponent->currentState                             = OMX_StateExecuting;
+        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].portState  = EXYNOS_OMX_PortStateFlushing;
+        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portState = EXYNOS_OMX_PortStateFlushing;
+    }
+
+    gExited = 0;
+    for (i = 0; i < TEST_THREAD_NUM; i++)
+        pthread_create(&thread[i], NULL, threadFunc[i], pOMXComponent);
+
+    usleep(10000);
+    nCpuUs = Test_GetCpuTimeUs();
+    usleep(TEST_PAUSE_US);
+    nCpuUs = Test_GetCpuTimeUs() - nCpuUs;
+
+    printf("  %d threads %s for %d ms: %lld us of cpu\n", TEST_THREAD_NUM, (bFlush == OMX_TRUE)? "flushing":"paused",
+           TEST_PAUSE_US / 1000, (long long)nCpuUs);
+    TEST_CHECK(nCpuUs < TEST_PAUSE_CPU_US);
+    TEST_CHECK(gExited == 0);
+
+    nExitUs = ExynosTest_GetTimeUs();
+    pVideoDec->bExitBufferProcessThread = OMX_TRUE;
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
+    TEST_CHECK(Test_WaitCount(&gExited, TEST_THREAD_NUM) == OMX_TRUE);
+    nExitUs = ExynosTest_GetTimeUs() - nExitUs;
+    printf("  all threads out %lld us after the exit notify\n", (long long)nExitUs);
+
+    if (gExited == TEST_THREAD_NUM) {
+        for (i = 0; i < TEST_THREAD_NUM; i++)
+            pthread_join(thread[i], NULL);
+    }
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_PausedThreadsSleep(void)
+{
+    Test_ThreadsSleep(OMX_FALSE);
+}
+
+static void Test_FlushedThreadsSleep(void)
+{
+    Test_ThreadsSleep(OMX_TRUE);
+}
+
+static void *Test_WaiterThread(void *pArg)
+{
+    TEST_WAITER                     *pWaiter            = (TEST_WAITER *)pArg;
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pWaiter->pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    OMX_TICKS                        nLatency;
+    int                              nRound;
+
+    for (nRound = 0; nRound < TEST_ROUNDS; nRound++) {
+        while ((__atomic_load_n(&gRound, __ATOMIC_ACQUIRE) < nRound) &&
+               (pVideoDec->bExitBufferProcessThread == OMX_FALSE))
+            usleep(50);
+
+        if (pVideoDec->bExitBufferProcessThread == OMX_TRUE)
+            break;
+
+        __atomic_add_fetch(&gArrived, 1, __ATOMIC_ACQ_REL);
+        if (pWaiter->bFlush == OMX_TRUE)
+            Exynos_OMX_BufferProcess_Yield(pExynosComponent, pWaiter->nPortIndex);
+        else
+            Exynos_Wait_ProcessPause(pExynosComponent, pWaiter->nPortIndex);
+
+        nLatency = ExynosTest_GetTimeUs() - gWakeTime;
+        pWaiter->nSumUs += nLatency;
+        if (nLatency > pWaiter->nMaxUs)
+            pWaiter->nMaxUs = nLatency;
+
+        __atomic_add_fetch(&gWoken, 1, __ATOMIC_ACQ_REL);
+    }
+
+    return NULL;
+}
+
+/* the port flush ends as Exynos_OMX_BufferFlush() does it: port state first, then the notify */
+static void Test_SetFlushing(EXYNOS_OMX_BASECOMPONENT *pExynosComponent, OMX_BOOL bFlushing)
+{
+    EXYNOS_OMX_PORT_STATETYPE ePortState = (bFlushing == OMX_TRUE)? EXYNOS_OMX_PortStateFlushing:EXYNOS_OMX_PortStateIdle;
+
+    pExynosComponent->pExynosPort[INPUT_PORT_INDEX].portState  = ePortState;
+    pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portState = ePortState;
+}
+
+/* every kind of wake reaches all waiters of both ports, none is lost */
+static void Test_WakeRounds(OMX_BOOL bFlush)
+{
+    OMX_COMPONENTTYPE               *pOMXComponent      = Test_CreateDecoder();
+    EXYNOS_OMX_BASECOMPONENT        *pExynosComponent   = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT   *pVideoDec          = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    TEST_WAITER                      waiter[TEST_THREAD_NUM];
+    pthread_t                        thread[TEST_THREAD_NUM];
+    OMX_TICKS                        nSumUs             = 0;
+    OMX_TICKS                        nMaxUs             = 0;
+    int                              nLost              = 0;
+    int                              nRound;
+    int                              i;
+
+    memset(waiter, 0, sizeof(waiter));
+    gRound   = 0;
+    gArrived = 0;
+    gWoken   = 0;
+
+    if (bFlush == OMX_TRUE) {
+        pExynosComponent->currentState = OMX_StateExecuting;
+        Test_SetFlushing(pExynosComponent, OMX_TRUE);
+    }
+
+    for (i = 0; i < TEST_THREAD_NUM; i++) {
+        waiter[i].pOMXComponent = pOMXComponent;
+        waiter[i].nPortIndex    = (i < (TEST_THREAD_NUM / 2))? INPUT_PORT_INDEX:OUTPUT_PORT_INDEX;
+        waiter[i].bFlush        = bFlush;
+        pthread_create(&thread[i], NULL, Test_WaiterThread, &waiter[i]);
+    }
+
+    for (nRound = 0; nRound < TEST_ROUNDS; nRound++) {
+        /* all of them are about to sleep, give them the time to get there */
+        if (Test_WaitCount(&gArrived, (nRound + 1) * TEST_THREAD_NUM) == OMX_FALSE) {
+            nLost++;
+            break;
+        }
+        usleep(200);
+
+        gWakeTime = ExynosTest_GetTimeUs();
+        if (bFlush == OMX_TRUE) {
+            Test_SetFlushing(pExynosComponent, OMX_FALSE);
+            Exynos_OMX_NotifyStateChange(pExynosComponent);
+
+            if (Test_WaitCount(&gWoken, (nRound + 1) * TEST_THREAD_NUM) == OMX_FALSE) {
+                nLost++;
+                break;
+            }
+
+            Test_SetFlushing(pExynosComponent, OMX_TRUE);
+            __atomic_add_fetch(&gRound, 1, __ATOMIC_ACQ_REL);
+            continue;
+        }
+
+        switch (nRound % 3) {
+        case 0:
+            pExynosComponent->currentState = OMX_StateExecuting;
+            break;
+        case 1:
+            pExynosComponent->transientState = EXYNOS_OMX_TransStateIdleToLoaded;
+            break;
+        default:
+            pExynosComponent->pExynosPort[INPUT_PORT_INDEX].portState  = EXYNOS_OMX_PortStateFlushing;
+            pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portState = EXYNOS_OMX_PortStateFlushing;
+            break;
+        }
+        Exynos_OMX_NotifyStateChange(pExynosComponent);
+
+        if (Test_WaitCount(&gWoken, (nRound + 1) * TEST_THREAD_NUM) == OMX_FALSE) {
+            nLost++;
+            break;
+        }
+
+        /* paused again for the next round */
+        pExynosComponent->currentState                             = OMX_StatePause;
+        pExynosComponent->transientState                           = EXYNOS_OMX_TransStateMax;
+        pExynosComponent->pExynosPort[INPUT_PORT_INDEX].portState  = EXYNOS_OMX_PortStateIdle;
+        pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].portState = EXYNOS_OMX_PortStateIdle;
+        __atomic_add_fetch(&gRound, 1, __ATOMIC_ACQ_REL);
+    }
+    TEST_CHECK(nLost == 0);
+
+    pVideoDec->bExitBufferProcessThread = OMX_TRUE;
+    Exynos_OMX_NotifyStateChange(pExynosComponent);
+    for (i = 0; i < TEST_THREAD_NUM; i++) {
+        pthread_join(thread[i], NULL);
+        nSumUs += waiter[i].nSumUs;
+        if (waiter[i].nMaxUs > nMaxUs)
+            nMaxUs = waiter[i].nMaxUs;
+    }
+
+    printf("  %d rounds x %d %s waiters: wake latency avg %lld us, max %lld us\n", nRound, TEST_THREAD_NUM,
+           (bFlush == OMX_TRUE)? "flushing":"paused",
+           (long long)((nRound > 0)? (nSumUs / (nRound * TEST_THREAD_NUM)):0), (long long)nMaxUs);
+
+    Test_DestroyDecoder(pOMXComponent);
+}
+
+static void Test_WakeLatency(void)
+{
+    Test_WakeRounds(OMX_FALSE);
+}
+
+static void Test_FlushWakeLatency(void)
+{
+    Test_WakeRounds(OMX_TRUE);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_PausedThreadsSleep);
+    TEST_RUN(Test_FlushedThreadsSleep);
+    TEST_RUN(Test_WakeLatency);
+    TEST_RUN(Test_FlushWakeLatency);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,299 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_SecurePool.c
+ * @brief       the secure pool of Exynos_OSAL_SharedMemory.c on a memfd backed stand-in heap
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include <hardware/exynos/ion.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OSAL_SharedMemory.h"
+#include "Exynos_OSAL_MemPressure.h"
+
+#define TEST_POOL_MB        8
+#define TEST_BUFFER_SIZE    ((3 * 1024 * 1024) / 2)     /* MAX_SECURE_INPUT_BUFFER_SIZE */
+#define TEST_BUFFER_NUM     3                           /* input buffers of a secure session */
+#define TEST_RESERVE_NUM    ((TEST_POOL_MB << 20) / TEST_BUFFER_SIZE)
+#define TEST_HEAP_DELAY_US  2000                        /* what a protected allocation costs */
+#define TEST_HOLD_MS        200
+#define TEST_WAIT_MS        (MEMPRESSURE_POLL_MS * 3)
+
+/* "debug.omx.psi.path" on android */
+#define TEST_PSI_PATH       "/data/local/tmp/exynos_omx_psi"
+
+static char gPsiPath[256];
+static int  gIonAllocCount  = 0;
+static int  gSealProtected  = 0;    /* protected buffers can not be written by the CPU, as on a device */
+
+/* the stand-in heap: every buffer is a memfd */
+int exynos_ion_open(void)
+{
+    return 0;
+}
+
+int exynos_ion_close(int fd)
+{
+    return 0;
+}
+
+int exynos_ion_alloc(int fd, size_t len, unsigned int heap_mask, unsigned int flags)
+{
+    int nBuffer = memfd_create("exynos_omx_test_ion", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+
+    if (nBuffer < 0)
+        return -1;
+
+    if (ftruncate(nBuffer, (off_t)len) != 0) {
+        close(nBuffer);
+        return -1;
+    }
+
+    if (gSealProtected && (flags & ION_FLAG_PROTECTED))
+        fcntl(nBuffer, F_ADD_SEALS, F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW);
+
+    usleep(TEST_HEAP_DELAY_US);
+    gIonAllocCount++;
+
+    return nBuffer;
+}
+
+static void Test_WritePsi(const char *pAvg10)
+{
+    FILE *fp = fopen(gPsiPath, "w");
+
+    if (fp == NULL)
+        return;
+
+    fprintf(fp, "some avg10=%s avg60=0.00 avg300=0.00 total=0\n", pAvg10);
+    fprintf(fp, "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+    fclose(fp);
+}
+
+/* the handle of a protected buffer is its fd */
+static int Test_Fd(OMX_PTR pBuffer)
+{
+    return (int)(long)pBuffer;
+}
+
+static OMX_BOOL Test_IsFilledWith(int fd, unsigned char value)
+{
+    unsigned char  *pData   = NULL;
+    OMX_BOOL        bFilled = OMX_TRUE;
+    int             i;
+
+    pData = (unsigned char *)mmap(NULL, TEST_BUFFER_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    if (pData == MAP_FAILED)
+        return OMX_FALSE;
+
+    for (i = 0; i < TEST_BUFFER_SIZE; i++) {
+        if (pData[i] != value) {
+            bFilled = OMX_FALSE;
+            break;
+        }
+    }
+    munmap(pData, TEST_BUFFER_SIZE);
+
+    return bFilled;
+}
+
+static OMX_TICKS Test_StartSession(OMX_HANDLETYPE hSession, OMX_PTR pBuffers[TEST_BUFFER_NUM])
+{
+    OMX_TICKS   nStart = ExynosTest_GetTimeUs();
+    int         i;
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        pBuffers[i] = Exynos_OSAL_SharedMemory_Alloc(hSession, TEST_BUFFER_SIZE, SECURE_MEMORY);
+
+    return ExynosTest_GetTimeUs() - nStart;
+}
+
+/* a mappable heap: the budget is reserved by the first session and cleared buffers go to the next one */
+static void Test_ReservedAndScrubbed(void)
+{
+    OMX_HANDLETYPE  hFirst      = Exynos_OSAL_SharedMemory_Open();
+    OMX_HANDLETYPE  hSecond     = Exynos_OSAL_SharedMemory_Open();
+    OMX_PTR         pFirst[TEST_BUFFER_NUM];
+    OMX_PTR         pSecond[TEST_BUFFER_NUM];
+    unsigned char  *pData       = NULL;
+    OMX_TICKS       nHeapUs     = 0;
+    OMX_TICKS       nPoolUs     = 0;
+    int             i, j;
+
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() == 0);
+
+    Test_StartSession(hFirst, pFirst);
+    TEST_CHECK(gIonAllocCount == TEST_RESERVE_NUM);
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() == ((OMX_U64)(TEST_RESERVE_NUM - TEST_BUFFER_NUM) * TEST_BUFFER_SIZE));
+
+    /* what the first owner leaves behind */
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        pData = (unsigned char *)mmap(NULL, TEST_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, Test_Fd(pFirst[i]), 0);
+        TEST_CHECK(pData != MAP_FAILED);
+        if (pData != MAP_FAILED) {
+            memset(pData, 0xA5, TEST_BUFFER_SIZE);
+            munmap(pData, TEST_BUFFER_SIZE);
+        }
+    }
+    Exynos_OSAL_SharedMemory_Close(hFirst);
+    TEST_CHECK(gIonAllocCount == TEST_RESERVE_NUM);
+
+    /* the second session starts from the pool only */
+    nPoolUs = Test_StartSession(hSecond, pSecond);
+    TEST_CHECK(gIonAllocCount == TEST_RESERVE_NUM);
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        TEST_CHECK(pSecond[i] != NULL);
+        TEST_CHECK(Test_IsFilledWith(Test_Fd(pSecond[i]), 0x00) == OMX_TRUE);
+    }
+
+    /* the same start straight from the heap */
+    nHeapUs = ExynosTest_GetTimeUs();
+    for (i = 0; i < TEST_BUFFER_NUM; i++)
+        close(exynos_ion_alloc(0, TEST_BUFFER_SIZE, EXYNOS_ION_HEAP_VIDEO_STREAM_MASK, ION_FLAG_PROTECTED));
+    nHeapUs = ExynosTest_GetTimeUs() - nHeapUs;
+    gIonAllocCount -= TEST_BUFFER_NUM;
+
+    printf("  %d secure input buffers: heap %lld us, pool %lld us\n", TEST_BUFFER_NUM, (long long)nHeapUs, (long long)nPoolUs);
+    TEST_CHECK(nPoolUs < nHeapUs);
+
+    Exynos_OSAL_SharedMemory_Close(hSecond);
+}
+
+/* a stall empties the pool from the monitor thread, without any buffer being released */
+static void Test_PressureDrains(void)
+{
+    OMX_TICKS nEnd;
+
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() > 0);
+
+    Test_WritePsi("40.00");
+    nEnd = ExynosTest_GetTimeUs() + ((OMX_TICKS)TEST_WAIT_MS * 1000);
+    while ((Exynos_OSAL_SharedMemory_GetSecurePoolBytes() > 0) &&
+           (ExynosTest_GetTimeUs() < nEnd))
+        usleep(10 * 1000);
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() == 0);
+
+    Test_WritePsi("0.00");
+    nEnd = ExynosTest_GetTimeUs() + ((OMX_TICKS)(TEST_WAIT_MS + TEST_HOLD_MS) * 1000);
+    while ((Exynos_OSAL_MemPressure_Get() == OMX_TRUE) &&
+           (ExynosTest_GetTimeUs() < nEnd))
+        usleep(10 * 1000);
+    TEST_CHECK(Exynos_OSAL_MemPressure_Get() == OMX_FALSE);
+}
+
+/* protected memory can not be cleared, it only goes back to its owner and is replaced when the owner closes */
+static void Test_ProtectedStaysWithOwner(void)
+{
+    OMX_HANDLETYPE  hOwner      = Exynos_OSAL_SharedMemory_Open();
+    OMX_HANDLETYPE  hOther      = Exynos_OSAL_SharedMemory_Open();
+    OMX_PTR         pOwned      = NULL;
+    OMX_PTR         pOthers[TEST_RESERVE_NUM];
+    int             nOwnedFd    = -1;
+    int             nAllocCount = 0;
+    int             i;
+
+    gSealProtected = 1;
+    gIonAllocCount = 0;
+
+    /* reserved again after the pressure */
+    pOwned = Exynos_OSAL_SharedMemory_Alloc(hOwner, TEST_BUFFER_SIZE, SECURE_MEMORY);
+    TEST_CHECK(gIonAllocCount == TEST_RESERVE_NUM);
+    nOwnedFd = Test_Fd(pOwned);
+    Exynos_OSAL_SharedMemory_Free(hOwner, pOwned);
+
+    /* the other session gets every clean buffer, then the heap */
+    for (i = 0; i < TEST_RESERVE_NUM; i++) {
+        pOthers[i] = Exynos_OSAL_SharedMemory_Alloc(hOther, TEST_BUFFER_SIZE, SECURE_MEMORY);
+        TEST_CHECK(Test_Fd(pOthers[i]) != nOwnedFd);
+    }
+    TEST_CHECK(gIonAllocCount == (TEST_RESERVE_NUM + 1));
+
+    /* a reconfiguration of the owner */
+    pOwned = Exynos_OSAL_SharedMemory_Alloc(hOwner, TEST_BUFFER_SIZE, SECURE_MEMORY);
+    TEST_CHECK(Test_Fd(pOwned) == nOwnedFd);
+    TEST_CHECK(gIonAllocCount == (TEST_RESERVE_NUM + 1));
+    Exynos_OSAL_SharedMemory_Free(hOwner, pOwned);
+
+    /* closing puts a fresh buffer in its place, which anyone may take */
+    nAllocCount = gIonAllocCount;
+    Exynos_OSAL_SharedMemory_Close(hOwner);
+    TEST_CHECK(gIonAllocCount == (nAllocCount + 1));
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() == TEST_BUFFER_SIZE);
+
+    Exynos_OSAL_SharedMemory_Free(hOther, pOthers[0]);
+    pOthers[0] = Exynos_OSAL_SharedMemory_Alloc(hOther, TEST_BUFFER_SIZE, SECURE_MEMORY);
+    pOwned     = Exynos_OSAL_SharedMemory_Alloc(hOther, TEST_BUFFER_SIZE, SECURE_MEMORY);
+    TEST_CHECK(pOthers[0] != NULL);
+    TEST_CHECK(pOwned != NULL);
+    TEST_CHECK(gIonAllocCount == (nAllocCount + 1));
+
+    /* the budget is refilled with fresh buffers */
+    Exynos_OSAL_SharedMemory_Close(hOther);
+    TEST_CHECK(Exynos_OSAL_SharedMemory_GetSecurePoolBytes() == ((OMX_U64)TEST_RESERVE_NUM * TEST_BUFFER_SIZE));
+    TEST_CHECK(gIonAllocCount == (nAllocCount + 1 + TEST_RESERVE_NUM));
+
+    gSealProtected = 0;
+}
+
+int main(int argc, char **argv)
+{
+    char poolMB[16];
+    char holdMs[16];
+
+    snprintf(poolMB, sizeof(poolMB), "%d", TEST_POOL_MB);
+    snprintf(holdMs, sizeof(holdMs), "%d", TEST_HOLD_MS);
+#ifdef USE_ANDROID
+    snprintf(gPsiPath, sizeof(gPsiPath), "%s", TEST_PSI_PATH);
+    property_set("debug.omx.secure.pool", poolMB);
+    property_set("debug.omx.psi.path", gPsiPath);
+    property_set("debug.omx.psi.hold", holdMs);
+#else
+    snprintf(gPsiPath, sizeof(gPsiPath), "/tmp/exynos_omx_psi.%d", (int)getpid());
+    setenv("EXYNOS_OMX_SECURE_POOL", poolMB, 1);
+    setenv("EXYNOS_OMX_PSI_PATH", gPsiPath, 1);
+    setenv("EXYNOS_OMX_PSI_HOLD", holdMs, 1);
+#endif
+    Test_WritePsi("0.00");
+
+    /* in order, they share the pool of the process */
+    TEST_RUN(Test_ReservedAndScrubbed);
+    TEST_RUN(Test_PressureDrains);
+    TEST_RUN(Test_ProtectedStaysWithOwner);
+
+    unlink(gPsiPath);
+
+    return TEST_RESULT();
+}
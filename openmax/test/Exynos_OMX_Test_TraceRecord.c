@@ -0,0 +1,184 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_TraceRecord.c
+ * @brief       parameter structures are recorded without addresses of the recording process
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef USE_ANDROID
+#include <cutils/properties.h>
+#endif
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Vdec.h"
+#include "Exynos_OSAL_Trace.h"
+
+#define TEST_ROI_MB_SIZE    64
+
+static char gTraceDir[64];
+
+static OMX_ERRORTYPE Test_SetParameter(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pParams)
+{
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_SetConfig(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pConfigs)
+{
+    return OMX_ErrorNone;
+}
+
+static void Test_EnableTrace(void)
+{
+#ifdef USE_ANDROID
+    snprintf(gTraceDir, sizeof(gTraceDir), "/data/local/tmp/omx_trace_test_%d", (int)getpid());
+    mkdir(gTraceDir, 0700);
+
+    property_set("debug.omx.trace", "2");
+    property_set("debug.omx.trace.dir", gTraceDir);
+#else
+    snprintf(gTraceDir, sizeof(gTraceDir), "/tmp/omx_trace_test_%d", (int)getpid());
+    mkdir(gTraceDir, 0700);
+
+    setenv("EXYNOS_OMX_TRACE", "2", 1);
+    setenv("EXYNOS_OMX_TRACE_DIR", gTraceDir, 1);
+#endif
+}
+
+static void Test_DisableTrace(void)
+{
+#ifdef USE_ANDROID
+    property_set("debug.omx.trace", "0");
+#else
+    unsetenv("EXYNOS_OMX_TRACE");
+#endif
+    rmdir(gTraceDir);
+}
+
+static void Test_PortDefAndRoiInfo(void)
+{
+    OMX_COMPONENTTYPE                   *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT            *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_PARAM_PORTDEFINITIONTYPE         portDef;
+    EXYNOS_OMX_VIDEO_CONFIG_ROIINFO      roiInfo;
+    OMX_U8                               roiMBInfo[TEST_ROI_MB_SIZE];
+    char                                 mimeType[] = "video/avc";
+    EXYNOS_OSAL_TRACE_FILE_HEADER        header;
+    EXYNOS_OSAL_TRACE_RECORD             record;
+    OMX_HANDLETYPE                       hReader  = NULL;
+    OMX_PTR                              pPayload = NULL;
+    char                                 path[128];
+    int                                  i;
+
+    pOMXComponent->SetParameter = &Test_SetParameter;
+    pOMXComponent->SetConfig    = &Test_SetConfig;
+
+    Test_EnableTrace();
+    TEST_CHECK(Exynos_OMX_TraceAttach((OMX_HANDLETYPE)pOMXComponent, "OMX.Exynos.Test") == OMX_ErrorNone);
+    TEST_CHECK(pExynosComponent->hTrace != NULL);
+    if (pExynosComponent->hTrace == NULL)
+        goto EXIT;
+
+    memset(&portDef, 0, sizeof(portDef));
+    INIT_SET_SIZE_VERSION(&portDef, OMX_PARAM_PORTDEFINITIONTYPE);
+    portDef.nPortIndex                  = INPUT_PORT_INDEX;
+    portDef.nBufferCountActual          = 4;
+    portDef.eDomain                     = OMX_PortDomainVideo;
+    portDef.format.video.cMIMEType      = mimeType;
+    portDef.format.video.pNativeWindow  = (OMX_PTR)&portDef;
+    portDef.format.video.nFrameWidth    = 1920;
+    portDef.format.video.nFrameHeight   = 1080;
+    pOMXComponent->SetParameter((OMX_HANDLETYPE)pOMXComponent, OMX_IndexParamPortDefinition, &portDef);
+
+    for (i = 0; i < TEST_ROI_MB_SIZE; i++)
+        roiMBInfo[i] = (OMX_U8)i;
+
+    memset(&roiInfo, 0, sizeof(roiInfo));
+    INIT_SET_SIZE_VERSION(&roiInfo, EXYNOS_OMX_VIDEO_CONFIG_ROIINFO);
+    roiInfo.nPortIndex     = INPUT_PORT_INDEX;
+    roiInfo.bUseRoiInfo    = OMX_TRUE;
+    roiInfo.nRoiMBInfoSize = TEST_ROI_MB_SIZE;
+    roiInfo.pRoiMBInfo     = roiMBInfo;
+    pOMXComponent->SetConfig((OMX_HANDLETYPE)pOMXComponent, (OMX_INDEXTYPE)OMX_IndexConfigVideoRoiInfo, &roiInfo);
+
+    /* a native buffer can not be replayed at all */
+    pOMXComponent->SetParameter((OMX_HANDLETYPE)pOMXComponent, (OMX_INDEXTYPE)OMX_IndexParamUseAndroidNativeBuffer2, &portDef);
+
+    Exynos_OSAL_TraceTerminate(&pExynosComponent->hTrace);
+
+    snprintf(path, sizeof(path), "%s/omx_trace_%d_%p.bin", gTraceDir, (int)getpid(), (void *)pExynosComponent);
+    TEST_CHECK(Exynos_OSAL_TraceReaderOpen(&hReader, path, &header) == OMX_ErrorNone);
+    if (hReader == NULL)
+        goto EXIT;
+
+    /* the caller's structure is left as it was */
+    TEST_CHECK(portDef.format.video.cMIMEType == mimeType);
+    TEST_CHECK(roiInfo.pRoiMBInfo == roiMBInfo);
+
+    TEST_CHECK(Exynos_OSAL_TraceReaderNext(hReader, &record, &pPayload) == OMX_ErrorNone);
+    TEST_CHECK(record.eType == TRACE_CALL_SET_PARAMETER);
+    TEST_CHECK(record.nDataLen == sizeof(OMX_PARAM_PORTDEFINITIONTYPE));
+    if (pPayload != NULL) {
+        OMX_PARAM_PORTDEFINITIONTYPE *pRecorded = (OMX_PARAM_PORTDEFINITIONTYPE *)pPayload;
+
+        TEST_CHECK(pRecorded->format.video.cMIMEType == NULL);
+        TEST_CHECK(pRecorded->format.video.pNativeWindow == NULL);
+        TEST_CHECK(pRecorded->format.video.nFrameWidth == 1920);
+        TEST_CHECK(pRecorded->nBufferCountActual == 4);
+    }
+
+    TEST_CHECK(Exynos_OSAL_TraceReaderNext(hReader, &record, &pPayload) == OMX_ErrorNone);
+    TEST_CHECK(record.eType == TRACE_CALL_SET_CONFIG);
+    TEST_CHECK(record.nDataLen == sizeof(EXYNOS_OMX_VIDEO_CONFIG_ROIINFO) + TEST_ROI_MB_SIZE);
+    if (pPayload != NULL) {
+        EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *pRecorded = (EXYNOS_OMX_VIDEO_CONFIG_ROIINFO *)pPayload;
+
+        TEST_CHECK(pRecorded->pRoiMBInfo == NULL);
+        TEST_CHECK(pRecorded->nRoiMBInfoSize == TEST_ROI_MB_SIZE);
+        TEST_CHECK(memcmp((OMX_U8 *)pPayload + sizeof(EXYNOS_OMX_VIDEO_CONFIG_ROIINFO), roiMBInfo, TEST_ROI_MB_SIZE) == 0);
+    }
+
+    TEST_CHECK(Exynos_OSAL_TraceReaderNext(hReader, &record, &pPayload) == OMX_ErrorNone);
+    TEST_CHECK(record.nIndex == (OMX_U32)OMX_IndexParamUseAndroidNativeBuffer2);
+    TEST_CHECK((record.nPayloadLen == 0) && (pPayload == NULL));
+
+    TEST_CHECK(Exynos_OSAL_TraceReaderNext(hReader, &record, &pPayload) != OMX_ErrorNone);
+
+    Exynos_OSAL_TraceReaderClose(&hReader);
+    unlink(path);
+
+EXIT:
+    Test_DisableTrace();
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_PortDefAndRoiInfo);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,329 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_Tunnel.c
+ * @brief       frames of a supplier output port going to the tunnel peer and
+ *              the decoder output switching to the tunnel buffers at the request,
+ *              built with TUNNELING_SUPPORT only
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Baseport.h"
+#include "Exynos_OSAL_Mutex.h"
+#include "Exynos_OSAL_Semaphore.h"
+#include "Exynos_OSAL_Queue.h"
+#include "Exynos_OSAL_Memory.h"
+#include "Exynos_OSAL_ETC.h"
+#include "Exynos_OMX_VdecControl.h"
+
+#define TEST_BUFFER_NUM     4
+
+static OMX_U8                   gFrame[64];
+static OMX_BUFFERHEADERTYPE     gHeader[TEST_BUFFER_NUM];
+static OMX_BUFFERHEADERTYPE     gPeerHeader[TEST_BUFFER_NUM];
+static EXYNOS_OMX_TUNNEL_BUFFER gTunnelBuffer[TEST_BUFFER_NUM];
+
+static OMX_COMPONENTTYPE        gPeer;
+static OMX_ERRORTYPE            gPeerRet;
+static OMX_U32                  gPeerCalls;
+static OMX_BUFFERHEADERTYPE    *gPeerLast;
+
+static OMX_ERRORTYPE Test_PeerEmptyThisBuffer(OMX_HANDLETYPE hComponent, OMX_BUFFERHEADERTYPE *pBuffer)
+{
+    gPeerCalls++;
+    gPeerLast = pBuffer;
+
+    return gPeerRet;
+}
+
+static OMX_ERRORTYPE Test_PeerGetComponentVersion(
+    OMX_HANDLETYPE   hComponent,
+    OMX_STRING       pComponentName,
+    OMX_VERSIONTYPE *pComponentVersion,
+    OMX_VERSIONTYPE *pSpecVersion,
+    OMX_UUIDTYPE    *pComponentUUID)
+{
+    strcpy(pComponentName, "OMX.Exynos.AVC.Encoder");
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_PeerGetParameter(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pParams)
+{
+    OMX_PARAM_PORTDEFINITIONTYPE *pPortDef = (OMX_PARAM_PORTDEFINITIONTYPE *)pParams;
+
+    if (nIndex != OMX_IndexParamPortDefinition)
+        return OMX_ErrorUnsupportedIndex;
+
+    pPortDef->eDir    = OMX_DirInput;
+    pPortDef->eDomain = OMX_PortDomainVideo;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateSupplier(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(OMX_U32));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    int                       i;
+
+    pOutputPort->portDefinition.bEnabled           = OMX_TRUE;
+    pOutputPort->portDefinition.nBufferCountActual = TEST_BUFFER_NUM;
+    pOutputPort->portState                         = EXYNOS_OMX_PortStateIdle;
+    pOutputPort->tunnelFlags                       = EXYNOS_TUNNEL_ESTABLISHED | EXYNOS_TUNNEL_IS_SUPPLIER;
+    pOutputPort->tunneledComponent                 = (OMX_HANDLETYPE)&gPeer;
+    pOutputPort->extendBufferHeader = (EXYNOS_OMX_BUFFERHEADERTYPE *)calloc(MAX_BUFFER_NUM, sizeof(EXYNOS_OMX_BUFFERHEADERTYPE));
+
+    Exynos_OSAL_MutexCreate(&pOutputPort->hPortMutex);
+    Exynos_OSAL_SemaphoreCreate(&pOutputPort->bufferSemID);
+    Exynos_OSAL_QueueCreate(&pOutputPort->bufferQ, MAX_QUEUE_ELEMENTS);
+
+    memset(&gPeer, 0, sizeof(gPeer));
+    gPeer.EmptyThisBuffer = &Test_PeerEmptyThisBuffer;
+    gPeerRet   = OMX_ErrorNone;
+    gPeerCalls = 0;
+    gPeerLast  = NULL;
+
+    for (i = 0; i < TEST_BUFFER_NUM; i++) {
+        INIT_SET_SIZE_VERSION(&gHeader[i], OMX_BUFFERHEADERTYPE);
+        INIT_SET_SIZE_VERSION(&gPeerHeader[i], OMX_BUFFERHEADERTYPE);
+        memset(&gTunnelBuffer[i], 0, sizeof(gTunnelBuffer[i]));
+
+        gTunnelBuffer[i].pSupplierHeader = &gHeader[i];
+        gTunnelBuffer[i].pPeerHeader     = &gPeerHeader[i];
+
+        gHeader[i].pBuffer            = gFrame;
+        gHeader[i].nAllocLen          = sizeof(gFrame);
+        gHeader[i].nInputPortIndex    = INPUT_PORT_INDEX;
+        gHeader[i].nOutputPortIndex   = OUTPUT_PORT_INDEX;
+        gHeader[i].pOutputPortPrivate = &gTunnelBuffer[i];
+        gPeerHeader[i].pBuffer            = gFrame;
+        gPeerHeader[i].pOutputPortPrivate = &gTunnelBuffer[i];
+
+        /* every frame is with the component */
+        pOutputPort->extendBufferHeader[i].OMXBufferHeader = &gHeader[i];
+        pOutputPort->extendBufferHeader[i].bBufferInOMX    = OMX_TRUE;
+    }
+
+    return pOMXComponent;
+}
+
+static void Test_DestroySupplier(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    while (Exynos_OSAL_GetElemNum(&pOutputPort->bufferQ) > 0)
+        Exynos_OSAL_Free(Exynos_OSAL_Dequeue(&pOutputPort->bufferQ));
+
+    Exynos_OSAL_QueueTerminate(&pOutputPort->bufferQ);
+    Exynos_OSAL_SemaphoreTerminate(pOutputPort->bufferSemID);
+    Exynos_OSAL_MutexTerminate(pOutputPort->hPortMutex);
+    free(pOutputPort->extendBufferHeader);
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static OMX_S32 Test_SemaphoreCount(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_S32                   nSemaCnt         = 0;
+
+    Exynos_OSAL_Get_SemaphoreCount(pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX].bufferSemID, &nSemaCnt);
+
+    return nSemaCnt;
+}
+
+static void Test_FrameGoesToPeer(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateSupplier();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    gHeader[0].nFilledLen = 32;
+    gHeader[0].nTimeStamp = 1000;
+    TEST_CHECK(Exynos_OMX_OutputBufferReturn(pOMXComponent, &gHeader[0]) == OMX_ErrorNone);
+    TEST_CHECK(gPeerCalls == 1);
+    TEST_CHECK(gPeerLast == &gPeerHeader[0]);
+    TEST_CHECK(gPeerHeader[0].nFilledLen == 32);
+    TEST_CHECK(gPeerHeader[0].nTimeStamp == 1000);
+    TEST_CHECK(gTunnelBuffer[0].nRefCount == 1);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pOutputPort->bufferQ) == 0);
+
+    /* EOS goes along even without data */
+    gHeader[1].nFilledLen = 0;
+    gHeader[1].nFlags     = OMX_BUFFERFLAG_EOS;
+    TEST_CHECK(Exynos_OMX_OutputBufferReturn(pOMXComponent, &gHeader[1]) == OMX_ErrorNone);
+    TEST_CHECK(gPeerCalls == 2);
+    TEST_CHECK(gPeerHeader[1].nFlags & OMX_BUFFERFLAG_EOS);
+
+    Test_DestroySupplier(pOMXComponent);
+}
+
+static void Test_EmptyFrameRecycled(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateSupplier();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    /* no round trip through the peer, the frame is ready to be decoded into again */
+    gHeader[2].nFilledLen = 0;
+    gHeader[2].nFlags     = 0;
+    TEST_CHECK(Exynos_OMX_OutputBufferReturn(pOMXComponent, &gHeader[2]) == OMX_ErrorNone);
+    TEST_CHECK(gPeerCalls == 0);
+    TEST_CHECK(gTunnelBuffer[2].bHeld == OMX_FALSE);
+    TEST_CHECK(pOutputPort->extendBufferHeader[2].bBufferInOMX == OMX_TRUE);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pOutputPort->bufferQ) == 1);
+    TEST_CHECK(Test_SemaphoreCount(pOMXComponent) == 1);
+
+    Test_DestroySupplier(pOMXComponent);
+}
+
+static void Test_HeldUntilRestart(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateSupplier();
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    /* flushed : kept by the supplier */
+    pOutputPort->portState = EXYNOS_OMX_PortStateFlushing;
+    gHeader[0].nFilledLen  = 32;
+    TEST_CHECK(Exynos_OMX_OutputBufferReturn(pOMXComponent, &gHeader[0]) == OMX_ErrorNone);
+    TEST_CHECK(gTunnelBuffer[0].bHeld == OMX_TRUE);
+
+    /* refused by the peer : kept as well */
+    pOutputPort->portState = EXYNOS_OMX_PortStateIdle;
+    gPeerRet              = OMX_ErrorIncorrectStateOperation;
+    gHeader[1].nFilledLen = 32;
+    TEST_CHECK(Exynos_OMX_OutputBufferReturn(pOMXComponent, &gHeader[1]) == OMX_ErrorNone);
+    TEST_CHECK(gTunnelBuffer[1].bHeld == OMX_TRUE);
+    TEST_CHECK(gTunnelBuffer[1].nRefCount == 0);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pOutputPort->bufferQ) == 0);
+
+    TEST_CHECK(Exynos_OMX_TunnelPortRestart(pOMXComponent, OUTPUT_PORT_INDEX) == OMX_ErrorNone);
+    TEST_CHECK(gTunnelBuffer[0].bHeld == OMX_FALSE);
+    TEST_CHECK(gTunnelBuffer[1].bHeld == OMX_FALSE);
+    TEST_CHECK(Exynos_OSAL_GetElemNum(&pOutputPort->bufferQ) == 2);
+    TEST_CHECK(Test_SemaphoreCount(pOMXComponent) == 2);
+
+    Test_DestroySupplier(pOMXComponent);
+}
+
+static OMX_COMPONENTTYPE *Test_CreateDecoder(OMX_U32 nWidth, OMX_U32 nHeight, PLANE_TYPE ePlaneType)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(OMX_U32));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pInputPort       = &pExynosComponent->pExynosPort[INPUT_PORT_INDEX];
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+
+    pExynosComponent->currentState = OMX_StateLoaded;
+
+    pInputPort->portDefinition.format.video.nFrameWidth  = nWidth;
+    pInputPort->portDefinition.format.video.nFrameHeight = nHeight;
+    pInputPort->portDefinition.format.video.nStride      = nWidth;
+    pInputPort->portDefinition.format.video.nSliceHeight = nHeight;
+
+    /* as the decoder is built */
+    pOutputPort->portDefinition.bEnabled                  = OMX_TRUE;
+    pOutputPort->portDefinition.format.video.eColorFormat = OMX_COLOR_FormatYUV420Planar;
+    pOutputPort->bufferProcessType = BUFFER_COPY;
+    pOutputPort->ePlaneType        = ePlaneType;
+    pOutputPort->eMetaDataType     = METADATA_TYPE_DISABLED;
+    Exynos_SetPlaneToPort(pOutputPort, Exynos_OSAL_GetPlaneCount(OMX_COLOR_FormatYUV420Planar, ePlaneType));
+
+    memset(&gPeer, 0, sizeof(gPeer));
+    gPeer.GetComponentVersion = &Test_PeerGetComponentVersion;
+    gPeer.GetParameter        = &Test_PeerGetParameter;
+
+    return pOMXComponent;
+}
+
+static void Test_RequestSharesBuffers(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder(1280, 720, PLANE_MULTIPLE);
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_TUNNELSETUPTYPE       tunnelSetup;
+
+    memset(&tunnelSetup, 0, sizeof(tunnelSetup));
+    TEST_CHECK(Exynos_OMX_ComponentTunnelRequest(pOMXComponent, OUTPUT_PORT_INDEX,
+                                                 (OMX_HANDLETYPE)&gPeer, INPUT_PORT_INDEX, &tunnelSetup) == OMX_ErrorNone);
+    TEST_CHECK(tunnelSetup.eSupplier == OMX_BufferSupplyOutput);
+    TEST_CHECK(CHECK_PORT_TUNNELED(pOutputPort) && CHECK_PORT_BUFFER_SUPPLIER(pOutputPort));
+
+    /* MFC decodes into the tunnel buffers, NV12 in one fd as the encoder reads it */
+    TEST_CHECK(pOutputPort->tunnelFlags & EXYNOS_TUNNEL_SHARE_BUFFER);
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_SHARE);
+    TEST_CHECK(pOutputPort->ePlaneType == PLANE_SINGLE);
+    TEST_CHECK(pOutputPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatYUV420SemiPlanar);
+    TEST_CHECK(Exynos_GetPlaneFromPort(pOutputPort) == 1);
+    TEST_CHECK(pOutputPort->portDefinition.nBufferSize == (1280 * 720 * 3) / 2);
+
+    /* and back to the copy once the tunnel is torn down */
+    TEST_CHECK(Exynos_OMX_ComponentTunnelRequest(pOMXComponent, OUTPUT_PORT_INDEX, NULL, 0, NULL) == OMX_ErrorNone);
+    TEST_CHECK(pOutputPort->tunnelFlags == 0);
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_COPY);
+    TEST_CHECK(pOutputPort->ePlaneType == PLANE_MULTIPLE);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_SingleFdPortCopies(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = Test_CreateDecoder(1280, 720, PLANE_SINGLE);
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_BASEPORT      *pOutputPort      = &pExynosComponent->pExynosPort[OUTPUT_PORT_INDEX];
+    OMX_TUNNELSETUPTYPE       tunnelSetup;
+
+    /* e.g. a secure decoder, its frames keep going through the copy */
+    memset(&tunnelSetup, 0, sizeof(tunnelSetup));
+    TEST_CHECK(Exynos_OMX_ComponentTunnelRequest(pOMXComponent, OUTPUT_PORT_INDEX,
+                                                 (OMX_HANDLETYPE)&gPeer, INPUT_PORT_INDEX, &tunnelSetup) == OMX_ErrorNone);
+    TEST_CHECK(CHECK_PORT_TUNNELED(pOutputPort));
+    TEST_CHECK(!(pOutputPort->tunnelFlags & EXYNOS_TUNNEL_SHARE_BUFFER));
+    TEST_CHECK(pOutputPort->bufferProcessType == BUFFER_COPY);
+    TEST_CHECK(pOutputPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatYUV420Planar);
+
+    /* a graphic buffer client is not tunneled at all */
+    Exynos_OMX_ComponentTunnelRequest(pOMXComponent, OUTPUT_PORT_INDEX, NULL, 0, NULL);
+    pOutputPort->eMetaDataType = METADATA_TYPE_GRAPHIC;
+    TEST_CHECK(Exynos_OMX_ComponentTunnelRequest(pOMXComponent, OUTPUT_PORT_INDEX,
+                                                 (OMX_HANDLETYPE)&gPeer, INPUT_PORT_INDEX, &tunnelSetup) == OMX_ErrorPortsNotCompatible);
+    TEST_CHECK(!CHECK_PORT_TUNNELED(pOutputPort));
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_FrameGoesToPeer);
+    TEST_RUN(Test_EmptyFrameRecycled);
+    TEST_RUN(Test_HeldUntilRestart);
+    TEST_RUN(Test_RequestSharesBuffers);
+    TEST_RUN(Test_SingleFdPortCopies);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,244 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_VendorExt.c
+ * @brief       vendor extensions of a component, and what registering them costs at creation
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+#include "Exynos_OMX_Test.h"
+#include "Exynos_OMX_Macros.h"
+#include "Exynos_OMX_Venc.h"
+#include "Exynos_OSAL_Android.h"
+
+#define TEST_CREATE_COUNT   1000
+
+typedef struct _TEST_VENDOR_EXT_NAME
+{
+    const char  *pName;
+    OMX_U32      nIndex;
+} TEST_VENDOR_EXT_NAME;
+
+/* what the H.264 encoder registers at init */
+static const TEST_VENDOR_EXT_NAME gEncoderExts[] = {
+    { "sec-ext-enc-qp-range",                           OMX_IndexConfigVideoQPRange },
+    { "sec-ext-enc-drop-control",                       OMX_IndexParamVideoDropControl },
+    { "sec-ext-enc-disable-dfr",                        OMX_IndexParamVideoDisableDFR },
+    { "sec-ext-enc-chroma-qp-offset",                   OMX_IndexParamVideoChromaQP },
+    { "sec-ext-enc-disable-hierarchical-b-encoding",    OMX_IndexParamVideoDisableHBEncoding },
+    { "rtc-ext-enc-caps-vt-driver-version",             OMX_IndexSkypeParamDriverVersion },
+    { "rtc-ext-enc-low-latency",                        OMX_IndexSkypeParamLowLatency },
+    { "rtc-ext-enc-caps-temporal-layers",               OMX_IndexSkypeParamEncoderMaxTemporalLayerCount },
+    { "rtc-ext-enc-caps-ltr",                           OMX_IndexSkypeParamEncoderMaxLTR },
+    { "rtc-ext-enc-ltr-count",                          OMX_IndexSkypeParamEncoderLTR },
+    { "rtc-ext-enc-caps-preprocess",                    OMX_IndexSkypeParamEncoderPreprocess },
+    { "rtc-ext-enc-custom-profile-level",               OMX_IndexParamVideoProfileLevelCurrent },
+    { "rtc-ext-enc-sar",                                OMX_IndexSkypeParamEncoderSar },
+    { "rtc-ext-enc-slice",                              OMX_IndexParamVideoAvc },
+    { "rtc-ext-enc-ltr",                                OMX_IndexSkypeConfigEncoderLTR },
+    { "rtc-ext-enc-frame-qp",                           OMX_IndexSkypeConfigQP },
+    { "rtc-ext-enc-base-layer-pid",                     OMX_IndexSkypeConfigBasePid },
+    { "rtc-ext-enc-app-input-control",                  OMX_IndexSkypeParamEncoderInputControl },
+    { "rtc-ext-enc-input-trigger",                      OMX_IndexSkypeConfigEncoderInputTrigger },
+    { "rtc-ext-enc-bitrate-mode",                       OMX_IndexSkypeParamVideoBitrate },
+    { "sec-ext-pipeline-metrics",                       OMX_IndexConfigVideoPipelineMetrics },
+    { "sec-ext-trim-memory",                            OMX_IndexConfigTrimMemory },
+};
+#define TEST_ENCODER_EXT_NUM (sizeof(gEncoderExts) / sizeof(gEncoderExts[0]))
+
+static OMX_BOOL gDropControl;
+
+static OMX_ERRORTYPE Test_GetParameter(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pParams)
+{
+    if (nIndex == (OMX_INDEXTYPE)OMX_IndexParamVideoDropControl)
+        ((OMX_CONFIG_BOOLEANTYPE *)pParams)->bEnabled = gDropControl;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_SetParameter(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pParams)
+{
+    if (nIndex == (OMX_INDEXTYPE)OMX_IndexParamVideoDropControl)
+        gDropControl = ((OMX_CONFIG_BOOLEANTYPE *)pParams)->bEnabled;
+
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE Test_GetConfig(OMX_HANDLETYPE hComponent, OMX_INDEXTYPE nIndex, OMX_PTR pConfigs)
+{
+    return OMX_ErrorNone;
+}
+
+static OMX_COMPONENTTYPE *Test_CreateEncoder(void)
+{
+    OMX_COMPONENTTYPE        *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEOENC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+
+    pExynosComponent->codecType = HW_VIDEO_ENC_CODEC;
+
+    pOMXComponent->GetParameter = &Test_GetParameter;
+    pOMXComponent->SetParameter = &Test_SetParameter;
+    pOMXComponent->GetConfig    = &Test_GetConfig;
+
+    return pOMXComponent;
+}
+
+static void Test_AddEncoderExts(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    OMX_U32 i;
+
+    for (i = 0; i < TEST_ENCODER_EXT_NUM; i++)
+        Exynos_OSAL_AddVendorExt((OMX_HANDLETYPE)pOMXComponent, (OMX_STRING)gEncoderExts[i].pName, (OMX_INDEXTYPE)gEncoderExts[i].nIndex);
+}
+
+static OMX_U32 Test_CountExts(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    OMX_U32                   nCount           = 0;
+
+    while ((nCount < MAX_VENDOR_EXT_NUM) &&
+           (pExynosComponent->vendorExts[nCount] != NULL))
+        nCount++;
+
+    return nCount;
+}
+
+static void Test_InitExtConfig(OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE *pExt, OMX_U32 nIndex)
+{
+    memset(pExt, 0, sizeof(*pExt));
+    INIT_SET_SIZE_VERSION(pExt, OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE);
+    pExt->nIndex         = nIndex;
+    pExt->nParamSizeUsed = 1;
+}
+
+static void Test_GetSet(void)
+{
+    OMX_COMPONENTTYPE                       *pOMXComponent = Test_CreateEncoder();
+    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE  ext;
+    OMX_U32                                  nCount;
+    OMX_U32                                  i;
+
+    Test_AddEncoderExts(pOMXComponent);
+
+    /* the extensions of other codec types and of a disabled feature are left out */
+    nCount = Test_CountExts(pOMXComponent);
+    TEST_CHECK((nCount >= 5) && (nCount <= TEST_ENCODER_EXT_NUM));
+
+    /* a decoder only extension is refused */
+    TEST_CHECK(Exynos_OSAL_AddVendorExt((OMX_HANDLETYPE)pOMXComponent, (OMX_STRING)"sec-ext-dec-compressed-color-format",
+                                        (OMX_INDEXTYPE)OMX_IndexParamVideoCompressedColorFormat) == OMX_ErrorUnsupportedIndex);
+    TEST_CHECK(Test_CountExts(pOMXComponent) == nCount);
+
+    /* queried by slot, in the order they were added */
+    Test_InitExtConfig(&ext, 1);
+    gDropControl = OMX_TRUE;
+    TEST_CHECK(Exynos_OSAL_GetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext) == OMX_ErrorNone);
+    TEST_CHECK(strcmp((char *)ext.cName, "sec-ext-enc-drop-control") == 0);
+    TEST_CHECK(ext.nParamCount == 1);
+    TEST_CHECK(strcmp((char *)ext.param[0].cKey, "enable") == 0);
+    TEST_CHECK(ext.param[0].nInt32 == OMX_TRUE);
+
+    /* and set by name */
+    ext.param[0].bSet   = OMX_TRUE;
+    ext.param[0].nInt32 = OMX_FALSE;
+    TEST_CHECK(Exynos_OSAL_SetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext) == OMX_ErrorNone);
+    TEST_CHECK(gDropControl == OMX_FALSE);
+
+    strcpy((char *)ext.cName, "sec-ext-enc-drop-controls");
+    TEST_CHECK(Exynos_OSAL_SetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext) == OMX_ErrorUnsupportedSetting);
+
+    /* every slot answers, with a size big enough for its parameters */
+    for (i = 0; i < nCount; i++) {
+        Test_InitExtConfig(&ext, i);
+        TEST_CHECK(Exynos_OSAL_GetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext) == OMX_ErrorNone);
+        TEST_CHECK(ext.nParamCount >= 1);
+    }
+
+    Test_InitExtConfig(&ext, nCount);
+    TEST_CHECK(Exynos_OSAL_GetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext) == OMX_ErrorNoMore);
+
+    Exynos_OSAL_DelVendorExts((OMX_HANDLETYPE)pOMXComponent);
+    TEST_CHECK(Test_CountExts(pOMXComponent) == 0);
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static void Test_CreationCost(void)
+{
+    OMX_COMPONENTTYPE                       *pOMXComponent = Test_CreateEncoder();
+    OMX_CONFIG_ANDROID_VENDOR_EXTENSIONTYPE  ext;
+    OMX_TICKS                                startUs;
+    OMX_TICKS                                addUs         = 0;
+    OMX_TICKS                                delUs         = 0;
+    size_t                                   nHeapBefore;
+    size_t                                   nHeapAdded;
+    size_t                                   nHeapQueried;
+    OMX_U32                                  nCount;
+    OMX_U32                                  i;
+
+    int n;
+
+    /* a thumbnail session registers everything and queries nothing */
+    for (n = 0; n < TEST_CREATE_COUNT; n++) {
+        startUs = ExynosTest_GetTimeUs();
+        Test_AddEncoderExts(pOMXComponent);
+        addUs += ExynosTest_GetTimeUs() - startUs;
+
+        startUs = ExynosTest_GetTimeUs();
+        Exynos_OSAL_DelVendorExts((OMX_HANDLETYPE)pOMXComponent);
+        delUs += ExynosTest_GetTimeUs() - startUs;
+    }
+
+    nHeapBefore = mallinfo().uordblks;
+    Test_AddEncoderExts(pOMXComponent);
+    nHeapAdded = mallinfo().uordblks;
+    nCount = Test_CountExts(pOMXComponent);
+
+    /* one that asks for every extension */
+    for (i = 0; i < nCount; i++) {
+        Test_InitExtConfig(&ext, i);
+        Exynos_OSAL_GetVendorExt((OMX_HANDLETYPE)pOMXComponent, &ext);
+    }
+    nHeapQueried = mallinfo().uordblks;
+
+    Exynos_OSAL_DelVendorExts((OMX_HANDLETYPE)pOMXComponent);
+
+    /* not a pass/fail check, the numbers are for comparing builds */
+    printf("  %lu extensions: add %lld ns, del %lld ns per component\n",
+           (unsigned long)nCount,
+           (long long)(addUs * 1000 / TEST_CREATE_COUNT), (long long)(delUs * 1000 / TEST_CREATE_COUNT));
+    printf("  heap: %lu bytes at creation, %lu bytes once all are queried\n",
+           (unsigned long)(nHeapAdded - nHeapBefore), (unsigned long)(nHeapQueried - nHeapBefore));
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_GetSet);
+    TEST_RUN(Test_CreationCost);
+
+    return TEST_RESULT();
+}
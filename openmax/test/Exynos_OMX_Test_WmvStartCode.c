@@ -0,0 +1,227 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        Exynos_OMX_Test_WmvStartCode.c
+ * @brief       start code put while copying against the one shifted in, on canned VC-1/WMV3 frames
+ * @version     1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+/* the start code handling is private to the codec, it is built into the test */
+#include "Exynos_OMX_Wmvdec.c"
+
+#include "Exynos_OMX_Test.h"
+
+#define TEST_BUFFER_SIZE    64
+
+typedef struct _TEST_WMV_FRAME {
+    const OMX_U8 *pChunk[3];        /* input buffers of one frame */
+    OMX_U32       nChunkLen[3];
+    OMX_U32       nFlags;           /* of the last chunk */
+} TEST_WMV_FRAME;
+
+typedef struct _TEST_WMV_RESULT {
+    OMX_ERRORTYPE ret;
+    OMX_U8        buffer[TEST_BUFFER_SIZE];
+    OMX_U32       nFrameSize;
+    OMX_BOOL      bStartCode;
+} TEST_WMV_RESULT;
+
+static const OMX_U8 gVC1Frame[]      = { 0x1b, 0x2c, 0x3d, 0x4e, 0x5f, 0x60, 0x71, 0x82, 0x93, 0xa4 };
+static const OMX_U8 gVC1Coded[]      = { 0x00, 0x00, 0x01, 0x0d, 0x5f, 0x60, 0x71, 0x82 };
+static const OMX_U8 gVC1Field[]      = { 0x00, 0x00, 0x01, 0x0c, 0x93, 0xa4 };
+static const OMX_U8 gVC1Head[]       = { 0x00, 0x00 };  /* too short to show a prefix code */
+static const OMX_U8 gVC1Tail[]       = { 0x01, 0x0d, 0xa4, 0xb5 };
+static const OMX_U8 gVC1Zero[]       = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const OMX_U8 gWMV3Frame[]     = { 0x8e, 0x12, 0x34, 0x56, 0x78, 0x9a };
+
+static OMX_COMPONENTTYPE *CreateWmvDec(WMV_FORMAT wmvFormat)
+{
+    OMX_COMPONENTTYPE             *pOMXComponent    = ExynosTest_CreateComponent(sizeof(EXYNOS_OMX_VIDEODEC_COMPONENT));
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+    EXYNOS_WMVDEC_HANDLE          *pWmvDec          = (EXYNOS_WMVDEC_HANDLE *)calloc(1, sizeof(EXYNOS_WMVDEC_HANDLE));
+
+    pWmvDec->hMFCWmvHandle.wmvFormat         = wmvFormat;
+    pWmvDec->hMFCWmvHandle.bConfiguredMFCSrc = OMX_TRUE;
+    pVideoDec->hCodecHandle                  = (OMX_HANDLETYPE)pWmvDec;
+
+    return pOMXComponent;
+}
+
+static void DestroyWmvDec(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    free(pVideoDec->hCodecHandle);
+    pVideoDec->hCodecHandle = NULL;
+
+    ExynosTest_DestroyComponent(pOMXComponent);
+}
+
+static EXYNOS_WMVDEC_HANDLE *GetWmvDec(OMX_COMPONENTTYPE *pOMXComponent)
+{
+    EXYNOS_OMX_BASECOMPONENT      *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_VIDEODEC_COMPONENT *pVideoDec        = (EXYNOS_OMX_VIDEODEC_COMPONENT *)pExynosComponent->hComponentHandle;
+
+    return (EXYNOS_WMVDEC_HANDLE *)pVideoDec->hCodecHandle;
+}
+
+/* same steps as Exynos_Preprocessor_InputData() gathering a frame, bCopy chooses the prefix hook */
+static void RunFrame(
+    OMX_COMPONENTTYPE       *pOMXComponent,
+    const TEST_WMV_FRAME    *pFrame,
+    OMX_U32                  nAllocSize,
+    OMX_BOOL                 bCopy,
+    TEST_WMV_RESULT         *pResult)
+{
+    EXYNOS_OMX_BASECOMPONENT *pExynosComponent = (EXYNOS_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    EXYNOS_OMX_DATA           srcInputData;
+    int i;
+
+    Exynos_OSAL_Memset(pResult, 0, sizeof(TEST_WMV_RESULT));
+    Exynos_OSAL_Memset(&srcInputData, 0, sizeof(srcInputData));
+    srcInputData.buffer.addr[0] = pResult->buffer;
+    srcInputData.allocSize      = nAllocSize;
+
+    for (i = 0; (i < 3) && (pFrame->pChunk[i] != NULL); i++) {
+        OMX_U32 nFlags = ((i == 2) || (pFrame->pChunk[i + 1] == NULL)) ? pFrame->nFlags : 0;
+
+        if ((bCopy == OMX_TRUE) &&
+            (srcInputData.dataLen == 0))
+            srcInputData.dataLen = Make_Stream_StartCodePrefix(pOMXComponent, (OMX_U8 *)pFrame->pChunk[i], pFrame->nChunkLen[i], nFlags,
+                                                               pResult->buffer, (nAllocSize - pFrame->nChunkLen[i]));
+
+        Exynos_OSAL_Memcpy(pResult->buffer + srcInputData.dataLen, pFrame->pChunk[i], pFrame->nChunkLen[i]);
+        srcInputData.dataLen += pFrame->nChunkLen[i];
+        srcInputData.nFlags   = nFlags;
+    }
+
+    pResult->nFrameSize = srcInputData.dataLen;
+    pResult->ret = WmvCodecPutStartCode(pExynosComponent, &srcInputData, &pResult->nFrameSize, &pResult->bStartCode);
+}
+
+static void CheckSameBytes(WMV_FORMAT wmvFormat, const TEST_WMV_FRAME *pFrame, OMX_U32 nAllocSize, OMX_U32 nExpectLen)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = CreateWmvDec(wmvFormat);
+    TEST_WMV_RESULT    shared;
+    TEST_WMV_RESULT    copied;
+
+    RunFrame(pOMXComponent, pFrame, nAllocSize, OMX_FALSE, &shared);
+    RunFrame(pOMXComponent, pFrame, nAllocSize, OMX_TRUE, &copied);
+
+    TEST_CHECK(shared.ret == copied.ret);
+    TEST_CHECK(shared.bStartCode == copied.bStartCode);
+    TEST_CHECK(shared.nFrameSize == copied.nFrameSize);
+    TEST_CHECK(copied.nFrameSize == nExpectLen);
+    TEST_CHECK(Exynos_OSAL_Memcmp(shared.buffer, copied.buffer, shared.nFrameSize) == 0);
+    TEST_CHECK(GetWmvDec(pOMXComponent)->nStartCodePrefixLen == 0);
+
+    DestroyWmvDec(pOMXComponent);
+}
+
+static void Test_VC1SingleChunk(void)
+{
+    TEST_WMV_FRAME frame = { { gVC1Frame }, { sizeof(gVC1Frame) }, OMX_BUFFERFLAG_ENDOFFRAME };
+
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Frame) + 4);
+
+    /* already coded with a start code */
+    frame.pChunk[0] = gVC1Coded; frame.nChunkLen[0] = sizeof(gVC1Coded);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Coded));
+
+    frame.pChunk[0] = gVC1Field; frame.nChunkLen[0] = sizeof(gVC1Field);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Field));
+
+    frame.pChunk[0] = gVC1Zero; frame.nChunkLen[0] = sizeof(gVC1Zero);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Zero) + 4);
+}
+
+static void Test_VC1Chunks(void)
+{
+    TEST_WMV_FRAME frame = { { gVC1Frame, gVC1Frame, gVC1Coded }, { sizeof(gVC1Frame), sizeof(gVC1Frame), sizeof(gVC1Coded) },
+                             OMX_BUFFERFLAG_ENDOFFRAME };
+
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, (2 * sizeof(gVC1Frame)) + sizeof(gVC1Coded) + 4);
+
+    /* the prefix code shows only once the frame is gathered */
+    frame.pChunk[0] = gVC1Head; frame.nChunkLen[0] = sizeof(gVC1Head);
+    frame.pChunk[1] = gVC1Tail; frame.nChunkLen[1] = sizeof(gVC1Tail);
+    frame.pChunk[2] = NULL;
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Head) + sizeof(gVC1Tail));
+
+    frame.pChunk[1] = gVC1Frame; frame.nChunkLen[1] = sizeof(gVC1Frame);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Head) + sizeof(gVC1Frame) + 4);
+}
+
+static void Test_VC1EOS(void)
+{
+    TEST_WMV_FRAME frame = { { gVC1Frame }, { sizeof(gVC1Frame) }, OMX_BUFFERFLAG_ENDOFFRAME | OMX_BUFFERFLAG_EOS };
+
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, sizeof(gVC1Frame));
+
+    /* EOS only with the last chunk, after the prefix was put */
+    frame.pChunk[1] = gVC1Frame; frame.nChunkLen[1] = sizeof(gVC1Frame);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, TEST_BUFFER_SIZE, 2 * sizeof(gVC1Frame));
+}
+
+static void Test_VC1NoSpace(void)
+{
+    TEST_WMV_FRAME frame = { { gVC1Frame }, { sizeof(gVC1Frame) }, OMX_BUFFERFLAG_ENDOFFRAME };
+
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, sizeof(gVC1Frame) + 4, sizeof(gVC1Frame) + 4);
+    CheckSameBytes(WMV_FORMAT_VC1, &frame, sizeof(gVC1Frame) + 2, sizeof(gVC1Frame));
+}
+
+static void Test_NotConfigured(void)
+{
+    OMX_COMPONENTTYPE *pOMXComponent = CreateWmvDec(WMV_FORMAT_VC1);
+    OMX_U8             prefix[8];
+
+    /* sequence header goes to WmvCodecSrcSetup() untouched */
+    GetWmvDec(pOMXComponent)->hMFCWmvHandle.bConfiguredMFCSrc = OMX_FALSE;
+    TEST_CHECK(Make_Stream_StartCodePrefix(pOMXComponent, (OMX_U8 *)gVC1Frame, sizeof(gVC1Frame), 0, prefix, sizeof(prefix)) == 0);
+    TEST_CHECK(GetWmvDec(pOMXComponent)->nStartCodePrefixLen == 0);
+
+    DestroyWmvDec(pOMXComponent);
+}
+
+static void Test_WMV3(void)
+{
+    TEST_WMV_FRAME frame = { { gWMV3Frame, gWMV3Frame }, { sizeof(gWMV3Frame), sizeof(gWMV3Frame) }, OMX_BUFFERFLAG_ENDOFFRAME };
+
+#ifdef WMV3_ADDITIONAL_START_CODE
+    CheckSameBytes(WMV_FORMAT_WMV3, &frame, TEST_BUFFER_SIZE, (2 * sizeof(gWMV3Frame)) + 8);
+#else
+    CheckSameBytes(WMV_FORMAT_WMV3, &frame, TEST_BUFFER_SIZE, 2 * sizeof(gWMV3Frame));
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    TEST_RUN(Test_VC1SingleChunk);
+    TEST_RUN(Test_VC1Chunks);
+    TEST_RUN(Test_VC1EOS);
+    TEST_RUN(Test_VC1NoSpace);
+    TEST_RUN(Test_NotConfigured);
+    TEST_RUN(Test_WMV3);
+
+    return TEST_RESULT();
+}
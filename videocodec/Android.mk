@@ -64,6 +64,12 @@ ifneq ($(BOARD_USE_FRAMERATE_THRESH_HOLD),)
 LOCAL_CFLAGS += -DFRAMERATE_THRESH_HOLD=$(BOARD_USE_FRAMERATE_THRESH_HOLD)
 endif
 
+# in-process MFC model for the OMX tests and benchmark on a host without MFC
+ifeq ($(BOARD_USE_MOCK_CODEC), true)
+LOCAL_SRC_FILES += osal/ExynosVideo_OSAL_Mock.c
+LOCAL_CFLAGS += -DUSE_MOCK_CODEC
+endif
+
 LOCAL_MODULE := libExynosVideoApi
 LOCAL_MODULE_TAGS := optional
 LOCAL_PRELINK_MODULE := false
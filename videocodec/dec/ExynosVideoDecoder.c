@@ -39,8 +39,6 @@
 #include <sys/mman.h>
 #include <pthread.h>
 
-#include <sys/poll.h>
-
 #include "ExynosVideoApi.h"
 #include "ExynosVideoDec.h"
 #include "ExynosVideo_OSAL_Dec.h"
@@ -253,6 +251,14 @@ static void *MFC_Decoder_Init(ExynosVideoInstInfo *pVideoInfo)
     pCtx->videoCtx.bStreamonInbuf  = VIDEO_FALSE;
     pCtx->videoCtx.bStreamonOutbuf = VIDEO_FALSE;
 
+    /* wakes the output waiter up, not every driver supports them */
+#ifdef V4L2_EVENT_SOURCE_CHANGE
+    if (Codec_OSAL_SubscribeEvent(pCtx, V4L2_EVENT_SOURCE_CHANGE) != 0)
+        ALOGV("%s: resolution change event is not supported", __FUNCTION__);
+#endif
+    if (Codec_OSAL_SubscribeEvent(pCtx, V4L2_EVENT_EOS) != 0)
+        ALOGV("%s: EOS event is not supported", __FUNCTION__);
+
     /* mutex for input */
     pMutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
     if (pMutex == NULL) {
@@ -1863,35 +1869,65 @@ static ExynosVideoErrorType MFC_Decoder_Wait_Inbuf(void *pHandle)
     CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
     ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
 
-    struct pollfd poll_events;
-    int poll_state;
-
     if (pCtx == NULL) {
         ALOGE("%s: Video context info must be supplied", __FUNCTION__);
         ret = VIDEO_ERROR_BADPARAM;
         goto EXIT;
     }
 
-    poll_events.fd = pCtx->videoCtx.hDevice;
-    poll_events.events = POLLOUT | POLLERR;
-    poll_events.revents = 0;
+    /* blocks until the input queue is ready or the wait is canceled by stream off */
+    if (Codec_OSAL_WaitReady(pCtx, CODEC_OSAL_BUF_TYPE_SRC, -1) != CODEC_OSAL_WAIT_READY) {
+        ALOGE("%s: Poll return error", __FUNCTION__);
+        ret = VIDEO_ERROR_POLL;
+    }
 
-    do {
-        poll_state = poll((struct pollfd*)&poll_events, 1, VIDEO_DECODER_POLL_TIMEOUT);
-        if (poll_state > 0) {
-            if (poll_events.revents & POLLOUT) {
-                break;
-            } else {
-                ALOGE("%s: Poll return error", __FUNCTION__);
-                ret = VIDEO_ERROR_POLL;
-                break;
-            }
-        } else if (poll_state < 0) {
-            ALOGE("%s: Poll state error", __FUNCTION__);
-            ret = VIDEO_ERROR_POLL;
-            break;
-        }
-    } while (poll_state == 0);
+EXIT:
+    return ret;
+}
+
+/*
+ * [Decoder Buffer OPS] Get Ready Fd (Input)
+ */
+static ExynosVideoErrorType MFC_Decoder_Get_ReadyFd_Inbuf(
+    void    *pHandle,
+    int     *pFd)
+{
+    CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
+    ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
+
+    if ((pCtx == NULL) ||
+        (pFd == NULL)) {
+        ALOGE("%s: Video context info must be supplied", __FUNCTION__);
+        ret = VIDEO_ERROR_BADPARAM;
+        goto EXIT;
+    }
+
+    /* readable while a dequeue would not sleep, -1 if the device can not tell */
+    *pFd = Codec_OSAL_GetReadyFd(pCtx, CODEC_OSAL_BUF_TYPE_SRC);
+
+EXIT:
+    return ret;
+}
+
+/*
+ * [Decoder Buffer OPS] Get Ready Fd (Output)
+ */
+static ExynosVideoErrorType MFC_Decoder_Get_ReadyFd_Outbuf(
+    void    *pHandle,
+    int     *pFd)
+{
+    CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
+    ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
+
+    if ((pCtx == NULL) ||
+        (pFd == NULL)) {
+        ALOGE("%s: Video context info must be supplied", __FUNCTION__);
+        ret = VIDEO_ERROR_BADPARAM;
+        goto EXIT;
+    }
+
+    /* readable while a dequeue would not sleep, -1 if the device can not tell */
+    *pFd = Codec_OSAL_GetReadyFd(pCtx, CODEC_OSAL_BUF_TYPE_DST);
 
 EXIT:
     return ret;
@@ -2487,6 +2523,12 @@ static ExynosVideoBuffer *MFC_Decoder_Dequeue_Outbuf(void *pHandle)
 
     pOutbuf->frameType = buf.frameType;
 
+    {
+        int64_t sec  = (int64_t)(buf.timestamp.tv_sec * 1E6);
+        int64_t usec = (int64_t)buf.timestamp.tv_usec;
+        pOutbuf->timestamp = sec + usec;
+    }
+
     if (pCtx->videoCtx.outbufGeometry.bInterlaced == VIDEO_TRUE) {
         if ((buf.field == CODEC_OSAL_INTER_TYPE_TB) ||
             (buf.field == CODEC_OSAL_INTER_TYPE_BT)) {
@@ -3195,6 +3237,12 @@ static ExynosVideoErrorType MFC_Decoder_ExtensionDequeue_Outbuf(
 
     pOutbuf->frameType = buf.frameType;
 
+    {
+        int64_t sec  = (int64_t)(buf.timestamp.tv_sec * 1E6);
+        int64_t usec = (int64_t)buf.timestamp.tv_usec;
+        pOutbuf->timestamp = sec + usec;
+    }
+
     if (pCtx->videoCtx.outbufGeometry.bInterlaced == VIDEO_TRUE) {
         if ((buf.field == CODEC_OSAL_INTER_TYPE_TB) ||
             (buf.field == CODEC_OSAL_INTER_TYPE_BT)) {
@@ -3323,6 +3371,7 @@ static ExynosVideoDecBufferOps defInbufOps = {
     .Apply_RegisteredBuffer = NULL,
     .ExtensionEnqueue       = MFC_Decoder_ExtensionEnqueue_Inbuf,
     .ExtensionDequeue       = MFC_Decoder_ExtensionDequeue_Inbuf,
+    .Get_ReadyFd            = MFC_Decoder_Get_ReadyFd_Inbuf,
 };
 
 /*
@@ -3349,6 +3398,7 @@ static ExynosVideoDecBufferOps defOutbufOps = {
     .Apply_RegisteredBuffer = MFC_Decoder_Apply_RegisteredBuffer_Outbuf,
     .ExtensionEnqueue       = MFC_Decoder_ExtensionEnqueue_Outbuf,
     .ExtensionDequeue       = MFC_Decoder_ExtensionDequeue_Outbuf,
+    .Get_ReadyFd            = MFC_Decoder_Get_ReadyFd_Outbuf,
 };
 
 ExynosVideoErrorType MFC_Exynos_Video_GetInstInfo_Decoder(
@@ -39,8 +39,6 @@
 #include <sys/mman.h>
 #include <pthread.h>
 
-#include <sys/poll.h>
-
 #include "ExynosVideoApi.h"
 #include "ExynosVideoEnc.h"
 #include "ExynosVideo_OSAL_Enc.h"
@@ -2233,35 +2231,17 @@ static ExynosVideoErrorType MFC_Encoder_Wait_Inbuf(void *pHandle)
     CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
     ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
 
-    struct pollfd poll_events;
-    int poll_state;
-
     if (pCtx == NULL) {
         ALOGE("%s: invalid parameter", __FUNCTION__);
         ret = VIDEO_ERROR_BADPARAM;
         goto EXIT;
     }
 
-    poll_events.fd = pCtx->videoCtx.hDevice;
-    poll_events.events = POLLOUT | POLLERR;
-    poll_events.revents = 0;
-
-    do {
-        poll_state = poll((struct pollfd*)&poll_events, 1, VIDEO_ENCODER_POLL_TIMEOUT);
-        if (poll_state > 0) {
-            if (poll_events.revents & POLLOUT) {
-                break;
-            } else {
-                ALOGE("%s: Poll return error", __FUNCTION__);
-                ret = VIDEO_ERROR_POLL;
-                break;
-            }
-        } else if (poll_state < 0) {
-            ALOGE("%s: Poll state error", __FUNCTION__);
-            ret = VIDEO_ERROR_POLL;
-            break;
-        }
-    } while (poll_state == 0);
+    /* blocks until the src queue is ready or the wait is canceled by stream off */
+    if (Codec_OSAL_WaitReady(pCtx, CODEC_OSAL_BUF_TYPE_SRC, -1) != CODEC_OSAL_WAIT_READY) {
+        ALOGE("%s: Poll return error", __FUNCTION__);
+        ret = VIDEO_ERROR_POLL;
+    }
 
 EXIT:
     return ret;
@@ -2275,38 +2255,70 @@ static ExynosVideoErrorType MFC_Encoder_Wait_Outbuf(void *pHandle)
     CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
     ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
 
-    struct pollfd poll_events;
-    int poll_state;
-    int bframe_count = 0; // FIXME
-
     if (pCtx == NULL) {
         ALOGE("%s: invalid parameter", __FUNCTION__);
         ret = VIDEO_ERROR_BADPARAM;
         goto EXIT;
     }
 
-    poll_events.fd = pCtx->videoCtx.hDevice;
-    poll_events.events = POLLIN | POLLERR;
-    poll_events.revents = 0;
+    /* B-frame reordering may hold the stream back, so it gives up quietly like before */
+    switch (Codec_OSAL_WaitReady(pCtx, CODEC_OSAL_BUF_TYPE_DST, VIDEO_ENCODER_POLL_TIMEOUT * 5)) { // FIXME
+    case CODEC_OSAL_WAIT_READY:
+    case CODEC_OSAL_WAIT_TIMEOUT:
+        break;
+    default:
+        ALOGE("%s: Poll return error", __FUNCTION__);
+        ret = VIDEO_ERROR_POLL;
+        break;
+    }
+
+EXIT:
+    return ret;
+}
 
-    do {
-        poll_state = poll((struct pollfd*)&poll_events, 1, VIDEO_ENCODER_POLL_TIMEOUT);
-        if (poll_state > 0) {
-            if (poll_events.revents & POLLIN) {
-                break;
-            } else {
-                ALOGE("%s: Poll return error", __FUNCTION__);
-                ret = VIDEO_ERROR_POLL;
-                break;
-            }
-        } else if (poll_state < 0) {
-            ALOGE("%s: Poll state error", __FUNCTION__);
-            ret = VIDEO_ERROR_POLL;
-            break;
-        } else {
-            bframe_count++; // FIXME
-        }
-    } while (poll_state == 0 && bframe_count < 5); // FIXME
+/*
+ * [Encoder Buffer OPS] Get Ready Fd (Src)
+ */
+static ExynosVideoErrorType MFC_Encoder_Get_ReadyFd_Inbuf(
+    void    *pHandle,
+    int     *pFd)
+{
+    CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
+    ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
+
+    if ((pCtx == NULL) ||
+        (pFd == NULL)) {
+        ALOGE("%s: Video context info must be supplied", __FUNCTION__);
+        ret = VIDEO_ERROR_BADPARAM;
+        goto EXIT;
+    }
+
+    /* readable while a dequeue would not sleep, -1 if the device can not tell */
+    *pFd = Codec_OSAL_GetReadyFd(pCtx, CODEC_OSAL_BUF_TYPE_SRC);
+
+EXIT:
+    return ret;
+}
+
+/*
+ * [Encoder Buffer OPS] Get Ready Fd (Dst)
+ */
+static ExynosVideoErrorType MFC_Encoder_Get_ReadyFd_Outbuf(
+    void    *pHandle,
+    int     *pFd)
+{
+    CodecOSALVideoContext *pCtx = (CodecOSALVideoContext *)pHandle;
+    ExynosVideoErrorType   ret  = VIDEO_ERROR_NONE;
+
+    if ((pCtx == NULL) ||
+        (pFd == NULL)) {
+        ALOGE("%s: Video context info must be supplied", __FUNCTION__);
+        ret = VIDEO_ERROR_BADPARAM;
+        goto EXIT;
+    }
+
+    /* readable while a dequeue would not sleep, -1 if the device can not tell */
+    *pFd = Codec_OSAL_GetReadyFd(pCtx, CODEC_OSAL_BUF_TYPE_DST);
 
 EXIT:
     return ret;
@@ -3511,6 +3523,7 @@ static ExynosVideoEncBufferOps defInbufOps = {
     .Cleanup_Buffer         = MFC_Encoder_Cleanup_Buffer_Inbuf,
     .ExtensionEnqueue       = MFC_Encoder_ExtensionEnqueue_Inbuf,
     .ExtensionDequeue       = MFC_Encoder_ExtensionDequeue_Inbuf,
+    .Get_ReadyFd            = MFC_Encoder_Get_ReadyFd_Inbuf,
 };
 
 /*
@@ -3535,6 +3548,7 @@ static ExynosVideoEncBufferOps defOutbufOps = {
     .Cleanup_Buffer         = MFC_Encoder_Cleanup_Buffer_Outbuf,
     .ExtensionEnqueue       = MFC_Encoder_ExtensionEnqueue_Outbuf,
     .ExtensionDequeue       = MFC_Encoder_ExtensionDequeue_Outbuf,
+    .Get_ReadyFd            = MFC_Encoder_Get_ReadyFd_Outbuf,
 };
 
 ExynosVideoErrorType MFC_Exynos_Video_GetInstInfo_Encoder(
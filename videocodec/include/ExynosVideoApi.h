@@ -831,6 +831,7 @@ typedef struct _ExynosVideoDecBufferOps {
     ExynosVideoErrorType  (*Apply_RegisteredBuffer)(void *pHandle);
     ExynosVideoErrorType  (*ExtensionEnqueue)(void *pHandle, void *pBuffer[], unsigned long pFd[], unsigned int nAllocLen[], unsigned int nDataSize[], int nPlanes, void *pPrivate);
     ExynosVideoErrorType  (*ExtensionDequeue)(void *pHandle, ExynosVideoBuffer *pVideoBuffer);
+    ExynosVideoErrorType  (*Get_ReadyFd)(void *pHandle, int *pFd);
 } ExynosVideoDecBufferOps;
 
 typedef struct _ExynosVideoEncBufferOps {
@@ -854,6 +855,7 @@ typedef struct _ExynosVideoEncBufferOps {
     ExynosVideoErrorType  (*Cleanup_Buffer)(void *pHandle);
     ExynosVideoErrorType  (*ExtensionEnqueue)(void *pHandle, void *pBuffer[], unsigned long pFd[], unsigned int nAllocLen[], unsigned int nDataSize[], int nPlanes, void *pPrivate);
     ExynosVideoErrorType  (*ExtensionDequeue)(void *pHandle, ExynosVideoBuffer *pVideoBuffer);
+    ExynosVideoErrorType  (*Get_ReadyFd)(void *pHandle, int *pFd);
 } ExynosVideoEncBufferOps;
 
 ExynosVideoErrorType Exynos_Video_GetInstInfo(
@@ -26,7 +26,12 @@
  */
 
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
 #include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 #include "ExynosVideo_OSAL.h"
 #include "ExynosVideo_OSAL_Dec.h"
@@ -299,14 +304,100 @@ unsigned int Codec_OSAL_ColorFormatToPixelFormat(
     return nPixelFormat;
 }
 
+#ifndef USE_MOCK_CODEC
+/* device part, ExynosVideo_OSAL_Mock.c provides it for a host without MFC */
+static int Codec_OSAL_QueueIndex(int nBufType)
+{
+    return (nBufType == CODEC_OSAL_BUF_TYPE_SRC)? 0:1;
+}
+
+static void Codec_OSAL_ReadyDestroy(CodecOSALVideoContext *pCtx)
+{
+    int i;
+
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+        if (pCtx->osalCtx.hReadyEpoll[i] >= 0)
+            close(pCtx->osalCtx.hReadyEpoll[i]);
+        pCtx->osalCtx.hReadyEpoll[i] = -1;
+
+        if (pCtx->osalCtx.hCancelEvent[i] >= 0)
+            close(pCtx->osalCtx.hCancelEvent[i]);
+        pCtx->osalCtx.hCancelEvent[i] = -1;
+    }
+
+    return;
+}
+
+static int Codec_OSAL_ReadyCreate(CodecOSALVideoContext *pCtx)
+{
+    /* src is ready on POLLOUT, dst on POLLIN and v4l2 events come as POLLPRI */
+    unsigned int        nDevEvents[CODEC_OSAL_QUEUE_NUM] = { (EPOLLOUT | EPOLLERR | EPOLLHUP), (EPOLLIN | EPOLLPRI | EPOLLERR | EPOLLHUP) };
+    struct epoll_event  event;
+    int                 i;
+
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+        pCtx->osalCtx.hReadyEpoll[i]  = epoll_create1(EPOLL_CLOEXEC);
+        pCtx->osalCtx.hCancelEvent[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((pCtx->osalCtx.hReadyEpoll[i] < 0) ||
+            (pCtx->osalCtx.hCancelEvent[i] < 0))
+            goto ERROR;
+
+        memset(&event, 0, sizeof(event));
+        event.events  = nDevEvents[i];
+        event.data.fd = pCtx->videoCtx.hDevice;
+        if (epoll_ctl(pCtx->osalCtx.hReadyEpoll[i], EPOLL_CTL_ADD, pCtx->videoCtx.hDevice, &event) != 0)
+            goto ERROR;
+
+        memset(&event, 0, sizeof(event));
+        event.events  = EPOLLIN;
+        event.data.fd = pCtx->osalCtx.hCancelEvent[i];
+        if (epoll_ctl(pCtx->osalCtx.hReadyEpoll[i], EPOLL_CTL_ADD, pCtx->osalCtx.hCancelEvent[i], &event) != 0)
+            goto ERROR;
+    }
+
+    return 0;
+
+ERROR:
+    ALOGW("%s: readiness wait is not available(%d), dequeue will block in the driver", __FUNCTION__, errno);
+    Codec_OSAL_ReadyDestroy(pCtx);
+
+    return -1;
+}
+
+static void Codec_OSAL_DequeueEvents(CodecOSALVideoContext *pCtx)
+{
+    struct v4l2_event event;
+
+    /* POLLPRI stays raised while any event is pending */
+    do {
+        memset(&event, 0, sizeof(event));
+        if (ioctl(pCtx->videoCtx.hDevice, VIDIOC_DQEVENT, &event) != 0)
+            break;
+
+        ALOGV("%s: v4l2 event(0x%x), pending(%d)", __FUNCTION__, event.type, event.pending);
+    } while (event.pending > 0);
+
+    return;
+}
+
 int Codec_OSAL_DevOpen(
     const char              *sDevName,
     int                      nFlag,
     CodecOSALVideoContext   *pCtx)
 {
+    int i;
+
     if ((sDevName != NULL) &&
         (pCtx != NULL)) {
+        for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+            pCtx->osalCtx.hReadyEpoll[i]  = -1;
+            pCtx->osalCtx.hCancelEvent[i] = -1;
+        }
+
         pCtx->videoCtx.hDevice = exynos_v4l2_open_devname(sDevName, nFlag, 0);
+        if (pCtx->videoCtx.hDevice >= 0)
+            Codec_OSAL_ReadyCreate(pCtx);
+
         return pCtx->videoCtx.hDevice;
     }
 
@@ -317,12 +408,150 @@ void Codec_OSAL_DevClose(CodecOSALVideoContext *pCtx)
 {
     if ((pCtx != NULL) &&
         (pCtx->videoCtx.hDevice >= 0)) {
+        Codec_OSAL_ReadyDestroy(pCtx);
         exynos_v4l2_close(pCtx->videoCtx.hDevice);
     }
 
     return;
 }
 
+int Codec_OSAL_WaitReady(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType,
+    int                      nTimeoutMs)
+{
+    struct epoll_event  events[2];
+    int                 nQueue;
+    int                 nReady;
+    int                 bReady;
+    int                 bEvent;
+    int                 bError;
+    int                 i;
+
+    if ((pCtx == NULL) ||
+        (pCtx->videoCtx.hDevice < 0))
+        return CODEC_OSAL_WAIT_ERROR;
+
+    nQueue = Codec_OSAL_QueueIndex(nBufType);
+
+    /* without the epoll set, the blocking dequeue does the waiting */
+    if (pCtx->osalCtx.hReadyEpoll[nQueue] < 0)
+        return CODEC_OSAL_WAIT_READY;
+
+    do {
+        nReady = epoll_wait(pCtx->osalCtx.hReadyEpoll[nQueue], events, 2, nTimeoutMs);
+    } while ((nReady < 0) && (errno == EINTR));
+
+    if (nReady < 0) {
+        ALOGE("%s: epoll_wait is failed(%d)", __FUNCTION__, errno);
+        return CODEC_OSAL_WAIT_ERROR;
+    }
+
+    if (nReady == 0)
+        return CODEC_OSAL_WAIT_TIMEOUT;
+
+    bReady = 0;
+    bEvent = 0;
+    bError = 0;
+    for (i = 0; i < nReady; i++) {
+        if (events[i].data.fd == pCtx->osalCtx.hCancelEvent[nQueue])
+            return CODEC_OSAL_WAIT_CANCELED;
+
+        /* POLLERR is a queue that is not streaming or has failed, the dequeue reports it */
+        if (events[i].events & (EPOLLIN | EPOLLOUT | EPOLLERR))
+            bReady = 1;
+
+        if (events[i].events & EPOLLHUP)
+            bError = 1;
+
+        if (events[i].events & EPOLLPRI)
+            bEvent = 1;
+    }
+
+    /* the device is gone */
+    if (bError) {
+        ALOGE("%s: device is disconnected(queue %d)", __FUNCTION__, nQueue);
+        errno = EIO;
+        return CODEC_OSAL_WAIT_ERROR;
+    }
+
+    if (bEvent)
+        Codec_OSAL_DequeueEvents(pCtx);
+
+    return (bReady)? CODEC_OSAL_WAIT_READY:CODEC_OSAL_WAIT_EVENT;
+}
+
+int Codec_OSAL_CancelWait(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    uint64_t nValue = 1;
+    int      nQueue;
+
+    if (pCtx == NULL)
+        return -1;
+
+    nQueue = Codec_OSAL_QueueIndex(nBufType);
+    if (pCtx->osalCtx.hCancelEvent[nQueue] < 0)
+        return -1;
+
+    /* stays signaled until Codec_OSAL_ResumeWait(), so late waiters leave too */
+    if (write(pCtx->osalCtx.hCancelEvent[nQueue], &nValue, sizeof(nValue)) != sizeof(nValue))
+        return -1;
+
+    return 0;
+}
+
+/* the epoll set is readable itself while WaitReady() would return, -1 without it */
+int Codec_OSAL_GetReadyFd(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    if ((pCtx == NULL) ||
+        (pCtx->videoCtx.hDevice < 0))
+        return -1;
+
+    return pCtx->osalCtx.hReadyEpoll[Codec_OSAL_QueueIndex(nBufType)];
+}
+
+int Codec_OSAL_ResumeWait(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    uint64_t nValue = 0;
+    int      nQueue;
+
+    if (pCtx == NULL)
+        return -1;
+
+    nQueue = Codec_OSAL_QueueIndex(nBufType);
+    if (pCtx->osalCtx.hCancelEvent[nQueue] < 0)
+        return -1;
+
+    /* non-blocking, fails with EAGAIN when it was not canceled */
+    if (read(pCtx->osalCtx.hCancelEvent[nQueue], &nValue, sizeof(nValue)) != sizeof(nValue))
+        return -1;
+
+    return 0;
+}
+
+int Codec_OSAL_SubscribeEvent(
+    CodecOSALVideoContext   *pCtx,
+    unsigned int             nEventType)
+{
+    if ((pCtx != NULL) &&
+        (pCtx->videoCtx.hDevice >= 0)) {
+        struct v4l2_event_subscription sub;
+
+        memset(&sub, 0, sizeof(sub));
+        sub.type = nEventType;
+
+        return ioctl(pCtx->videoCtx.hDevice, VIDIOC_SUBSCRIBE_EVENT, &sub);
+    }
+
+    return -1;
+}
+
 int Codec_OSAL_QueryCap(CodecOSALVideoContext *pCtx)
 {
     int needCaps = (V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_VIDEO_OUTPUT | V4L2_CAP_STREAMING);
@@ -412,6 +641,20 @@ int Codec_OSAL_DequeueBuf(
         buf.length      = pBuf->nPlane;
         buf.memory      = pBuf->memory;
 
+        switch (Codec_OSAL_WaitReady(pCtx, pBuf->type, -1)) {
+        case CODEC_OSAL_WAIT_READY:
+            break;
+        case CODEC_OSAL_WAIT_EVENT:
+            /* let the caller look at its state, the buffer carrying the change follows */
+            errno = EAGAIN;
+            return -1;
+        case CODEC_OSAL_WAIT_CANCELED:
+            errno = ECANCELED;
+            return -1;
+        default:
+            return -1;
+        }
+
         if (exynos_v4l2_dqbuf(pCtx->videoCtx.hDevice, &buf) == 0) {
             pBuf->index     = buf.index;
 #ifdef USE_ORIGINAL_HEADER
@@ -2134,6 +2377,7 @@ int Codec_OSAL_SetStreamOn(
 {
     if ((pCtx != NULL) &&
         (pCtx->videoCtx.hDevice >= 0)) {
+        Codec_OSAL_ResumeWait(pCtx, nPort);
         return exynos_v4l2_streamon(pCtx->videoCtx.hDevice, nPort);
     }
 
@@ -2146,11 +2390,14 @@ int Codec_OSAL_SetStreamOff(
 {
     if ((pCtx != NULL) &&
         (pCtx->videoCtx.hDevice >= 0)) {
+        /* flush and stop, the waiters leave before the queue is torn down */
+        Codec_OSAL_CancelWait(pCtx, nPort);
         return exynos_v4l2_streamoff(pCtx->videoCtx.hDevice, nPort);
     }
 
     return -1;
 }
+#endif /* USE_MOCK_CODEC */
 
 void *Codec_OSAL_MemoryMap(void *addr, size_t len, int prot, int flags, unsigned long fd, off_t offset)
 {
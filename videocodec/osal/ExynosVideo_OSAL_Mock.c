@@ -0,0 +1,1243 @@
+/*
+ *
+ * Copyright 2016 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    ExynosVideo_OSAL_Mock.c
+ * @brief   ExynosVideo OSAL, device part of an in-process MFC model
+ *          replaces the v4l2 node when built with USE_MOCK_CODEC
+ * @version    1.0.0
+ * @history
+ *   2026.10.19 : Create
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "ExynosVideo_OSAL.h"
+#include "ExynosVideo_OSAL_Dec.h"
+#include "ExynosVideo_OSAL_Enc.h"
+
+#include "ExynosVideoDec.h"
+#include "ExynosVideoEnc.h"
+
+/* #define LOG_NDEBUG 0 */
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "ExynosVideoOSALMock"
+
+#define ALIGN(x, a) (((x) + (a) - 1) & ~((a) - 1))
+
+/*
+ * The model decodes/encodes a frame as soon as a src and a dst buffer are
+ * queued on a streaming context. It never touches the picture, but it keeps
+ * the queue, control and timing behavior the Exynos video API relies on:
+ *  - decoder : the first src is consumed as the header, GetFormat(dst) fails
+ *              with EAGAIN until then. A dst is returned per src in decode
+ *              order and an empty(EOS) src finishes decoding.
+ *  - encoder : the first dst carries the stream header, then a dst per src.
+ *              I frames follow the IDR period or a forced frame type.
+ *  - timing  : all contexts share one hardware. A frame holds it for
+ *              EXYNOS_VIDEO_MOCK_FRAME_US(0) and a dst is not dequeueable
+ *              before its frame is done, so concurrent sessions queue up.
+ *  - stop    : a stream off takes EXYNOS_VIDEO_MOCK_STOP_US(0) like the firmware
+ *              round trip of MFC, the frames it discards give their hardware time back.
+ * EXYNOS_VIDEO_MOCK_SIZE("1920x1080") is the size the decoder reports.
+ */
+#define MOCK_DEFAULT_WIDTH      1920
+#define MOCK_DEFAULT_HEIGHT     1080
+#define MOCK_MIN_DPB_NUM        4
+#define MOCK_DEFAULT_IDR_PERIOD 30
+#define MOCK_DEFAULT_BITRATE    (10 * 1000 * 1000)
+#define MOCK_DEFAULT_FRAMERATE  30
+#define MOCK_MAX_CONTROLS       64
+
+#define MOCK_DEC_EXT_INFO       (0x1 << 5)  /* DPB is managed by driver, no shared ion buffer */
+#define MOCK_ENC_EXT_INFO       (0x0)
+
+#define MOCK_DISPLAY_DECODING   1
+#define MOCK_DECODING_FINISHED  3
+
+typedef struct _MockFrame {
+    int                     index;
+    unsigned int            flags;
+    int                     dataLen[VIDEO_BUFFER_MAX_PLANES];
+    void                   *addr[VIDEO_BUFFER_MAX_PLANES];     /* fd or user pointer of a shared buffer */
+    int                     bufferSize[VIDEO_BUFFER_MAX_PLANES];
+    struct timeval          timestamp;
+    int                     nFrameTag;
+    int                     nDisplayStatus;
+    ExynosVideoFrameType    frameType;
+    long long               nReadyUs;
+} MockFrame;
+
+typedef struct _MockQueue {
+    int                 bStreaming;
+    int                 bCanceled;
+    int                 nMemory;
+    int                 nBuffers;
+    CodecOSAL_Format    format;
+    int                 hPlaneFD[VIDEO_BUFFER_MAX_NUM][VIDEO_BUFFER_MAX_PLANES];  /* memfd of MMAP buffers */
+    MockFrame           queued[VIDEO_BUFFER_MAX_NUM];
+    int                 nQueued;
+    MockFrame           done[VIDEO_BUFFER_MAX_NUM];
+    int                 nDone;
+    int                 hReadyTimer;    /* timerfd, readable while Mock_Wait() would return */
+} MockQueue;
+
+typedef struct _MockControl {
+    unsigned int    nCID;
+    int             nValue;
+} MockControl;
+
+typedef struct _MockDevice {
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    int                 bEncoder;
+    int                 bHeaderDone;
+    int                 bPendingFinish;
+    int                 nPendingTag;
+    struct timeval      pendingTimestamp;
+    int                 bForceIFrame;
+    int                 nFrameCount;
+    int                 nIDRPeriod;
+    int                 nBitrate;
+    int                 nFramerate;
+    unsigned int        nWidth;
+    unsigned int        nHeight;
+    long long           nStopUs;
+    int                 nLastTag;
+    int                 nLastStatus;
+    MockQueue           queue[CODEC_OSAL_QUEUE_NUM];
+    MockControl         controls[MOCK_MAX_CONTROLS];
+    int                 nControls;
+} MockDevice;
+
+/* one MFC is shared by every context */
+static pthread_mutex_t gMockHWLock  = PTHREAD_MUTEX_INITIALIZER;
+static long long       gMockHWBusyUs = 0;
+static long long       gMockFrameUs  = -1;
+
+static long long Mock_NowUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((long long)now.tv_sec * 1000000LL) + (now.tv_nsec / 1000);
+}
+
+static int Codec_OSAL_QueueIndex(int nBufType)
+{
+    return (nBufType == CODEC_OSAL_BUF_TYPE_SRC)? 0:1;
+}
+
+static MockDevice *Mock_GetDevice(CodecOSALVideoContext *pCtx)
+{
+    if ((pCtx == NULL) ||
+        (pCtx->videoCtx.hDevice < 0))
+        return NULL;
+
+    return (MockDevice *)pCtx->osalCtx.pMockDevice;
+}
+
+/* returns the time the frame is done, after the frames of every context already on the hardware */
+static long long Mock_RunHW(void)
+{
+    long long nStartUs;
+
+    pthread_mutex_lock(&gMockHWLock);
+
+    if (gMockFrameUs < 0) {
+        char *pValue = getenv("EXYNOS_VIDEO_MOCK_FRAME_US");
+        gMockFrameUs = (pValue != NULL)? atoll(pValue):0;
+        if (gMockFrameUs < 0)
+            gMockFrameUs = 0;
+    }
+
+    nStartUs = Mock_NowUs();
+    if (nStartUs < gMockHWBusyUs)
+        nStartUs = gMockHWBusyUs;
+
+    gMockHWBusyUs = nStartUs + gMockFrameUs;
+    nStartUs = gMockHWBusyUs;
+
+    pthread_mutex_unlock(&gMockHWLock);
+
+    return nStartUs;
+}
+
+/* stream off aborts the frames not done yet, they give their time on the hardware back */
+static void Mock_AbortHW(MockQueue *pQueue)
+{
+    long long nNowUs   = Mock_NowUs();
+    int       nAborted = 0;
+    int       i;
+
+    for (i = 0; i < pQueue->nDone; i++) {
+        if (pQueue->done[i].nReadyUs > nNowUs)
+            nAborted++;
+    }
+
+    if (nAborted <= 0)
+        return;
+
+    pthread_mutex_lock(&gMockHWLock);
+
+    gMockHWBusyUs -= (long long)nAborted * gMockFrameUs;
+    if (gMockHWBusyUs < nNowUs)
+        gMockHWBusyUs = nNowUs;
+
+    pthread_mutex_unlock(&gMockHWLock);
+
+    return;
+}
+
+static int Mock_FindControl(MockDevice *pDev, unsigned int nCID)
+{
+    int i;
+
+    for (i = 0; i < pDev->nControls; i++) {
+        if (pDev->controls[i].nCID == nCID)
+            return i;
+    }
+
+    return -1;
+}
+
+static void Mock_PopFrame(MockFrame *pList, int *pCount, MockFrame *pFrame)
+{
+    *pFrame = pList[0];
+    (*pCount)--;
+    memmove(&pList[0], &pList[1], sizeof(MockFrame) * (*pCount));
+
+    return;
+}
+
+static void Mock_PushDone(MockQueue *pQueue, MockFrame *pFrame)
+{
+    if (pQueue->nDone < VIDEO_BUFFER_MAX_NUM)
+        pQueue->done[pQueue->nDone++] = *pFrame;
+
+    return;
+}
+
+/* fills the head of a bitstream, the component looks for the start codes of the header */
+static void Mock_WriteStream(
+    MockQueue       *pQueue,
+    MockFrame       *pFrame,
+    unsigned char   *pData,
+    int              nDataLen)
+{
+    unsigned char *pAddr  = NULL;
+    int            nSize  = pFrame->bufferSize[0];
+    int            hFD    = -1;
+
+    if (pQueue->nMemory == CODEC_OSAL_MEM_TYPE_USERPTR) {
+        pAddr = (unsigned char *)pFrame->addr[0];
+    } else {
+        hFD = (pQueue->nMemory == CODEC_OSAL_MEM_TYPE_MMAP)? pQueue->hPlaneFD[pFrame->index][0]:(int)(unsigned long)pFrame->addr[0];
+        if ((hFD < 0) || (nSize <= 0))
+            return;
+
+        pAddr = (unsigned char *)mmap(NULL, nSize, PROT_READ | PROT_WRITE, MAP_SHARED, hFD, 0);
+        if (pAddr == MAP_FAILED)
+            return;
+    }
+
+    if ((pAddr != NULL) &&
+        (nDataLen <= nSize))
+        memcpy(pAddr, pData, nDataLen);
+
+    if (hFD >= 0)
+        munmap(pAddr, nSize);
+
+    return;
+}
+
+static void Mock_PlaneSize(
+    CodecOSAL_Format    *pFmt,
+    unsigned int         nWidth,
+    unsigned int         nHeight)
+{
+    unsigned int nStride    = ALIGN(nWidth, 16);
+    unsigned int nLumaSize  = nStride * ALIGN(nHeight, 16);
+    int          nPlane     = (pFmt->nPlane > 0)? pFmt->nPlane:2;
+
+    pFmt->width  = nWidth;
+    pFmt->height = nHeight;
+    pFmt->stride = nStride;
+    pFmt->nPlane = nPlane;
+    pFmt->field  = CODEC_OSAL_INTER_TYPE_NONE;
+
+    switch (nPlane) {
+    case 1:
+        pFmt->planeSize[0] = (nLumaSize * 3) / 2;
+        break;
+    case 3:
+        pFmt->planeSize[0] = nLumaSize;
+        pFmt->planeSize[1] = nLumaSize / 4;
+        pFmt->planeSize[2] = nLumaSize / 4;
+        break;
+    default:
+        pFmt->planeSize[0] = nLumaSize;
+        pFmt->planeSize[1] = nLumaSize / 2;
+        break;
+    }
+
+    return;
+}
+
+static void Mock_Decode(MockDevice *pDev)
+{
+    MockQueue *pSrc = &pDev->queue[0];
+    MockQueue *pDst = &pDev->queue[1];
+    MockFrame  src, dst;
+    int        i;
+
+    if (pSrc->bStreaming == 0)
+        return;
+
+    /* the first src is parsed for the geometry and given back, the component streams it again */
+    if (pDev->bHeaderDone == 0) {
+        if (pSrc->nQueued > 0) {
+            Mock_PopFrame(pSrc->queued, &pSrc->nQueued, &src);
+            src.nReadyUs = Mock_NowUs();
+            Mock_PushDone(pSrc, &src);
+            pDev->bHeaderDone = 1;
+        }
+
+        return;
+    }
+
+    while ((pDst->bStreaming != 0) &&
+           (pDst->nQueued > 0)) {
+        if (pDev->bPendingFinish != 0) {
+            Mock_PopFrame(pDst->queued, &pDst->nQueued, &dst);
+            memset(dst.dataLen, 0, sizeof(dst.dataLen));
+            dst.nFrameTag       = pDev->nPendingTag;
+            dst.timestamp       = pDev->pendingTimestamp;
+            dst.nDisplayStatus  = MOCK_DECODING_FINISHED;
+            dst.frameType       = VIDEO_FRAME_OTHERS;
+            dst.nReadyUs        = Mock_NowUs();
+            Mock_PushDone(pDst, &dst);
+            pDev->bPendingFinish = 0;
+            continue;
+        }
+
+        if (pSrc->nQueued <= 0)
+            break;
+
+        Mock_PopFrame(pSrc->queued, &pSrc->nQueued, &src);
+
+        if ((src.flags & EMPTY_DATA) ||
+            (src.dataLen[0] <= 0)) {
+            src.nReadyUs = Mock_NowUs();
+            Mock_PushDone(pSrc, &src);
+
+            pDev->bPendingFinish    = 1;
+            pDev->nPendingTag       = src.nFrameTag;
+            pDev->pendingTimestamp  = src.timestamp;
+            continue;
+        }
+
+        Mock_PopFrame(pDst->queued, &pDst->nQueued, &dst);
+        for (i = 0; i < pDst->format.nPlane; i++)
+            dst.dataLen[i] = pDst->format.planeSize[i];
+
+        dst.nFrameTag       = src.nFrameTag;
+        dst.timestamp       = src.timestamp;
+        dst.nDisplayStatus  = MOCK_DISPLAY_DECODING;
+        dst.frameType       = (pDev->nFrameCount == 0)? VIDEO_FRAME_I:VIDEO_FRAME_P;
+        dst.nReadyUs        = Mock_RunHW();
+        Mock_PushDone(pDst, &dst);
+
+        /* MFC gives the src back when the frame is done */
+        src.nReadyUs = dst.nReadyUs;
+        Mock_PushDone(pSrc, &src);
+
+        pDev->nFrameCount++;
+
+        if (src.flags & LAST_FRAME) {
+            pDev->bPendingFinish    = 1;
+            pDev->nPendingTag       = src.nFrameTag;
+            pDev->pendingTimestamp  = src.timestamp;
+        }
+    }
+
+    return;
+}
+
+static void Mock_Encode(MockDevice *pDev)
+{
+    /* AUD-less SPS/PPS(or VPS/SPS/PPS) prefix, enough for the header split in the components */
+    unsigned char header[] = { 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x28,
+                               0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x3c, 0x80 };
+    unsigned char slice[]  = { 0x00, 0x00, 0x00, 0x01, 0x65 };
+
+    MockQueue *pSrc = &pDev->queue[0];
+    MockQueue *pDst = &pDev->queue[1];
+    MockFrame  src, dst;
+    int        nAvgSize;
+
+    if ((pSrc->bStreaming == 0) ||
+        (pDst->bStreaming == 0))
+        return;
+
+    while ((pSrc->nQueued > 0) &&
+           (pDst->nQueued > 0)) {
+        Mock_PopFrame(pDst->queued, &pDst->nQueued, &dst);
+        memset(dst.dataLen, 0, sizeof(dst.dataLen));
+        dst.nDisplayStatus = 0;
+
+        if (pDev->bHeaderDone == 0) {
+            if (pDst->format.format == V4L2_PIX_FMT_HEVC) {
+                header[4]  = 0x40;  /* VPS+SPS are not split by the component */
+                header[12] = 0x44;
+            }
+
+            Mock_WriteStream(pDst, &dst, header, sizeof(header));
+            dst.dataLen[0]  = sizeof(header);
+            dst.nFrameTag   = -1;
+            dst.frameType   = VIDEO_FRAME_OTHERS;
+            dst.nReadyUs    = Mock_NowUs();
+            Mock_PushDone(pDst, &dst);
+            pDev->bHeaderDone = 1;
+            continue;
+        }
+
+        Mock_PopFrame(pSrc->queued, &pSrc->nQueued, &src);
+        dst.nFrameTag = src.nFrameTag;
+        dst.timestamp = src.timestamp;
+
+        if ((src.flags & EMPTY_DATA) ||
+            (src.dataLen[0] <= 0)) {
+            /* EOS is given back through an empty dst with the tag of the src */
+            dst.frameType = VIDEO_FRAME_OTHERS;
+            dst.nReadyUs  = Mock_NowUs();
+        } else {
+            nAvgSize = pDev->nBitrate / 8 / ((pDev->nFramerate > 0)? pDev->nFramerate:MOCK_DEFAULT_FRAMERATE);
+
+            if ((pDev->bForceIFrame != 0) ||
+                (pDev->nIDRPeriod <= 0) ||
+                ((pDev->nFrameCount % pDev->nIDRPeriod) == 0)) {
+                dst.frameType   = VIDEO_FRAME_I;
+                dst.dataLen[0]  = nAvgSize * 3;
+                slice[4]        = (pDst->format.format == V4L2_PIX_FMT_HEVC)? 0x26:0x65;
+                pDev->bForceIFrame = 0;
+            } else {
+                dst.frameType   = VIDEO_FRAME_P;
+                dst.dataLen[0]  = nAvgSize;
+                slice[4]        = (pDst->format.format == V4L2_PIX_FMT_HEVC)? 0x02:0x41;
+            }
+
+            if (dst.dataLen[0] > dst.bufferSize[0])
+                dst.dataLen[0] = dst.bufferSize[0];
+            if (dst.dataLen[0] < (int)sizeof(slice))
+                dst.dataLen[0] = sizeof(slice);
+
+            Mock_WriteStream(pDst, &dst, slice, sizeof(slice));
+            dst.nReadyUs = Mock_RunHW();
+            pDev->nFrameCount++;
+        }
+
+        Mock_PushDone(pDst, &dst);
+
+        src.nReadyUs = dst.nReadyUs;
+        Mock_PushDone(pSrc, &src);
+    }
+
+    return;
+}
+
+/* arms the timer for the head of the done list, like the v4l2 poll it never misses a state */
+static void Mock_UpdateReady(MockQueue *pQueue)
+{
+    struct itimerspec timer;
+    long long         nReadyUs = 0;
+
+    if (pQueue->hReadyTimer < 0)
+        return;
+
+    if ((pQueue->bCanceled != 0) ||
+        (pQueue->bStreaming == 0))
+        nReadyUs = 1;
+    else if (pQueue->nDone > 0)
+        nReadyUs = pQueue->done[0].nReadyUs;
+
+    /* an absolute time in the past expires at once, zero disarms and clears the expiration */
+    memset(&timer, 0, sizeof(timer));
+    if (nReadyUs > 0) {
+        timer.it_value.tv_sec  = nReadyUs / 1000000LL;
+        timer.it_value.tv_nsec = (nReadyUs % 1000000LL) * 1000;
+    }
+
+    timerfd_settime(pQueue->hReadyTimer, TFD_TIMER_ABSTIME, &timer, NULL);
+
+    return;
+}
+
+/* under the device lock, after anything Mock_Wait() looks at has changed */
+static void Mock_Notify(MockDevice *pDev)
+{
+    int i;
+
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++)
+        Mock_UpdateReady(&pDev->queue[i]);
+
+    pthread_cond_broadcast(&pDev->cond);
+
+    return;
+}
+
+static void Mock_Process(MockDevice *pDev)
+{
+    if (pDev->bEncoder)
+        Mock_Encode(pDev);
+    else
+        Mock_Decode(pDev);
+
+    Mock_Notify(pDev);
+
+    return;
+}
+
+/* under the device lock, same results as the epoll based wait */
+static int Mock_Wait(
+    MockDevice  *pDev,
+    MockQueue   *pQueue,
+    int          nTimeoutMs)
+{
+    struct timespec deadline;
+    long long       nDeadlineUs = -1;
+    long long       nWakeUs;
+    long long       nNowUs;
+
+    if (nTimeoutMs >= 0)
+        nDeadlineUs = Mock_NowUs() + ((long long)nTimeoutMs * 1000);
+
+    while (1) {
+        if (pQueue->bCanceled != 0)
+            return CODEC_OSAL_WAIT_CANCELED;
+
+        /* like POLLERR, dequeue reports it */
+        if (pQueue->bStreaming == 0)
+            return CODEC_OSAL_WAIT_READY;
+
+        nNowUs = Mock_NowUs();
+        if ((pQueue->nDone > 0) &&
+            (pQueue->done[0].nReadyUs <= nNowUs))
+            return CODEC_OSAL_WAIT_READY;
+
+        if ((nDeadlineUs >= 0) &&
+            (nNowUs >= nDeadlineUs))
+            return CODEC_OSAL_WAIT_TIMEOUT;
+
+        nWakeUs = nDeadlineUs;
+        if ((pQueue->nDone > 0) &&
+            ((nWakeUs < 0) || (pQueue->done[0].nReadyUs < nWakeUs)))
+            nWakeUs = pQueue->done[0].nReadyUs;
+
+        if (nWakeUs < 0) {
+            pthread_cond_wait(&pDev->cond, &pDev->lock);
+        } else {
+            deadline.tv_sec  = nWakeUs / 1000000LL;
+            deadline.tv_nsec = (nWakeUs % 1000000LL) * 1000;
+            pthread_cond_timedwait(&pDev->cond, &pDev->lock, &deadline);
+        }
+    }
+
+    return CODEC_OSAL_WAIT_ERROR;
+}
+
+static void Mock_ReleaseBuffers(MockQueue *pQueue)
+{
+    int i, j;
+
+    for (i = 0; i < VIDEO_BUFFER_MAX_NUM; i++) {
+        for (j = 0; j < VIDEO_BUFFER_MAX_PLANES; j++) {
+            if (pQueue->hPlaneFD[i][j] >= 0)
+                close(pQueue->hPlaneFD[i][j]);
+            pQueue->hPlaneFD[i][j] = -1;
+        }
+    }
+
+    pQueue->nBuffers = 0;
+    pQueue->nQueued  = 0;
+    pQueue->nDone    = 0;
+
+    return;
+}
+
+int Codec_OSAL_DevOpen(
+    const char              *sDevName,
+    int                      nFlag,
+    CodecOSALVideoContext   *pCtx)
+{
+    MockDevice         *pDev = NULL;
+    pthread_condattr_t  attr;
+    char               *pValue = NULL;
+    int                 i, j;
+
+    if ((sDevName == NULL) ||
+        (pCtx == NULL))
+        return -1;
+
+    pCtx->osalCtx.pMockDevice = NULL;
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+        pCtx->osalCtx.hReadyEpoll[i]  = -1;
+        pCtx->osalCtx.hCancelEvent[i] = -1;
+    }
+
+    pDev = (MockDevice *)calloc(1, sizeof(*pDev));
+    if (pDev == NULL)
+        return -1;
+
+    /* a real descriptor, so the callers that check or close it keep working */
+    pCtx->videoCtx.hDevice = eventfd(0, EFD_CLOEXEC);
+    if (pCtx->videoCtx.hDevice < 0) {
+        free(pDev);
+        return -1;
+    }
+
+    pthread_mutex_init(&pDev->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pDev->cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    pDev->bEncoder   = (strstr(sDevName, "-enc") != NULL)? 1:0;
+    pDev->nIDRPeriod = MOCK_DEFAULT_IDR_PERIOD;
+    pDev->nBitrate   = MOCK_DEFAULT_BITRATE;
+    pDev->nFramerate = MOCK_DEFAULT_FRAMERATE;
+    pDev->nWidth     = MOCK_DEFAULT_WIDTH;
+    pDev->nHeight    = MOCK_DEFAULT_HEIGHT;
+    pDev->nLastTag   = -1;
+
+    pValue = getenv("EXYNOS_VIDEO_MOCK_STOP_US");
+    if (pValue != NULL)
+        pDev->nStopUs = atoll(pValue);
+
+    pValue = getenv("EXYNOS_VIDEO_MOCK_SIZE");
+    if ((pValue != NULL) &&
+        (sscanf(pValue, "%ux%u", &pDev->nWidth, &pDev->nHeight) != 2)) {
+        pDev->nWidth  = MOCK_DEFAULT_WIDTH;
+        pDev->nHeight = MOCK_DEFAULT_HEIGHT;
+    }
+
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+        for (j = 0; j < VIDEO_BUFFER_MAX_NUM; j++)
+            memset(pDev->queue[i].hPlaneFD[j], -1, sizeof(pDev->queue[i].hPlaneFD[j]));
+
+        /* Codec_OSAL_GetReadyFd() reports -1 without it, the callers block in dequeue then */
+        pDev->queue[i].hReadyTimer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        Mock_UpdateReady(&pDev->queue[i]);
+    }
+
+    pCtx->osalCtx.pMockDevice = (void *)pDev;
+
+    ALOGV("%s: %s is opened as a mock(%ux%u)", __FUNCTION__, sDevName, pDev->nWidth, pDev->nHeight);
+
+    return pCtx->videoCtx.hDevice;
+}
+
+void Codec_OSAL_DevClose(CodecOSALVideoContext *pCtx)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    int         i;
+
+    if (pDev == NULL)
+        return;
+
+    for (i = 0; i < CODEC_OSAL_QUEUE_NUM; i++) {
+        Mock_ReleaseBuffers(&pDev->queue[i]);
+        if (pDev->queue[i].hReadyTimer >= 0)
+            close(pDev->queue[i].hReadyTimer);
+    }
+
+    pthread_cond_destroy(&pDev->cond);
+    pthread_mutex_destroy(&pDev->lock);
+    free(pDev);
+
+    pCtx->osalCtx.pMockDevice = NULL;
+    close(pCtx->videoCtx.hDevice);
+
+    return;
+}
+
+int Codec_OSAL_WaitReady(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType,
+    int                      nTimeoutMs)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    int         ret;
+
+    if (pDev == NULL)
+        return CODEC_OSAL_WAIT_ERROR;
+
+    pthread_mutex_lock(&pDev->lock);
+    ret = Mock_Wait(pDev, &pDev->queue[Codec_OSAL_QueueIndex(nBufType)], nTimeoutMs);
+    pthread_mutex_unlock(&pDev->lock);
+
+    return ret;
+}
+
+int Codec_OSAL_CancelWait(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+
+    if (pDev == NULL)
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+    pDev->queue[Codec_OSAL_QueueIndex(nBufType)].bCanceled = 1;
+    Mock_Notify(pDev);
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_ResumeWait(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+    int         ret = -1;
+
+    if (pDev == NULL)
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(nBufType)];
+    if (pQueue->bCanceled != 0) {
+        pQueue->bCanceled = 0;
+        Mock_UpdateReady(pQueue);
+        ret = 0;
+    }
+    pthread_mutex_unlock(&pDev->lock);
+
+    return ret;
+}
+
+int Codec_OSAL_GetReadyFd(
+    CodecOSALVideoContext   *pCtx,
+    int                      nBufType)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+
+    if (pDev == NULL)
+        return -1;
+
+    return pDev->queue[Codec_OSAL_QueueIndex(nBufType)].hReadyTimer;
+}
+
+int Codec_OSAL_SubscribeEvent(
+    CodecOSALVideoContext   *pCtx,
+    unsigned int             nEventType)
+{
+    /* the model raises no event, resolution and EOS are told through the buffers */
+    return (Mock_GetDevice(pCtx) != NULL)? 0:-1;
+}
+
+int Codec_OSAL_QueryCap(CodecOSALVideoContext *pCtx)
+{
+    return (Mock_GetDevice(pCtx) != NULL)? 0:-1;
+}
+
+int Codec_OSAL_EnqueueBuf(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Buffer        *pBuf)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+    MockFrame   frame;
+    int         nTag, i;
+
+    if ((pDev == NULL) ||
+        (pBuf == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pBuf->type)];
+    if ((pBuf->index < 0) ||
+        (pBuf->index >= pQueue->nBuffers) ||
+        (pQueue->nQueued >= VIDEO_BUFFER_MAX_NUM)) {
+        pthread_mutex_unlock(&pDev->lock);
+        errno = EINVAL;
+        return -1;
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    frame.index     = pBuf->index;
+    frame.flags     = pBuf->flags;
+    frame.timestamp = pBuf->timestamp;
+
+    for (i = 0; (i < pBuf->nPlane) && (i < VIDEO_BUFFER_MAX_PLANES); i++) {
+        frame.dataLen[i]    = pBuf->planes[i].dataLen;
+        frame.addr[i]       = pBuf->planes[i].addr;
+        frame.bufferSize[i] = (pBuf->planes[i].bufferSize > 0)? pBuf->planes[i].bufferSize:pQueue->format.planeSize[i];
+    }
+
+    /* the tag is latched at src queueing as the driver does */
+    nTag = Mock_FindControl(pDev, CODEC_OSAL_CID_VIDEO_FRAME_TAG);
+    frame.nFrameTag = (nTag >= 0)? pDev->controls[nTag].nValue:-1;
+
+    pQueue->queued[pQueue->nQueued++] = frame;
+
+    Mock_Process(pDev);
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_DequeueBuf(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Buffer        *pBuf)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+    MockFrame   frame;
+    int         i;
+
+    if ((pDev == NULL) ||
+        (pBuf == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pBuf->type)];
+
+    switch (Mock_Wait(pDev, pQueue, -1)) {
+    case CODEC_OSAL_WAIT_READY:
+        break;
+    case CODEC_OSAL_WAIT_CANCELED:
+        pthread_mutex_unlock(&pDev->lock);
+        errno = ECANCELED;
+        return -1;
+    default:
+        pthread_mutex_unlock(&pDev->lock);
+        return -1;
+    }
+
+    if ((pQueue->bStreaming == 0) ||
+        (pQueue->nDone <= 0)) {
+        pthread_mutex_unlock(&pDev->lock);
+        errno = EINVAL;
+        return -1;
+    }
+
+    Mock_PopFrame(pQueue->done, &pQueue->nDone, &frame);
+    Mock_UpdateReady(pQueue);
+
+    pBuf->index     = frame.index;
+    pBuf->flags     = 0;
+    pBuf->field     = CODEC_OSAL_INTER_TYPE_NONE;
+    pBuf->timestamp = frame.timestamp;
+    pBuf->frameType = frame.frameType;
+
+    for (i = 0; (i < pBuf->nPlane) && (i < VIDEO_BUFFER_MAX_PLANES); i++)
+        pBuf->planes[i].dataLen = frame.dataLen[i];
+
+    /* DISPLAY_STATUS and FRAME_TAG are read right after the dst dequeue */
+    if (pBuf->type == CODEC_OSAL_BUF_TYPE_DST) {
+        pDev->nLastTag    = frame.nFrameTag;
+        pDev->nLastStatus = frame.nDisplayStatus;
+    }
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_GetControls(
+    CodecOSALVideoContext   *pCtx,
+    unsigned int             nCID,
+    void                    *pInfo)
+{
+    /* SEI and HDR info are never reported by the model */
+    errno = EINVAL;
+
+    return -1;
+}
+
+int Codec_OSAL_SetControls(
+    CodecOSALVideoContext   *pCtx,
+    unsigned int             nCID,
+    void                    *pInfo)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+
+    if ((pDev == NULL) ||
+        (pInfo == NULL))
+        return -1;
+
+    if (nCID == CODEC_OSAL_CID_ENC_SET_PARAMS) {
+        ExynosVideoEncParam *pEncParam = (ExynosVideoEncParam *)pInfo;
+
+        pthread_mutex_lock(&pDev->lock);
+        pDev->nIDRPeriod = pEncParam->commonParam.IDRPeriod;
+        if (pEncParam->commonParam.Bitrate > 0)
+            pDev->nBitrate = pEncParam->commonParam.Bitrate;
+        pthread_mutex_unlock(&pDev->lock);
+    }
+
+    return 0;
+}
+
+int Codec_OSAL_GetControl(
+    CodecOSALVideoContext   *pCtx,
+    unsigned int             uCID,
+    int                     *pValue)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    int         ret  = 0;
+    int         nIndex;
+
+    if ((pDev == NULL) ||
+        (pValue == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    switch (uCID) {
+    case CODEC_OSAL_CID_VIDEO_GET_VERSION_INFO:
+        *pValue = (int)MFC_1220;
+        break;
+    case CODEC_OSAL_CID_VIDEO_GET_EXT_INFO:
+        *pValue = (pDev->bEncoder)? MOCK_ENC_EXT_INFO:MOCK_DEC_EXT_INFO;
+        break;
+    case CODEC_OSAL_CID_VIDEO_GET_DRIVER_VERSION:
+    case CODEC_OSAL_CID_DEC_CHECK_STATE:
+    case CODEC_OSAL_CID_DEC_GET_10BIT_INFO:
+        *pValue = 0;
+        break;
+    case CODEC_OSAL_CID_DEC_NUM_MIN_BUFFERS:
+        *pValue = MOCK_MIN_DPB_NUM;
+        break;
+    case CODEC_OSAL_CID_DEC_DISPLAY_STATUS:
+        *pValue = pDev->nLastStatus;
+        break;
+    case CODEC_OSAL_CID_VIDEO_FRAME_TAG:
+        *pValue = pDev->nLastTag;
+        break;
+    default:
+        nIndex = Mock_FindControl(pDev, uCID);
+        if (nIndex >= 0) {
+            *pValue = pDev->controls[nIndex].nValue;
+        } else {
+            errno = EINVAL;
+            ret = -1;
+        }
+        break;
+    }
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return ret;
+}
+
+int Codec_OSAL_SetControl(
+    CodecOSALVideoContext  *pCtx,
+    unsigned int            uCID,
+    unsigned long           nValue)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    int         nIndex;
+
+    if (pDev == NULL)
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    switch (uCID) {
+    case CODEC_OSAL_CID_ENC_FRAME_TYPE:
+        if ((int)nValue == VIDEO_FRAME_I)
+            pDev->bForceIFrame = 1;
+        break;
+    case CODEC_OSAL_CID_ENC_IDR_PERIOD:
+        pDev->nIDRPeriod = (int)nValue;
+        break;
+    case CODEC_OSAL_CID_ENC_BIT_RATE:
+        if ((int)nValue > 0)
+            pDev->nBitrate = (int)nValue;
+        break;
+    case CODEC_OSAL_CID_ENC_FRAME_RATE:
+        if ((int)nValue > 0)
+            pDev->nFramerate = (int)nValue;
+        break;
+    default:
+        break;
+    }
+
+    nIndex = Mock_FindControl(pDev, uCID);
+    if ((nIndex < 0) &&
+        (pDev->nControls < MOCK_MAX_CONTROLS))
+        nIndex = pDev->nControls++;
+
+    if (nIndex >= 0) {
+        pDev->controls[nIndex].nCID   = uCID;
+        pDev->controls[nIndex].nValue = (int)nValue;
+    }
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_GetCrop(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Crop          *pCrop)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+
+    if ((pDev == NULL) ||
+        (pCrop == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+    pCrop->left   = 0;
+    pCrop->top    = 0;
+    pCrop->width  = pDev->nWidth;
+    pCrop->height = pDev->nHeight;
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_GetFormat(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Format        *pFmt)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+    int         nType;
+
+    if ((pDev == NULL) ||
+        (pFmt == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pFmt->type)];
+
+    if ((pDev->bEncoder == 0) &&
+        (pFmt->type == CODEC_OSAL_BUF_TYPE_DST)) {
+        if (pDev->bHeaderDone == 0) {
+            pthread_mutex_unlock(&pDev->lock);
+            errno = EAGAIN;
+            return -1;
+        }
+
+        Mock_PlaneSize(&pQueue->format, pDev->nWidth, pDev->nHeight);
+    }
+
+    nType = pFmt->type;
+    *pFmt = pQueue->format;
+    pFmt->type = nType;
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_SetFormat(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Format        *pFmt)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+
+    if ((pDev == NULL) ||
+        (pFmt == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pFmt->type)];
+    pQueue->format = *pFmt;
+
+    /* the raw side of a decoder follows the stream, not the request */
+    if ((pDev->bEncoder == 0) &&
+        (pFmt->type == CODEC_OSAL_BUF_TYPE_DST))
+        Mock_PlaneSize(&pQueue->format, pDev->nWidth, pDev->nHeight);
+
+    /* the raw side of an encoder is sized by the driver */
+    if ((pDev->bEncoder != 0) &&
+        (pFmt->type == CODEC_OSAL_BUF_TYPE_SRC))
+        Mock_PlaneSize(&pQueue->format, pFmt->width, pFmt->height);
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_RequestBuf(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_ReqBuf        *pReqBuf)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+
+    if ((pDev == NULL) ||
+        (pReqBuf == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pReqBuf->type)];
+    if (pQueue->bStreaming != 0) {
+        pthread_mutex_unlock(&pDev->lock);
+        errno = EBUSY;
+        return -1;
+    }
+
+    Mock_ReleaseBuffers(pQueue);
+
+    if (pReqBuf->count > VIDEO_BUFFER_MAX_NUM)
+        pReqBuf->count = VIDEO_BUFFER_MAX_NUM;
+
+    pQueue->nBuffers = pReqBuf->count;
+    pQueue->nMemory  = pReqBuf->memory;
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_QueryBuf(
+    CodecOSALVideoContext   *pCtx,
+    CodecOSAL_Buffer        *pBuf)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+    int         i;
+
+    if ((pDev == NULL) ||
+        (pBuf == NULL))
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(pBuf->type)];
+    if ((pBuf->index < 0) ||
+        (pBuf->index >= pQueue->nBuffers)) {
+        pthread_mutex_unlock(&pDev->lock);
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* MMAP buffers are memfds, Codec_OSAL_MemoryMap() maps them by the descriptor in addr */
+    for (i = 0; (i < pBuf->nPlane) && (i < VIDEO_BUFFER_MAX_PLANES); i++) {
+        int hFD = pQueue->hPlaneFD[pBuf->index][i];
+        int nSize = (pQueue->format.planeSize[i] > 0)? pQueue->format.planeSize[i]:4096;
+
+        if (hFD < 0) {
+            hFD = (int)syscall(__NR_memfd_create, "mock-mfc", 0);
+            if ((hFD < 0) ||
+                (ftruncate(hFD, nSize) != 0)) {
+                if (hFD >= 0)
+                    close(hFD);
+                pthread_mutex_unlock(&pDev->lock);
+                return -1;
+            }
+
+            pQueue->hPlaneFD[pBuf->index][i] = hFD;
+        }
+
+        pBuf->planes[i].addr        = (void *)(unsigned long)hFD;
+        pBuf->planes[i].bufferSize  = nSize;
+        pBuf->planes[i].offset      = 0;
+    }
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_SetStreamOn(
+    CodecOSALVideoContext  *pCtx,
+    int                     nPort)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+
+    if (pDev == NULL)
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(nPort)];
+    pQueue->bCanceled  = 0;
+    pQueue->bStreaming = 1;
+
+    Mock_Process(pDev);
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    return 0;
+}
+
+int Codec_OSAL_SetStreamOff(
+    CodecOSALVideoContext  *pCtx,
+    int                     nPort)
+{
+    MockDevice *pDev = Mock_GetDevice(pCtx);
+    MockQueue  *pQueue;
+
+    if (pDev == NULL)
+        return -1;
+
+    pthread_mutex_lock(&pDev->lock);
+
+    /* every buffer goes back to the user, the waiters leave before the queue is torn down */
+    pQueue = &pDev->queue[Codec_OSAL_QueueIndex(nPort)];
+    if (nPort == CODEC_OSAL_BUF_TYPE_DST)
+        Mock_AbortHW(pQueue);
+
+    pQueue->bCanceled  = 1;
+    pQueue->bStreaming = 0;
+    pQueue->nQueued    = 0;
+    pQueue->nDone      = 0;
+
+    if (nPort == CODEC_OSAL_BUF_TYPE_DST)
+        pDev->bPendingFinish = 0;
+
+    Mock_Notify(pDev);
+
+    pthread_mutex_unlock(&pDev->lock);
+
+    if (pDev->nStopUs > 0)
+        usleep((useconds_t)pDev->nStopUs);
+
+    return 0;
+}
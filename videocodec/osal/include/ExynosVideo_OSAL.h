@@ -188,8 +188,23 @@ typedef struct _CodecOSAL_Buffer {
 
 typedef struct v4l2_requestbuffers CodecOSAL_ReqBuf;
 
+typedef enum _CodecOSAL_WaitResult {
+    CODEC_OSAL_WAIT_ERROR    = -1, /* the wait failed, or POLLHUP(the device is gone) */
+    CODEC_OSAL_WAIT_TIMEOUT  = 0,
+    CODEC_OSAL_WAIT_READY    = 1,  /* a buffer can be dequeued, or the queue is in error that dequeue reports */
+    CODEC_OSAL_WAIT_EVENT    = 2,  /* only v4l2 events(resolution change, EOS) arrived */
+    CODEC_OSAL_WAIT_CANCELED = 3,  /* Codec_OSAL_CancelWait(), done by stream off as well */
+} CodecOSAL_WaitResult;
+
+#define CODEC_OSAL_QUEUE_NUM    2   /* [0] : src, [1] : dst */
+
 typedef struct _CodecOSALInfo {
     int reserved;
+    int hReadyEpoll[CODEC_OSAL_QUEUE_NUM];  /* the device fd and the cancel event, registered once at open */
+    int hCancelEvent[CODEC_OSAL_QUEUE_NUM];
+#ifdef USE_MOCK_CODEC
+    void *pMockDevice;                      /* ExynosVideo_OSAL_Mock.c */
+#endif
 } CodecOSALInfo;
 
 typedef struct _CodecOSALVideoContext {
@@ -208,6 +223,12 @@ void Codec_OSAL_DevClose(CodecOSALVideoContext *pCtx);
 
 int Codec_OSAL_QueryCap(CodecOSALVideoContext *pCtx);
 
+int Codec_OSAL_WaitReady(CodecOSALVideoContext *pCtx, int nBufType, int nTimeoutMs);
+int Codec_OSAL_CancelWait(CodecOSALVideoContext *pCtx, int nBufType);
+int Codec_OSAL_ResumeWait(CodecOSALVideoContext *pCtx, int nBufType);
+int Codec_OSAL_GetReadyFd(CodecOSALVideoContext *pCtx, int nBufType);
+int Codec_OSAL_SubscribeEvent(CodecOSALVideoContext *pCtx, unsigned int nEventType);
+
 int Codec_OSAL_EnqueueBuf(CodecOSALVideoContext *pCtx, CodecOSAL_Buffer *pBuf);
 int Codec_OSAL_DequeueBuf(CodecOSALVideoContext *pCtx, CodecOSAL_Buffer *pBuf);
 